@@ -32,6 +32,7 @@
 #include <vector>
 
 #define MAX_STACK_SIZE 64
+#define BIH_RAY_PACKET_SIZE 8
 
 // https://stackoverflow.com/a/4328396
 
@@ -280,6 +281,34 @@ public:
         }
     }
 
+    /// Any-hit traversal of a packet of rays, as needed by line of sight checks.
+    /// hit[i] is set when rays[i] hits a primitive within maxDist[i]. The per ray
+    /// clip tests are plain loops over BIH_RAY_PACKET_SIZE lanes so the compiler
+    /// can vectorize them, and a subtree is only entered while any lane is inside.
+    template<typename RayCallback>
+    void intersectRays(G3D::Ray const* rays, float const* maxDist, bool* hit, uint32 count, RayCallback& intersectCallback) const
+    {
+        for (uint32 first = 0; first < count; first += BIH_RAY_PACKET_SIZE)
+        {
+            uint32 packetSize = std::min<uint32>(count - first, BIH_RAY_PACKET_SIZE);
+            float packetDist[BIH_RAY_PACKET_SIZE];
+            std::copy(maxDist + first, maxDist + first + packetSize, packetDist);
+            intersectRayPacket<true>(rays + first, packetDist, hit + first, packetSize, intersectCallback);
+        }
+    }
+
+    /// Closest-hit traversal of a packet of rays, as needed by height queries.
+    /// Same as intersectRays, but every lane keeps tracing until its nearest hit
+    /// is found and maxDist[i] is lowered to that distance when hit[i] is set.
+    template<typename RayCallback>
+    void intersectRaysClosest(G3D::Ray const* rays, float* maxDist, bool* hit, uint32 count, RayCallback& intersectCallback) const
+    {
+        for (uint32 first = 0; first < count; first += BIH_RAY_PACKET_SIZE)
+        {
+            intersectRayPacket<false>(rays + first, maxDist + first, hit + first, std::min<uint32>(count - first, BIH_RAY_PACKET_SIZE), intersectCallback);
+        }
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& p, IsectCallback& intersectCallback) const
     {
@@ -394,6 +423,239 @@ protected:
         float tfar;
     };
 
+    struct PacketStackNode
+    {
+        uint32 node;
+        float tnear[BIH_RAY_PACKET_SIZE];
+        float tfar[BIH_RAY_PACKET_SIZE];
+    };
+
+    // StopAtFirstHit retires a lane on its first hit, otherwise maxDist[i] shrinks to the closest hit
+    template<bool StopAtFirstHit, typename RayCallback>
+    void intersectRayPacket(G3D::Ray const* rays, float* maxDist, bool* hit, uint32 count, RayCallback& intersectCallback) const
+    {
+        constexpr uint32 N = BIH_RAY_PACKET_SIZE;
+        float org[3][N];
+        float invDir[3][N];
+        bool negDir[3][N];
+        float intervalMin[N];
+        float intervalMax[N];
+        bool laneHit[N] = { };
+        uint32 remaining = 0;
+
+        for (uint32 i = 0; i < N; ++i)
+        {
+            // unused lanes get an empty interval and never take part in the traversal
+            intervalMin[i] = 1.f;
+            intervalMax[i] = 0.f;
+            for (int a = 0; a < 3; ++a)
+            {
+                org[a][i] = 0.f;
+                invDir[a][i] = 0.f;
+                negDir[a][i] = false;
+            }
+
+            if (i >= count)
+            {
+                continue;
+            }
+
+            hit[i] = false;
+            G3D::Vector3 const& o = rays[i].origin();
+            G3D::Vector3 const& dir = rays[i].direction();
+            float tMin = -1.f;
+            float tMax = -1.f;
+            bool missed = false;
+            for (int a = 0; a < 3; ++a)
+            {
+                org[a][i] = o[a];
+                invDir[a][i] = 1.f / dir[a];
+                negDir[a][i] = floatToRawIntBits(dir[a]) >> 31;
+                if (!missed && G3D::fuzzyNe(dir[a], 0.0f))
+                {
+                    float t1 = (bounds.low()[a] - o[a]) * invDir[a][i];
+                    float t2 = (bounds.high()[a] - o[a]) * invDir[a][i];
+                    if (t1 > t2)
+                    {
+                        std::swap(t1, t2);
+                    }
+                    if (t1 > tMin)
+                    {
+                        tMin = t1;
+                    }
+                    if (t2 < tMax || tMax < 0.f)
+                    {
+                        tMax = t2;
+                    }
+                    missed = tMax <= 0 || tMin >= maxDist[i];
+                }
+            }
+
+            if (missed || tMin > tMax)
+            {
+                continue;
+            }
+
+            intervalMin[i] = std::max(tMin, 0.f);
+            intervalMax[i] = std::min(tMax, maxDist[i]);
+            ++remaining;
+        }
+
+        if (!remaining)
+        {
+            return;
+        }
+
+        PacketStackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        uint32 node = 0;
+
+        while (true)
+        {
+            while (true)
+            {
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30; // cppcheck-suppress integerOverflow
+                bool BVH2 = tn & (1 << 29); // cppcheck-suppress integerOverflow
+                uint32 offset = tn & ~(7 << 29); // cppcheck-suppress integerOverflow
+                if (!BVH2 && axis == 3)
+                {
+                    // leaf - test the objects against every lane that is still tracing
+                    uint32 n = tree[node + 1];
+                    for (; n > 0; --n, ++offset)
+                    {
+                        for (uint32 i = 0; i < count; ++i)
+                        {
+                            if (laneHit[i] || intervalMin[i] > intervalMax[i])
+                            {
+                                continue;
+                            }
+
+                            float dist = maxDist[i];
+                            if (intersectCallback(rays[i], objects[offset], dist, StopAtFirstHit))
+                            {
+                                hit[i] = true;
+                                if constexpr (StopAtFirstHit)
+                                {
+                                    laneHit[i] = true;
+                                    intervalMin[i] = 1.f;
+                                    intervalMax[i] = 0.f;
+                                    if (!--remaining)
+                                    {
+                                        return;
+                                    }
+                                }
+                                else
+                                {
+                                    maxDist[i] = dist;
+                                    intervalMax[i] = std::min(intervalMax[i], dist);
+                                }
+                            }
+                        }
+                    }
+                    break;
+                }
+
+                if (axis > 2)
+                {
+                    return;    // should not happen
+                }
+
+                float clipLeft = intBitsToFloat(tree[node + 1]);
+                float clipRight = intBitsToFloat(tree[node + 2]);
+                if (BVH2)
+                {
+                    // both planes bound the single child
+                    bool anyInside = false;
+                    for (uint32 i = 0; i < N; ++i)
+                    {
+                        float tl = (clipLeft - org[axis][i]) * invDir[axis][i];
+                        float tr = (clipRight - org[axis][i]) * invDir[axis][i];
+                        float tf = negDir[axis][i] ? tr : tl;
+                        float tb = negDir[axis][i] ? tl : tr;
+                        intervalMin[i] = (tf >= intervalMin[i]) ? tf : intervalMin[i];
+                        intervalMax[i] = (tb <= intervalMax[i]) ? tb : intervalMax[i];
+                        anyInside |= intervalMin[i] <= intervalMax[i];
+                    }
+                    node = offset;
+                    if (!anyInside)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+
+                // "normal" interior node, left child at offset and right child at offset + 3
+                float leftMin[N], leftMax[N], rightMin[N], rightMax[N];
+                bool anyLeft = false;
+                bool anyRight = false;
+                for (uint32 i = 0; i < N; ++i)
+                {
+                    float tl = (clipLeft - org[axis][i]) * invDir[axis][i];
+                    float tr = (clipRight - org[axis][i]) * invDir[axis][i];
+                    leftMin[i] = negDir[axis][i] ? std::max(intervalMin[i], tl) : intervalMin[i];
+                    leftMax[i] = negDir[axis][i] ? intervalMax[i] : std::min(intervalMax[i], tl);
+                    rightMin[i] = negDir[axis][i] ? intervalMin[i] : std::max(intervalMin[i], tr);
+                    rightMax[i] = negDir[axis][i] ? std::min(intervalMax[i], tr) : intervalMax[i];
+                    anyLeft |= leftMin[i] <= leftMax[i];
+                    anyRight |= rightMin[i] <= rightMax[i];
+                }
+
+                if (anyLeft && anyRight)
+                {
+                    // the right child waits on the stack, for closest hits it is clipped
+                    // again by whatever the left child found once it is popped
+                    stack[stackPos].node = offset + 3;
+                    std::copy(rightMin, rightMin + N, stack[stackPos].tnear);
+                    std::copy(rightMax, rightMax + N, stack[stackPos].tfar);
+                    stackPos++;
+                }
+
+                if (anyLeft)
+                {
+                    node = offset;
+                    std::copy(leftMin, leftMin + N, intervalMin);
+                    std::copy(leftMax, leftMax + N, intervalMax);
+                    continue;
+                }
+
+                if (!anyRight)
+                {
+                    break;
+                }
+
+                node = offset + 3;
+                std::copy(rightMin, rightMin + N, intervalMin);
+                std::copy(rightMax, rightMax + N, intervalMax);
+            } // traversal loop
+
+            do
+            {
+                // stack is empty?
+                if (stackPos == 0)
+                {
+                    return;
+                }
+                // move back up the stack, dropping lanes that hit in the meantime
+                // and clipping the others to their closest hit so far
+                stackPos--;
+                bool anyInside = false;
+                for (uint32 i = 0; i < N; ++i)
+                {
+                    intervalMin[i] = laneHit[i] ? 1.f : stack[stackPos].tnear[i];
+                    intervalMax[i] = laneHit[i] ? 0.f : std::min(stack[stackPos].tfar[i], i < count ? maxDist[i] : 0.f);
+                    anyInside |= intervalMin[i] <= intervalMax[i];
+                }
+                if (!anyInside)
+                {
+                    continue;
+                }
+                node = stack[stackPos].node;
+                break;
+            } while (true);
+        }
+    }
+
     class BuildStats
     {
     private:
@@ -23,6 +23,11 @@
 #include "G3D/Set.h"
 #include "G3D/Table.h"
 
+#include <atomic>
+#include <chrono>
+
+#define BIH_WRAP_UNBALANCED_LIMIT 16
+
 template<class T, class BoundsFunc = BoundsTrait<T>>
 class BIHWrap
 {
@@ -66,28 +71,62 @@ class BIHWrap
     typedef G3D::Array<const T*> ObjArray;
 
     BIH m_tree;
-    ObjArray m_objects;
+    ObjArray m_objects;                     // objects of m_tree, nullptr once removed
     G3D::Table<const T*, uint32> m_obj2Idx;
-    G3D::Set<const T*> m_objects_to_push;
-    int unbalanced_times;
+    G3D::Set<const T*> m_objects_to_push;   // objects inserted since the last build, tested one by one
+    uint32 m_removed;                       // slots of m_objects emptied since the last build
+
+    void rebuild()
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        ObjArray objects;
+        for (const T* obj : m_objects)
+        {
+            if (obj)
+            {
+                objects.append(obj);
+            }
+        }
+        for (const T* obj : m_objects_to_push)
+        {
+            objects.append(obj);
+        }
+
+        m_objects = objects;
+        m_objects_to_push.clear();
+        m_obj2Idx.clear();
+        for (int i = 0; i < m_objects.size(); ++i)
+        {
+            m_obj2Idx.set(m_objects[i], i);
+        }
+        m_removed = 0;
+
+        m_tree.build(m_objects, BoundsFunc::GetBounds2);
+
+        ++s_rebuilds;
+        s_rebuildMicros += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
 
 public:
-    BIHWrap() : unbalanced_times(0) { }
+    BIHWrap() : m_removed(0) { }
+
+    inline static std::atomic<uint64> s_rebuilds{0};
+    inline static std::atomic<uint64> s_rebuildMicros{0};
 
     void insert(const T& obj)
     {
-        ++unbalanced_times;
         m_objects_to_push.insert(&obj);
     }
 
     void remove(const T& obj)
     {
-        ++unbalanced_times;
         uint32 Idx = 0;
         const T* temp;
         if (m_obj2Idx.getRemove(&obj, temp, Idx))
         {
             m_objects[Idx] = nullptr;
+            ++m_removed;
         }
         else
         {
@@ -95,26 +134,31 @@ public:
         }
     }
 
+    /// A moved transport or a changed door model stays outside the tree and is tested
+    /// next to it, the tree is only rebuilt once too many objects are outside or removed
     void balance()
     {
-        if (unbalanced_times == 0)
+        uint32 limit = std::max<uint32>(BIH_WRAP_UNBALANCED_LIMIT, m_obj2Idx.size() / 4);
+        if (uint32(m_objects_to_push.size()) <= limit && m_removed <= limit)
         {
             return;
         }
 
-        unbalanced_times = 0;
-        m_objects.fastClear();
-        m_obj2Idx.getKeys(m_objects);
-        m_objects_to_push.getMembers(m_objects);
-        //assert that m_obj2Idx has all the keys
-
-        m_tree.build(m_objects, BoundsFunc::GetBounds2);
+        rebuild();
     }
 
     template<typename RayCallback>
     void intersectRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& maxDist, bool stopAtFirstHit)
     {
         balance();
+        for (const T* obj : m_objects_to_push)
+        {
+            if (intersectCallback(ray, *obj, maxDist, stopAtFirstHit) && stopAtFirstHit)
+            {
+                return;
+            }
+        }
+
         MDLCallback<RayCallback> temp_cb(intersectCallback, m_objects.getCArray(), m_objects.size());
         m_tree.intersectRay(ray, temp_cb, maxDist, stopAtFirstHit);
     }
@@ -123,6 +167,11 @@ public:
     void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback)
     {
         balance();
+        for (const T* obj : m_objects_to_push)
+        {
+            intersectCallback(point, *obj);
+        }
+
         MDLCallback<IsectCallback> callback(intersectCallback, m_objects.getCArray(), m_objects.size());
         m_tree.intersectPoint(point, callback);
     }
@@ -144,6 +144,12 @@ void DynamicMapTree::update(uint32 t_diff)
     impl->update(t_diff);
 }
 
+void DynamicMapTree::TakeRebuildStats(uint64& rebuilds, uint64& micros)
+{
+    rebuilds = BIHWrap<GameObjectModel>::s_rebuilds.exchange(0);
+    micros = BIHWrap<GameObjectModel>::s_rebuildMicros.exchange(0);
+}
+
 struct DynamicTreeIntersectionCallback
 {
     DynamicTreeIntersectionCallback(uint32 phasemask, VMAP::ModelIgnoreFlags ignoreFlags) :
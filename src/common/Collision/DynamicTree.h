@@ -63,6 +63,9 @@ public:
 
     void balance();
     void update(uint32 diff);
+
+    // rebuilds of the per cell trees and the time spent in them, over all maps, since the last call
+    static void TakeRebuildStats(uint64& rebuilds, uint64& micros);
 };
 
 #endif // _DYNTREE_H
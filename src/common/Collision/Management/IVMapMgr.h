@@ -22,6 +22,7 @@
 #include "ModelIgnoreFlags.h"
 #include "Optional.h"
 #include <string>
+#include <vector>
 
 //===========================================================
 
@@ -73,6 +74,21 @@ namespace VMAP
         Optional<LiquidInfo> liquidInfo;
     };
 
+    // one segment of a batched line of sight check, InSight holds the result
+    struct LineOfSightQuery
+    {
+        float X1, Y1, Z1;
+        float X2, Y2, Z2;
+        bool InSight = true;
+    };
+
+    // one point of a batched height query, Height holds the result
+    struct HeightQuery
+    {
+        float X, Y, Z;
+        float Height = VMAP_INVALID_HEIGHT_VALUE;
+    };
+
     //===========================================================
     class IVMapMgr
     {
@@ -93,8 +109,16 @@ namespace VMAP
         virtual void unloadMap(unsigned int pMapId) = 0;
 
         virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+        /**
+        checks all queries against the map's static collision in one tree traversal per packet of segments
+        */
+        virtual void isInLineOfSight(unsigned int pMapId, std::vector<LineOfSightQuery>& queries, ModelIgnoreFlags ignoreFlags) = 0;
         virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
         /**
+        resolves the floor height of all queries with one tree traversal per packet of points
+        */
+        virtual void getHeight(unsigned int pMapId, std::vector<HeightQuery>& queries, float maxSearchDist) = 0;
+        /**
         test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
         return a position, that is pReduceDist closer to the origin
         */
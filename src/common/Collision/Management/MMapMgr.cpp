@@ -20,12 +20,31 @@
 #include "Errors.h"
 #include "Log.h"
 #include "MapDefines.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <mutex>
 
 namespace MMAP
 {
     static char const* const MAP_FILE_NAME_FORMAT = "%s/mmaps/%03i.mmap";
     static char const* const TILE_FILE_NAME_FORMAT = "%s/mmaps/%03i%02i%02i.mmtile";
 
+    MMapData::MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
+
+    MMapData::~MMapData()
+    {
+        for (auto& navMeshQuerie : navMeshQueries)
+        {
+            dtFreeNavMeshQuery(navMeshQuerie.second);
+        }
+
+        // mapped tiles are not owned by the nav mesh, their mappings are released after it
+        if (navMesh)
+        {
+            dtFreeNavMesh(navMesh);
+        }
+    }
+
     // ######################## MMapMgr ########################
     MMapMgr::~MMapMgr()
     {
@@ -116,10 +135,21 @@ namespace MMAP
 
         // store inside our map list
         MMapData* mmap_data = new MMapData(mesh);
+        if (pathCacheSize)
+        {
+            mmap_data->pathCache = std::make_unique<PathCache>(pathCacheSize);
+        }
+
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
         itr->second = mmap_data;
         return true;
     }
 
+    std::string MMapMgr::GetTileFileName(uint32 mapId, int32 x, int32 y)
+    {
+        return Acore::StringFormat(TILE_FILE_NAME_FORMAT, sConfigMgr->GetOption<std::string>("DataDir", ".").c_str(), mapId, x, y);
+    }
+
     uint32 MMapMgr::packTileID(int32 x, int32 y)
     {
         return uint32(x << 16 | y);
@@ -146,7 +176,7 @@ namespace MMAP
         }
 
         // load this tile :: mmaps/MMMXXYY.mmtile
-        std::string fileName = Acore::StringFormat(TILE_FILE_NAME_FORMAT, sConfigMgr->GetOption<std::string>("DataDir", ".").c_str(), mapId, x, y);
+        std::string fileName = GetTileFileName(mapId, x, y);
         FILE* file = fopen(fileName.c_str(), "rb");
         if (!file)
         {
@@ -171,36 +201,88 @@ namespace MMAP
             return false;
         }
 
-        unsigned char* data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
-        ASSERT(data);
+        unsigned char* data = nullptr;
+        int tileFlags = DT_TILE_FREE_DATA;
 
-        size_t result = fread(data, fileHeader.size, 1, file);
-        if (!result)
+        // detour only writes to the links and polygons of a tile, the other pages of a mapped tile stay shared
+        if (useMappedTiles && (data = MapTileData(mmap, packedGridPos, fileName, fileHeader.size)))
         {
-            LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap {:03}{:02}{:02}.mmtile", mapId, x, y);
+            tileFlags = 0;
             fclose(file);
-            return false;
         }
+        else
+        {
+            data = (unsigned char*)dtAlloc(fileHeader.size, DT_ALLOC_PERM);
+            ASSERT(data);
 
-        fclose(file);
+            size_t result = fread(data, fileHeader.size, 1, file);
+            if (!result)
+            {
+                LOG_ERROR("maps", "MMAP:loadMap: Bad header or data in mmap {:03}{:02}{:02}.mmtile", mapId, x, y);
+                fclose(file);
+                return false;
+            }
+
+            fclose(file);
+        }
 
         dtTileRef tileRef = 0;
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
-        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
+        if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, tileFlags, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+
+            // the new tile may connect shorter corridors than the cached ones
+            if (mmap->pathCache)
+            {
+                mmap->pathCache->Clear();
+            }
+
             dtMeshHeader* header = (dtMeshHeader*)data;
             LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:03}[{:02},{:02}] into {:03}[{:02},{:02}]", mapId, x, y, mapId, header->x, header->y);
             return true;
         }
 
         LOG_ERROR("maps", "MMAP:loadMap: Could not load {:03}{:02}{:02}.mmtile into navmesh", mapId, x, y);
-        dtFree(data);
+        if (tileFlags & DT_TILE_FREE_DATA)
+        {
+            dtFree(data);
+        }
+        else
+        {
+            mmap->mappedTiles.erase(packedGridPos);
+        }
+
         return false;
     }
 
+    unsigned char* MMapMgr::MapTileData(MMapData* mmap, uint32 packedGridPos, std::string const& fileName, uint32 dataSize)
+    {
+        try
+        {
+            boost::interprocess::file_mapping file(fileName.c_str(), boost::interprocess::read_only);
+            auto region = std::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::copy_on_write);
+            if (region->get_size() < sizeof(MmapTileHeader) + dataSize)
+            {
+                LOG_ERROR("maps", "MMAP:loadMap: '{}' is shorter than the size in its header", fileName);
+                return nullptr;
+            }
+
+            unsigned char* data = static_cast<unsigned char*>(region->get_address()) + sizeof(MmapTileHeader);
+            mmap->mappedTiles[packedGridPos] = std::move(region);
+            return data;
+        }
+        catch (boost::interprocess::interprocess_exception const& e)
+        {
+            LOG_ERROR("maps", "MMAP:loadMap: Could not map '{}' ({}), reading it instead", fileName, e.what());
+            return nullptr;
+        }
+    }
+
     bool MMapMgr::unloadMap(uint32 mapId, int32 x, int32 y)
     {
         // check if we have this map loaded
@@ -225,6 +307,13 @@ namespace MMAP
 
         dtTileRef tileRef = mmap->loadedTileRefs[packedGridPos];
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
+        if (mmap->pathCache)
+        {
+            mmap->pathCache->InvalidateTile(mmap->navMesh, tileRef);
+        }
+
         // unload, and mark as non loaded
         if (dtStatusFailed(mmap->navMesh->removeTile(tileRef, nullptr, nullptr)))
         {
@@ -236,11 +325,30 @@ namespace MMAP
         }
 
         mmap->loadedTileRefs.erase(packedGridPos);
+        mmap->mappedTiles.erase(packedGridPos);
         --loadedTiles;
         LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:03}[{:02},{:02}] from {:03}", mapId, x, y, mapId);
         return true;
     }
 
+    std::size_t MMapMgr::GetLoadedTileBytes()
+    {
+        std::shared_lock<std::shared_mutex> lock(navMeshLock);
+
+        std::size_t size = 0;
+        for (auto const& [mapId, mmap] : loadedMMaps)
+        {
+            if (!mmap)
+                continue;
+
+            for (auto const& [packedGridPos, tileRef] : mmap->loadedTileRefs)
+                if (dtMeshTile const* tile = mmap->navMesh->getTileByRef(tileRef))
+                    size += tile->dataSize;
+        }
+
+        return size;
+    }
+
     bool MMapMgr::unloadMap(uint32 mapId)
     {
         MMapDataSet::iterator itr = loadedMMaps.find(mapId);
@@ -251,6 +359,8 @@ namespace MMAP
             return false;
         }
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // unload all tiles from given map
         MMapData* mmap = itr->second;
         for (auto& i : mmap->loadedTileRefs)
@@ -314,6 +424,33 @@ namespace MMAP
         return itr->second->navMesh;
     }
 
+    PathCache* MMapMgr::GetPathCache(uint32 mapId)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+        {
+            return nullptr;
+        }
+
+        return itr->second->pathCache.get();
+    }
+
+    void MMapMgr::TakePathCacheStats(uint64& hits, uint64& misses)
+    {
+        hits = 0;
+        misses = 0;
+
+        std::shared_lock<std::shared_mutex> lock(navMeshLock);
+        for (auto const& [mapId, mmap] : loadedMMaps)
+        {
+            if (mmap && mmap->pathCache)
+            {
+                hits += mmap->pathCache->TakeHits();
+                misses += mmap->pathCache->TakeMisses();
+            }
+        }
+    }
+
     dtNavMeshQuery const* MMapMgr::GetNavMeshQuery(uint32 mapId, uint32 instanceId)
     {
         MMapDataSet::const_iterator itr = GetMMapData(mapId);
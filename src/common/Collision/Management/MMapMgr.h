@@ -22,10 +22,17 @@
 #include "DetourAlloc.h"
 #include "DetourExtended.h"
 #include "DetourNavMesh.h"
+#include "MMapPathCache.h"
+#include <memory>
 #include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
+namespace boost::interprocess
+{
+    class mapped_region;
+}
+
 //  memory management
 inline void* dtCustomAlloc(size_t size, dtAllocHint /*hint*/)
 {
@@ -42,29 +49,20 @@ namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
     typedef std::unordered_map<uint32, dtNavMeshQuery*> NavMeshQuerySet;
+    typedef std::unordered_map<uint32, std::unique_ptr<boost::interprocess::mapped_region>> MappedTileSet;
 
     // dummy struct to hold map's mmap data
     struct MMapData
     {
-        MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
-
-        ~MMapData()
-        {
-            for (auto& navMeshQuerie : navMeshQueries)
-            {
-                dtFreeNavMeshQuery(navMeshQuerie.second);
-            }
-
-            if (navMesh)
-            {
-                dtFreeNavMesh(navMesh);
-            }
-        }
+        MMapData(dtNavMesh* mesh);
+        ~MMapData();
 
         // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
         NavMeshQuerySet navMeshQueries; // instanceId to query
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs; // maps [map grid coords] to [dtTile]
+        MappedTileSet mappedTiles;  // maps [map grid coords] to the file mapping backing the tile data, if mapped
+        std::unique_ptr<PathCache> pathCache; // nullptr if corridor caching is disabled
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
@@ -87,17 +85,37 @@ namespace MMAP
         dtNavMeshQuery const* GetNavMeshQuery(uint32 mapId, uint32 instanceId);
         dtNavMesh const* GetNavMesh(uint32 mapId);
 
+        // number of poly corridors cached per map, 0 disables the cache; only affects maps loaded afterwards
+        void SetPathCacheSize(uint32 size) { pathCacheSize = size; }
+        // map .mmtile files copy-on-write instead of reading them, so unmodified pages are shared between processes
+        void SetUseMappedTiles(bool mapped) { useMappedTiles = mapped; }
+        [[nodiscard]] PathCache* GetPathCache(uint32 mapId);
+        // cache hits and misses of all maps since the previous call
+        void TakePathCacheStats(uint64& hits, uint64& misses);
+
+        static std::string GetTileFileName(uint32 mapId, int32 x, int32 y);
+
         [[nodiscard]] uint32 getLoadedTilesCount() const { return loadedTiles; }
         [[nodiscard]] uint32 getLoadedMapsCount() const { return loadedMMaps.size(); }
+        /// return: bytes of the tile data in the navmeshes, mapped tiles included
+        [[nodiscard]] std::size_t GetLoadedTileBytes();
+
+        // held shared by threads that query the nav meshes outside of their map update,
+        // tiles are only added or removed while holding it exclusively
+        [[nodiscard]] std::shared_mutex& GetNavMeshLock() { return navMeshLock; }
 
     private:
         bool loadMapData(uint32 mapId);
         uint32 packTileID(int32 x, int32 y);
         [[nodiscard]] MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
+        unsigned char* MapTileData(MMapData* mmap, uint32 packedGridPos, std::string const& fileName, uint32 dataSize);
 
         MMapDataSet loadedMMaps;
         uint32 loadedTiles{0};
         bool thread_safe_environment{true};
+        std::shared_mutex navMeshLock;
+        uint32 pathCacheSize{0};
+        bool useMappedTiles{false};
     };
 }
 
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MMapPathCache.h"
+#include <algorithm>
+#include <functional>
+
+namespace MMAP
+{
+    std::size_t PathCacheKeyHash::operator()(PathCacheKey const& key) const
+    {
+        std::size_t hash = std::hash<dtPolyRef>()(key.StartPoly);
+        hash ^= std::hash<dtPolyRef>()(key.EndPoly) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<uint32>()((uint32(key.IncludeFlags) << 16) | key.ExcludeFlags) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    bool PathCache::Find(PathCacheKey const& key, dtPolyRef* path, uint32& pathLength, uint32 maxPathLength)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto itr = _index.find(key);
+        if (itr == _index.end() || itr->second->Path.size() > maxPathLength)
+        {
+            ++_misses;
+            return false;
+        }
+
+        _entries.splice(_entries.begin(), _entries, itr->second);
+
+        std::vector<dtPolyRef> const& cached = itr->second->Path;
+        std::copy(cached.begin(), cached.end(), path);
+        pathLength = uint32(cached.size());
+        ++_hits;
+        return true;
+    }
+
+    void PathCache::Insert(PathCacheKey const& key, dtPolyRef const* path, uint32 pathLength)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto itr = _index.find(key);
+        if (itr != _index.end())
+        {
+            itr->second->Path.assign(path, path + pathLength);
+            _entries.splice(_entries.begin(), _entries, itr->second);
+            return;
+        }
+
+        if (_entries.size() >= _capacity)
+        {
+            _index.erase(_entries.back().Key);
+            _entries.pop_back();
+        }
+
+        _entries.push_front({ key, std::vector<dtPolyRef>(path, path + pathLength) });
+        _index[key] = _entries.begin();
+    }
+
+    void PathCache::InvalidateTile(dtNavMesh const* navMesh, dtTileRef tileRef)
+    {
+        uint32 tileIndex = navMesh->decodePolyIdTile(tileRef);
+
+        std::lock_guard<std::mutex> guard(_lock);
+
+        for (auto itr = _entries.begin(); itr != _entries.end();)
+        {
+            bool crossesTile = std::any_of(itr->Path.begin(), itr->Path.end(), [&](dtPolyRef ref)
+            {
+                return navMesh->decodePolyIdTile(ref) == tileIndex;
+            });
+
+            if (crossesTile)
+            {
+                _index.erase(itr->Key);
+                itr = _entries.erase(itr);
+            }
+            else
+                ++itr;
+        }
+    }
+
+    void PathCache::Clear()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        _index.clear();
+        _entries.clear();
+    }
+}
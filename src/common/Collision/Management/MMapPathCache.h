@@ -0,0 +1,86 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MMAP_PATH_CACHE_H
+#define _MMAP_PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace MMAP
+{
+    struct PathCacheKey
+    {
+        dtPolyRef StartPoly;
+        dtPolyRef EndPoly;
+        uint16 IncludeFlags;
+        uint16 ExcludeFlags;
+
+        bool operator==(PathCacheKey const& other) const
+        {
+            return StartPoly == other.StartPoly && EndPoly == other.EndPoly &&
+                IncludeFlags == other.IncludeFlags && ExcludeFlags == other.ExcludeFlags;
+        }
+    };
+
+    struct PathCacheKeyHash
+    {
+        std::size_t operator()(PathCacheKey const& key) const;
+    };
+
+    // least recently used poly corridors of one map, shared by all its instances
+    class PathCache
+    {
+    public:
+        explicit PathCache(uint32 capacity) : _capacity(capacity) { }
+
+        // return: true if a corridor was found, copied into path
+        bool Find(PathCacheKey const& key, dtPolyRef* path, uint32& pathLength, uint32 maxPathLength);
+        void Insert(PathCacheKey const& key, dtPolyRef const* path, uint32 pathLength);
+
+        // drops every corridor crossing the given tile
+        void InvalidateTile(dtNavMesh const* navMesh, dtTileRef tileRef);
+        void Clear();
+
+        uint64 TakeHits() { return _hits.exchange(0); }
+        uint64 TakeMisses() { return _misses.exchange(0); }
+
+    private:
+        struct Entry
+        {
+            PathCacheKey Key;
+            std::vector<dtPolyRef> Path;
+        };
+
+        typedef std::list<Entry> EntryList;
+
+        EntryList _entries; // most recently used first
+        std::unordered_map<PathCacheKey, EntryList::iterator, PathCacheKeyHash> _index;
+        std::mutex _lock;
+        uint32 _capacity;
+
+        std::atomic<uint64> _hits{0};
+        std::atomic<uint64> _misses{0};
+    };
+}
+
+#endif
@@ -24,6 +24,7 @@
 #include "WorldModel.h"
 #include <G3D/Vector3.h>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <string>
 
@@ -194,6 +195,58 @@ namespace VMAP
         return true;
     }
 
+    void VMapMgr2::isInLineOfSight(unsigned int mapId, std::vector<LineOfSightQuery>& queries, ModelIgnoreFlags ignoreFlags)
+    {
+        for (LineOfSightQuery& query : queries)
+        {
+            query.InSight = true;
+        }
+
+#if defined(ENABLE_VMAP_CHECKS)
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+        {
+            return;
+        }
+#endif
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            return;
+        }
+
+        std::vector<Vector3> starts;
+        std::vector<Vector3> ends;
+        std::vector<std::size_t> indices;
+        starts.reserve(queries.size());
+        ends.reserve(queries.size());
+        indices.reserve(queries.size());
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            LineOfSightQuery const& query = queries[i];
+            Vector3 pos1 = convertPositionToInternalRep(query.X1, query.Y1, query.Z1);
+            Vector3 pos2 = convertPositionToInternalRep(query.X2, query.Y2, query.Z2);
+            if (pos1 != pos2)
+            {
+                starts.push_back(pos1);
+                ends.push_back(pos2);
+                indices.push_back(i);
+            }
+        }
+
+        if (starts.empty())
+        {
+            return;
+        }
+
+        std::unique_ptr<bool[]> inSight = std::make_unique<bool[]>(starts.size());
+        instanceTree->second->isInLineOfSight(starts.data(), ends.data(), inSight.get(), starts.size(), ignoreFlags);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            queries[indices[i]].InSight = inSight[i];
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -253,6 +306,44 @@ namespace VMAP
         return VMAP_INVALID_HEIGHT_VALUE;
     }
 
+    void VMapMgr2::getHeight(unsigned int mapId, std::vector<HeightQuery>& queries, float maxSearchDist)
+    {
+        for (HeightQuery& query : queries)
+        {
+            query.Height = VMAP_INVALID_HEIGHT_VALUE;
+        }
+
+#if defined(ENABLE_VMAP_CHECKS)
+        if (!isHeightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_HEIGHT))
+        {
+            return;
+        }
+#endif
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end() || queries.empty())
+        {
+            return;
+        }
+
+        std::vector<Vector3> positions;
+        positions.reserve(queries.size());
+        for (HeightQuery const& query : queries)
+        {
+            positions.push_back(convertPositionToInternalRep(query.X, query.Y, query.Z));
+        }
+
+        std::vector<float> heights(queries.size());
+        instanceTree->second->getHeight(positions.data(), heights.data(), positions.size(), maxSearchDist);
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            if (heights[i] < G3D::finf())
+            {
+                queries[i].Height = heights[i];
+            }
+        }
+    }
+
     bool VMapMgr2::GetAreaInfo(uint32 mapId, float x, float y, float& z, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const
     {
 #if defined(ENABLE_VMAP_CHECKS)
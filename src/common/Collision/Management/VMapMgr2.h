@@ -108,11 +108,13 @@ namespace VMAP
         void unloadMap(unsigned int mapId) override;
 
         bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override ;
+        void isInLineOfSight(unsigned int mapId, std::vector<LineOfSightQuery>& queries, ModelIgnoreFlags ignoreFlags) override;
         /**
         fill the hit pos and return true, if an object was hit
         */
         bool GetObjectHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist) override;
         float getHeight(unsigned int mapId, float x, float y, float z, float maxSearchDist) override;
+        void getHeight(unsigned int mapId, std::vector<HeightQuery>& queries, float maxSearchDist) override;
 
         bool processCommand(char* /*command*/) override { return false; } // for debug and extensions
 
@@ -24,8 +24,10 @@
 #include "VMapMgr2.h"
 #include <iomanip>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using G3D::Vector3;
 
@@ -178,6 +180,51 @@ namespace VMAP
 
         return !GetIntersectionTime(ray, maxDist, true, ignoreFlags);
     }
+
+    void StaticMapTree::isInLineOfSight(Vector3 const* starts, Vector3 const* ends, bool* inSight, uint32 count, ModelIgnoreFlags ignoreFlags) const
+    {
+        std::vector<G3D::Ray> rays;
+        std::vector<float> maxDists;
+        std::vector<uint32> indices;
+        rays.reserve(count);
+        maxDists.reserve(count);
+        indices.reserve(count);
+
+        // same edge cases as the single segment check, only the remaining segments are traced
+        for (uint32 i = 0; i < count; ++i)
+        {
+            float maxDist = (ends[i] - starts[i]).magnitude();
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                inSight[i] = false;
+                continue;
+            }
+
+            inSight[i] = true;
+            if (maxDist < 1e-10f)
+            {
+                continue;
+            }
+
+            rays.push_back(G3D::Ray::fromOriginAndDirection(starts[i], (ends[i] - starts[i]) / maxDist));
+            maxDists.push_back(maxDist);
+            indices.push_back(i);
+        }
+
+        if (rays.empty())
+        {
+            return;
+        }
+
+        std::unique_ptr<bool[]> hits = std::make_unique<bool[]>(rays.size());
+        MapRayCallback intersectionCallBack(iTreeValues, ignoreFlags);
+        iTree.intersectRays(rays.data(), maxDists.data(), hits.get(), rays.size(), intersectionCallBack);
+
+        for (std::size_t i = 0; i < rays.size(); ++i)
+        {
+            inSight[indices[i]] = !hits[i];
+        }
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
@@ -242,6 +289,31 @@ namespace VMAP
         return (height);
     }
 
+    void StaticMapTree::getHeight(Vector3 const* positions, float* heights, uint32 count, float maxSearchDist) const
+    {
+        if (!count)
+        {
+            return;
+        }
+
+        std::vector<G3D::Ray> rays;
+        rays.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            rays.emplace_back(positions[i], Vector3(0, 0, -1));
+        }
+
+        std::vector<float> maxDists(count, maxSearchDist);
+        std::unique_ptr<bool[]> hits = std::make_unique<bool[]>(count);
+        MapRayCallback intersectionCallBack(iTreeValues, ModelIgnoreFlags::Nothing);
+        iTree.intersectRaysClosest(rays.data(), maxDists.data(), hits.get(), count, intersectionCallBack);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            heights[i] = hits[i] ? positions[i].z - maxDists[i] : G3D::finf();
+        }
+    }
+
     //=========================================================
 
     LoadResult StaticMapTree::CanLoadMap(const std::string& vmapPath, uint32 mapID, uint32 tileX, uint32 tileY)
@@ -71,8 +71,12 @@ namespace VMAP
         ~StaticMapTree();
 
         [[nodiscard]] bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
+        // batched isInLineOfSight, inSight[i] is the result for the segment starts[i] -> ends[i]
+        void isInLineOfSight(G3D::Vector3 const* starts, G3D::Vector3 const* ends, bool* inSight, uint32 count, ModelIgnoreFlags ignoreFlags) const;
         bool GetObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
         [[nodiscard]] float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
+        // batched getHeight, heights[i] is the result for positions[i] and finf() where nothing was hit
+        void getHeight(G3D::Vector3 const* positions, float* heights, uint32 count, float maxSearchDist) const;
         bool GetAreaInfo(G3D::Vector3& pos, uint32& flags, int32& adtId, int32& rootId, int32& groupId) const;
         bool GetLocationInfo(const G3D::Vector3& pos, LocationInfo& info) const;
 
@@ -20,10 +20,12 @@
 #include "MapDefines.h"
 #include "MapTree.h"
 #include "VMapDefinitions.h"
+#include <atomic>
 #include <boost/filesystem.hpp>
 #include <iomanip>
 #include <set>
 #include <sstream>
+#include <thread>
 
 using G3D::Vector3;
 using G3D::AABox;
@@ -37,6 +39,43 @@ template<> struct BoundsTrait<VMAP::ModelSpawn*>
 
 namespace VMAP
 {
+    namespace
+    {
+        // Calls func for every index in [0, count) on up to threads threads, stops handing out indexes after the first failure
+        template<class Func>
+        bool RunParallel(size_t count, uint32 threads, Func&& func)
+        {
+            std::atomic<size_t> next(0);
+            std::atomic<bool> success(true);
+
+            auto worker = [&]()
+            {
+                for (size_t index = next++; index < count && success; index = next++)
+                {
+                    if (!func(index))
+                    {
+                        success = false;
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (uint32 i = 1; i < std::min<size_t>(std::max<uint32>(threads, 1), count); ++i)
+            {
+                workers.emplace_back(worker);
+            }
+
+            worker();
+
+            for (std::thread& thread : workers)
+            {
+                thread.join();
+            }
+
+            return success;
+        }
+    }
+
     bool readChunk(FILE* rf, char* dest, const char* compare, uint32 len)
     {
         if (fread(dest, sizeof(char), len, rf) != len) { return false; }
@@ -64,7 +103,7 @@ namespace VMAP
         //delete iCoordModelMapping;
     }
 
-    bool TileAssembler::convertWorld2()
+    bool TileAssembler::convertWorld2(uint32 threads)
     {
         bool success = readMapSpawns();
         if (!success)
@@ -72,146 +111,165 @@ namespace VMAP
             return false;
         }
 
-        // export Map data
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end() && success; ++map_iter)
+        // export Map data, the maps are independent of each other
+        std::vector<MapData::value_type*> maps;
+        for (MapData::value_type& map : mapData)
         {
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            UniqueEntryMap::iterator entry;
-            printf("Calculating model bounds for map %u...\n", map_iter->first);
-            for (entry = map_iter->second->UniqueEntries.begin(); entry != map_iter->second->UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
-                if (entry->second.flags & MOD_M2)
-                {
-                    if (!calculateTransformedBound(entry->second))
-                    {
-                        break;
-                    }
-                }
-                else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
-                {
-                    /// @todo remove extractor hack and uncomment below line:
-                    //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
-                    entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
-                }
-                mapSpawns.push_back(&(entry->second));
-                spawnedModelFiles.insert(entry->second.name);
-            }
+            maps.push_back(&map);
+        }
 
-            printf("Creating map tree for map %u...\n", map_iter->first);
-            BIH pTree;
+        std::vector<std::set<std::string>> mapModelFiles(maps.size());
+        success = RunParallel(maps.size(), threads, [&](size_t index)
+        {
+            return convertMap(maps[index]->first, *maps[index]->second, mapModelFiles[index]);
+        });
 
-            try
-            {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::GetBounds);
-            }
-            catch (std::exception& e)
+        for (std::set<std::string> const& modelFiles : mapModelFiles)
+        {
+            spawnedModelFiles.insert(modelFiles.begin(), modelFiles.end());
+        }
+
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        success = RunParallel(modelFiles.size(), threads, [&](size_t index)
+        {
+            printf("Converting %s\n", modelFiles[index].c_str());
+            if (!convertRawFile(modelFiles[index]))
             {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
+                printf("error converting %s\n", modelFiles[index].c_str());
                 return false;
             }
+            return true;
+        }) && success;
 
-            // ===> possibly move this code to StaticMapTree class
-            std::map<uint32, uint32> modelNodeIdx;
-            for (uint32 i = 0; i < mapSpawns.size(); ++i)
-            {
-                modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
-            }
+        //cleanup:
+        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        {
+            delete map_iter->second;
+        }
+        return success;
+    }
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << map_iter->first << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+    bool TileAssembler::convertMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles)
+    {
+        bool success = true;
+
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        UniqueEntryMap::iterator entry;
+        printf("Calculating model bounds for map %u...\n", mapId);
+        for (entry = spawns.UniqueEntries.begin(); entry != spawns.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, i still think they're not used for LoS at all on retail
+            if (entry->second.flags & MOD_M2)
             {
-                success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
+                if (!calculateTransformedBound(entry->second))
+                {
+                    break;
+                }
             }
-
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) { success = false; }
-            uint32 globalTileID = StaticMapTree::packTileID(65, 65);
-            pair<TileMap::iterator, TileMap::iterator> globalRange = map_iter->second->TileEntries.equal_range(globalTileID);
-            char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
-            if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) { success = false; }
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) { success = false; }
-            if (success) { success = pTree.writeToFile(mapfile); }
-            // global map spawns (WDT), if any (most instances)
-            if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) { success = false; }
-
-            for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
+            else if (entry->second.flags & MOD_WORLDSPAWN) // WMO maps and terrain maps use different origin, so we need to adapt :/
             {
-                success = ModelSpawn::writeToFile(mapfile, map_iter->second->UniqueEntries[glob->second]);
+                /// @todo remove extractor hack and uncomment below line:
+                //entry->second.iPos += Vector3(533.33333f*32, 533.33333f*32, 0.f);
+                entry->second.iBound = entry->second.iBound + Vector3(533.33333f * 32, 533.33333f * 32, 0.f);
             }
+            mapSpawns.push_back(&(entry->second));
+            modelFiles.insert(entry->second.name);
+        }
 
-            fclose(mapfile);
+        printf("Creating map tree for map %u...\n", mapId);
+        BIH pTree;
 
-            // <====
+        try
+        {
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::GetBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build", e.what());
+            return false;
+        }
 
-            // write map tile files, similar to ADT files, only with extra BSP tree node info
-            TileMap& tileEntries = map_iter->second->TileEntries;
-            TileMap::iterator tile;
-            for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
-            {
-                const ModelSpawn& spawn = map_iter->second->UniqueEntries[tile->second];
-                if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
-                {
-                    continue;
-                }
-                uint32 nSpawns = tileEntries.count(tile->first);
-                std::stringstream tilefilename;
-                tilefilename.fill('0');
-                tilefilename << iDestDir << '/' << std::setw(3) << map_iter->first << '_';
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tile->first, x, y);
-                tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
-                if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
-                {
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) { success = false; }
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) { success = false; }
-                    // write tile spawns
-                    for (uint32 s = 0; s < nSpawns; ++s)
-                    {
-                        if (s)
-                        {
-                            ++tile;
-                        }
-                        const ModelSpawn& spawn2 = map_iter->second->UniqueEntries[tile->second];
-                        success = success && ModelSpawn::writeToFile(tilefile, spawn2);
-                        // MapTree nodes to update when loading tile:
-                        std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
-                        if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) { success = false; }
-                    }
-                    fclose(tilefile);
-                }
-            }
-            // break; //test, extract only first map; TODO: remvoe this line
+        // ===> possibly move this code to StaticMapTree class
+        std::map<uint32, uint32> modelNodeIdx;
+        for (uint32 i = 0; i < mapSpawns.size(); ++i)
+        {
+            modelNodeIdx.insert(pair<uint32, uint32>(mapSpawns[i]->ID, i));
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::set<std::string>::iterator mfile = spawnedModelFiles.begin(); mfile != spawnedModelFiles.end(); ++mfile)
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(3) << mapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
         {
-            std::cout << "Converting " << *mfile << std::endl;
-            if (!convertRawFile(*mfile))
-            {
-                std::cout << "error converting " << *mfile << std::endl;
-                success = false;
-                break;
-            }
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
         }
 
-        //cleanup:
-        for (MapData::iterator map_iter = mapData.begin(); map_iter != mapData.end(); ++map_iter)
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) { success = false; }
+        uint32 globalTileID = StaticMapTree::packTileID(65, 65);
+        pair<TileMap::iterator, TileMap::iterator> globalRange = spawns.TileEntries.equal_range(globalTileID);
+        char isTiled = globalRange.first == globalRange.second; // only maps without terrain (tiles) have global WMO
+        if (success && fwrite(&isTiled, sizeof(char), 1, mapfile) != 1) { success = false; }
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) { success = false; }
+        if (success) { success = pTree.writeToFile(mapfile); }
+        // global map spawns (WDT), if any (most instances)
+        if (success && fwrite("GOBJ", 4, 1, mapfile) != 1) { success = false; }
+
+        for (TileMap::iterator glob = globalRange.first; glob != globalRange.second && success; ++glob)
         {
-            delete map_iter->second;
+            success = ModelSpawn::writeToFile(mapfile, spawns.UniqueEntries[glob->second]);
+        }
+
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BSP tree node info
+        TileMap& tileEntries = spawns.TileEntries;
+        TileMap::iterator tile;
+        for (tile = tileEntries.begin(); tile != tileEntries.end(); ++tile)
+        {
+            const ModelSpawn& spawn = spawns.UniqueEntries[tile->second];
+            if (spawn.flags & MOD_WORLDSPAWN) // WDT spawn, saved as tile 65/65 currently...
+            {
+                continue;
+            }
+            uint32 nSpawns = tileEntries.count(tile->first);
+            std::stringstream tilefilename;
+            tilefilename.fill('0');
+            tilefilename << iDestDir << '/' << std::setw(3) << mapId << '_';
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tile->first, x, y);
+            tilefilename << std::setw(2) << x << '_' << std::setw(2) << y << ".vmtile";
+            if (FILE* tilefile = fopen(tilefilename.str().c_str(), "wb"))
+            {
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tilefile) != 8) { success = false; }
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tilefile) != 1) { success = false; }
+                // write tile spawns
+                for (uint32 s = 0; s < nSpawns; ++s)
+                {
+                    if (s)
+                    {
+                        ++tile;
+                    }
+                    const ModelSpawn& spawn2 = spawns.UniqueEntries[tile->second];
+                    success = success && ModelSpawn::writeToFile(tilefile, spawn2);
+                    // MapTree nodes to update when loading tile:
+                    std::map<uint32, uint32>::iterator nIdx = modelNodeIdx.find(spawn2.ID);
+                    if (success && fwrite(&nIdx->second, sizeof(uint32), 1, tilefile) != 1) { success = false; }
+                }
+                fclose(tilefile);
+            }
         }
         return success;
     }
@@ -102,7 +102,9 @@ namespace VMAP
         TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
         virtual ~TileAssembler();
 
-        bool convertWorld2();
+        /// Maps and models are converted on up to threads threads
+        bool convertWorld2(uint32 threads = 1);
+        bool convertMap(uint32 mapId, MapSpawns& spawns, std::set<std::string>& modelFiles);
         bool readMapSpawns();
         bool calculateTransformedBound(ModelSpawn& spawn);
         void exportGameobjectModels();
@@ -22,7 +22,9 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #if AC_PLATFORM == AC_PLATFORM_WINDOWS
 #include <ws2tcpip.h>
@@ -85,6 +87,9 @@ enum LocaleConstant
 
 AC_COMMON_API extern char const* localeNames[TOTAL_LOCALES];
 
+// Text of a *_locale table field by LocaleConstant, the views point into ObjectMgr's locale string pool
+typedef std::vector<std::string_view> LocaleStrings;
+
 AC_COMMON_API LocaleConstant GetLocaleByName(const std::string& name);
 AC_COMMON_API void CleanStringForMysqlQuery(std::string& str);
 
@@ -27,12 +27,16 @@ public:
     AuthCrypt() = default;
 
     void Init(SessionKey const& K);
+    /// Client side of the connection: sends with the key the server receives with and the other way around
+    void InitClient(SessionKey const& K);
     void DecryptRecv(uint8* data, size_t len);
     void EncryptSend(uint8* data, size_t len);
 
     bool IsInitialized() const { return _initialized; }
 
 private:
+    void Init(SessionKey const& K, uint8 const (&sendKey)[16], uint8 const (&recvKey)[16]);
+
     Acore::Crypto::ARC4 _clientDecrypt;
     Acore::Crypto::ARC4 _serverEncrypt;
     bool _initialized{ false };
@@ -49,6 +49,9 @@ namespace Acore::Crypto
             return (verifier == CalculateVerifier(username, password, salt));
         }
 
+        // K = interleaved SHA1 of S, the client computes the same key from its own S
+        static SessionKey SHA1Interleave(EphemeralKey const& S);
+
         static SHA1::Digest GetSessionVerifier(EphemeralKey const& A, SHA1::Digest const& clientM, SessionKey const& K)
         {
             return SHA1::GetDigestOf(A, clientM, K);
@@ -61,7 +64,6 @@ namespace Acore::Crypto
         bool _used = false; // a single instance can only be used to verify once
 
         static Verifier CalculateVerifier(std::string const& username, std::string const& password, Salt const& salt);
-        static SessionKey SHA1Interleave(EphemeralKey const& S);
 
         /* global algorithm parameters */
         static BigNumber const _g; // a [g]enerator for the ring of integers mod N, algorithm parameter
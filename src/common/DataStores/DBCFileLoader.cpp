@@ -17,72 +17,66 @@
 
 #include "DBCFileLoader.h"
 #include "Errors.h"
-#include <stdio.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <string.h>
 
+namespace
+{
+    // magic, record count, field count, record size, string size
+    constexpr std::size_t HEADER_SIZE = 5 * sizeof(uint32);
+}
+
 DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
 
 bool DBCFileLoader::Load(char const* filename, char const* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
-
-    FILE* f = fopen(filename, "rb");
-    if (!f)
-    {
-        return false;
-    }
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
-    {
-        fclose(f);
-        return false;
-    }
+    data = nullptr;
+    stringTable = nullptr;
+    region.reset();
 
-    EndianConvert(header);
-
-    if (header != 0x43424457)                                //'WDBC'
+    // map the file instead of reading it, stores with a fixed layout use the records in place
+    try
     {
-        fclose(f);
-        return false;
+        boost::interprocess::file_mapping file(filename, boost::interprocess::read_only);
+        region = std::make_unique<boost::interprocess::mapped_region>(file, boost::interprocess::copy_on_write);
     }
-
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
+    catch (boost::interprocess::interprocess_exception const&)
     {
-        fclose(f);
         return false;
     }
 
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
+    std::size_t const fileSize = region->get_size();
+    unsigned char const* file = static_cast<unsigned char const*>(region->get_address());
+    if (fileSize < HEADER_SIZE)
     {
-        fclose(f);
+        region.reset();
         return false;
     }
 
-    EndianConvert(fieldCount);
+    uint32 header[5];
+    memcpy(header, file, HEADER_SIZE);
+    for (uint32& field : header)
+        EndianConvert(field);
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
+    if (header[0] != 0x43424457)                                //'WDBC'
     {
-        fclose(f);
+        region.reset();
         return false;
     }
 
-    EndianConvert(recordSize);
+    recordCount = header[1];                                    // Number of records
+    fieldCount = header[2];                                     // Number of fields
+    recordSize = header[3];                                     // Size of a record
+    stringSize = header[4];                                     // String size
 
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
+    if (fileSize < HEADER_SIZE + uint64(recordSize) * recordCount + stringSize)
     {
-        fclose(f);
+        region.reset();
         return false;
     }
 
-    EndianConvert(stringSize);
-
+    delete[] fieldsOffset;
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
 
@@ -99,24 +93,14 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
         }
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = static_cast<unsigned char*>(region->get_address()) + HEADER_SIZE;
     stringTable = data + recordSize * recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
     delete[] fieldsOffset;
 }
 
@@ -330,3 +314,69 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 
     return stringPool;
 }
+
+bool DBCFileLoader::HasStructureLayout(char const* format) const
+{
+    if (!data || strlen(format) != fieldCount)
+    {
+        return false;
+    }
+
+    for (uint32 x = 0; format[x]; ++x)
+    {
+        switch (format[x])
+        {
+            case FT_FLOAT:
+            case FT_INT:
+            case FT_IND:
+            case FT_BYTE:
+                break;
+            default:
+                return false;
+        }
+    }
+
+    // records are used as structures, keep them aligned
+    return GetFormatRecordSize(format) == recordSize && recordSize % sizeof(uint32) == 0;
+}
+
+char** DBCFileLoader::AutoProduceIndex(char const* format, uint32& records)
+{
+    typedef char* ptr;
+    ASSERT(HasStructureLayout(format));
+
+    int32 i;
+    GetFormatRecordSize(format, &i);
+
+    if (i >= 0)
+    {
+        uint32 maxi = 0;
+        //find max index
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            uint32 ind = getRecord(y).getUInt(i);
+            if (ind > maxi)
+            {
+                maxi = ind;
+            }
+        }
+
+        ++maxi;
+        records = maxi;
+    }
+    else
+    {
+        records = recordCount;
+    }
+
+    ptr* indexTable = new ptr[records];
+    memset(indexTable, 0, records * sizeof(ptr));
+
+    for (uint32 y = 0; y < recordCount; ++y)
+    {
+        char* record = reinterpret_cast<char*>(data + y * recordSize);
+        indexTable[i >= 0 ? getRecord(y).getUInt(i) : y] = record;
+    }
+
+    return indexTable;
+}
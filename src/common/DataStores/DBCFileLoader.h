@@ -21,6 +21,12 @@
 #include "Define.h"
 #include "Errors.h"
 #include "Utilities/ByteConverter.h"
+#include <memory>
+
+namespace boost::interprocess
+{
+    class mapped_region;
+}
 
 enum DbcFieldFormat
 {
@@ -96,6 +102,14 @@ public:
     char* AutoProduceStrings(char const* fmt, char* dataTable);
     static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
 
+    // True if the records of the file have the layout of the structure described by fmt:
+    // only 4 byte numbers, bytes and an index column, no strings and no skipped columns
+    [[nodiscard]] bool HasStructureLayout(char const* fmt) const;
+
+    // Index table pointing straight into the mapped file, only for HasStructureLayout formats.
+    // The records stay valid as long as this loader exists.
+    char** AutoProduceIndex(char const* fmt, uint32& count);
+
 private:
     uint32 recordSize;
     uint32 recordCount;
@@ -105,6 +119,9 @@ private:
     unsigned char* data;
     unsigned char* stringTable;
 
+    // copy on write mapping of the whole file, data and stringTable point into it
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+
     DBCFileLoader(DBCFileLoader const& right) = delete;
     DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
 };
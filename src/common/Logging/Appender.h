@@ -42,6 +42,8 @@ public:
     void write(LogMessage* message);
     static char const* getLogLevelString(LogLevel level);
     virtual void setRealmId(uint32 /*realmId*/) { }
+    // called after every batch of asynchronously written messages
+    virtual void Flush() { }
 
 private:
     virtual void _write(LogMessage const* /*message*/) = 0;
@@ -115,10 +115,20 @@ void AppenderFile::_write(LogMessage const* message)
     }
 
     fprintf(logfile, "%s%s\n", message->prefix.c_str(), message->text.c_str());
-    fflush(logfile);
+
+    // asynchronous logging flushes once per batch
+    if (!sLog->IsAsync())
+        fflush(logfile);
+
     _fileSize += uint64(message->Size());
 }
 
+void AppenderFile::Flush()
+{
+    if (logfile)
+        fflush(logfile);
+}
+
 FILE* AppenderFile::OpenFile(std::string const& filename, std::string const& mode, bool backup)
 {
     std::string fullName(_logDir + filename);
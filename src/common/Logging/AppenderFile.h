@@ -30,6 +30,7 @@ public:
     ~AppenderFile();
     FILE* OpenFile(std::string const& name, std::string const& mode, bool backup);
     AppenderType getType() const override { return type; }
+    void Flush() override;
 
 private:
     void CloseFile();
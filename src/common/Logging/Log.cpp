@@ -22,7 +22,6 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "LogMessage.h"
-#include "LogOperation.h"
 #include "Logger.h"
 #include "Strand.h"
 #include "StringConvert.h"
@@ -30,7 +29,7 @@
 #include "Tokenize.h"
 #include <chrono>
 
-Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL)
+Log::Log() : AppenderId(0), highestLogLevel(LOG_LEVEL_FATAL), _filterGeneration(1), _ioContext(nullptr), _strand(nullptr), _droppedMessages(0), _maxQueuedMessages(0)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -244,13 +243,56 @@ void Log::write(std::unique_ptr<LogMessage>&& msg) const
 
     if (_ioContext)
     {
-        std::shared_ptr<LogOperation> logOperation = std::make_shared<LogOperation>(logger, std::move(msg));
-        Acore::Asio::post(*_ioContext, Acore::Asio::bind_executor(*_strand, [logOperation]() { logOperation->call(); }));
+        bool startBatch;
+        {
+            std::lock_guard<std::mutex> lock(_queueLock);
+
+            // errors and warnings are always kept
+            if (_maxQueuedMessages && _queuedMessages.size() >= _maxQueuedMessages && msg->level >= LOG_LEVEL_INFO)
+            {
+                ++_droppedMessages;
+                return;
+            }
+
+            // one strand task per batch, later messages join the queue until it runs
+            startBatch = _queuedMessages.empty();
+            _queuedMessages.push_back({ logger, std::move(msg) });
+        }
+
+        if (startBatch)
+            Acore::Asio::post(*_ioContext, Acore::Asio::bind_executor(*_strand, [this]() { WriteQueuedMessages(); }));
     }
     else
         logger->write(msg.get());
 }
 
+void Log::WriteQueuedMessages() const
+{
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        _writtenMessages.swap(_queuedMessages);
+    }
+
+    for (QueuedMessage const& queued : _writtenMessages)
+        queued.Target->write(queued.Message.get());
+
+    _writtenMessages.clear();
+
+    for (auto const& [id, appender] : appenders)
+        appender->Flush();
+}
+
+std::size_t Log::GetQueuedMessageCount() const
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    return _queuedMessages.size();
+}
+
+uint64 Log::TakeDroppedMessageCount()
+{
+    return _droppedMessages.exchange(0);
+}
+
 Logger const* Log::GetLoggerByType(std::string const& type) const
 {
     auto it = loggers.find(type);
@@ -274,6 +316,12 @@ Logger const* Log::GetLoggerByType(std::string const& type) const
     return GetLoggerByType(parentLogger);
 }
 
+LogLevel Log::GetLoggerLevel(std::string const& type) const
+{
+    Logger const* logger = GetLoggerByType(type);
+    return logger ? logger->getLogLevel() : LOG_LEVEL_DISABLED;
+}
+
 std::string Log::GetTimestampStr()
 {
     return Acore::Time::TimeToTimestampStr(GetEpochTime(), "%Y-%m-%d_%H_%M_%S");
@@ -302,6 +350,7 @@ bool Log::SetLogLevel(std::string const& name, int32 newLeveli, bool isLogger /*
         }
 
         it->second->setLogLevel(newLevel);
+        ++_filterGeneration;
 
         if (newLevel != LOG_LEVEL_DISABLED && newLevel > highestLogLevel)
         {
@@ -334,13 +383,12 @@ void Log::Close()
 {
     loggers.clear();
     appenders.clear();
+    ++_filterGeneration;
 }
 
 bool Log::ShouldLog(std::string const& type, LogLevel level) const
 {
-    /// @todo: Use cache to store "Type.sub1.sub2": "Type" equivalence, should
-    // Speed up in cases where requesting "Type.sub1.sub2" but only configured
-    // Logger "Type"
+    // LOG_* call sites with a literal filter type skip the lookup through their LogFilterCache
 
     // Don't even look for a logger if the LogLevel is higher than the highest log levels across all loggers
     if (level > highestLogLevel)
@@ -377,6 +425,10 @@ void Log::Initialize(Acore::Asio::IoContext* ioContext)
 
 void Log::SetSynchronous()
 {
+    // the io context is stopped, nothing else writes the last batch
+    if (_ioContext)
+        WriteQueuedMessages();
+
     delete _strand;
     _strand = nullptr;
     _ioContext = nullptr;
@@ -398,4 +450,7 @@ void Log::LoadFromConfig()
 
     ReadAppendersFromConfig();
     ReadLoggersFromConfig();
+    ++_filterGeneration;
+
+    _maxQueuedMessages = sConfigMgr->GetOption<uint32>("Log.Async.QueueSize", 0, false);
 }
@@ -21,7 +21,9 @@
 #include "Define.h"
 #include "LogCommon.h"
 #include "StringFormat.h"
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -37,6 +39,18 @@ namespace Acore::Asio
 
 #define LOGGER_ROOT "root"
 
+// Most verbose level compiled into the LOG_* macros, set with the LOG_COMPILE_LEVEL CMake option
+#ifndef ACORE_LOG_COMPILE_LEVEL
+#define ACORE_LOG_COMPILE_LEVEL LOG_LEVEL_TRACE
+#endif
+
+// Level of the logger a LOG_* call site writes to, resolved once per configuration
+struct LogFilterCache
+{
+    std::atomic<uint32> Generation{ 0 };
+    std::atomic<LogLevel> Level{ LOG_LEVEL_DISABLED };
+};
+
 typedef Appender*(*AppenderCreatorFn)(uint8 id, std::string const& name, LogLevel level, AppenderFlags flags, std::vector<std::string_view> const& extraArgs);
 
 template <class AppenderImpl>
@@ -65,6 +79,32 @@ public:
     void LoadFromConfig();
     void Close();
     [[nodiscard]] bool ShouldLog(std::string const& type, LogLevel level) const;
+
+    // Call sites with a literal filter type keep the logger level in their cache
+    template<std::size_t N>
+    [[nodiscard]] bool ShouldLog(LogFilterCache& cache, char const (&type)[N], LogLevel level) const
+    {
+        if (level > highestLogLevel)
+        {
+            return false;
+        }
+
+        uint32 const generation = _filterGeneration.load(std::memory_order_acquire);
+        if (cache.Generation.load(std::memory_order_acquire) != generation)
+        {
+            cache.Level.store(GetLoggerLevel(type), std::memory_order_relaxed);
+            cache.Generation.store(generation, std::memory_order_release);
+        }
+
+        LogLevel const logLevel = cache.Level.load(std::memory_order_relaxed);
+        return logLevel != LOG_LEVEL_DISABLED && logLevel >= level;
+    }
+
+    [[nodiscard]] bool ShouldLog(LogFilterCache& /*cache*/, std::string const& type, LogLevel level) const
+    {
+        return ShouldLog(type, level);
+    }
+
     bool SetLogLevel(std::string const& name, int32 level, bool isLogger = true);
 
     template<typename... Args>
@@ -95,11 +135,26 @@ public:
     [[nodiscard]] std::string const& GetLogsDir() const { return m_logsDir; }
     [[nodiscard]] std::string const& GetLogsTimestamp() const { return m_logsTimestamp; }
 
+    // messages are queued and written in batches on the io context, appenders flush once per batch
+    [[nodiscard]] bool IsAsync() const { return _ioContext != nullptr; }
+    // messages waiting to be written
+    [[nodiscard]] std::size_t GetQueuedMessageCount() const;
+    // messages dropped since the last call because more than Log.Async.QueueSize were waiting
+    uint64 TakeDroppedMessageCount();
+
 private:
+    struct QueuedMessage
+    {
+        Logger const* Target;
+        std::unique_ptr<LogMessage> Message;
+    };
+
     static std::string GetTimestampStr();
     void write(std::unique_ptr<LogMessage>&& msg) const;
+    void WriteQueuedMessages() const;
 
     [[nodiscard]] Logger const* GetLoggerByType(std::string const& type) const;
+    [[nodiscard]] LogLevel GetLoggerLevel(std::string const& type) const;
     Appender* GetAppenderByName(std::string_view name);
     uint8 NextAppenderId();
     void CreateAppenderFromConfig(std::string const& name);
@@ -115,12 +170,21 @@ private:
     std::unordered_map<std::string, std::unique_ptr<Logger>> loggers;
     uint8 AppenderId;
     LogLevel highestLogLevel;
+    // changed whenever a logger level may have changed, invalidates every LogFilterCache
+    std::atomic<uint32> _filterGeneration;
 
     std::string m_logsDir;
     std::string m_logsTimestamp;
 
     Acore::Asio::IoContext* _ioContext;
     Acore::Asio::Strand* _strand;
+
+    // filled by the logging threads, swapped with _writtenMessages by the strand so both keep their capacity
+    mutable std::mutex _queueLock;
+    mutable std::vector<QueuedMessage> _queuedMessages;
+    mutable std::vector<QueuedMessage> _writtenMessages;
+    mutable std::atomic<uint64> _droppedMessages;
+    uint32 _maxQueuedMessages;
 };
 
 #define sLog Log::instance()
@@ -141,11 +205,13 @@ private:
 #ifdef PERFORMANCE_PROFILING
 #define LOG_MESSAGE_BODY(filterType__, level__, ...) ((void)0)
 #else
-#define LOG_MESSAGE_BODY(filterType__, level__, ...)                        \
-        do                                                              \
-        {                                                               \
-            if (sLog->ShouldLog(filterType__, level__))                 \
-                LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__); \
+#define LOG_MESSAGE_BODY(filterType__, level__, ...)                                    \
+        do                                                                          \
+        {                                                                           \
+            static LogFilterCache logFilterCache__;                                 \
+            if ((level__) <= ACORE_LOG_COMPILE_LEVEL &&                             \
+                sLog->ShouldLog(logFilterCache__, filterType__, level__))           \
+                LOG_EXCEPTION_FREE(filterType__, level__, __VA_ARGS__);             \
         } while (0)
 #endif
 
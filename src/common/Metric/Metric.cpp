@@ -19,6 +19,7 @@
 #include "Config.h"
 #include "DeadlineTimer.h"
 #include "Log.h"
+#include "MetricExporter.h"
 #include "Strand.h"
 #include "Tokenize.h"
 #include <boost/algorithm/string/replace.hpp>
@@ -45,6 +46,7 @@ void Metric::Initialize(std::string const& realmName, Acore::Asio::IoContext& io
     _batchTimer = std::make_unique<Acore::Asio::DeadlineTimer>(ioContext);
     _overallStatusTimer = std::make_unique<Acore::Asio::DeadlineTimer>(ioContext);
     _overallStatusLogger = overallStatusLogger;
+    _ioContext = &ioContext;
     LoadFromConfigs();
 }
 
@@ -95,6 +97,8 @@ void Metric::LoadFromConfigs()
         _thresholds[thresholdName] = thresholdValue;
     }
 
+    LoadExporterFromConfigs();
+
     // Schedule a send at this point only if the config changed from Disabled to Enabled.
     // Cancel any scheduled operation if the config changed from Enabled to Disabled.
     if (_enabled && !previousValue)
@@ -123,6 +127,20 @@ void Metric::LoadFromConfigs()
     }
 }
 
+void Metric::LoadExporterFromConfigs()
+{
+    // the acceptor runs on the io threads, it is only started once and stopped on shutdown
+    if (!_ioContext || _exporter || !sConfigMgr->GetOption<bool>("Metric.Exporter.Enable", false))
+        return;
+
+    std::string bindIp = sConfigMgr->GetOption<std::string>("Metric.Exporter.BindIP", "127.0.0.1");
+    uint32 port = sConfigMgr->GetOption<uint32>("Metric.Exporter.Port", 9464);
+
+    auto exporter = std::make_unique<MetricExporter>(*_ioContext);
+    if (exporter->Start(bindIp, uint16(port)))
+        _exporter = std::move(exporter);
+}
+
 void Metric::Update()
 {
     if (_overallStatusTimerTriggered)
@@ -274,6 +292,7 @@ void Metric::Unload()
 
     _batchTimer->cancel();
     _overallStatusTimer->cancel();
+    _exporter.reset();
 }
 
 void Metric::ScheduleOverallStatusLog()
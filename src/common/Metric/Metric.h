@@ -41,6 +41,8 @@ enum MetricDataType
     METRIC_DATA_EVENT
 };
 
+class MetricExporter;
+
 typedef std::pair<std::string, std::string> MetricTag;
 
 struct MetricData
@@ -76,11 +78,14 @@ private:
     std::function<void()> _overallStatusLogger;
     std::string _realmName;
     std::unordered_map<std::string, int64> _thresholds;
+    Acore::Asio::IoContext* _ioContext = nullptr;
+    std::unique_ptr<MetricExporter> _exporter;
 
     bool Connect();
     void SendBatch();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
+    void LoadExporterFromConfigs();
 
     static std::string FormatInfluxDBValue(bool value);
 
@@ -127,6 +132,8 @@ public:
 
     void Unload();
     bool IsEnabled() const { return _enabled; }
+    // the pull exporter serves the MetricRegistry, independent of the InfluxDB batches
+    bool IsExporterEnabled() const { return _exporter != nullptr; }
 };
 
 #define sMetric Metric::instance()
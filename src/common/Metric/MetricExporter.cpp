@@ -0,0 +1,149 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricExporter.h"
+#include "IoContext.h"
+#include "IpAddress.h"
+#include "Log.h"
+#include "MetricRegistry.h"
+#include "StringFormat.h"
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+namespace
+{
+    // scrapers send a few hundred bytes, anything larger is not a scrape
+    constexpr std::size_t MAX_REQUEST_SIZE = 4096;
+
+    class ExporterConnection : public std::enable_shared_from_this<ExporterConnection>
+    {
+    public:
+        explicit ExporterConnection(boost::asio::ip::tcp::socket&& socket) : _socket(std::move(socket)), _request(MAX_REQUEST_SIZE) { }
+
+        void Start()
+        {
+            boost::asio::async_read_until(_socket, _request, "\r\n\r\n",
+                [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*length*/)
+            {
+                if (!error)
+                    self->HandleRequest();
+            });
+        }
+
+    private:
+        void HandleRequest()
+        {
+            std::string requestLine;
+            std::istream stream(&_request);
+            std::getline(stream, requestLine);
+
+            std::string body;
+            char const* status;
+            char const* contentType = "text/plain; charset=utf-8";
+            if (requestLine.rfind("GET /metrics ", 0) == 0)
+            {
+                status = "200 OK";
+                contentType = "text/plain; version=0.0.4; charset=utf-8";
+                sMetricRegistry->Serialize(body);
+            }
+            else if (requestLine.rfind("GET ", 0) == 0)
+            {
+                status = "404 Not Found";
+                body = "Metrics are served at /metrics\n";
+            }
+            else
+            {
+                status = "405 Method Not Allowed";
+            }
+
+            _response = Acore::StringFormatFmt("HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n", status, contentType, body.size());
+            _response += body;
+
+            boost::asio::async_write(_socket, boost::asio::buffer(_response),
+                [self = shared_from_this()](boost::system::error_code const& /*error*/, std::size_t /*length*/)
+            {
+                boost::system::error_code ignored;
+                self->_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+                self->_socket.close(ignored);
+            });
+        }
+
+        boost::asio::ip::tcp::socket _socket;
+        boost::asio::streambuf _request;
+        std::string _response;
+    };
+}
+
+MetricExporter::MetricExporter(Acore::Asio::IoContext& ioContext) : _acceptor(ioContext)
+{
+}
+
+MetricExporter::~MetricExporter()
+{
+    Stop();
+}
+
+bool MetricExporter::Start(std::string const& bindIp, uint16 port)
+{
+    boost::system::error_code error;
+    boost::asio::ip::tcp::endpoint endpoint(Acore::Net::make_address(bindIp, error), port);
+    if (error)
+    {
+        LOG_ERROR("metric", "Invalid metric exporter address '{}': {}", bindIp, error.message());
+        return false;
+    }
+
+    _acceptor.open(endpoint.protocol(), error);
+    if (!error)
+        _acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), error);
+    if (!error)
+        _acceptor.bind(endpoint, error);
+    if (!error)
+        _acceptor.listen(boost::asio::socket_base::max_listen_connections, error);
+
+    if (error)
+    {
+        LOG_ERROR("metric", "Could not start the metric exporter on {}:{}: {}", bindIp, port, error.message());
+        Stop();
+        return false;
+    }
+
+    LOG_INFO("metric", "Metric exporter listening on {}:{}", bindIp, port);
+    AsyncAccept();
+    return true;
+}
+
+void MetricExporter::Stop()
+{
+    boost::system::error_code ignored;
+    _acceptor.close(ignored);
+}
+
+void MetricExporter::AsyncAccept()
+{
+    _acceptor.async_accept([this](boost::system::error_code const& error, boost::asio::ip::tcp::socket socket)
+    {
+        if (error == boost::asio::error::operation_aborted || !_acceptor.is_open())
+            return;
+
+        if (!error)
+            std::make_shared<ExporterConnection>(std::move(socket))->Start();
+
+        AsyncAccept();
+    });
+}
@@ -15,27 +15,36 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef LOGOPERATION_H
-#define LOGOPERATION_H
+#ifndef METRIC_EXPORTER_H__
+#define METRIC_EXPORTER_H__
 
 #include "Define.h"
+#include <boost/asio/ip/tcp.hpp>
 #include <memory>
+#include <string>
 
-class Logger;
-struct LogMessage;
+namespace Acore::Asio
+{
+    class IoContext;
+}
 
-class LogOperation
+/*
+ * Serves the MetricRegistry over HTTP for Prometheus and other OpenMetrics scrapers.
+ * Every connection gets one response to GET /metrics and is closed afterwards.
+ */
+class AC_COMMON_API MetricExporter
 {
 public:
-    LogOperation(Logger const* _logger, std::unique_ptr<LogMessage>&& _msg);
+    explicit MetricExporter(Acore::Asio::IoContext& ioContext);
+    ~MetricExporter();
 
-    ~LogOperation();
+    bool Start(std::string const& bindIp, uint16 port);
+    void Stop();
 
-    int call();
+private:
+    void AsyncAccept();
 
-protected:
-    Logger const* logger;
-    std::unique_ptr<LogMessage> msg;
+    boost::asio::ip::tcp::acceptor _acceptor;
 };
 
-#endif
+#endif // METRIC_EXPORTER_H__
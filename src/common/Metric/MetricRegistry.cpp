@@ -0,0 +1,221 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricRegistry.h"
+#include "Errors.h"
+#include "StringFormat.h"
+#include <algorithm>
+
+namespace
+{
+    void AppendEscaped(std::string& out, std::string const& value, bool escapeQuotes)
+    {
+        for (char c : value)
+        {
+            switch (c)
+            {
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '"':
+                    out += escapeQuotes ? "\\\"" : "\"";
+                    break;
+                default:
+                    out += c;
+                    break;
+            }
+        }
+    }
+
+    // name="value",... without the braces, a histogram appends its le label
+    std::string FormatLabels(std::vector<Acore::Metrics::MetricLabel> const& labels)
+    {
+        std::string formatted;
+        for (Acore::Metrics::MetricLabel const& label : labels)
+        {
+            if (!formatted.empty())
+                formatted += ',';
+
+            formatted += label.first;
+            formatted += "=\"";
+            AppendEscaped(formatted, label.second, true);
+            formatted += '"';
+        }
+
+        return formatted;
+    }
+
+    void AppendSample(std::string& out, std::string const& name, std::string const& labels, std::string_view value)
+    {
+        out += name;
+        if (!labels.empty())
+        {
+            out += '{';
+            out += labels;
+            out += '}';
+        }
+
+        out += ' ';
+        out += value;
+        out += '\n';
+    }
+
+    char const* GetTypeName(Acore::Metrics::MetricType type)
+    {
+        switch (type)
+        {
+            case Acore::Metrics::MetricType::Counter:
+                return "counter";
+            case Acore::Metrics::MetricType::Gauge:
+                return "gauge";
+            case Acore::Metrics::MetricType::Histogram:
+                return "histogram";
+        }
+
+        return "untyped";
+    }
+}
+
+namespace Acore::Metrics
+{
+    Histogram::Histogram(std::vector<double> bounds) : _bounds(std::move(bounds)), _buckets(new std::atomic<uint64>[_bounds.size() + 1]), _count(0), _sum(0.0)
+    {
+        std::sort(_bounds.begin(), _bounds.end());
+        for (std::size_t i = 0; i <= _bounds.size(); ++i)
+            _buckets[i].store(0, std::memory_order_relaxed);
+    }
+
+    void Histogram::Observe(double value)
+    {
+        // few buckets, a linear search beats a binary one
+        std::size_t index = 0;
+        while (index < _bounds.size() && value > _bounds[index])
+            ++index;
+
+        _buckets[index].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+
+        double sum = _sum.load(std::memory_order_relaxed);
+        while (!_sum.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed))
+            ;
+    }
+
+    MetricRegistry* MetricRegistry::instance()
+    {
+        static MetricRegistry instance;
+        return &instance;
+    }
+
+    MetricRegistry::Series& MetricRegistry::GetSeries(std::string const& name, std::string const& help, MetricType type, std::vector<MetricLabel> const& labels)
+    {
+        Family*& family = _familiesByName[name];
+        if (!family)
+        {
+            family = _families.emplace_back(std::make_unique<Family>()).get();
+            family->Name = name;
+            family->Help = help;
+            family->Type = type;
+        }
+
+        ASSERT(family->Type == type, "Metric {} registered with two different types", name);
+        return family->Values[FormatLabels(labels)];
+    }
+
+    Counter& MetricRegistry::GetCounter(std::string const& name, std::string const& help, std::vector<MetricLabel> const& labels)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        Series& series = GetSeries(name, help, MetricType::Counter, labels);
+        if (!series.CounterValue)
+            series.CounterValue = std::make_unique<Counter>();
+
+        return *series.CounterValue;
+    }
+
+    Gauge& MetricRegistry::GetGauge(std::string const& name, std::string const& help, std::vector<MetricLabel> const& labels)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        Series& series = GetSeries(name, help, MetricType::Gauge, labels);
+        if (!series.GaugeValue)
+            series.GaugeValue = std::make_unique<Gauge>();
+
+        return *series.GaugeValue;
+    }
+
+    Histogram& MetricRegistry::GetHistogram(std::string const& name, std::string const& help, std::vector<double> const& bounds, std::vector<MetricLabel> const& labels)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        Series& series = GetSeries(name, help, MetricType::Histogram, labels);
+        if (!series.HistogramValue)
+            series.HistogramValue = std::make_unique<Histogram>(bounds);
+
+        return *series.HistogramValue;
+    }
+
+    void MetricRegistry::Serialize(std::string& out) const
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        for (std::unique_ptr<Family> const& family : _families)
+        {
+            out += "# HELP ";
+            out += family->Name;
+            out += ' ';
+            AppendEscaped(out, family->Help, false);
+            out += "\n# TYPE ";
+            out += family->Name;
+            out += ' ';
+            out += GetTypeName(family->Type);
+            out += '\n';
+
+            for (auto const& [labels, series] : family->Values)
+            {
+                switch (family->Type)
+                {
+                    case MetricType::Counter:
+                        AppendSample(out, family->Name, labels, Acore::StringFormatFmt("{}", series.CounterValue->GetValue()));
+                        break;
+                    case MetricType::Gauge:
+                        AppendSample(out, family->Name, labels, Acore::StringFormatFmt("{}", series.GaugeValue->GetValue()));
+                        break;
+                    case MetricType::Histogram:
+                    {
+                        Histogram const& histogram = *series.HistogramValue;
+                        std::string const bucketName = family->Name + "_bucket";
+                        std::string const separator = labels.empty() ? "" : ",";
+
+                        // buckets are cumulative in the exposition format, the count is the +Inf bucket so both always agree
+                        uint64 cumulative = 0;
+                        for (std::size_t i = 0; i < histogram.GetBounds().size(); ++i)
+                        {
+                            cumulative += histogram.GetBucketCount(i);
+                            AppendSample(out, bucketName, Acore::StringFormatFmt("{}{}le=\"{}\"", labels, separator, histogram.GetBounds()[i]), Acore::StringFormatFmt("{}", cumulative));
+                        }
+
+                        cumulative += histogram.GetBucketCount(histogram.GetBounds().size());
+                        AppendSample(out, bucketName, Acore::StringFormatFmt("{}{}le=\"+Inf\"", labels, separator), Acore::StringFormatFmt("{}", cumulative));
+                        AppendSample(out, family->Name + "_sum", labels, Acore::StringFormatFmt("{}", histogram.GetSum()));
+                        AppendSample(out, family->Name + "_count", labels, Acore::StringFormatFmt("{}", cumulative));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
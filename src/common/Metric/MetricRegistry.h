@@ -0,0 +1,132 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRIC_REGISTRY_H__
+#define METRIC_REGISTRY_H__
+
+#include "Define.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * Pre-registered metrics for the pull exporter (see MetricExporter).
+ *
+ * Registering a metric takes a lock, updating it is a relaxed atomic operation without
+ * any allocation. Keep the reference returned by the registry, metrics live until shutdown.
+ * The registry is serialized in the Prometheus text format when the endpoint is scraped.
+ */
+namespace Acore::Metrics
+{
+    typedef std::pair<std::string, std::string> MetricLabel;
+
+    class AC_COMMON_API Counter
+    {
+    public:
+        void Increment(uint64 value = 1) { _value.fetch_add(value, std::memory_order_relaxed); }
+        [[nodiscard]] uint64 GetValue() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<uint64> _value = 0;
+    };
+
+    class AC_COMMON_API Gauge
+    {
+    public:
+        void Set(int64 value) { _value.store(value, std::memory_order_relaxed); }
+        void Add(int64 value) { _value.fetch_add(value, std::memory_order_relaxed); }
+        [[nodiscard]] int64 GetValue() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<int64> _value = 0;
+    };
+
+    class AC_COMMON_API Histogram
+    {
+    public:
+        /// bounds are the inclusive upper bounds of the buckets in ascending order, +Inf is implicit
+        explicit Histogram(std::vector<double> bounds);
+
+        void Observe(double value);
+
+        [[nodiscard]] std::vector<double> const& GetBounds() const { return _bounds; }
+        /// observations in the bucket alone, not cumulative. The last bucket is +Inf
+        [[nodiscard]] uint64 GetBucketCount(std::size_t index) const { return _buckets[index].load(std::memory_order_relaxed); }
+        [[nodiscard]] uint64 GetCount() const { return _count.load(std::memory_order_relaxed); }
+        [[nodiscard]] double GetSum() const { return _sum.load(std::memory_order_relaxed); }
+
+    private:
+        std::vector<double> _bounds;
+        std::unique_ptr<std::atomic<uint64>[]> _buckets;
+        std::atomic<uint64> _count;
+        std::atomic<double> _sum;
+    };
+
+    enum class MetricType : uint8
+    {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    class AC_COMMON_API MetricRegistry
+    {
+    public:
+        static MetricRegistry* instance();
+
+        /// Returns the metric with the given name and labels, registering it on first use
+        Counter& GetCounter(std::string const& name, std::string const& help, std::vector<MetricLabel> const& labels = {});
+        Gauge& GetGauge(std::string const& name, std::string const& help, std::vector<MetricLabel> const& labels = {});
+        Histogram& GetHistogram(std::string const& name, std::string const& help, std::vector<double> const& bounds, std::vector<MetricLabel> const& labels = {});
+
+        /// Appends every metric in the Prometheus text exposition format (version 0.0.4)
+        void Serialize(std::string& out) const;
+
+    private:
+        MetricRegistry() = default;
+
+        struct Series
+        {
+            std::unique_ptr<Counter> CounterValue;
+            std::unique_ptr<Gauge> GaugeValue;
+            std::unique_ptr<Histogram> HistogramValue;
+        };
+
+        struct Family
+        {
+            std::string Name;
+            std::string Help;
+            MetricType Type;
+            std::map<std::string, Series> Values;   // keyed by the formatted label set
+        };
+
+        Series& GetSeries(std::string const& name, std::string const& help, MetricType type, std::vector<MetricLabel> const& labels);
+
+        mutable std::mutex _lock;
+        std::vector<std::unique_ptr<Family>> _families;
+        std::unordered_map<std::string, Family*> _familiesByName;
+    };
+}
+
+#define sMetricRegistry Acore::Metrics::MetricRegistry::instance()
+
+#endif // METRIC_REGISTRY_H__
@@ -0,0 +1,254 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ZoneProfiler.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+struct ZoneProfiler::ThreadBuffer
+{
+    std::mutex Lock;
+    std::vector<Event> Events;
+    std::size_t Next = 0;
+    bool Wrapped = false;
+    uint32 ThreadId = 0;
+    uint32 Depth = 0;
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> guard(Lock);
+        Events.clear();
+        Next = 0;
+        Wrapped = false;
+    }
+
+    // events in recording order
+    std::vector<Event> Snapshot()
+    {
+        std::lock_guard<std::mutex> guard(Lock);
+        std::vector<Event> result;
+        result.reserve(Events.size());
+        if (Wrapped)
+            result.insert(result.end(), Events.begin() + Next, Events.end());
+        result.insert(result.end(), Events.begin(), Events.begin() + Next);
+        return result;
+    }
+};
+
+namespace
+{
+    thread_local ZoneProfiler::ThreadBuffer* ThreadLocalBuffer = nullptr;
+
+    std::string EscapeJson(char const* str)
+    {
+        std::string result;
+        for (; *str; ++str)
+        {
+            switch (*str)
+            {
+                case '"': result += "\\\""; break;
+                case '\\': result += "\\\\"; break;
+                default:
+                    if (static_cast<unsigned char>(*str) >= 0x20)
+                        result += *str;
+                    break;
+            }
+        }
+        return result;
+    }
+}
+
+ZoneProfiler* ZoneProfiler::instance()
+{
+    static ZoneProfiler instance;
+    return &instance;
+}
+
+void ZoneProfiler::Start()
+{
+    std::lock_guard<std::mutex> guard(_buffersLock);
+    for (std::shared_ptr<ThreadBuffer> const& buffer : _buffers)
+        buffer->Clear();
+
+    _startTime = std::chrono::steady_clock::now();
+    _recording.store(true, std::memory_order_release);
+}
+
+bool ZoneProfiler::Stop(std::string const& basePath, std::size_t* eventCount)
+{
+    _recording.store(false, std::memory_order_release);
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> guard(_buffersLock);
+        buffers = _buffers;
+    }
+
+    if (eventCount)
+    {
+        *eventCount = 0;
+        for (std::shared_ptr<ThreadBuffer> const& buffer : buffers)
+        {
+            std::lock_guard<std::mutex> guard(buffer->Lock);
+            *eventCount += buffer->Events.size();
+        }
+    }
+
+    bool written = WriteChromeTrace(basePath + ".json", buffers);
+    written = WriteCollapsedStacks(basePath + ".folded", buffers) && written;
+    return written;
+}
+
+uint64 ZoneProfiler::GetTimestamp() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _startTime).count();
+}
+
+ZoneProfiler::ThreadBuffer& ZoneProfiler::GetThreadBuffer()
+{
+    if (!ThreadLocalBuffer)
+    {
+        std::shared_ptr<ThreadBuffer> buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> guard(_buffersLock);
+        buffer->ThreadId = uint32(_buffers.size() + 1);
+        _buffers.push_back(buffer);
+        // buffers are owned by the registry and never released, threads may exit before the recording is dumped
+        ThreadLocalBuffer = buffer.get();
+    }
+
+    return *ThreadLocalBuffer;
+}
+
+uint32 ZoneProfiler::EnterZone()
+{
+    return sZoneProfiler->GetThreadBuffer().Depth++;
+}
+
+void ZoneProfiler::LeaveZone(char const* name, uint64 start, uint32 depth)
+{
+    ZoneProfiler* profiler = sZoneProfiler;
+    ThreadBuffer& buffer = profiler->GetThreadBuffer();
+    buffer.Depth = depth;
+
+    // zone was started before the recording was restarted or stopped
+    if (!profiler->IsRecording())
+        return;
+
+    uint64 now = profiler->GetTimestamp();
+    if (now < start)
+        return;
+
+    Event event{ name, start, now - start, depth };
+
+    std::lock_guard<std::mutex> guard(buffer.Lock);
+    if (buffer.Events.size() < EVENTS_PER_THREAD)
+        buffer.Events.push_back(event);
+    else
+    {
+        buffer.Events[buffer.Next] = event;
+        buffer.Wrapped = true;
+    }
+
+    buffer.Next = (buffer.Next + 1) % EVENTS_PER_THREAD;
+}
+
+bool ZoneProfiler::WriteChromeTrace(std::string const& fileName, std::vector<std::shared_ptr<ThreadBuffer>> const& buffers) const
+{
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file)
+        return false;
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (std::shared_ptr<ThreadBuffer> const& buffer : buffers)
+    {
+        for (Event const& event : buffer->Snapshot())
+        {
+            if (!first)
+                file << ',';
+            first = false;
+
+            file << Acore::StringFormat("\n{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                EscapeJson(event.Name), event.Start / 1000.0, event.Duration / 1000.0, buffer->ThreadId);
+        }
+    }
+
+    file << "\n]}\n";
+    return bool(file);
+}
+
+bool ZoneProfiler::WriteCollapsedStacks(std::string const& fileName, std::vector<std::shared_ptr<ThreadBuffer>> const& buffers) const
+{
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file)
+        return false;
+
+    // self time in microseconds per unique stack
+    std::map<std::string, uint64> stacks;
+    for (std::shared_ptr<ThreadBuffer> const& buffer : buffers)
+    {
+        std::vector<Event> events = buffer->Snapshot();
+        // parents finish after their children, process them first so children can find their stack
+        std::sort(events.begin(), events.end(), [](Event const& left, Event const& right)
+        {
+            if (left.Start != right.Start)
+                return left.Start < right.Start;
+            return left.Depth < right.Depth;
+        });
+
+        struct OpenZone
+        {
+            Event const* Zone;
+            std::string Stack;
+            uint64 ChildTime;
+        };
+
+        std::vector<OpenZone> open;
+        auto closeZone = [&stacks, &open]()
+        {
+            OpenZone const& zone = open.back();
+            uint64 self = zone.Zone->Duration > zone.ChildTime ? zone.Zone->Duration - zone.ChildTime : 0;
+            stacks[zone.Stack] += self / 1000;
+            uint64 duration = zone.Zone->Duration;
+            open.pop_back();
+            if (!open.empty())
+                open.back().ChildTime += duration;
+        };
+
+        for (Event const& event : events)
+        {
+            while (!open.empty() && open.back().Zone->Start + open.back().Zone->Duration <= event.Start)
+                closeZone();
+
+            std::string stack = open.empty() ? Acore::StringFormat("thread_%u", buffer->ThreadId) : open.back().Stack;
+            stack += ';';
+            stack += event.Name;
+            open.push_back({ &event, std::move(stack), 0 });
+        }
+
+        while (!open.empty())
+            closeZone();
+    }
+
+    for (auto const& [stack, time] : stacks)
+        if (time)
+            file << stack << ' ' << time << '\n';
+
+    return bool(file);
+}
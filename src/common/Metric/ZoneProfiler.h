@@ -0,0 +1,120 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZONE_PROFILER_H__
+#define ZONE_PROFILER_H__
+
+#include "Define.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Scoped zone profiler.
+ *
+ * Zones are recorded into per-thread ring buffers while a recording is running
+ * (see the .debug profile command). When not recording a zone costs one relaxed
+ * atomic load. Stopping a recording writes a Chrome trace (chrome://tracing,
+ * Perfetto) and a collapsed stack file usable by flamegraph.pl / speedscope.
+ *
+ * Zone names must be string literals or other strings with static storage.
+ */
+class AC_COMMON_API ZoneProfiler
+{
+public:
+    // events kept per thread, older ones are overwritten
+    static constexpr std::size_t EVENTS_PER_THREAD = 1 << 16;
+
+    struct Event
+    {
+        char const* Name;
+        uint64 Start;       // nanoseconds since recording start
+        uint64 Duration;    // nanoseconds
+        uint32 Depth;
+    };
+
+    static ZoneProfiler* instance();
+
+    void Start();
+    // stops recording and dumps <basePath>.json and <basePath>.folded, returns false if the files could not be written
+    bool Stop(std::string const& basePath, std::size_t* eventCount = nullptr);
+
+    [[nodiscard]] bool IsRecording() const { return _recording.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetTimestamp() const;
+
+    static uint32 EnterZone();
+    static void LeaveZone(char const* name, uint64 start, uint32 depth);
+
+    struct ThreadBuffer;
+
+private:
+    ZoneProfiler() = default;
+
+    ThreadBuffer& GetThreadBuffer();
+    bool WriteChromeTrace(std::string const& fileName, std::vector<std::shared_ptr<ThreadBuffer>> const& buffers) const;
+    bool WriteCollapsedStacks(std::string const& fileName, std::vector<std::shared_ptr<ThreadBuffer>> const& buffers) const;
+
+    std::atomic<bool> _recording = false;
+    std::chrono::steady_clock::time_point _startTime;
+
+    std::mutex _buffersLock;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers;
+};
+
+#define sZoneProfiler ZoneProfiler::instance()
+
+class ZoneProfileScope
+{
+public:
+    explicit ZoneProfileScope(char const* name) : _name(nullptr), _start(0), _depth(0)
+    {
+        if (sZoneProfiler->IsRecording())
+        {
+            _name = name;
+            _depth = ZoneProfiler::EnterZone();
+            _start = sZoneProfiler->GetTimestamp();
+        }
+    }
+
+    ~ZoneProfileScope()
+    {
+        if (_name)
+            ZoneProfiler::LeaveZone(_name, _start, _depth);
+    }
+
+    ZoneProfileScope(ZoneProfileScope const&) = delete;
+    ZoneProfileScope& operator=(ZoneProfileScope const&) = delete;
+
+private:
+    char const* _name;
+    uint64 _start;
+    uint32 _depth;
+};
+
+#define PROFILE_DO_CONCAT(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_DO_CONCAT(a, b)
+
+#if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
+#define PROFILE_ZONE(name) ((void)0)
+#else
+#define PROFILE_ZONE(name) ZoneProfileScope PROFILE_CONCAT(__ac_profile_zone, __LINE__)(name)
+#endif
+
+#endif // ZONE_PROFILER_H__
@@ -0,0 +1,271 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LOCKFREE_PCQ_H
+#define _LOCKFREE_PCQ_H
+
+#include "Define.h"
+#include "PCQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Bounded lock-free multi producer / multi consumer queue (D. Vyukov's array queue) with the
+ * interface of ProducerConsumerQueue.
+ *
+ * Every slot carries a sequence number telling producers and consumers whose turn it is, so
+ * pushing and popping is one CAS on the position plus one store, without any lock. Blocked
+ * consumers (empty queue) and producers (full queue) sleep with std::atomic::wait on an event
+ * counter, which is a futex on Linux. The counters are only touched while somebody waits.
+ */
+template <typename T>
+class LockFreeProducerConsumerQueue
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+    explicit LockFreeProducerConsumerQueue(std::size_t capacity = DEFAULT_CAPACITY)
+        : _cells(new Cell[RoundUpCapacity(capacity)]), _mask(RoundUpCapacity(capacity) - 1), _enqueuePos(0), _dequeuePos(0), _shutdown(false)
+    {
+        for (std::size_t i = 0; i <= _mask; ++i)
+            _cells[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~LockFreeProducerConsumerQueue()
+    {
+        T value;
+        while (TryPop(value))
+            ;
+    }
+
+    LockFreeProducerConsumerQueue(LockFreeProducerConsumerQueue const&) = delete;
+    LockFreeProducerConsumerQueue& operator=(LockFreeProducerConsumerQueue const&) = delete;
+
+    /// Blocks while the queue is full
+    void Push(T const& value)
+    {
+        if (!TryPush(value))
+        {
+            if (!_producers.WaitFor([&]() { return TryPush(value); }, _shutdown))
+                return;
+
+            // a burst of pops only woke one producer, it passes the wake up on while there is room
+            if (Size() <= _mask)
+                _producers.Wake();
+        }
+
+        _consumers.Wake();
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    /// Approximate while other threads push or pop
+    [[nodiscard]] std::size_t Size() const
+    {
+        std::size_t const dequeuePos = _dequeuePos.load(std::memory_order_relaxed);
+        std::size_t const enqueuePos = _enqueuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    bool Pop(T& value)
+    {
+        if (_shutdown || !TryPop(value))
+            return false;
+
+        _producers.Wake();
+        return true;
+    }
+
+    void WaitAndPop(T& value)
+    {
+        if (_shutdown)
+            return;
+
+        if (!TryPop(value))
+        {
+            if (!_consumers.WaitFor([&]() { return TryPop(value); }, _shutdown))
+                return;
+
+            // same as in Push, the woken consumer wakes the next one while items are left
+            if (!Empty())
+                _consumers.Wake();
+        }
+
+        _producers.Wake();
+    }
+
+    void Cancel()
+    {
+        _shutdown = true;
+
+        T value;
+        while (TryPop(value))
+            DeleteQueuedObject(value);
+
+        _consumers.WakeAll();
+        _producers.WakeAll();
+    }
+
+private:
+    struct alignas(64) Cell
+    {
+        std::atomic<std::size_t> Sequence;
+        alignas(T) unsigned char Storage[sizeof(T)];
+    };
+
+    // sleeping threads of one side of the queue, the futex word is only touched while somebody sleeps
+    struct alignas(64) WaitEvent
+    {
+        std::atomic<uint32> Events = 0;
+        std::atomic<uint32> Waiters = 0;
+        std::atomic<bool> WakePending = false;
+
+        // one futex wake up at a time, further calls don't wake anybody until the woken thread runs
+        void Wake()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (Waiters.load(std::memory_order_relaxed) && !WakePending.load() && !WakePending.exchange(true))
+            {
+                ++Events;
+                Events.notify_one();
+            }
+        }
+
+        void WakeAll()
+        {
+            ++Events;
+            Events.notify_all();
+        }
+
+        // returns false if the queue was canceled before the attempt succeeded
+        template<class Attempt>
+        bool WaitFor(Attempt&& attempt, std::atomic<bool> const& shutdown)
+        {
+            // registered before the last attempt, a Wake between the attempt and the wait changes Events
+            ++Waiters;
+            bool done = false;
+            while (!shutdown)
+            {
+                uint32 const events = Events.load();
+                // the thread that runs takes over the pending wake up, the next Wake wakes somebody else
+                WakePending = false;
+                if ((done = attempt()))
+                    break;
+
+                Events.wait(events);
+            }
+
+            --Waiters;
+            return done;
+        }
+    };
+
+    static std::size_t RoundUpCapacity(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        return size;
+    }
+
+    bool TryPush(T const& value)
+    {
+        Cell* cell;
+        std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            std::size_t const sequence = cell->Sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t const diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+            if (diff == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;   // full
+            else
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+
+        new (cell->Storage) T(value);
+        cell->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(T& value)
+    {
+        Cell* cell;
+        std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &_cells[pos & _mask];
+            std::size_t const sequence = cell->Sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t const diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos + 1);
+            if (diff == 0)
+            {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;   // empty
+            else
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+        }
+
+        T* item = std::launder(reinterpret_cast<T*>(cell->Storage));
+        value = std::move(*item);
+        item->~T();
+        cell->Sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    template<typename E = T>
+    typename std::enable_if<std::is_pointer<E>::value>::type DeleteQueuedObject(E& obj) { delete obj; }
+
+    template<typename E = T>
+    typename std::enable_if<!std::is_pointer<E>::value>::type DeleteQueuedObject(E const& /*packet*/) { }
+
+    std::unique_ptr<Cell[]> _cells;
+    std::size_t const _mask;
+
+    // producers and consumers each get their own cache lines
+    alignas(64) std::atomic<std::size_t> _enqueuePos;
+    alignas(64) std::atomic<std::size_t> _dequeuePos;
+    WaitEvent _consumers;
+    WaitEvent _producers;
+    std::atomic<bool> _shutdown;
+};
+
+/// Queue of the worker pools of the core, the lock-free one unless built with WITH_LOCKFREE_WORKER_QUEUES=0
+#ifdef ACORE_LOCKFREE_WORKER_QUEUES
+template <typename T>
+using WorkerQueue = LockFreeProducerConsumerQueue<T>;
+#else
+template <typename T>
+using WorkerQueue = ProducerConsumerQueue<T>;
+#endif
+
+#endif
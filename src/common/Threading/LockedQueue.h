@@ -18,6 +18,7 @@
 #ifndef LOCKEDQUEUE_H
 #define LOCKEDQUEUE_H
 
+#include <algorithm>
 #include <deque>
 #include <mutex>
 
@@ -51,6 +52,14 @@ public:
         unlock();
     }
 
+    //! Adds items to the back of the queue with a single lock
+    template<class Iterator>
+    void add(Iterator begin, Iterator end)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _queue.insert(_queue.end(), begin, end);
+    }
+
     //! Adds items back to front of the queue
     template<class Iterator>
     void readd(Iterator begin, Iterator end)
@@ -75,6 +84,18 @@ public:
         return true;
     }
 
+    //! Moves up to count items from the front of the queue to the back of result with a single lock, returns the number of moved items
+    template<class Container>
+    std::size_t take(Container& result, std::size_t count)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        count = std::min(count, _queue.size());
+        result.insert(result.end(), _queue.begin(), _queue.begin() + count);
+        _queue.erase(_queue.begin(), _queue.begin() + count);
+        return count;
+    }
+
     template<class Checker>
     bool next(T& result, Checker& check)
     {
@@ -16,11 +16,16 @@
  */
 
 #include "ProcessPriority.h"
+#include "Config.h"
 #include "Log.h"
+#include "StringConvert.h"
+#include "Tokenize.h"
+#include <vector>
 
 #ifdef _WIN32 // Windows
 #include <Windows.h>
 #elif defined(__linux__)
+#include <pthread.h>
 #include <sched.h>
 #include <sys/resource.h>
 #define PROCESS_HIGH_PRIORITY -15 // [-20, 19], default is 0
@@ -113,3 +118,92 @@ void SetProcessPriority(std::string const& logChannel, uint32 affinity, bool hig
     (void)highPriority;
 #endif
 }
+
+void SetCurrentThreadName(std::string const& name)
+{
+#ifdef _WIN32 // Windows
+    std::wstring wideName(name.begin(), name.end());
+    SetThreadDescription(GetCurrentThread(), wideName.c_str());
+#elif defined(__linux__) // Linux
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#else
+    (void)name;
+#endif
+}
+
+namespace
+{
+    bool ParseProcessorList(std::string_view processors, std::vector<uint32>& cpus)
+    {
+        for (std::string_view range : Acore::Tokenize(processors, ',', false))
+        {
+            std::vector<std::string_view> bounds = Acore::Tokenize(range, '-', false);
+            if (bounds.empty() || bounds.size() > 2)
+                return false;
+
+            Optional<uint32> first = Acore::StringTo<uint32>(bounds.front());
+            Optional<uint32> last = Acore::StringTo<uint32>(bounds.back());
+            if (!first || !last || *first > *last)
+                return false;
+
+            for (uint32 cpu = *first; cpu <= *last; ++cpu)
+                cpus.push_back(cpu);
+        }
+
+        return true;
+    }
+}
+
+bool SetCurrentThreadAffinity(std::string const& logChannel, std::string_view processors)
+{
+    if (processors.empty())
+        return true;
+
+    std::vector<uint32> cpus;
+    if (!ParseProcessorList(processors, cpus))
+    {
+        LOG_ERROR(logChannel, "Invalid thread processor list '{}', expected a list like 0-7,16-23", processors);
+        return false;
+    }
+
+#ifdef _WIN32 // Windows
+
+    DWORD_PTR mask = 0;
+    for (uint32 cpu : cpus)
+        if (cpu < sizeof(mask) * 8)
+            mask |= DWORD_PTR(1) << cpu;
+
+    if (!mask || !SetThreadAffinityMask(GetCurrentThread(), mask))
+    {
+        LOG_ERROR(logChannel, "Can't bind thread to processors {}", processors);
+        return false;
+    }
+
+#elif defined(__linux__) // Linux
+
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+
+    for (uint32 cpu : cpus)
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &mask);
+
+    if (int error = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask))
+    {
+        LOG_ERROR(logChannel, "Can't bind thread to processors {}, error: {}", processors, strerror(error));
+        return false;
+    }
+
+#endif
+
+    return true;
+}
+
+void SetupCurrentThread(std::string const& role, uint32 index)
+{
+    SetCurrentThreadName(role + std::to_string(index));
+
+    std::string const processors = sConfigMgr->GetOption<std::string>(CONFIG_THREAD_AFFINITY + role, "", false);
+    if (!processors.empty() && SetCurrentThreadAffinity("server", processors))
+        LOG_DEBUG("server", "{} thread {} bound to processors {}", role, index, processors);
+}
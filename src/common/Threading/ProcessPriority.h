@@ -20,10 +20,21 @@
 
 #include "Define.h"
 #include <string>
+#include <string_view>
 
 #define CONFIG_PROCESSOR_AFFINITY "UseProcessors"
 #define CONFIG_HIGH_PRIORITY "ProcessPriority"
+#define CONFIG_THREAD_AFFINITY "ThreadAffinity."
 
 void AC_COMMON_API SetProcessPriority(std::string const& logChannel, uint32 affinity, bool highPriority);
 
+/// Names the calling thread for debuggers and profilers, Linux keeps the first 15 characters
+void AC_COMMON_API SetCurrentThreadName(std::string const& name);
+
+/// Binds the calling thread to a processor list like "0-7,16-23", an empty list keeps the process mask
+bool AC_COMMON_API SetCurrentThreadAffinity(std::string const& logChannel, std::string_view processors);
+
+/// Names the calling worker thread "<role><index>" and binds it to the ThreadAffinity.<role> processors
+void AC_COMMON_API SetupCurrentThread(std::string const& role, uint32 index);
+
 #endif
@@ -38,6 +38,8 @@ public:
         return _callbacks.back();
     }
 
+    [[nodiscard]] bool Empty() const { return _callbacks.empty(); }
+
     void ProcessReadyCallbacks()
     {
         if (_callbacks.empty())
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_DENSE_ID_INDEX_H
+#define ACORE_DENSE_ID_INDEX_H
+
+#include "Define.h"
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Acore
+{
+    /// Pointers to the entries of a store, indexed by their id in one contiguous array.
+    /// The store keeps owning the entries (a node based map keeps them at a fixed address),
+    /// the index only replaces its hash lookups by a bounds check and a load.
+    /// Ids at or above the limit are not indexed, Covers() tells the caller to ask the store.
+    template<class T>
+    class DenseIdIndex
+    {
+    public:
+        explicit DenseIdIndex(uint32 limit = std::numeric_limits<uint32>::max()) : _limit(limit) { }
+
+        [[nodiscard]] bool Covers(uint32 id) const { return id < _limit; }
+
+        [[nodiscard]] T* Find(uint32 id) const { return id < _entries.size() ? _entries[id] : nullptr; }
+
+        void Set(uint32 id, T* entry)
+        {
+            if (!Covers(id))
+                return;
+
+            if (id >= _entries.size())
+            {
+                if (!entry)
+                    return;
+
+                _entries.resize(id + 1, nullptr);
+            }
+
+            if (!_entries[id] && entry)
+                ++_count;
+            else if (_entries[id] && !entry)
+                --_count;
+
+            _entries[id] = entry;
+        }
+
+        void Remove(uint32 id) { Set(id, nullptr); }
+
+        void Clear()
+        {
+            _entries.clear();
+            _count = 0;
+        }
+
+        /// Rebuilds the index from a map of id to entry or to entry pointer
+        template<class Store>
+        void Build(Store& store)
+        {
+            Clear();
+
+            uint32 maxId = 0;
+            for (auto const& [id, entry] : store)
+                if (Covers(id) && id > maxId)
+                    maxId = id;
+
+            if (!store.empty())
+                _entries.reserve(std::size_t(maxId) + 1);
+
+            for (auto& [id, entry] : store)
+            {
+                if constexpr (std::is_pointer_v<std::decay_t<decltype(entry)>>)
+                    Set(id, entry);
+                else
+                    Set(id, &entry);
+            }
+        }
+
+        [[nodiscard]] std::vector<T*> const& GetEntries() const { return _entries; }
+        [[nodiscard]] std::size_t GetSlotCount() const { return _entries.size(); }
+        [[nodiscard]] std::size_t GetEntryCount() const { return _count; }
+        [[nodiscard]] std::size_t GetMemoryUsage() const { return _entries.capacity() * sizeof(T*); }
+
+    private:
+        std::vector<T*> _entries;
+        std::size_t _count{0};
+        uint32 _limit;
+    };
+}
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "Duration.h"
+#include "NodePoolAllocator.h"
 #include <map>
 
 class EventMap
@@ -35,7 +36,7 @@ class EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<uint32, uint32> EventStore;
+    typedef std::multimap<uint32, uint32, std::less<uint32>, Acore::NodePoolAllocator<std::pair<uint32 const, uint32>>> EventStore;
 
 public:
     EventMap() { }
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "Duration.h"
+#include "NodePoolAllocator.h"
 #include "Random.h"
 #include <map>
 #include <type_traits>
@@ -91,7 +92,8 @@ class LambdaBasicEvent : public BasicEvent
 template<typename T>
 using is_lambda_event = std::enable_if_t<!std::is_base_of_v<BasicEvent, std::remove_pointer_t<std::remove_cvref_t<T>>>>;
 
-typedef std::multimap<uint64, BasicEvent*> EventList;
+// scheduled and rescheduled on every unit and script tick, nodes come from a pool instead of the heap
+typedef std::multimap<uint64, BasicEvent*, std::less<uint64>, Acore::NodePoolAllocator<std::pair<uint64 const, BasicEvent*>>> EventList;
 
 class EventProcessor
 {
@@ -123,6 +125,8 @@ class EventProcessor
 
         void CancelEventGroup(uint8 group);
 
+        [[nodiscard]] bool HasEvents() const { return !m_events.empty(); }
+
     protected:
         uint64 m_time{0};
         EventList m_events;
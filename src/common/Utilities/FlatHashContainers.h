@@ -0,0 +1,344 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_FLAT_HASH_CONTAINERS_H
+#define ACORE_FLAT_HASH_CONTAINERS_H
+
+#include "Define.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Acore
+{
+    /// Finalizer of MurmurHash3, spreads every input bit over the whole result.
+    /// Guid hashes are the raw value, without it the type half would never reach the slot index.
+    inline uint64 HashMix64(uint64 value)
+    {
+        value ^= value >> 33;
+        value *= UI64LIT(0xFF51AFD7ED558CCD);
+        value ^= value >> 33;
+        value *= UI64LIT(0xC4CEB9FE1A85EC53);
+        value ^= value >> 33;
+        return value;
+    }
+
+    namespace Impl
+    {
+        /// Open addressing hash table with linear probing over power of two capacities.
+        /// Slots live in one contiguous array next to a control byte per slot, so lookups
+        /// and copies touch a few cache lines instead of one node per element.
+        /// Erased slots become tombstones that are dropped on the next rehash: erasing never
+        /// moves other elements, iterators to other elements stay valid like with the std
+        /// unordered containers. Inserting may rehash and invalidate all iterators.
+        /// Slots must be default constructible, an erased slot is reset to a default value.
+        template<class Key, class Slot, class KeyOf, class Hash, class KeyEqual>
+        class FlatHashTable
+        {
+            enum SlotState : uint8
+            {
+                SLOT_EMPTY,
+                SLOT_FULL,
+                SLOT_DELETED
+            };
+
+            static constexpr std::size_t MinCapacity = 8;
+
+        public:
+            template<bool Const>
+            class Iterator
+            {
+                friend class FlatHashTable;
+                typedef std::conditional_t<Const, FlatHashTable const, FlatHashTable> TableType;
+
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef Slot value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef std::conditional_t<Const, Slot const*, Slot*> pointer;
+                typedef std::conditional_t<Const, Slot const&, Slot&> reference;
+
+                Iterator() : _table(nullptr), _index(0) { }
+                Iterator(TableType* table, std::size_t index) : _table(table), _index(index) { }
+
+                // non const to const conversion
+                template<bool OtherConst, class = std::enable_if_t<Const && !OtherConst>>
+                Iterator(Iterator<OtherConst> const& other) : _table(other._table), _index(other._index) { }
+
+                reference operator*() const { return _table->_slots[_index]; }
+                pointer operator->() const { return &_table->_slots[_index]; }
+
+                Iterator& operator++()
+                {
+                    _index = _table->NextFull(_index + 1);
+                    return *this;
+                }
+
+                Iterator operator++(int)
+                {
+                    Iterator itr = *this;
+                    ++*this;
+                    return itr;
+                }
+
+                bool operator==(Iterator const& other) const { return _index == other._index; }
+                bool operator!=(Iterator const& other) const { return _index != other._index; }
+
+            private:
+                template<bool> friend class Iterator;
+
+                TableType* _table;
+                std::size_t _index;
+            };
+
+            typedef Key key_type;
+            typedef Slot value_type;
+            typedef std::size_t size_type;
+            typedef Iterator<false> iterator;
+            typedef Iterator<true> const_iterator;
+
+            FlatHashTable() : _size(0), _deleted(0) { }
+
+            [[nodiscard]] iterator begin() { return iterator(this, NextFull(0)); }
+            [[nodiscard]] iterator end() { return iterator(this, _states.size()); }
+            [[nodiscard]] const_iterator begin() const { return const_iterator(this, NextFull(0)); }
+            [[nodiscard]] const_iterator end() const { return const_iterator(this, _states.size()); }
+            [[nodiscard]] const_iterator cbegin() const { return begin(); }
+            [[nodiscard]] const_iterator cend() const { return end(); }
+
+            [[nodiscard]] bool empty() const { return !_size; }
+            [[nodiscard]] size_type size() const { return _size; }
+            [[nodiscard]] size_type capacity() const { return _states.size(); }
+            [[nodiscard]] std::size_t memory_usage() const { return _states.capacity() + _slots.capacity() * sizeof(Slot); }
+
+            void clear()
+            {
+                if (!_size && !_deleted)
+                    return;
+
+                std::fill(_states.begin(), _states.end(), SLOT_EMPTY);
+                std::fill(_slots.begin(), _slots.end(), Slot());
+                _size = 0;
+                _deleted = 0;
+            }
+
+            /// Makes room for count elements without rehashing
+            void reserve(size_type count)
+            {
+                size_type capacity = MinCapacity;
+                while (!FitsLoad(count, capacity))
+                    capacity <<= 1;
+
+                if (capacity > _states.size())
+                    Rehash(capacity);
+            }
+
+            void swap(FlatHashTable& other) noexcept
+            {
+                _states.swap(other._states);
+                _slots.swap(other._slots);
+                std::swap(_size, other._size);
+                std::swap(_deleted, other._deleted);
+                std::swap(_hash, other._hash);
+                std::swap(_equal, other._equal);
+            }
+
+            [[nodiscard]] iterator find(Key const& key) { return iterator(this, FindIndex(key)); }
+            [[nodiscard]] const_iterator find(Key const& key) const { return const_iterator(this, FindIndex(key)); }
+            [[nodiscard]] size_type count(Key const& key) const { return FindIndex(key) != _states.size() ? 1 : 0; }
+            [[nodiscard]] bool contains(Key const& key) const { return FindIndex(key) != _states.size(); }
+
+            size_type erase(Key const& key)
+            {
+                std::size_t index = FindIndex(key);
+                if (index == _states.size())
+                    return 0;
+
+                EraseIndex(index);
+                return 1;
+            }
+
+            iterator erase(const_iterator itr)
+            {
+                EraseIndex(itr._index);
+                return iterator(this, NextFull(itr._index + 1));
+            }
+
+        protected:
+            template<class K, class MakeSlot>
+            std::pair<iterator, bool> InsertSlot(K const& key, MakeSlot&& makeSlot)
+            {
+                std::size_t index = FindIndex(key);
+                if (index != _states.size())
+                    return { iterator(this, index), false };
+
+                if (!FitsLoad(_size + _deleted + 1, _states.size()))
+                    Rehash(FitsLoad(_size + 1, _states.size()) && _deleted > _size ? _states.size() : std::max(MinCapacity, _states.size() << 1));
+
+                // the first free slot of the probe sequence, deleted slots are reused
+                std::size_t const mask = _states.size() - 1;
+                index = Bucket(key);
+                while (_states[index] == SLOT_FULL)
+                    index = (index + 1) & mask;
+
+                if (_states[index] == SLOT_DELETED)
+                    --_deleted;
+
+                _states[index] = SLOT_FULL;
+                _slots[index] = makeSlot();
+                ++_size;
+                return { iterator(this, index), true };
+            }
+
+        private:
+            // up to 7/8 of the slots may be full or deleted
+            static bool FitsLoad(size_type count, size_type capacity) { return count * 8 <= capacity * 7; }
+
+            std::size_t Bucket(Key const& key) const
+            {
+                return std::size_t(HashMix64(uint64(_hash(key)))) & (_states.size() - 1);
+            }
+
+            std::size_t FindIndex(Key const& key) const
+            {
+                if (!_size)
+                    return _states.size();
+
+                std::size_t const mask = _states.size() - 1;
+                for (std::size_t index = Bucket(key); _states[index] != SLOT_EMPTY; index = (index + 1) & mask)
+                    if (_states[index] == SLOT_FULL && _equal(KeyOf()(_slots[index]), key))
+                        return index;
+
+                return _states.size();
+            }
+
+            std::size_t NextFull(std::size_t index) const
+            {
+                while (index < _states.size() && _states[index] != SLOT_FULL)
+                    ++index;
+
+                return index;
+            }
+
+            void EraseIndex(std::size_t index)
+            {
+                _states[index] = SLOT_DELETED;
+                _slots[index] = Slot();
+                --_size;
+                ++_deleted;
+            }
+
+            void Rehash(std::size_t capacity)
+            {
+                std::vector<uint8> states(capacity, SLOT_EMPTY);
+                std::vector<Slot> slots(capacity);
+                states.swap(_states);
+                slots.swap(_slots);
+                _deleted = 0;
+
+                std::size_t const mask = capacity - 1;
+                for (std::size_t i = 0; i < states.size(); ++i)
+                {
+                    if (states[i] != SLOT_FULL)
+                        continue;
+
+                    std::size_t index = Bucket(KeyOf()(slots[i]));
+                    while (_states[index] == SLOT_FULL)
+                        index = (index + 1) & mask;
+
+                    _states[index] = SLOT_FULL;
+                    _slots[index] = std::move(slots[i]);
+                }
+            }
+
+            std::vector<uint8> _states;
+            std::vector<Slot> _slots;
+            size_type _size;
+            size_type _deleted;
+            Hash _hash;
+            KeyEqual _equal;
+        };
+
+        struct FlatSetKeyOf
+        {
+            template<class Key>
+            Key const& operator()(Key const& key) const { return key; }
+        };
+
+        struct FlatMapKeyOf
+        {
+            template<class Key, class Value>
+            Key const& operator()(std::pair<Key, Value> const& slot) const { return slot.first; }
+        };
+    }
+
+    /// Drop-in replacement of std::unordered_set for small trivially copyable keys (guids, ids),
+    /// see Impl::FlatHashTable for the iterator rules
+    template<class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class FlatHashSet : public Impl::FlatHashTable<Key, Key, Impl::FlatSetKeyOf, Hash, KeyEqual>
+    {
+        typedef Impl::FlatHashTable<Key, Key, Impl::FlatSetKeyOf, Hash, KeyEqual> Base;
+
+    public:
+        std::pair<typename Base::iterator, bool> insert(Key const& key)
+        {
+            return this->InsertSlot(key, [&key]() { return key; });
+        }
+
+        template<class InputIt>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+
+        std::pair<typename Base::iterator, bool> emplace(Key const& key) { return insert(key); }
+    };
+
+    /// Drop-in replacement of std::unordered_map for small trivially copyable keys (guids, ids).
+    /// Elements are std::pair<Key, Value>, the key must not be modified through an iterator.
+    template<class Key, class Value, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+    class FlatHashMap : public Impl::FlatHashTable<Key, std::pair<Key, Value>, Impl::FlatMapKeyOf, Hash, KeyEqual>
+    {
+        typedef Impl::FlatHashTable<Key, std::pair<Key, Value>, Impl::FlatMapKeyOf, Hash, KeyEqual> Base;
+
+    public:
+        typedef Value mapped_type;
+
+        std::pair<typename Base::iterator, bool> insert(std::pair<Key, Value> const& value)
+        {
+            return this->InsertSlot(value.first, [&value]() { return value; });
+        }
+
+        template<class... Args>
+        std::pair<typename Base::iterator, bool> emplace(Key const& key, Args&&... args)
+        {
+            return this->InsertSlot(key, [&]() { return std::pair<Key, Value>(key, Value(std::forward<Args>(args)...)); });
+        }
+
+        Value& operator[](Key const& key)
+        {
+            return emplace(key).first->second;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "HeapAllocator.h"
+
+#ifdef ACORE_WITH_JEMALLOC
+
+#include <algorithm>
+#include <jemalloc/jemalloc.h>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    std::mutex ArenaNamesLock;
+    std::unordered_map<unsigned, std::string> ArenaNames;
+
+    template<typename T>
+    bool ReadControl(std::string const& name, T& value)
+    {
+        std::size_t size = sizeof(T);
+        return mallctl(name.c_str(), &value, &size, nullptr, 0) == 0;
+    }
+}
+
+char const* Acore::Heap::GetAllocatorName()
+{
+    return "jemalloc";
+}
+
+bool Acore::Heap::GetHeapStats(HeapStats& stats)
+{
+    // stats are a snapshot taken at the last epoch change
+    uint64_t epoch = 1;
+    std::size_t size = sizeof(epoch);
+    if (mallctl("epoch", &epoch, &size, &epoch, size) != 0)
+        return false;
+
+    std::size_t allocated = 0, active = 0, resident = 0, mapped = 0, retained = 0;
+    if (!ReadControl("stats.allocated", allocated) || !ReadControl("stats.active", active) ||
+        !ReadControl("stats.resident", resident) || !ReadControl("stats.mapped", mapped) ||
+        !ReadControl("stats.retained", retained))
+        return false;
+
+    stats.Allocated = allocated;
+    stats.Active = active;
+    stats.Resident = resident;
+    stats.Mapped = mapped;
+    stats.Retained = retained;
+    stats.Arenas.clear();
+
+    unsigned arenaCount = 0;
+    if (!ReadControl("arenas.narenas", arenaCount))
+        return true;
+
+    std::lock_guard<std::mutex> lock(ArenaNamesLock);
+    for (unsigned i = 0; i < arenaCount; ++i)
+    {
+        std::string const prefix = "stats.arenas." + std::to_string(i);
+        std::size_t smallAllocated = 0, largeAllocated = 0, arenaResident = 0;
+
+        // arenas that were never used have no stats
+        if (!ReadControl(prefix + ".small.allocated", smallAllocated) || !ReadControl(prefix + ".large.allocated", largeAllocated) ||
+            !ReadControl(prefix + ".resident", arenaResident))
+            continue;
+
+        auto itr = ArenaNames.find(i);
+        std::string const& name = itr != ArenaNames.end() ? itr->second : "shared";
+
+        auto arena = std::find_if(stats.Arenas.begin(), stats.Arenas.end(), [&name](ArenaStats const& arena) { return arena.Name == name; });
+        if (arena == stats.Arenas.end())
+            arena = stats.Arenas.insert(stats.Arenas.end(), ArenaStats{ name });
+
+        arena->Allocated += smallAllocated + largeAllocated;
+        arena->Resident += arenaResident;
+    }
+
+    return true;
+}
+
+bool Acore::Heap::DumpHeapProfile(std::string const& path, std::string& error)
+{
+    bool profiling = false;
+    if (!ReadControl("opt.prof", profiling) || !profiling)
+    {
+        error = "heap profiling is not enabled, start the server with MALLOC_CONF=prof:true";
+        return false;
+    }
+
+    char const* fileName = path.c_str();
+    int result = path.empty() ? mallctl("prof.dump", nullptr, nullptr, nullptr, 0) : mallctl("prof.dump", nullptr, nullptr, &fileName, sizeof(fileName));
+    if (result)
+    {
+        error = "prof.dump failed with error " + std::to_string(result);
+        return false;
+    }
+
+    return true;
+}
+
+bool Acore::Heap::UseThreadArena(std::string const& name)
+{
+    unsigned arena = 0;
+    if (!ReadControl("arenas.create", arena))
+        return false;
+
+    if (mallctl("thread.arena", nullptr, nullptr, &arena, sizeof(arena)) != 0)
+        return false;
+
+    std::lock_guard<std::mutex> lock(ArenaNamesLock);
+    ArenaNames[arena] = name;
+    return true;
+}
+
+#else
+
+char const* Acore::Heap::GetAllocatorName()
+{
+    return "system";
+}
+
+bool Acore::Heap::GetHeapStats(HeapStats& /*stats*/)
+{
+    return false;
+}
+
+bool Acore::Heap::DumpHeapProfile(std::string const& /*path*/, std::string& error)
+{
+    error = "heap profiling needs the server to be built with jemalloc";
+    return false;
+}
+
+bool Acore::Heap::UseThreadArena(std::string const& /*name*/)
+{
+    return false;
+}
+
+#endif
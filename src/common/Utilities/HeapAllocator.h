@@ -0,0 +1,62 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_HEAP_ALLOCATOR_H
+#define ACORE_HEAP_ALLOCATOR_H
+
+#include "Define.h"
+#include <string>
+#include <vector>
+
+/// Runtime control over the heap allocator the server is linked with. jemalloc
+/// (deps/jemalloc) is the only backend that answers, with the system allocator
+/// every call reports that it is not available.
+namespace Acore::Heap
+{
+    struct ArenaStats
+    {
+        std::string Name;
+        uint64 Allocated = 0;
+        uint64 Resident = 0;
+    };
+
+    struct HeapStats
+    {
+        uint64 Allocated = 0;
+        uint64 Active = 0;
+        uint64 Resident = 0;
+        uint64 Mapped = 0;
+        uint64 Retained = 0;
+
+        /// arenas created by UseThreadArena grouped by name, all automatic arenas as "shared"
+        std::vector<ArenaStats> Arenas;
+    };
+
+    AC_COMMON_API char const* GetAllocatorName();
+
+    AC_COMMON_API bool GetHeapStats(HeapStats& stats);
+
+    /// Writes a heap profile to `path`, or to jemalloc's prof_prefix naming if empty.
+    /// Profiling has to be enabled at startup, e.g. MALLOC_CONF=prof:true,prof_active:true
+    AC_COMMON_API bool DumpHeapProfile(std::string const& path, std::string& error);
+
+    /// Moves the allocations of the calling thread into an arena of its own, reported
+    /// under `name` in the stats. Meant for long lived worker threads.
+    AC_COMMON_API bool UseThreadArena(std::string const& name);
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MemoryAccounting.h"
+#include <algorithm>
+
+MemoryAccounting* MemoryAccounting::instance()
+{
+    static MemoryAccounting instance;
+    return &instance;
+}
+
+void MemoryAccounting::Register(std::string const& subsystem, Estimator estimator)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _estimators.emplace_back(subsystem, std::move(estimator));
+}
+
+std::vector<std::pair<std::string, std::size_t>> MemoryAccounting::Collect() const
+{
+    std::vector<std::pair<std::string, std::size_t>> sizes;
+
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for (auto const& [subsystem, estimator] : _estimators)
+        {
+            auto itr = std::find_if(sizes.begin(), sizes.end(), [&subsystem](auto const& size) { return size.first == subsystem; });
+            if (itr == sizes.end())
+                itr = sizes.insert(sizes.end(), { subsystem, 0 });
+
+            itr->second += estimator();
+        }
+    }
+
+    std::sort(sizes.begin(), sizes.end(), [](auto const& left, auto const& right) { return left.second > right.second; });
+    return sizes;
+}
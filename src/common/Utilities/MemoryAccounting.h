@@ -0,0 +1,52 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_MEMORY_ACCOUNTING_H
+#define ACORE_MEMORY_ACCOUNTING_H
+
+#include "Define.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Size estimators of the big containers of the server, grouped by subsystem.
+/// The estimates count the elements and the storage of the containers, not the
+/// allocator overhead, so they are meant for trends and comparing subsystems.
+/// Estimators are run on the world thread between map updates.
+class AC_COMMON_API MemoryAccounting
+{
+public:
+    typedef std::function<std::size_t()> Estimator;
+
+    static MemoryAccounting* instance();
+
+    /// Adds an estimator to `subsystem`, the sizes of all estimators of a subsystem are summed up
+    void Register(std::string const& subsystem, Estimator estimator);
+
+    /// return: estimated bytes per subsystem, largest first
+    [[nodiscard]] std::vector<std::pair<std::string, std::size_t>> Collect() const;
+
+private:
+    mutable std::mutex _lock;
+    std::vector<std::pair<std::string, Estimator>> _estimators;
+};
+
+#define sMemoryAccounting MemoryAccounting::instance()
+
+#endif // ACORE_MEMORY_ACCOUNTING_H
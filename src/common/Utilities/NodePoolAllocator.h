@@ -0,0 +1,190 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_NODE_POOL_ALLOCATOR_H
+#define ACORE_NODE_POOL_ALLOCATOR_H
+
+#include "Define.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+namespace Acore
+{
+    namespace Impl
+    {
+        /// Free lists of equally sized nodes, carved out of chunks of NodesPerChunk nodes.
+        /// Every thread keeps its own list, a node may be freed by another thread than the
+        /// one that allocated it, it then simply continues its life in that thread's list.
+        /// Chunks are never returned, the nodes of a thread that exits are handed to the others.
+        template<std::size_t NodeSize, std::size_t NodesPerChunk = 64>
+        class NodePool
+        {
+            struct FreeNode
+            {
+                FreeNode* Next;
+            };
+
+            static constexpr std::size_t Alignment = alignof(std::max_align_t);
+            static constexpr std::size_t Stride = (std::max(NodeSize, sizeof(FreeNode)) + Alignment - 1) & ~(Alignment - 1);
+
+            struct SharedList
+            {
+                std::mutex Lock;
+                FreeNode* Head = nullptr;
+            };
+
+            struct LocalList
+            {
+                FreeNode* Head = nullptr;
+
+                ~LocalList()
+                {
+                    LocalListDestroyed() = true;
+                    if (!Head)
+                        return;
+
+                    FreeNode* tail = Head;
+                    while (tail->Next)
+                        tail = tail->Next;
+
+                    SharedList& shared = GetSharedList();
+                    std::lock_guard<std::mutex> lock(shared.Lock);
+                    tail->Next = shared.Head;
+                    shared.Head = Head;
+                }
+
+                void Refill()
+                {
+                    {
+                        SharedList& shared = GetSharedList();
+                        std::lock_guard<std::mutex> lock(shared.Lock);
+                        if (shared.Head)
+                        {
+                            Head = shared.Head;
+                            shared.Head = nullptr;
+                            return;
+                        }
+                    }
+
+                    char* chunk = static_cast<char*>(::operator new(Stride * NodesPerChunk));
+                    ReservedBytes() += Stride * NodesPerChunk;
+                    for (std::size_t i = NodesPerChunk; i-- > 0;)
+                    {
+                        FreeNode* node = reinterpret_cast<FreeNode*>(chunk + i * Stride);
+                        node->Next = Head;
+                        Head = node;
+                    }
+                }
+            };
+
+            static SharedList& GetSharedList()
+            {
+                static SharedList shared;
+                return shared;
+            }
+
+            static LocalList& GetLocalList()
+            {
+                thread_local LocalList local;
+                return local;
+            }
+
+            // trivially destructible, so still usable while thread locals are torn down
+            static bool& LocalListDestroyed()
+            {
+                thread_local bool destroyed = false;
+                return destroyed;
+            }
+
+        public:
+            /// memory held by this pool's chunks, in use or free
+            static std::atomic<std::size_t>& ReservedBytes()
+            {
+                static std::atomic<std::size_t> reserved{0};
+                return reserved;
+            }
+
+            static void* Allocate()
+            {
+                // containers destroyed after their thread's list is gone get plain, never released nodes
+                if (LocalListDestroyed())
+                    return ::operator new(Stride);
+
+                LocalList& local = GetLocalList();
+                if (!local.Head)
+                    local.Refill();
+
+                FreeNode* node = local.Head;
+                local.Head = node->Next;
+                return node;
+            }
+
+            static void Deallocate(void* ptr)
+            {
+                if (LocalListDestroyed())
+                    return;
+
+                LocalList& local = GetLocalList();
+                FreeNode* node = static_cast<FreeNode*>(ptr);
+                node->Next = local.Head;
+                local.Head = node;
+            }
+        };
+    }
+
+    /// Allocator for node based containers (std::list, std::map, std::multimap...) that
+    /// serves single node allocations from Impl::NodePool. Iterator and reference stability
+    /// of the container are unchanged, only the heap traffic of inserting and erasing is gone
+    /// and nodes allocated together end up next to each other.
+    template<typename T>
+    class NodePoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        NodePoolAllocator() noexcept = default;
+        template<typename U>
+        NodePoolAllocator(NodePoolAllocator<U> const&) noexcept { }
+
+        T* allocate(std::size_t n)
+        {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "NodePoolAllocator does not support over-aligned types");
+            if (n == 1)
+                return static_cast<T*>(Impl::NodePool<sizeof(T)>::Allocate());
+
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t n) noexcept
+        {
+            if (n == 1)
+                Impl::NodePool<sizeof(T)>::Deallocate(ptr);
+            else
+                ::operator delete(ptr);
+        }
+
+        template<typename U>
+        bool operator==(NodePoolAllocator<U> const&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(NodePoolAllocator<U> const&) const noexcept { return false; }
+    };
+}
+
+#endif //! #ifdef ACORE_NODE_POOL_ALLOCATOR_H
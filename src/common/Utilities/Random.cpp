@@ -74,16 +74,15 @@ uint32 rand32()
     return GetRng()->RandomUInt32();
 }
 
+// a single 32 bit draw, uniform_real_distribution<double> takes two of them for its 53 bits
 double rand_norm()
 {
-    std::uniform_real_distribution<double> urd;
-    return urd(engine);
+    return GetRng()->RandomUInt32() * (1.0 / 4294967296.0);
 }
 
 double rand_chance()
 {
-    std::uniform_real_distribution<double> urd(0.0, 100.0);
-    return urd(engine);
+    return rand_norm() * 100.0;
 }
 
 uint32 urandweighted(size_t count, double const* chances)
@@ -92,6 +91,11 @@ uint32 urandweighted(size_t count, double const* chances)
     return dd(engine);
 }
 
+void SetRandomSeed(uint32 seed)
+{
+    GetRng()->Seed(seed);
+}
+
 RandomEngine& RandomEngine::Instance()
 {
     return engine;
@@ -49,6 +49,9 @@ AC_COMMON_API double rand_chance();
 /* Return a random number in the range 0..count (exclusive) with each value having a different chance of happening */
 AC_COMMON_API uint32 urandweighted(size_t count, double const* chances);
 
+/* Reseeds the generator of the calling thread, so the numbers it draws from now on are reproducible. Other threads keep their random seeds. */
+AC_COMMON_API void SetRandomSeed(uint32 seed);
+
 /* Return true if a random roll fits in the specified chance (range 0-100). */
 inline bool roll_chance_f(float chance)
 {
@@ -56,7 +56,7 @@
 #include <emmintrin.h>
 #endif
 
-SFMTRand::SFMTRand()
+SFMTRand::SFMTRand() : _index(BUFFER_SIZE)
 {
     std::random_device dev;
 
@@ -73,9 +73,21 @@ SFMTRand::SFMTRand()
     }
 }
 
-uint32 SFMTRand::RandomUInt32()                            // Output random bits
+SFMTRand::SFMTRand(uint32 seed)
 {
-    return sfmt_genrand_uint32(&_state);
+    Seed(seed);
+}
+
+void SFMTRand::Seed(uint32 seed)
+{
+    sfmt_init_gen_rand(&_state, seed);
+    _index = BUFFER_SIZE;
+}
+
+void SFMTRand::Refill()
+{
+    sfmt_fill_array32(&_state, _buffer, BUFFER_SIZE);
+    _index = 0;
 }
 
 void* SFMTRand::operator new(size_t size, std::nothrow_t const&)
@@ -24,12 +24,26 @@
 
 /*
  * C++ Wrapper for SFMT
+ * Numbers are generated a block at a time into a buffer with SFMT's array fill,
+ * single draws only read the next buffered value.
  */
 class SFMTRand
 {
 public:
     SFMTRand();
-    uint32 RandomUInt32(); // Output random bits
+    explicit SFMTRand(uint32 seed);
+
+    /// Restarts the sequence, the same seed gives the same numbers
+    void Seed(uint32 seed);
+
+    uint32 RandomUInt32() // Output random bits
+    {
+        if (_index == BUFFER_SIZE)
+            Refill();
+
+        return _buffer[_index++];
+    }
+
     void* operator new(size_t size, std::nothrow_t const&);
     void operator delete(void* ptr, std::nothrow_t const&);
     void* operator new(size_t size);
@@ -39,7 +53,14 @@ public:
     void* operator new[](size_t size);
     void operator delete[](void* ptr);
 private:
+    // sfmt_fill_array32 needs at least SFMT_N32 values and a multiple of 4
+    static constexpr int BUFFER_SIZE = SFMT_N32 * 2;
+
+    void Refill();
+
     sfmt_t _state;
+    alignas(16) uint32 _buffer[BUFFER_SIZE];
+    int _index;
 };
 
 #endif // SFMTRand_h__
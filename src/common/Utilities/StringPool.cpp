@@ -0,0 +1,72 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StringPool.h"
+#include <cstring>
+
+std::string_view Acore::StringPool::Intern(std::string_view text)
+{
+    if (text.empty())
+        return { };
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _strings.find(text);
+    if (itr != _strings.end())
+        return *itr;
+
+    char* data = Allocate(text.size());
+    std::memcpy(data, text.data(), text.size());
+
+    std::string_view const pooled(data, text.size());
+    _strings.insert(pooled);
+    return pooled;
+}
+
+std::size_t Acore::StringPool::GetStringCount() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _strings.size();
+}
+
+std::size_t Acore::StringPool::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _memoryUsage + _strings.bucket_count() * sizeof(void*) + _strings.size() * (sizeof(std::string_view) + 2 * sizeof(void*));
+}
+
+char* Acore::StringPool::Allocate(std::size_t size)
+{
+    // long texts get a block of their own so the current block keeps filling up
+    if (size > _blockSize / 4)
+    {
+        _largeBlocks.push_back(std::make_unique<char[]>(size));
+        _memoryUsage += size;
+        return _largeBlocks.back().get();
+    }
+
+    if (_blocks.empty() || _blockUsed + size > _blockSize)
+    {
+        _blocks.push_back(std::make_unique<char[]>(_blockSize));
+        _blockUsed = 0;
+        _memoryUsage += _blockSize;
+    }
+
+    char* data = _blocks.back().get() + _blockUsed;
+    _blockUsed += size;
+    return data;
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_STRING_POOL_H
+#define ACORE_STRING_POOL_H
+
+#include "Define.h"
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace Acore
+{
+    /// Keeps one copy of every distinct string in large blocks and hands out views of it.
+    /// Meant for text loaded at startup that stays until shutdown: nothing is ever freed,
+    /// reloading a table only adds the strings that changed. Thread safe.
+    class AC_COMMON_API StringPool
+    {
+    public:
+        explicit StringPool(std::size_t blockSize = 64 * 1024) : _blockSize(blockSize) { }
+
+        StringPool(StringPool const&) = delete;
+        StringPool& operator=(StringPool const&) = delete;
+
+        /// return: a view of the pooled copy of text, valid as long as the pool
+        std::string_view Intern(std::string_view text);
+
+        std::size_t GetStringCount() const;
+        std::size_t GetMemoryUsage() const;
+
+    private:
+        char* Allocate(std::size_t size);
+
+        std::size_t const _blockSize;
+        mutable std::mutex _lock;
+        std::unordered_set<std::string_view> _strings;
+        std::vector<std::unique_ptr<char[]>> _blocks;
+        std::vector<std::unique_ptr<char[]>> _largeBlocks;
+        std::size_t _blockUsed = 0;
+        std::size_t _memoryUsage = 0;
+    };
+}
+
+#endif // ACORE_STRING_POOL_H
@@ -194,16 +194,6 @@ bool TaskScheduler::TaskQueue::IsEmpty() const
     return container.empty();
 }
 
-TaskContext& TaskContext::Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply)
-{
-    if (auto const owner = _owner.lock())
-    {
-        apply(*owner);
-    }
-
-    return *this;
-}
-
 bool TaskContext::IsExpired() const
 {
     return _owner.expired();
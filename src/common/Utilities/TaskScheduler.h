@@ -18,6 +18,7 @@
 #ifndef _TASK_SCHEDULER_H_
 #define _TASK_SCHEDULER_H_
 
+#include "NodePoolAllocator.h"
 #include "Util.h"
 #include <algorithm>
 #include <chrono>
@@ -120,6 +121,13 @@ class TaskScheduler
 
     typedef std::shared_ptr<Task> TaskContainer;
 
+    // Task and its shared_ptr control block share one pooled node
+    template<typename... Args>
+    static TaskContainer MakeTask(Args&&... args)
+    {
+        return std::allocate_shared<Task>(Acore::NodePoolAllocator<Task>(), std::forward<Args>(args)...);
+    }
+
     /// Container which provides Task order, insert and reschedule operations.
     struct Compare
     {
@@ -131,7 +139,7 @@ class TaskScheduler
 
     class TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        std::multiset<TaskContainer, Compare, Acore::NodePoolAllocator<TaskContainer>> container;
 
     public:
         // Pushes the task in the container
@@ -384,7 +392,7 @@ private:
     TaskScheduler& ScheduleAt(timepoint_t const& end,
                               std::chrono::duration<_Rep, _Period> const& time, task_handler_t const& task)
     {
-        return InsertTask(TaskContainer(new Task(end + time, time, task)));
+        return InsertTask(MakeTask(end + time, time, task));
     }
 
     /// Schedule an event with a fixed rate.
@@ -395,7 +403,7 @@ private:
                               group_t const group, task_handler_t const& task)
     {
         static repeated_t const DEFAULT_REPEATED = 0;
-        return InsertTask(TaskContainer(new Task(end + time, time, group, DEFAULT_REPEATED, task)));
+        return InsertTask(MakeTask(end + time, time, group, DEFAULT_REPEATED, task));
     }
 
     // Returns a random duration between min and max
@@ -428,16 +436,30 @@ class TaskContext
     std::shared_ptr<bool> _consumed;
 
     /// Dispatches an action safe on the TaskScheduler
-    TaskContext& Dispatch(std::function<TaskScheduler&(TaskScheduler&)> const& apply);
+    template<typename Apply>
+    TaskContext& Dispatch(Apply const& apply)
+    {
+        if (auto const owner = _owner.lock())
+        {
+            apply(*owner);
+        }
+
+        return *this;
+    }
+
+    static std::shared_ptr<bool> MakeConsumed(bool consumed)
+    {
+        return std::allocate_shared<bool>(Acore::NodePoolAllocator<bool>(), consumed);
+    }
 
 public:
     // Empty constructor
     TaskContext()
-        : _task(), _owner(), _consumed(std::make_shared<bool>(true)) { }
+        : _task(), _owner(), _consumed(MakeConsumed(true)) { }
 
     // Construct from task and owner
     explicit TaskContext(TaskScheduler::TaskContainer&& task, std::weak_ptr<TaskScheduler>&& owner)
-        : _task(task), _owner(owner), _consumed(std::make_shared<bool>(false)) { }
+        : _task(std::move(task)), _owner(std::move(owner)), _consumed(MakeConsumed(false)) { }
 
     // Copy construct
     TaskContext(TaskContext const& right)
@@ -494,7 +516,10 @@ public:
         _task->_end += duration;
         _task->_repeated += 1;
         (*_consumed) = true;
-        return Dispatch(std::bind(&TaskScheduler::InsertTask, std::placeholders::_1, _task));
+        return Dispatch([this](TaskScheduler& scheduler) -> TaskScheduler&
+        {
+            return scheduler.InsertTask(_task);
+        });
     }
 
     /// Repeats the event with the same duration.
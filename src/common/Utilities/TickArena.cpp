@@ -0,0 +1,138 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickArena.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace
+{
+    constexpr std::size_t INITIAL_BLOCK_SIZE = 64 * 1024;
+    constexpr std::size_t MAX_BLOCK_SIZE = 8 * 1024 * 1024;
+
+    std::atomic<uint64> OverflowBytes = 0;
+
+    // heap behind the first block, remembers how much the scope needed beyond it
+    class OverflowResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t TakeAllocatedBytes()
+        {
+            std::size_t bytes = _allocatedBytes;
+            _allocatedBytes = 0;
+            return bytes;
+        }
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            _allocatedBytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        std::size_t _allocatedBytes = 0;
+    };
+
+    struct TickArena
+    {
+        TickArena()
+        {
+            Reset(INITIAL_BLOCK_SIZE);
+        }
+
+        void Reset(std::size_t blockSize)
+        {
+            Resource.reset();
+            if (blockSize != BlockSize)
+            {
+                Block = std::make_unique<std::byte[]>(blockSize);
+                BlockSize = blockSize;
+            }
+
+            Resource.emplace(Block.get(), BlockSize, &Overflow);
+        }
+
+        // ends the outermost scope: everything is dropped, the first block grows by what overflowed
+        void Release()
+        {
+            std::size_t const overflow = Overflow.TakeAllocatedBytes();
+            if (!overflow)
+            {
+                Resource->release();
+                return;
+            }
+
+            OverflowBytes += overflow;
+
+            std::size_t blockSize = BlockSize;
+            while (blockSize < BlockSize + overflow && blockSize < MAX_BLOCK_SIZE)
+                blockSize *= 2;
+
+            Reset(blockSize);
+        }
+
+        OverflowResource Overflow;
+        std::unique_ptr<std::byte[]> Block;
+        std::size_t BlockSize = 0;
+        std::optional<std::pmr::monotonic_buffer_resource> Resource;
+        uint32 Depth = 0;
+    };
+
+    TickArena& GetThreadArena()
+    {
+        thread_local TickArena arena;
+        return arena;
+    }
+}
+
+Acore::TickArenaScope::TickArenaScope()
+{
+    ++GetThreadArena().Depth;
+}
+
+Acore::TickArenaScope::~TickArenaScope()
+{
+    TickArena& arena = GetThreadArena();
+    if (!--arena.Depth)
+        arena.Release();
+}
+
+std::pmr::memory_resource* Acore::GetTickMemoryResource()
+{
+    TickArena& arena = GetThreadArena();
+    if (!arena.Depth)
+        return std::pmr::new_delete_resource();
+
+    return &*arena.Resource;
+}
+
+uint64 Acore::TakeTickArenaOverflowBytes()
+{
+    return OverflowBytes.exchange(0);
+}
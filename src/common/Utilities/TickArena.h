@@ -0,0 +1,48 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_TICK_ARENA_H
+#define ACORE_TICK_ARENA_H
+
+#include "Define.h"
+#include <memory_resource>
+
+namespace Acore
+{
+    /// Marks code whose temporary containers may come from the arena of the current thread.
+    /// Every allocation inside the outermost scope is bump allocated and all of them are
+    /// dropped at once when it ends. Containers using the arena must be destroyed before
+    /// that, never store them in members; copies of them get the default resource.
+    class AC_COMMON_API TickArenaScope
+    {
+    public:
+        TickArenaScope();
+        ~TickArenaScope();
+
+        TickArenaScope(TickArenaScope const&) = delete;
+        TickArenaScope& operator=(TickArenaScope const&) = delete;
+    };
+
+    /// return: the arena of the calling thread inside a TickArenaScope, the heap outside of one
+    AC_COMMON_API std::pmr::memory_resource* GetTickMemoryResource();
+
+    /// Bytes the arenas took from the heap because their first block was full, since the last call.
+    /// The first block of an arena grows to fit the largest scope, so this drops to 0 after a few ticks
+    AC_COMMON_API uint64 TakeTickArenaOverflowBytes();
+}
+
+#endif // ACORE_TICK_ARENA_H
@@ -437,6 +437,10 @@ public:
     {
         return m_list.size();
     }
+    bool empty() const
+    {
+        return m_list.empty();
+    }
     ListIterator begin()
     {
         return m_list.begin();
@@ -24,6 +24,7 @@
 */
 
 #include "AppenderDB.h"
+#include "AuthCryptoPool.h"
 #include "AuthSocketMgr.h"
 #include "Banner.h"
 #include "Config.h"
@@ -38,6 +39,7 @@
 #include "OpenSSLCrypto.h"
 #include "ProcessPriority.h"
 #include "RealmList.h"
+#include "RealmListCache.h"
 #include "SecretMgr.h"
 #include "SharedDefines.h"
 #include "Util.h"
@@ -133,6 +135,7 @@ int main(int argc, char** argv)
 
     // Get the list of realms for the server
     sRealmList->Initialize(*ioContext, sConfigMgr->GetOption<int32>("RealmsStateUpdateDelay", 20));
+    sRealmListCache->SetCharacterCountsCacheTime(Seconds(sConfigMgr->GetOption<int32>("RealmListCharacterCountsCacheTime", 10)));
 
     std::shared_ptr<void> sRealmListHandle(nullptr, [](void*) { sRealmList->Close(); });
 
@@ -159,6 +162,10 @@ int main(int argc, char** argv)
 
     std::string bindIp = sConfigMgr->GetOption<std::string>("BindIP", "0.0.0.0");
 
+    // Stopped after the network, no session waits for a crypto task anymore
+    sAuthCryptoPool->Start(std::max<int32>(sConfigMgr->GetOption<int32>("CryptoThreads", 2), 0));
+    std::shared_ptr<void> sAuthCryptoPoolHandle(nullptr, [](void*) { sAuthCryptoPool->Stop(); });
+
     if (!sAuthSocketMgr.StartNetwork(*ioContext, bindIp, port))
     {
         LOG_ERROR("server.authserver", "Failed to initialize network");
@@ -0,0 +1,104 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuthCryptoPool.h"
+#include "Duration.h"
+#include "Log.h"
+
+bool AuthCryptoCallback::InvokeIfReady()
+{
+    if (_result.wait_for(0s) != std::future_status::ready)
+        return false;
+
+    // tasks dropped by AuthCryptoPool::Stop() never produced their result
+    try
+    {
+        _result.get();
+    }
+    catch (std::future_error const&)
+    {
+        return true;
+    }
+
+    _callback();
+    return true;
+}
+
+/*static*/ AuthCryptoPool* AuthCryptoPool::instance()
+{
+    static AuthCryptoPool instance;
+    return &instance;
+}
+
+void AuthCryptoPool::Start(uint32 threadCount)
+{
+    for (uint32 i = 0; i < threadCount; ++i)
+        _workers.emplace_back(&AuthCryptoPool::WorkerThread, this);
+
+    LOG_INFO("server.authserver", "Started {} crypto worker threads", threadCount);
+}
+
+void AuthCryptoPool::Stop()
+{
+    _queue.Cancel();
+
+    for (std::thread& worker : _workers)
+        worker.join();
+
+    _workers.clear();
+}
+
+AuthCryptoCallback AuthCryptoPool::EnqueueTask(char const* stage, std::function<void()>&& task, std::function<void()>&& callback)
+{
+    TimePoint const queued = std::chrono::steady_clock::now();
+    std::packaged_task<void()>* work = new std::packaged_task<void()>([stage, queued, task = std::move(task)]()
+    {
+        TimePoint const started = std::chrono::steady_clock::now();
+        task();
+
+        LOG_DEBUG("server.authserver", "[{}] waited {} us for a crypto worker, computed in {} us", stage,
+            std::chrono::duration_cast<Microseconds>(started - queued).count(),
+            std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - started).count());
+    });
+
+    std::future<void> result = work->get_future();
+    if (_workers.empty())
+    {
+        (*work)();
+        delete work;
+    }
+    else
+        _queue.Push(work);
+
+    return { std::move(result), std::move(callback) };
+}
+
+void AuthCryptoPool::WorkerThread()
+{
+    for (;;)
+    {
+        std::packaged_task<void()>* work = nullptr;
+        _queue.WaitAndPop(work);
+
+        // only returns without a task once the queue is cancelled
+        if (!work)
+            return;
+
+        (*work)();
+        delete work;
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AuthCryptoPool_h__
+#define AuthCryptoPool_h__
+
+#include "AsyncCallbackProcessor.h"
+#include "Define.h"
+#include "Optional.h"
+#include "PCQueue.h"
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/// Task of a session running on the AuthCryptoPool, the callback is invoked by the session once the task finished
+class AuthCryptoCallback
+{
+public:
+    AuthCryptoCallback(std::future<void>&& result, std::function<void()>&& callback) : _result(std::move(result)), _callback(std::move(callback)) { }
+    AuthCryptoCallback(AuthCryptoCallback&& right) = default;
+    AuthCryptoCallback& operator=(AuthCryptoCallback&& right) = default;
+
+    bool InvokeIfReady();
+
+private:
+    std::future<void> _result;
+    std::function<void()> _callback;
+};
+
+using AuthCryptoCallbackProcessor = AsyncCallbackProcessor<AuthCryptoCallback>;
+
+/// Worker threads for the SRP6 math of logins. The authserver has a single network thread,
+/// a login storm would otherwise keep it from answering realm lists and other clients.
+class AuthCryptoPool
+{
+public:
+    static AuthCryptoPool* instance();
+
+    void Start(uint32 threadCount);
+    void Stop();
+
+    /// Runs task on a worker thread, without workers it runs immediately. The task must not access the session,
+    /// callback receives the value returned by the task. stage names the login step in the latency log.
+    template<class Task, class Callback>
+    AuthCryptoCallback Enqueue(char const* stage, Task&& task, Callback&& callback)
+    {
+        using Result = std::invoke_result_t<Task>;
+
+        std::shared_ptr<Optional<Result>> result = std::make_shared<Optional<Result>>();
+        return EnqueueTask(stage,
+            [result, task = std::forward<Task>(task)]() mutable { result->emplace(task()); },
+            [result, callback = std::forward<Callback>(callback)]() mutable { callback(**result); });
+    }
+
+private:
+    AuthCryptoPool() = default;
+    ~AuthCryptoPool() = default;
+
+    AuthCryptoCallback EnqueueTask(char const* stage, std::function<void()>&& task, std::function<void()>&& callback);
+    void WorkerThread();
+
+    ProducerConsumerQueue<std::packaged_task<void()>*> _queue;
+    std::vector<std::thread> _workers;
+};
+
+#define sAuthCryptoPool AuthCryptoPool::instance()
+
+#endif // AuthCryptoPool_h__
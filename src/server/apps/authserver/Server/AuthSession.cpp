@@ -183,10 +183,16 @@ bool AuthSession::Update()
         return false;
 
     _queryProcessor.ProcessReadyCallbacks();
+    _cryptoProcessor.ProcessReadyCallbacks();
 
     return true;
 }
 
+bool AuthSession::HasPendingUpdate() const
+{
+    return AuthSocket::HasPendingUpdate() || !_queryProcessor.Empty() || !_cryptoProcessor.Empty();
+}
+
 void AuthSession::CheckIpCallback(PreparedQueryResult result)
 {
     if (result)
@@ -406,9 +412,24 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
         }
     }
 
-    _srp6.emplace(_accountInfo.Login,
-        fields[12].Get<Binary, Acore::Crypto::SRP6::SALT_LENGTH>(),
-        fields[13].Get<Binary, Acore::Crypto::SRP6::VERIFIER_LENGTH>());
+    // B = 3v + g^b is a modular exponentiation, computed by a crypto worker
+    _cryptoProcessor.AddCallback(sAuthCryptoPool->Enqueue("AuthChallenge",
+        [login = _accountInfo.Login, salt = fields[12].Get<Binary, Acore::Crypto::SRP6::SALT_LENGTH>(), verifier = fields[13].Get<Binary, Acore::Crypto::SRP6::VERIFIER_LENGTH>()]()
+        {
+            return std::make_shared<Acore::Crypto::SRP6>(login, salt, verifier);
+        },
+        [this, securityFlags](std::shared_ptr<Acore::Crypto::SRP6>& srp6)
+        {
+            _srp6 = std::move(srp6);
+            LogonChallengeCryptoCallback(securityFlags);
+        }));
+}
+
+void AuthSession::LogonChallengeCryptoCallback(uint8 securityFlags)
+{
+    ByteBuffer pkt;
+    pkt << uint8(AUTH_LOGON_CHALLENGE);
+    pkt << uint8(0x00);
 
     // Fill the response packet with the result
     if (AuthHelper::IsAcceptedClientBuild(_build))
@@ -443,7 +464,7 @@ void AuthSession::LogonChallengeCallback(PreparedQueryResult result)
             pkt << uint8(1);
 
         LOG_DEBUG("server.authserver", "'{}:{}' [AuthChallenge] account {} is using '{}' locale ({})",
-            ipAddress, port, _accountInfo.Login, _localizationName, GetLocaleByName(_localizationName));
+            GetRemoteIpAddress().to_string(), GetRemotePort(), _accountInfo.Login, _localizationName, GetLocaleByName(_localizationName));
 
         _status = STATUS_LOGON_PROOF;
     }
@@ -470,21 +491,43 @@ bool AuthSession::HandleLogonProof()
         return false;
     }
 
+    // the read buffer is reused once the handler returns, the token is taken out of it right away
+    Optional<uint32> incomingToken;
+    if ((logonProof->securityFlags & 0x04) && _totpSecret)
+    {
+        uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
+        std::string token(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
+        GetReadBuffer().ReadCompleted(sizeof(size) + size);
+
+        incomingToken = Acore::StringTo<uint32>(token);
+    }
+
+    // S = (Av^u)^b is a modular exponentiation, verified by a crypto worker
+    _cryptoProcessor.AddCallback(sAuthCryptoPool->Enqueue("AuthProof",
+        [srp6 = _srp6, A = logonProof->A, clientM = logonProof->clientM]()
+        {
+            return srp6->VerifyChallengeResponse(A, clientM);
+        },
+        [this, proof = *logonProof, incomingToken](Optional<SessionKey>& K)
+        {
+            LogonProofCryptoCallback(proof, K, incomingToken);
+        }));
+
+    return true;
+}
+
+void AuthSession::LogonProofCryptoCallback(sAuthLogonProof_C const& logonProof, Optional<SessionKey> const& K, Optional<uint32> incomingToken)
+{
     // Check if SRP6 results match (password is correct), else send an error
-    if (Optional<SessionKey> K = _srp6->VerifyChallengeResponse(logonProof->A, logonProof->clientM))
+    if (K)
     {
         _sessionKey = *K;
         // Check auth token
         bool tokenSuccess = false;
-        bool sentToken = (logonProof->securityFlags & 0x04);
+        bool sentToken = (logonProof.securityFlags & 0x04);
         if (sentToken && _totpSecret)
         {
-            uint8 size = *(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C));
-            std::string token(reinterpret_cast<char*>(GetReadBuffer().GetReadPointer() + sizeof(sAuthLogonProof_C) + sizeof(size)), size);
-            GetReadBuffer().ReadCompleted(sizeof(size) + size);
-
-            uint32 incomingToken = *Acore::StringTo<uint32>(token);
-            tokenSuccess = Acore::Crypto::TOTP::ValidateToken(*_totpSecret, incomingToken);
+            tokenSuccess = incomingToken && Acore::Crypto::TOTP::ValidateToken(*_totpSecret, *incomingToken);
             memset(_totpSecret->data(), 0, _totpSecret->size());
         }
         else if (!sentToken && !_totpSecret)
@@ -497,16 +540,16 @@ bool AuthSession::HandleLogonProof()
             packet << uint8(WOW_FAIL_UNKNOWN_ACCOUNT);
             packet << uint16(0);    // LoginFlags, 1 has account message
             SendPacket(packet);
-            return true;
+            return;
         }
 
-        if (!VerifyVersion(logonProof->A.data(), logonProof->A.size(), logonProof->crc_hash, false))
+        if (!VerifyVersion(logonProof.A.data(), logonProof.A.size(), logonProof.crc_hash, false))
         {
             ByteBuffer packet;
             packet << uint8(AUTH_LOGON_PROOF);
             packet << uint8(WOW_FAIL_VERSION_INVALID);
             SendPacket(packet);
-            return true;
+            return;
         }
 
         LOG_DEBUG("server.authserver", "'{}:{}' User '{}' successfully authenticated", GetRemoteIpAddress().to_string(), GetRemotePort(), _accountInfo.Login);
@@ -524,7 +567,7 @@ bool AuthSession::HandleLogonProof()
         LoginDatabase.DirectExecute(stmt);
 
         // Finish SRP6 and send the final result to the client
-        Acore::Crypto::SHA1::Digest M2 = Acore::Crypto::SRP6::GetSessionVerifier(logonProof->A, logonProof->clientM, _sessionKey);
+        Acore::Crypto::SHA1::Digest M2 = Acore::Crypto::SRP6::GetSessionVerifier(logonProof.A, logonProof.clientM, _sessionKey);
 
         ByteBuffer packet;
         if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
@@ -614,8 +657,6 @@ bool AuthSession::HandleLogonProof()
             }
         }
     }
-
-    return true;
 }
 
 bool AuthSession::HandleReconnectChallenge()
@@ -731,6 +772,13 @@ bool AuthSession::HandleRealmList()
 {
     LOG_DEBUG("server.authserver", "Entering _HandleRealmList");
 
+    // the client asks again every time the realm selection is opened
+    if (Optional<RealmListCache::CharacterCounts> characterCounts = sRealmListCache->GetCharacterCounts(_accountInfo.Id))
+    {
+        SendRealmList(*characterCounts);
+        return true;
+    }
+
     LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_REALM_CHARACTER_COUNTS);
     stmt->SetData(0, _accountInfo.Id);
 
@@ -741,7 +789,7 @@ bool AuthSession::HandleRealmList()
 
 void AuthSession::RealmListCallback(PreparedQueryResult result)
 {
-    std::map<uint32, uint8> characterCounts;
+    RealmListCache::CharacterCounts characterCounts;
     if (result)
     {
         do
@@ -751,61 +799,49 @@ void AuthSession::RealmListCallback(PreparedQueryResult result)
         } while (result->NextRow());
     }
 
+    sRealmListCache->SetCharacterCounts(_accountInfo.Id, characterCounts);
+    SendRealmList(characterCounts);
+}
+
+void AuthSession::SendRealmList(RealmListCache::CharacterCounts const& characterCounts)
+{
     // Circle through realms in the RealmList and construct the return packet (including # of user characters in each realm)
     ByteBuffer pkt;
 
     size_t RealmListSize = 0;
-    for (auto const& [realmHandle, realm] : sRealmList->GetRealms())
+    std::shared_ptr<RealmListCache::EntryList const> entries = sRealmListCache->GetEntries(_build, _expversion);
+    for (RealmListEntry const& entry : *entries)
     {
-        // don't work with realms which not compatible with the client
-        bool okBuild = ((_expversion & POST_BC_EXP_FLAG) && realm.Build == _build) || ((_expversion & PRE_BC_EXP_FLAG) && !AuthHelper::IsPreBCAcceptedClientBuild(realm.Build));
-
-        // No SQL injection. id of realm is controlled by the database.
-        uint32 flag = realm.Flags;
-        RealmBuildInfo const* buildInfo = sRealmList->GetBuildInfo(realm.Build);
-        if (!okBuild)
-        {
-            if (!buildInfo)
-                continue;
-
-            flag |= REALM_FLAG_OFFLINE | REALM_FLAG_SPECIFYBUILD;   // tell the client what build the realm is for
-        }
-
-        if (!buildInfo)
-            flag &= ~REALM_FLAG_SPECIFYBUILD;
-
-        std::string name = realm.Name;
-        if (_expversion & PRE_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
-        {
-            std::ostringstream ss;
-            ss << name << " (" << buildInfo->MajorVersion << '.' << buildInfo->MinorVersion << '.' << buildInfo->BugfixVersion << ')';
-            name = ss.str();
-        }
+        // removed since the cache was built
+        Realm const* realm = sRealmList->GetRealm(entry.Id);
+        if (!realm)
+            continue;
 
-        uint8 lock = (realm.AllowedSecurityLevel > _accountInfo.SecurityLevel) ? 1 : 0;
+        uint8 lock = (entry.AllowedSecurityLevel > _accountInfo.SecurityLevel) ? 1 : 0;
+        auto characterCount = characterCounts.find(entry.Id.Realm);
 
-        pkt << uint8(realm.Type);                           // realm type
+        pkt << uint8(entry.Type);                           // realm type
         if (_expversion & POST_BC_EXP_FLAG)                 // only 2.x and 3.x clients
             pkt << uint8(lock);                             // if 1, then realm locked
 
-        pkt << uint8(flag);                                 // RealmFlags
-        pkt << name;
-        pkt << boost::lexical_cast<std::string>(realm.GetAddressForClient(GetRemoteIpAddress()));
-        pkt << float(realm.PopulationLevel);
-        pkt << uint8(characterCounts[realm.Id.Realm]);
-        pkt << uint8(realm.Timezone);                       // realm category
+        pkt << uint8(entry.Flags);                          // RealmFlags
+        pkt << entry.Name;
+        pkt << boost::lexical_cast<std::string>(realm->GetAddressForClient(GetRemoteIpAddress()));
+        pkt << float(entry.PopulationLevel);
+        pkt << uint8(characterCount != characterCounts.end() ? characterCount->second : 0);
+        pkt << uint8(entry.Timezone);                       // realm category
 
         if (_expversion & POST_BC_EXP_FLAG)                 // 2.x and 3.x clients
-            pkt << uint8(realm.Id.Realm);
+            pkt << uint8(entry.Id.Realm);
         else
             pkt << uint8(0x0);                              // 1.12.1 and 1.12.2 clients
 
-        if (_expversion & POST_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
+        if (_expversion & POST_BC_EXP_FLAG && entry.Flags & REALM_FLAG_SPECIFYBUILD)
         {
-            pkt << uint8(buildInfo->MajorVersion);
-            pkt << uint8(buildInfo->MinorVersion);
-            pkt << uint8(buildInfo->BugfixVersion);
-            pkt << uint16(buildInfo->Build);
+            pkt << uint8(entry.BuildInfo->MajorVersion);
+            pkt << uint8(entry.BuildInfo->MinorVersion);
+            pkt << uint8(entry.BuildInfo->BugfixVersion);
+            pkt << uint16(entry.BuildInfo->Build);
         }
 
         ++RealmListSize;
@@ -19,12 +19,14 @@
 #define __AUTHSESSION_H__
 
 #include "AsyncCallbackProcessor.h"
+#include "AuthCryptoPool.h"
 #include "BigNumber.h"
 #include "ByteBuffer.h"
 #include "Common.h"
 #include "CryptoHash.h"
 #include "Optional.h"
 #include "QueryResult.h"
+#include "RealmListCache.h"
 #include "SRP6.h"
 #include "Socket.h"
 #include <boost/asio/ip/tcp.hpp>
@@ -34,6 +36,7 @@ using boost::asio::ip::tcp;
 
 class Field;
 struct AuthHandler;
+struct AUTH_LOGON_PROOF_C;
 
 enum AuthStatus
 {
@@ -72,6 +75,7 @@ public:
 
     void Start() override;
     bool Update() override;
+    [[nodiscard]] bool HasPendingUpdate() const override;
 
     void SendPacket(ByteBuffer& packet);
 
@@ -87,12 +91,15 @@ private:
 
     void CheckIpCallback(PreparedQueryResult result);
     void LogonChallengeCallback(PreparedQueryResult result);
+    void LogonChallengeCryptoCallback(uint8 securityFlags);
+    void LogonProofCryptoCallback(AUTH_LOGON_PROOF_C const& logonProof, Optional<SessionKey> const& K, Optional<uint32> incomingToken);
     void ReconnectChallengeCallback(PreparedQueryResult result);
     void RealmListCallback(PreparedQueryResult result);
+    void SendRealmList(RealmListCache::CharacterCounts const& characterCounts);
 
     bool VerifyVersion(uint8 const* a, int32 aLength, Acore::Crypto::SHA1::Digest const& versionProof, bool isReconnect);
 
-    Optional<Acore::Crypto::SRP6> _srp6;
+    std::shared_ptr<Acore::Crypto::SRP6> _srp6;
     SessionKey _sessionKey = {};
     std::array<uint8, 16> _reconnectProof = {};
 
@@ -106,6 +113,7 @@ private:
     uint8 _expversion;
 
     QueryCallbackProcessor _queryProcessor;
+    AuthCryptoCallbackProcessor _cryptoProcessor;
 };
 
 #pragma pack(push, 1)
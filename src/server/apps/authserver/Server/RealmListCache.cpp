@@ -0,0 +1,119 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RealmListCache.h"
+#include "AuthCodes.h"
+#include "RealmList.h"
+#include <sstream>
+
+/*static*/ RealmListCache* RealmListCache::instance()
+{
+    static RealmListCache instance;
+    return &instance;
+}
+
+std::shared_ptr<RealmListCache::EntryList const> RealmListCache::GetEntries(uint32 build, uint8 expversion)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    uint32 realmsUpdateCount = sRealmList->GetUpdateCount();
+    if (_realmsUpdateCount != realmsUpdateCount)
+    {
+        _entries.clear();
+        _realmsUpdateCount = realmsUpdateCount;
+    }
+
+    std::shared_ptr<EntryList const>& entries = _entries[build];
+    if (!entries)
+        entries = BuildEntries(build, expversion);
+
+    return entries;
+}
+
+/*static*/ std::shared_ptr<RealmListCache::EntryList const> RealmListCache::BuildEntries(uint32 build, uint8 expversion)
+{
+    std::shared_ptr<EntryList> entries = std::make_shared<EntryList>();
+
+    for (auto const& [realmHandle, realm] : sRealmList->GetRealms())
+    {
+        // don't work with realms which not compatible with the client
+        bool okBuild = ((expversion & POST_BC_EXP_FLAG) && realm.Build == build) || ((expversion & PRE_BC_EXP_FLAG) && !AuthHelper::IsPreBCAcceptedClientBuild(realm.Build));
+
+        // No SQL injection. id of realm is controlled by the database.
+        uint32 flag = realm.Flags;
+        RealmBuildInfo const* buildInfo = sRealmList->GetBuildInfo(realm.Build);
+        if (!okBuild)
+        {
+            if (!buildInfo)
+                continue;
+
+            flag |= REALM_FLAG_OFFLINE | REALM_FLAG_SPECIFYBUILD;   // tell the client what build the realm is for
+        }
+
+        if (!buildInfo)
+            flag &= ~REALM_FLAG_SPECIFYBUILD;
+
+        std::string name = realm.Name;
+        if (expversion & PRE_BC_EXP_FLAG && flag & REALM_FLAG_SPECIFYBUILD)
+        {
+            std::ostringstream ss;
+            ss << name << " (" << buildInfo->MajorVersion << '.' << buildInfo->MinorVersion << '.' << buildInfo->BugfixVersion << ')';
+            name = ss.str();
+        }
+
+        RealmListEntry& entry = entries->emplace_back();
+        entry.Id = realm.Id;
+        entry.Type = realm.Type;
+        entry.Flags = uint8(flag);
+        entry.Name = std::move(name);
+        entry.AllowedSecurityLevel = realm.AllowedSecurityLevel;
+        entry.PopulationLevel = realm.PopulationLevel;
+        entry.Timezone = realm.Timezone;
+        entry.BuildInfo = buildInfo;
+    }
+
+    return entries;
+}
+
+Optional<RealmListCache::CharacterCounts> RealmListCache::GetCharacterCounts(uint32 accountId)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    auto itr = _characterCounts.find(accountId);
+    if (itr == _characterCounts.end() || itr->second.Expires < std::chrono::steady_clock::now())
+        return {};
+
+    return itr->second.Counts;
+}
+
+void RealmListCache::SetCharacterCounts(uint32 accountId, CharacterCounts const& characterCounts)
+{
+    if (_characterCountsCacheTime <= 0s)
+        return;
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    TimePoint now = std::chrono::steady_clock::now();
+    _characterCounts[accountId] = { now + _characterCountsCacheTime, characterCounts };
+
+    // accounts that did not come back are dropped once in a while
+    if (_nextCharacterCountsCleanup < now)
+    {
+        std::erase_if(_characterCounts, [now](auto const& pair) { return pair.second.Expires < now; });
+        _nextCharacterCountsCleanup = now + _characterCountsCacheTime;
+    }
+}
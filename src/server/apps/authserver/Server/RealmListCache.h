@@ -0,0 +1,85 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RealmListCache_h__
+#define RealmListCache_h__
+
+#include "Common.h"
+#include "Duration.h"
+#include "Optional.h"
+#include "Realm.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct RealmBuildInfo;
+
+/// Realm list data of a realm that does not depend on the account or address of the client
+struct RealmListEntry
+{
+    RealmHandle Id;
+    uint8 Type;
+    uint8 Flags;
+    std::string Name;
+    AccountTypes AllowedSecurityLevel;
+    float PopulationLevel;
+    uint8 Timezone;
+    RealmBuildInfo const* BuildInfo;
+};
+
+/// Caches what clients on the realm selection screen ask for again and again: the realm list per client build,
+/// rebuilt after RealmList updated the realms, and the character counts per account for a short time
+class RealmListCache
+{
+public:
+    typedef std::vector<RealmListEntry> EntryList;
+    typedef std::map<uint32 /*realmId*/, uint8 /*count*/> CharacterCounts;
+
+    static RealmListCache* instance();
+
+    void SetCharacterCountsCacheTime(Seconds cacheTime) { _characterCountsCacheTime = cacheTime; }
+
+    std::shared_ptr<EntryList const> GetEntries(uint32 build, uint8 expversion);
+
+    Optional<CharacterCounts> GetCharacterCounts(uint32 accountId);
+    void SetCharacterCounts(uint32 accountId, CharacterCounts const& characterCounts);
+
+private:
+    RealmListCache() = default;
+    ~RealmListCache() = default;
+
+    static std::shared_ptr<EntryList const> BuildEntries(uint32 build, uint8 expversion);
+
+    struct CachedCharacterCounts
+    {
+        TimePoint Expires;
+        CharacterCounts Counts;
+    };
+
+    std::mutex _lock;
+    uint32 _realmsUpdateCount = 0;
+    std::unordered_map<uint32 /*build*/, std::shared_ptr<EntryList const>> _entries;
+    Seconds _characterCountsCacheTime = 0s;
+    TimePoint _nextCharacterCountsCleanup;
+    std::unordered_map<uint32 /*accountId*/, CachedCharacterCounts> _characterCounts;
+};
+
+#define sRealmListCache RealmListCache::instance()
+
+#endif // RealmListCache_h__
@@ -17,9 +17,15 @@
 
 #include "ACSoap.h"
 #include "AccountMgr.h"
+#include "Config.h"
 #include "Log.h"
+#include "StringFormat.h"
+#include "Tokenize.h"
 #include "World.h"
 #include "soapStub.h"
+#include <cstring>
+#include <memory>
+#include <vector>
 
 void ACSoapThread(const std::string& host, uint16 port)
 {
@@ -103,6 +109,10 @@ int ns1__executeCommand(soap* soap, char* command, char** result)
         return soap_sender_fault(soap, "Command can not be empty", "The supplied command was an empty string");
 
     LOG_DEBUG("network.soap", "ACSoap: got command '{}'", command);
+
+    if (sConfigMgr->GetOption<bool>("SOAP.BatchCommands", false) && std::strchr(command, '\n'))
+        return ExecuteCommandBatch(soap, command, result);
+
     SOAPCommand connection;
 
     // commands are executed in the world thread. We have to wait for them to be completed
@@ -126,6 +136,50 @@ int ns1__executeCommand(soap* soap, char* command, char** result)
         return soap_sender_fault(soap, printBuffer, printBuffer);
 }
 
+int ExecuteCommandBatch(soap* soap, char const* commands, char** result)
+{
+    std::vector<std::unique_ptr<SOAPCommand>> connections;
+    std::vector<std::string_view> lines;
+    std::vector<CliCommandHolder*> holders;
+
+    for (std::string_view line : Acore::Tokenize(commands, '\n', false))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        if (line.empty())
+            continue;
+
+        connections.push_back(std::make_unique<SOAPCommand>());
+        lines.push_back(line);
+        // CliCommandHolder will be deleted from world, accessing after queueing is NOT save
+        holders.push_back(new CliCommandHolder(connections.back().get(), std::string(line).c_str(), &SOAPCommand::print, &SOAPCommand::commandFinished));
+    }
+
+    // all commands of the request are executed by the same world update
+    sWorld->QueueCliCommands(holders);
+
+    bool succeeded = true;
+    std::string output;
+    for (std::size_t i = 0; i < connections.size(); ++i)
+    {
+        connections[i]->finishedPromise.get_future().wait();
+
+        succeeded = succeeded && connections[i]->hasCommandSucceeded();
+        output += Acore::StringFormatFmt("> {}{}\n", lines[i], connections[i]->hasCommandSucceeded() ? "" : " (failed)");
+        output += connections[i]->m_printBuffer;
+    }
+
+    char* printBuffer = soap_strdup(soap, output.c_str());
+    if (succeeded)
+    {
+        *result = printBuffer;
+        return SOAP_OK;
+    }
+
+    return soap_sender_fault(soap, printBuffer, printBuffer);
+}
+
 void SOAPCommand::commandFinished(void* soapconnection, bool success)
 {
     SOAPCommand* con = (SOAPCommand*)soapconnection;
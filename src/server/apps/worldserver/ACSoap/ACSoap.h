@@ -24,6 +24,8 @@
 
 void process_message(struct soap* soap_message);
 void ACSoapThread(const std::string& host, uint16 port);
+// executes every line of the request as a command, all queued to the world at once
+int ExecuteCommandBatch(struct soap* soap, char const* commands, char** result);
 
 class SOAPCommand
 {
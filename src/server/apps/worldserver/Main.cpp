@@ -28,27 +28,44 @@
 #include "BigNumber.h"
 #include "CliRunnable.h"
 #include "Common.h"
+#include "CollisionQueryCache.h"
 #include "Config.h"
+#include "Creature.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
+#include "DatabaseWorkQueue.h"
 #include "DeadlineTimer.h"
+#include "DynamicTree.h"
+#include "GameObject.h"
 #include "GitRevision.h"
+#include "HeapAllocator.h"
 #include "IoContext.h"
+#include "LootMgr.h"
+#include "MMapFactory.h"
 #include "MapMgr.h"
+#include "MemoryAccounting.h"
 #include "Metric.h"
 #include "ModuleMgr.h"
 #include "ModulesScriptLoader.h"
+#include "MovementGenerator.h"
 #include "MySQLThreading.h"
+#include "OpcodeStats.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvPMgr.h"
+#include "PathfindingService.h"
+#include "PreparedQueryCache.h"
+#include "PreparedStatementStats.h"
 #include "ProcessPriority.h"
 #include "RASession.h"
 #include "RealmList.h"
 #include "Resolver.h"
 #include "ScriptLoader.h"
 #include "ScriptMgr.h"
+#include "ScriptReloadMgr.h"
 #include "SecretMgr.h"
 #include "SharedDefines.h"
+#include "Spell.h"
+#include "TickArena.h"
 #include "World.h"
 #include "WorldSocket.h"
 #include "WorldSocketMgr.h"
@@ -250,8 +267,9 @@ int main(int argc, char** argv)
 
     for (int i = 0; i < numThreads; ++i)
     {
-        threadPool->push_back(std::thread([ioContext]()
+        threadPool->push_back(std::thread([ioContext, i]()
         {
+            SetupCurrentThread("ThreadPool", uint32(i));
             ioContext->run();
         }));
     }
@@ -268,7 +286,7 @@ int main(int argc, char** argv)
     std::shared_ptr<void> sScriptMgrHandle(nullptr, [](void*)
     {
         sScriptMgr->Unload();
-        //sScriptReloadMgr->Unload();
+        sScriptReloadMgr->Unload();
     });
 
     LOG_INFO("server.loading", "Initializing Scripts...");
@@ -288,9 +306,92 @@ int main(int argc, char** argv)
     sMetric->Initialize(realm.Name, *ioContext, []()
     {
         METRIC_VALUE("online_players", sWorld->GetPlayerCount());
+
+        for (int32 i = 0; i < sWorldSocketMgr.GetNetworkThreadCount(); ++i)
+            METRIC_VALUE("network_thread_connections", sWorldSocketMgr.GetConnectionCount(i), METRIC_TAG("thread", std::to_string(i)));
+        METRIC_VALUE("creature_loot_fills", LootTemplates_Creature.TakeFillCount());
+        METRIC_VALUE("creature_loot_fills_unopened", LootTemplates_Creature.TakeUnopenedFillCount());
         METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+
+        static constexpr std::array<std::string_view, MAX_DATABASE_QUEUE_LANES> laneNames = { "interactive", "normal", "background" };
+        for (uint8 lane = 0; lane < MAX_DATABASE_QUEUE_LANES; ++lane)
+        {
+            [[maybe_unused]] DatabaseQueueLaneStats stats = CharacterDatabase.GetQueueLaneStats(DatabaseQueueLane(lane));
+            METRIC_VALUE("db_queue_character_lane", uint64(stats.Size), METRIC_TAG("lane", std::string(laneNames[lane])));
+            METRIC_VALUE("db_queue_character_wait_avg", uint64(stats.AvgWaitMs), METRIC_TAG("lane", std::string(laneNames[lane])));
+            METRIC_VALUE("db_queue_character_wait_max", uint64(stats.MaxWaitMs), METRIC_TAG("lane", std::string(laneNames[lane])));
+        }
+
+        [[maybe_unused]] PreparedQueryCacheStats cacheStats = CharacterDatabase.GetQueryCacheStats();
+        METRIC_VALUE("db_query_cache_character_hits", cacheStats.Hits);
+        METRIC_VALUE("db_query_cache_character_misses", cacheStats.Misses);
+        METRIC_VALUE("db_query_cache_character_invalidations", cacheStats.Invalidations);
+        METRIC_VALUE("db_query_cache_character_entries", uint64(cacheStats.Entries));
+        METRIC_VALUE("db_journal_character_bytes", CharacterDatabase.JournalSize());
+        METRIC_VALUE("db_coalesced_writes_character", CharacterDatabase.TakeCoalescedWriteCount());
+
+        for ([[maybe_unused]] PreparedStatementStatsEntry const& stats : CharacterDatabase.GetStatementStats())
+        {
+            METRIC_VALUE("db_statement_character_count", stats.Count, METRIC_TAG("statement", std::to_string(stats.Index)));
+            METRIC_VALUE("db_statement_character_rows", stats.Rows, METRIC_TAG("statement", std::to_string(stats.Index)));
+            METRIC_VALUE("db_statement_character_avg_us", uint64(stats.AvgMicros), METRIC_TAG("statement", std::to_string(stats.Index)));
+            METRIC_VALUE("db_statement_character_p99_us", uint64(stats.P99Micros), METRIC_TAG("statement", std::to_string(stats.Index)));
+        }
+
+        METRIC_VALUE("pathfinding_queue", uint64(sPathfindingService->GetQueueSize()));
+        [[maybe_unused]] PathfindingSolveStats pathStats = sPathfindingService->TakeSolveStats();
+        METRIC_VALUE("pathfinding_solved", uint64(pathStats.Solved));
+        METRIC_VALUE("pathfinding_solve_avg_us", uint64(pathStats.AvgMicros));
+        METRIC_VALUE("pathfinding_solve_max_us", uint64(pathStats.MaxMicros));
+
+        [[maybe_unused]] uint64 pathCacheHits, pathCacheMisses;
+        MMAP::MMapFactory::createOrGetMMapMgr()->TakePathCacheStats(pathCacheHits, pathCacheMisses);
+        METRIC_VALUE("mmap_path_cache_hits", pathCacheHits);
+        METRIC_VALUE("mmap_path_cache_misses", pathCacheMisses);
+        METRIC_VALUE("grid_prefetch_hits", uint64(sMapMgr->GetGridPrefetcher()->TakeHits()));
+        METRIC_VALUE("collision_cache_hits", CollisionQueryCache::TakeHits());
+        METRIC_VALUE("collision_cache_misses", CollisionQueryCache::TakeMisses());
+
+        [[maybe_unused]] uint64 dynamicTreeRebuilds, dynamicTreeRebuildMicros;
+        DynamicMapTree::TakeRebuildStats(dynamicTreeRebuilds, dynamicTreeRebuildMicros);
+        METRIC_VALUE("dynamic_tree_rebuilds", dynamicTreeRebuilds);
+        METRIC_VALUE("dynamic_tree_rebuild_us", dynamicTreeRebuildMicros);
+        METRIC_VALUE("spell_pool_allocations", Spell::TakePoolAllocationCount());
+        METRIC_VALUE("spell_pool_reserved_bytes", uint64(Spell::GetPoolReservedBytes()));
+        METRIC_VALUE("creature_pool_allocations", Creature::TakePoolAllocationCount());
+        METRIC_VALUE("creature_pool_objects", Creature::GetPoolObjectCount());
+        METRIC_VALUE("creature_pool_reserved_bytes", uint64(Creature::GetPoolReservedBytes()));
+        METRIC_VALUE("gameobject_pool_allocations", GameObject::TakePoolAllocationCount());
+        METRIC_VALUE("gameobject_pool_objects", GameObject::GetPoolObjectCount());
+        METRIC_VALUE("gameobject_pool_reserved_bytes", uint64(GameObject::GetPoolReservedBytes()));
+        METRIC_VALUE("movement_generator_creations", MovementGenerator::TakeCreationCount());
+        METRIC_VALUE("movement_generator_pool_reserved_bytes", uint64(MovementGenerator::GetPoolReservedBytes()));
+        METRIC_VALUE("log_queued_messages", uint64(sLog->GetQueuedMessageCount()));
+        METRIC_VALUE("log_dropped_messages", sLog->TakeDroppedMessageCount());
+        METRIC_VALUE("tick_arena_overflow_bytes", Acore::TakeTickArenaOverflowBytes());
+
+        Acore::Heap::HeapStats heapStats;
+        if (Acore::Heap::GetHeapStats(heapStats))
+        {
+            METRIC_VALUE("heap_allocated_bytes", heapStats.Allocated);
+            METRIC_VALUE("heap_active_bytes", heapStats.Active);
+            METRIC_VALUE("heap_resident_bytes", heapStats.Resident);
+            METRIC_VALUE("heap_mapped_bytes", heapStats.Mapped);
+            METRIC_VALUE("heap_retained_bytes", heapStats.Retained);
+            for ([[maybe_unused]] Acore::Heap::ArenaStats const& arena : heapStats.Arenas)
+            {
+                METRIC_VALUE("heap_arena_allocated_bytes", arena.Allocated, METRIC_TAG("arena", arena.Name));
+                METRIC_VALUE("heap_arena_resident_bytes", arena.Resident, METRIC_TAG("arena", arena.Name));
+            }
+        }
+
+        for ([[maybe_unused]] auto const& [subsystem, size] : sMemoryAccounting->Collect())
+            METRIC_VALUE("memory_bytes", uint64(size), METRIC_TAG("subsystem", subsystem));
+
+        if (sWorld->getBoolConfig(CONFIG_OPCODE_STATS))
+            sOpcodeStatsMgr->LogMetrics();
     });
 
     METRIC_EVENT("events", "Worldserver started", "");
@@ -359,6 +460,11 @@ int main(int argc, char** argv)
 
     std::shared_ptr<void> sWorldSocketMgrHandle(nullptr, [](void*)
     {
+        // remember the grids of the players before they are kicked, the next start loads them first
+        std::string const warmRestartFile = sConfigMgr->GetOption<std::string>("WarmRestart.GridFile", "");
+        if (!warmRestartFile.empty())
+            sMapMgr->SaveWarmRestartGrids(warmRestartFile);
+
         sWorld->KickAll();              // save and kick all players
         sWorld->UpdateSessions(1);      // real players unload required UpdateSessions call
 
@@ -406,15 +512,19 @@ int main(int argc, char** argv)
         cliThread.reset(new std::thread(CliThread), &ShutdownCLIThread);
     }
 
-    // Launch auction listing thread
-    std::shared_ptr<std::thread> auctionListingThread;
-    auctionListingThread.reset(new std::thread(AuctionListingRunnable),
-        [](std::thread* thr)
+    // Launch auction listing threads
+    std::shared_ptr<std::vector<std::thread>> auctionListingThreads(new std::vector<std::thread>(),
+        [](std::vector<std::thread>* threads)
     {
-        thr->join();
-        delete thr;
+        for (std::thread& thr : *threads)
+            thr.join();
+
+        delete threads;
     });
 
+    for (int32 i = std::max(sConfigMgr->GetOption<int32>("AuctionHouse.ListingThreads", 2), 1); i > 0; --i)
+        auctionListingThreads->emplace_back(AuctionListingRunnable);
+
     WorldUpdateLoop();
 
     // Shutdown starts here
@@ -725,44 +835,10 @@ void AuctionListingRunnable()
 
     while (!World::IsStopped())
     {
-        Milliseconds diff = AsyncAuctionListingMgr::GetDiff();
-        AsyncAuctionListingMgr::ResetDiff();
-
-        if (!AsyncAuctionListingMgr::GetTempList().empty() || !AsyncAuctionListingMgr::GetList().empty())
-        {
-            {
-                std::lock_guard<std::mutex> guard(AsyncAuctionListingMgr::GetTempLock());
-
-                for (auto const& delayEvent: AsyncAuctionListingMgr::GetTempList())
-                    AsyncAuctionListingMgr::GetList().emplace_back(delayEvent);
-
-                AsyncAuctionListingMgr::GetTempList().clear();
-            }
-
-            for (auto& itr: AsyncAuctionListingMgr::GetList())
-            {
-                if (itr._pickupTimer <= diff)
-                {
-                    itr._pickupTimer = Milliseconds::zero();
-                }
-                else
-                {
-                    itr._pickupTimer -= diff;
-                }
-            }
-
-            for (auto itr = AsyncAuctionListingMgr::GetList().begin(); itr != AsyncAuctionListingMgr::GetList().end(); ++itr)
-            {
-                if ((*itr)._pickupTimer != Milliseconds::zero())
-                    continue;
-
-                if ((*itr).Execute())
-                    AsyncAuctionListingMgr::GetList().erase(itr);
-
-                break;
-            }
-        }
-        std::this_thread::sleep_for(1ms);
+        if (Optional<AuctionListItemsDelayEvent> delayEvent = AsyncAuctionListingMgr::PopReadyEvent())
+            delayEvent->Execute();
+        else
+            std::this_thread::sleep_for(1ms);
     }
 
     LOG_INFO("server", "Auction House Listing thread exiting without problems.");
@@ -25,6 +25,8 @@
 /*! Raw, ad-hoc query. */
 class AC_DATABASE_API BasicStatementTask : public SQLOperation
 {
+friend class DatabaseJournal;
+
 public:
     BasicStatementTask(std::string_view sql, bool async = false);
     ~BasicStatementTask();
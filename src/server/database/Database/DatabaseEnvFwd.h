@@ -42,6 +42,9 @@ using CharacterDatabasePreparedStatement = PreparedStatement<CharacterDatabaseCo
 using LoginDatabasePreparedStatement = PreparedStatement<LoginDatabaseConnection>;
 using WorldDatabasePreparedStatement = PreparedStatement<WorldDatabaseConnection>;
 
+class StreamedResultSet;
+using StreamedQueryResult = std::unique_ptr<StreamedResultSet>;
+
 class PreparedResultSet;
 using PreparedQueryResult = std::shared_ptr<PreparedResultSet>;
 using PreparedQueryResultFuture = std::future<PreparedQueryResult>;
@@ -84,6 +87,16 @@ using WorldDatabaseQueryHolder = SQLQueryHolder<WorldDatabaseConnection>;
 
 class SQLQueryHolderCallback;
 
+enum DatabaseQueueLane
+{
+    DATABASE_QUEUE_INTERACTIVE,     // async reads a player is waiting for (login, character list, ...)
+    DATABASE_QUEUE_NORMAL,          // one-way statements and transactions
+    DATABASE_QUEUE_BACKGROUND,      // work without ordering requirements (logs, keep alive pings)
+    MAX_DATABASE_QUEUE_LANES
+};
+
+class DatabaseWorkQueue;
+
 // mysql
 struct MySQLHandle;
 struct MySQLResult;
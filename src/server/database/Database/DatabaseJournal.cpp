@@ -0,0 +1,553 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseJournal.h"
+#include "AdhocStatement.h"
+#include "DatabaseWorkQueue.h"
+#include "Log.h"
+#include "PreparedStatement.h"
+#include "Transaction.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+    template<typename T>
+    void WriteValue(std::string& buffer, T value)
+    {
+        buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    void WriteString(std::string& buffer, std::string_view value)
+    {
+        WriteValue<uint32>(buffer, uint32(value.size()));
+        buffer.append(value);
+    }
+
+    void WriteStatement(std::string& buffer, PreparedStatementBase const* stmt)
+    {
+        std::vector<PreparedStatementData> const& parameters = stmt->GetParameters();
+
+        WriteValue<uint32>(buffer, stmt->GetIndex());
+        WriteValue<uint8>(buffer, uint8(parameters.size()));
+
+        for (PreparedStatementData const& parameter : parameters)
+        {
+            WriteValue<uint8>(buffer, uint8(parameter.data.index()));
+
+            std::visit([&buffer](auto const& value)
+            {
+                using ValueType = std::decay_t<decltype(value)>;
+
+                if constexpr (std::is_same_v<ValueType, std::string>)
+                    WriteString(buffer, value);
+                else if constexpr (std::is_same_v<ValueType, std::vector<uint8>>)
+                    WriteString(buffer, std::string_view(reinterpret_cast<char const*>(value.data()), value.size()));
+                else if constexpr (!std::is_same_v<ValueType, std::nullptr_t>)
+                    WriteValue<ValueType>(buffer, value);
+            }, parameter.data);
+        }
+    }
+
+    class RecordReader
+    {
+    public:
+        explicit RecordReader(std::string const& data) : _data(data), _position(0), _failed(false) { }
+
+        template<typename T>
+        T Read()
+        {
+            T value{};
+            if (_failed || _position + sizeof(T) > _data.size())
+            {
+                _failed = true;
+                return value;
+            }
+
+            std::memcpy(&value, _data.data() + _position, sizeof(T));
+            _position += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            uint32 size = Read<uint32>();
+            if (_failed || _position + size > _data.size())
+            {
+                _failed = true;
+                return { };
+            }
+
+            std::string value = _data.substr(_position, size);
+            _position += size;
+            return value;
+        }
+
+        PreparedStatementBase* ReadStatement()
+        {
+            uint32 index = Read<uint32>();
+            uint8 parameterCount = Read<uint8>();
+            if (_failed)
+                return nullptr;
+
+            PreparedStatementBase* stmt = new PreparedStatementBase(index, parameterCount);
+            for (uint8 i = 0; i < parameterCount && !_failed; ++i)
+            {
+                // alternatives in the order of PreparedStatementData::data
+                switch (Read<uint8>())
+                {
+                    case 0: stmt->SetData(i, Read<bool>()); break;
+                    case 1: stmt->SetData(i, Read<uint8>()); break;
+                    case 2: stmt->SetData(i, Read<uint16>()); break;
+                    case 3: stmt->SetData(i, Read<uint32>()); break;
+                    case 4: stmt->SetData(i, Read<uint64>()); break;
+                    case 5: stmt->SetData(i, Read<int8>()); break;
+                    case 6: stmt->SetData(i, Read<int16>()); break;
+                    case 7: stmt->SetData(i, Read<int32>()); break;
+                    case 8: stmt->SetData(i, Read<int64>()); break;
+                    case 9: stmt->SetData(i, Read<float>()); break;
+                    case 10: stmt->SetData(i, Read<double>()); break;
+                    case 11: stmt->SetData(i, std::string_view(ReadString())); break;
+                    case 12:
+                    {
+                        std::string value = ReadString();
+                        stmt->SetData(i, std::vector<uint8>(value.begin(), value.end()));
+                        break;
+                    }
+                    case 13: stmt->SetData(i); break;
+                    default: _failed = true; break;
+                }
+            }
+
+            if (_failed)
+            {
+                delete stmt;
+                return nullptr;
+            }
+
+            return stmt;
+        }
+
+        [[nodiscard]] bool Failed() const { return _failed; }
+
+    private:
+        std::string const& _data;
+        std::size_t _position;
+        bool _failed;
+    };
+}
+
+DatabaseJournal::DatabaseJournal(DatabaseWorkQueue* queue, std::string path, uint64 maxSize, std::size_t spillThreshold) :
+    _queue(queue),
+    _path(std::move(path)),
+    _maxSize(maxSize),
+    _spillThreshold(std::max<std::size_t>(spillThreshold, 2)),
+    _writer(nullptr),
+    _reader(nullptr),
+    _writeOffset(0),
+    _readOffset(0),
+    _spilling(false),
+    _stop(false) { }
+
+DatabaseJournal::~DatabaseJournal()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stop = true;
+    }
+
+    _itemAdded.notify_all();
+    _spaceFreed.notify_all();
+
+    if (_replayThread.joinable())
+        _replayThread.join();
+
+    std::size_t records = 0;
+    for (Item& item : _items)
+    {
+        if (item.Operation)
+            delete item.Operation;
+        else
+            ++records;
+    }
+
+    if (records)
+        LOG_WARN("sql.driver", "Database journal {} still holds {} operations, they are replayed at the next start.", _path, records);
+
+    _items.clear();
+
+    if (_writer)
+        fclose(_writer);
+
+    if (_reader)
+        fclose(_reader);
+}
+
+bool DatabaseJournal::Open()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (!Recover())
+            return false;
+    }
+
+    _replayThread = std::thread(&DatabaseJournal::ReplayThread, this);
+    return true;
+}
+
+bool DatabaseJournal::Accept(SQLOperation* operation, DatabaseQueueLane lane, uint32 orderingKey)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    if (_stop || !_writer)
+        return false;
+
+    if (!_spilling)
+    {
+        std::size_t const queueSize = _queue->Size();
+        if (queueSize < _spillThreshold)
+            return false;
+
+        _spilling = true;
+        LOG_WARN("sql.driver", "Database queue holds {} operations, journaling writes to {} until it has caught up.", queueSize, _path);
+    }
+
+    Item item{ operation, lane, orderingKey, 0, { } };
+
+    RecordType type;
+    std::string payload;
+    if (Serialize(operation, type, payload))
+    {
+        uint32 const recordSize = RecordHeaderSize + uint32(payload.size());
+
+        // back-pressure: wait for the replay thread, an empty journal takes any record
+        _spaceFreed.wait(lock, [&]()
+        {
+            return _stop || _writeOffset == _readOffset || _writeOffset - _readOffset + recordSize <= _maxSize;
+        });
+
+        // a failed write keeps the operation parked in memory, its order is kept either way
+        if (!_stop && Append(type, lane, orderingKey, payload))
+        {
+            item.Operation = nullptr;
+            item.RecordSize = recordSize;
+            item.CacheGuard = std::move(operation->m_cacheGuard);
+            delete operation;
+        }
+    }
+
+    _items.push_back(std::move(item));
+    _itemAdded.notify_one();
+    return true;
+}
+
+uint64 DatabaseJournal::GetPendingBytes() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _writeOffset - _readOffset;
+}
+
+std::size_t DatabaseJournal::GetPendingOperations() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _items.size();
+}
+
+bool DatabaseJournal::Serialize(SQLOperation const* operation, RecordType& type, std::string& payload)
+{
+    // operations handing out a result can't be replayed from a file
+    if (dynamic_cast<TransactionWithResultTask const*>(operation))
+        return false;
+
+    if (TransactionTask const* task = dynamic_cast<TransactionTask const*>(operation))
+    {
+        type = RECORD_TRANSACTION;
+        WriteValue<uint32>(payload, uint32(task->m_trans->m_queries.size()));
+
+        for (SQLElementData const& data : task->m_trans->m_queries)
+        {
+            WriteValue<uint8>(payload, uint8(data.type));
+
+            if (data.type == SQL_ELEMENT_RAW)
+                WriteString(payload, std::get<std::string>(data.element));
+            else
+                WriteStatement(payload, std::get<PreparedStatementBase*>(data.element));
+        }
+
+        return true;
+    }
+
+    if (PreparedStatementTask const* task = dynamic_cast<PreparedStatementTask const*>(operation))
+    {
+        if (task->m_has_result)
+            return false;
+
+        type = RECORD_STATEMENT;
+        WriteStatement(payload, task->m_stmt);
+        return true;
+    }
+
+    if (BasicStatementTask const* task = dynamic_cast<BasicStatementTask const*>(operation))
+    {
+        if (task->m_has_result)
+            return false;
+
+        type = RECORD_RAW;
+        WriteString(payload, task->m_sql);
+        return true;
+    }
+
+    return false;
+}
+
+SQLOperation* DatabaseJournal::Deserialize(RecordType type, std::string const& payload)
+{
+    RecordReader reader(payload);
+
+    switch (type)
+    {
+        case RECORD_RAW:
+        {
+            std::string sql = reader.ReadString();
+            if (!reader.Failed())
+                return new BasicStatementTask(sql);
+
+            break;
+        }
+        case RECORD_STATEMENT:
+        {
+            if (PreparedStatementBase* stmt = reader.ReadStatement())
+                return new PreparedStatementTask(stmt);
+
+            break;
+        }
+        case RECORD_TRANSACTION:
+        {
+            std::shared_ptr<TransactionBase> transaction = std::make_shared<TransactionBase>();
+
+            uint32 count = reader.Read<uint32>();
+            for (uint32 i = 0; i < count && !reader.Failed(); ++i)
+            {
+                if (reader.Read<uint8>() == SQL_ELEMENT_RAW)
+                {
+                    std::string sql = reader.ReadString();
+                    if (!reader.Failed())
+                        transaction->Append(sql);
+                }
+                else if (PreparedStatementBase* stmt = reader.ReadStatement())
+                    transaction->AppendPreparedStatement(stmt);
+            }
+
+            if (!reader.Failed())
+                return new TransactionTask(transaction);
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    return nullptr;
+}
+
+bool DatabaseJournal::Recover()
+{
+    std::error_code error;
+    uint64 fileSize = std::filesystem::exists(_path, error) ? std::filesystem::file_size(_path, error) : 0;
+    uint64 validSize = 0;
+
+    if (fileSize)
+    {
+        FILE* file = fopen(_path.c_str(), "rb");
+        if (!file)
+        {
+            LOG_ERROR("sql.driver", "Could not open the database journal {}.", _path);
+            return false;
+        }
+
+        // a crash may have left a partly written record at the end
+        char header[RecordHeaderSize];
+        while (fread(header, RecordHeaderSize, 1, file) == 1)
+        {
+            std::string headerData(header, RecordHeaderSize);
+            RecordReader reader(headerData);
+            uint32 payloadSize = reader.Read<uint32>();
+            uint8 type = reader.Read<uint8>();
+            uint8 lane = reader.Read<uint8>();
+            uint32 orderingKey = reader.Read<uint32>();
+
+            if (type >= MAX_RECORD_TYPES || lane >= MAX_DATABASE_QUEUE_LANES || validSize + RecordHeaderSize + payloadSize > fileSize)
+                break;
+
+            if (fseek(file, long(payloadSize), SEEK_CUR))
+                break;
+
+            _items.push_back({ nullptr, DatabaseQueueLane(lane), orderingKey, RecordHeaderSize + payloadSize, { } });
+            validSize += RecordHeaderSize + payloadSize;
+        }
+
+        fclose(file);
+
+        if (validSize < fileSize)
+        {
+            LOG_WARN("sql.driver", "Database journal {} ends with an incomplete record, {} bytes discarded.", _path, fileSize - validSize);
+            std::filesystem::resize_file(_path, validSize, error);
+        }
+
+        if (!_items.empty())
+        {
+            LOG_WARN("sql.driver", "Replaying {} operations left in the database journal {} by the previous run.", _items.size(), _path);
+            _spilling = true;
+        }
+    }
+
+    _writer = fopen(_path.c_str(), validSize ? "ab" : "wb");
+    _reader = fopen(_path.c_str(), "rb");
+    if (!_writer || !_reader)
+    {
+        LOG_ERROR("sql.driver", "Could not open the database journal {}.", _path);
+        return false;
+    }
+
+    _writeOffset = validSize;
+    _readOffset = 0;
+    return true;
+}
+
+bool DatabaseJournal::Append(RecordType type, DatabaseQueueLane lane, uint32 orderingKey, std::string const& payload)
+{
+    std::string record;
+    record.reserve(RecordHeaderSize + payload.size());
+    WriteValue<uint32>(record, uint32(payload.size()));
+    WriteValue<uint8>(record, uint8(type));
+    WriteValue<uint8>(record, uint8(lane));
+    WriteValue<uint32>(record, orderingKey);
+    record.append(payload);
+
+    if (fwrite(record.data(), record.size(), 1, _writer) != 1 || fflush(_writer))
+    {
+        LOG_ERROR("sql.driver", "Could not write to the database journal {}, keeping the operation in memory.", _path);
+
+        // drop the partial record so the next one starts at a known offset
+        std::error_code error;
+        fflush(_writer);
+        std::filesystem::resize_file(_path, _writeOffset, error);
+        return false;
+    }
+
+    _writeOffset += record.size();
+    return true;
+}
+
+SQLOperation* DatabaseJournal::ReadRecord(Item const& item)
+{
+    std::string record(item.RecordSize, '\0');
+
+    clearerr(_reader);
+    if (fread(record.data(), record.size(), 1, _reader) != 1)
+    {
+        LOG_ERROR("sql.driver", "Could not read from the database journal {}, operation lost.", _path);
+        return nullptr;
+    }
+
+    RecordReader header(record);
+    header.Read<uint32>();
+    RecordType type = RecordType(header.Read<uint8>());
+
+    SQLOperation* operation = Deserialize(type, record.substr(RecordHeaderSize));
+    if (!operation)
+        LOG_ERROR("sql.driver", "Skipped a corrupt record of the database journal {}.", _path);
+
+    return operation;
+}
+
+bool DatabaseJournal::ResetFiles()
+{
+    fclose(_writer);
+    fclose(_reader);
+
+    _writer = fopen(_path.c_str(), "wb");
+    _reader = fopen(_path.c_str(), "rb");
+    _writeOffset = 0;
+    _readOffset = 0;
+
+    if (!_writer || !_reader)
+    {
+        LOG_ERROR("sql.driver", "Could not reopen the database journal {}, writes are no longer journaled.", _path);
+
+        if (_writer)
+            fclose(_writer);
+
+        if (_reader)
+            fclose(_reader);
+
+        _writer = nullptr;
+        _reader = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void DatabaseJournal::ReplayThread()
+{
+    std::size_t const resumeSize = _spillThreshold / 2;
+
+    std::unique_lock<std::mutex> lock(_lock);
+    for (;;)
+    {
+        _itemAdded.wait(lock, [this]() { return _stop || !_items.empty(); });
+        if (_stop)
+            return;
+
+        // only feed the queue while it is short, the journal holds the rest
+        if (_queue->Size() >= resumeSize)
+        {
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            lock.lock();
+            continue;
+        }
+
+        Item item = std::move(_items.front());
+        _items.pop_front();
+
+        SQLOperation* operation = item.Operation;
+        if (!operation)
+        {
+            operation = ReadRecord(item);
+            if (operation)
+                operation->m_cacheGuard = std::move(item.CacheGuard);
+
+            _readOffset += item.RecordSize;
+            _spaceFreed.notify_all();
+        }
+
+        // pushed under the lock so nothing passes the journal before its last operation is queued
+        if (operation)
+            _queue->Push(operation, item.Lane, item.OrderingKey);
+
+        if (_items.empty())
+        {
+            _spilling = false;
+            if (ResetFiles())
+                LOG_INFO("sql.driver", "Database journal {} has been replayed.", _path);
+        }
+    }
+}
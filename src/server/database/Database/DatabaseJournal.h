@@ -0,0 +1,116 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATABASEJOURNAL_H
+#define _DATABASEJOURNAL_H
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include "PreparedQueryCache.h"
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class DatabaseWorkQueue;
+class SQLOperation;
+
+/**
+* @brief Write-behind journal of a DatabaseWorkerPool for database stalls.
+*
+* Once the async queue holds spillThreshold operations, writes without a result (statements, raw SQL and
+* transactions committed by CommitTransaction) are appended to a local append-only file instead of being
+* kept in memory, every other operation is parked in memory behind them. A replay thread feeds them back
+* into the queue in their original order whenever it is shorter than half the threshold, the file is
+* truncated once everything has been replayed.
+*
+* The journal holds at most maxSize bytes, callers trying to journal more are blocked until the replay
+* thread catches up. Records still in the file when the worldserver stops are replayed at the next start.
+*/
+class AC_DATABASE_API DatabaseJournal
+{
+public:
+    DatabaseJournal(DatabaseWorkQueue* queue, std::string path, uint64 maxSize, std::size_t spillThreshold);
+    ~DatabaseJournal();
+
+    //! Opens the journal file and starts the replay thread, records left by the previous run are replayed first
+    bool Open();
+
+    //! Takes over the operation while the queue is stalled or older operations are still journaled
+    bool Accept(SQLOperation* operation, DatabaseQueueLane lane, uint32 orderingKey);
+
+    //! Size of the records not replayed yet
+    [[nodiscard]] uint64 GetPendingBytes() const;
+
+    //! Journaled and parked operations not replayed yet
+    [[nodiscard]] std::size_t GetPendingOperations() const;
+
+private:
+    enum RecordType : uint8
+    {
+        RECORD_RAW,
+        RECORD_STATEMENT,
+        RECORD_TRANSACTION,
+
+        MAX_RECORD_TYPES
+    };
+
+    struct Item
+    {
+        SQLOperation* Operation;            ///< Parked operation, nullptr for the next record of the file
+        DatabaseQueueLane Lane;
+        uint32 OrderingKey;
+        uint32 RecordSize;
+        PreparedQueryCacheWriteGuard CacheGuard;
+    };
+
+    static constexpr uint32 RecordHeaderSize = sizeof(uint32) + sizeof(uint8) + sizeof(uint8) + sizeof(uint32);
+
+    static bool Serialize(SQLOperation const* operation, RecordType& type, std::string& payload);
+    static SQLOperation* Deserialize(RecordType type, std::string const& payload);
+
+    bool Recover();
+    bool Append(RecordType type, DatabaseQueueLane lane, uint32 orderingKey, std::string const& payload);
+    SQLOperation* ReadRecord(Item const& item);
+    bool ResetFiles();
+    void ReplayThread();
+
+    DatabaseWorkQueue* _queue;
+    std::string _path;
+    uint64 _maxSize;
+    std::size_t _spillThreshold;
+
+    FILE* _writer;
+    FILE* _reader;
+    uint64 _writeOffset;
+    uint64 _readOffset;
+
+    mutable std::mutex _lock;
+    std::condition_variable _itemAdded;
+    std::condition_variable _spaceFreed;
+    std::deque<Item> _items;
+    bool _spilling;
+    bool _stop;
+    std::thread _replayThread;
+
+    DatabaseJournal(DatabaseJournal const& right) = delete;
+    DatabaseJournal& operator=(DatabaseJournal const& right) = delete;
+};
+
+#endif
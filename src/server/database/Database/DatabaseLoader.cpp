@@ -21,14 +21,18 @@
 #include "DatabaseEnv.h"
 #include "Duration.h"
 #include "Log.h"
+#include "Timer.h"
+#include <algorithm>
 #include <errmsg.h>
 #include <mysqld_error.h>
 #include <thread>
+#include <vector>
 
 DatabaseLoader::DatabaseLoader(std::string const& logger, uint32 const defaultUpdateMask, std::string_view modulesList)
     : _logger(logger),
     _modulesList(modulesList),
     _autoSetup(sConfigMgr->GetOption<bool>("Updates.AutoSetup", true)),
+    _parallelUpdates(sConfigMgr->GetOption<bool>("Updates.Parallel", false)),
     _updateFlags(sConfigMgr->GetOption<uint32>("Updates.EnableDatabases", defaultUpdateMask)) { }
 
 template <class T>
@@ -57,6 +61,38 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
 
         pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
 
+        bool const queueLanes = sConfigMgr->GetOption<bool>(name + "Database.QueueLanes", false);
+        uint8 const interactiveThreads = sConfigMgr->GetOption<uint8>(name + "Database.InteractiveWorkerThreads", 0);
+        if (queueLanes && interactiveThreads >= asyncThreads)
+        {
+            LOG_ERROR(_logger, "{} database: {}Database.InteractiveWorkerThreads must be lower than {}Database.WorkerThreads.",
+                      name, name, name);
+            return false;
+        }
+
+        pool.SetQueueLanes(queueLanes, interactiveThreads);
+        pool.SetQueryHolderTasks(sConfigMgr->GetOption<uint8>(name + "Database.QueryHolderTasks", 1));
+
+        if (uint8 const maxAsyncThreads = sConfigMgr->GetOption<uint8>(name + "Database.MaxWorkerThreads", 0))
+        {
+            if (maxAsyncThreads < asyncThreads || maxAsyncThreads > 32)
+            {
+                LOG_ERROR(_logger, "{} database: {}Database.MaxWorkerThreads must be between {}Database.WorkerThreads and 32.",
+                          name, name, name);
+                return false;
+            }
+
+            pool.SetWorkerScaling(maxAsyncThreads,
+                sConfigMgr->GetOption<uint32>(name + "Database.ScaleQueueDepth", 100),
+                sConfigMgr->GetOption<uint32>(name + "Database.ScaleMaxLatency", 50));
+        }
+
+        if (uint32 const queryCacheSize = sConfigMgr->GetOption<uint32>(name + "Database.QueryCacheSize", 0))
+            pool.EnableQueryCache(queryCacheSize);
+
+        if (sConfigMgr->GetOption<bool>(name + "Database.CoalesceWrites", true))
+            pool.EnableWriteCoalescing();
+
         if (uint32 error = pool.Open())
         {
             // Try reconnect
@@ -145,6 +181,19 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
             return false;
         }
 
+        std::string const journalPath = sConfigMgr->GetOption<std::string>(name + "Database.Journal.Path", "");
+        if (!journalPath.empty())
+        {
+            uint64 const journalSize = uint64(sConfigMgr->GetOption<uint32>(name + "Database.Journal.MaxSize", 256)) * 1024 * 1024;
+            uint32 const spillThreshold = sConfigMgr->GetOption<uint32>(name + "Database.Journal.SpillThreshold", 5000);
+
+            if (!pool.OpenJournal(journalPath, journalSize, spillThreshold))
+            {
+                LOG_ERROR(_logger, "Could not open the write journal of the {} database at {}.", name, journalPath);
+                return false;
+            }
+        }
+
         return true;
     });
 
@@ -178,12 +227,28 @@ bool DatabaseLoader::OpenDatabases()
 
 bool DatabaseLoader::PopulateDatabases()
 {
-    return Process(_populate);
+    if (_populate.empty())
+        return true;
+
+    uint32 const oldMSTime = getMSTime();
+    if (!(_parallelUpdates ? ProcessParallel(_populate) : Process(_populate)))
+        return false;
+
+    LOG_INFO(_logger, ">> Checked and populated the databases in {} ms", GetMSTimeDiffToNow(oldMSTime));
+    return true;
 }
 
 bool DatabaseLoader::UpdateDatabases()
 {
-    return Process(_update);
+    if (_update.empty())
+        return true;
+
+    uint32 const oldMSTime = getMSTime();
+    if (!(_parallelUpdates ? ProcessParallel(_update) : Process(_update)))
+        return false;
+
+    LOG_INFO(_logger, ">> Updated the databases in {} ms", GetMSTimeDiffToNow(oldMSTime));
+    return true;
 }
 
 bool DatabaseLoader::PrepareStatements()
@@ -213,6 +278,32 @@ bool DatabaseLoader::Process(std::queue<Predicate>& queue)
     return true;
 }
 
+bool DatabaseLoader::ProcessParallel(std::queue<Predicate>& queue)
+{
+    // Every database has its own pool and update history, only the log output interleaves
+    std::vector<std::thread> threads;
+    std::vector<char> results(queue.size(), 0);
+    threads.reserve(queue.size());
+
+    for (size_t i = 0; !queue.empty(); ++i, queue.pop())
+        threads.emplace_back([&results, i, predicate = std::move(queue.front())]() { results[i] = predicate() ? 1 : 0; });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    if (std::find(results.begin(), results.end(), 0) == results.end())
+        return true;
+
+    // Close all open databases which have a registered close operation
+    while (!_close.empty())
+    {
+        _close.top()();
+        _close.pop();
+    }
+
+    return false;
+}
+
 template AC_DATABASE_API
 DatabaseLoader& DatabaseLoader::AddDatabase<LoginDatabaseConnection>(DatabaseWorkerPool<LoginDatabaseConnection>&, std::string const&);
 template AC_DATABASE_API
@@ -70,9 +70,13 @@ private:
     // Returns false when there was an error.
     bool Process(std::queue<Predicate>& queue);
 
+    // Same as Process, but invokes every function on its own thread
+    bool ProcessParallel(std::queue<Predicate>& queue);
+
     std::string const _logger;
     std::string_view _modulesList;
     bool const _autoSetup;
+    bool const _parallelUpdates;
     uint32 const _updateFlags;
 
     std::queue<Predicate> _open, _populate, _update, _prepare;
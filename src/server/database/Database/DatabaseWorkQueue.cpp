@@ -0,0 +1,230 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseWorkQueue.h"
+#include "SQLOperation.h"
+#include <algorithm>
+#include <utility>
+
+bool DatabaseWorkQueue::RegisterWorker()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _registeredWorkers++ < _interactiveWorkers;
+}
+
+void DatabaseWorkQueue::Push(SQLOperation* operation, DatabaseQueueLane lane, uint32 orderingKey)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    PushLocked(operation, lane, orderingKey, { });
+}
+
+void DatabaseWorkQueue::PushCoalesced(SQLOperation* operation, DatabaseQueueLane lane, std::string coalescingKey)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    PushLocked(operation, lane, 0, std::move(coalescingKey));
+}
+
+void DatabaseWorkQueue::PushLocked(SQLOperation* operation, DatabaseQueueLane lane, uint32 orderingKey, std::string coalescingKey)
+{
+    if (!_lanesEnabled)
+    {
+        lane = DATABASE_QUEUE_NORMAL;
+        orderingKey = 0;
+    }
+
+    bool orderedWrite = false;
+    if (orderingKey)
+    {
+        if (lane == DATABASE_QUEUE_INTERACTIVE)
+        {
+            // Reads must not overtake pending writes of the same key
+            if (_pendingOrderedWrites.find(orderingKey) != _pendingOrderedWrites.end())
+                lane = DATABASE_QUEUE_NORMAL;
+        }
+        else
+        {
+            // Keyed writes always use the normal lane, that's where keyed reads wait for them
+            lane = DATABASE_QUEUE_NORMAL;
+            orderedWrite = true;
+            ++_pendingOrderedWrites[orderingKey];
+        }
+    }
+
+    if (!coalescingKey.empty())
+    {
+        auto itr = _pendingCoalescedWrites.find(coalescingKey);
+        if (itr != _pendingCoalescedWrites.end())
+        {
+            // The dropped entry stays in its lane until popped, only its operation goes
+            Entry* previous = itr->second.first;
+            delete previous->Operation;
+            previous->Operation = nullptr;
+
+            ++_droppedEntries[itr->second.second];
+            ++_coalescedCount;
+        }
+    }
+
+    _lanes[lane].push_back({ operation, Clock::now(), orderingKey, orderedWrite, coalescingKey });
+
+    if (!coalescingKey.empty())
+        _pendingCoalescedWrites[std::move(coalescingKey)] = { &_lanes[lane].back(), lane };
+
+    if (lane == DATABASE_QUEUE_INTERACTIVE && _interactiveWorkers)
+        _interactiveCondition.notify_one();
+
+    _sharedCondition.notify_one();
+}
+
+bool DatabaseWorkQueue::PopLocked(SQLOperation*& operation, bool interactiveOnly)
+{
+    std::size_t lane = MAX_DATABASE_QUEUE_LANES;
+    if (!_lanes[DATABASE_QUEUE_INTERACTIVE].empty())
+        lane = DATABASE_QUEUE_INTERACTIVE;
+    else if (!interactiveOnly && !_lanes[DATABASE_QUEUE_NORMAL].empty())
+        lane = DATABASE_QUEUE_NORMAL;
+
+    if (!interactiveOnly && !_lanes[DATABASE_QUEUE_BACKGROUND].empty())
+        if (lane == MAX_DATABASE_QUEUE_LANES || (++_sharedPops % 8) == 0)
+            lane = DATABASE_QUEUE_BACKGROUND;
+
+    if (lane == MAX_DATABASE_QUEUE_LANES)
+        return false;
+
+    if (!_lanes[lane].front().CoalescingKey.empty())
+    {
+        auto itr = _pendingCoalescedWrites.find(_lanes[lane].front().CoalescingKey);
+        if (itr != _pendingCoalescedWrites.end() && itr->second.first == &_lanes[lane].front())
+            _pendingCoalescedWrites.erase(itr);
+    }
+
+    Entry entry = std::move(_lanes[lane].front());
+    _lanes[lane].pop_front();
+
+    if (entry.OrderedWrite)
+    {
+        auto itr = _pendingOrderedWrites.find(entry.OrderingKey);
+        if (itr != _pendingOrderedWrites.end() && !--itr->second)
+            _pendingOrderedWrites.erase(itr);
+    }
+
+    // Dropped for a newer write of the same key
+    if (!entry.Operation)
+    {
+        --_droppedEntries[lane];
+        return PopLocked(operation, interactiveOnly);
+    }
+
+    uint32 waitMs = uint32(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - entry.Queued).count());
+    WaitStats& stats = _waitStats[lane];
+    ++stats.Count;
+    stats.TotalWaitMs += waitMs;
+    stats.MaxWaitMs = std::max(stats.MaxWaitMs, waitMs);
+
+    operation = entry.Operation;
+    return true;
+}
+
+bool DatabaseWorkQueue::WaitAndPop(SQLOperation*& operation, bool interactiveOnly)
+{
+    std::unique_lock<std::mutex> lock(_lock);
+
+    std::condition_variable& condition = interactiveOnly ? _interactiveCondition : _sharedCondition;
+    while (!_shutdown)
+    {
+        if (!interactiveOnly && _retireRequests)
+        {
+            --_retireRequests;
+            return false;
+        }
+
+        if (PopLocked(operation, interactiveOnly))
+            return true;
+
+        condition.wait(lock);
+    }
+
+    return false;
+}
+
+void DatabaseWorkQueue::Cancel()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    for (std::deque<Entry>& lane : _lanes)
+    {
+        for (Entry& entry : lane)
+            delete entry.Operation;
+
+        lane.clear();
+    }
+
+    _pendingOrderedWrites.clear();
+    _pendingCoalescedWrites.clear();
+    _droppedEntries.fill(0);
+    _shutdown = true;
+
+    _interactiveCondition.notify_all();
+    _sharedCondition.notify_all();
+}
+
+void DatabaseWorkQueue::RetireWorker()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    ++_retireRequests;
+    _sharedCondition.notify_one();
+}
+
+std::size_t DatabaseWorkQueue::Size() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    std::size_t size = 0;
+    for (std::size_t lane = 0; lane < MAX_DATABASE_QUEUE_LANES; ++lane)
+        size += _lanes[lane].size() - _droppedEntries[lane];
+
+    return size;
+}
+
+std::size_t DatabaseWorkQueue::Size(DatabaseQueueLane lane) const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _lanes[lane].size() - _droppedEntries[lane];
+}
+
+DatabaseQueueLaneStats DatabaseWorkQueue::GetLaneStats(DatabaseQueueLane lane)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    WaitStats& stats = _waitStats[lane];
+
+    DatabaseQueueLaneStats result;
+    result.Size = _lanes[lane].size() - _droppedEntries[lane];
+    result.Processed = stats.Count;
+    result.AvgWaitMs = stats.Count ? uint32(stats.TotalWaitMs / stats.Count) : 0;
+    result.MaxWaitMs = stats.MaxWaitMs;
+
+    stats = WaitStats();
+    return result;
+}
+
+uint64 DatabaseWorkQueue::TakeCoalescedCount()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return std::exchange(_coalescedCount, 0);
+}
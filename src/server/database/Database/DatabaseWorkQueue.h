@@ -0,0 +1,124 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _DATABASEWORKQUEUE_H
+#define _DATABASEWORKQUEUE_H
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class SQLOperation;
+
+struct DatabaseQueueLaneStats
+{
+    std::size_t Size = 0;
+    uint64 Processed = 0;
+    uint32 AvgWaitMs = 0;
+    uint32 MaxWaitMs = 0;
+};
+
+/**
+* @brief Queue shared by the asynchronous connections of a DatabaseWorkerPool.
+*
+* When lanes are disabled every operation uses the normal lane, which is a plain FIFO.
+* Otherwise operations are split in lanes (see DatabaseQueueLane), each served in FIFO order. Shared workers
+* serve the interactive lane first, then the normal one, and give every 8th pop to the background
+* lane so it can't starve. A configurable number of workers only serve the interactive lane.
+*
+* Operations may carry an ordering key (e.g. an account id). An interactive operation queued while
+* writes with the same key are still pending is put in the normal lane so it can't overtake them.
+*
+* Last-write-wins writes carry a coalescing key (statement and row). Queueing one drops the pending write
+* with the same key, the new one is queued at the back so it still executes after everything queued before it.
+*/
+class AC_DATABASE_API DatabaseWorkQueue
+{
+public:
+    DatabaseWorkQueue() = default;
+
+    void SetLanesEnabled(bool enabled) { _lanesEnabled = enabled; }
+    void SetInteractiveWorkers(uint8 count) { _interactiveWorkers = count; _registeredWorkers = 0; }
+
+    /// Returns true if the calling worker must only serve the interactive lane
+    bool RegisterWorker();
+
+    void Push(SQLOperation* operation, DatabaseQueueLane lane, uint32 orderingKey = 0);
+    void PushCoalesced(SQLOperation* operation, DatabaseQueueLane lane, std::string coalescingKey);
+
+    /// Returns false once the calling worker has to exit, because the queue was canceled or it was retired
+    bool WaitAndPop(SQLOperation*& operation, bool interactiveOnly);
+    void Cancel();
+
+    /// Makes the next idle shared worker exit, see DatabaseWorkerPool::SetWorkerScaling
+    void RetireWorker();
+
+    [[nodiscard]] std::size_t Size() const;
+    [[nodiscard]] std::size_t Size(DatabaseQueueLane lane) const;
+
+    /// Returns the queue depth and the wait times since the previous call for the given lane
+    DatabaseQueueLaneStats GetLaneStats(DatabaseQueueLane lane);
+
+    /// Returns the number of writes dropped for a newer one since the previous call
+    uint64 TakeCoalescedCount();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        SQLOperation* Operation;
+        Clock::time_point Queued;
+        uint32 OrderingKey;
+        bool OrderedWrite;
+        std::string CoalescingKey;
+    };
+
+    struct WaitStats
+    {
+        uint64 Count = 0;
+        uint64 TotalWaitMs = 0;
+        uint32 MaxWaitMs = 0;
+    };
+
+    void PushLocked(SQLOperation* operation, DatabaseQueueLane lane, uint32 orderingKey, std::string coalescingKey);
+    bool PopLocked(SQLOperation*& operation, bool interactiveOnly);
+
+    mutable std::mutex _lock;
+    std::condition_variable _interactiveCondition;
+    std::condition_variable _sharedCondition;
+    std::array<std::deque<Entry>, MAX_DATABASE_QUEUE_LANES> _lanes;
+    std::array<WaitStats, MAX_DATABASE_QUEUE_LANES> _waitStats;
+    std::unordered_map<uint32, uint32> _pendingOrderedWrites;
+    std::unordered_map<std::string, std::pair<Entry*, DatabaseQueueLane>> _pendingCoalescedWrites; // deque::push_back/pop_front keep other elements in place
+    std::array<std::size_t, MAX_DATABASE_QUEUE_LANES> _droppedEntries{};
+    uint64 _coalescedCount = 0;
+    uint8 _interactiveWorkers = 0;
+    uint8 _registeredWorkers = 0;
+    uint8 _retireRequests = 0;
+    uint32 _sharedPops = 0;
+    bool _lanesEnabled = false;
+    bool _shutdown = false;
+};
+
+#endif
@@ -16,14 +16,17 @@
  */
 
 #include "DatabaseWorker.h"
-#include "PCQueue.h"
+#include "DatabaseWorkQueue.h"
+#include "ProcessPriority.h"
 #include "SQLOperation.h"
 
-DatabaseWorker::DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection)
+DatabaseWorker::DatabaseWorker(DatabaseWorkQueue* newQueue, MySQLConnection* connection)
 {
     _connection = connection;
     _queue = newQueue;
+    _interactiveOnly = _queue->RegisterWorker();
     _cancelationToken = false;
+    _finished = false;
     _workerThread = std::thread(&DatabaseWorker::WorkerThread, this);
 }
 
@@ -31,7 +34,9 @@ DatabaseWorker::~DatabaseWorker()
 {
     _cancelationToken = true;
 
-    _queue->Cancel();
+    // A retired worker leaves the queue to the others
+    if (!_finished)
+        _queue->Cancel();
 
     _workerThread.join();
 }
@@ -41,11 +46,19 @@ void DatabaseWorker::WorkerThread()
     if (!_queue)
         return;
 
+    // workers of all pools share one numbering, the pools restart and scale them independently
+    static std::atomic<uint32> workerIndex{0};
+    SetupCurrentThread("Database", workerIndex++);
+
     for (;;)
     {
         SQLOperation* operation = nullptr;
 
-        _queue->WaitAndPop(operation);
+        if (!_queue->WaitAndPop(operation, _interactiveOnly))
+        {
+            _finished = true;
+            return;
+        }
 
         if (_cancelationToken || !operation)
             return;
@@ -18,30 +18,33 @@
 #ifndef _WORKERTHREAD_H
 #define _WORKERTHREAD_H
 
+#include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include <atomic>
 #include <thread>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class MySQLConnection;
 class SQLOperation;
 
 class AC_DATABASE_API DatabaseWorker
 {
 public:
-    DatabaseWorker(ProducerConsumerQueue<SQLOperation*>* newQueue, MySQLConnection* connection);
+    DatabaseWorker(DatabaseWorkQueue* newQueue, MySQLConnection* connection);
     ~DatabaseWorker();
 
+    //! True once the worker thread exited because it was retired (or the queue canceled)
+    [[nodiscard]] bool IsFinished() const { return _finished; }
+
 private:
-    ProducerConsumerQueue<SQLOperation*>* _queue;
+    DatabaseWorkQueue* _queue;
     MySQLConnection* _connection;
+    bool _interactiveOnly;
 
     void WorkerThread();
     std::thread _workerThread;
 
     std::atomic<bool> _cancelationToken;
+    std::atomic<bool> _finished;
 
     DatabaseWorker(DatabaseWorker const& right) = delete;
     DatabaseWorker& operator=(DatabaseWorker const& right) = delete;
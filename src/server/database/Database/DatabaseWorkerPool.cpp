@@ -18,22 +18,29 @@
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
 #include "CharacterDatabase.h"
+#include "DatabaseJournal.h"
+#include "DatabaseWorkQueue.h"
 #include "Errors.h"
 #include "Log.h"
 #include "LoginDatabase.h"
 #include "MySQLPreparedStatement.h"
 #include "MySQLWorkaround.h"
-#include "PCQueue.h"
+#include "PreparedQueryCache.h"
 #include "PreparedStatement.h"
+#include "PreparedStatementStats.h"
 #include "QueryCallback.h"
 #include "QueryHolder.h"
 #include "QueryResult.h"
 #include "SQLOperation.h"
 #include "Transaction.h"
 #include "WorldDatabase.h"
+#include <algorithm>
+#include <chrono>
 #include <limits>
 #include <mysqld_error.h>
 #include <sstream>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 #ifdef ACORE_DEBUG
@@ -53,9 +60,15 @@ class PingOperation : public SQLOperation
 
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool() :
-    _queue(new ProducerConsumerQueue<SQLOperation*>()),
+    _queue(new DatabaseWorkQueue()),
     _async_threads(0),
-    _synch_threads(0)
+    _synch_threads(0),
+    _interactive_threads(0),
+    _queryHolderTasks(1),
+    _scalingStopped(false),
+    _max_async_threads(0),
+    _scaleQueueDepth(0),
+    _scaleMaxLatencyMs(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
 
@@ -76,6 +89,7 @@ DatabaseWorkerPool<T>::DatabaseWorkerPool() :
 template <class T>
 DatabaseWorkerPool<T>::~DatabaseWorkerPool()
 {
+    StopWorkerScaling();
     _queue->Cancel();
 }
 
@@ -88,13 +102,60 @@ void DatabaseWorkerPool<T>::SetConnectionInfo(std::string_view infoString, uint8
     _synch_threads = synchThreads;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::SetQueueLanes(bool enabled, uint8 const interactiveThreads)
+{
+    _queue->SetLanesEnabled(enabled);
+    _interactive_threads = enabled ? interactiveThreads : 0;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetQueryHolderTasks(uint8 const maxTasks)
+{
+    _queryHolderTasks = std::max<uint8>(maxTasks, 1);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetWorkerScaling(uint8 const maxAsyncThreads, uint32 queueDepth, uint32 maxLatencyMs)
+{
+    _max_async_threads = maxAsyncThreads;
+    _scaleQueueDepth = std::max<uint32>(queueDepth, 1);
+    _scaleMaxLatencyMs = maxLatencyMs;
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::EnableQueryCache(uint32 maxEntriesPerStatement)
+{
+    _queryCache = std::make_unique<PreparedQueryCache>(maxEntriesPerStatement);
+    T::RegisterCachedStatements(*_queryCache);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::EnableWriteCoalescing()
+{
+    T::RegisterCoalescedStatements(_coalescedStatements);
+}
+
+template <class T>
+bool DatabaseWorkerPool<T>::OpenJournal(std::string const& path, uint64 maxSize, uint32 spillThreshold)
+{
+    auto journal = std::make_unique<DatabaseJournal>(_queue.get(), path, maxSize, spillThreshold);
+    if (!journal->Open())
+        return false;
+
+    _journal = std::move(journal);
+    return true;
+}
+
 template <class T>
 uint32 DatabaseWorkerPool<T>::Open()
 {
     WPFatal(_connectionInfo.get(), "Connection info was not set!");
 
-    LOG_INFO("sql.driver", "Opening DatabasePool '{}'. Asynchronous connections: {}, synchronous connections: {}.",
-        GetDatabaseName(), _async_threads, _synch_threads);
+    LOG_INFO("sql.driver", "Opening DatabasePool '{}'. Asynchronous connections: {} ({} interactive only), synchronous connections: {}.",
+        GetDatabaseName(), _async_threads, _interactive_threads, _synch_threads);
+
+    _queue->SetInteractiveWorkers(_interactive_threads);
 
     uint32 error = OpenConnections(IDX_ASYNC, _async_threads);
 
@@ -119,6 +180,11 @@ void DatabaseWorkerPool<T>::Close()
 {
     LOG_INFO("sql.driver", "Closing down DatabasePool '{}'.", GetDatabaseName());
 
+    StopWorkerScaling();
+
+    //! Journaled writes not replayed yet are kept in the file for the next start
+    _journal.reset();
+
     //! Closes the actualy MySQL connection.
     _connections[IDX_ASYNC].clear();
 
@@ -175,6 +241,23 @@ bool DatabaseWorkerPool<T>::PrepareStatements()
         }
     }
 
+    if (!_statementStats)
+        _statementStats = std::make_unique<PreparedStatementStats>(_preparedStatementSize.size());
+
+    for (auto const& connections : _connections)
+        for (auto const& connection : connections)
+            connection->m_statementStats = _statementStats.get();
+
+    //! Async operations queued so far wait for the statements to be prepared
+    for (auto const& connection : _connections[IDX_ASYNC])
+        connection->StartWorker();
+
+    if (_max_async_threads > _async_threads && !_scalingThread.joinable())
+    {
+        _scalingStopped = false;
+        _scalingThread = std::thread(&DatabaseWorkerPool<T>::ScaleWorkers, this);
+    }
+
     return true;
 }
 
@@ -195,23 +278,59 @@ QueryResult DatabaseWorkerPool<T>::Query(std::string_view sql)
     return QueryResult(result);
 }
 
+template <class T>
+StreamedQueryResult DatabaseWorkerPool<T>::StreamQuery(std::string_view sql)
+{
+    auto connection = GetFreeConnection();
+
+    //! The result unlocks the connection once all rows were read or it is destroyed
+    StreamedQueryResult result(connection->StreamQuery(sql));
+    if (!result)
+    {
+        connection->Unlock();
+        return nullptr;
+    }
+
+    if (!result->NextRow())
+        return nullptr;
+
+    return result;
+}
+
 template <class T>
 PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
 {
+    uint64 cacheGeneration = 0;
+    bool const cached = _queryCache && _queryCache->IsCacheable(stmt->GetIndex());
+    if (cached)
+    {
+        if (Optional<PreparedQueryResult> result = _queryCache->Find(stmt, cacheGeneration))
+        {
+            delete stmt;
+            return *result;
+        }
+    }
+
     auto connection = GetFreeConnection();
     PreparedResultSet* ret = connection->Query(stmt);
     connection->Unlock();
 
-    //! Delete proxy-class. Not needed anymore
-    delete stmt;
+    bool const failed = !ret;
 
-    if (!ret || !ret->GetRowCount())
-    {
+    PreparedQueryResult result;
+    if (ret && ret->GetRowCount())
+        result.reset(ret);
+    else
         delete ret;
-        return PreparedQueryResult(nullptr);
-    }
 
-    return PreparedQueryResult(ret);
+    // empty results are cached too, failed queries are not
+    if (cached && !failed)
+        result = _queryCache->Store(stmt, cacheGeneration, std::move(result));
+
+    //! Delete proxy-class. Not needed anymore
+    delete stmt;
+
+    return result;
 }
 
 template <class T>
@@ -220,27 +339,46 @@ QueryCallback DatabaseWorkerPool<T>::AsyncQuery(std::string_view sql)
     BasicStatementTask* task = new BasicStatementTask(sql, true);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     QueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, DATABASE_QUEUE_INTERACTIVE);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
 {
+    uint64 cacheGeneration = 0;
+    bool const cached = _queryCache && _queryCache->IsCacheable(stmt->GetIndex());
+    if (cached)
+    {
+        if (Optional<PreparedQueryResult> result = _queryCache->Find(stmt, cacheGeneration))
+        {
+            delete stmt;
+
+            PreparedQueryResultPromise promise;
+            promise.set_value(std::move(*result));
+            return QueryCallback(promise.get_future());
+        }
+    }
+
     PreparedStatementTask* task = new PreparedStatementTask(stmt, true);
+    if (cached)
+        task->SetQueryCache(_queryCache.get(), cacheGeneration);
+
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
     PreparedQueryResultFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, DATABASE_QUEUE_INTERACTIVE);
     return QueryCallback(std::move(result));
 }
 
 template <class T>
 SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
 {
-    SQLQueryHolderTask* task = new SQLQueryHolderTask(holder);
+    std::vector<SQLQueryHolderTask*> tasks = SQLQueryHolderTask::CreateTasks(holder, _queryHolderTasks);
     // Store future result before enqueueing - task might get already processed and deleted before returning from this method
-    QueryResultHolderFuture result = task->GetFuture();
-    Enqueue(task);
+    QueryResultHolderFuture result = tasks.front()->GetFuture();
+    for (SQLQueryHolderTask* task : tasks)
+        Enqueue(task, DATABASE_QUEUE_INTERACTIVE, holder->GetOrderingKey());
+
     return { std::move(holder), std::move(result) };
 }
 
@@ -270,7 +408,12 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // ACORE_DEBUG
 
-    Enqueue(new TransactionTask(transaction));
+    uint32 orderingKey = transaction->GetOrderingKey();
+    TransactionTask* task = new TransactionTask(std::move(transaction));
+    if (_queryCache)
+        task->m_cacheGuard = _queryCache->BeginWrite(task->m_trans->m_queries);
+
+    Enqueue(task, DATABASE_QUEUE_NORMAL, orderingKey);
 }
 
 template <class T>
@@ -293,15 +436,23 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
     }
 #endif // ACORE_DEBUG
 
-    TransactionWithResultTask* task = new TransactionWithResultTask(transaction);
+    uint32 orderingKey = transaction->GetOrderingKey();
+    TransactionWithResultTask* task = new TransactionWithResultTask(std::move(transaction));
+    if (_queryCache)
+        task->m_cacheGuard = _queryCache->BeginWrite(task->m_trans->m_queries);
+
     TransactionFuture result = task->GetFuture();
-    Enqueue(task);
+    Enqueue(task, DATABASE_QUEUE_NORMAL, orderingKey);
     return TransactionCallback(std::move(result));
 }
 
 template <class T>
 void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transaction)
 {
+    PreparedQueryCacheWriteGuard cacheGuard;
+    if (_queryCache)
+        cacheGuard = _queryCache->BeginWrite(transaction->m_queries);
+
     T* connection = GetFreeConnection();
     int errorCode = connection->ExecuteTransaction(transaction);
 
@@ -365,10 +516,14 @@ void DatabaseWorkerPool<T>::KeepAlive()
     //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
     //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
     //! as the sole purpose is to prevent connections from idling.
-    auto const count = _connections[IDX_ASYNC].size();
+    std::size_t count;
+    {
+        std::lock_guard<std::mutex> lock(_scalingLock);
+        count = _connections[IDX_ASYNC].size();
+    }
 
-    for (uint8 i = 0; i < count; ++i)
-        Enqueue(new PingOperation);
+    for (std::size_t i = 0; i < count; ++i)
+        Enqueue(new PingOperation, DATABASE_QUEUE_BACKGROUND);
 }
 
 /**
@@ -469,6 +624,96 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
     return 0;
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::ScaleWorkers()
+{
+    //! Consecutive checks the queue was deep or empty
+    uint32 busyChecks = 0;
+    uint32 idleChecks = 0;
+
+    std::unique_lock<std::mutex> lock(_scalingLock);
+    while (!_scalingCondition.wait_for(lock, std::chrono::seconds(1), [this] { return _scalingStopped; }))
+    {
+        //! Drop the connections retired by a previous check
+        std::erase_if(_connections[IDX_ASYNC], [](std::unique_ptr<T> const& connection) { return connection->IsWorkerFinished(); });
+
+        std::size_t const queued = _queue->Size();
+        uint32 const latencyMs = uint32(_statementStats->TakeMeanDuration().count() / 1000);
+        std::size_t const connections = _connections[IDX_ASYNC].size();
+
+        if (queued >= _scaleQueueDepth)
+        {
+            ++busyChecks;
+            idleChecks = 0;
+        }
+        else if (!queued)
+        {
+            ++idleChecks;
+            busyChecks = 0;
+        }
+        else
+            busyChecks = idleChecks = 0;
+
+        if (busyChecks >= 3 && connections < _max_async_threads)
+        {
+            busyChecks = 0;
+
+            if (_scaleMaxLatencyMs && latencyMs > _scaleMaxLatencyMs)
+            {
+                LOG_DEBUG("sql.driver", "DatabasePool '{}' not growing, statements take {} ms on average with {} operations queued.",
+                    GetDatabaseName(), latencyMs, queued);
+                continue;
+            }
+
+            //! Opening the connection takes a while, KeepAlive must not wait for it
+            lock.unlock();
+
+            auto connection = std::make_unique<T>(_queue.get(), *_connectionInfo);
+            bool const opened = !connection->Open() && connection->PrepareStatements();
+            if (opened)
+            {
+                connection->m_statementStats = _statementStats.get();
+                connection->StartWorker();
+            }
+
+            lock.lock();
+
+            if (!opened)
+            {
+                LOG_ERROR("sql.driver", "DatabasePool '{}' could not open an additional asynchronous connection.", GetDatabaseName());
+                continue;
+            }
+
+            _connections[IDX_ASYNC].push_back(std::move(connection));
+
+            LOG_INFO("sql.driver", "DatabasePool '{}' grew to {} asynchronous connections, {} operations queued.",
+                GetDatabaseName(), _connections[IDX_ASYNC].size(), queued);
+        }
+        else if (idleChecks >= 60 && connections > _async_threads)
+        {
+            idleChecks = 0;
+            _queue->RetireWorker();
+
+            LOG_INFO("sql.driver", "DatabasePool '{}' shrinking to {} asynchronous connections.", GetDatabaseName(), connections - 1);
+        }
+    }
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::StopWorkerScaling()
+{
+    if (!_scalingThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_scalingLock);
+        _scalingStopped = true;
+    }
+
+    _scalingCondition.notify_all();
+    _scalingThread.join();
+}
+
 template <class T>
 unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, unsigned long length)
 {
@@ -479,9 +724,12 @@ unsigned long DatabaseWorkerPool<T>::EscapeString(char* to, char const* from, un
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op)
+void DatabaseWorkerPool<T>::Enqueue(SQLOperation* op, DatabaseQueueLane lane, uint32 orderingKey)
 {
-    _queue->Push(op);
+    if (_journal && _journal->Accept(op, lane, orderingKey))
+        return;
+
+    _queue->Push(op, lane, orderingKey);
 }
 
 template <class T>
@@ -490,6 +738,48 @@ size_t DatabaseWorkerPool<T>::QueueSize() const
     return _queue->Size();
 }
 
+template <class T>
+size_t DatabaseWorkerPool<T>::QueueSize(DatabaseQueueLane lane) const
+{
+    return _queue->Size(lane);
+}
+
+template <class T>
+DatabaseQueueLaneStats DatabaseWorkerPool<T>::GetQueueLaneStats(DatabaseQueueLane lane)
+{
+    return _queue->GetLaneStats(lane);
+}
+
+template <class T>
+PreparedQueryCacheStats DatabaseWorkerPool<T>::GetQueryCacheStats()
+{
+    if (!_queryCache)
+        return { };
+
+    return _queryCache->GetStats();
+}
+
+template <class T>
+uint64 DatabaseWorkerPool<T>::JournalSize() const
+{
+    return _journal ? _journal->GetPendingBytes() : 0;
+}
+
+template <class T>
+uint64 DatabaseWorkerPool<T>::TakeCoalescedWriteCount()
+{
+    return _queue->TakeCoalescedCount();
+}
+
+template <class T>
+std::vector<PreparedStatementStatsEntry> DatabaseWorkerPool<T>::GetStatementStats()
+{
+    if (!_statementStats)
+        return {};
+
+    return _statementStats->Collect();
+}
+
 template <class T>
 T* DatabaseWorkerPool<T>::GetFreeConnection()
 {
@@ -531,14 +821,50 @@ void DatabaseWorkerPool<T>::Execute(std::string_view sql)
         return;
 
     BasicStatementTask* task = new BasicStatementTask(sql);
-    Enqueue(task);
+    if (_queryCache)
+        task->m_cacheGuard = _queryCache->BeginRawWrite();
+
+    Enqueue(task, DATABASE_QUEUE_NORMAL);
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, DatabaseQueueLane lane)
 {
     PreparedStatementTask* task = new PreparedStatementTask(stmt);
-    Enqueue(task);
+    if (_queryCache)
+        task->m_cacheGuard = _queryCache->BeginWrite(stmt->GetIndex());
+
+    auto itr = _coalescedStatements.find(stmt->GetIndex());
+    if (itr == _coalescedStatements.end())
+    {
+        Enqueue(task, lane);
+        return;
+    }
+
+    if (_journal && _journal->Accept(task, lane, 0))
+        return;
+
+    //! Statement index followed by the raw values of the parameters identifying the row
+    std::string key(reinterpret_cast<char const*>(&itr->first), sizeof(itr->first));
+    for (uint8 param : itr->second)
+    {
+        PreparedStatementData const& data = stmt->GetParameters()[param];
+        key.push_back(char(data.data.index()));
+        std::visit([&key](auto const& value)
+        {
+            using Type = std::decay_t<decltype(value)>;
+            if constexpr (std::is_arithmetic_v<Type>)
+                key.append(reinterpret_cast<char const*>(&value), sizeof(value));
+            else if constexpr (!std::is_same_v<Type, std::nullptr_t>)
+            {
+                uint32 const size = uint32(value.size());
+                key.append(reinterpret_cast<char const*>(&size), sizeof(size));
+                key.append(reinterpret_cast<char const*>(value.data()), value.size());
+            }
+        }, data.data);
+    }
+
+    _queue->PushCoalesced(task, lane, std::move(key));
 }
 
 template <class T>
@@ -547,6 +873,10 @@ void DatabaseWorkerPool<T>::DirectExecute(std::string_view sql)
     if (sql.empty())
         return;
 
+    PreparedQueryCacheWriteGuard cacheGuard;
+    if (_queryCache)
+        cacheGuard = _queryCache->BeginRawWrite();
+
     T* connection = GetFreeConnection();
     connection->Execute(sql);
     connection->Unlock();
@@ -555,6 +885,10 @@ void DatabaseWorkerPool<T>::DirectExecute(std::string_view sql)
 template <class T>
 void DatabaseWorkerPool<T>::DirectExecute(PreparedStatement<T>* stmt)
 {
+    PreparedQueryCacheWriteGuard cacheGuard;
+    if (_queryCache)
+        cacheGuard = _queryCache->BeginWrite(stmt->GetIndex());
+
     T* connection = GetFreeConnection();
     connection->Execute(stmt);
     connection->Unlock();
@@ -22,6 +22,10 @@
 #include "Define.h"
 #include "StringFormat.h"
 #include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 /** @file DatabaseWorkerPool.h */
@@ -52,10 +56,13 @@
 */
 #define MIN_MARIADB_SERVER_VERSION "10.5.0"
 
-template <typename T>
-class ProducerConsumerQueue;
-
+class DatabaseJournal;
+class PreparedQueryCache;
+class PreparedStatementStats;
 class SQLOperation;
+struct DatabaseQueueLaneStats;
+struct PreparedQueryCacheStats;
+struct PreparedStatementStatsEntry;
 struct MySQLConnectionInfo;
 
 template <class T>
@@ -76,10 +83,32 @@ public:
 
     void SetConnectionInfo(std::string_view infoString, uint8 const asyncThreads, uint8 const synchThreads);
 
+    //! Enables the priority lanes of the async queue, interactiveThreads of the async connections only serve interactive reads
+    void SetQueueLanes(bool enabled, uint8 const interactiveThreads);
+
+    //! Splits the statements of async query holders in up to maxTasks operations, so several async connections
+    //! execute them at the same time. The holder callback still runs once, after all of them finished.
+    void SetQueryHolderTasks(uint8 const maxTasks);
+
+    //! Opens up to maxAsyncThreads async connections while queueDepth operations stay queued, unless the mean statement
+    //! duration exceeds maxLatencyMs (a saturated database isn't helped by more connections). Extra connections
+    //! are closed again once the queue stayed empty for a minute. Must be called before Open.
+    void SetWorkerScaling(uint8 const maxAsyncThreads, uint32 queueDepth, uint32 maxLatencyMs);
+
+    //! Caches the results of the read statements the connection type registers, up to maxEntriesPerStatement results each
+    void EnableQueryCache(uint32 maxEntriesPerStatement);
+
+    //! Drops a still queued async write of the statements the connection type registers when the same row is written again
+    void EnableWriteCoalescing();
+
+    //! Journals async writes to path while spillThreshold operations are queued, see DatabaseJournal.
+    //! Must be called once the statements are prepared, as records left by the previous run are replayed right away.
+    bool OpenJournal(std::string const& path, uint64 maxSize, uint32 spillThreshold);
+
     uint32 Open();
     void Close();
 
-    //! Prepares all prepared statements
+    //! Prepares all prepared statements and starts the async workers
     bool PrepareStatements();
 
     [[nodiscard]] inline MySQLConnectionInfo const* GetConnectionInfo() const
@@ -108,7 +137,8 @@ public:
 
     //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
     //! Statement must be prepared with CONNECTION_ASYNC flag.
-    void Execute(PreparedStatement<T>* stmt);
+    //! Use DATABASE_QUEUE_BACKGROUND for writes that nothing reads back soon (logs).
+    void Execute(PreparedStatement<T>* stmt, DatabaseQueueLane lane = DATABASE_QUEUE_NORMAL);
 
     /**
         Direct synchronous one-way statement methods.
@@ -152,6 +182,12 @@ public:
         return Query(Acore::StringFormatFmt(sql, std::forward<Args>(args)...));
     }
 
+    //! Directly executes an SQL query in string format that will block the calling thread until finished.
+    //! Rows are read from the server while iterating instead of being buffered first, use for large loads.
+    //! Keeps a synchronous connection locked until the result is destroyed, so no other synchronous
+    //! query must be issued on this pool while iterating.
+    StreamedQueryResult StreamQuery(std::string_view sql);
+
     //! Directly executes an SQL query in prepared format that will block the calling thread until finished.
     //! Returns reference counted auto pointer, no need for manual memory management in upper level code.
     //! Statement must be prepared with CONNECTION_SYNCH flag.
@@ -228,13 +264,33 @@ public:
     }
 
     [[nodiscard]] size_t QueueSize() const;
+    [[nodiscard]] size_t QueueSize(DatabaseQueueLane lane) const;
+
+    //! Queue depth and wait times since the previous call for the given lane
+    DatabaseQueueLaneStats GetQueueLaneStats(DatabaseQueueLane lane);
+
+    //! Query cache hits and misses since the previous call, all zero if the cache is disabled
+    PreparedQueryCacheStats GetQueryCacheStats();
+
+    //! Bytes of journaled writes not replayed yet
+    [[nodiscard]] uint64 JournalSize() const;
+
+    //! Async writes dropped for a newer write of the same row since the previous call
+    uint64 TakeCoalescedWriteCount();
+
+    //! Execution counters of the prepared statements executed since the previous call
+    std::vector<PreparedStatementStatsEntry> GetStatementStats();
 
 private:
     uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
+    //! Grows or shrinks the async connections every second while scaling is enabled
+    void ScaleWorkers();
+    void StopWorkerScaling();
+
     unsigned long EscapeString(char* to, char const* from, unsigned long length);
 
-    void Enqueue(SQLOperation* op);
+    void Enqueue(SQLOperation* op, DatabaseQueueLane lane, uint32 orderingKey = 0);
 
     //! Gets a free connection in the synchronous connection pool.
     //! Caller MUST call t->Unlock() after touching the MySQL context to prevent deadlocks.
@@ -243,11 +299,24 @@ private:
     [[nodiscard]] std::string_view GetDatabaseName() const;
 
     //! Queue shared by async worker threads.
-    std::unique_ptr<ProducerConsumerQueue<SQLOperation*>> _queue;
+    std::unique_ptr<DatabaseWorkQueue> _queue;
     std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
     std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
     std::vector<uint8> _preparedStatementSize;
-    uint8 _async_threads, _synch_threads;
+    std::unique_ptr<PreparedQueryCache> _queryCache;
+    std::unique_ptr<DatabaseJournal> _journal;          // destroyed first, its operations may hold query cache guards
+    std::unique_ptr<PreparedStatementStats> _statementStats;
+    std::unordered_map<uint32, std::vector<uint8>> _coalescedStatements;
+    uint8 _async_threads, _synch_threads, _interactive_threads;
+    uint8 _queryHolderTasks;
+
+    //! Worker scaling, _scalingLock also guards _connections[IDX_ASYNC] once the workers are started
+    std::thread _scalingThread;
+    std::mutex _scalingLock;
+    std::condition_variable _scalingCondition;
+    bool _scalingStopped;
+    uint8 _max_async_threads;
+    uint32 _scaleQueueDepth, _scaleMaxLatencyMs;
 #ifdef ACORE_DEBUG
     static inline thread_local bool _warnSyncQueries = false;
 #endif
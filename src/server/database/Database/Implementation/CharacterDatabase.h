@@ -124,6 +124,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_REP_ITEM_INSTANCE,
     CHAR_UPD_ITEM_INSTANCE,
     CHAR_UPD_ITEM_INSTANCE_ON_LOAD,
+    CHAR_UPD_ITEM_INSTANCE_DURABILITY,
     CHAR_DEL_ITEM_INSTANCE,
     CHAR_DEL_ITEM_INSTANCE_BY_OWNER,
     CHAR_UPD_GIFT_OWNER,
@@ -156,11 +157,9 @@ enum CharacterDatabaseStatements : uint32
     CHAR_INS_GUILD_BANK_RIGHT,
     CHAR_DEL_GUILD_BANK_RIGHTS,
     CHAR_DEL_GUILD_BANK_RIGHTS_FOR_RANK,
-    CHAR_INS_GUILD_BANK_EVENTLOG,
-    CHAR_DEL_GUILD_BANK_EVENTLOG,
+    CHAR_REP_GUILD_BANK_EVENTLOG,
     CHAR_DEL_GUILD_BANK_EVENTLOGS,
-    CHAR_INS_GUILD_EVENTLOG,
-    CHAR_DEL_GUILD_EVENTLOG,
+    CHAR_REP_GUILD_EVENTLOG,
     CHAR_DEL_GUILD_EVENTLOGS,
     CHAR_UPD_GUILD_MEMBER_PNOTE,
     CHAR_UPD_GUILD_MEMBER_OFFNOTE,
@@ -362,9 +361,9 @@ enum CharacterDatabaseStatements : uint32
     CHAR_SEL_GUILD_BANK_ITEM_BY_ENTRY,
     CHAR_DEL_CHAR_ACHIEVEMENT,
     CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS,
-    CHAR_INS_CHAR_ACHIEVEMENT,
+    CHAR_REP_CHAR_ACHIEVEMENT,
     CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA,
-    CHAR_INS_CHAR_ACHIEVEMENT_PROGRESS,
+    CHAR_REP_CHAR_ACHIEVEMENT_PROGRESS,
     CHAR_DEL_CHAR_REPUTATION_BY_FACTION,
     CHAR_INS_CHAR_REPUTATION_BY_FACTION,
     CHAR_UPD_CHAR_ARENA_POINTS,
@@ -531,11 +530,17 @@ public:
 
     //- Constructors for sync and async connections
     CharacterDatabaseConnection(MySQLConnectionInfo& connInfo);
-    CharacterDatabaseConnection(ProducerConsumerQueue<SQLOperation*>* q, MySQLConnectionInfo& connInfo);
+    CharacterDatabaseConnection(DatabaseWorkQueue* q, MySQLConnectionInfo& connInfo);
     ~CharacterDatabaseConnection() override;
 
     //- Loads database type specific prepared statements
     void DoPrepareStatements() override;
+
+    //- Read statements the query cache may keep, with the writes invalidating them
+    static void RegisterCachedStatements(PreparedQueryCache& cache);
+
+    //- Async writes whose pending copy is dropped when the same row is written again, with the parameters identifying the row
+    static void RegisterCoalescedStatements(CoalescedStatementKeys& keys);
 };
 
 #endif
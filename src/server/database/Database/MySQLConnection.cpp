@@ -22,15 +22,32 @@
 #include "MySQLPreparedStatement.h"
 #include "MySQLWorkaround.h"
 #include "PreparedStatement.h"
+#include "PreparedStatementStats.h"
 #include "QueryResult.h"
 #include "StringConvert.h"
 #include "Timer.h"
 #include "Tokenize.h"
 #include "Transaction.h"
+#include <atomic>
+#include <chrono>
 #include <errmsg.h>
 #include <mysql.h>
 #include <mysqld_error.h>
 
+namespace
+{
+    std::atomic<uint64> QueryCount = 0;
+    std::atomic<uint64> QueryRows = 0;
+    std::atomic<uint64> QueryMicroseconds = 0;
+
+    void RecordQuery(std::chrono::steady_clock::time_point start, uint64 rows)
+    {
+        QueryCount.fetch_add(1, std::memory_order_relaxed);
+        QueryRows.fetch_add(rows, std::memory_order_relaxed);
+        QueryMicroseconds.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+    }
+}
+
 MySQLConnectionInfo::MySQLConnectionInfo(std::string_view infoString)
 {
     std::vector<std::string_view> tokens = Acore::Tokenize(infoString, ';', true);
@@ -52,20 +69,19 @@ MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo) :
     m_reconnecting(false),
     m_prepareError(false),
     m_Mysql(nullptr),
+    m_statementStats(nullptr),
     m_queue(nullptr),
     m_connectionInfo(connInfo),
     m_connectionFlags(CONNECTION_SYNCH) { }
 
-MySQLConnection::MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo) :
+MySQLConnection::MySQLConnection(DatabaseWorkQueue* queue, MySQLConnectionInfo& connInfo) :
     m_reconnecting(false),
     m_prepareError(false),
     m_Mysql(nullptr),
+    m_statementStats(nullptr),
     m_queue(queue),
     m_connectionInfo(connInfo),
-    m_connectionFlags(CONNECTION_ASYNC)
-{
-    m_worker = std::make_unique<DatabaseWorker>(m_queue, this);
-}
+    m_connectionFlags(CONNECTION_ASYNC) { }
 
 MySQLConnection::~MySQLConnection()
 {
@@ -76,6 +92,7 @@ void MySQLConnection::Close()
 {
     // Stop the worker thread before the statements are cleared
     m_worker.reset();
+    m_batchStmts.clear();
     m_stmts.clear();
 
     if (m_Mysql)
@@ -85,6 +102,17 @@ void MySQLConnection::Close()
     }
 }
 
+void MySQLConnection::StartWorker()
+{
+    if (m_queue && !m_worker)
+        m_worker = std::make_unique<DatabaseWorker>(m_queue, this);
+}
+
+bool MySQLConnection::IsWorkerFinished() const
+{
+    return m_worker && m_worker->IsFinished();
+}
+
 uint32 MySQLConnection::Open()
 {
     MYSQL* mysqlInit = mysql_init(nullptr);
@@ -179,6 +207,7 @@ uint32 MySQLConnection::Open()
 
 bool MySQLConnection::PrepareStatements()
 {
+    m_batchStmts.clear();
     DoPrepareStatements();
     return !m_prepareError;
 }
@@ -226,6 +255,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    auto const start = std::chrono::steady_clock::now();
 
 #if !defined(MARIADB_VERSION_ID) && (MYSQL_VERSION_ID >= 80300)
     if (mysql_stmt_bind_named_param(msql_STMT, msql_BIND, m_mStmt->GetParameterCount(), nullptr))
@@ -257,6 +287,10 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
 
     LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
 
+    if (m_statementStats)
+        m_statementStats->Record(index, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start),
+            mysql_stmt_affected_rows(msql_STMT));
+
     m_mStmt->ClearParameters();
     return true;
 }
@@ -318,6 +352,68 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
     return true;
 }
 
+bool MySQLConnection::ExecuteBatch(PreparedStatementBase* const* stmts, uint32 stmtCount)
+{
+    if (!m_Mysql)
+        return false;
+
+    MySQLPreparedStatement* m_mStmt = GetBatchPreparedStatement(stmts[0]->GetIndex(), stmtCount);
+    if (!m_mStmt)
+    {
+        // Fall back to one round trip per row
+        for (uint32 i = 0; i < stmtCount; ++i)
+            if (!Execute(stmts[i]))
+                return false;
+
+        return true;
+    }
+
+    m_mStmt->BindParameters(stmts, stmtCount);
+
+    MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
+    MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
+
+    uint32 _s = getMSTime();
+    auto const start = std::chrono::steady_clock::now();
+
+#if !defined(MARIADB_VERSION_ID) && (MYSQL_VERSION_ID >= 80300)
+    if (mysql_stmt_bind_named_param(msql_STMT, msql_BIND, m_mStmt->GetParameterCount(), nullptr))
+#else
+    if (mysql_stmt_bind_param(msql_STMT, msql_BIND))
+#endif
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_ERROR("sql.sql", "SQL(p) x{}: {}\n [ERROR]: [{}] {}", stmtCount, m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
+
+        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return ExecuteBatch(stmts, stmtCount);       // Try again
+
+        m_mStmt->ClearParameters();
+        return false;
+    }
+
+    if (mysql_stmt_execute(msql_STMT))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_ERROR("sql.sql", "SQL(p) x{}: {}\n [ERROR]: [{}] {}", stmtCount, m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
+
+        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return ExecuteBatch(stmts, stmtCount);       // Try again
+
+        m_mStmt->ClearParameters();
+        return false;
+    }
+
+    LOG_DEBUG("sql.sql", "[{} ms] SQL(p) x{}: {}", getMSTimeDiff(_s, getMSTime()), stmtCount, m_mStmt->getQueryString());
+
+    if (m_statementStats)
+        m_statementStats->Record(stmts[0]->GetIndex(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start),
+            mysql_stmt_affected_rows(msql_STMT), stmtCount);
+
+    m_mStmt->ClearParameters();
+    return true;
+}
+
 ResultSet* MySQLConnection::Query(std::string_view sql)
 {
     if (sql.empty())
@@ -327,13 +423,49 @@ ResultSet* MySQLConnection::Query(std::string_view sql)
     MySQLField* fields = nullptr;
     uint64 rowCount = 0;
     uint32 fieldCount = 0;
+    auto const start = std::chrono::steady_clock::now();
 
     if (!_Query(sql, &result, &fields, &rowCount, &fieldCount))
+    {
+        RecordQuery(start, 0);
         return nullptr;
+    }
 
+    RecordQuery(start, rowCount);
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
+StreamedResultSet* MySQLConnection::StreamQuery(std::string_view sql)
+{
+    if (sql.empty() || !m_Mysql)
+        return nullptr;
+
+    uint32 _s = getMSTime();
+
+    if (mysql_query(m_Mysql, std::string(sql).c_str()))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        LOG_INFO("sql.sql", "SQL: {}", sql);
+        LOG_ERROR("sql.sql", "[{}] {}", lErrno, mysql_error(m_Mysql));
+
+        if (_HandleMySQLErrno(lErrno)) // If it returns true, an error was handled successfully (i.e. reconnection)
+            return StreamQuery(sql);    // We try again
+
+        return nullptr;
+    }
+
+    LOG_DEBUG("sql.sql", "[{} ms] SQL (streamed): {}", getMSTimeDiff(_s, getMSTime()), sql);
+
+    MYSQL_RES* result = mysql_use_result(m_Mysql);
+    if (!result)
+        return nullptr;
+
+    uint32 fieldCount = mysql_field_count(m_Mysql);
+    MySQLField* fields = reinterpret_cast<MySQLField*>(mysql_fetch_fields(result));
+
+    return new StreamedResultSet(this, reinterpret_cast<MySQLResult*>(result), fields, fieldCount);
+}
+
 bool MySQLConnection::_Query(std::string_view sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount)
 {
     if (!m_Mysql)
@@ -390,6 +522,17 @@ void MySQLConnection::CommitTransaction()
     Execute("COMMIT");
 }
 
+/// Largest multi-row statement size that fits the remaining rows. Only a few sizes
+/// are used so the number of prepared multi-row variants per statement stays small.
+static uint32 GetTransactionBatchSize(std::size_t remainingRows)
+{
+    for (uint32 size : { 64, 16, 4 })
+        if (remainingRows >= size)
+            return size;
+
+    return 1;
+}
+
 int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transaction)
 {
     std::vector<SQLElementData> const& queries = transaction->m_queries;
@@ -398,27 +541,67 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
     BeginTransaction();
 
-    for (auto const& data : queries)
+    auto getStatement = [](SQLElementData const& data) -> PreparedStatementBase*
+    {
+        PreparedStatementBase* stmt = nullptr;
+
+        try
+        {
+            stmt = std::get<PreparedStatementBase*>(data.element);
+        }
+        catch (const std::bad_variant_access& ex)
+        {
+            LOG_FATAL("sql.sql", "> PreparedStatementBase not found in SQLElementData. {}", ex.what());
+            ABORT();
+        }
+
+        ASSERT(stmt);
+        return stmt;
+    };
+
+    std::vector<PreparedStatementBase*> batch;
+
+    for (std::size_t i = 0; i < queries.size(); ++i)
     {
+        SQLElementData const& data = queries[i];
         switch (data.type)
         {
             case SQL_ELEMENT_PREPARED:
             {
-                PreparedStatementBase* stmt = nullptr;
+                PreparedStatementBase* stmt = getStatement(data);
 
-                try
+                // Consecutive executions of the same INSERT/REPLACE statement are merged into multi-row statements
+                batch.clear();
+                batch.push_back(stmt);
+
+                MySQLPreparedStatement* mysqlStmt = GetPreparedStatement(stmt->GetIndex());
+                if (mysqlStmt && mysqlStmt->IsBatchable())
                 {
-                    stmt = std::get<PreparedStatementBase*>(data.element);
+                    while (i + 1 < queries.size() && queries[i + 1].type == SQL_ELEMENT_PREPARED)
+                    {
+                        PreparedStatementBase* next = getStatement(queries[i + 1]);
+                        if (next->GetIndex() != stmt->GetIndex())
+                            break;
+
+                        batch.push_back(next);
+                        ++i;
+                    }
                 }
-                catch (const std::bad_variant_access& ex)
+
+                std::size_t executed = 0;
+                bool success = true;
+                while (success && executed < batch.size())
                 {
-                    LOG_FATAL("sql.sql", "> PreparedStatementBase not found in SQLElementData. {}", ex.what());
-                    ABORT();
-                }
+                    uint32 rowCount = GetTransactionBatchSize(batch.size() - executed);
+                    if (rowCount > 1)
+                        success = ExecuteBatch(batch.data() + executed, rowCount);
+                    else
+                        success = Execute(batch[executed]);
 
-                ASSERT(stmt);
+                    executed += rowCount;
+                }
 
-                if (!Execute(stmt))
+                if (!success)
                 {
                     LOG_WARN("sql.sql", "Transaction aborted. {} queries not executed.", queries.size());
                     int errorCode = GetLastError();
@@ -474,6 +657,15 @@ void MySQLConnection::Ping()
     mysql_ping(m_Mysql);
 }
 
+MySQLQueryTotals MySQLConnection::GetQueryTotals()
+{
+    MySQLQueryTotals totals;
+    totals.Queries = QueryCount.load(std::memory_order_relaxed);
+    totals.Rows = QueryRows.load(std::memory_order_relaxed);
+    totals.Microseconds = QueryMicroseconds.load(std::memory_order_relaxed);
+    return totals;
+}
+
 uint32 MySQLConnection::GetLastError()
 {
     return mysql_errno(m_Mysql);
@@ -513,6 +705,38 @@ MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
     return ret;
 }
 
+MySQLPreparedStatement* MySQLConnection::GetBatchPreparedStatement(uint32 index, uint32 rowCount)
+{
+    auto itr = m_batchStmts.find({ index, rowCount });
+    if (itr != m_batchStmts.end())
+        return itr->second.get();
+
+    MySQLPreparedStatement* baseStmt = GetPreparedStatement(index);
+    if (!baseStmt || !baseStmt->IsBatchable())
+        return nullptr;
+
+    std::string sql = baseStmt->GetBatchQueryString(rowCount);
+    std::unique_ptr<MySQLPreparedStatement>& batchStmt = m_batchStmts[{ index, rowCount }];
+
+    MYSQL_STMT* stmt = mysql_stmt_init(m_Mysql);
+    if (!stmt)
+    {
+        LOG_ERROR("sql.sql", "In mysql_stmt_init() id: {} x{}, sql: \"{}\"", index, rowCount, sql);
+        LOG_ERROR("sql.sql", "{}", mysql_error(m_Mysql));
+    }
+    else if (mysql_stmt_prepare(stmt, sql.c_str(), static_cast<unsigned long>(sql.size())))
+    {
+        // Keep the null entry so we don't retry to prepare it for every transaction
+        LOG_ERROR("sql.sql", "In mysql_stmt_prepare() id: {} x{}, sql: \"{}\"", index, rowCount, sql);
+        LOG_ERROR("sql.sql", "{}", mysql_stmt_error(stmt));
+        mysql_stmt_close(stmt);
+    }
+    else
+        batchStmt = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(stmt), sql);
+
+    return batchStmt.get();
+}
+
 void MySQLConnection::PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags)
 {
     // Check if specified query should be prepared on this connection
@@ -551,16 +775,27 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatementBase* stmt)
     MySQLResult* result = nullptr;
     uint64 rowCount = 0;
     uint32 fieldCount = 0;
+    auto const start = std::chrono::steady_clock::now();
 
     if (!_Query(stmt, &mysqlStmt, &result, &rowCount, &fieldCount))
+    {
+        RecordQuery(start, 0);
         return nullptr;
+    }
 
     if (mysql_more_results(m_Mysql))
     {
         mysql_next_result(m_Mysql);
     }
 
-    return new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+    PreparedResultSet* resultSet = new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
+
+    if (m_statementStats)
+        m_statementStats->Record(stmt->GetIndex(), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start),
+            resultSet->GetRowCount());
+
+    RecordQuery(start, resultSet->GetRowCount());
+    return resultSet;
 }
 
 bool MySQLConnection::_HandleMySQLErrno(uint32 errNo, uint8 attempts /*= 5*/)
@@ -24,13 +24,13 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-template <typename T>
-class ProducerConsumerQueue;
-
 class DatabaseWorker;
 class MySQLPreparedStatement;
+class PreparedQueryCache;
+class PreparedStatementStats;
 class SQLOperation;
 
 enum ConnectionFlags
@@ -40,6 +40,9 @@ enum ConnectionFlags
     CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH
 };
 
+//! Parameters identifying the row written by a last-write-wins statement, by statement index
+typedef std::unordered_map<uint32, std::vector<uint8>> CoalescedStatementKeys;
+
 struct AC_DATABASE_API MySQLConnectionInfo
 {
     explicit MySQLConnectionInfo(std::string_view infoString);
@@ -52,26 +55,42 @@ struct AC_DATABASE_API MySQLConnectionInfo
     std::string ssl;
 };
 
+//! Totals of the synchronous queries of every connection of the process
+struct MySQLQueryTotals
+{
+    uint64 Queries = 0;
+    uint64 Rows = 0;
+    uint64 Microseconds = 0;
+};
+
 class AC_DATABASE_API MySQLConnection
 {
 template <class T>
 friend class DatabaseWorkerPool;
 
 friend class PingOperation;
+friend class StreamedResultSet;
 
 public:
     MySQLConnection(MySQLConnectionInfo& connInfo);                               //! Constructor for synchronous connections.
-    MySQLConnection(ProducerConsumerQueue<SQLOperation*>* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
+    MySQLConnection(DatabaseWorkQueue* queue, MySQLConnectionInfo& connInfo);  //! Constructor for asynchronous connections.
     virtual ~MySQLConnection();
 
     virtual uint32 Open();
     void Close();
 
+    //! Starts the worker thread of an asynchronous connection, once its statements are prepared
+    void StartWorker();
+    //! True once the worker thread was retired by the pool
+    [[nodiscard]] bool IsWorkerFinished() const;
+
     bool PrepareStatements();
 
     bool Execute(std::string_view sql);
     bool Execute(PreparedStatementBase* stmt);
+    bool ExecuteBatch(PreparedStatementBase* const* stmts, uint32 stmtCount);
     ResultSet* Query(std::string_view sql);
+    StreamedResultSet* StreamQuery(std::string_view sql);
     PreparedResultSet* Query(PreparedStatementBase* stmt);
     bool _Query(std::string_view sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
     bool _Query(PreparedStatementBase* stmt, MySQLPreparedStatement** mysqlStmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount);
@@ -85,6 +104,15 @@ public:
 
     uint32 GetLastError();
 
+    //! Synchronous queries of all connections so far, used to profile the startup
+    static MySQLQueryTotals GetQueryTotals();
+
+    //! Registers the read statements DatabaseWorkerPool::EnableQueryCache may cache, hidden by the database types that have some
+    static void RegisterCachedStatements(PreparedQueryCache& /*cache*/) { }
+
+    //! Registers the async writes DatabaseWorkerPool::EnableWriteCoalescing may drop for a newer one, hidden by the database types that have some
+    static void RegisterCoalescedStatements(CoalescedStatementKeys& /*keys*/) { }
+
 protected:
     /// Tries to acquire lock. If lock is acquired by another thread
     /// the calling parent will just try another connection
@@ -96,6 +124,7 @@ protected:
     [[nodiscard]] uint32 GetServerVersion() const;
     [[nodiscard]] std::string GetServerInfo() const;
     MySQLPreparedStatement* GetPreparedStatement(uint32 index);
+    MySQLPreparedStatement* GetBatchPreparedStatement(uint32 index, uint32 rowCount);
     void PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags);
 
     virtual void DoPrepareStatements() = 0;
@@ -104,12 +133,14 @@ protected:
     typedef std::vector<std::unique_ptr<MySQLPreparedStatement>> PreparedStatementContainer;
 
     PreparedStatementContainer m_stmts; //! PreparedStatements storage
+    std::map<std::pair<uint32, uint32>, std::unique_ptr<MySQLPreparedStatement>> m_batchStmts; //! Multi-row variants of m_stmts, prepared on first use
     bool m_reconnecting;  //! Are we reconnecting?
     bool m_prepareError;  //! Was there any error while preparing statements?
     MySQLHandle* m_Mysql; //! MySQL Handle.
+    PreparedStatementStats* m_statementStats; //! Execution counters of the pool, null until the statements are prepared
 
 private:
-    ProducerConsumerQueue<SQLOperation*>* m_queue;      //! Queue shared with other asynchronous connections.
+    DatabaseWorkQueue* m_queue;      //! Queue shared with other asynchronous connections.
     std::unique_ptr<DatabaseWorker> m_worker;           //! Core worker task.
     MySQLConnectionInfo& m_connectionInfo;              //! Connection info (used for logging)
     ConnectionFlags m_connectionFlags;                  //! Connection flags (for preparing relevant statements)
@@ -20,6 +20,8 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "PreparedStatement.h"
+#include <algorithm>
+#include <cctype>
 
 template<typename T>
 struct MySQLType { };
@@ -35,11 +37,50 @@ template<> struct MySQLType<int64> : std::integral_constant<enum_field_types, MY
 template<> struct MySQLType<float> : std::integral_constant<enum_field_types, MYSQL_TYPE_FLOAT> { };
 template<> struct MySQLType<double> : std::integral_constant<enum_field_types, MYSQL_TYPE_DOUBLE> { };
 
+/// Returns the offset of the trailing "(?, ...)" group of an INSERT/REPLACE ... VALUES statement,
+/// or npos if the statement has placeholders anywhere else and can't be merged into a multi-row statement
+static std::size_t FindBatchValuesGroup(std::string const& query)
+{
+    std::size_t start = query.find_first_not_of(" \t\n");
+    if (start == std::string::npos)
+        return std::string::npos;
+
+    auto startsWith = [&](std::string_view keyword)
+    {
+        return query.size() >= start + keyword.size() && std::equal(keyword.begin(), keyword.end(), query.begin() + start,
+            [](char a, char b) { return a == std::toupper(static_cast<unsigned char>(b)); });
+    };
+
+    if (!startsWith("INSERT") && !startsWith("REPLACE"))
+        return std::string::npos;
+
+    std::size_t end = query.find_last_not_of(" \t\n;");
+    if (end == std::string::npos || query[end] != ')')
+        return std::string::npos;
+
+    std::size_t open = query.rfind('(', end);
+    if (open == std::string::npos || query.find_first_not_of("?, ", open + 1) != end)
+        return std::string::npos;
+
+    // No placeholders allowed before the values group (INSERT ... SELECT, subqueries, ...)
+    if (query.rfind('?', open) != std::string::npos)
+        return std::string::npos;
+
+    std::string upper(query.begin(), query.begin() + open);
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+    std::size_t values = upper.find_last_not_of(" \t\n");
+    if (values == std::string::npos || values < 5 || upper.compare(values - 5, 6, "VALUES") != 0)
+        return std::string::npos;
+
+    return open;
+}
+
 MySQLPreparedStatement::MySQLPreparedStatement(MySQLStmt* stmt, std::string_view queryString) :
     m_stmt(nullptr),
     m_Mstmt(stmt),
     m_bind(nullptr),
-    m_queryString(std::string(queryString))
+    m_queryString(std::string(queryString)),
+    m_batchValuesPos(FindBatchValuesGroup(m_queryString))
 {
     /// Initialize variable parameters
     m_paramCount = mysql_stmt_param_count(stmt);
@@ -86,6 +127,50 @@ void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 #endif
 }
 
+void MySQLPreparedStatement::BindParameters(PreparedStatementBase* const* stmts, uint32 stmtCount)
+{
+    m_stmt = stmts[0];
+
+    uint32 pos = 0;
+    for (uint32 i = 0; i < stmtCount; ++i)
+    {
+        for (PreparedStatementData const& data : stmts[i]->GetParameters())
+        {
+            std::visit([&](auto&& param)
+            {
+                SetParameter(pos, param);
+            }, data.data);
+
+            ++pos;
+        }
+    }
+
+#ifdef _DEBUG
+    if (pos < m_paramCount)
+        LOG_WARN("sql.sql", "[WARNING]: BindParameters() for batched statement {} did not bind all allocated parameters", m_stmt->GetIndex());
+#endif
+}
+
+std::string MySQLPreparedStatement::GetBatchQueryString(uint32 rowCount) const
+{
+    ASSERT(IsBatchable() && rowCount > 0);
+
+    std::size_t end = m_queryString.find(')', m_batchValuesPos);
+    std::string_view group(m_queryString.data() + m_batchValuesPos, end - m_batchValuesPos + 1);
+
+    std::string query(m_queryString, 0, m_batchValuesPos);
+    query.reserve(query.size() + (group.size() + 1) * rowCount);
+    for (uint32 i = 0; i < rowCount; ++i)
+    {
+        if (i)
+            query += ',';
+
+        query += group;
+    }
+
+    return query;
+}
+
 void MySQLPreparedStatement::ClearParameters()
 {
     for (uint32 i=0; i < m_paramCount; ++i)
@@ -98,7 +183,7 @@ void MySQLPreparedStatement::ClearParameters()
     }
 }
 
-static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 paramCount)
+static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint32 index, uint32 paramCount)
 {
     LOG_ERROR("sql.driver", "Attempted to bind parameter {}{} on a PreparedStatement {} (statement has only {} parameters)",
         uint32(index) + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
@@ -107,7 +192,7 @@ static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 para
 }
 
 //- Bind on mysql level
-void MySQLPreparedStatement::AssertValidIndex(uint8 index)
+void MySQLPreparedStatement::AssertValidIndex(uint32 index)
 {
     ASSERT(index < m_paramCount || ParamenterIndexAssertFail(m_stmt->GetIndex(), index, m_paramCount));
 
@@ -116,7 +201,7 @@ void MySQLPreparedStatement::AssertValidIndex(uint8 index)
 }
 
 template<typename T>
-void MySQLPreparedStatement::SetParameter(const uint8 index, T value)
+void MySQLPreparedStatement::SetParameter(const uint32 index, T value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -133,12 +218,12 @@ void MySQLPreparedStatement::SetParameter(const uint8 index, T value)
     memcpy(param->buffer, &value, len);
 }
 
-void MySQLPreparedStatement::SetParameter(const uint8 index, bool value)
+void MySQLPreparedStatement::SetParameter(const uint32 index, bool value)
 {
     SetParameter(index, uint8(value ? 1 : 0));
 }
 
-void MySQLPreparedStatement::SetParameter(const uint8 index, std::nullptr_t /*value*/)
+void MySQLPreparedStatement::SetParameter(const uint32 index, std::nullptr_t /*value*/)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -152,7 +237,7 @@ void MySQLPreparedStatement::SetParameter(const uint8 index, std::nullptr_t /*va
     param->length = nullptr;
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::string const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -169,7 +254,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
     memcpy(param->buffer, value.c_str(), len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::vector<uint8> const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -40,23 +40,29 @@ public:
     ~MySQLPreparedStatement();
 
     void BindParameters(PreparedStatementBase* stmt);
+    void BindParameters(PreparedStatementBase* const* stmts, uint32 stmtCount);
 
     uint32 GetParameterCount() const { return m_paramCount; }
 
+    //- Multi-row INSERT/REPLACE support: statements whose only placeholders are in
+    //- a trailing VALUES (...) group can be merged into a single statement
+    bool IsBatchable() const { return m_batchValuesPos != std::string::npos; }
+    std::string GetBatchQueryString(uint32 rowCount) const;
+
 protected:
-    void SetParameter(const uint8 index, bool value);
-    void SetParameter(const uint8 index, std::nullptr_t /*value*/);
-    void SetParameter(const uint8 index, std::string const& value);
-    void SetParameter(const uint8 index, std::vector<uint8> const& value);
+    void SetParameter(const uint32 index, bool value);
+    void SetParameter(const uint32 index, std::nullptr_t /*value*/);
+    void SetParameter(const uint32 index, std::string const& value);
+    void SetParameter(const uint32 index, std::vector<uint8> const& value);
 
     template<typename T>
-    void SetParameter(const uint8 index, T value);
+    void SetParameter(const uint32 index, T value);
 
     MySQLStmt* GetSTMT() { return m_Mstmt; }
     MySQLBind* GetBind() { return m_bind; }
     PreparedStatementBase* m_stmt;
     void ClearParameters();
-    void AssertValidIndex(const uint8 index);
+    void AssertValidIndex(const uint32 index);
     std::string getQueryString() const;
 
 private:
@@ -65,6 +71,7 @@ private:
     std::vector<bool> m_paramsSet;
     MySQLBind* m_bind;
     std::string m_queryString{};
+    std::size_t m_batchValuesPos;
 
     MySQLPreparedStatement(MySQLPreparedStatement const& right) = delete;
     MySQLPreparedStatement& operator=(MySQLPreparedStatement const& right) = delete;
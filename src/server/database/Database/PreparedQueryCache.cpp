@@ -0,0 +1,232 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreparedQueryCache.h"
+#include "PreparedStatement.h"
+#include "QueryResult.h"
+#include "SQLOperation.h"
+#include <algorithm>
+
+PreparedQueryCacheWriteGuard::PreparedQueryCacheWriteGuard(PreparedQueryCache* cache, std::vector<uint32> statements) :
+    _cache(cache), _statements(std::move(statements)) { }
+
+PreparedQueryCacheWriteGuard::~PreparedQueryCacheWriteGuard()
+{
+    Release();
+}
+
+PreparedQueryCacheWriteGuard::PreparedQueryCacheWriteGuard(PreparedQueryCacheWriteGuard&& right) noexcept :
+    _cache(right._cache), _statements(std::move(right._statements))
+{
+    right._cache = nullptr;
+}
+
+PreparedQueryCacheWriteGuard& PreparedQueryCacheWriteGuard::operator=(PreparedQueryCacheWriteGuard&& right) noexcept
+{
+    if (this != &right)
+    {
+        Release();
+        _cache = right._cache;
+        _statements = std::move(right._statements);
+        right._cache = nullptr;
+    }
+
+    return *this;
+}
+
+void PreparedQueryCacheWriteGuard::Release()
+{
+    if (_cache)
+        _cache->EndWrite(_statements);
+
+    _cache = nullptr;
+}
+
+void PreparedQueryCache::SetCacheable(uint32 readStatement, std::initializer_list<uint32> writeStatements)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    _statements[readStatement];
+    _allStatements.push_back(readStatement);
+
+    for (uint32 writeStatement : writeStatements)
+        _invalidatedBy[writeStatement].push_back(readStatement);
+}
+
+Optional<PreparedQueryResult> PreparedQueryCache::Find(PreparedStatementBase const* stmt, uint64& generation)
+{
+    std::string key = BuildKey(stmt);
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    StatementCache& cache = _statements.at(stmt->GetIndex());
+    generation = cache.Generation;
+
+    if (!cache.PendingWrites)
+    {
+        auto itr = cache.Entries.find(key);
+        if (itr != cache.Entries.end())
+        {
+            ++_stats.Hits;
+            return PreparedResultSet::CreateView(itr->second);
+        }
+    }
+
+    ++_stats.Misses;
+    return { };
+}
+
+PreparedQueryResult PreparedQueryCache::Store(PreparedStatementBase const* stmt, uint64 generation, PreparedQueryResult result)
+{
+    std::string key = BuildKey(stmt);
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    StatementCache& cache = _statements.at(stmt->GetIndex());
+    if (cache.PendingWrites || cache.Generation != generation)
+        return result;
+
+    // no eviction order is kept, a full statement cache simply starts over
+    if (cache.Entries.size() >= _maxEntriesPerStatement)
+        cache.Entries.clear();
+
+    cache.Entries[key] = result;
+    return PreparedResultSet::CreateView(result);
+}
+
+PreparedQueryCacheWriteGuard PreparedQueryCache::BeginWrite(uint32 writeStatement)
+{
+    auto itr = _invalidatedBy.find(writeStatement);
+    if (itr == _invalidatedBy.end())
+        return { };
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    for (uint32 statement : itr->second)
+    {
+        StatementCache& cache = _statements.at(statement);
+        ++cache.PendingWrites;
+        Invalidate(cache);
+    }
+
+    return { this, itr->second };
+}
+
+PreparedQueryCacheWriteGuard PreparedQueryCache::BeginRawWrite()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    for (auto& [statement, cache] : _statements)
+    {
+        ++cache.PendingWrites;
+        Invalidate(cache);
+    }
+
+    return { this, _allStatements };
+}
+
+PreparedQueryCacheWriteGuard PreparedQueryCache::BeginWrite(std::vector<SQLElementData> const& queries)
+{
+    std::vector<uint32> statements;
+    for (SQLElementData const& query : queries)
+    {
+        if (query.type == SQL_ELEMENT_RAW)
+            return BeginRawWrite();
+
+        auto itr = _invalidatedBy.find(std::get<PreparedStatementBase*>(query.element)->GetIndex());
+        if (itr != _invalidatedBy.end())
+            statements.insert(statements.end(), itr->second.begin(), itr->second.end());
+    }
+
+    if (statements.empty())
+        return { };
+
+    std::sort(statements.begin(), statements.end());
+    statements.erase(std::unique(statements.begin(), statements.end()), statements.end());
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    for (uint32 statement : statements)
+    {
+        StatementCache& cache = _statements.at(statement);
+        ++cache.PendingWrites;
+        Invalidate(cache);
+    }
+
+    return { this, std::move(statements) };
+}
+
+PreparedQueryCacheStats PreparedQueryCache::GetStats()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    PreparedQueryCacheStats stats = _stats;
+    for (auto const& [statement, cache] : _statements)
+        stats.Entries += cache.Entries.size();
+
+    _stats = PreparedQueryCacheStats();
+    return stats;
+}
+
+std::string PreparedQueryCache::BuildKey(PreparedStatementBase const* stmt)
+{
+    std::string key;
+    for (PreparedStatementData const& parameter : stmt->GetParameters())
+    {
+        key.push_back(char(parameter.data.index()));
+
+        std::visit([&key](auto const& value)
+        {
+            using ValueType = std::decay_t<decltype(value)>;
+
+            if constexpr (std::is_same_v<ValueType, std::string> || std::is_same_v<ValueType, std::vector<uint8>>)
+            {
+                uint32 size = uint32(value.size());
+                key.append(reinterpret_cast<char const*>(&size), sizeof(size));
+                key.append(reinterpret_cast<char const*>(value.data()), value.size());
+            }
+            else if constexpr (!std::is_same_v<ValueType, std::nullptr_t>)
+                key.append(reinterpret_cast<char const*>(&value), sizeof(value));
+        }, parameter.data);
+    }
+
+    return key;
+}
+
+void PreparedQueryCache::Invalidate(StatementCache& cache)
+{
+    ++cache.Generation;
+
+    if (!cache.Entries.empty())
+    {
+        ++_stats.Invalidations;
+        cache.Entries.clear();
+    }
+}
+
+void PreparedQueryCache::EndWrite(std::vector<uint32> const& statements)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    // reads started while the write was pending may have fetched the old rows
+    for (uint32 statement : statements)
+    {
+        StatementCache& cache = _statements.at(statement);
+        --cache.PendingWrites;
+        Invalidate(cache);
+    }
+}
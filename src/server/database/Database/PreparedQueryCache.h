@@ -0,0 +1,117 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PREPAREDQUERYCACHE_H
+#define _PREPAREDQUERYCACHE_H
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include "Optional.h"
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class PreparedQueryCache;
+struct SQLElementData;
+
+struct PreparedQueryCacheStats
+{
+    uint64 Hits = 0;
+    uint64 Misses = 0;
+    uint64 Invalidations = 0;
+    std::size_t Entries = 0;
+};
+
+/// Disables the cached reads a queued write invalidates until the write operation is destroyed
+class AC_DATABASE_API PreparedQueryCacheWriteGuard
+{
+public:
+    PreparedQueryCacheWriteGuard() = default;
+    PreparedQueryCacheWriteGuard(PreparedQueryCache* cache, std::vector<uint32> statements);
+    ~PreparedQueryCacheWriteGuard();
+
+    PreparedQueryCacheWriteGuard(PreparedQueryCacheWriteGuard&& right) noexcept;
+    PreparedQueryCacheWriteGuard& operator=(PreparedQueryCacheWriteGuard&& right) noexcept;
+
+private:
+    void Release();
+
+    PreparedQueryCache* _cache{nullptr};
+    std::vector<uint32> _statements;
+
+    PreparedQueryCacheWriteGuard(PreparedQueryCacheWriteGuard const& right) = delete;
+    PreparedQueryCacheWriteGuard& operator=(PreparedQueryCacheWriteGuard const& right) = delete;
+};
+
+/**
+* @brief Results of read-only prepared statements kept by a DatabaseWorkerPool, keyed on statement index and bound parameters.
+*
+* Only statements registered with SetCacheable are cached. Queueing one of the write statements registered for it
+* drops all cached results of the read statement and keeps it uncached until the write has been executed, raw SQL
+* writes do the same for every cached statement. Writes done outside the core (e.g. by hand in the database) are not
+* noticed, so only register statements whose tables are changed by the core alone.
+* Every lookup hands out its own copy of the row cursor, the row data itself is shared.
+*/
+class AC_DATABASE_API PreparedQueryCache
+{
+    friend class PreparedQueryCacheWriteGuard;
+
+public:
+    explicit PreparedQueryCache(uint32 maxEntriesPerStatement) : _maxEntriesPerStatement(maxEntriesPerStatement) { }
+
+    //! Caches the results of readStatement, dropped whenever one of writeStatements is executed
+    void SetCacheable(uint32 readStatement, std::initializer_list<uint32> writeStatements);
+    [[nodiscard]] bool IsCacheable(uint32 statement) const { return _statements.find(statement) != _statements.end(); }
+
+    //! Returns the cached result (null for an empty result) or nothing on a miss, generation must then be passed to Store
+    Optional<PreparedQueryResult> Find(PreparedStatementBase const* stmt, uint64& generation);
+
+    //! Caches the result of a missed lookup unless a write invalidated it meanwhile, returns the result to hand out
+    PreparedQueryResult Store(PreparedStatementBase const* stmt, uint64 generation, PreparedQueryResult result);
+
+    //! Guard for a write that is about to be executed, empty if it doesn't affect any cached statement
+    PreparedQueryCacheWriteGuard BeginWrite(uint32 writeStatement);
+    PreparedQueryCacheWriteGuard BeginRawWrite();
+    PreparedQueryCacheWriteGuard BeginWrite(std::vector<SQLElementData> const& queries);
+
+    //! Hits and misses since the previous call and the current number of cached results
+    PreparedQueryCacheStats GetStats();
+
+private:
+    struct StatementCache
+    {
+        std::unordered_map<std::string, PreparedQueryResult> Entries;
+        uint64 Generation = 0;
+        uint32 PendingWrites = 0;
+    };
+
+    static std::string BuildKey(PreparedStatementBase const* stmt);
+
+    void Invalidate(StatementCache& cache);
+    void EndWrite(std::vector<uint32> const& statements);
+
+    std::mutex _lock;
+    std::unordered_map<uint32, StatementCache> _statements;
+    std::unordered_map<uint32, std::vector<uint32>> _invalidatedBy;
+    std::vector<uint32> _allStatements;
+    uint32 _maxEntriesPerStatement;
+    PreparedQueryCacheStats _stats;
+};
+
+#endif
@@ -60,13 +60,16 @@ template void PreparedStatementBase::SetValidData(const uint8 index, uint64 cons
 template void PreparedStatementBase::SetValidData(const uint8 index, int64 const& value);
 template void PreparedStatementBase::SetValidData(const uint8 index, bool const& value);
 template void PreparedStatementBase::SetValidData(const uint8 index, float const& value);
+template void PreparedStatementBase::SetValidData(const uint8 index, double const& value);
 template void PreparedStatementBase::SetValidData(const uint8 index, std::string const& value);
 template void PreparedStatementBase::SetValidData(const uint8 index, std::vector<uint8> const& value);
 
 //- Execution
 PreparedStatementTask::PreparedStatementTask(PreparedStatementBase* stmt, bool async) :
     m_stmt(stmt),
-    m_result(nullptr)
+    m_result(nullptr),
+    m_cache(nullptr),
+    m_cacheGeneration(0)
 {
     m_has_result = async; // If it's async, then there's a result
 
@@ -89,12 +92,20 @@ bool PreparedStatementTask::Execute()
         PreparedResultSet* result = m_conn->Query(m_stmt);
         if (!result || !result->GetRowCount())
         {
+            // empty results are cached too, failed queries are not
+            if (result && m_cache)
+                m_cache->Store(m_stmt, m_cacheGeneration, nullptr);
+
             delete result;
             m_result->set_value(PreparedQueryResult(nullptr));
             return false;
         }
 
-        m_result->set_value(PreparedQueryResult(result));
+        PreparedQueryResult queryResult(result);
+        if (m_cache)
+            queryResult = m_cache->Store(m_stmt, m_cacheGeneration, std::move(queryResult));
+
+        m_result->set_value(std::move(queryResult));
         return true;
     }
 
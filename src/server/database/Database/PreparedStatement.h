@@ -169,6 +169,8 @@ private:
 //- Lower-level class, enqueuable operation
 class AC_DATABASE_API PreparedStatementTask : public SQLOperation
 {
+friend class DatabaseJournal;
+
 public:
     PreparedStatementTask(PreparedStatementBase* stmt, bool async = false);
     ~PreparedStatementTask() override;
@@ -176,10 +178,15 @@ public:
     bool Execute() override;
     PreparedQueryResultFuture GetFuture() { return m_result->get_future(); }
 
+    //! The result of the query is stored in cache, generation as returned by the missed PreparedQueryCache::Find
+    void SetQueryCache(PreparedQueryCache* cache, uint64 generation) { m_cache = cache; m_cacheGeneration = generation; }
+
 protected:
     PreparedStatementBase* m_stmt;
     bool m_has_result;
     PreparedQueryResultPromise* m_result;
+    PreparedQueryCache* m_cache;
+    uint64 m_cacheGeneration;
 };
 
 #endif
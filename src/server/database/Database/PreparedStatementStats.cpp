@@ -0,0 +1,91 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreparedStatementStats.h"
+#include <algorithm>
+#include <bit>
+
+PreparedStatementStats::PreparedStatementStats(std::size_t statementCount) :
+    _counters(std::make_unique<Counters[]>(statementCount)), _statementCount(statementCount) { }
+
+void PreparedStatementStats::Record(uint32 index, std::chrono::microseconds duration, uint64 rows, uint32 executions /*= 1*/)
+{
+    if (index >= _statementCount || !executions)
+        return;
+
+    uint64 const micros = uint64(std::max<int64>(duration.count(), 0));
+    std::size_t const bucket = std::min<std::size_t>(std::bit_width(micros / executions), HISTOGRAM_BUCKETS - 1);
+
+    Counters& counters = _counters[index];
+    counters.Count.fetch_add(executions, std::memory_order_relaxed);
+    counters.TotalMicros.fetch_add(micros, std::memory_order_relaxed);
+    counters.Rows.fetch_add(rows, std::memory_order_relaxed);
+    counters.Histogram[bucket].fetch_add(executions, std::memory_order_relaxed);
+
+    _totalCount.fetch_add(executions, std::memory_order_relaxed);
+    _totalMicros.fetch_add(micros, std::memory_order_relaxed);
+}
+
+std::vector<PreparedStatementStatsEntry> PreparedStatementStats::Collect()
+{
+    std::vector<PreparedStatementStatsEntry> result;
+
+    for (std::size_t index = 0; index < _statementCount; ++index)
+    {
+        Counters& counters = _counters[index];
+        if (!counters.Count.load(std::memory_order_relaxed))
+            continue;
+
+        PreparedStatementStatsEntry entry;
+        entry.Index = uint32(index);
+        entry.Count = counters.Count.exchange(0, std::memory_order_relaxed);
+        entry.Rows = counters.Rows.exchange(0, std::memory_order_relaxed);
+        entry.AvgMicros = entry.Count ? uint32(counters.TotalMicros.exchange(0, std::memory_order_relaxed) / entry.Count) : 0;
+
+        std::array<uint32, HISTOGRAM_BUCKETS> histogram;
+        uint64 executions = 0;
+        for (std::size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket)
+        {
+            histogram[bucket] = counters.Histogram[bucket].exchange(0, std::memory_order_relaxed);
+            executions += histogram[bucket];
+        }
+
+        // Smallest bucket reaching 99% of the executions, counted from the fastest one
+        uint64 const threshold = executions - executions / 100;
+        uint64 seen = 0;
+        for (std::size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket)
+        {
+            seen += histogram[bucket];
+            if (seen && seen >= threshold)
+            {
+                entry.P99Micros = uint32(1) << bucket;
+                break;
+            }
+        }
+
+        result.push_back(entry);
+    }
+
+    return result;
+}
+
+std::chrono::microseconds PreparedStatementStats::TakeMeanDuration()
+{
+    uint64 const count = _totalCount.exchange(0, std::memory_order_relaxed);
+    uint64 const micros = _totalMicros.exchange(0, std::memory_order_relaxed);
+    return std::chrono::microseconds(count ? micros / count : 0);
+}
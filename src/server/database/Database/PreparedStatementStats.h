@@ -0,0 +1,73 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PREPAREDSTATEMENTSTATS_H
+#define _PREPAREDSTATEMENTSTATS_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+struct PreparedStatementStatsEntry
+{
+    uint32 Index = 0;
+    uint64 Count = 0;
+    uint64 Rows = 0;
+    uint32 AvgMicros = 0;
+    uint32 P99Micros = 0;
+};
+
+/**
+* @brief Execution counters of the prepared statements of a DatabaseWorkerPool, updated lock free by every connection.
+*
+* Durations are kept in a power of two histogram, so the reported 99th percentile is the upper bound of its bucket.
+* Rows are the affected rows of writes and the returned rows of reads.
+*/
+class AC_DATABASE_API PreparedStatementStats
+{
+public:
+    explicit PreparedStatementStats(std::size_t statementCount);
+
+    void Record(uint32 index, std::chrono::microseconds duration, uint64 rows, uint32 executions = 1);
+
+    //! Returns the statements executed since the previous call
+    std::vector<PreparedStatementStatsEntry> Collect();
+
+    //! Mean duration of all statements executed since the previous call, independent of Collect
+    std::chrono::microseconds TakeMeanDuration();
+
+private:
+    static constexpr std::size_t HISTOGRAM_BUCKETS = 25; // bucket n holds durations below 2^n microseconds, the last one everything above
+
+    struct Counters
+    {
+        std::atomic<uint64> Count{0};
+        std::atomic<uint64> TotalMicros{0};
+        std::atomic<uint64> Rows{0};
+        std::array<std::atomic<uint32>, HISTOGRAM_BUCKETS> Histogram{};
+    };
+
+    std::unique_ptr<Counters[]> _counters;
+    std::size_t _statementCount;
+    std::atomic<uint64> _totalCount{0};
+    std::atomic<uint64> _totalMicros{0};
+};
+
+#endif
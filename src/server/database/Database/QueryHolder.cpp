@@ -21,6 +21,7 @@
 #include "MySQLConnection.h"
 #include "PreparedStatement.h"
 #include "QueryResult.h"
+#include <algorithm>
 
 bool SQLQueryHolderBase::SetPreparedQueryImpl(size_t index, PreparedStatementBase* stmt)
 {
@@ -72,16 +73,51 @@ void SQLQueryHolderBase::SetSize(size_t size)
     m_queries.resize(size);
 }
 
+SQLQueryHolderTask::SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
+    : SQLQueryHolderTask(holder, std::make_shared<SQLQueryHolderCompletion>(1), 0, holder->GetSize()) { }
+
 SQLQueryHolderTask::~SQLQueryHolderTask() = default;
 
+std::vector<SQLQueryHolderTask*> SQLQueryHolderTask::CreateTasks(std::shared_ptr<SQLQueryHolderBase> const& holder, uint8 maxTasks)
+{
+    std::vector<std::pair<PreparedStatementBase*, PreparedQueryResult>> const& queries = holder->m_queries;
+
+    size_t statements = std::count_if(queries.begin(), queries.end(), [](auto const& query) { return query.first != nullptr; });
+    size_t taskCount = std::clamp<size_t>(statements / MIN_STATEMENTS_PER_TASK, 1, std::max<uint8>(maxTasks, 1));
+
+    std::vector<SQLQueryHolderTask*> tasks;
+    tasks.reserve(taskCount);
+
+    std::shared_ptr<SQLQueryHolderCompletion> completion = std::make_shared<SQLQueryHolderCompletion>(uint32(taskCount));
+    size_t begin = 0;
+    size_t assigned = 0;
+    for (size_t task = 1; task < taskCount; ++task)
+    {
+        // spread the statements evenly, unset indexes don't count
+        size_t const target = statements * task / taskCount;
+        size_t end = begin;
+        for (; assigned < target; ++end)
+            if (queries[end].first)
+                ++assigned;
+
+        tasks.push_back(new SQLQueryHolderTask(holder, completion, begin, end));
+        begin = end;
+    }
+
+    tasks.push_back(new SQLQueryHolderTask(holder, completion, begin, queries.size()));
+    return tasks;
+}
+
 bool SQLQueryHolderTask::Execute()
 {
-    /// execute all queries in the holder and pass the results
-    for (size_t i = 0; i < m_holder->m_queries.size(); ++i)
+    /// execute the queries of this task and pass the results, other tasks of the holder only touch other indexes
+    for (size_t i = m_begin; i < m_end; ++i)
         if (PreparedStatementBase* stmt = m_holder->m_queries[i].first)
             m_holder->SetPreparedResult(i, m_conn->Query(stmt));
 
-    m_result.set_value();
+    if (m_completion->PendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_completion->Result.set_value();
+
     return true;
 }
 
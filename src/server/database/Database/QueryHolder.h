@@ -18,7 +18,9 @@
 #ifndef _QUERYHOLDER_H
 #define _QUERYHOLDER_H
 
+#include "Define.h"
 #include "SQLOperation.h"
+#include <atomic>
 #include <vector>
 
 class AC_DATABASE_API SQLQueryHolderBase
@@ -31,12 +33,18 @@ public:
     void SetSize(size_t size);
     PreparedQueryResult GetPreparedResult(size_t index) const;
     void SetPreparedResult(size_t index, PreparedResultSet* result);
+    [[nodiscard]] size_t GetSize() const { return m_queries.size(); }
+
+    //! The holder won't overtake pending transactions queued with the same key (see TransactionBase::SetOrderingKey)
+    void SetOrderingKey(uint32 key) { _orderingKey = key; }
+    [[nodiscard]] uint32 GetOrderingKey() const { return _orderingKey; }
 
 protected:
     bool SetPreparedQueryImpl(size_t index, PreparedStatementBase* stmt);
 
 private:
     std::vector<std::pair<PreparedStatementBase*, PreparedQueryResult>> m_queries;
+    uint32 _orderingKey{0};
 };
 
 template<typename T>
@@ -49,20 +57,41 @@ public:
     }
 };
 
+//! Shared by the tasks a holder was split into, the last one to finish sets the result
+struct SQLQueryHolderCompletion
+{
+    explicit SQLQueryHolderCompletion(uint32 tasks) : PendingTasks(tasks) { }
+
+    std::atomic<uint32> PendingTasks;
+    QueryResultHolderPromise Result;
+};
+
 class AC_DATABASE_API SQLQueryHolderTask : public SQLOperation
 {
 public:
-    explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder)
-        : m_holder(std::move(holder)) { }
+    //! Every task executes at least this many statements, smaller holders aren't worth a second connection
+    static constexpr size_t MIN_STATEMENTS_PER_TASK = 4;
+
+    explicit SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder);
+
+    //! Executes the statements [begin, end) of the holder
+    SQLQueryHolderTask(std::shared_ptr<SQLQueryHolderBase> holder, std::shared_ptr<SQLQueryHolderCompletion> completion, size_t begin, size_t end)
+        : m_holder(std::move(holder)), m_completion(std::move(completion)), m_begin(begin), m_end(end) { }
 
     ~SQLQueryHolderTask();
 
+    //! Splits the statements of the holder in up to maxTasks tasks that can run on different connections,
+    //! the future of any of them is set once all of them executed
+    static std::vector<SQLQueryHolderTask*> CreateTasks(std::shared_ptr<SQLQueryHolderBase> const& holder, uint8 maxTasks);
+
     bool Execute() override;
-    QueryResultHolderFuture GetFuture() { return m_result.get_future(); }
+    QueryResultHolderFuture GetFuture() { return m_completion->Result.get_future(); }
 
 private:
     std::shared_ptr<SQLQueryHolderBase> m_holder;
-    QueryResultHolderPromise m_result;
+    std::shared_ptr<SQLQueryHolderCompletion> m_completion;
+    size_t m_begin;
+    size_t m_end;
 };
 
 class AC_DATABASE_API SQLQueryHolderCallback
@@ -19,6 +19,7 @@
 #include "Errors.h"
 #include "Field.h"
 #include "Log.h"
+#include "MySQLConnection.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
 
@@ -245,6 +246,80 @@ void ResultSet::AssertRows(std::size_t sizeRows)
     ASSERT(sizeRows == _fieldCount);
 }
 
+StreamedResultSet::StreamedResultSet(MySQLConnection* connection, MySQLResult* result, MySQLField* fields, uint32 fieldCount) :
+    _connection(connection),
+    _result(result),
+    _fetchedRows(0),
+    _fieldCount(fieldCount)
+{
+    _fieldMetadata.resize(_fieldCount);
+    _currentRow = new Field[_fieldCount];
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+    {
+        InitializeDatabaseFieldMetadata(&_fieldMetadata[i], &fields[i], i);
+        _currentRow[i].SetMetadata(&_fieldMetadata[i]);
+    }
+}
+
+StreamedResultSet::~StreamedResultSet()
+{
+    CleanUp();
+    delete[] _currentRow;
+}
+
+bool StreamedResultSet::NextRow()
+{
+    if (!_result)
+        return false;
+
+    MYSQL_ROW row = mysql_fetch_row(_result);
+    if (!row)
+    {
+        if (uint32 lErrno = mysql_errno(_result->handle))
+            LOG_ERROR("sql.sql", "{}: streaming stopped after {} rows. Error [{}] {}", __FUNCTION__, _fetchedRows, lErrno, mysql_error(_result->handle));
+
+        CleanUp();
+        return false;
+    }
+
+    unsigned long* lengths = mysql_fetch_lengths(_result);
+    if (!lengths)
+    {
+        LOG_WARN("sql.sql", "{}:mysql_fetch_lengths, cannot retrieve value lengths. Error {}.", __FUNCTION__, mysql_error(_result->handle));
+        CleanUp();
+        return false;
+    }
+
+    for (uint32 i = 0; i < _fieldCount; i++)
+        _currentRow[i].SetStructuredValue(row[i], lengths[i]);
+
+    ++_fetchedRows;
+    return true;
+}
+
+void StreamedResultSet::CleanUp()
+{
+    // mysql_free_result also discards the rows that weren't read yet, the connection is usable again afterwards
+    if (_result)
+    {
+        mysql_free_result(_result);
+        _result = nullptr;
+    }
+
+    if (_connection)
+    {
+        _connection->Unlock();
+        _connection = nullptr;
+    }
+}
+
+Field const& StreamedResultSet::operator[](std::size_t index) const
+{
+    ASSERT(index < _fieldCount);
+    return _currentRow[index];
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
     m_rowCount(rowCount),
     m_rowPosition(0),
@@ -377,6 +452,24 @@ PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint6
     mysql_stmt_free_result(m_stmt);
 }
 
+PreparedResultSet::PreparedResultSet(PreparedQueryResult source) :
+    m_rows(source->m_rows),
+    m_rowCount(source->m_rowCount),
+    m_rowPosition(0),
+    m_fieldCount(source->m_fieldCount),
+    m_rBind(nullptr),
+    m_stmt(nullptr),
+    m_metadataResult(nullptr),
+    m_source(std::move(source)) { }
+
+PreparedQueryResult PreparedResultSet::CreateView(PreparedQueryResult const& source)
+{
+    if (!source)
+        return nullptr;
+
+    return PreparedQueryResult(new PreparedResultSet(source));
+}
+
 PreparedResultSet::~PreparedResultSet()
 {
     CleanUp();
@@ -24,6 +24,8 @@
 #include <tuple>
 #include <vector>
 
+class MySQLConnection;
+
 template<typename T>
 struct ResultIterator
 {
@@ -95,6 +97,40 @@ private:
     ResultSet& operator=(ResultSet const& right) = delete;
 };
 
+/// Result of a query in string format whose rows are read from the server one at a time
+/// (mysql_use_result) instead of being buffered client side, for large loads.
+/// The synchronous connection stays locked until the object is destroyed, so no other
+/// synchronous query may be issued on the same pool while iterating over it.
+class AC_DATABASE_API StreamedResultSet
+{
+public:
+    StreamedResultSet(MySQLConnection* connection, MySQLResult* result, MySQLField* fields, uint32 fieldCount);
+    ~StreamedResultSet();
+
+    bool NextRow();
+    [[nodiscard]] uint64 GetFetchedRowCount() const { return _fetchedRows; }
+    [[nodiscard]] uint32 GetFieldCount() const { return _fieldCount; }
+
+    [[nodiscard]] Field* Fetch() const { return _currentRow; }
+    Field const& operator[](std::size_t index) const;
+
+    template<typename T>
+    [[nodiscard]] inline T Get(std::size_t index) const { return (*this)[index].Get<T>(); }
+
+private:
+    void CleanUp();
+
+    std::vector<QueryResultFieldMetadata> _fieldMetadata;
+    MySQLConnection* _connection;
+    MySQLResult* _result;
+    Field* _currentRow;
+    uint64 _fetchedRows;
+    uint32 _fieldCount;
+
+    StreamedResultSet(StreamedResultSet const& right) = delete;
+    StreamedResultSet& operator=(StreamedResultSet const& right) = delete;
+};
+
 class AC_DATABASE_API PreparedResultSet
 {
 public:
@@ -127,6 +163,9 @@ public:
     auto begin()        { return ResultIterator<PreparedResultSet>(this); }
     static auto end()   { return ResultIterator<PreparedResultSet>(nullptr); }
 
+    //! New result with its own row cursor over the rows of source, which stays alive as long as the view
+    static PreparedQueryResult CreateView(PreparedQueryResult const& source);
+
 protected:
     std::vector<QueryResultFieldMetadata> m_fieldMetadata;
     std::vector<Field> m_rows;
@@ -138,6 +177,9 @@ private:
     MySQLBind* m_rBind;
     MySQLStmt* m_stmt;
     MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
+    PreparedQueryResult m_source;     ///< Owner of the row data, set for views only
+
+    explicit PreparedResultSet(PreparedQueryResult source);
 
     void CleanUp();
     bool _NextRow();
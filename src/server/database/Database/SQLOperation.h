@@ -20,6 +20,7 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
+#include "PreparedQueryCache.h"
 #include <variant>
 
 //- Type specifier of our element data
@@ -55,6 +56,9 @@ public:
 
     MySQLConnection* m_conn{nullptr};
 
+    //! Set for writes that invalidate cached reads, released when the operation is deleted after execution
+    PreparedQueryCacheWriteGuard m_cacheGuard;
+
 private:
     SQLOperation(SQLOperation const& right) = delete;
     SQLOperation& operator=(SQLOperation const& right) = delete;
@@ -32,6 +32,7 @@ class AC_DATABASE_API TransactionBase
 {
     friend class TransactionTask;
     friend class MySQLConnection;
+    friend class DatabaseJournal;
 
     template <typename T>
     friend class DatabaseWorkerPool;
@@ -50,6 +51,10 @@ public:
 
     [[nodiscard]] std::size_t GetSize() const { return m_queries.size(); }
 
+    //! Async reads queued with the same key (see SQLQueryHolderBase::SetOrderingKey) won't overtake this transaction
+    void SetOrderingKey(uint32 key) { _orderingKey = key; }
+    [[nodiscard]] uint32 GetOrderingKey() const { return _orderingKey; }
+
 protected:
     void AppendPreparedStatement(PreparedStatementBase* statement);
     void Cleanup();
@@ -57,6 +62,7 @@ protected:
 
 private:
     bool _cleanedUp{false};
+    uint32 _orderingKey{0};
 };
 
 template<typename T>
@@ -79,6 +85,7 @@ class AC_DATABASE_API TransactionTask : public SQLOperation
 
     friend class DatabaseWorker;
     friend class TransactionCallback;
+    friend class DatabaseJournal;
 
 public:
     TransactionTask(std::shared_ptr<TransactionBase> trans) : m_trans(std::move(trans)) { }
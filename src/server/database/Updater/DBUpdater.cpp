@@ -23,10 +23,12 @@
 #include "GitRevision.h"
 #include "Log.h"
 #include "StartProcess.h"
+#include "Timer.h"
 #include "UpdateFetcher.h"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 
 std::string DBUpdaterUtil::GetCorrectedMySQLExecutable()
 {
@@ -38,6 +40,10 @@ std::string DBUpdaterUtil::GetCorrectedMySQLExecutable()
 
 bool DBUpdaterUtil::CheckExecutable()
 {
+    // The databases may be updated in parallel
+    static std::mutex lock;
+    std::lock_guard<std::mutex> guard(lock);
+
     std::filesystem::path exe(GetCorrectedMySQLExecutable());
     if (!is_regular_file(exe))
     {
@@ -57,6 +63,15 @@ bool DBUpdaterUtil::CheckExecutable()
     return true;
 }
 
+std::string DBUpdaterUtil::GetTempDirectory()
+{
+    std::string const configTempDir = sConfigMgr->GetOption<std::string>("TempDir", "");
+
+    std::string const tempDir = configTempDir.empty() ? std::filesystem::temp_directory_path().string() : configTempDir;
+
+    return Acore::String::AddSuffixIfNotExists(tempDir, std::filesystem::path::preferred_separator);
+}
+
 std::string& DBUpdaterUtil::corrected_path()
 {
     static std::string path;
@@ -224,6 +239,8 @@ bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::string_view modulesL
 
     LOG_INFO("sql.updates", "Updating {} database...", DBUpdater<T>::GetTableName());
 
+    uint32 const oldMSTime = getMSTime();
+
     Path const sourceDirectory(BuiltInConfig::GetSourceDirectory());
 
     if (!is_directory(sourceDirectory))
@@ -272,7 +289,8 @@ bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::string_view modulesL
                      sConfigMgr->GetOption<bool>("Updates.Redundancy", true),
                      sConfigMgr->GetOption<bool>("Updates.AllowRehash", true),
                      sConfigMgr->GetOption<bool>("Updates.ArchivedRedundancy", false),
-                     sConfigMgr->GetOption<int32>("Updates.CleanDeadRefMaxCount", 3));
+                     sConfigMgr->GetOption<int32>("Updates.CleanDeadRefMaxCount", 3),
+                     sConfigMgr->GetOption<uint32>("Updates.BatchSize", 1));
     }
     catch (UpdateException&)
     {
@@ -282,9 +300,10 @@ bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::string_view modulesL
     std::string const info = Acore::StringFormatFmt("Containing {} new and {} archived updates.", result.recent, result.archived);
 
     if (!result.updated)
-        LOG_INFO("sql.updates", ">> {} database is up-to-date! {}", DBUpdater<T>::GetTableName(), info);
+        LOG_INFO("sql.updates", ">> {} database is up-to-date! {} Checked in {} ms", DBUpdater<T>::GetTableName(), info, GetMSTimeDiffToNow(oldMSTime));
     else
-        LOG_INFO("sql.updates", ">> Applied {} {}. {}", result.updated, result.updated == 1 ? "query" : "queries", info);
+        LOG_INFO("sql.updates", ">> Applied {} {} to the {} database in {} ms. {}", result.updated, result.updated == 1 ? "query" : "queries",
+            DBUpdater<T>::GetTableName(), GetMSTimeDiffToNow(oldMSTime), info);
 
     LOG_INFO("sql.updates", " ");
 
@@ -342,7 +361,8 @@ bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::vector<std::string>
                      sConfigMgr->GetOption<bool>("Updates.Redundancy", true),
                      sConfigMgr->GetOption<bool>("Updates.AllowRehash", true),
                      sConfigMgr->GetOption<bool>("Updates.ArchivedRedundancy", false),
-                     sConfigMgr->GetOption<int32>("Updates.CleanDeadRefMaxCount", 3));
+                     sConfigMgr->GetOption<int32>("Updates.CleanDeadRefMaxCount", 3),
+                     sConfigMgr->GetOption<uint32>("Updates.BatchSize", 1));
     }
     catch (UpdateException&)
     {
@@ -366,6 +386,8 @@ bool DBUpdater<T>::Populate(DatabaseWorkerPool<T>& pool)
 
     LOG_INFO("sql.updates", "Database {} is empty, auto populating it...", DBUpdater<T>::GetTableName());
 
+    uint32 const oldMSTime = getMSTime();
+
     std::string const DirPathStr = DBUpdater<T>::GetBaseFilesDirectory();
 
     Path const DirPath(DirPathStr);
@@ -413,7 +435,7 @@ bool DBUpdater<T>::Populate(DatabaseWorkerPool<T>& pool)
         }
     }
 
-    LOG_INFO("sql.updates", ">> Done!");
+    LOG_INFO("sql.updates", ">> Populated the {} database in {} ms", DBUpdater<T>::GetTableName(), GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("sql.updates", " ");
     return true;
 }
@@ -441,13 +463,10 @@ template<class T>
 void DBUpdater<T>::ApplyFile(DatabaseWorkerPool<T>& pool, std::string const& host, std::string const& user,
                              std::string const& password, std::string const& port_or_socket, std::string const& database, std::string const& ssl, Path const& path)
 {
-    std::string configTempDir = sConfigMgr->GetOption<std::string>("TempDir", "");
-
-    auto tempDir = configTempDir.empty() ? std::filesystem::temp_directory_path().string() : configTempDir;
-
-    tempDir = Acore::String::AddSuffixIfNotExists(tempDir, std::filesystem::path::preferred_separator);
+    std::string const tempDir = DBUpdaterUtil::GetTempDirectory();
 
-    std::string confFileName = "mysql_ac.conf";
+    // One file per database, the databases may be updated in parallel
+    std::string const confFileName = database.empty() ? "mysql_ac.conf" : "mysql_ac_" + database + ".conf";
 
     std::ofstream outfile (tempDir + confFileName);
 
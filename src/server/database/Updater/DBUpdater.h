@@ -59,6 +59,9 @@ public:
 
     static bool CheckExecutable();
 
+    // TempDir from the config, or the system temp directory, with a trailing separator
+    static std::string GetTempDirectory();
+
 private:
     static std::string& corrected_path();
 };
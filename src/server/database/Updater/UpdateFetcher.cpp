@@ -230,7 +230,8 @@ std::string UpdateFetcher::ReadSQLUpdate(Path const& file) const
 UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
                                    bool const allowRehash,
                                    bool const archivedRedundancy,
-                                   int32 const cleanDeadReferencesMaxCount) const
+                                   int32 const cleanDeadReferencesMaxCount,
+                                   uint32 const batchSize /*= 1*/) const
 {
     LocaleFileStorage const available = GetFileList();
     if (_setDirectories && available.empty())
@@ -257,6 +258,9 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
 
     size_t importedUpdates = 0;
 
+    // New updates wait here until the batch is full, everything else about them is already decided
+    PendingUpdateStorage batch;
+
     auto ApplyUpdateFile = [&](LocaleFileEntry const& sqlFile)
     {
         auto filePath = sqlFile.first;
@@ -284,7 +288,8 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
             }
         }
 
-        std::string const hash = ByteArrayToHexStr(Acore::Crypto::SHA1::GetDigestOf(ReadSQLUpdate(filePath)));
+        std::string content = ReadSQLUpdate(filePath);
+        std::string const hash = ByteArrayToHexStr(Acore::Crypto::SHA1::GetDigestOf(content));
 
         UpdateMode mode = MODE_APPLY;
 
@@ -367,6 +372,16 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
         switch (mode)
         {
             case MODE_APPLY:
+                if (batchSize > 1 && CanBatch(content))
+                {
+                    batch.push_back({ filePath, file, std::move(content) });
+                    if (batch.size() >= batchSize)
+                        ApplyBatch(batch);
+                    break;
+                }
+
+                // keep the file order, everything queued before this update goes first
+                ApplyBatch(batch);
                 speed = Apply(filePath);
                 [[fallthrough]];
             case MODE_REHASH:
@@ -388,6 +403,8 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
             ApplyUpdateFile(availableQuery);
     }
 
+    ApplyBatch(batch);
+
     // Apply only custom/module updates
     for (auto const& availableQuery : available)
     {
@@ -395,6 +412,8 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
             ApplyUpdateFile(availableQuery);
     }
 
+    ApplyBatch(batch);
+
     // Cleanup up orphaned entries (if enabled)
     if (!applied.empty() && !_setDirectories)
     {
@@ -449,13 +468,82 @@ uint32 UpdateFetcher::Apply(Path const& path) const
     return uint32(std::chrono::duration_cast<std::chrono::milliseconds>(Time::now() - begin).count());
 }
 
-void UpdateFetcher::UpdateEntry(AppliedFileEntry const& entry, uint32 const speed) const
+bool UpdateFetcher::CanBatch(std::string const& update)
 {
-    std::string const update = "REPLACE INTO `updates` (`name`, `hash`, `state`, `speed`) VALUES (\"" +
-                               entry.name + "\", \"" + entry.hash + "\", \'" + entry.GetStateAsString() + "\', " + std::to_string(speed) + ")";
+    // A changed delimiter would leak into the next file of the batch
+    if (StringContainsStringI(update, "DELIMITER"))
+        return false;
+
+    // The next file must start with a new statement
+    size_t const last = update.find_last_not_of(" \t\r\n");
+    return last != std::string::npos && update[last] == ';';
+}
 
+void UpdateFetcher::ApplyBatch(PendingUpdateStorage& batch) const
+{
+    if (batch.empty())
+        return;
+
+    if (batch.size() == 1)
+    {
+        UpdateEntry(batch.front().entry, Apply(batch.front().path));
+        batch.clear();
+        return;
+    }
+
+    // Every file is followed by its own `updates` row, so a batch that fails halfway
+    // only records the files that made it into the database
+    Path const batchFile = Path(DBUpdaterUtil::GetTempDirectory()) / ("ac_updates_" + _dbModuleName + ".sql");
+    {
+        std::ofstream out(batchFile.generic_string(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            LOG_FATAL("sql.updates", "Failed to create the sql update batch \"{}\"!", batchFile.generic_string());
+            throw UpdateException("Creating the sql update batch failed!");
+        }
+
+        for (PendingUpdate const& update : batch)
+            out << update.content << "\n" << GetUpdateEntryQuery(update.entry, 0) << ";\n";
+    }
+
+    LOG_DEBUG("sql.updates", ">> Applying a batch of {} updates...", batch.size());
+
+    uint32 speed = 0;
+    try
+    {
+        speed = Apply(batchFile);
+    }
+    catch (UpdateException&)
+    {
+        LOG_FATAL("sql.updates", "The batch contained the updates \"{}\" to \"{}\".",
+            batch.front().entry.name, batch.back().entry.name);
+        std::filesystem::remove(batchFile);
+        throw;
+    }
+
+    std::filesystem::remove(batchFile);
+
+    // The client can't time single files of a batch, spread the batch time over them
+    std::stringstream update;
+    update << "UPDATE `updates` SET `speed`=" << (speed / batch.size()) << " WHERE `name` IN(";
+    for (size_t i = 0; i < batch.size(); ++i)
+        update << (i ? ", " : "") << "\"" << batch[i].entry.name << "\"";
+    update << ")";
+
+    _apply(update.str());
+    batch.clear();
+}
+
+std::string UpdateFetcher::GetUpdateEntryQuery(AppliedFileEntry const& entry, uint32 const speed)
+{
+    return "REPLACE INTO `updates` (`name`, `hash`, `state`, `speed`) VALUES (\"" +
+           entry.name + "\", \"" + entry.hash + "\", \'" + entry.GetStateAsString() + "\', " + std::to_string(speed) + ")";
+}
+
+void UpdateFetcher::UpdateEntry(AppliedFileEntry const& entry, uint32 const speed) const
+{
     // Update database
-    _apply(update);
+    _apply(GetUpdateEntryQuery(entry, speed));
 }
 
 void UpdateFetcher::RenameEntry(std::string const& from, std::string const& to) const
@@ -58,8 +58,10 @@ public:
 
     ~UpdateFetcher();
 
+    // batchSize > 1 applies that many new update files in a single mysql client invocation
     UpdateResult Update(bool const redundancyChecks, bool const allowRehash,
-                        bool const archivedRedundancy, int32 const cleanDeadReferencesMaxCount) const;
+                        bool const archivedRedundancy, int32 const cleanDeadReferencesMaxCount,
+                        uint32 const batchSize = 1) const;
 
 private:
     enum UpdateMode
@@ -123,6 +125,15 @@ private:
 
     struct DirectoryEntry;
 
+    struct PendingUpdate
+    {
+        Path path;
+        AppliedFileEntry entry;
+        std::string content;
+    };
+
+    typedef std::vector<PendingUpdate> PendingUpdateStorage;
+
     typedef std::pair<Path, State> LocaleFileEntry;
 
     struct PathCompare
@@ -145,7 +156,10 @@ private:
     std::string ReadSQLUpdate(Path const& file) const;
 
     uint32 Apply(Path const& path) const;
+    static bool CanBatch(std::string const& update);
+    void ApplyBatch(PendingUpdateStorage& batch) const;
 
+    static std::string GetUpdateEntryQuery(AppliedFileEntry const& entry, uint32 const speed);
     void UpdateEntry(AppliedFileEntry const& entry, uint32 const speed = 0) const;
     void RenameEntry(std::string const& from, std::string const& to) const;
     void CleanUp(AppliedFileStorage const& storage) const;
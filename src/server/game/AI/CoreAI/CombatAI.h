@@ -31,6 +31,9 @@ public:
     explicit AggressorAI(Creature* c) : CreatureAI(c) {}
 
     void UpdateAI(uint32) override;
+    bool CanThrottleIdleUpdates() const override { return IsExactAI<AggressorAI>(); }
+    bool IsUpdateQuiescent() const override { return IsExactAI<AggressorAI>() && !me->IsEngaged(); }
+
     static int32 Permissible(Creature const* creature);
 };
 
@@ -32,5 +32,6 @@ public:
     void Reset() override;
     void EnterEvadeMode(EvadeReason /*why*/) override;
     void JustDied(Unit* killer) override;
+    bool CanThrottleIdleUpdates() const override { return IsExactAI<GuardAI>(); }
 };
 #endif
@@ -29,6 +29,8 @@ public:
     void MoveInLineOfSight(Unit*) override {}
     void AttackStart(Unit*) override {}
     void UpdateAI(uint32) override;
+    bool CanThrottleIdleUpdates() const override { return IsExactAI<PassiveAI>(); }
+    bool IsUpdateQuiescent() const override { return IsExactAI<PassiveAI>() && !me->IsInCombat(); }
 
     static int32 Permissible(Creature const* /*creature*/) { return PERMIT_BASE_NO; }
 };
@@ -59,6 +61,8 @@ public:
     void UpdateAI(uint32) override {}
     void EnterEvadeMode(EvadeReason /*why*/) override {}
     void OnCharmed(bool /*apply*/) override {}
+    bool CanThrottleIdleUpdates() const override { return IsExactAI<NullCreatureAI>(); }
+    bool IsUpdateQuiescent() const override { return IsExactAI<NullCreatureAI>(); }
 
     static int32 Permissible(Creature const* creature);
 };
@@ -72,6 +76,7 @@ public:
     void EnterEvadeMode(EvadeReason why) override;
     void MovementInform(uint32 type, uint32 id) override;
     void UpdateAI(uint32 /*diff*/) override { }
+    bool IsUpdateQuiescent() const override { return IsExactAI<CritterAI>(); }
 
     static int32 Permissible(Creature const* creature);
 };
@@ -29,6 +29,8 @@ public:
 
     void MoveInLineOfSight(Unit*) override {}
     void UpdateAI(uint32 diff) override;
+    bool CanThrottleIdleUpdates() const override { return IsExactAI<ReactorAI>(); }
+    bool IsUpdateQuiescent() const override { return IsExactAI<ReactorAI>() && !me->IsEngaged(); }
 
     static int32 Permissible(Creature const* creature);
 };
@@ -24,6 +24,7 @@
 #include "EventMap.h"
 #include "TaskScheduler.h"
 #include "UnitAI.h"
+#include <typeinfo>
 
 class WorldObject;
 class Unit;
@@ -208,6 +209,12 @@ public:
 
     virtual void PetStopAttack() { }
 
+    // true if UpdateAI does nothing while out of combat, idle creatures may then be updated at a lower rate
+    virtual bool CanThrottleIdleUpdates() const { return false; }
+
+    // true while UpdateAI would do nothing, the creature update then skips calling it
+    virtual bool IsUpdateQuiescent() const { return false; }
+
     // boundary system methods
     virtual bool CheckInRoom();
     CreatureBoundary const* GetBoundary() const { return _boundary; }
@@ -223,6 +230,10 @@ public:
 protected:
     virtual void MoveInLineOfSight(Unit* /*who*/);
 
+    // the update hints above only hold for the core AI itself, not for scripts deriving from it with their own UpdateAI
+    template<class AI>
+    bool IsExactAI() const { return typeid(*this) == typeid(AI); }
+
     bool _EnterEvadeMode(EvadeReason why = EVADE_REASON_OTHER);
 
     CreatureBoundary const* _boundary;
@@ -101,7 +101,7 @@ void SmartAI::UpdateDespawn(const uint32 diff)
         mDespawnTime -= diff;
 }
 
-WayPoint* SmartAI::GetNextWayPoint()
+WayPoint const* SmartAI::GetNextWayPoint()
 {
     if (!mWayPoints || mWayPoints->empty())
         return nullptr;
@@ -110,11 +110,11 @@ WayPoint* SmartAI::GetNextWayPoint()
     WPPath::const_iterator itr = mWayPoints->find(mCurrentWPID);
     if (itr != mWayPoints->end())
     {
-        mLastWP = (*itr).second;
+        mLastWP = &itr->second;
         if (mLastWP->id != mCurrentWPID)
             LOG_ERROR("scripts.ai.sai", "SmartAI::GetNextWayPoint: Got not expected waypoint id {}, expected {}", mLastWP->id, mCurrentWPID);
 
-        return (*itr).second;
+        return mLastWP;
     }
     return nullptr;
 }
@@ -134,7 +134,7 @@ void SmartAI::GenerateWayPointArray(Movement::PointsArray* points)
         WPPath::const_iterator itr;
         while ((itr = mWayPoints->find(wpCounter++)) != mWayPoints->end())
         {
-            WayPoint* wp = (*itr).second;
+            WayPoint const* wp = &itr->second;
             points->push_back(G3D::Vector3(wp->x, wp->y, wp->z));
         }
     }
@@ -152,7 +152,7 @@ void SmartAI::GenerateWayPointArray(Movement::PointsArray* points)
             WPPath::const_iterator itr;
             while ((itr = mWayPoints->find(wpCounter++)) != mWayPoints->end() && cnt++ <= length)
             {
-                WayPoint* wp = (*itr).second;
+                WayPoint const* wp = &itr->second;
                 pVector.push_back(G3D::Vector3(wp->x, wp->y, wp->z));
             }
 
@@ -196,7 +196,7 @@ void SmartAI::StartPath(bool run, uint32 path, bool repeat, Unit* invoker)
     if (!mWayPoints || mWayPoints->empty())
         return;
 
-    if (WayPoint* wp = GetNextWayPoint())
+    if (WayPoint const* wp = GetNextWayPoint())
     {
         AddEscortState(SMART_ESCORT_ESCORTING);
         mCanRepeatPath = repeat;
@@ -256,9 +256,9 @@ void SmartAI::PausePath(uint32 delay, bool forced)
         me->GetMotionMaster()->MoveIdle();//force stop
 
         auto waypoint = mWayPoints->find(mCurrentWPID);
-        if (waypoint->second->o.has_value())
+        if (waypoint->second.o.has_value())
         {
-            me->SetFacingTo(waypoint->second->o.has_value());
+            me->SetFacingTo(waypoint->second.o.has_value());
         }
     }
     GetScript()->ProcessEventsFor(SMART_EVENT_WAYPOINT_PAUSED, nullptr, mCurrentWPID, GetScript()->GetPathId());
@@ -34,7 +34,9 @@
 #include "ScriptedGossip.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
+#include "TickArena.h"
 #include "Vehicle.h"
+#include "ZoneProfiler.h"
 
 /// @todo: this import is not necessary for compilation and marked as unused by the IDE
 //  however, for some reasons removing it would cause a damn linking issue
@@ -58,6 +60,8 @@ SmartScript::SmartScript()
     isProcessingTimedActionList = false;
     mCurrentPriority = 0;
     mEventSortingRequired = false;
+    mEventTypeOffsets.fill(0);
+    mEventTypeIndexDirty = false;
     _allowPhaseReset = true;
 }
 
@@ -94,20 +98,21 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_AC_END)//special handling
+        return;
+
+    if (mEventTypeIndexDirty)
+        BuildEventTypeIndex();
+
+    for (uint16 i = mEventTypeOffsets[e], end = mEventTypeOffsets[e + 1]; i < end; ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        SmartScriptHolder& holder = mEvents[mEventTypeIndex[i]];
 
-        if (eventType == e)
-        {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent((*i).entryOrGuid, (*i).event_id, (*i).source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
+        ConditionList const& conds = sConditionMgr->GetConditionsForSmartEvent(holder.entryOrGuid, holder.event_id, holder.source_type);
+        ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
-                ProcessEvent(*i, unit, var0, var1, bvar, spell, gob);
-        }
+        if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+            ProcessEvent(holder, unit, var0, var1, bvar, spell, gob);
     }
 }
 
@@ -134,7 +139,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
     bool isControlled = e.action.moveToPos.controlled > 0;
 
-    ObjectVector targets;
+    ObjectVector targets(Acore::GetTickMemoryResource());
     GetTargets(targets, e, unit);
 
     switch (e.GetActionType())
@@ -269,7 +274,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_MUSIC:
         {
-            ObjectVector targets;
+            ObjectVector targets(Acore::GetTickMemoryResource());
 
             if (e.action.music.type > 0)
             {
@@ -315,7 +320,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
         }
         case SMART_ACTION_RANDOM_MUSIC:
         {
-            ObjectVector targets;
+            ObjectVector targets(Acore::GetTickMemoryResource());
 
             if (e.action.randomMusic.type > 0)
             {
@@ -1213,7 +1218,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
             if (!me->GetMap()->IsDungeon())
             {
-                ObjectVector units;
+                ObjectVector units(Acore::GetTickMemoryResource());
                 GetWorldObjectsInDist(units, static_cast<float>(e.target.unitRange.maxDist));
 
                 if (!units.empty() && GetBaseObject())
@@ -1998,7 +2003,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (targets.empty())
                 break;
 
-            ObjectVector casters;
+            ObjectVector casters(Acore::GetTickMemoryResource());
             GetTargets(casters, CreateSmartEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.crossCast.targetType, e.action.crossCast.targetParam1, e.action.crossCast.targetParam2, e.action.crossCast.targetParam3, 0, 0), unit);
 
             for (WorldObject* caster : casters)
@@ -2401,7 +2406,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                          std::back_inserter(waypoints), [](uint32 wp) { return wp != 0; });
 
             float distanceToClosest = std::numeric_limits<float>::max();
-            WayPoint* closestWp = nullptr;
+            WayPoint const* closestWp = nullptr;
 
             for (WorldObject* target : targets)
             {
@@ -2411,21 +2416,19 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                     {
                         for (uint32 wp : waypoints)
                         {
-                            WPPath* path = sSmartWaypointMgr->GetPath(wp);
+                            WPPath const* path = sSmartWaypointMgr->GetPath(wp);
                             if (!path || path->empty())
                                 continue;
 
                             auto itrWp = path->find(0);
                             if (itrWp != path->end())
                             {
-                                if (WayPoint* wp = itrWp->second)
+                                WayPoint const* wp = &itrWp->second;
+                                float distToThisPath = creature->GetDistance(wp->x, wp->y, wp->z);
+                                if (distToThisPath < distanceToClosest)
                                 {
-                                    float distToThisPath = creature->GetDistance(wp->x, wp->y, wp->z);
-                                    if (distToThisPath < distanceToClosest)
-                                    {
-                                        distanceToClosest = distToThisPath;
-                                        closestWp = wp;
-                                    }
+                                    distanceToClosest = distToThisPath;
+                                    closestWp = wp;
                                 }
                             }
                         }
@@ -3043,7 +3046,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 }
                 case 3: // Target parameters
                 {
-                    ObjectVector facingTargets;
+                    ObjectVector facingTargets(Acore::GetTickMemoryResource());
                     GetTargets(facingTargets, CreateSmartEvent(SMART_EVENT_UPDATE_IC, 0, 0, 0, 0, 0, 0, 0, SMART_ACTION_NONE, 0, 0, 0, 0, 0, 0, (SMARTAI_TARGETS)e.action.orientationTarget.targetType, e.action.orientationTarget.targetParam1, e.action.orientationTarget.targetParam2, e.action.orientationTarget.targetParam3, e.action.orientationTarget.targetParam4, 0), unit);
 
                     for (WorldObject* facingTarget : facingTargets)
@@ -3132,7 +3135,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
     // xinef: extended by selfs victim
-    ConditionList const conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
+    ConditionList const& conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
     ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
     if (sConditionMgr->IsObjectMeetToConditions(info, conds))
@@ -3373,7 +3376,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
                 break;
             }
 
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.unitRange.maxDist));
 
             for (WorldObject* unit : units)
@@ -3401,7 +3404,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_CREATURE_DISTANCE:
         {
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.unitDistance.dist));
 
             for (WorldObject* unit : units)
@@ -3429,7 +3432,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_GAMEOBJECT_DISTANCE:
         {
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.goDistance.dist));
 
             for (WorldObject* unit : units)
@@ -3460,7 +3463,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
                 break;
             }
 
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.goRange.maxDist));
 
             for (WorldObject* unit : units)
@@ -3507,7 +3510,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_PLAYER_RANGE:
         {
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.playerRange.maxDist));
 
             if (!units.empty() && baseObject)
@@ -3520,7 +3523,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_PLAYER_DISTANCE:
         {
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.playerDistance.dist));
 
             for (WorldObject* unit : units)
@@ -3683,7 +3686,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_PLAYER_WITH_AURA:
         {
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.playerDistance.dist));
 
             for (WorldObject* unit : units)
@@ -3699,7 +3702,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
         }
         case SMART_TARGET_ROLE_SELECTION:
         {
-            ObjectVector units;
+            ObjectVector units(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(units, static_cast<float>(e.target.playerDistance.dist));
             // 1 = Tanks, 2 = Healer, 4 = Damage
             uint32 roleMask = e.target.roleSelection.roleMask;
@@ -4342,7 +4345,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                     case SMART_TARGET_PLAYER_RANGE:
                     case SMART_TARGET_PLAYER_DISTANCE:
                     {
-                        ObjectVector targets;
+                        ObjectVector targets(Acore::GetTickMemoryResource());
                         GetTargets(targets, e);
                         for (WorldObject* target : targets)
                         {
@@ -4446,7 +4449,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         case SMART_EVENT_NEAR_PLAYERS:
         {
             uint32 playerCount = 0;
-            ObjectVector targets;
+            ObjectVector targets(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(targets, static_cast<float>(e.event.nearPlayer.radius));
 
             if (!targets.empty())
@@ -4465,7 +4468,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         case SMART_EVENT_NEAR_PLAYERS_NEGATION:
         {
             uint32 playerCount = 0;
-            ObjectVector targets;
+            ObjectVector targets(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(targets, static_cast<float>(e.event.nearPlayerNegation.radius));
 
             if (!targets.empty())
@@ -4485,7 +4488,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         case SMART_EVENT_NEAR_UNIT:
         {
             uint32 unitCount = 0;
-            ObjectVector targets;
+            ObjectVector targets(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(targets, static_cast<float>(e.event.nearUnit.range));
 
             if (!targets.empty())
@@ -4516,7 +4519,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
         case SMART_EVENT_NEAR_UNIT_NEGATION:
         {
             uint32 unitCount = 0;
-            ObjectVector targets;
+            ObjectVector targets(Acore::GetTickMemoryResource());
             GetWorldObjectsInDist(targets, static_cast<float>(e.event.nearUnitNegation.range));
 
             if (!targets.empty())
@@ -4759,11 +4762,14 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        mEventTypeIndexDirty = true;
     }
 }
 
 void SmartScript::OnUpdate(uint32 const diff)
 {
+    PROFILE_ZONE("SmartScript::OnUpdate");
+
     if ((mScriptType == SMART_SCRIPT_TYPE_CREATURE || mScriptType == SMART_SCRIPT_TYPE_GAMEOBJECT) && !GetBaseObject())
         return;
 
@@ -4773,6 +4779,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     {
         SortEvents(mEvents);
         mEventSortingRequired = false;
+        mEventTypeIndexDirty = true;
     }
 
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
@@ -4835,6 +4842,26 @@ void SmartScript::SortEvents(SmartAIEventList& events)
     std::sort(events.begin(), events.end());
 }
 
+void SmartScript::BuildEventTypeIndex()
+{
+    // counting sort by event type, keeps the (priority) order of mEvents within each type
+    mEventTypeOffsets.fill(0);
+    for (SmartScriptHolder const& e : mEvents)
+        if (e.GetEventType() < SMART_EVENT_AC_END)
+            ++mEventTypeOffsets[e.GetEventType() + 1];
+
+    for (std::size_t i = 1; i < mEventTypeOffsets.size(); ++i)
+        mEventTypeOffsets[i] += mEventTypeOffsets[i - 1];
+
+    std::array<uint16, SMART_EVENT_AC_END + 1> next = mEventTypeOffsets;
+    mEventTypeIndex.resize(mEventTypeOffsets[SMART_EVENT_AC_END]);
+    for (std::size_t i = 0; i < mEvents.size(); ++i)
+        if (mEvents[i].GetEventType() < SMART_EVENT_AC_END)
+            mEventTypeIndex[next[mEvents[i].GetEventType()]++] = uint16(i);
+
+    mEventTypeIndexDirty = false;
+}
+
 void SmartScript::RaisePriority(SmartScriptHolder& e)
 {
     e.timer = 1200;
@@ -4857,7 +4884,7 @@ void SmartScript::RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll)
     e.runOnce = false;
 }
 
-void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at)
+void SmartScript::FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTrigger const* at)
 {
     (void)at; // ensure that the variable is referenced even if extra logs are disabled in order to pass compiler checks
 
@@ -4870,7 +4897,9 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
             LOG_DEBUG("sql.sql", "SmartScript: EventMap for AreaTrigger {} is empty but is using SmartScript.", at->entry);
         return;
     }
-    for (SmartAIEventList::iterator i = e.begin(); i != e.end(); ++i)
+
+    mEvents.reserve(mEvents.size() + e.size());
+    for (SmartAIEventList::const_iterator i = e.begin(); i != e.end(); ++i)
     {
 #ifndef ACORE_DEBUG
         if ((*i).event.event_flags & SMART_EVENT_FLAG_DEBUG_ONLY)
@@ -4890,40 +4919,35 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger c
         }
         mEvents.push_back((*i));//NOTE: 'world(0)' events still get processed in ANY instance mode
     }
+
+    mEventTypeIndexDirty = true;
 }
 
 void SmartScript::GetScript()
 {
-    SmartAIEventList e;
     if (me)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)me->GetSpawnId()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)me->GetSpawnId()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
 
-        FillScript(e, me, nullptr);
+        FillScript(*e, me, nullptr);
 
         if (CreatureTemplate const* cInfo = me->GetCreatureTemplate())
         {
             if (cInfo->HasFlagsExtra(CREATURE_FLAG_DONT_OVERRIDE_ENTRY_SAI))
-            {
-                e = sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType);
-                FillScript(e, me, nullptr);
-            }
+                FillScript(sSmartScriptMgr->GetScript((int32)me->GetEntry(), mScriptType), me, nullptr);
         }
     }
     else if (go)
     {
-        e = sSmartScriptMgr->GetScript(-((int32)go->GetSpawnId()), mScriptType);
-        if (e.empty())
-            e = sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
-        FillScript(e, go, nullptr);
+        SmartAIEventList const* e = &sSmartScriptMgr->GetScript(-((int32)go->GetSpawnId()), mScriptType);
+        if (e->empty())
+            e = &sSmartScriptMgr->GetScript((int32)go->GetEntry(), mScriptType);
+        FillScript(*e, go, nullptr);
     }
     else if (trigger)
-    {
-        e = sSmartScriptMgr->GetScript((int32)trigger->entry, mScriptType);
-        FillScript(e, nullptr, trigger);
-    }
+        FillScript(sSmartScriptMgr->GetScript((int32)trigger->entry, mScriptType), nullptr, trigger);
 }
 
 void SmartScript::OnInitialize(WorldObject* obj, AreaTrigger const* at)
@@ -34,7 +34,7 @@ public:
 
     void OnInitialize(WorldObject* obj, AreaTrigger const* at = nullptr);
     void GetScript();
-    void FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at);
+    void FillScript(SmartAIEventList const& e, WorldObject* obj, AreaTrigger const* at);
 
     void ProcessEventsFor(SMART_EVENT e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
     void ProcessEvent(SmartScriptHolder& e, Unit* unit = nullptr, uint32 var0 = 0, uint32 var1 = 0, bool bvar = false, SpellInfo const* spell = nullptr, GameObject* gob = nullptr);
@@ -229,10 +229,15 @@ private:
     bool IsInPhase(uint32 p) const;
 
     void SortEvents(SmartAIEventList& events);
+    void BuildEventTypeIndex();
     void RaisePriority(SmartScriptHolder& e);
     void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
     SmartAIEventList mEvents;
+    // positions in mEvents grouped by event type, so ProcessEventsFor only visits matching events
+    std::vector<uint16> mEventTypeIndex;
+    std::array<uint16, SMART_EVENT_AC_END + 1> mEventTypeOffsets;
+    bool mEventTypeIndexDirty;
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
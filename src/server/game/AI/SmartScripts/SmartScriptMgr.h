@@ -27,6 +27,7 @@
 #include "SpellMgr.h"
 #include "Unit.h"
 #include <limits>
+#include <memory_resource>
 
 typedef uint32 SAIBool;
 
@@ -1959,9 +1960,10 @@ public:
     static constexpr uint32 DEFAULT_PRIORITY = std::numeric_limits<uint32>::max();
 };
 
-typedef std::unordered_map<uint32, WayPoint*> WPPath;
+typedef std::unordered_map<uint32, WayPoint> WPPath;
 
-typedef std::vector<WorldObject*> ObjectVector;
+// pmr so temporary target lists can live in the tick arena (see TickArena.h), copies use the heap
+typedef std::pmr::vector<WorldObject*> ObjectVector;
 
 class ObjectGuidVector
 {
@@ -2008,15 +2010,18 @@ public:
 
     void LoadFromDB();
 
-    WPPath* GetPath(uint32 id)
+    WPPath const* GetPath(uint32 id) const
     {
-        if (waypoint_map.find(id) != waypoint_map.end())
-            return waypoint_map[id];
-        else return 0;
+        auto itr = waypoint_map.find(id);
+        if (itr != waypoint_map.end())
+            return &itr->second;
+
+        return nullptr;
     }
 
 private:
-    std::unordered_map<uint32, WPPath*> waypoint_map;
+    // Points are stored by value, one allocation per node instead of node plus point
+    std::unordered_map<uint32, WPPath> waypoint_map;
 };
 
 // all events for a single entry
@@ -2036,17 +2041,16 @@ public:
 
     void LoadSmartAIFromDB();
 
-    SmartAIEventList GetScript(int32 entry, SmartScriptType type)
+    SmartAIEventList const& GetScript(int32 entry, SmartScriptType type) const
     {
-        SmartAIEventList temp;
-        if (mEventMap[uint32(type)].find(entry) != mEventMap[uint32(type)].end())
-            return mEventMap[uint32(type)][entry];
-        else
-        {
-            if (entry > 0) //first search is for guid (negative), do not drop error if not found
-                LOG_DEBUG("sql.sql", "SmartAIMgr::GetScript: Could not load Script for Entry {} ScriptType {}.", entry, uint32(type));
-            return temp;
-        }
+        static SmartAIEventList const empty;
+        auto itr = mEventMap[uint32(type)].find(entry);
+        if (itr != mEventMap[uint32(type)].end())
+            return itr->second;
+
+        if (entry > 0) //first search is for guid (negative), do not drop error if not found
+            LOG_DEBUG("sql.sql", "SmartAIMgr::GetScript: Could not load Script for Entry {} ScriptType {}.", entry, uint32(type));
+        return empty;
     }
 
 private:
@@ -505,6 +505,7 @@ void AchievementMgr::Reset()
 
     _completedAchievements.clear();
     _criteriaProgress.clear();
+    ResetCompletedCriteriaTypes();
     DeleteFromDB(_player->GetGUID().GetCounter());
 
     // re-fill data
@@ -553,8 +554,9 @@ void AchievementMgr::DeleteFromDB(ObjectGuid::LowType lowguid)
     CharacterDatabase.CommitTransaction(trans);
 }
 
-void AchievementMgr::SaveToDB(CharacterDatabaseTransaction trans)
+void AchievementMgr::SaveToDB(CharacterDatabaseTransaction trans, bool logout /*= false*/)
 {
+    // Rows are written as REPLACE statements, consecutive ones are sent by the transaction as multi-row statements
     if (!_completedAchievements.empty())
     {
         for (CompletedAchievementMap::iterator iter = _completedAchievements.begin(); iter != _completedAchievements.end(); ++iter)
@@ -562,12 +564,7 @@ void AchievementMgr::SaveToDB(CharacterDatabaseTransaction trans)
             if (!iter->second.changed)
                 continue;
 
-            CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACHIEVEMENT_BY_ACHIEVEMENT);
-            stmt->SetData(0, iter->first);
-            stmt->SetData(1, GetPlayer()->GetGUID().GetCounter());
-            trans->Append(stmt);
-
-            stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_ACHIEVEMENT);
+            CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_ACHIEVEMENT);
             stmt->SetData(0, GetPlayer()->GetGUID().GetCounter());
             stmt->SetData(1, iter->first);
             stmt->SetData(2, uint32(iter->second.date));
@@ -579,34 +576,56 @@ void AchievementMgr::SaveToDB(CharacterDatabaseTransaction trans)
         }
     }
 
-    if (!_criteriaProgress.empty())
+    if (_criteriaProgress.empty())
+        return;
+
+    uint32 statisticThreshold = logout ? 0 : sWorld->getIntConfig(CONFIG_ACHIEVEMENT_STATISTIC_SAVE_THRESHOLD);
+
+    // Deletes are appended after all replaces so they don't split the multi-row statements
+    std::vector<CharacterDatabasePreparedStatement*> deletes;
+
+    for (CriteriaProgressMap::iterator iter = _criteriaProgress.begin(); iter != _criteriaProgress.end(); ++iter)
     {
-        for (CriteriaProgressMap::iterator iter = _criteriaProgress.begin(); iter != _criteriaProgress.end(); ++iter)
+        CriteriaProgress& progress = iter->second;
+        if (!progress.changed)
+            continue;
+
+        // statistics change all the time, only write them once they moved far enough from the saved value
+        if (statisticThreshold && progress.counter && progress.savedCounter)
         {
-            if (!iter->second.changed)
-                continue;
+            uint64 delta = progress.counter > progress.savedCounter ? progress.counter - progress.savedCounter : progress.savedCounter - progress.counter;
+            if (delta * 100 < uint64(progress.savedCounter) * statisticThreshold)
+                if (AchievementCriteriaEntry const* criteria = sAchievementCriteriaStore.LookupEntry(iter->first))
+                    if (sAchievementMgr->IsStatisticCriteria(criteria))
+                        continue;
+        }
 
-            CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA);
+        // pussywizard: insert only for (counter != 0) is very important! this is how criteria of completed achievements gets deleted from db (by setting counter to 0); if conflicted during merge - contact me
+        if (progress.counter)
+        {
+            CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_ACHIEVEMENT_PROGRESS);
             stmt->SetData(0, GetPlayer()->GetGUID().GetCounter());
             stmt->SetData(1, iter->first);
+            stmt->SetData(2, progress.counter);
+            stmt->SetData(3, uint32(progress.date));
             trans->Append(stmt);
+        }
+        else
+        {
+            CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_ACHIEVEMENT_PROGRESS_BY_CRITERIA);
+            stmt->SetData(0, GetPlayer()->GetGUID().GetCounter());
+            stmt->SetData(1, iter->first);
+            deletes.push_back(stmt);
+        }
 
-            // pussywizard: insert only for (counter != 0) is very important! this is how criteria of completed achievements gets deleted from db (by setting counter to 0); if conflicted during merge - contact me
-            if (iter->second.counter)
-            {
-                stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CHAR_ACHIEVEMENT_PROGRESS);
-                stmt->SetData(0, GetPlayer()->GetGUID().GetCounter());
-                stmt->SetData(1, iter->first);
-                stmt->SetData(2, iter->second.counter);
-                stmt->SetData(3, uint32(iter->second.date));
-                trans->Append(stmt);
-            }
-
-            iter->second.changed = false;
+        progress.changed = false;
+        progress.savedCounter = progress.counter;
 
-            sScriptMgr->OnCriteriaSave(trans, GetPlayer(), iter->first, iter->second);
-        }
+        sScriptMgr->OnCriteriaSave(trans, GetPlayer(), iter->first, progress);
     }
+
+    for (CharacterDatabasePreparedStatement* stmt : deletes)
+        trans->Append(stmt);
 }
 
 void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQueryResult criteriaResult)
@@ -667,6 +686,7 @@ void AchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, PreparedQ
             progress.counter = counter;
             progress.date    = date;
             progress.changed = false;
+            progress.savedCounter = counter;
         } while (criteriaResult->NextRow());
     }
 }
@@ -806,6 +826,9 @@ void AchievementMgr::UpdateAchievementCriteria(AchievementCriteriaTypes type, ui
 
     LOG_DEBUG("achievement", "AchievementMgr::UpdateAchievementCriteria({}, {}, {})", type, miscValue1, miscValue2);
 
+    if (IsCriteriaTypeCompleted(type))
+        return;
+
     AchievementCriteriaEntryList const* achievementCriteriaList = nullptr;
 
     switch (type)
@@ -2156,6 +2179,7 @@ void AchievementMgr::RemoveCriteriaProgress(const AchievementCriteriaEntry* entr
     _player->SendDirectMessage(&data);
 
     _criteriaProgress.erase(criteriaProgress);
+    ResetCompletedCriteriaTypes();
 }
 
 void AchievementMgr::UpdateTimedAchievements(uint32 timeDiff)
@@ -2249,6 +2273,9 @@ void AchievementMgr::CompletedAchievement(AchievementEntry const* achievement)
     ca.date = GameTime::GetGameTime().count();
     ca.changed = true;
 
+    // types with incomplete criteria may have run out of them now
+    _checkedCriteriaTypes.reset();
+
     sScriptMgr->OnAchievementComplete(GetPlayer(), achievement);
 
     // pussywizard: set all progress counters to 0, so progress will be deleted from db during save
@@ -2432,6 +2459,44 @@ bool AchievementMgr::CanUpdateCriteria(AchievementCriteriaEntry const* criteria,
     return true;
 }
 
+/**
+ * true when every criteria of the type is completed for good, so updates of that type can be dropped without walking the criteria list
+ */
+bool AchievementMgr::IsCriteriaTypeCompleted(AchievementCriteriaTypes type)
+{
+    if (_checkedCriteriaTypes.test(type))
+        return _completedCriteriaTypes.test(type);
+
+    _checkedCriteriaTypes.set(type);
+    _completedCriteriaTypes.reset(type);
+
+    if (AchievementCriteriaEntryList const* achievementCriteriaList = sAchievementMgr->GetAchievementCriteriaByType(type))
+    {
+        for (AchievementCriteriaEntry const* achievementCriteria : *achievementCriteriaList)
+        {
+            AchievementEntry const* achievement = sAchievementStore.LookupEntry(achievementCriteria->referredAchievement);
+            if (!achievement)
+                continue;
+
+            // counters never complete and realm first criteria are reopened when the realm first is lost
+            if (achievement->flags & (ACHIEVEMENT_FLAG_COUNTER | ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL))
+                return false;
+
+            if (!IsCompletedCriteria(achievementCriteria, achievement))
+                return false;
+        }
+    }
+
+    _completedCriteriaTypes.set(type);
+    return true;
+}
+
+void AchievementMgr::ResetCompletedCriteriaTypes()
+{
+    _checkedCriteriaTypes.reset();
+    _completedCriteriaTypes.reset();
+}
+
 CompletedAchievementMap const& AchievementMgr::GetCompletedAchievements()
 {
     return _completedAchievements;
@@ -3037,8 +3102,8 @@ void AchievementGlobalMgr::LoadRewardLocales()
             continue;
 
         AchievementRewardLocale& data = _achievementRewardLocales[ID];
-        ObjectMgr::AddLocaleString(fields[2].Get<std::string>(), locale, data.Subject);
-        ObjectMgr::AddLocaleString(fields[3].Get<std::string>(), locale, data.Text);
+        ObjectMgr::AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Subject);
+        ObjectMgr::AddLocaleString(fields[3].Get<std::string_view>(), locale, data.Text);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Achievement Reward Locale Strings in {} ms", (unsigned long)_achievementRewardLocales.size(), GetMSTimeDiffToNow(oldMSTime));
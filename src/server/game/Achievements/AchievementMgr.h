@@ -23,6 +23,7 @@
 #include "DBCStores.h"
 #include "DatabaseEnv.h"
 #include "ObjectGuid.h"
+#include <bitset>
 #include <chrono>
 #include <map>
 #include <string>
@@ -38,6 +39,7 @@ struct CriteriaProgress
     uint32 counter;
     time_t date;                                            // latest update time.
     bool changed;
+    uint32 savedCounter;                                    // counter as last written to the db
 };
 
 enum AchievementCriteriaDataType
@@ -257,8 +259,8 @@ typedef std::map<uint32, AchievementReward> AchievementRewards;
 
 struct AchievementRewardLocale
 {
-    std::vector<std::string> Subject;
-    std::vector<std::string> Text;
+    LocaleStrings Subject;
+    LocaleStrings Text;
 };
 
 typedef std::map<uint32, AchievementRewardLocale> AchievementRewardLocales;
@@ -285,7 +287,7 @@ public:
     void Reset();
     static void DeleteFromDB(ObjectGuid::LowType lowguid);
     void LoadFromDB(PreparedQueryResult achievementResult, PreparedQueryResult criteriaResult);
-    void SaveToDB(CharacterDatabaseTransaction trans);
+    void SaveToDB(CharacterDatabaseTransaction trans, bool logout = false);
     void ResetAchievementCriteria(AchievementCriteriaCondition condition, uint32 value, bool evenIfCriteriaComplete = false);
     void UpdateAchievementCriteria(AchievementCriteriaTypes type, uint32 miscValue1 = 0, uint32 miscValue2 = 0, Unit* unit = nullptr);
     void CompletedAchievement(AchievementEntry const* entry);
@@ -311,6 +313,8 @@ private:
     bool IsCompletedCriteria(AchievementCriteriaEntry const* achievementCriteria, AchievementEntry const* achievement);
     bool IsCompletedAchievement(AchievementEntry const* entry);
     bool CanUpdateCriteria(AchievementCriteriaEntry const* criteria, AchievementEntry const* achievement);
+    bool IsCriteriaTypeCompleted(AchievementCriteriaTypes type);
+    void ResetCompletedCriteriaTypes();
     void BuildAllDataPacket(WorldPacket* data) const;
 
     Player* _player;
@@ -318,6 +322,9 @@ private:
     CompletedAchievementMap _completedAchievements;
     typedef std::map<uint32, uint32> TimedAchievementMap;
     TimedAchievementMap _timedAchievements;      // Criteria id/time left in MS
+    // criteria types without anything left to update for this player, filled lazily
+    std::bitset<ACHIEVEMENT_CRITERIA_TYPE_TOTAL> _checkedCriteriaTypes;
+    std::bitset<ACHIEVEMENT_CRITERIA_TYPE_TOTAL> _completedCriteriaTypes;
 };
 
 class AchievementGlobalMgr
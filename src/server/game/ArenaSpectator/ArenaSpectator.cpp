@@ -309,6 +309,14 @@ AC_GAME_API void ArenaSpectator::SendPacketTo(Player const* player, std::string&
     player->GetSession()->SendPacket(&data);
 }
 
+template<>
+AC_GAME_API void ArenaSpectator::SendPacketTo(const Battleground* bg, std::string&& message)
+{
+    WorldPacket data;
+    CreatePacket(data, message);
+    bg->SpectatorsSendPacket(data);
+}
+
 template<>
 AC_GAME_API void ArenaSpectator::SendPacketTo(const Map* map, std::string&& message)
 {
@@ -319,7 +327,17 @@ AC_GAME_API void ArenaSpectator::SendPacketTo(const Map* map, std::string&& mess
     if (!bg || bg->GetStatus() != STATUS_IN_PROGRESS)
         return;
 
-    WorldPacket data;
-    CreatePacket(data, message);
-    bg->SpectatorsSendPacket(data);
+    SendPacketTo<Battleground>(bg, std::move(message));
+}
+
+void ArenaSpectator::QueueCommand_UInt32Value(Map const* map, ObjectGuid targetGUID, const char* prefix, uint32 t)
+{
+    if (!targetGUID.IsPlayer() || !map->IsBattleArena())
+        return;
+
+    Battleground* bg = ((BattlegroundMap*)map)->GetBG();
+    if (!bg || bg->GetStatus() != STATUS_IN_PROGRESS)
+        return;
+
+    bg->SpectatorsQueueValue(targetGUID, prefix, t);
 }
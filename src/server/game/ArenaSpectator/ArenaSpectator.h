@@ -26,6 +26,7 @@
 #include "StringFormat.h"
 
 class Aura;
+class Battleground;
 class Player;
 class Map;
 class WorldPacket;
@@ -107,6 +108,9 @@ namespace ArenaSpectator
         SendCommand(o, "%s0x%016llX;%s=%u,%u,%i,%i,%u,%u,%u,0x%016llX;", SPECTATOR_ADDON_PREFIX, targetGUID.GetRawValue(), prefix, remove ? 1 : 0, stack, dur, maxdur, id, dispel, isDebuff ? 1 : 0, caster.GetRawValue());
     }
 
+    // Health and power change many times per tick in a busy arena, spectators only get the last value of each tick
+    AC_GAME_API void QueueCommand_UInt32Value(Map const* map, ObjectGuid targetGUID, const char* prefix, uint32 t);
+
     AC_GAME_API bool HandleSpectatorSpectateCommand(ChatHandler* handler, std::string const& name);
     AC_GAME_API bool HandleSpectatorWatchCommand(ChatHandler* handler, std::string const& name);
     AC_GAME_API void CreatePacket(WorldPacket& data, std::string const& message);
@@ -228,6 +228,13 @@ AuctionHouseMgr* AuctionHouseMgr::instance()
     return &instance;
 }
 
+std::size_t AuctionHouseMgr::GetMemoryUsage() const
+{
+    // auctioned items are full Item objects with their update field values
+    return _hordeAuctions.GetMemoryUsage() + _allianceAuctions.GetMemoryUsage() + _neutralAuctions.GetMemoryUsage() +
+        _mAitems.size() * (sizeof(Item) + ITEM_END * sizeof(uint32)) + _mAitems.memory_usage();
+}
+
 AuctionHouseObject* AuctionHouseMgr::GetAuctionsMap(uint32 factionTemplateId)
 {
     if (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_AUCTION))
@@ -570,6 +577,8 @@ void AuctionHouseMgr::AddAItem(Item* it)
 {
     ASSERT(it);
     ASSERT(_mAitems.find(it->GetGUID()) == _mAitems.end());
+
+    std::unique_lock<std::shared_mutex> lock(_listingLock);
     _mAitems[it->GetGUID()] = it;
 }
 
@@ -586,6 +595,7 @@ bool AuctionHouseMgr::RemoveAItem(ObjectGuid itemGuid, bool deleteFromDB, Charac
         i->second->SaveToDB(*trans);
     }
 
+    std::unique_lock<std::shared_mutex> lock(_listingLock);
     _mAitems.erase(i);
     return true;
 }
@@ -593,9 +603,15 @@ bool AuctionHouseMgr::RemoveAItem(ObjectGuid itemGuid, bool deleteFromDB, Charac
 void AuctionHouseMgr::Update()
 {
     sScriptMgr->OnBeforeAuctionHouseMgrUpdate();
-    _hordeAuctions.Update();
-    _allianceAuctions.Update();
-    _neutralAuctions.Update();
+
+    // all houses expire their auctions in one transaction
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    _hordeAuctions.Update(trans);
+    _allianceAuctions.Update(trans);
+    _neutralAuctions.Update(trans);
+
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
 }
 
 AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTemplateId)
@@ -626,45 +642,193 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntryFromHouse(uint8 ho
     return (sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_AUCTION)) ? sAuctionHouseStore.LookupEntry(AUCTIONHOUSE_NEUTRAL) : sAuctionHouseStore.LookupEntry(houseId);
 }
 
+std::size_t AuctionHouseObject::GetMemoryUsage() const
+{
+    // every auction is in _auctionsMap, the three category indexes and the expire set, tree nodes carry about 32 bytes of links
+    std::size_t constexpr TreeNodeOverhead = 32;
+    std::size_t const perAuction = sizeof(AuctionEntry) + 4 * (TreeNodeOverhead + sizeof(AuctionEntryMap::value_type)) +
+        TreeNodeOverhead + sizeof(std::pair<time_t, uint32>);
+
+    return _auctionsMap.size() * perAuction;
+}
+
 void AuctionHouseObject::AddAuction(AuctionEntry* auction)
 {
     ASSERT(auction);
 
-    _auctionsMap[auction->Id] = auction;
+    {
+        std::unique_lock<std::shared_mutex> lock(sAuctionMgr->GetListingLock());
+        _auctionsMap[auction->Id] = auction;
+        AddToIndexes(auction);
+    }
+
     sScriptMgr->OnAuctionAdd(this, auction);
 }
 
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
+    std::unique_lock<std::shared_mutex> lock(sAuctionMgr->GetListingLock());
+
     bool wasInMap = !!_auctionsMap.erase(auction->Id);
+    if (wasInMap)
+        RemoveFromIndexes(auction);
+
+    lock.unlock();
 
     sScriptMgr->OnAuctionRemove(this, auction);
 
-    // we need to delete the entry, it is not referenced any more
+    // we need to delete the entry, it is not referenced any more, listing threads can no longer reach it
     delete auction;
     auction = nullptr;
 
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+void AuctionHouseObject::AddToIndexes(AuctionEntry* auction)
 {
-    time_t checkTime = GameTime::GetGameTime().count() + 60;
-    ///- Handle expired auctions
+    _auctionsByExpireTime.emplace(auction->expire_time, auction->Id);
 
-    // If storage is empty, no need to update. next == nullptr in this case.
-    if (_auctionsMap.empty())
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->item_template);
+    if (!proto)
         return;
 
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    _auctionsByClass[proto->Class][auction->Id] = auction;
+    _auctionsBySubClass[(proto->Class << 16) | proto->SubClass][auction->Id] = auction;
+    _auctionsByInventoryType[proto->InventoryType][auction->Id] = auction;
+}
+
+void AuctionHouseObject::RemoveFromIndexes(AuctionEntry* auction)
+{
+    _auctionsByExpireTime.erase({ auction->expire_time, auction->Id });
+
+    ItemTemplate const* proto = sObjectMgr->GetItemTemplate(auction->item_template);
+    if (!proto)
+        return;
+
+    auto removeFrom = [auction](AuctionIndex& index, uint32 key)
+    {
+        auto itr = index.find(key);
+        if (itr == index.end())
+            return;
+
+        itr->second.erase(auction->Id);
+        if (itr->second.empty())
+            index.erase(itr);
+    };
+
+    removeFrom(_auctionsByClass, proto->Class);
+    removeFrom(_auctionsBySubClass, (proto->Class << 16) | proto->SubClass);
+    removeFrom(_auctionsByInventoryType, proto->InventoryType);
+}
+
+AuctionHouseObject::AuctionEntryMap const& AuctionHouseObject::GetSearchCandidates(uint32 inventoryType, uint32 itemClass, uint32 itemSubClass) const
+{
+    static AuctionEntryMap const emptyIndex;
+
+    auto lookup = [](AuctionIndex const& index, uint32 key) -> AuctionEntryMap const&
+    {
+        auto itr = index.find(key);
+        return itr != index.end() ? itr->second : emptyIndex;
+    };
+
+    AuctionEntryMap const* candidates = &_auctionsMap;
+
+    if (itemClass != 0xffffffff)
+        candidates = itemSubClass != 0xffffffff ? &lookup(_auctionsBySubClass, (itemClass << 16) | itemSubClass) : &lookup(_auctionsByClass, itemClass);
+
+    // robes are listed as chests, the chest index alone would miss them
+    if (inventoryType != 0xffffffff && inventoryType != INVTYPE_CHEST)
+    {
+        AuctionEntryMap const& byInventoryType = lookup(_auctionsByInventoryType, inventoryType);
+        if (byInventoryType.size() < candidates->size())
+            candidates = &byInventoryType;
+    }
+
+    return *candidates;
+}
+
+std::wstring const& AuctionHouseObject::GetSearchName(Item* item, ItemTemplate const* proto, int locIdx, int locDbcIdx)
+{
+    // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
+    //  that matches the search but it may not equal item->GetItemRandomPropertyId()
+    //  used in BuildAuctionInfo() which then causes wrong items to be listed
+    int32 propRefID = item->GetItemRandomPropertyId();
+
+    uint64 key = (uint64(proto->ItemId) << 32) | ((uint32(propRefID) & 0xFFFFFF) << 8) | (uint32(locIdx + 1) << 4) | uint32(locDbcIdx + 1);
+
+    // every listing thread keeps its own names, they are never shared
+    thread_local std::unordered_map<uint64, std::wstring> searchNames;
+
+    auto itr = searchNames.find(key);
+    if (itr != searchNames.end())
+        return itr->second;
+
+    // templates and locales are static, the size cap only guards against a long uptime with a huge item variety
+    if (searchNames.size() >= 100000)
+        searchNames.clear();
+
+    std::wstring& searchName = searchNames[key];
 
-    for (AuctionEntryMap::iterator itr, iter = _auctionsMap.begin(); iter != _auctionsMap.end(); )
+    std::string name = proto->Name1;
+    if (name.empty())
+        return searchName;
+
+    // local name
+    if (locIdx >= 0)
+        if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
+            ObjectMgr::GetLocaleString(il->Name, locIdx, name);
+
+    if (propRefID)
     {
-        itr = iter++;
-        AuctionEntry* auction = (*itr).second;
+        // Append the suffix to the name (ie: of the Monkey) if one exists
+        // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
+        // even though the DBC name seems misleading
+        std::array<char const*, 16> const* suffix = nullptr;
+
+        if (propRefID < 0)
+        {
+            ItemRandomSuffixEntry const* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-propRefID);
+            if (itemRandEntry)
+                suffix = &itemRandEntry->Name;
+        }
+        else
+        {
+            ItemRandomPropertiesEntry const* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(propRefID);
+            if (itemRandEntry)
+                suffix = &itemRandEntry->Name;
+        }
+
+        // dbc local name
+        if (suffix)
+        {
+            // Append the suffix (ie: of the Monkey) to the name using localization
+            // or default enUS if localization is invalid
+            name += ' ';
+            name += (*suffix)[locDbcIdx >= 0 ? locDbcIdx : LOCALE_enUS];
+        }
+    }
+
+    if (Utf8toWStr(name, searchName))
+        wstrToLower(searchName);
+    else
+        searchName.clear();
 
-        if (auction->expire_time > checkTime)
+    return searchName;
+}
+
+void AuctionHouseObject::Update(CharacterDatabaseTransaction trans)
+{
+    time_t checkTime = GameTime::GetGameTime().count() + 60;
+    ///- Handle expired auctions, RemoveAuction() drops them from the expire time index
+    while (!_auctionsByExpireTime.empty() && _auctionsByExpireTime.begin()->first <= checkTime)
+    {
+        uint32 auctionId = _auctionsByExpireTime.begin()->second;
+        AuctionEntry* auction = GetAuction(auctionId);
+        if (!auction)
+        {
+            _auctionsByExpireTime.erase(_auctionsByExpireTime.begin());
             continue;
+        }
 
         ///- Either cancel the auction if there was no bidder
         if (!auction->bidder)
@@ -689,7 +853,6 @@ void AuctionHouseObject::Update()
         sAuctionMgr->RemoveAItem(auction->item_guid);
         RemoveAuction(auction);
     }
-    CharacterDatabase.CommitTransaction(trans);
 }
 
 void AuctionHouseObject::BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount)
@@ -750,7 +913,9 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
         int loc_idx = player->GetSession()->GetSessionDbLocaleIndex();
         int locdbc_idx = player->GetSession()->GetSessionDbcLocale();
 
-        for (AuctionEntryMap::const_iterator itr = _auctionsMap.begin(); itr != _auctionsMap.end(); ++itr)
+        AuctionEntryMap const& candidates = GetSearchCandidates(inventoryType, itemClass, itemSubClass);
+
+        for (AuctionEntryMap::const_iterator itr = candidates.begin(); itr != candidates.end(); ++itr)
         {
             if ((itrcounter++) % 100 == 0) // check condition every 100 iterations
             {
@@ -822,59 +987,9 @@ bool AuctionHouseObject::BuildListAuctionItems(WorldPacket& data, Player* player
 
             // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
             // No need to do any of this if no search term was entered
-            if (!wsearchedname.empty())
+            if (!wsearchedname.empty() && GetSearchName(item, proto, loc_idx, locdbc_idx).find(wsearchedname) == std::wstring::npos)
             {
-                std::string name = proto->Name1;
-                if (name.empty())
-                {
-                    continue;
-                }
-
-                // local name
-                if (loc_idx >= 0)
-                    if (ItemLocale const* il = sObjectMgr->GetItemLocale(proto->ItemId))
-                        ObjectMgr::GetLocaleString(il->Name, loc_idx, name);
-
-                // DO NOT use GetItemEnchantMod(proto->RandomProperty) as it may return a result
-                //  that matches the search but it may not equal item->GetItemRandomPropertyId()
-                //  used in BuildAuctionInfo() which then causes wrong items to be listed
-                int32 propRefID = item->GetItemRandomPropertyId();
-
-                if (propRefID)
-                {
-                    // Append the suffix to the name (ie: of the Monkey) if one exists
-                    // These are found in ItemRandomSuffix.dbc and ItemRandomProperties.dbc
-                    // even though the DBC name seems misleading
-                    std::array<char const*, 16> const* suffix = nullptr;
-
-                    if (propRefID < 0)
-                    {
-                        ItemRandomSuffixEntry const* itemRandEntry = sItemRandomSuffixStore.LookupEntry(-item->GetItemRandomPropertyId());
-                        if (itemRandEntry)
-                            suffix = &itemRandEntry->Name;
-                    }
-                    else
-                    {
-                        ItemRandomPropertiesEntry const* itemRandEntry = sItemRandomPropertiesStore.LookupEntry(item->GetItemRandomPropertyId());
-                        if (itemRandEntry)
-                            suffix = &itemRandEntry->Name;
-                    }
-
-                    // dbc local name
-                    if (suffix)
-                    {
-                        // Append the suffix (ie: of the Monkey) to the name using localization
-                        // or default enUS if localization is invalid
-                        name += ' ';
-                        name += (*suffix)[locdbc_idx >= 0 ? locdbc_idx : LOCALE_enUS];
-                    }
-                }
-
-                // Perform the search (with or without suffix)
-                if (!Utf8FitTo(name, wsearchedname))
-                {
-                    continue;
-                }
+                continue;
             }
 
             auctionShortlist.push_back(Aentry);
@@ -24,10 +24,13 @@
 #include "EventProcessor.h"
 #include "ObjectGuid.h"
 #include "WorldPacket.h"
+#include <set>
+#include <shared_mutex>
 #include <unordered_map>
 
 class Item;
 class Player;
+struct ItemTemplate;
 
 #define MIN_AUCTION_TIME (12*HOUR)
 #define MAX_AUCTION_ITEMS 160
@@ -130,7 +133,7 @@ class AuctionHouseObject
 {
 public:
     // Initialize storage
-    AuctionHouseObject() { _next = _auctionsMap.begin(); }
+    AuctionHouseObject() = default;
     ~AuctionHouseObject()
     {
         for (auto& itr : _auctionsMap)
@@ -140,6 +143,8 @@ public:
     typedef std::map<uint32, AuctionEntry*> AuctionEntryMap;
 
     [[nodiscard]] uint32 Getcount() const { return _auctionsMap.size(); }
+    /// return: estimated bytes of the auctions and their indexes
+    [[nodiscard]] std::size_t GetMemoryUsage() const;
 
     AuctionEntryMap::iterator GetAuctionsBegin() { return _auctionsMap.begin(); }
     AuctionEntryMap::iterator GetAuctionsEnd() { return _auctionsMap.end(); }
@@ -155,7 +160,7 @@ public:
 
     bool RemoveAuction(AuctionEntry* auction);
 
-    void Update();
+    void Update(CharacterDatabaseTransaction trans);
 
     void BuildListBidderItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
     void BuildListOwnerItems(WorldPacket& data, Player* player, uint32& count, uint32& totalcount);
@@ -165,10 +170,22 @@ public:
                                uint32& count, uint32& totalcount, uint8 getAll, AuctionSortOrderVector const& sortOrder, Milliseconds searchTimeout);
 
 private:
+    typedef std::unordered_map<uint32, AuctionEntryMap> AuctionIndex;
+
+    void AddToIndexes(AuctionEntry* auction);
+    void RemoveFromIndexes(AuctionEntry* auction);
+    [[nodiscard]] AuctionEntryMap const& GetSearchCandidates(uint32 inventoryType, uint32 itemClass, uint32 itemSubClass) const;
+    static std::wstring const& GetSearchName(Item* item, ItemTemplate const* proto, int locIdx, int locDbcIdx);
+
     AuctionEntryMap _auctionsMap;
 
-    // storage for "next" auction item for next Update()
-    AuctionEntryMap::const_iterator _next;
+    // secondary indexes of _auctionsMap, searches with a category only walk the matching auctions
+    AuctionIndex _auctionsByClass;
+    AuctionIndex _auctionsBySubClass;
+    AuctionIndex _auctionsByInventoryType;
+
+    // expire time and id of every auction, Update() only visits the ones that are due
+    std::set<std::pair<time_t, uint32>> _auctionsByExpireTime;
 };
 
 class AuctionHouseMgr
@@ -178,7 +195,7 @@ private:
     ~AuctionHouseMgr();
 
 public:
-    typedef std::unordered_map<ObjectGuid, Item*> ItemMap;
+    typedef Acore::FlatHashMap<ObjectGuid, Item*> ItemMap;
 
     static AuctionHouseMgr* instance();
 
@@ -216,12 +233,21 @@ public:
 
     void Update();
 
+    /// Held shared by the auction listing threads while they search, the world thread takes it
+    /// exclusively to add or remove auctions and auction items
+    std::shared_mutex& GetListingLock() { return _listingLock; }
+
+    /// return: estimated bytes of the auctions of all houses and of the auctioned items
+    [[nodiscard]] std::size_t GetMemoryUsage() const;
+
 private:
     AuctionHouseObject _hordeAuctions;
     AuctionHouseObject _allianceAuctions;
     AuctionHouseObject _neutralAuctions;
 
     ItemMap _mAitems;
+
+    std::shared_mutex _listingLock;
 };
 
 #define sAuctionMgr AuctionHouseMgr::instance()
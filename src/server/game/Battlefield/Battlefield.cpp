@@ -26,6 +26,7 @@
 #include "GroupMgr.h"
 #include "Map.h"
 #include "MapMgr.h"
+#include "Metric.h"
 #include "MiscPackets.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -141,22 +142,28 @@ void Battlefield::HandlePlayerLeaveZone(Player* player, uint32 /*zone*/)
 
 bool Battlefield::Update(uint32 diff)
 {
-    if (m_Timer <= diff)
+    std::string const battleId = std::to_string(m_BattleId);
+
     {
-        if (!IsEnabled() || (!IsWarTime() && sWorld->GetActiveSessionCount() > 3500)) // if WG is disabled or there is more than 3500 connections, switch automaticly
+        METRIC_TIMER("battlefield_update_time", METRIC_TAG("battlefield", battleId), METRIC_TAG("phase", "battle_timer"));
+
+        if (m_Timer <= diff)
         {
-            m_isActive = true;
-            EndBattle(false);
-            return false;
+            if (!IsEnabled() || (!IsWarTime() && sWorld->GetActiveSessionCount() > 3500)) // if WG is disabled or there is more than 3500 connections, switch automaticly
+            {
+                m_isActive = true;
+                EndBattle(false);
+                return false;
+            }
+            // Battlefield ends on time
+            if (IsWarTime())
+                EndBattle(true);
+            else // Time to start a new battle!
+                StartBattle();
         }
-        // Battlefield ends on time
-        if (IsWarTime())
-            EndBattle(true);
-        else // Time to start a new battle!
-            StartBattle();
+        else
+            m_Timer -= diff;
     }
-    else
-        m_Timer -= diff;
 
     if (!IsEnabled())
         return false;
@@ -164,6 +171,8 @@ bool Battlefield::Update(uint32 diff)
     // Invite players a few minutes before the battle's beginning
     if (!IsWarTime() && !m_StartGrouping && m_Timer <= m_StartGroupingTimer)
     {
+        METRIC_TIMER("battlefield_update_time", METRIC_TAG("battlefield", battleId), METRIC_TAG("phase", "grouping"));
+
         m_StartGrouping = true;
         InvitePlayersInZoneToQueue();
         OnStartGrouping();
@@ -172,33 +181,39 @@ bool Battlefield::Update(uint32 diff)
     bool objective_changed = false;
     if (IsWarTime())
     {
-        if (m_uiKickAfkPlayersTimer <= diff)
         {
-            m_uiKickAfkPlayersTimer = 20000;
-            KickAfkPlayers();
-        }
-        else
-            m_uiKickAfkPlayersTimer -= diff;
+            METRIC_TIMER("battlefield_update_time", METRIC_TAG("battlefield", battleId), METRIC_TAG("phase", "kick_timers"));
 
-        // Kick players who chose not to accept invitation to the battle
-        if (m_uiKickDontAcceptTimer <= diff)
-        {
-            time_t now = GameTime::GetGameTime().count();
-            for (int team = 0; team < 2; team++)
-                for (PlayerTimerMap::iterator itr = m_InvitedPlayers[team].begin(); itr != m_InvitedPlayers[team].end(); ++itr)
-                    if (itr->second <= now)
-                        KickPlayerFromBattlefield(itr->first);
-
-            InvitePlayersInZoneToWar();
-            for (int team = 0; team < 2; team++)
-                for (PlayerTimerMap::iterator itr = m_PlayersWillBeKick[team].begin(); itr != m_PlayersWillBeKick[team].end(); ++itr)
-                    if (itr->second <= now)
-                        KickPlayerFromBattlefield(itr->first);
-
-            m_uiKickDontAcceptTimer = 5000;
+            if (m_uiKickAfkPlayersTimer <= diff)
+            {
+                m_uiKickAfkPlayersTimer = 20000;
+                KickAfkPlayers();
+            }
+            else
+                m_uiKickAfkPlayersTimer -= diff;
+
+            // Kick players who chose not to accept invitation to the battle
+            if (m_uiKickDontAcceptTimer <= diff)
+            {
+                time_t now = GameTime::GetGameTime().count();
+                for (int team = 0; team < 2; team++)
+                    for (PlayerTimerMap::iterator itr = m_InvitedPlayers[team].begin(); itr != m_InvitedPlayers[team].end(); ++itr)
+                        if (itr->second <= now)
+                            QueuePlayerAction(itr->first, BF_PLAYER_ACTION_KICK);
+
+                InvitePlayersInZoneToWar();
+                for (int team = 0; team < 2; team++)
+                    for (PlayerTimerMap::iterator itr = m_PlayersWillBeKick[team].begin(); itr != m_PlayersWillBeKick[team].end(); ++itr)
+                        if (itr->second <= now)
+                            QueuePlayerAction(itr->first, BF_PLAYER_ACTION_KICK);
+
+                m_uiKickDontAcceptTimer = 5000;
+            }
+            else
+                m_uiKickDontAcceptTimer -= diff;
         }
-        else
-            m_uiKickDontAcceptTimer -= diff;
+
+        METRIC_TIMER("battlefield_update_time", METRIC_TAG("battlefield", battleId), METRIC_TAG("phase", "capture_points"));
 
         for (BfCapturePointVector::iterator itr = m_capturePoints.begin(); itr != m_capturePoints.end(); ++itr)
             if ((*itr)->Update(diff))
@@ -207,6 +222,8 @@ bool Battlefield::Update(uint32 diff)
 
     if (m_LastResurectTimer <= diff)
     {
+        METRIC_TIMER("battlefield_update_time", METRIC_TAG("battlefield", battleId), METRIC_TAG("phase", "resurrect"));
+
         for (uint8 i = 0; i < m_GraveyardList.size(); i++)
             if (GetGraveyardById(i))
                 m_GraveyardList[i]->Resurrect();
@@ -218,12 +235,75 @@ bool Battlefield::Update(uint32 diff)
     return objective_changed;
 }
 
+void Battlefield::QueuePlayerAction(ObjectGuid guid, BattlefieldPlayerAction action)
+{
+    m_PlayerActions.emplace_back(guid, action);
+}
+
+void Battlefield::ProcessPlayerActions()
+{
+    if (m_PlayerActions.empty())
+        return;
+
+    METRIC_TIMER("battlefield_update_time", METRIC_TAG("battlefield", std::to_string(m_BattleId)), METRIC_TAG("phase", "player_actions"));
+
+    for (uint32 count = 0; count < BATTLEFIELD_PLAYER_ACTIONS_PER_TICK && !m_PlayerActions.empty(); ++count)
+    {
+        auto [guid, action] = m_PlayerActions.front();
+        m_PlayerActions.pop_front();
+
+        // the player may have logged out or left the zone since the action was queued
+        Player* player = ObjectAccessor::FindPlayer(guid);
+        if (!player || (action != BF_PLAYER_ACTION_INVITE_QUEUED_TO_WAR && !HasPlayer(player)))
+            continue;
+
+        switch (action)
+        {
+            case BF_PLAYER_ACTION_INVITE_TO_QUEUE:
+                if (!IsWarTime())
+                    InvitePlayerToQueue(player);
+                break;
+            case BF_PLAYER_ACTION_INVITE_TO_WAR:
+                if (IsWarTime())
+                    InviteZonePlayerToWar(player);
+                break;
+            case BF_PLAYER_ACTION_INVITE_QUEUED_TO_WAR:
+                if (IsWarTime() && m_PlayersInWar[player->GetTeamId()].size() + m_InvitedPlayers[player->GetTeamId()].size() < m_MaxPlayer)
+                    InvitePlayerToWar(player);
+                break;
+            case BF_PLAYER_ACTION_KICK:
+                // the invitation may have been accepted while the kick was queued
+                if (IsKickDue(player))
+                    KickPlayerFromBattlefield(guid);
+                break;
+            case BF_PLAYER_ACTION_KICK_AFK:
+                if (IsWarTime() && player->isAFK() && player->GetZoneId() == GetZoneId() && !player->IsGameMaster())
+                    player->TeleportTo(KickPosition);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+bool Battlefield::IsKickDue(Player const* player) const
+{
+    time_t now = GameTime::GetGameTime().count();
+    TeamId teamId = player->GetTeamId();
+
+    PlayerTimerMap::const_iterator itr = m_InvitedPlayers[teamId].find(player->GetGUID());
+    if (itr != m_InvitedPlayers[teamId].end() && itr->second <= now)
+        return true;
+
+    itr = m_PlayersWillBeKick[teamId].find(player->GetGUID());
+    return itr != m_PlayersWillBeKick[teamId].end() && itr->second <= now;
+}
+
 void Battlefield::InvitePlayersInZoneToQueue()
 {
     for (uint8 team = 0; team < 2; ++team)
         for (GuidUnorderedSet::const_iterator itr = m_players[team].begin(); itr != m_players[team].end(); ++itr)
-            if (Player* player = ObjectAccessor::FindPlayer(*itr))
-                InvitePlayerToQueue(player);
+            QueuePlayerAction(*itr, BF_PLAYER_ACTION_INVITE_TO_QUEUE);
 }
 
 void Battlefield::InvitePlayerToQueue(Player* player)
@@ -239,38 +319,32 @@ void Battlefield::InvitePlayersInQueueToWar()
 {
     for (uint8 team = 0; team < PVP_TEAMS_COUNT; ++team)
     {
-        GuidUnorderedSet copy(m_PlayersInQueue[team]);
-        for (GuidUnorderedSet::const_iterator itr = copy.begin(); itr != copy.end(); ++itr)
-        {
-            if (Player* player = ObjectAccessor::FindPlayer(*itr))
-            {
-                if (m_PlayersInWar[player->GetTeamId()].size() + m_InvitedPlayers[player->GetTeamId()].size() < m_MaxPlayer)
-                    InvitePlayerToWar(player);
-                else
-                {
-                    //Full
-                }
-            }
-        }
+        // players that do not fit anymore when their turn comes are not invited
+        for (GuidUnorderedSet::const_iterator itr = m_PlayersInQueue[team].begin(); itr != m_PlayersInQueue[team].end(); ++itr)
+            QueuePlayerAction(*itr, BF_PLAYER_ACTION_INVITE_QUEUED_TO_WAR);
+
         m_PlayersInQueue[team].clear();
     }
 }
 
 void Battlefield::InvitePlayersInZoneToWar()
 {
+    // only players not yet taking part are queued, the invitations themselves are spread over the next ticks
     for (uint8 team = 0; team < PVP_TEAMS_COUNT; ++team)
         for (GuidUnorderedSet::const_iterator itr = m_players[team].begin(); itr != m_players[team].end(); ++itr)
-        {
-            if (Player* player = ObjectAccessor::FindPlayer(*itr))
-            {
-                if (m_PlayersInWar[player->GetTeamId()].count(player->GetGUID()) || m_InvitedPlayers[player->GetTeamId()].count(player->GetGUID()))
-                    continue;
-                if (m_PlayersInWar[player->GetTeamId()].size() + m_InvitedPlayers[player->GetTeamId()].size() < m_MaxPlayer)
-                    InvitePlayerToWar(player);
-                else if (m_PlayersWillBeKick[player->GetTeamId()].count(player->GetGUID()) == 0)// Battlefield is full of players
-                    m_PlayersWillBeKick[player->GetTeamId()][player->GetGUID()] = GameTime::GetGameTime().count() + 10;
-            }
-        }
+            if (!m_PlayersInWar[team].count(*itr) && !m_InvitedPlayers[team].count(*itr))
+                QueuePlayerAction(*itr, BF_PLAYER_ACTION_INVITE_TO_WAR);
+}
+
+void Battlefield::InviteZonePlayerToWar(Player* player)
+{
+    if (m_PlayersInWar[player->GetTeamId()].count(player->GetGUID()) || m_InvitedPlayers[player->GetTeamId()].count(player->GetGUID()))
+        return;
+
+    if (m_PlayersInWar[player->GetTeamId()].size() + m_InvitedPlayers[player->GetTeamId()].size() < m_MaxPlayer)
+        InvitePlayerToWar(player);
+    else if (m_PlayersWillBeKick[player->GetTeamId()].count(player->GetGUID()) == 0)// Battlefield is full of players
+        m_PlayersWillBeKick[player->GetTeamId()][player->GetGUID()] = GameTime::GetGameTime().count() + 10;
 }
 
 void Battlefield::InvitePlayerToWar(Player* player)
@@ -316,11 +390,12 @@ void Battlefield::InitStalker(uint32 entry, float x, float y, float z, float o)
 void Battlefield::KickAfkPlayers()
 {
     // xinef: optimization, dont lookup player twice
+    // the teleports are spread over the next ticks by ProcessPlayerActions()
     for (uint8 team = 0; team < PVP_TEAMS_COUNT; ++team)
         for (GuidUnorderedSet::const_iterator itr = m_PlayersInWar[team].begin(); itr != m_PlayersInWar[team].end(); ++itr)
             if (Player* player = ObjectAccessor::FindPlayer(*itr))
                 if (player->isAFK() && player->GetZoneId() == GetZoneId() && !player->IsGameMaster())
-                    player->TeleportTo(KickPosition);
+                    QueuePlayerAction(*itr, BF_PLAYER_ACTION_KICK_AFK);
 }
 
 void Battlefield::KickPlayerFromBattlefield(ObjectGuid guid)
@@ -478,10 +553,21 @@ void Battlefield::SendWarning(uint8 id, WorldObject const* target /*= nullptr*/)
 
 void Battlefield::SendUpdateWorldState(uint32 field, uint32 value)
 {
-    for (uint8 i = 0; i < PVP_TEAMS_COUNT; ++i)
-        for (GuidUnorderedSet::iterator itr = m_players[i].begin(); itr != m_players[i].end(); ++itr)
-            if (Player* player = ObjectAccessor::FindPlayer(*itr))
-                player->SendUpdateWorldState(field, value);
+    m_pendingWorldStates.Set(field, value);
+}
+
+void Battlefield::SendPendingWorldStates()
+{
+    if (m_pendingWorldStates.IsEmpty())
+        return;
+
+    m_pendingWorldStates.Flush([this](WorldPacket const* packet)
+    {
+        for (uint8 i = 0; i < PVP_TEAMS_COUNT; ++i)
+            for (GuidUnorderedSet::iterator itr = m_players[i].begin(); itr != m_players[i].end(); ++itr)
+                if (Player* player = ObjectAccessor::FindPlayer(*itr))
+                    player->SendDirectMessage(packet);
+    });
 }
 
 void Battlefield::RegisterZone(uint32 zoneId)
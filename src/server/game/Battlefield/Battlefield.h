@@ -25,6 +25,7 @@
 #include "Utilities/Util.h"
 #include "WorldPacket.h"
 #include "ZoneScript.h"
+#include <deque>
 
 enum BattlefieldTypes
 {
@@ -56,6 +57,17 @@ enum BattlefieldSounds
 };
 
 constexpr auto BATTLEFIELD_OBJECTIVE_UPDATE_INTERVAL = 1000;
+constexpr auto BATTLEFIELD_PLAYER_ACTIONS_PER_TICK = 20;    // invitations and kicks handled per world tick
+
+// Work on zone players queued by the periodic updates, see Battlefield::ProcessPlayerActions()
+enum BattlefieldPlayerAction : uint8
+{
+    BF_PLAYER_ACTION_INVITE_TO_QUEUE,
+    BF_PLAYER_ACTION_INVITE_TO_WAR,
+    BF_PLAYER_ACTION_INVITE_QUEUED_TO_WAR,  // player accepted the queue invitation, may have left the zone since
+    BF_PLAYER_ACTION_KICK,                  // invitation not accepted in time or battle full
+    BF_PLAYER_ACTION_KICK_AFK
+};
 
 const uint32 BattlefieldFactions[PVP_TEAMS_COUNT] =
 {
@@ -218,8 +230,10 @@ public:
     /// Call this to init the Battlefield
     virtual bool SetupBattlefield() { return true; }
 
-    /// Update data of a worldstate to all players present in zone
+    /// Update data of a worldstate to all players present in zone, sent at the end of the tick
     void SendUpdateWorldState(uint32 field, uint32 value);
+    /// Sends the worldstates changed since the last call to all players present in zone
+    void SendPendingWorldStates();
 
     /**
      * \brief Called every time for update bf data and time
@@ -237,6 +251,12 @@ public:
     /// Invite all players in zone to join battle on battle start
     void InvitePlayersInZoneToWar();
 
+    /**
+     * \brief Runs up to BATTLEFIELD_PLAYER_ACTIONS_PER_TICK of the queued invitations and kicks,
+     * called by BattlefieldMgr every world tick so the war start of a full zone is spread over several ticks
+     */
+    void ProcessPlayerActions();
+
     /// Called when a Unit is kill in battlefield zone
     virtual void HandleKill(Player* /*killer*/, Unit* /*killed*/) {};
 
@@ -373,6 +393,7 @@ protected:
 
     // Players info maps
     GuidUnorderedSet m_players[PVP_TEAMS_COUNT];             // Players in zone
+    WorldStateBatch m_pendingWorldStates;                    // SendUpdateWorldState() changes not sent yet
     GuidUnorderedSet m_PlayersInQueue[PVP_TEAMS_COUNT];      // Players in the queue
     GuidUnorderedSet m_PlayersInWar[PVP_TEAMS_COUNT];        // Players in WG combat
     PlayerTimerMap m_InvitedPlayers[PVP_TEAMS_COUNT];
@@ -408,8 +429,14 @@ protected:
     std::vector<uint64> m_Data64;
     std::vector<uint32> m_Data32;
 
+    std::deque<std::pair<ObjectGuid, BattlefieldPlayerAction>> m_PlayerActions;   // invitations and kicks waiting for ProcessPlayerActions()
+
     void KickAfkPlayers();
 
+    void QueuePlayerAction(ObjectGuid guid, BattlefieldPlayerAction action);
+    void InviteZonePlayerToWar(Player* player);
+    bool IsKickDue(Player const* player) const;
+
     // use for switch off all worldstate for client
     virtual void SendRemoveWorldStates(Player* /*player*/) {}
 
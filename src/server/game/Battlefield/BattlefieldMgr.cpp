@@ -16,6 +16,7 @@
  */
 
 #include "BattlefieldMgr.h"
+#include "Metric.h"
 #include "Player.h"
 #include "Zones/BattlefieldWG.h"
 
@@ -136,10 +137,22 @@ void BattlefieldMgr::Update(uint32 diff)
     if (m_UpdateTimer > BATTLEFIELD_OBJECTIVE_UPDATE_INTERVAL)
     {
         for (BattlefieldSet::iterator itr = m_BattlefieldSet.begin(); itr != m_BattlefieldSet.end(); ++itr)
+        {
+            // the phases of Battlefield::Update are reported separately, this includes the zone script
+            METRIC_TIMER("battlefield_update_time", METRIC_TAG("battlefield", std::to_string((*itr)->GetBattleId())), METRIC_TAG("phase", "total"));
+
             //if ((*itr)->IsEnabled())
             (*itr)->Update(m_UpdateTimer);
+        }
         m_UpdateTimer = 0;
     }
+
+    // changes made by map updates and by the objective update above, once per world tick
+    for (Battlefield* battlefield : m_BattlefieldSet)
+    {
+        battlefield->ProcessPlayerActions();
+        battlefield->SendPendingWorldStates();
+    }
 }
 
 ZoneScript* BattlefieldMgr::GetZoneScript(uint32 zoneId)
@@ -769,10 +769,15 @@ uint32 Battleground::GetRealRepFactionForPlayer(uint32 factionId, Player* player
 
 void Battleground::UpdateWorldState(uint32 variable, uint32 value)
 {
-    WorldPackets::WorldState::UpdateWorldState worldstate;
-    worldstate.VariableID = variable;
-    worldstate.Value = value;
-    SendPacketToAll(worldstate.Write());
+    _pendingWorldStates.Set(variable, value);
+}
+
+void Battleground::SendPendingWorldStates()
+{
+    if (_pendingWorldStates.IsEmpty())
+        return;
+
+    _pendingWorldStates.Flush([this](WorldPacket const* packet) { SendPacketToAll(packet); });
 }
 
 void Battleground::EndBattleground(PvPTeamId winnerTeamId)
@@ -1293,12 +1298,39 @@ bool Battleground::HasFreeSlots() const
     return false;
 }
 
-void Battleground::SpectatorsSendPacket(WorldPacket& data)
+void Battleground::SpectatorsSendPacket(WorldPacket const& data) const
 {
     for (SpectatorList::const_iterator itr = m_Spectators.begin(); itr != m_Spectators.end(); ++itr)
         (*itr)->GetSession()->SendPacket(&data);
 }
 
+void Battleground::SpectatorsQueueValue(ObjectGuid guid, char const* field, uint32 value)
+{
+    for (SpectatorValue& queued : _spectatorValues)
+    {
+        if (queued.Guid == guid && !strcmp(queued.Field, field))
+        {
+            queued.Value = value;
+            return;
+        }
+    }
+
+    _spectatorValues.push_back({ guid, field, value });
+}
+
+void Battleground::SpectatorsSendQueuedValues()
+{
+    if (_spectatorValues.empty())
+        return;
+
+    // every value is formatted once and the packet shared by all spectators
+    if (GetStatus() == STATUS_IN_PROGRESS && HaveSpectators())
+        for (SpectatorValue const& queued : _spectatorValues)
+            ArenaSpectator::SendCommand_UInt32Value(this, queued.Guid, queued.Field, queued.Value);
+
+    _spectatorValues.clear();
+}
+
 void Battleground::ReadyMarkerClicked(Player* p)
 {
     if (!isArena() || GetStatus() >= STATUS_IN_PROGRESS || GetStartDelayTime() <= BG_START_DELAY_15S || (m_Events & BG_STARTING_EVENT_3) || p->IsSpectator())
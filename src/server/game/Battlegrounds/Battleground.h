@@ -23,6 +23,7 @@
 #include "DBCEnums.h"
 #include "GameObject.h"
 #include "SharedDefines.h"
+#include "WorldStateBatch.h"
 
 class Creature;
 class GameObject;
@@ -391,7 +392,10 @@ public:
     [[nodiscard]] const SpectatorList& GetSpectators() const { return m_Spectators; }
     void AddToBeTeleported(ObjectGuid spectator, ObjectGuid participant) { m_ToBeTeleported[spectator] = participant; }
     void RemoveToBeTeleported(ObjectGuid spectator) { ToBeTeleportedMap::iterator itr = m_ToBeTeleported.find(spectator); if (itr != m_ToBeTeleported.end()) m_ToBeTeleported.erase(itr); }
-    void SpectatorsSendPacket(WorldPacket& data);
+    void SpectatorsSendPacket(WorldPacket const& data) const;
+    // coalesced per field, only the last value of a tick is sent by SpectatorsSendQueuedValues()
+    void SpectatorsQueueValue(ObjectGuid guid, char const* field, uint32 value);
+    void SpectatorsSendQueuedValues();
 
     [[nodiscard]] bool isArena() const        { return m_IsArena; }
     [[nodiscard]] bool isBattleground() const { return !m_IsArena; }
@@ -458,7 +462,9 @@ public:
     void RewardReputationToTeam(uint32 factionId, uint32 reputation, TeamId teamId);
     uint32 GetRealRepFactionForPlayer(uint32 factionId, Player* player);
 
+    // queued and sent to all players by SendPendingWorldStates() at the end of the tick
     void UpdateWorldState(uint32 variable, uint32 value);
+    void SendPendingWorldStates();
 
     void EndBattleground(PvPTeamId winnerTeamId);
 
@@ -667,6 +673,16 @@ private:
     bool   m_PrematureCountDown;
     uint32 m_PrematureCountDownTimer;
     std::string m_Name{};
+    WorldStateBatch _pendingWorldStates;                // UpdateWorldState() changes not sent yet
+
+    struct SpectatorValue
+    {
+        ObjectGuid Guid;
+        char const* Field;
+        uint32 Value;
+    };
+
+    std::vector<SpectatorValue> _spectatorValues;       // arena spectator health and power updates not sent yet
 
     /* Pre- and post-update hooks */
 
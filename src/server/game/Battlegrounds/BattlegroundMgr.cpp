@@ -110,6 +110,9 @@ void BattlegroundMgr::Update(uint32 diff)
             Battleground* bg = itrDelete->second;
 
             bg->Update(diff);
+            bg->SendPendingWorldStates();
+            bg->SpectatorsSendQueuedValues();
+
             if (bg->ToBeDeleted())
             {
                 itrDelete->second = nullptr;
@@ -134,7 +137,7 @@ void BattlegroundMgr::Update(uint32 diff)
         std::vector<uint64> scheduled;
         std::swap(scheduled, m_QueueUpdateScheduler);
 
-        for (uint8 i = 0; i < scheduled.size(); i++)
+        for (std::size_t i = 0; i < scheduled.size(); i++)
         {
             uint32 arenaMMRating = scheduled[i] >> 32;
             uint8 arenaType = scheduled[i] >> 24 & 255;
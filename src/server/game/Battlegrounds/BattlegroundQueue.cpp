@@ -189,7 +189,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player* leader, Group* group, Battle
     }
 
     //add GroupInfo to m_QueuedGroups
-    m_QueuedGroups[bracketId][index].push_back(ginfo);
+    ginfo->QueueIterator = m_QueuedGroups[bracketId][index].insert(m_QueuedGroups[bracketId][index].end(), ginfo);
 
     // announce world (this doesn't need mutex)
     SendJoinMessageArenaQueue(leader, ginfo, bracketEntry, isRated);
@@ -280,23 +280,7 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     uint32 _bracketId = groupInfo->BracketId;
     uint32 _groupType = groupInfo->GroupType;
 
-    // find iterator
-    auto group_itr = m_QueuedGroups[_bracketId][_groupType].end();
-
-    for (auto k = m_QueuedGroups[_bracketId][_groupType].begin(); k != m_QueuedGroups[_bracketId][_groupType].end(); k++)
-        if ((*k) == groupInfo)
-        {
-            group_itr = k;
-            break;
-        }
-
-    // player can't be in queue without group, but just in case
-    if (group_itr == m_QueuedGroups[_bracketId][_groupType].end())
-    {
-        LOG_ERROR("bg.battleground", "BattlegroundQueue: ERROR Cannot find groupinfo for {}", guid.ToString());
-        //ABORT("BattlegroundQueue: ERROR Cannot find groupinfo for {}", guid.ToString());
-        return;
-    }
+    auto group_itr = groupInfo->QueueIterator;
 
     LOG_DEBUG("bg.battleground", "BattlegroundQueue: Removing {}, from bracket_id {}", guid.ToString(), _bracketId);
 
@@ -367,6 +351,15 @@ void BattlegroundQueue::AddEvent(BasicEvent* Event, uint64 e_time)
     m_events.AddEvent(Event, m_events.CalculateTime(e_time));
 }
 
+void BattlegroundQueue::MoveGroupToFront(GroupQueueInfo* ginfo, uint8 groupType)
+{
+    GroupsQueueType& from = m_QueuedGroups[ginfo->BracketId][ginfo->GroupType];
+    GroupsQueueType& to = m_QueuedGroups[ginfo->BracketId][groupType];
+
+    to.splice(to.begin(), from, ginfo->QueueIterator);
+    ginfo->GroupType = groupType; // pussywizard: update GroupQueueInfo internal variable
+}
+
 bool BattlegroundQueue::IsPlayerInvitedToRatedArena(ObjectGuid pl_guid)
 {
     auto qItr = m_QueuedPlayers.find(pl_guid);
@@ -555,13 +548,11 @@ bool BattlegroundQueue::CheckPremadeMatch(BattlegroundBracketId bracket_id, uint
     {
         if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].empty())
         {
-            GroupsQueueType::iterator itr = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].begin();
-            if (!(*itr)->IsInvitedToBGInstanceGUID && ((*itr)->JoinTime < time_before || (*itr)->Players.size() < MinPlayersPerTeam))
+            GroupQueueInfo* ginfo = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].front();
+            if (!ginfo->IsInvitedToBGInstanceGUID && (ginfo->JoinTime < time_before || ginfo->Players.size() < MinPlayersPerTeam))
             {
-                //we must insert group to normal queue and erase pointer from premade queue
-                (*itr)->GroupType = BG_QUEUE_NORMAL_ALLIANCE + i; // pussywizard: update GroupQueueInfo internal variable
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + i].push_front((*itr));
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE + i].erase(itr);
+                //we must move group from premade queue to normal queue
+                MoveGroupToFront(ginfo, BG_QUEUE_NORMAL_ALLIANCE + i);
             }
         }
     }
@@ -648,14 +639,11 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     GroupQueueInfo* ginfo = m_SelectionPools[teamIndex].SelectedGroups.back();
 
     //set itr_team to group that was added to selection pool latest
-    GroupsQueueType::iterator itr_team = m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + static_cast<uint8>(teamIndex)].begin();
-    for (; itr_team != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + static_cast<uint8>(teamIndex)].end(); ++itr_team)
-        if (ginfo == *itr_team)
-            break;
-
-    if (itr_team == m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + static_cast<uint8>(teamIndex)].end())
+    if (ginfo->BracketId != bracket_id || ginfo->GroupType != BG_QUEUE_NORMAL_ALLIANCE + static_cast<uint8>(teamIndex))
         return false;
 
+    GroupsQueueType::iterator itr_team = ginfo->QueueIterator;
+
     GroupsQueueType::iterator itr_team2 = itr_team;
     ++itr_team2;
 
@@ -673,25 +661,9 @@ bool BattlegroundQueue::CheckSkirmishForSameFaction(BattlegroundBracketId bracke
     //here we have correct 2 selections and we need to change one teams team and move selection pool teams to other team's queue
     for (GroupsQueueType::iterator itr = m_SelectionPools[otherTeam].SelectedGroups.begin(); itr != m_SelectionPools[otherTeam].SelectedGroups.end(); ++itr)
     {
-        //set correct team
+        //set correct team and move team to other queue
         (*itr)->teamId = otherTeam;
-        (*itr)->GroupType = static_cast<uint8>(BG_QUEUE_NORMAL_ALLIANCE) + static_cast<uint8>(otherTeam);
-
-        //add team to other queue
-        m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + static_cast<uint8>(otherTeam)].push_front(*itr);
-
-        //remove team from old queue
-        GroupsQueueType::iterator itr2 = itr_team;
-        ++itr2;
-
-        for (; itr2 != m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + static_cast<uint8>(teamIndex)].end(); ++itr2)
-        {
-            if (*itr2 == *itr)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_NORMAL_ALLIANCE + static_cast<uint8>(teamIndex)].erase(itr2);
-                break;
-            }
-        }
+        MoveGroupToFront(*itr, static_cast<uint8>(BG_QUEUE_NORMAL_ALLIANCE) + static_cast<uint8>(otherTeam));
     }
 
     return true;
@@ -927,18 +899,10 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 diff, BattlegroundTypeId
 
             // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
             if (aTeam->teamId != TEAM_ALLIANCE)
-            {
-                aTeam->GroupType = BG_QUEUE_PREMADE_ALLIANCE;
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-            }
+                MoveGroupToFront(aTeam, BG_QUEUE_PREMADE_ALLIANCE);
 
             if (hTeam->teamId != TEAM_HORDE)
-            {
-                hTeam->GroupType = BG_QUEUE_PREMADE_HORDE;
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-            }
+                MoveGroupToFront(hTeam, BG_QUEUE_PREMADE_HORDE);
 
             arena->SetArenaMatchmakerRating(TEAM_ALLIANCE, aTeam->ArenaMatchmakerRating);
             arena->SetArenaMatchmakerRating(TEAM_HORDE, hTeam->ArenaMatchmakerRating);
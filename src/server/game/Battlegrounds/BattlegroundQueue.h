@@ -24,9 +24,15 @@
 #include "EventProcessor.h"
 #include <array>
 #include <deque>
+#include <list>
 
 constexpr auto COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME = 10;
 
+struct GroupQueueInfo;
+
+//do NOT use deque because deque.erase() invalidates ALL iterators
+typedef std::list<GroupQueueInfo*> GroupsQueueType;
+
 struct GroupQueueInfo                                       // stores information about the group in queue (also used when joined as solo!)
 {
     GuidSet Players;                                        // player guid set
@@ -46,6 +52,7 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  PreviousOpponentsTeamId;                        // excluded from the current queue until the timer is met
     uint8   BracketId;                                      // BattlegroundBracketId
     uint8   GroupType;                                      // BattlegroundQueueGroupTypes
+    GroupsQueueType::iterator QueueIterator;                // position in m_QueuedGroups[BracketId][GroupType], list splices keep it valid
 };
 
 enum BattlegroundQueueGroupTypes
@@ -90,11 +97,13 @@ public:
 
     void AddEvent(BasicEvent* Event, uint64 e_time);
 
+    // moves a queued group to the front of another group type queue of its bracket
+    void MoveGroupToFront(GroupQueueInfo* ginfo, uint8 groupType);
+
     typedef std::map<ObjectGuid, GroupQueueInfo*> QueuedPlayersMap;
     QueuedPlayersMap m_QueuedPlayers;
 
-    //do NOT use deque because deque.erase() invalidates ALL iterators
-    typedef std::list<GroupQueueInfo*> GroupsQueueType;
+    typedef ::GroupsQueueType GroupsQueueType;
 
     /*
     This two dimensional array is used to store All queued groups
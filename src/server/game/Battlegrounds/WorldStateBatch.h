@@ -0,0 +1,68 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WorldStateBatch_h__
+#define WorldStateBatch_h__
+
+#include "WorldStatePackets.h"
+#include <vector>
+
+/*
+ * World state changes of a battleground, battlefield or outdoor pvp zone, collected
+ * during a tick and sent once at its end. A variable changed several times in the
+ * same tick is only sent with its last value.
+ */
+class WorldStateBatch
+{
+public:
+    void Set(uint32 variable, uint32 value)
+    {
+        for (WorldPackets::WorldState::InitWorldStates::WorldStateInfo& state : _states)
+        {
+            if (state.VariableID == int32(variable))
+            {
+                state.Value = int32(value);
+                return;
+            }
+        }
+
+        _states.emplace_back(int32(variable), int32(value));
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return _states.empty(); }
+
+    // Builds one packet per changed variable and hands it to send(WorldPacket const*)
+    template<class Sender>
+    void Flush(Sender&& send)
+    {
+        for (WorldPackets::WorldState::InitWorldStates::WorldStateInfo const& state : _states)
+        {
+            WorldPackets::WorldState::UpdateWorldState worldstate;
+            worldstate.VariableID = state.VariableID;
+            worldstate.Value = state.Value;
+            send(worldstate.Write());
+        }
+
+        _states.clear();
+    }
+
+private:
+    // kept in the order of the first change, tick batches hold a handful of states
+    std::vector<WorldPackets::WorldState::InitWorldStates::WorldStateInfo> _states;
+};
+
+#endif // WorldStateBatch_h__
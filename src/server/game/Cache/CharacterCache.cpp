@@ -18,16 +18,45 @@
 #include "CharacterCache.h"
 #include "ArenaTeam.h"
 #include "DatabaseEnv.h"
+#include "FlatHashContainers.h"
 #include "Log.h"
 #include "Player.h"
 #include "Timer.h"
 #include "World.h"
-#include <unordered_map>
+#include <deque>
+#include <string_view>
 
 namespace
 {
-    std::unordered_map<ObjectGuid, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+    // Entries never move, the pointers handed out and the name keys below stay valid until the entry is deleted.
+    // Slots of deleted characters are reused by the next added one.
+    std::deque<CharacterCacheEntry> _characterCacheStore;
+    std::vector<uint32> _freeCharacterCacheSlots;
+    Acore::FlatHashMap<ObjectGuid::LowType, uint32> _characterCacheSlotByGuid;
+    // keys view the name stored in the entry they point to
+    Acore::FlatHashMap<std::string_view, uint32> _characterCacheSlotByName;
+
+    CharacterCacheEntry* FindCharacterCacheEntry(ObjectGuid const& guid)
+    {
+        if (!guid.IsPlayer())
+            return nullptr;
+
+        auto itr = _characterCacheSlotByGuid.find(guid.GetCounter());
+        return itr != _characterCacheSlotByGuid.end() ? &_characterCacheStore[itr->second] : nullptr;
+    }
+
+    CharacterCacheEntry* FindCharacterCacheEntry(std::string_view name)
+    {
+        auto itr = _characterCacheSlotByName.find(name);
+        return itr != _characterCacheSlotByName.end() ? &_characterCacheStore[itr->second] : nullptr;
+    }
+
+    void RemoveCharacterCacheName(CharacterCacheEntry const& entry, uint32 slot)
+    {
+        auto itr = _characterCacheSlotByName.find(entry.Name);
+        if (itr != _characterCacheSlotByName.end() && itr->second == slot)
+            _characterCacheSlotByName.erase(itr);
+    }
 }
 
 CharacterCache* CharacterCache::instance()
@@ -60,6 +89,9 @@ CharacterCache* CharacterCache::instance()
 void CharacterCache::LoadCharacterCacheStorage()
 {
     _characterCacheStore.clear();
+    _freeCharacterCacheSlots.clear();
+    _characterCacheSlotByGuid.clear();
+    _characterCacheSlotByName.clear();
     uint32 oldMSTime = getMSTime();
 
     QueryResult result = CharacterDatabase.Query("SELECT guid, name, account, race, gender, class, level FROM characters");
@@ -69,6 +101,9 @@ void CharacterCache::LoadCharacterCacheStorage()
         return;
     }
 
+    _characterCacheSlotByGuid.reserve(result->GetRowCount());
+    _characterCacheSlotByName.reserve(result->GetRowCount());
+
     do
     {
         Field* fields = result->Fetch();
@@ -86,7 +121,7 @@ void CharacterCache::LoadCharacterCacheStorage()
         } while (mailCountResult->NextRow());
     }
 
-    LOG_INFO("server.loading", ">> Loaded Character Infos For {} Characters in {} ms", _characterCacheStore.size(), GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", ">> Loaded Character Infos For {} Characters in {} ms", _characterCacheSlotByGuid.size(), GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
 
@@ -121,7 +156,28 @@ Modifying functions
 */
 void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level)
 {
-    CharacterCacheEntry& data = _characterCacheStore[guid];
+    uint32 slot;
+    auto itr = _characterCacheSlotByGuid.find(guid.GetCounter());
+    if (itr != _characterCacheSlotByGuid.end())
+    {
+        slot = itr->second;
+        RemoveCharacterCacheName(_characterCacheStore[slot], slot);
+    }
+    else if (!_freeCharacterCacheSlots.empty())
+    {
+        // deleted entries are reset already
+        slot = _freeCharacterCacheSlots.back();
+        _freeCharacterCacheSlots.pop_back();
+        _characterCacheSlotByGuid[guid.GetCounter()] = slot;
+    }
+    else
+    {
+        slot = uint32(_characterCacheStore.size());
+        _characterCacheStore.emplace_back();
+        _characterCacheSlotByGuid[guid.GetCounter()] = slot;
+    }
+
+    CharacterCacheEntry& data = _characterCacheStore[slot];
     data.Guid = guid;
     data.Name = name;
     data.AccountId = accountId;
@@ -136,156 +192,168 @@ void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accou
     }
 
     // Fill Name to Guid Store
-    _characterCacheByNameStore[name] = &data;
+    _characterCacheSlotByName[data.Name] = slot;
 }
 
-void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name)
+void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& /*name*/)
 {
-    _characterCacheStore.erase(guid);
-    _characterCacheByNameStore.erase(name);
+    auto itr = _characterCacheSlotByGuid.find(guid.GetCounter());
+    if (itr == _characterCacheSlotByGuid.end())
+        return;
+
+    uint32 slot = itr->second;
+    _characterCacheSlotByGuid.erase(itr);
+
+    RemoveCharacterCacheName(_characterCacheStore[slot], slot);
+    _characterCacheStore[slot] = CharacterCacheEntry();
+    _freeCharacterCacheSlots.push_back(slot);
 }
 
 void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string const& name, Optional<uint8> gender /*= {}*/, Optional<uint8> race /*= {}*/)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    auto itr = _characterCacheSlotByGuid.find(guid.GetCounter());
+    if (itr == _characterCacheSlotByGuid.end())
         return;
 
-    std::string oldName = itr->second.Name;
-    itr->second.Name = name;
+    uint32 slot = itr->second;
+    CharacterCacheEntry& data = _characterCacheStore[slot];
+
+    // the name key views the stored name, it has to go before the name changes
+    RemoveCharacterCacheName(data, slot);
+    data.Name = name;
 
     if (gender)
     {
-        itr->second.Sex = *gender;
+        data.Sex = *gender;
     }
 
     if (race)
     {
-        itr->second.Race = *race;
+        data.Race = *race;
     }
 
     //WorldPackets::Misc::InvalidatePlayer packet(guid);
     //sWorld->SendGlobalMessage(packet.Write());
 
-    // Correct name -> pointer storage
-    _characterCacheByNameStore.erase(oldName);
-    _characterCacheByNameStore[name] = &itr->second;
+    // Correct name -> slot storage
+    _characterCacheSlotByName[data.Name] = slot;
 }
 
 void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return;
     }
 
-    itr->second.Level = level;
+    data->Level = level;
 }
 
 void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 accountId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return;
     }
 
-    itr->second.AccountId = accountId;
+    data->AccountId = accountId;
 }
 
 void CharacterCache::UpdateCharacterGuildId(ObjectGuid const& guid, ObjectGuid::LowType guildId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return;
     }
 
-    itr->second.GuildId = guildId;
+    data->GuildId = guildId;
 }
 
 void CharacterCache::UpdateCharacterArenaTeamId(ObjectGuid const& guid, uint8 slot, uint32 arenaTeamId)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return;
     }
 
-    itr->second.ArenaTeamId[slot] = arenaTeamId;
+    data->ArenaTeamId[slot] = arenaTeamId;
 }
 
 void CharacterCache::UpdateCharacterMailCount(ObjectGuid const& guid, int8 count, bool update)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return;
     }
 
     if (update)
     {
-        itr->second.MailCount = count;
+        data->MailCount = count;
         return;
     }
 
     // Let's be safe and prevent overflow
-    if (!itr->second.MailCount && count < 0)
+    if (!data->MailCount && count < 0)
     {
         return;
     }
 
-    itr->second.MailCount += count;
+    data->MailCount += count;
 }
 
 void CharacterCache::UpdateCharacterGroup(ObjectGuid const& guid, ObjectGuid groupGUID)
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return;
     }
 
-    itr->second.GroupGuid = groupGUID;
+    data->GroupGuid = groupGUID;
 }
 
 /*
 Getters
 */
+std::size_t CharacterCache::GetMemoryUsage() const
+{
+    std::size_t size = _characterCacheStore.size() * sizeof(CharacterCacheEntry) + _freeCharacterCacheSlots.capacity() * sizeof(uint32) +
+        _characterCacheSlotByGuid.memory_usage() + _characterCacheSlotByName.memory_usage();
+
+    // names longer than the small string buffer are on the heap
+    std::size_t const inlineCapacity = std::string().capacity();
+    for (CharacterCacheEntry const& entry : _characterCacheStore)
+        if (entry.Name.capacity() > inlineCapacity)
+            size += entry.Name.capacity() + 1;
+
+    return size;
+}
+
 bool CharacterCache::HasCharacterCacheEntry(ObjectGuid const& guid) const
 {
-    return _characterCacheStore.find(guid) != _characterCacheStore.end();
+    return FindCharacterCacheEntry(guid) != nullptr;
 }
 
 CharacterCacheEntry const* CharacterCache::GetCharacterCacheByGuid(ObjectGuid const& guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr != _characterCacheStore.end())
-    {
-        return &itr->second;
-    }
-
-    return nullptr;
+    return FindCharacterCacheEntry(guid);
 }
 
 CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
-    {
-        return itr->second;
-    }
-
-    return nullptr;
+    return FindCharacterCacheEntry(name);
 }
 
 ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
+    if (CharacterCacheEntry const* data = FindCharacterCacheEntry(name))
     {
-        return itr->second->Guid;
+        return data->Guid;
     }
 
     return ObjectGuid::Empty;
@@ -293,44 +361,43 @@ ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
 
 bool CharacterCache::GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return false;
     }
 
-    name = itr->second.Name;
+    name = data->Name;
     return true;
 }
 
 uint32 CharacterCache::GetCharacterTeamByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return 0;
     }
 
-    return Player::TeamIdForRace(itr->second.Race);
+    return Player::TeamIdForRace(data->Race);
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return 0;
     }
 
-    return itr->second.AccountId;
+    return data->AccountId;
 }
 
 uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) const
 {
-    auto itr = _characterCacheByNameStore.find(name);
-    if (itr != _characterCacheByNameStore.end())
+    if (CharacterCacheEntry const* data = FindCharacterCacheEntry(name))
     {
-        return itr->second->AccountId;
+        return data->AccountId;
     }
 
     return 0;
@@ -338,44 +405,44 @@ uint32 CharacterCache::GetCharacterAccountIdByName(std::string const& name) cons
 
 uint8 CharacterCache::GetCharacterLevelByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return 0;
     }
 
-    return itr->second.Level;
+    return data->Level;
 }
 
 ObjectGuid::LowType CharacterCache::GetCharacterGuildIdByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return 0;
     }
 
-    return itr->second.GuildId;
+    return data->GuildId;
 }
 
 uint32 CharacterCache::GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return 0;
     }
 
-    return itr->second.ArenaTeamId[type];
+    return data->ArenaTeamId[type];
 }
 
 ObjectGuid CharacterCache::GetCharacterGroupGuidByGuid(ObjectGuid guid) const
 {
-    auto itr = _characterCacheStore.find(guid);
-    if (itr == _characterCacheStore.end())
+    CharacterCacheEntry const* data = FindCharacterCacheEntry(guid);
+    if (!data)
     {
         return ObjectGuid::Empty;
     }
 
-    return itr->second.GroupGuid;
+    return data->GroupGuid;
 }
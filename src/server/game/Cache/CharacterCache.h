@@ -78,6 +78,9 @@ class AC_GAME_API CharacterCache
         [[nodiscard]] ObjectGuid::LowType GetCharacterGuildIdByGuid(ObjectGuid guid) const;
         [[nodiscard]] uint32 GetCharacterArenaTeamIdByGuid(ObjectGuid guid, uint8 type) const;
         [[nodiscard]] ObjectGuid GetCharacterGroupGuidByGuid(ObjectGuid guid) const;
+
+        /// return: estimated bytes of the cache entries and their indexes
+        [[nodiscard]] std::size_t GetMemoryUsage() const;
 };
 
 #define sCharacterCache CharacterCache::instance()
@@ -16,6 +16,7 @@
  */
 
 #include "WhoListCacheMgr.h"
+#include "DBCStores.h"
 #include "GuildMgr.h"
 #include "ObjectAccessor.h"
 #include "World.h"
@@ -30,6 +31,7 @@ void WhoListCacheMgr::Update()
 {
     // clear current list
     _whoListStorage.clear();
+    _whoListByZone.clear();
     _whoListStorage.reserve(sWorld->GetPlayerCount() + 1);
 
     for (auto const& [guid, player] : ObjectAccessor::GetPlayers())
@@ -58,4 +60,50 @@ void WhoListCacheMgr::Update()
             (player->IsSpectator() ? 4395 /*Dalaran*/ : player->GetZoneId()), player->getGender(), player->IsVisible(),
             widePlayerName, wideGuildName, playerName, guildName);
     }
+
+    // requests usually ask for a level range, keep the list ordered so it is a binary search
+    std::stable_sort(_whoListStorage.begin(), _whoListStorage.end(), [](WhoListPlayerInfo const& left, WhoListPlayerInfo const& right)
+    {
+        return left.GetLevel() < right.GetLevel();
+    });
+
+    for (std::size_t i = 0; i < _whoListStorage.size(); ++i)
+        _whoListByZone[_whoListStorage[i].GetZoneId()].push_back(i);
+}
+
+std::pair<WhoListInfoVector::const_iterator, WhoListInfoVector::const_iterator> WhoListCacheMgr::GetWhoListByLevel(uint32 levelMin, uint32 levelMax) const
+{
+    auto begin = std::lower_bound(_whoListStorage.begin(), _whoListStorage.end(), levelMin, [](WhoListPlayerInfo const& info, uint32 level)
+    {
+        return info.GetLevel() < level;
+    });
+
+    auto end = std::upper_bound(begin, _whoListStorage.end(), levelMax, [](uint32 level, WhoListPlayerInfo const& info)
+    {
+        return level < info.GetLevel();
+    });
+
+    return { begin, end };
+}
+
+std::vector<std::size_t> const* WhoListCacheMgr::GetWhoListByZone(uint32 zoneId) const
+{
+    auto itr = _whoListByZone.find(zoneId);
+    return itr != _whoListByZone.end() ? &itr->second : nullptr;
+}
+
+std::wstring const& WhoListCacheMgr::GetWideAreaName(uint32 zoneId, LocaleConstant locale)
+{
+    uint32 key = (zoneId << 4) | uint32(locale);
+
+    auto itr = _wideAreaNames.find(key);
+    if (itr != _wideAreaNames.end())
+        return itr->second;
+
+    std::wstring& wideAreaName = _wideAreaNames[key];
+    if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(zoneId))
+        if (Utf8toWStr(areaEntry->area_name[locale], wideAreaName))
+            wstrToLower(wideAreaName);
+
+    return wideAreaName;
 }
@@ -21,6 +21,7 @@
 #include "Common.h"
 #include "ObjectGuid.h"
 #include "SharedDefines.h"
+#include <unordered_map>
 
 class WhoListPlayerInfo
 {
@@ -89,8 +90,19 @@ public:
     void Update();
     WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
 
+    /// The who list is ordered by level, returns the entries with a level between levelMin and levelMax
+    std::pair<WhoListInfoVector::const_iterator, WhoListInfoVector::const_iterator> GetWhoListByLevel(uint32 levelMin, uint32 levelMax) const;
+
+    /// Positions in the who list of the players in a zone, nullptr if nobody is there
+    std::vector<std::size_t> const* GetWhoListByZone(uint32 zoneId) const;
+
+    /// Lower case area name for name searches, converted once per zone and locale
+    std::wstring const& GetWideAreaName(uint32 zoneId, LocaleConstant locale);
+
 protected:
     WhoListInfoVector _whoListStorage;
+    std::unordered_map<uint32, std::vector<std::size_t>> _whoListByZone;
+    std::unordered_map<uint32, std::wstring> _wideAreaNames;
 };
 
 #define sWhoListCacheMgr WhoListCacheMgr::instance()
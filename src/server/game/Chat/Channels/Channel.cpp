@@ -21,6 +21,7 @@
 #include "Chat.h"
 #include "DatabaseEnv.h"
 #include "GameTime.h"
+#include "Metric.h"
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "SocialMgr.h"
@@ -802,6 +803,10 @@ void Channel::Say(ObjectGuid guid, std::string const& what, uint32 lang)
         ChatHandler::BuildChatPacket(data, CHAT_MSG_CHANNEL, Language(lang), guid, guid, what, 0, "", "", 0, false, _name);
     }
 
+    // global channels are the biggest fan-out, tagged by channel id to keep the series bounded
+    if (IsConstant())
+        METRIC_VALUE("channel_message_recipients", uint64(playersStore.size()), METRIC_TAG("channel_id", std::to_string(_channelId)));
+
     SendToAll(&data, pinfo.IsModerator() ? ObjectGuid::Empty : guid);
 }
 
@@ -909,16 +914,25 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, ObjectGuid guid)
 {
+    if (playersStore.empty())
+        return;
+
+    // every member queues the same buffer instead of a copy of the packet
+    std::shared_ptr<WorldPacket const> sharedData = WorldSession::MakeSharedPacket(*data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (!guid || !i->second.plrPtr->GetSocial()->HasIgnore(guid))
-            i->second.plrPtr->GetSession()->SendPacket(data);
+            i->second.plrPtr->GetSession()->SendPacket(sharedData);
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, ObjectGuid who)
 {
+    if (playersStore.empty())
+        return;
+
+    std::shared_ptr<WorldPacket const> sharedData = WorldSession::MakeSharedPacket(*data);
     for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
         if (i->first != who)
-            i->second.plrPtr->GetSession()->SendPacket(data);
+            i->second.plrPtr->GetSession()->SendPacket(sharedData);
 }
 
 void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
@@ -929,8 +943,12 @@ void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
 
 void Channel::SendToAllWatching(WorldPacket* data)
 {
+    if (playersWatchingStore.empty())
+        return;
+
+    std::shared_ptr<WorldPacket const> sharedData = WorldSession::MakeSharedPacket(*data);
     for (PlayersWatchingContainer::const_iterator i = playersWatchingStore.begin(); i != playersWatchingStore.end(); ++i)
-        (*i)->GetSession()->SendPacket(data);
+        (*i)->GetSession()->SendPacket(sharedData);
 }
 
 bool Channel::ShouldAnnouncePlayer(Player const* player) const
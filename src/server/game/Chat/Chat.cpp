@@ -203,7 +203,9 @@ size_t ChatHandler::BuildChatPacket(WorldPacket& data, ChatMsg chatType, Languag
                                     uint32 achievementId /*= 0*/, bool gmMessage /*= false*/, std::string const& channelName /*= ""*/)
 {
     size_t receiverGUIDPos = 0;
-    data.Initialize(!gmMessage ? SMSG_MESSAGECHAT : SMSG_GM_MESSAGECHAT);
+    // upper bound of every field the chat type may write, long messages do not grow the buffer twice
+    data.Initialize(!gmMessage ? SMSG_MESSAGECHAT : SMSG_GM_MESSAGECHAT, 1 + 4 + 8 + 4 + 4 + senderName.length() + 1 + 8 + 4 + receiverName.length() + 1 +
+        channelName.length() + 1 + 4 + message.length() + 1 + 1 + 4);
     data << uint8(chatType);
     data << int32(language);
     data << senderGUID;
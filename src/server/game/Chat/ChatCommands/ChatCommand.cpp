@@ -142,6 +142,8 @@ void Acore::Impl::ChatCommands::ChatCommandNode::ResolveNames(std::string name)
         LOG_WARN("sql.sql", "Table `command` is missing help text for command '{}'.", name);
 
     _name = name;
+    _subCommandsMinLevel = NO_VISIBLE_SUB_COMMANDS;
+    _subCommandsConsoleVisible = false;
 
     for (auto& [subToken, cmd] : _subCommands)
     {
@@ -149,6 +151,15 @@ void Acore::Impl::ChatCommands::ChatCommandNode::ResolveNames(std::string name)
         subName.push_back(COMMAND_DELIMITER);
         subName.append(subToken);
         cmd.ResolveNames(subName);
+
+        if (cmd._invoker)
+        {
+            _subCommandsMinLevel = std::min(_subCommandsMinLevel, cmd._permission.RequiredLevel);
+            _subCommandsConsoleVisible = _subCommandsConsoleVisible || (cmd._permission.AllowConsole == Acore::ChatCommands::Console::Yes);
+        }
+
+        _subCommandsMinLevel = std::min(_subCommandsMinLevel, cmd._subCommandsMinLevel);
+        _subCommandsConsoleVisible = _subCommandsConsoleVisible || cmd._subCommandsConsoleVisible;
     }
 }
 
@@ -517,11 +528,11 @@ bool Acore::Impl::ChatCommands::ChatCommandNode::IsInvokerVisible(ChatHandler co
 
 bool Acore::Impl::ChatCommands::ChatCommandNode::HasVisibleSubCommands(ChatHandler const& who) const
 {
-    for (auto it = _subCommands.begin(); it != _subCommands.end(); ++it)
-        if (it->second.IsVisible(who))
-            return true;
+    // same result as IsVisible() on every sub command
+    if (who.IsConsole())
+        return _subCommandsConsoleVisible;
 
-    return false;
+    return (_subCommandsMinLevel != NO_VISIBLE_SUB_COMMANDS) && who.IsAvailable(_subCommandsMinLevel);
 }
 
 void Acore::ChatCommands::LoadCommandMap() { Acore::Impl::ChatCommands::ChatCommandNode::LoadCommandMap(); }
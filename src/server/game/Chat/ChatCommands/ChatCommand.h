@@ -28,6 +28,7 @@
 #include "StringFormat.h"
 #include "Util.h"
 #include <cstddef>
+#include <limits>
 #include <map>
 #include <tuple>
 #include <type_traits>
@@ -186,7 +187,8 @@ namespace Acore::Impl::ChatCommands
         static void SendCommandHelpFor(ChatHandler& handler, std::string_view cmd);
         static std::vector<std::string> GetAutoCompletionsFor(ChatHandler const& handler, std::string_view cmd);
 
-        ChatCommandNode() : _name{}, _invoker {}, _permission{}, _help{}, _subCommands{} { }
+        ChatCommandNode() : _name{}, _invoker {}, _permission{}, _help{}, _subCommands{},
+            _subCommandsMinLevel{ NO_VISIBLE_SUB_COMMANDS }, _subCommandsConsoleVisible{ false } { }
 
     private:
         static std::map<std::string_view, ChatCommandNode, StringCompareLessI_T> const& GetTopLevelMap();
@@ -207,6 +209,11 @@ namespace Acore::Impl::ChatCommands
         CommandPermissions _permission;
         std::variant<std::monostate, AcoreStrings, std::string> _help;
         std::map<std::string_view, ChatCommandNode, StringCompareLessI_T> _subCommands;
+
+        // visibility of the whole sub tree, computed by ResolveNames() so lookups don't walk it for every command
+        static constexpr uint32 NO_VISIBLE_SUB_COMMANDS = std::numeric_limits<uint32>::max();
+        uint32 _subCommandsMinLevel;            // lowest security level that can invoke a command below this node
+        bool _subCommandsConsoleVisible;        // a command below this node can be invoked from the console
     };
 }
 
@@ -305,7 +305,33 @@ void ThreatContainer::ModifyThreatByPercent(Unit* victim, int32 percent)
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Acore::ThreatOrderPred());
+    {
+        // mostly only a few references changed their place since the last update, so move just those
+        // in place (insertion sort) and fall back to a full sort if too many are out of order.
+        // both are stable, so the resulting order is the same either way
+        Acore::ThreatOrderPred pred;
+        uint32 moved = 0;
+        for (StorageType::iterator itr = std::next(iThreatList.begin()); itr != iThreatList.end();)
+        {
+            StorageType::iterator next = std::next(itr);
+            if (pred(*itr, *std::prev(itr)))
+            {
+                if (++moved > THREAT_LIST_MAX_INCREMENTAL_MOVES)
+                {
+                    iThreatList.sort(pred);
+                    break;
+                }
+
+                StorageType::iterator pos = std::prev(itr);
+                while (pos != iThreatList.begin() && pred(*itr, *std::prev(pos)))
+                    --pos;
+
+                iThreatList.splice(pos, iThreatList, itr);
+            }
+
+            itr = next;
+        }
+    }
 
     iDirty = false;
 }
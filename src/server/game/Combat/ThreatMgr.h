@@ -34,6 +34,7 @@ class ThreatMgr;
 class SpellInfo;
 
 #define THREAT_UPDATE_INTERVAL 2 * IN_MILLISECONDS    // Server should send threat update to client periodically each second
+#define THREAT_LIST_MAX_INCREMENTAL_MOVES 8            // more references out of order than this and the threat list is sorted from scratch
 
 //==============================================================
 // Class to calculate the real threat based
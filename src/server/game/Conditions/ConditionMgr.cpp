@@ -777,6 +777,47 @@ uint32 Condition::GetSearcherTypeMaskForCondition()
     return mask;
 }
 
+uint32 Condition::GetEvaluationCost() const
+{
+    if (ReferenceId)
+        return 3;
+
+    switch (ConditionType)
+    {
+        // plain field reads of the target
+        case CONDITION_TEAM:
+        case CONDITION_CLASS:
+        case CONDITION_RACE:
+        case CONDITION_GENDER:
+        case CONDITION_LEVEL:
+        case CONDITION_MAPID:
+        case CONDITION_ZONEID:
+        case CONDITION_AREAID:
+        case CONDITION_SPAWNMASK:
+        case CONDITION_DIFFICULTY_ID:
+        case CONDITION_PHASEMASK:
+        case CONDITION_TYPE_MASK:
+        case CONDITION_OBJECT_ENTRY_GUID:
+        case CONDITION_CREATURE_TYPE:
+        case CONDITION_UNIT_STATE:
+        case CONDITION_ALIVE:
+        case CONDITION_HP_VAL:
+        case CONDITION_HP_PCT:
+        case CONDITION_DRUNKENSTATE:
+        case CONDITION_STAND_STATE:
+        case CONDITION_CHARMED:
+        case CONDITION_TAXI:
+        case CONDITION_TITLE:
+            return 0;
+        // grid searches
+        case CONDITION_NEAR_CREATURE:
+        case CONDITION_NEAR_GAMEOBJECT:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
 uint32 Condition::GetMaxAvailableConditionTargets()
 {
     // returns number of targets which are available for given source type
@@ -865,46 +906,60 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& co
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions)
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> ElseGroupStore;
-    for (ConditionList::const_iterator i = conditions.begin(); i != conditions.end(); ++i)
+    // the list is ordered by ElseGroup, so every group is a contiguous run: the conditions of a group
+    // are AND-ed and the groups are OR-ed, the first group passing all of its conditions decides
+    bool inGroup = false;
+    bool groupPassed = false;
+    uint32 elseGroup = 0;
+
+    for (Condition* condition : conditions)
     {
-        LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: {} val1: {}", (*i)->ConditionType, (*i)->ConditionValue1);
-        if ((*i)->isLoaded())
+        LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList condType: {} val1: {}", condition->ConditionType, condition->ConditionValue1);
+        if (!condition->isLoaded())
+            continue;
+
+        if (!inGroup || condition->ElseGroup != elseGroup)
         {
-            //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::const_iterator itr = ElseGroupStore.find((*i)->ElseGroup);
-            //! If not found, add an entry in the store and set to true (placeholder)
-            if (itr == ElseGroupStore.end())
-                ElseGroupStore[(*i)->ElseGroup] = true;
-            else if (!(*itr).second)
-                continue;
+            if (inGroup && groupPassed)
+                return true;
 
-            if ((*i)->ReferenceId) // handle reference
+            inGroup = true;
+            groupPassed = true;
+            elseGroup = condition->ElseGroup;
+        }
+        // cheaper conditions of this group already failed
+        else if (!groupPassed)
+            continue;
+
+        if (condition->ReferenceId) // handle reference
+        {
+            ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(condition->ReferenceId);
+            if (ref != ConditionReferenceStore.end())
             {
-                ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find((*i)->ReferenceId);
-                if (ref != ConditionReferenceStore.end())
-                {
-                    if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
-                        ElseGroupStore[(*i)->ElseGroup] = false;
-                }
-                else
-                {
-                    LOG_DEBUG("condition", "IsPlayerMeetToConditionList: Reference template -{} not found", (*i)->ReferenceId);
-                }
+                if (!IsObjectMeetToConditionList(sourceInfo, (*ref).second))
+                    groupPassed = false;
             }
-            else // handle normal condition
+            else
             {
-                if (!(*i)->Meets(sourceInfo))
-                    ElseGroupStore[(*i)->ElseGroup] = false;
+                LOG_DEBUG("condition", "IsPlayerMeetToConditionList: Reference template -{} not found", condition->ReferenceId);
             }
         }
+        else if (!condition->Meets(sourceInfo)) // handle normal condition
+            groupPassed = false;
     }
-    for (std::map<uint32, bool>::const_iterator i = ElseGroupStore.begin(); i != ElseGroupStore.end(); ++i)
-        if (i->second)
-            return true;
 
-    return false;
+    return inGroup && groupPassed;
+}
+
+void ConditionMgr::AddToConditionList(ConditionList& conditions, Condition* cond)
+{
+    // keep ElseGroups contiguous and the cheapest checks of a group first, so evaluation can stop at the first failure
+    uint32 cost = cond->GetEvaluationCost();
+    ConditionList::iterator itr = conditions.begin();
+    while (itr != conditions.end() && ((*itr)->ElseGroup < cond->ElseGroup || ((*itr)->ElseGroup == cond->ElseGroup && (*itr)->GetEvaluationCost() <= cost)))
+        ++itr;
+
+    conditions.insert(itr, cond);
 }
 
 bool ConditionMgr::IsObjectMeetToConditions(WorldObject* object, ConditionList const& conditions)
@@ -940,9 +995,11 @@ bool ConditionMgr::CanHaveSourceIdSet(ConditionSourceType sourceType) const
     return (sourceType == CONDITION_SOURCE_TYPE_SMART_EVENT);
 }
 
-ConditionList ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry)
+// returned by the lookups below when nothing is stored for the key
+static ConditionList const EmptyConditionList;
+
+ConditionList const& ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry)
 {
-    ConditionList spellCond;
     if (sourceType > CONDITION_SOURCE_TYPE_NONE && sourceType < CONDITION_SOURCE_TYPE_MAX)
     {
         ConditionContainer::const_iterator itr = ConditionStore.find(sourceType);
@@ -951,72 +1008,73 @@ ConditionList ConditionMgr::GetConditionsForNotGroupedEntry(ConditionSourceType
             ConditionTypeContainer::const_iterator i = (*itr).second.find(entry);
             if (i != (*itr).second.end())
             {
-                spellCond = (*i).second;
                 LOG_DEBUG("condition", "GetConditionsForNotGroupedEntry: found conditions for type {} and entry {}", uint32(sourceType), entry);
+                return (*i).second;
             }
         }
     }
-    return spellCond;
+    return EmptyConditionList;
 }
 
-ConditionList ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId)
+bool ConditionMgr::HasConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const
+{
+    ConditionContainer::const_iterator itr = ConditionStore.find(sourceType);
+    return itr != ConditionStore.end() && itr->second.find(entry) != itr->second.end();
+}
+
+ConditionList const& ConditionMgr::GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId)
 {
-    ConditionList                                   cond;
     CreatureSpellConditionContainer::const_iterator itr = SpellClickEventConditionStore.find(creatureId);
     if (itr != SpellClickEventConditionStore.end())
     {
         ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
         if (i != (*itr).second.end())
         {
-            cond = (*i).second;
             LOG_DEBUG("condition", "GetConditionsForSpellClickEvent: found conditions for Vehicle entry {} spell {}", creatureId, spellId);
+            return (*i).second;
         }
     }
-    return cond;
+    return EmptyConditionList;
 }
 
-ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId)
+ConditionList const& ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId)
 {
-    ConditionList                                   cond;
     CreatureSpellConditionContainer::const_iterator itr = VehicleSpellConditionStore.find(creatureId);
     if (itr != VehicleSpellConditionStore.end())
     {
         ConditionTypeContainer::const_iterator i = (*itr).second.find(spellId);
         if (i != (*itr).second.end())
         {
-            cond = (*i).second;
             LOG_DEBUG("condition", "GetConditionsForVehicleSpell: found conditions for Vehicle entry {} spell {}", creatureId, spellId);
+            return (*i).second;
         }
     }
-    return cond;
+    return EmptyConditionList;
 }
 
-ConditionList ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType)
+ConditionList const& ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType)
 {
-    ConditionList                                cond;
     SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
     if (itr != SmartEventConditionStore.end())
     {
         ConditionTypeContainer::const_iterator i = (*itr).second.find(eventId + 1);
         if (i != (*itr).second.end())
         {
-            cond = (*i).second;
             LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid {} event_id {}", entryOrGuid, eventId);
+            return (*i).second;
         }
     }
-    return cond;
+    return EmptyConditionList;
 }
 
-ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId)
+ConditionList const& ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId)
 {
-    ConditionList                               cond;
     NpcVendorConditionContainer::const_iterator itr = NpcVendorConditionContainerStore.find(creatureId);
     if (itr != NpcVendorConditionContainerStore.end())
     {
         ConditionTypeContainer::const_iterator i = (*itr).second.find(itemId);
         if (i != (*itr).second.end())
         {
-            cond = (*i).second;
             if (itemId)
             {
                 LOG_DEBUG("condition", "GetConditionsForNpcVendorEvent: found conditions for creature entry {} item {}", creatureId, itemId);
@@ -1025,9 +1083,10 @@ ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, ui
             {
                 LOG_DEBUG("condition", "GetConditionsForNpcVendorEvent: found conditions for creature entry {}", creatureId);
             }
+            return (*i).second;
         }
     }
-    return cond;
+    return EmptyConditionList;
 }
 
 void ConditionMgr::LoadConditions(bool isReload)
@@ -1035,6 +1094,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     uint32 oldMSTime = getMSTime();
 
     Clean();
+    sObjectMgr->InvalidateQuestGiverStatus();
 
     // must clear all custom handled cases (groupped types) before reload
     if (isReload)
@@ -1142,7 +1202,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                 ConditionList mCondList;
                 ConditionReferenceStore[uRefId] = mCondList;
             }
-            ConditionReferenceStore[uRefId].push_back(cond); // add to reference storage
+            AddToConditionList(ConditionReferenceStore[uRefId], cond); // add to reference storage
             count++;
             continue;
         } // end of reference templates
@@ -1230,7 +1290,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                 break;
             case CONDITION_SOURCE_TYPE_SPELL_CLICK_EVENT:
             {
-                SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                AddToConditionList(SpellClickEventConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                 valid = true;
                 ++count;
                 continue; // do not add to m_AllocatedMemory to avoid double deleting
@@ -1240,7 +1300,7 @@ void ConditionMgr::LoadConditions(bool isReload)
                 break;
             case CONDITION_SOURCE_TYPE_VEHICLE_SPELL:
             {
-                VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                AddToConditionList(VehicleSpellConditionStore[cond->SourceGroup][cond->SourceEntry], cond);
                 valid = true;
                 ++count;
                 continue; // do not add to m_AllocatedMemory to avoid double deleting
@@ -1249,14 +1309,14 @@ void ConditionMgr::LoadConditions(bool isReload)
             {
                 //! TODO: PAIR_32 ?
                 std::pair<int32, uint32> key = std::make_pair(cond->SourceEntry, cond->SourceId);
-                SmartEventConditionStore[key][cond->SourceGroup].push_back(cond);
+                AddToConditionList(SmartEventConditionStore[key][cond->SourceGroup], cond);
                 valid = true;
                 ++count;
                 continue;
             }
             case CONDITION_SOURCE_TYPE_NPC_VENDOR:
             {
-                NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry].push_back(cond);
+                AddToConditionList(NpcVendorConditionContainerStore[cond->SourceGroup][cond->SourceEntry], cond);
                 valid = true;
                 ++count;
                 continue;
@@ -1299,7 +1359,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         }
 
         // add new Condition to storage based on Type/Entry
-        ConditionStore[cond->SourceType][cond->SourceEntry].push_back(cond);
+        AddToConditionList(ConditionStore[cond->SourceType][cond->SourceEntry], cond);
         ++count;
     } while (result->NextRow());
 
@@ -1307,6 +1367,18 @@ void ConditionMgr::LoadConditions(bool isReload)
     LOG_INFO("server.loading", " ");
 }
 
+void ConditionMgr::AttachLootConditions(ConditionSourceType sourceType, LootStore const& store)
+{
+    // AllocatedMemoryStore only keeps the grouped conditions accepted at the last LoadConditions,
+    // conditions rejected back then for a template missing at that time need a full reload
+    uint32 count = 0;
+    for (Condition* cond : AllocatedMemoryStore)
+        if (cond->SourceType == sourceType && addToLootTemplate(cond, store.GetLootForConditionFill(cond->SourceGroup)))
+            ++count;
+
+    LOG_INFO("server.loading", ">> Attached {} conditions to `{}`", count, store.GetName());
+}
+
 bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot)
 {
     if (!loot)
@@ -1332,7 +1404,7 @@ bool ConditionMgr::addToGossipMenus(Condition* cond)
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.TextID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1351,7 +1423,7 @@ bool ConditionMgr::addToGossipMenuItems(Condition* cond)
         {
             if ((*itr).second.MenuID == cond->SourceGroup && (*itr).second.OptionID == uint32(cond->SourceEntry))
             {
-                (*itr).second.Conditions.push_back(cond);
+                AddToConditionList((*itr).second.Conditions, cond);
                 return true;
             }
         }
@@ -1440,7 +1512,7 @@ bool ConditionMgr::addToSpellImplicitTargetConditions(Condition* cond)
                     delete sharedList;
             }
             if (sharedList)
-                sharedList->push_back(cond);
+                AddToConditionList(*sharedList, cond);
             break;
         }
     }
@@ -22,11 +22,13 @@
 #include "Errors.h"
 #include <list>
 #include <map>
+#include <unordered_map>
 
 class Player;
 class Unit;
 class WorldObject;
 class LootTemplate;
+class LootStore;
 struct Condition;
 
 enum ConditionTypes
@@ -230,17 +232,19 @@ struct Condition
     bool Meets(ConditionSourceInfo& sourceInfo);
     uint32 GetSearcherTypeMaskForCondition();
     [[nodiscard]] bool isLoaded() const { return ConditionType > CONDITION_NONE || ReferenceId; }
+    [[nodiscard]] uint32 GetEvaluationCost() const;
     uint32 GetMaxAvailableConditionTargets();
 };
 
+// lists are kept ordered by ElseGroup and then by evaluation cost, see ConditionMgr::AddToConditionList
 typedef std::list<Condition*> ConditionList;
-typedef std::map<uint32, ConditionList> ConditionTypeContainer;
-typedef std::map<ConditionSourceType, ConditionTypeContainer> ConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> CreatureSpellConditionContainer;
-typedef std::map<uint32, ConditionTypeContainer> NpcVendorConditionContainer;
+typedef std::unordered_map<uint32, ConditionList> ConditionTypeContainer;
+typedef std::unordered_map<ConditionSourceType, ConditionTypeContainer> ConditionContainer;
+typedef std::unordered_map<uint32, ConditionTypeContainer> CreatureSpellConditionContainer;
+typedef std::unordered_map<uint32, ConditionTypeContainer> NpcVendorConditionContainer;
 typedef std::map<std::pair<int32, uint32 /*SAI source_type*/>, ConditionTypeContainer> SmartEventConditionContainer;
 
-typedef std::map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
+typedef std::unordered_map<uint32, ConditionList> ConditionReferenceContainer;//only used for references
 
 class ConditionMgr
 {
@@ -252,8 +256,11 @@ public:
     static ConditionMgr* instance();
 
     void LoadConditions(bool isReload = false);
+    // Hands the loaded grouped conditions of a loot source type to the templates of a freshly reloaded loot store
+    void AttachLootConditions(ConditionSourceType sourceType, LootStore const& store);
     bool isConditionTypeValid(Condition* cond);
     ConditionList GetConditionReferences(uint32 refId);
+    static void AddToConditionList(ConditionList& conditions, Condition* cond);
 
     uint32 GetSearcherTypeMaskForConditionList(ConditionList const& conditions);
     bool IsObjectMeetToConditions(WorldObject* object, ConditionList const& conditions);
@@ -261,11 +268,12 @@ public:
     bool IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
     [[nodiscard]] bool CanHaveSourceGroupSet(ConditionSourceType sourceType) const;
     [[nodiscard]] bool CanHaveSourceIdSet(ConditionSourceType sourceType) const;
-    ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
-    ConditionList GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
-    ConditionList GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType);
-    ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
-    ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
+    ConditionList const& GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
+    [[nodiscard]] bool HasConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry) const;
+    ConditionList const& GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
+    ConditionList const& GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType);
+    ConditionList const& GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
+    ConditionList const& GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
 
 private:
     bool isSourceTypeValid(Condition* cond);
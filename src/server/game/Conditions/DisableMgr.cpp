@@ -56,6 +56,7 @@ namespace DisableMgr
             itr->second.clear();
 
         m_DisableMap.clear();
+        sObjectMgr->InvalidateQuestGiverStatus();
 
         QueryResult result = WorldDatabase.Query("SELECT sourceType, entry, flags, params_0, params_1 FROM disables");
 
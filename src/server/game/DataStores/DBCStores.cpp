@@ -26,7 +26,10 @@
 #include "SpellMgr.h"
 #include "TransportMgr.h"
 #include "World.h"
+#include "WorldLoadGraph.h"
+#include <atomic>
 #include <map>
+#include <mutex>
 
 typedef std::map<uint16, uint32> AreaFlagByAreaID;
 typedef std::map<uint32, uint32> AreaFlagByMapID;
@@ -209,13 +212,13 @@ static bool LoadDBC_assert_print(uint32 fsize, uint32 rsize, const std::string&
     return false;
 }
 
+// called by several threads at once, see LoadDBCStores
 template<class T>
-inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, char const* dbTable = nullptr)
+inline void LoadDBC(std::atomic<uint32>& availableDbcLocales, StoreProblemList& errors, std::mutex& errorsLock, DBCStorage<T>& storage, std::string const& dbcPath, std::string const& filename, char const* dbTable = nullptr)
 {
     // compatibility format and C++ structure sizes
     ASSERT(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()) == sizeof(T) || LoadDBC_assert_print(DBCFileLoader::GetFormatRecordSize(storage.GetFormat()), sizeof(T), filename));
 
-    ++DBCFileCount;
     std::string dbcFilename = dbcPath + filename;
     bool existDBData = false;
 
@@ -223,7 +226,7 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
     {
         for (uint8 i = 0; i < TOTAL_LOCALES; ++i)
         {
-            if (!(availableDbcLocales & (1 << i)))
+            if (!(availableDbcLocales.load() & (1 << i)))
                 continue;
 
             std::string localizedName(dbcPath);
@@ -232,7 +235,7 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
             localizedName.append(filename);
 
             if (!storage.LoadStringsFrom(localizedName.c_str()))
-                availableDbcLocales &= ~(1 << i);             // mark as not available for speedup next checks
+                availableDbcLocales.fetch_and(~(1 << i));     // mark as not available for speedup next checks
         }
     }
 
@@ -244,6 +247,8 @@ inline void LoadDBC(uint32& availableDbcLocales, StoreProblemList& errors, DBCSt
 
     if (!existDBData)
     {
+        std::lock_guard<std::mutex> guard(errorsLock);
+
         // sort problematic dbc to (1) non compatible and (2) non-existed
         if (FILE* f = fopen(dbcFilename.c_str(), "rb"))
         {
@@ -265,9 +270,13 @@ void LoadDBCStores(const std::string& dataPath)
     std::string dbcPath = dataPath + "dbc/";
 
     StoreProblemList bad_dbc_files;
-    uint32 availableDbcLocales = 0xFFFFFFFF;
+    std::mutex badDbcFilesLock;
+    std::atomic<uint32> availableDbcLocales(0xFFFFFFFF);
+
+    // every file fills only its own store, the index builders below run once all of them are loaded
+    WorldLoadGraph loadGraph("Data Stores");
 
-#define LOAD_DBC(store, file, dbtable) LoadDBC(availableDbcLocales, bad_dbc_files, store, dbcPath, file, dbtable)
+#define LOAD_DBC(store, file, dbtable) do { ++DBCFileCount; loadGraph.Add(file, [&] { LoadDBC(availableDbcLocales, bad_dbc_files, badDbcFilesLock, store, dbcPath, file, dbtable); }); } while (0)
 
     LOAD_DBC(sAreaTableStore,                       "AreaTable.dbc",                        "areatable_dbc");
     LOAD_DBC(sAchievementStore,                     "Achievement.dbc",                      "achievement_dbc");
@@ -384,6 +393,8 @@ void LoadDBCStores(const std::string& dataPath)
 
 #undef LOAD_DBC
 
+    loadGraph.Run(sWorld->getIntConfig(CONFIG_NUMTHREADS_STARTUP_LOADERS));
+
     for (CharStartOutfitEntry const* outfit : sCharStartOutfitStore)
         sCharStartOutfitMap[outfit->Race | (outfit->Class << 8) | (outfit->Gender << 16)] = outfit;
 
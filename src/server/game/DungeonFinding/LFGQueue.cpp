@@ -150,12 +150,34 @@ namespace lfg
     void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
     {
         LOG_DEBUG("lfg", "COMPATIBLES REMOVE for: {}", guid.ToString());
-        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(guid))
+        LfgCompatibleIndex::iterator itIndex = CompatibleIndex.find(guid);
+        if (itIndex != CompatibleIndex.end())
+        {
+            std::vector<LfgCompatibleContainer::iterator> compatibles = std::move(itIndex->second);
+            CompatibleIndex.erase(itIndex);
+
+            for (LfgCompatibleContainer::iterator it : compatibles)
             {
+                // drop the compatible from the index of the other members too
+                for (uint8 i = 0; i < 5 && it->guids[i]; ++i)
+                {
+                    if (it->guids[i] == guid)
+                        continue;
+
+                    LfgCompatibleIndex::iterator itOther = CompatibleIndex.find(it->guids[i]);
+                    if (itOther == CompatibleIndex.end())
+                        continue;
+
+                    std::erase(itOther->second, it);
+                    if (itOther->second.empty())
+                        CompatibleIndex.erase(itOther);
+                }
+
                 LOG_DEBUG("lfg", "Removed Compatible: {}, because of: {}", it->toString(), guid.ToString());
                 it->clear(); // set to 0, this will be removed while iterating in FindNewGroups
             }
+        }
+
         for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); )
         {
             LfgCompatibleContainer::iterator it = itr++;
@@ -173,6 +195,12 @@ namespace lfg
         CompatibleTempList.push_back(key);
     }
 
+    void LFGQueue::IndexCompatible(LfgCompatibleContainer::iterator itr)
+    {
+        for (uint8 i = 0; i < 5 && itr->guids[i]; ++i)
+            CompatibleIndex[itr->guids[i]].push_back(itr);
+    }
+
     uint8 LFGQueue::FindGroups()
     {
         LOG_DEBUG("lfg", "FIND GROUPS!");
@@ -187,6 +215,10 @@ namespace lfg
 
             FindNewGroups(newGuid);
 
+            // list iterators stay valid when the nodes are spliced into CompatibleList
+            for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); ++itr)
+                IndexCompatible(itr);
+
             CompatibleList.splice((pushCompatiblesToFront ? CompatibleList.begin() : CompatibleList.end()), CompatibleTempList);
             CompatibleTempList.clear();
 
@@ -207,8 +239,10 @@ namespace lfg
         // we have to take into account that FindNewGroups is called every X minutes if number of compatibles is low!
         // build set of already present compatibles for this guid
         std::set<Lfg5Guids> currentCompatibles;
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(newGuid))
+        LfgCompatibleIndex::const_iterator itIndex = CompatibleIndex.find(newGuid);
+        if (itIndex != CompatibleIndex.end())
+        {
+            for (LfgCompatibleContainer::iterator it : itIndex->second)
             {
                 // unset roles here so they are not copied, restore after insertion
                 LfgRolesMap* r = it->roles;
@@ -216,6 +250,7 @@ namespace lfg
                 currentCompatibles.insert(*it);
                 it->roles = r;
             }
+        }
 
         LfgCompatibility selfCompatibility = LFG_COMPATIBILITY_PENDING;
         if (currentCompatibles.empty())
@@ -574,14 +609,14 @@ namespace lfg
 
     uint32 LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
     {
-        uint32 numOfCompatibles = 0;
-        for (LfgCompatibleContainer::const_iterator itr = CompatibleList.begin(); itr != CompatibleList.end(); ++itr)
-            if (itr->hasGuid(itrQueue->first))
-            {
-                ++numOfCompatibles;
-                UpdateBestCompatibleInQueue(itrQueue, *itr);
-            }
-        return numOfCompatibles;
+        LfgCompatibleIndex::const_iterator itIndex = CompatibleIndex.find(itrQueue->first);
+        if (itIndex == CompatibleIndex.end())
+            return 0;
+
+        for (LfgCompatibleContainer::iterator itr : itIndex->second)
+            UpdateBestCompatibleInQueue(itrQueue, *itr);
+
+        return itIndex->second.size();
     }
 
     void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key)
@@ -18,7 +18,9 @@
 #ifndef _LFGQUEUE_H
 #define _LFGQUEUE_H
 
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "LFG.h"
 
@@ -67,6 +69,7 @@ namespace lfg
     typedef std::map<uint32, LfgWaitTime> LfgWaitTimesContainer;
     typedef std::map<ObjectGuid, LfgQueueData> LfgQueueDataContainer;
     typedef std::list<Lfg5Guids> LfgCompatibleContainer;
+    typedef std::unordered_map<ObjectGuid, std::vector<LfgCompatibleContainer::iterator>> LfgCompatibleIndex;
 
     /**
         Stores all data related to queue
@@ -94,13 +97,12 @@ namespace lfg
         uint8 FindGroups();
 
     private:
-        void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
-
         void AddToNewQueue(ObjectGuid guid, bool front);
         void RemoveFromNewQueue(ObjectGuid guid);
 
         void RemoveFromCompatibles(ObjectGuid guid);
         void AddToCompatibles(Lfg5Guids const& key);
+        void IndexCompatible(LfgCompatibleContainer::iterator itr);
 
         uint32 FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
         void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key);
@@ -113,6 +115,7 @@ namespace lfg
         LfgQueueDataContainer QueueDataStore;              // Queued groups
         LfgCompatibleContainer CompatibleList;             // Compatible dungeons
         LfgCompatibleContainer CompatibleTempList;         // new compatibles are added to this container while main one is being iterated
+        LfgCompatibleIndex CompatibleIndex;                // CompatibleList entries each queued guid takes part in
 
         LfgWaitTimesContainer waitTimesAvgStore;           // Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          // Average wait time to find a group queuing as tank
@@ -24,6 +24,7 @@
 #include "ObjectAccessor.h"
 #include "Opcodes.h"
 #include "Player.h"
+#include "UpdateFieldFlags.h"
 #include "UpdateMask.h"
 #include "World.h"
 
@@ -88,12 +89,9 @@ bool Corpse::Create(ObjectGuid::LowType guidlow, Player* owner)
     return true;
 }
 
-void Corpse::SaveToDB()
+// Map::SaveCorpseData deletes the previous row of the owner before appending this
+CharacterDatabasePreparedStatement* Corpse::BuildSaveStatement() const
 {
-    // prevent DB data inconsistence problems and duplicates
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
-    DeleteFromDB(trans);
-
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_CORPSE);
     stmt->SetData(0, GetOwnerGUID().GetCounter());                            // guid
     stmt->SetData (1, GetPositionX());                                         // posX
@@ -112,9 +110,7 @@ void Corpse::SaveToDB()
     stmt->SetData (14, GetType());                                             // corpseType
     stmt->SetData(15, GetInstanceId());                                       // instanceId
     stmt->SetData(16, GetPhaseMask());                                        // phaseMask
-    trans->Append(stmt);
-
-    CharacterDatabase.CommitTransaction(trans);
+    return stmt;
 }
 
 void Corpse::DeleteFromDB(CharacterDatabaseTransaction trans)
@@ -181,16 +177,21 @@ bool Corpse::LoadCorpseFromDB(ObjectGuid::LowType guid, Field* fields)
     return true;
 }
 
+time_t Corpse::GetExpiryTime() const
+{
+    if (m_type == CORPSE_BONES)
+        return m_time + 60 * MINUTE;
+    else
+        return m_time + 3 * DAY;
+}
+
 bool Corpse::IsExpired(time_t t) const
 {
     // Deleted character
     if (!sCharacterCache->GetCharacterCacheByGuid(GetOwnerGUID()))
         return true;
 
-    if (m_type == CORPSE_BONES)
-        return m_time < t - 60 * MINUTE;
-    else
-        return m_time < t - 3 * DAY;
+    return GetExpiryTime() < t;
 }
 
 void Corpse::ResetGhostTime()
@@ -209,43 +210,35 @@ void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
+    BuildValuesUpdateMask(updateType, flags, visibleFlag, UF_FLAG_NONE, updateMask);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    for (uint32 index = updateMask.FindNextSetBit(0); index < m_valuesCount; index = updateMask.FindNextSetBit(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] || ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
+        if (index == CORPSE_FIELD_BYTES_1 || index == CORPSE_FIELD_BYTES_2)
         {
-            updateMask.SetBit(index);
-
-            if (index == CORPSE_FIELD_BYTES_1 || index == CORPSE_FIELD_BYTES_2)
+            Player* owner = ObjectAccessor::GetPlayer(*this, GetOwnerGUID());
+            if (owner && owner != target && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && owner->IsInRaidWith(target) && owner->GetTeamId() != target->GetTeamId())
             {
-                Player* owner = ObjectAccessor::GetPlayer(*this, GetOwnerGUID());
-                if (owner && owner != target && sWorld->getBoolConfig(CONFIG_ALLOW_TWO_SIDE_INTERACTION_GROUP) && owner->IsInRaidWith(target) && owner->GetTeamId() != target->GetTeamId())
+                uint32 playerBytes = target->GetUInt32Value(PLAYER_BYTES);
+                uint32 playerBytes2 = target->GetUInt32Value(PLAYER_BYTES_2);
+
+                uint8 race = target->getRace();
+                uint8 skin = (uint8)(playerBytes);
+                uint8 face = (uint8)(playerBytes >> 8);
+                uint8 hairstyle = (uint8)(playerBytes >> 16);
+                uint8 haircolor = (uint8)(playerBytes >> 24);
+                uint8 facialhair = (uint8)(playerBytes2);
+
+                uint32 corpseBytes1 = ((0x00) | (race << 8) | (target->GetByteValue(PLAYER_BYTES_3, 0) << 16) | (skin << 24));
+                uint32 corpseBytes2 = ((face) | (hairstyle << 8) | (haircolor << 16) | (facialhair << 24));
+
+                if (index == CORPSE_FIELD_BYTES_1)
                 {
-                    uint32 playerBytes = target->GetUInt32Value(PLAYER_BYTES);
-                    uint32 playerBytes2 = target->GetUInt32Value(PLAYER_BYTES_2);
-
-                    uint8 race = target->getRace();
-                    uint8 skin = (uint8)(playerBytes);
-                    uint8 face = (uint8)(playerBytes >> 8);
-                    uint8 hairstyle = (uint8)(playerBytes >> 16);
-                    uint8 haircolor = (uint8)(playerBytes >> 24);
-                    uint8 facialhair = (uint8)(playerBytes2);
-
-                    uint32 corpseBytes1 = ((0x00) | (race << 8) | (target->GetByteValue(PLAYER_BYTES_3, 0) << 16) | (skin << 24));
-                    uint32 corpseBytes2 = ((face) | (hairstyle << 8) | (haircolor << 16) | (facialhair << 24));
-
-                    if (index == CORPSE_FIELD_BYTES_1)
-                    {
-                        fieldBuffer << corpseBytes1;
-                    }
-                    else
-                    {
-                        fieldBuffer << corpseBytes2;
-                    }
+                    fieldBuffer << corpseBytes1;
                 }
                 else
                 {
-                    fieldBuffer << m_uint32Values[index];
+                    fieldBuffer << corpseBytes2;
                 }
             }
             else
@@ -253,6 +246,10 @@ void Corpse::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
                 fieldBuffer << m_uint32Values[index];
             }
         }
+        else
+        {
+            fieldBuffer << m_uint32Values[index];
+        }
     }
 
     *data << uint8(updateMask.GetBlockCount());
@@ -59,7 +59,7 @@ public:
     bool Create(ObjectGuid::LowType guidlow);
     bool Create(ObjectGuid::LowType guidlow, Player* owner);
 
-    void SaveToDB();
+    [[nodiscard]] CharacterDatabasePreparedStatement* BuildSaveStatement() const;
     bool LoadCorpseFromDB(ObjectGuid::LowType guid, Field* fields);
 
     void DeleteFromDB(CharacterDatabaseTransaction trans);
@@ -77,6 +77,7 @@ public:
     Loot loot;                                          // remove insignia ONLY at BG
     Player* lootRecipient;
 
+    [[nodiscard]] time_t GetExpiryTime() const;
     [[nodiscard]] bool IsExpired(time_t t) const;
 
 private:
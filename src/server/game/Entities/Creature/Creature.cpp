@@ -306,6 +306,61 @@ Creature::~Creature()
     i_AI = nullptr;
 }
 
+// Creature objects are a few kilobytes, so their chunks are kept small
+typedef Acore::Impl::NodePool<sizeof(Creature), 16> CreaturePool;
+typedef Acore::Impl::NodePool<sizeof(TempSummon), 16> TempSummonPool;
+typedef Acore::Impl::NodePool<sizeof(Minion), 16> MinionPool;
+static std::atomic<uint64> CreaturePoolAllocations{0};
+static std::atomic<uint64> CreaturePoolObjects{0};
+
+void* Creature::operator new(std::size_t size)
+{
+    ++CreaturePoolAllocations;
+
+    // pets, totems and creatures of scripts have their own sizes
+    if (size != sizeof(Creature) && size != sizeof(TempSummon) && size != sizeof(Minion))
+        return ::operator new(size);
+
+    ++CreaturePoolObjects;
+    if (size == sizeof(Creature))
+        return CreaturePool::Allocate();
+    if (size == sizeof(TempSummon))
+        return TempSummonPool::Allocate();
+    return MinionPool::Allocate();
+}
+
+void Creature::operator delete(void* ptr, std::size_t size)
+{
+    if (size != sizeof(Creature) && size != sizeof(TempSummon) && size != sizeof(Minion))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    --CreaturePoolObjects;
+    if (size == sizeof(Creature))
+        CreaturePool::Deallocate(ptr);
+    else if (size == sizeof(TempSummon))
+        TempSummonPool::Deallocate(ptr);
+    else
+        MinionPool::Deallocate(ptr);
+}
+
+uint64 Creature::TakePoolAllocationCount()
+{
+    return CreaturePoolAllocations.exchange(0);
+}
+
+uint64 Creature::GetPoolObjectCount()
+{
+    return CreaturePoolObjects;
+}
+
+std::size_t Creature::GetPoolReservedBytes()
+{
+    return CreaturePool::ReservedBytes() + TempSummonPool::ReservedBytes() + MinionPool::ReservedBytes();
+}
+
 void Creature::AddToWorld()
 {
     ///- Register the creature for guid lookup
@@ -320,6 +375,7 @@ void Creature::AddToWorld()
         {
             GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
         }
+        GetMap()->AddToCreatureEntryIndex(this, GetEntry());
         Unit::AddToWorld();
 
         SearchFormation();
@@ -362,6 +418,7 @@ void Creature::RemoveFromWorld()
         if (m_spawnId)
             Acore::Containers::MultimapErasePair(GetMap()->GetCreatureBySpawnIdStore(), m_spawnId, this);
 
+        GetMap()->RemoveFromCreatureEntryIndex(this, GetEntry());
         GetMap()->GetObjectsStore().Remove<Creature>(GetGUID());
     }
 }
@@ -406,6 +463,11 @@ void Creature::RemoveCorpse(bool setSpawnTime, bool skipVisibility)
     RemoveAllAuras();
     if (!skipVisibility) // pussywizard
         DestroyForNearbyPlayers(); // pussywizard: previous UpdateObjectVisibility()
+
+    // loot type is only set once somebody opened the loot
+    if (loot.loot_type == LOOT_NONE && !loot.empty())
+        LootTemplates_Creature.CountUnopenedFill();
+
     loot.clear();
     uint32 respawnDelay = m_respawnDelay;
     if (IsAIEnabled)
@@ -672,14 +734,13 @@ void Creature::Update(uint32 diff)
             LOG_ERROR("entities.unit", "Creature ({}) in wrong state: DeathState::JustDead (1)", GetGUID().ToString());
             break;
         case DeathState::Dead:
-        {
-            time_t now = GameTime::GetGameTime().count();
-            if (m_respawnTime <= now)
+            // the map wakes us once the respawn time is due, see Map::ProcessCreatureRespawns()
+            if (m_queuedRespawnTime != m_respawnTime)
             {
-                Respawn();
+                m_queuedRespawnTime = m_respawnTime;
+                GetMap()->QueueCreatureRespawn(GetGUID(), m_respawnTime);
             }
             break;
-        }
         case DeathState::Corpse:
         {
             Unit::Update(diff);
@@ -814,10 +875,15 @@ void Creature::Update(uint32 diff)
 
             if (!IsInEvadeMode() && IsAIEnabled)
             {
-                // do not allow the AI to be changed during update
-                m_AI_locked = true;
-                i_AI->UpdateAI(diff);
-                m_AI_locked = false;
+                if (AI()->IsUpdateQuiescent())
+                    GetMap()->CountQuiescentAIUpdate();
+                else
+                {
+                    // do not allow the AI to be changed during update
+                    m_AI_locked = true;
+                    i_AI->UpdateAI(diff);
+                    m_AI_locked = false;
+                }
             }
 
             // creature can be dead after UpdateAI call
@@ -2030,7 +2096,7 @@ void Creature::Respawn(bool force)
         }
     }
 
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_CREATURE_RESPAWN, GetEntry());
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_CREATURE_RESPAWN, GetEntry());
 
     if (!sConditionMgr->IsObjectMeetToConditions(this, conditions) && !force)
     {
@@ -2076,6 +2142,7 @@ void Creature::Respawn(bool force)
 
             LOG_DEBUG("entities.unit", "Respawning creature {} (SpawnId: {}, {})", GetName(), GetSpawnId(), GetGUID().ToString());
             m_respawnTime = 0;
+            m_queuedRespawnTime.reset();
             ResetPickPocketLootTime();
             loot.clear();
             SelectLevel();
@@ -2136,6 +2203,22 @@ void Creature::Respawn(bool force)
     }
 }
 
+bool Creature::RespawnQueued(time_t queuedTime)
+{
+    // the respawn time changed after this entry was queued, the new one is queued as well
+    if (m_queuedRespawnTime != queuedTime)
+        return false;
+
+    m_queuedRespawnTime.reset();
+
+    if (m_deathState != DeathState::Dead || m_respawnTime > GameTime::GetGameTime().count())
+        return false;
+
+    // if the respawn is refused or delayed the next Update queues the creature again
+    Respawn();
+    return IsAlive();
+}
+
 void Creature::ForcedDespawn(uint32 timeMSToDespawn, Seconds forceRespawnTimer)
 {
     if (timeMSToDespawn)
@@ -3104,7 +3187,7 @@ TrainerSpellData const* Creature::GetTrainerSpells() const
 }
 
 // overwrite WorldObject function for proper name localization
-std::string const& Creature::GetNameForLocaleIdx(LocaleConstant loc_idx) const
+std::string_view Creature::GetNameForLocaleIdx(LocaleConstant loc_idx) const
 {
     if (loc_idx != DEFAULT_LOCALE)
     {
@@ -3674,6 +3757,41 @@ void Creature::SetLastDamagedTimePtr(std::shared_ptr<time_t> const& val)
     _lastDamagedTime = val;
 }
 
+bool Creature::IsIdleForUpdate() const
+{
+    if (!IsAlive() || IsInCombat() || isActiveObject() || !IsAIEnabled || TriggerJustRespawned || NeedChangeAI)
+        return false;
+
+    if (!AI()->CanThrottleIdleUpdates())
+        return false;
+
+    if (IsSummon() || IsVehicle() || GetCharmerOrOwnerGUID() || GetVictim() || HasUnitState(UNIT_STATE_EVADE | UNIT_STATE_CASTING))
+        return false;
+
+    if (!IsFullHealth() || GetPower(getPowerType()) < GetMaxPower(getPowerType()))
+        return false;
+
+    if (m_Events.HasEvents() || m_delayed_unit_relocation_timer || m_delayed_unit_ai_notify_timer || m_assistanceTimer)
+        return false;
+
+    if (!movespline->Finalized() || GetMotionMaster()->GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE)
+        return false;
+
+    // auras have to expire and tick in time
+    for (auto const& [spellId, aura] : GetOwnedAuras())
+    {
+        if (!aura->IsPermanent())
+            return false;
+
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            if (AuraEffect const* aurEff = aura->GetEffect(i))
+                if (aurEff->IsPeriodic())
+                    return false;
+    }
+
+    return true;
+}
+
 bool Creature::CanPeriodicallyCallForAssistance() const
 {
     if (!IsInCombat())
@@ -24,6 +24,7 @@
 #include "DatabaseEnv.h"
 #include "ItemTemplate.h"
 #include "LootMgr.h"
+#include "Optional.h"
 #include "Unit.h"
 #include "UpdateMask.h"
 #include "World.h"
@@ -48,6 +49,16 @@ public:
     explicit Creature(bool isWorldObject = false);
     ~Creature() override;
 
+    // spawns, respawns and summons allocate a Creature, TempSummon or Minion, they are recycled through per thread pools
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+    // Creature, TempSummon and Minion allocations since the last call
+    static uint64 TakePoolAllocationCount();
+    // objects currently living in the pools
+    static uint64 GetPoolObjectCount();
+    // memory held by the pools, in use or free
+    static std::size_t GetPoolReservedBytes();
+
     void AddToWorld() override;
     void RemoveFromWorld() override;
 
@@ -135,6 +146,8 @@ public:
     void Motion_Initialize();
 
     [[nodiscard]] CreatureAI* AI() const { return (CreatureAI*)i_AI; }
+    // alive, out of combat and standing still, with nothing in Update to count down
+    [[nodiscard]] bool IsIdleForUpdate() const;
 
     bool SetWalk(bool enable) override;
     bool SetDisableGravity(bool disable, bool packetOnly = false, bool updateAnimationTier = true) override;
@@ -207,7 +220,7 @@ public:
     [[nodiscard]] uint32 GetScriptId() const;
 
     // override WorldObject function for proper name localization
-    [[nodiscard]] std::string const& GetNameForLocaleIdx(LocaleConstant locale_idx) const override;
+    [[nodiscard]] std::string_view GetNameForLocaleIdx(LocaleConstant locale_idx) const override;
 
     void setDeathState(DeathState s, bool despawn = false) override;                   // override virtual Unit::setDeathState
 
@@ -281,6 +294,8 @@ public:
     [[nodiscard]] time_t GetRespawnTimeEx() const;
     void SetRespawnTime(uint32 respawn);
     void Respawn(bool force = false);
+    //! Called by the map when the respawn queued for queuedTime is due, returns true if the creature came back
+    bool RespawnQueued(time_t queuedTime);
     void SaveRespawnTime() override;
 
     [[nodiscard]] uint32 GetRespawnDelay() const { return m_respawnDelay; }
@@ -439,6 +454,7 @@ protected:
     /// Timers
     time_t m_corpseRemoveTime;                          // (secs) timer for death or corpse disappearance
     time_t m_respawnTime;                               // (secs) time of next respawn
+    Optional<time_t> m_queuedRespawnTime;               // (secs) respawn time the map currently wakes us at
     time_t m_respawnedTime;                             // (secs) time when creature respawned
     uint32 m_respawnDelay;                              // (secs) delay between corpse disappearance and respawning
     uint32 m_corpseDelay;                               // (secs) delay between death and corpse disappearance
@@ -347,19 +347,19 @@ typedef std::unordered_map<uint16, CreatureBaseStats> CreatureBaseStatsContainer
 
 struct CreatureLocale
 {
-    std::vector<std::string> Name;
-    std::vector<std::string> Title;
+    LocaleStrings Name;
+    LocaleStrings Title;
 };
 
 struct GossipMenuItemsLocale
 {
-    std::vector<std::string> OptionText;
-    std::vector<std::string> BoxText;
+    LocaleStrings OptionText;
+    LocaleStrings BoxText;
 };
 
 struct PointOfInterestLocale
 {
-    std::vector<std::string> Name;
+    LocaleStrings Name;
 };
 
 struct EquipmentInfo
@@ -342,16 +342,31 @@ void CreatureGroup::FormationReset(bool dismiss, bool initMotionMaster)
     m_Formed = !dismiss;
 }
 
-void CreatureGroup::LeaderMoveTo(float x, float y, float z, uint32 move_type)
+void CreatureGroup::LeaderMoveTo(float x, float y, float z, uint32 move_type, Movement::PointsArray const* path /*= nullptr*/)
 {
-    //! To do: This should probably get its own movement generator or use WaypointMovementGenerator.
-    //! If the leader's path is known, member's path can be plotted as well using formation offsets.
     if (!m_leader)
         return;
 
-    float pathDist = m_leader->GetExactDist(x, y, z);
+    // members walk the leader's path shifted by their formation offset, nobody searches a path of its own
+    Movement::PointsArray leaderPath;
+    if (path && path->size() > 1)
+        leaderPath = *path;
+    else
+    {
+        leaderPath.emplace_back(m_leader->GetPositionX(), m_leader->GetPositionY(), m_leader->GetPositionZ());
+        leaderPath.emplace_back(x, y, z);
+    }
+
+    float pathDist = 0.0f;
+    for (std::size_t i = 1; i < leaderPath.size(); ++i)
+        pathDist += (leaderPath[i] - leaderPath[i - 1]).length();
+
+    if (pathDist < 0.1f)
+        return;
+
     float pathAngle = std::atan2(m_leader->GetPositionY() - y, m_leader->GetPositionX() - x);
 
+    Movement::PointsArray memberPath;
     for (auto const& itr : m_members)
     {
         Creature* member = itr.first;
@@ -375,15 +390,27 @@ void CreatureGroup::LeaderMoveTo(float x, float y, float z, uint32 move_type)
         }
 
         float const followDist = pFormationInfo.follow_dist;
+        float const offsetX = std::cos(followAngle + pathAngle) * followDist;
+        float const offsetY = std::sin(followAngle + pathAngle) * followDist;
+
+        // the member first steps into its slot next to the leader's start, then keeps it along the whole path
+        memberPath.clear();
+        memberPath.emplace_back(member->GetPositionX(), member->GetPositionY(), member->GetPositionZ());
+        float memberDist = 0.0f;
+        for (G3D::Vector3 const& point : leaderPath)
+        {
+            float dx = point.x + offsetX;
+            float dy = point.y + offsetY;
+            float dz = point.z;
 
-        float dx = x + std::cos(followAngle + pathAngle) * followDist;
-        float dy = y + std::sin(followAngle + pathAngle) * followDist;
-        float dz = z;
+            Acore::NormalizeMapCoord(dx);
+            Acore::NormalizeMapCoord(dy);
+            if (move_type < 2)
+                member->UpdateGroundPositionZ(dx, dy, dz);
 
-        Acore::NormalizeMapCoord(dx);
-        Acore::NormalizeMapCoord(dy);
-        if (move_type < 2)
-            member->UpdateGroundPositionZ(dx, dy, dz);
+            memberPath.emplace_back(dx, dy, dz);
+            memberDist += (memberPath.back() - memberPath[memberPath.size() - 2]).length();
+        }
 
         // pussywizard: setting the same movementflags is not enough, spline decides whether leader walks/runs, so spline param is now passed as "run" parameter to this function
         member->SetUnitMovementFlags(m_leader->GetUnitMovementFlags());
@@ -403,13 +430,14 @@ void CreatureGroup::LeaderMoveTo(float x, float y, float z, uint32 move_type)
         // xinef: if we move members to position without taking care of sizes, we should compare distance without sizes
         // xinef: change members speed basing on distance - if too far speed up, if too close slow down
         UnitMoveType const mtype = Movement::SelectSpeedType(member->GetUnitMovementFlags());
-        float const speedRate = m_leader->GetSpeedRate(mtype) * member->GetExactDist(dx, dy, dz) / pathDist;
+        float const speedRate = m_leader->GetSpeedRate(mtype) * memberDist / pathDist;
 
         if (speedRate > 0.01f) // don't move if speed rate is too low
         {
+            G3D::Vector3 const& dest = memberPath.back();
             member->SetSpeedRate(mtype, speedRate);
-            member->GetMotionMaster()->MovePoint(0, dx, dy, dz);
-            member->SetHomePosition(dx, dy, dz, pathAngle);
+            member->GetMotionMaster()->MovePoint(0, memberPath);
+            member->SetHomePosition(dest.x, dest.y, dest.z, pathAngle);
         }
     }
 }
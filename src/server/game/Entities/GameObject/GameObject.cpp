@@ -83,6 +83,46 @@ GameObject::~GameObject()
     //    CleanupsBeforeDelete();
 }
 
+typedef Acore::Impl::NodePool<sizeof(GameObject), 16> GameObjectPool;
+static std::atomic<uint64> GameObjectPoolAllocations{0};
+static std::atomic<uint64> GameObjectPoolObjects{0};
+
+void* GameObject::operator new(std::size_t size)
+{
+    ++GameObjectPoolAllocations;
+    if (size != sizeof(GameObject))
+        return ::operator new(size);
+
+    ++GameObjectPoolObjects;
+    return GameObjectPool::Allocate();
+}
+
+void GameObject::operator delete(void* ptr, std::size_t size)
+{
+    if (size != sizeof(GameObject))
+        ::operator delete(ptr);
+    else
+    {
+        --GameObjectPoolObjects;
+        GameObjectPool::Deallocate(ptr);
+    }
+}
+
+uint64 GameObject::TakePoolAllocationCount()
+{
+    return GameObjectPoolAllocations.exchange(0);
+}
+
+uint64 GameObject::GetPoolObjectCount()
+{
+    return GameObjectPoolObjects;
+}
+
+std::size_t GameObject::GetPoolReservedBytes()
+{
+    return GameObjectPool::ReservedBytes();
+}
+
 bool GameObject::AIM_Initialize()
 {
     if (m_AI)
@@ -2204,7 +2244,7 @@ uint32 GameObject::GetScriptId() const
 }
 
 // overwrite WorldObject function for proper name localization
-std::string const& GameObject::GetNameForLocaleIdx(LocaleConstant loc_idx) const
+std::string_view GameObject::GetNameForLocaleIdx(LocaleConstant loc_idx) const
 {
     if (loc_idx != DEFAULT_LOCALE)
     {
@@ -2755,81 +2795,78 @@ void GameObject::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* t
     if (GetOwnerGUID() == target->GetGUID())
         visibleFlag |= UF_FLAG_OWNER;
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildValuesUpdateMask(updateType, flags, visibleFlag, UF_FLAG_NONE, updateMask);
+    if (forcedFlags)
+        updateMask.SetBit(GAMEOBJECT_FLAGS);
+
+    for (uint32 index = updateMask.FindNextSetBit(0); index < m_valuesCount; index = updateMask.FindNextSetBit(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] ||
-                ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-                (index == GAMEOBJECT_FLAGS && forcedFlags))
+        if (index == GAMEOBJECT_DYNAMIC)
         {
-            updateMask.SetBit(index);
-
-            if (index == GAMEOBJECT_DYNAMIC)
+            uint16 dynFlags = 0;
+            int16 pathProgress = -1;
+            switch (GetGoType())
             {
-                uint16 dynFlags = 0;
-                int16 pathProgress = -1;
-                switch (GetGoType())
-                {
-                    case GAMEOBJECT_TYPE_QUESTGIVER:
-                        if (ActivateToQuest(target))
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_CHEST:
-                    case GAMEOBJECT_TYPE_GOOBER:
-                        if (ActivateToQuest(target))
-                        {
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                            if (sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
-                                dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        }
-                        else if (targetIsGM)
-                            dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
-                        break;
-                    case GAMEOBJECT_TYPE_SPELL_FOCUS:
-                    case GAMEOBJECT_TYPE_GENERIC:
-                        if (ActivateToQuest(target) && sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
+                case GAMEOBJECT_TYPE_QUESTGIVER:
+                    if (ActivateToQuest(target))
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_CHEST:
+                case GAMEOBJECT_TYPE_GOOBER:
+                    if (ActivateToQuest(target))
+                    {
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                        if (sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
                             dynFlags |= GO_DYNFLAG_LO_SPARKLE;
-                        break;
-                    case GAMEOBJECT_TYPE_TRANSPORT:
-                        if (const StaticTransport* t = ToStaticTransport())
-                            if (t->GetPauseTime())
+                    }
+                    else if (targetIsGM)
+                        dynFlags |= GO_DYNFLAG_LO_ACTIVATE;
+                    break;
+                case GAMEOBJECT_TYPE_SPELL_FOCUS:
+                case GAMEOBJECT_TYPE_GENERIC:
+                    if (ActivateToQuest(target) && sWorld->getBoolConfig(CONFIG_OBJECT_SPARKLES))
+                        dynFlags |= GO_DYNFLAG_LO_SPARKLE;
+                    break;
+                case GAMEOBJECT_TYPE_TRANSPORT:
+                    if (const StaticTransport* t = ToStaticTransport())
+                        if (t->GetPauseTime())
+                        {
+                            if (GetGoState() == GO_STATE_READY)
                             {
-                                if (GetGoState() == GO_STATE_READY)
-                                {
-                                    if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
-                                }
-                                else
-                                {
-                                    if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
-                                        pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
-                                }
+                                if (t->GetPathProgress() >= t->GetPauseTime()) // if not, send 100% progress
+                                    pathProgress = int16(float(t->GetPathProgress() - t->GetPauseTime()) / float(t->GetPeriod() - t->GetPauseTime()) * 65535.0f);
                             }
-                        // else it's ignored
-                        break;
-                    case GAMEOBJECT_TYPE_MO_TRANSPORT:
-                        if (const MotionTransport* t = ToMotionTransport())
-                            pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
-                        break;
-                    default:
-                        break;
-                }
-
-                fieldBuffer << uint16(dynFlags);
-                fieldBuffer << int16(pathProgress);
+                            else
+                            {
+                                if (t->GetPathProgress() <= t->GetPauseTime()) // if not, send 100% progress
+                                    pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPauseTime()) * 65535.0f);
+                            }
+                        }
+                    // else it's ignored
+                    break;
+                case GAMEOBJECT_TYPE_MO_TRANSPORT:
+                    if (const MotionTransport* t = ToMotionTransport())
+                        pathProgress = int16(float(t->GetPathProgress()) / float(t->GetPeriod()) * 65535.0f);
+                    break;
+                default:
+                    break;
             }
-            else if (index == GAMEOBJECT_FLAGS)
-            {
-                uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
-                if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
-                {
-                    goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
-                }
 
-                fieldBuffer << goFlags;
+            fieldBuffer << uint16(dynFlags);
+            fieldBuffer << int16(pathProgress);
+        }
+        else if (index == GAMEOBJECT_FLAGS)
+        {
+            uint32 goFlags = m_uint32Values[GAMEOBJECT_FLAGS];
+            if (GetGoType() == GAMEOBJECT_TYPE_CHEST && GetGOInfo() && GetGOInfo()->chest.groupLootRules && !IsLootAllowedFor(target))
+            {
+                goFlags |= GO_FLAG_LOCKED | GO_FLAG_NOT_SELECTABLE;
             }
-            else
-                fieldBuffer << m_uint32Values[index];                // other cases
+
+            fieldBuffer << goFlags;
         }
+        else
+            fieldBuffer << m_uint32Values[index];                // other cases
     }
 
     *data << uint8(updateMask.GetBlockCount());
@@ -124,6 +124,16 @@ public:
     explicit GameObject();
     ~GameObject() override;
 
+    // recycled through per thread pools, transports are allocated normally
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+    // GameObject allocations since the last call
+    static uint64 TakePoolAllocationCount();
+    // objects currently living in the pool
+    static uint64 GetPoolObjectCount();
+    // memory held by the pool, in use or free
+    static std::size_t GetPoolReservedBytes();
+
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) override;
 
     void AddToWorld() override;
@@ -154,7 +164,7 @@ public:
     [[nodiscard]] G3D::Quat GetWorldRotation() const;
 
     // overwrite WorldObject function for proper name localization
-    [[nodiscard]] std::string const& GetNameForLocaleIdx(LocaleConstant locale_idx) const override;
+    [[nodiscard]] std::string_view GetNameForLocaleIdx(LocaleConstant locale_idx) const override;
 
     void SaveToDB(bool saveAddon = false);
     void SaveToDB(uint32 mapid, uint8 spawnMask, uint32 phaseMask, bool saveAddon = false);
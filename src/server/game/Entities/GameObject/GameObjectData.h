@@ -19,6 +19,7 @@
 #define GAMEOBJECTDATA_H
 
 #include "Common.h"
+#include "LocalizedQueryData.h"
 #include "SharedDefines.h"
 #include "WorldPacket.h"
 #include <string>
@@ -393,6 +394,10 @@ struct GameObjectTemplate
     std::string AIName;
     uint32 ScriptId;
     bool IsForQuests; // pussywizard
+    LocalizedQueryData QueryData;           // SMSG_GAMEOBJECT_QUERY_RESPONSE, built by ObjectMgr::InitializeQueriesData
+
+    [[nodiscard]] WorldPacket BuildQueryData(LocaleConstant locale) const;
+    void InitializeQueryData();
 
     // helpers
     [[nodiscard]] bool IsDespawnAtAction() const
@@ -673,8 +678,8 @@ struct GameObjectTemplateAddon
 
 struct GameObjectLocale
 {
-    std::vector<std::string> Name;
-    std::vector<std::string> CastBarCaption;
+    LocaleStrings Name;
+    LocaleStrings CastBarCaption;
 };
 
 // `gameobject_addon` table
@@ -21,6 +21,7 @@
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "UpdateData.h"
+#include <bit>
 
 Bag::Bag(): Item()
 {
@@ -30,6 +31,7 @@ Bag::Bag(): Item()
     m_valuesCount = CONTAINER_END;
 
     memset(m_bagslot, 0, sizeof(Item*) * MAX_BAG_SIZE);
+    m_usedSlotMask = 0;
 }
 
 Bag::~Bag()
@@ -94,6 +96,7 @@ bool Bag::Create(ObjectGuid::LowType guidlow, uint32 itemid, Player const* owner
         SetGuidValue(CONTAINER_FIELD_SLOT_1 + (i * 2), ObjectGuid::Empty);
         m_bagslot[i] = nullptr;
     }
+    m_usedSlotMask = 0;
 
     return true;
 }
@@ -117,6 +120,7 @@ bool Bag::LoadFromDB(ObjectGuid::LowType guid, ObjectGuid owner_guid, Field* fie
         delete m_bagslot[i];
         m_bagslot[i] = nullptr;
     }
+    m_usedSlotMask = 0;
 
     return true;
 }
@@ -132,12 +136,7 @@ void Bag::DeleteFromDB(CharacterDatabaseTransaction trans)
 
 uint32 Bag::GetFreeSlots() const
 {
-    uint32 slots = 0;
-    for (uint32 i = 0; i < GetBagSize(); ++i)
-        if (!m_bagslot[i])
-            ++slots;
-
-    return slots;
+    return std::popcount(GetFreeSlotMask());
 }
 
 void Bag::RemoveItem(uint8 slot, bool /*update*/)
@@ -148,6 +147,7 @@ void Bag::RemoveItem(uint8 slot, bool /*update*/)
         m_bagslot[slot]->SetContainer(nullptr);
 
     m_bagslot[slot] = nullptr;
+    m_usedSlotMask &= ~(uint64(1) << slot);
     SetGuidValue(CONTAINER_FIELD_SLOT_1 + (slot * 2), ObjectGuid::Empty);
 }
 
@@ -158,6 +158,7 @@ void Bag::StoreItem(uint8 slot, Item* pItem, bool /*update*/)
     if (pItem && pItem->GetGUID() != this->GetGUID())
     {
         m_bagslot[slot] = pItem;
+        m_usedSlotMask |= uint64(1) << slot;
         SetGuidValue(CONTAINER_FIELD_SLOT_1 + (slot * 2), pItem->GetGUID());
         pItem->SetGuidValue(ITEM_FIELD_CONTAINED, GetGUID());
         pItem->SetGuidValue(ITEM_FIELD_OWNER, GetOwnerGUID());
@@ -178,11 +179,7 @@ void Bag::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target)
 // If the bag is empty returns true
 bool Bag::IsEmpty() const
 {
-    for (uint32 i = 0; i < GetBagSize(); ++i)
-        if (m_bagslot[i])
-            return false;
-
-    return true;
+    return !m_usedSlotMask;
 }
 
 uint32 Bag::GetItemCount(uint32 item, Item* eItem) const
@@ -47,6 +47,10 @@ public:
     [[nodiscard]] uint32 GetFreeSlots() const;
     [[nodiscard]] uint32 GetBagSize() const { return GetUInt32Value(CONTAINER_FIELD_NUM_SLOTS); }
 
+    // bit i is set while slot i holds an item, lets storage checks skip straight to the used or free slots
+    [[nodiscard]] uint64 GetUsedSlotMask() const { return m_usedSlotMask; }
+    [[nodiscard]] uint64 GetFreeSlotMask() const { return ~m_usedSlotMask & ((uint64(1) << GetBagSize()) - 1); }
+
     // DB operations
     // overwrite virtual Item::SaveToDB
     void SaveToDB(CharacterDatabaseTransaction trans) override;
@@ -62,6 +66,7 @@ public:
 protected:
     // Bag Storage space
     Item* m_bagslot[MAX_BAG_SIZE];
+    uint64 m_usedSlotMask;
 };
 
 inline Item* NewItemOrBag(ItemTemplate const* proto)
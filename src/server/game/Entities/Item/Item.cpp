@@ -270,7 +270,11 @@ Item::Item()
     m_slot = 0;
     uState = ITEM_NEW;
     uQueuePos = -1;
+    m_changedFields = ITEM_CHANGED_FIELD_ALL;
     m_container = nullptr;
+    m_countIndexOwner = nullptr;
+    m_indexedCount = 0;
+    m_indexedInBank = false;
     m_lootGenerated = false;
     mb_in_trade = false;
     m_lastPlayedTimeUpdate = GameTime::GetGameTime().count();
@@ -346,6 +350,16 @@ void Item::SaveToDB(CharacterDatabaseTransaction trans)
         case ITEM_NEW:
         case ITEM_CHANGED:
             {
+                // durability loss and repairs don't need the whole row rewritten
+                if (HasOnlyChangedFields(ITEM_CHANGED_FIELD_DURABILITY))
+                {
+                    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_INSTANCE_DURABILITY);
+                    stmt->SetData(0, GetUInt32Value(ITEM_FIELD_DURABILITY));
+                    stmt->SetData(1, guid);
+                    trans->Append(stmt);
+                    break;
+                }
+
                 uint8 index = 0;
                 CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(uState == ITEM_NEW ? CHAR_REP_ITEM_INSTANCE : CHAR_UPD_ITEM_INSTANCE);
                 stmt->SetData(  index, GetEntry());
@@ -712,7 +726,15 @@ void Item::UpdateItemSuffixFactor()
     SetUInt32Value(ITEM_FIELD_PROPERTY_SEED, suffixFactor);
 }
 
-void Item::SetState(ItemUpdateState state, Player* forplayer)
+void Item::SetCount(uint32 value)
+{
+    SetUInt32Value(ITEM_FIELD_STACK_COUNT, value);
+
+    if (m_countIndexOwner)
+        m_countIndexOwner->UpdateItemCountIndex(this);
+}
+
+void Item::SetState(ItemUpdateState state, Player* forplayer, uint8 changedFields)
 {
     if (uState == ITEM_NEW && state == ITEM_REMOVED)
     {
@@ -729,7 +751,11 @@ void Item::SetState(ItemUpdateState state, Player* forplayer)
     {
         // new items must stay in new state until saved
         if (uState != ITEM_NEW)
+        {
+            // fields accumulate until the next save, any other state rewrites the whole row
+            m_changedFields = (uState == ITEM_UNCHANGED ? 0 : m_changedFields) | (state == ITEM_CHANGED ? changedFields : ITEM_CHANGED_FIELD_ALL);
             uState = state;
+        }
         if (forplayer)
             AddToUpdateQueueOf(forplayer);
     }
@@ -739,6 +765,7 @@ void Item::SetState(ItemUpdateState state, Player* forplayer)
         // the item must be removed from the queue manually
         uQueuePos = -1;
         uState = ITEM_UNCHANGED;
+        m_changedFields = 0;
     }
 }
 
@@ -206,6 +206,13 @@ enum ItemUpdateState
     ITEM_REMOVED                                 = 3
 };
 
+// Columns of an ITEM_CHANGED item that differ from its item_instance row
+enum ItemChangedFields : uint8
+{
+    ITEM_CHANGED_FIELD_DURABILITY                = 0x01,
+    ITEM_CHANGED_FIELD_ALL                       = 0xFF
+};
+
 #define MAX_ITEM_SPELLS 5
 
 bool ItemCanGoIntoBag(ItemTemplate const* proto, ItemTemplate const* pBagProto);
@@ -261,7 +268,7 @@ public:
     [[nodiscard]] bool GemsFitSockets() const;
 
     [[nodiscard]] uint32 GetCount() const { return GetUInt32Value(ITEM_FIELD_STACK_COUNT); }
-    void SetCount(uint32 value) { SetUInt32Value(ITEM_FIELD_STACK_COUNT, value); }
+    void SetCount(uint32 value);
     [[nodiscard]] uint32 GetMaxStackCount() const { return GetTemplate()->GetMaxStackSize(); }
     // Checks if this item has sockets, whether built-in or added by an upgrade.
     [[nodiscard]] bool HasSocket() const;
@@ -277,6 +284,12 @@ public:
     void SetContainer(Bag* container) { m_container = container; }
 
     [[nodiscard]] bool IsInBag() const { return m_container != nullptr; }
+
+    // set while the stack is counted in the item count index of its owner, see Player::AddToItemCountIndex
+    [[nodiscard]] Player* GetCountIndexOwner() const { return m_countIndexOwner; }
+    [[nodiscard]] uint32 GetIndexedCount() const { return m_indexedCount; }
+    [[nodiscard]] bool IsIndexedInBank() const { return m_indexedInBank; }
+    void SetCountIndexState(Player* owner, uint32 count, bool inBank) { m_countIndexOwner = owner; m_indexedCount = count; m_indexedInBank = inBank; }
     [[nodiscard]] bool IsEquipped() const;
 
     uint32 GetSkill();
@@ -313,7 +326,9 @@ public:
 
     // Update States
     [[nodiscard]] ItemUpdateState GetState() const { return uState; }
-    void SetState(ItemUpdateState state, Player* forplayer = nullptr);
+    void SetState(ItemUpdateState state, Player* forplayer = nullptr, uint8 changedFields = ITEM_CHANGED_FIELD_ALL);
+    // true if the item only needs the given columns written to its existing row
+    [[nodiscard]] bool HasOnlyChangedFields(uint8 fields) const { return uState == ITEM_CHANGED && !(m_changedFields & ~fields); }
     void AddToUpdateQueueOf(Player* player);
     void RemoveFromUpdateQueueOf(Player* player);
     [[nodiscard]] bool IsInUpdateQueue() const { return uQueuePos != -1; }
@@ -321,6 +336,7 @@ public:
     void FSetState(ItemUpdateState state)               // forced
     {
         uState = state;
+        m_changedFields = state == ITEM_UNCHANGED ? 0 : ITEM_CHANGED_FIELD_ALL;
     }
 
     [[nodiscard]] bool hasQuest(uint32 quest_id) const override { return GetTemplate()->StartQuest == quest_id; }
@@ -359,8 +375,12 @@ private:
     std::string m_text;
     uint8 m_slot;
     Bag* m_container;
+    Player* m_countIndexOwner;
+    uint32 m_indexedCount;
+    bool m_indexedInBank;
     ItemUpdateState uState;
     int32 uQueuePos;
+    uint8 m_changedFields;
     bool mb_in_trade;                                   // true if item is currently in trade-window
     time_t m_lastPlayedTimeUpdate;
     uint32 m_refundRecipient;
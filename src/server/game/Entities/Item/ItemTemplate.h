@@ -841,8 +841,8 @@ typedef std::unordered_map<uint32, ItemTemplate> ItemTemplateContainer;
 
 struct ItemLocale
 {
-    std::vector<std::string> Name;
-    std::vector<std::string> Description;
+    LocaleStrings Name;
+    LocaleStrings Description;
 };
 
 struct ItemSetNameEntry
@@ -853,7 +853,7 @@ struct ItemSetNameEntry
 
 struct ItemSetNameLocale
 {
-    std::vector<std::string> Name;
+    LocaleStrings Name;
 };
 
 #endif
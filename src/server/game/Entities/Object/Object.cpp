@@ -25,6 +25,7 @@
 #include "GameObjectAI.h"
 #include "GameTime.h"
 #include "GridNotifiers.h"
+#include "IVMapMgr.h"
 #include "Log.h"
 #include "MapMgr.h"
 #include "MiscPackets.h"
@@ -79,6 +80,7 @@ Object::Object() : m_PackGUID(sizeof(uint64) + 1)
 
     m_inWorld           = false;
     m_objectUpdated     = false;
+    m_updateQueueIndex  = 0;
 
     sScriptMgr->OnConstructObject(this);
 }
@@ -238,7 +240,12 @@ void Object::BuildCreateUpdateBlockForPlayer(UpdateData* data, Player* target)
     buf << GetPackGUID();
     buf << (uint8)m_objectTypeId;
 
-    BuildMovementUpdate(&buf, flags);
+    // units share the movement block between the viewers they are created for in the same tick
+    if (isType(TYPEMASK_UNIT))
+        ((Unit*)this)->BuildCachedMovementUpdate(&buf, flags);
+    else
+        BuildMovementUpdate(&buf, flags);
+
     BuildValuesUpdate(updatetype, &buf, target);
     data->AddUpdateBlock(buf);
 }
@@ -505,22 +512,49 @@ void Object::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* targe
 
     uint32* flags = nullptr;
     uint32 visibleFlag = GetUpdateFieldData(target, flags);
+    BuildValuesUpdateMask(updateType, flags, visibleFlag, UF_FLAG_NONE, updateMask);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
-    {
-        if (_fieldNotifyFlags & flags[index] ||
-                ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)))
-        {
-            updateMask.SetBit(index);
-            fieldBuffer << m_uint32Values[index];
-        }
-    }
+    for (uint32 index = updateMask.FindNextSetBit(0); index < m_valuesCount; index = updateMask.FindNextSetBit(index + 1))
+        fieldBuffer << m_uint32Values[index];
 
     *data << uint8(updateMask.GetBlockCount());
     updateMask.AppendToPacket(data);
     data->append(fieldBuffer);
 }
 
+void Object::BuildValuesUpdateMask(uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 forcedFlag, UpdateMask& updateMask) const
+{
+    uint32 const* visibleMask = GetUpdateFieldVisibilityMask(flags, visibleFlag);
+    uint32 const* forcedMask = GetUpdateFieldVisibilityMask(flags, _fieldNotifyFlags | forcedFlag);
+
+    for (uint32 block = 0; block < updateMask.GetBlockCount(); ++block)
+    {
+        uint32 fields = visibleMask[block];
+        if (updateType == UPDATETYPE_VALUES)
+            fields &= _changesMask.GetBlock(block);
+        else
+        {
+            // object creation sends every visible field that is set
+            for (uint32 candidates = fields; candidates; candidates &= candidates - 1)
+            {
+                uint32 const bit = std::countr_zero(candidates);
+                uint32 const index = block * UpdateMask::CLIENT_UPDATE_MASK_BITS + bit;
+                if (index >= m_valuesCount || !m_uint32Values[index])
+                    fields &= ~(1u << bit);
+            }
+        }
+
+        fields |= forcedMask[block];
+
+        // the flag tables are shared by objects of different sizes, e.g. creatures use the first UNIT_END player fields
+        uint32 const blockEnd = (block + 1) * UpdateMask::CLIENT_UPDATE_MASK_BITS;
+        if (blockEnd > m_valuesCount)
+            fields &= (1u << (m_valuesCount % UpdateMask::CLIENT_UPDATE_MASK_BITS)) - 1;
+
+        updateMask.SetBlock(block, fields);
+    }
+}
+
 void Object::AddToObjectUpdateIfNeeded()
 {
     if (m_inWorld && !m_objectUpdated)
@@ -660,6 +694,20 @@ void Object::SetUInt32Value(uint16 index, uint32 value)
     }
 }
 
+void Object::SetEntry(uint32 entry)
+{
+    uint32 const oldEntry = GetEntry();
+    SetUInt32Value(OBJECT_FIELD_ENTRY, entry);
+
+    // keep the map's entry index in sync, scripts change creature entries on the fly
+    if (oldEntry != entry && IsInWorld())
+        if (Creature* creature = ToCreature())
+        {
+            creature->GetMap()->RemoveFromCreatureEntryIndex(creature, oldEntry);
+            creature->GetMap()->AddToCreatureEntryIndex(creature, entry);
+        }
+}
+
 void Object::UpdateUInt32Value(uint16 index, uint32 value)
 {
     ASSERT(index < m_valuesCount || PrintIndexError(index, true));
@@ -1047,10 +1095,13 @@ void MovementInfo::OutDebug()
         LOG_INFO("movement", "splineElevation: {}", splineElevation);
 }
 
+std::atomic<uint64> WorldObject::_visibilityStampCounter(0);
+
 WorldObject::WorldObject(bool isWorldObject) : WorldLocation(),
     LastUsedScriptID(0), m_name(""), m_isActive(false), m_visibilityDistanceOverride(), m_isWorldObject(isWorldObject), m_zoneScript(nullptr),
     _zoneId(0), _areaId(0), _floorZ(INVALID_HEIGHT), _outdoors(false), _liquidData(), _updatePositionData(false), m_transport(nullptr),
-    m_currMap(nullptr), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL), m_useCombinedPhases(true), m_notifyflags(0), m_executed_notifies(0)
+    m_currMap(nullptr), m_InstanceId(0), m_phaseMask(PHASEMASK_NORMAL), m_useCombinedPhases(true), m_notifyflags(0), m_executed_notifies(0),
+    m_visibilityStamp(NewVisibilityStamp()), m_inRemoveList(false)
 {
     m_serverSideVisibility.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE | GHOST_VISIBILITY_GHOST);
     m_serverSideVisibilityDetect.SetValue(SERVERSIDE_VISIBILITY_GHOST, GHOST_VISIBILITY_ALIVE);
@@ -1327,19 +1378,9 @@ bool WorldObject::IsWithinLOS(float ox, float oy, float oz, VMAP::ModelIgnoreFla
 {
     if (IsInWorld())
     {
-        oz += GetCollisionHeight();
-        float x, y, z;
-        if (GetTypeId() == TYPEID_PLAYER)
-        {
-            GetPosition(x, y, z);
-            z += GetCollisionHeight();
-        }
-        else
-        {
-            GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
-        }
-
-        return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks, ignoreFlags);
+        VMAP::LineOfSightQuery query;
+        GetLineOfSightSegment(ox, oy, oz, query);
+        return GetMap()->isInLineOfSight(query.X1, query.Y1, query.Z1, query.X2, query.Y2, query.Z2, GetPhaseMask(), checks, ignoreFlags);
     }
     return true;
 }
@@ -1349,6 +1390,30 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlag
    if (!IsInMap(obj))
         return false;
 
+    VMAP::LineOfSightQuery query;
+    GetLineOfSightSegment(obj, query, collisionHeight, combatReach);
+    return GetMap()->isInLineOfSight(query.X1, query.Y1, query.Z1, query.X2, query.Y2, query.Z2, GetPhaseMask(), checks, ignoreFlags);
+}
+
+void WorldObject::GetLineOfSightSegment(float ox, float oy, float oz, VMAP::LineOfSightQuery& query) const
+{
+    oz += GetCollisionHeight();
+    float x, y, z;
+    if (GetTypeId() == TYPEID_PLAYER)
+    {
+        GetPosition(x, y, z);
+        z += GetCollisionHeight();
+    }
+    else
+    {
+        GetHitSpherePointFor({ ox, oy, oz }, x, y, z);
+    }
+
+    query = { x, y, z, ox, oy, oz };
+}
+
+void WorldObject::GetLineOfSightSegment(WorldObject const* obj, VMAP::LineOfSightQuery& query, Optional<float> collisionHeight /*= { }*/, Optional<float> combatReach /*= { }*/) const
+{
     float ox, oy, oz;
     if (obj->GetTypeId() == TYPEID_PLAYER)
     {
@@ -1367,7 +1432,7 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlag
     else
         GetHitSpherePointFor({ obj->GetPositionX(), obj->GetPositionY(), obj->GetPositionZ() + obj->GetCollisionHeight() }, x, y, z, collisionHeight, combatReach);
 
-    return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks, ignoreFlags);
+    query = { x, y, z, ox, oy, oz };
 }
 
 void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z, Optional<float> collisionHeight, Optional<float> combatReach) const
@@ -1561,6 +1626,47 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* grou
         return;
     }
 
+    float floorZ = GetMap()->GetHeight(GetPhaseMask(), x, y, GetAllowedPositionSearchZ(z), true, DEFAULT_HEIGHT_SEARCH);
+    ApplyAllowedPositionZ(x, y, z, floorZ, groundZ);
+}
+
+void WorldObject::UpdateAllowedPositionZ(std::vector<G3D::Vector3>& points) const
+{
+    if (GetTransport() || points.empty())
+        return;
+
+    std::vector<VMAP::HeightQuery> queries;
+    queries.reserve(points.size());
+    for (G3D::Vector3 const& point : points)
+        queries.push_back({ point.x, point.y, GetAllowedPositionSearchZ(point.z) });
+
+    GetMap()->GetHeight(GetPhaseMask(), queries, true, DEFAULT_HEIGHT_SEARCH);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+        ApplyAllowedPositionZ(points[i].x, points[i].y, points[i].z, queries[i].Height, nullptr);
+}
+
+float WorldObject::GetAllowedPositionSearchZ(float z) const
+{
+    // swimming units look for the floor the way GetMapWaterOrGroundLevel does, everything else like GetMapHeight
+    if (Unit const* unit = ToUnit())
+    {
+        if (!unit->CanFly())
+        {
+            Creature const* c = unit->ToCreature();
+            if (c ? c->CanSwim() : true)
+                return z + Z_OFFSET_FIND_HEIGHT;
+        }
+    }
+
+    if (z != MAX_HEIGHT)
+        z += std::max(GetCollisionHeight(), Z_OFFSET_FIND_HEIGHT);
+
+    return z;
+}
+
+void WorldObject::ApplyAllowedPositionZ(float x, float y, float& z, float floorZ, float* groundZ) const
+{
     if (Unit const* unit = ToUnit())
     {
         if (!unit->CanFly())
@@ -1568,11 +1674,17 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* grou
             Creature const* c = unit->ToCreature();
             bool canSwim = c ? c->CanSwim() : true;
             float ground_z = z;
-            float max_z;
+            float max_z = VMAP_INVALID_HEIGHT_VALUE;
             if (canSwim)
-                max_z = GetMapWaterOrGroundLevel(x, y, z, &ground_z);
+            {
+                if (GetMap()->GetGrid(x, y))
+                {
+                    ground_z = floorZ;
+                    max_z = GetMap()->GetWaterOrGroundLevelAboveFloor(GetPhaseMask(), x, y, floorZ, std::max(GetCollisionHeight(), Z_OFFSET_FIND_HEIGHT));
+                }
+            }
             else
-                max_z = ground_z = GetMapHeight(x, y, z);
+                max_z = ground_z = floorZ;
 
             if (max_z > INVALID_HEIGHT)
             {
@@ -1601,7 +1713,7 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* grou
         }
         else
         {
-            float ground_z = GetMapHeight(x, y, z) + unit->GetHoverHeight();
+            float ground_z = floorZ + unit->GetHoverHeight();
             if (z < ground_z)
                 z = ground_z;
 
@@ -1611,7 +1723,7 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float& z, float* grou
     }
     else
     {
-        float ground_z = GetMapHeight(x, y, z);
+        float ground_z = floorZ;
         if (ground_z > INVALID_HEIGHT)
             z = ground_z;
 
@@ -1744,7 +1856,7 @@ bool WorldObject::CanSeeOrDetect(WorldObject const* obj, bool ignoreStealth, boo
                 return false;
             }
 
-            ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_CREATURE_VISIBILITY, cObj->GetEntry());
+            ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_CREATURE_VISIBILITY, cObj->GetEntry());
             if (!sConditionMgr->IsObjectMeetToConditions((WorldObject*)this, (WorldObject*)obj, conditions))
             {
                 return false;
@@ -2086,6 +2198,32 @@ void WorldObject::SendMessageToSetInRange(WorldPacket const* data, float dist, b
     Cell::VisitWorldObjects(this, notifier, dist);
 }
 
+uint32 WorldObject::SendMessagesToSet(std::vector<std::shared_ptr<WorldPacket const>> const& messages, bool self, float dist /*= 0.0f*/) const
+{
+    if (!IsInWorld() || messages.empty())
+        return 0;
+
+    uint32 delivered = 0;
+    if (self)
+    {
+        if (Player const* player = ToPlayer())
+        {
+            for (std::shared_ptr<WorldPacket const> const& message : messages)
+                player->GetSession()->SendPacket(message);
+
+            delivered += messages.size();
+        }
+    }
+
+    float const visibilityDist = GetVisibilityRange() + GetObjectSize() + VISIBILITY_COMPENSATION;
+    if (dist <= 0.0f || dist > visibilityDist)
+        dist = visibilityDist;
+
+    Acore::MessageDistDeliverer notifier(this, messages, dist);
+    Cell::VisitWorldObjects(this, notifier, dist);
+    return delivered + notifier.i_delivered;
+}
+
 void WorldObject::SendObjectDeSpawnAnim(ObjectGuid guid)
 {
     WorldPacket data(SMSG_GAMEOBJECT_DESPAWN_ANIM, 8);
@@ -2487,6 +2625,9 @@ void WorldObject::GetGameObjectListWithEntryInGrid(std::list<GameObject*>& gameo
 
 void WorldObject::GetCreatureListWithEntryInGrid(std::list<Creature*>& creatureList, uint32 entry, float maxSearchRange) const
 {
+    if (GetMap()->GetCreaturesWithEntryInRange(creatureList, this, entry, maxSearchRange))
+        return;
+
     Acore::AllCreaturesOfEntryInRange check(this, entry, maxSearchRange);
     Acore::CreatureListSearcher<Acore::AllCreaturesOfEntryInRange> searcher(this, creatureList, check);
     Cell::VisitGridObjects(this, searcher, maxSearchRange);
@@ -2862,6 +3003,7 @@ void WorldObject::SetPhaseMask(uint32 newPhaseMask, bool update)
 {
     sScriptMgr->OnBeforeWorldObjectSetPhaseMask(this, m_phaseMask, newPhaseMask, m_useCombinedPhases, update);
     m_phaseMask = newPhaseMask;
+    MarkVisibilityStateChanged();
 
     if (update && IsInWorld())
         UpdateObjectVisibility();
@@ -2956,6 +3098,8 @@ void WorldObject::DestroyForNearbyPlayers()
 
 void WorldObject::UpdateObjectVisibility(bool /*forced*/, bool /*fromUpdate*/)
 {
+    MarkVisibilityStateChanged();
+
     //updates object's visibility for nearby players
     Acore::VisibleChangesNotifier notifier(*this);
     Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
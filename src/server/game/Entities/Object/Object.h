@@ -31,6 +31,7 @@
 #include "Position.h"
 #include "UpdateData.h"
 #include "UpdateMask.h"
+#include <atomic>
 #include <set>
 #include <sstream>
 #include <string>
@@ -107,7 +108,7 @@ public:
     [[nodiscard]] ObjectGuid GetGUID() const { return GetGuidValue(OBJECT_FIELD_GUID); }
     [[nodiscard]] PackedGuid const& GetPackGUID() const { return m_PackGUID; }
     [[nodiscard]] uint32 GetEntry() const { return GetUInt32Value(OBJECT_FIELD_ENTRY); }
-    void SetEntry(uint32 entry) { SetUInt32Value(OBJECT_FIELD_ENTRY, entry); }
+    void SetEntry(uint32 entry);
 
     [[nodiscard]] float GetObjectScale() const { return GetFloatValue(OBJECT_FIELD_SCALE_X); }
     virtual void SetObjectScale(float scale) { SetFloatValue(OBJECT_FIELD_SCALE_X, scale); }
@@ -178,6 +179,10 @@ public:
 
     void ClearUpdateMask(bool remove);
 
+    // position in the map's update queue while m_objectUpdated is set, see Map::AddUpdateObject
+    [[nodiscard]] uint32 GetUpdateQueueIndex() const { return m_updateQueueIndex; }
+    void SetUpdateQueueIndex(uint32 index) { m_updateQueueIndex = index; }
+
     [[nodiscard]] uint16 GetValuesCount() const { return m_valuesCount; }
 
     [[nodiscard]] virtual bool hasQuest(uint32 /* quest_id */) const { return false; }
@@ -224,6 +229,8 @@ protected:
 
     void BuildMovementUpdate(ByteBuffer* data, uint16 flags) const;
     virtual void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target);
+    // fields a viewer with visibleFlag gets in a values update, forcedFlag fields are sent even if unchanged
+    void BuildValuesUpdateMask(uint8 updateType, uint32 const* flags, uint32 visibleFlag, uint32 forcedFlag, UpdateMask& updateMask) const;
 
     uint16 m_objectType;
 
@@ -248,6 +255,7 @@ protected:
     void AddToObjectUpdateIfNeeded();
 
     bool m_objectUpdated;
+    uint32 m_updateQueueIndex;
 
 private:
     bool m_inWorld;
@@ -424,6 +432,8 @@ public:
     [[nodiscard]] virtual float GetCombatReach() const { return 0.0f; } // overridden (only) in Unit
     void UpdateGroundPositionZ(float x, float y, float& z) const;
     void UpdateAllowedPositionZ(float x, float y, float& z, float* groundZ = nullptr) const;
+    // same as above for a whole path, the floor heights are resolved in one batched map query
+    void UpdateAllowedPositionZ(std::vector<G3D::Vector3>& points) const;
 
     void GetRandomPoint(const Position& srcPos, float distance, float& rand_x, float& rand_y, float& rand_z) const;
     [[nodiscard]] Position GetRandomPoint(const Position& srcPos, float distance) const;
@@ -446,7 +456,7 @@ public:
     [[nodiscard]] std::string const& GetName() const { return m_name; }
     void SetName(std::string const& newname) { m_name = newname; }
 
-    [[nodiscard]] virtual std::string const& GetNameForLocaleIdx(LocaleConstant /*locale_idx*/) const { return m_name; }
+    [[nodiscard]] virtual std::string_view GetNameForLocaleIdx(LocaleConstant /*locale_idx*/) const { return m_name; }
 
     float GetDistance(WorldObject const* obj) const;
     [[nodiscard]] float GetDistance(const Position& pos) const;
@@ -466,6 +476,9 @@ public:
     bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool useBoundingRadius = true) const;
     [[nodiscard]] bool IsWithinLOS(float x, float y, float z, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
     [[nodiscard]] bool IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
+    // the segments IsWithinLOS and IsWithinLOSInMap check, for batched Map::isInLineOfSight calls
+    void GetLineOfSightSegment(float x, float y, float z, VMAP::LineOfSightQuery& query) const;
+    void GetLineOfSightSegment(WorldObject const* obj, VMAP::LineOfSightQuery& query, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
     [[nodiscard]] Position GetHitSpherePointFor(Position const& dest, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
     void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
     bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
@@ -482,6 +495,9 @@ public:
     virtual void SendMessageToSet(WorldPacket const* data, bool self) const { if (IsInWorld()) SendMessageToSetInRange(data, GetVisibilityRange(), self, true); } // pussywizard!
     virtual void SendMessageToSetInRange(WorldPacket const* data, float dist, bool /*self*/, bool includeMargin = false, Player const* skipped_rcvr = nullptr) const; // pussywizard!
     virtual void SendMessageToSet(WorldPacket const* data, Player const* skipped_rcvr) const { if (IsInWorld()) SendMessageToSetInRange(data, GetVisibilityRange(), false, true, skipped_rcvr); } // pussywizard!
+    // same receivers as SendMessageToSet, but one grid search for all packets
+    // returns the number of packets queued to receivers, dist 0 (or beyond visibility) means visibility range
+    uint32 SendMessagesToSet(std::vector<std::shared_ptr<WorldPacket const>> const& messages, bool self, float dist = 0.0f) const;
 
     virtual uint8 getLevelForTarget(WorldObject const* /*target*/) const { return 1; }
 
@@ -495,6 +511,8 @@ public:
 
     virtual void SaveRespawnTime() {}
     void AddObjectToRemoveList();
+    [[nodiscard]] bool IsInRemoveList() const { return m_inRemoveList; }
+    void SetInRemoveList(bool inRemoveList) { m_inRemoveList = inRemoveList; }
 
     [[nodiscard]] float GetGridActivationRange() const;
     [[nodiscard]] float GetVisibilityRange() const;
@@ -559,6 +577,13 @@ public:
     void SetNotified(uint16 f) { m_executed_notifies |= f;}
     void ResetAllNotifies() { m_notifyflags = 0; m_executed_notifies = 0; }
 
+    // Stamps taken from one world wide counter, an object's stamp is renewed whenever something that decides
+    // who can see it changes (phase, stealth, server side visibility, ...), see Acore::VisibleNotifier
+    void MarkVisibilityStateChanged() { m_visibilityStamp.store(NewVisibilityStamp(), std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetVisibilityStamp() const { return m_visibilityStamp.load(std::memory_order_relaxed); }
+    static uint64 NewVisibilityStamp() { return ++_visibilityStampCounter; }
+    [[nodiscard]] bool IsVisibilityStateUnchangedSince(uint64 stamp) const { return GetVisibilityStamp() <= stamp && !IsInvisibleDueToDespawn(); }
+
     [[nodiscard]] bool isActiveObject() const { return m_isActive; }
     void setActive(bool isActiveObject);
     [[nodiscard]] bool IsFarVisible() const { return m_isFarVisible; }
@@ -653,6 +678,10 @@ protected:
     //difference from IsAlwaysVisibleFor: 1. after distance check; 2. use owner or charmer as seer
     virtual bool IsAlwaysDetectableFor(WorldObject const* /*seer*/) const { return false; }
 private:
+    // shared parts of UpdateAllowedPositionZ, the z to search the floor from and the clamp against that floor
+    [[nodiscard]] float GetAllowedPositionSearchZ(float z) const;
+    void ApplyAllowedPositionZ(float x, float y, float& z, float floorZ, float* groundZ) const;
+
     Map* m_currMap;                                    //current object's Map location
 
     //uint32 m_mapId;                                     // object at map with map_id
@@ -664,6 +693,10 @@ private:
     uint16 m_notifyflags;
     uint16 m_executed_notifies;
 
+    std::atomic<uint64> m_visibilityStamp;
+    bool m_inRemoveList;
+    static std::atomic<uint64> _visibilityStampCounter;
+
     virtual bool _IsWithinDist(WorldObject const* obj, float dist2compare, bool is3D, bool useBoundingRadius = true) const;
 
     bool CanNeverSee(WorldObject const* obj) const;
@@ -20,6 +20,7 @@
 
 #include "ByteBuffer.h"
 #include "Define.h"
+#include "FlatHashContainers.h"
 #include <deque>
 #include <functional>
 #include <list>
@@ -257,6 +258,7 @@ typedef std::list<ObjectGuid> GuidList;
 typedef std::deque<ObjectGuid> GuidDeque;
 typedef std::vector<ObjectGuid> GuidVector;
 typedef std::unordered_set<ObjectGuid> GuidUnorderedSet;
+typedef Acore::FlatHashSet<ObjectGuid> GuidFlatSet;
 
 // minimum buffer size for packed guid is 9 bytes
 #define PACKED_GUID_MIN_BUFFER_SIZE 9
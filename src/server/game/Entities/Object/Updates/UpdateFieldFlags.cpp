@@ -16,6 +16,10 @@
  */
 
 #include "UpdateFieldFlags.h"
+#include "Errors.h"
+#include "UpdateMask.h"
+#include <array>
+#include <vector>
 
 uint32 ItemUpdateFieldFlags[CONTAINER_END] =
 {
@@ -1566,3 +1570,44 @@ uint32 CorpseUpdateFieldFlags[CORPSE_END] =
     UF_FLAG_DYNAMIC,                                        // CORPSE_FIELD_DYNAMIC_FLAGS
     UF_FLAG_NONE,                                           // CORPSE_FIELD_PAD
 };
+
+namespace
+{
+    constexpr uint32 UF_FLAG_COMBINATIONS = UF_FLAG_DYNAMIC << 1;
+
+    struct UpdateFieldVisibilityMasks
+    {
+        UpdateFieldVisibilityMasks(uint32 const* flags, uint32 count) : Flags(flags),
+            BlockCount((count + UpdateMask::CLIENT_UPDATE_MASK_BITS - 1) / UpdateMask::CLIENT_UPDATE_MASK_BITS),
+            Masks(UF_FLAG_COMBINATIONS * BlockCount, 0)
+        {
+            for (uint32 visibleFlag = 0; visibleFlag < UF_FLAG_COMBINATIONS; ++visibleFlag)
+                for (uint32 index = 0; index < count; ++index)
+                    if (flags[index] & visibleFlag)
+                        Masks[visibleFlag * BlockCount + index / UpdateMask::CLIENT_UPDATE_MASK_BITS] |= 1u << (index % UpdateMask::CLIENT_UPDATE_MASK_BITS);
+        }
+
+        uint32 const* Flags;
+        uint32 BlockCount;
+        std::vector<uint32> Masks;
+    };
+}
+
+uint32 const* GetUpdateFieldVisibilityMask(uint32 const* flags, uint32 visibleFlag)
+{
+    static std::array<UpdateFieldVisibilityMasks, 5> const masks =
+    {
+        UpdateFieldVisibilityMasks(ItemUpdateFieldFlags, CONTAINER_END),
+        UpdateFieldVisibilityMasks(UnitUpdateFieldFlags, PLAYER_END),
+        UpdateFieldVisibilityMasks(GameObjectUpdateFieldFlags, GAMEOBJECT_END),
+        UpdateFieldVisibilityMasks(DynamicObjectUpdateFieldFlags, DYNAMICOBJECT_END),
+        UpdateFieldVisibilityMasks(CorpseUpdateFieldFlags, CORPSE_END)
+    };
+
+    for (UpdateFieldVisibilityMasks const& table : masks)
+        if (table.Flags == flags)
+            return &table.Masks[(visibleFlag % UF_FLAG_COMBINATIONS) * table.BlockCount];
+
+    ABORT("GetUpdateFieldVisibilityMask: unknown update field flags table");
+    return nullptr;
+}
@@ -41,4 +41,8 @@ extern uint32 GameObjectUpdateFieldFlags[GAMEOBJECT_END];
 extern uint32 DynamicObjectUpdateFieldFlags[DYNAMICOBJECT_END];
 extern uint32 CorpseUpdateFieldFlags[CORPSE_END];
 
+/// Fields of one of the tables above whose flags intersect visibleFlag, one bit per field in update mask blocks.
+/// Built once for every flag combination so values updates select their fields a block at a time.
+uint32 const* GetUpdateFieldVisibilityMask(uint32 const* flags, uint32 visibleFlag);
+
 #endif // _UPDATEFIELDFLAGS_H
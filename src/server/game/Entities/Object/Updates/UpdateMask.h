@@ -21,6 +21,8 @@
 #include "ByteBuffer.h"
 #include "Errors.h"
 #include "UpdateFields.h"
+#include <algorithm>
+#include <bit>
 
 class UpdateMask
 {
@@ -38,26 +40,39 @@ public:
     UpdateMask(UpdateMask const& right)
     {
         SetCount(right.GetCount());
-        memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * 32);
+        memcpy(_bits, right._bits, sizeof(ClientUpdateMaskType) * _blockCount);
     }
 
     ~UpdateMask() { delete[] _bits; }
 
-    void SetBit(uint32 index) { _bits[index] = 1; }
-    void UnsetBit(uint32 index) { _bits[index] = 0; }
-    [[nodiscard]] bool GetBit(uint32 index) const { return _bits[index] != 0; }
+    void SetBit(uint32 index) { _bits[index / CLIENT_UPDATE_MASK_BITS] |= ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS); }
+    void UnsetBit(uint32 index) { _bits[index / CLIENT_UPDATE_MASK_BITS] &= ~(ClientUpdateMaskType(1) << (index % CLIENT_UPDATE_MASK_BITS)); }
+    [[nodiscard]] bool GetBit(uint32 index) const { return (_bits[index / CLIENT_UPDATE_MASK_BITS] >> (index % CLIENT_UPDATE_MASK_BITS)) & 1; }
 
-    void AppendToPacket(ByteBuffer* data)
+    /// Blocks are stored the way the client reads them, so whole blocks can be combined with precomputed masks
+    [[nodiscard]] ClientUpdateMaskType GetBlock(uint32 block) const { return _bits[block]; }
+    void SetBlock(uint32 block, ClientUpdateMaskType value) { _bits[block] = value; }
+
+    /// Index of the first set bit at or after index, GetCount() if there is none
+    [[nodiscard]] uint32 FindNextSetBit(uint32 index) const
     {
-        for (uint32 i = 0; i < GetBlockCount(); ++i)
+        for (uint32 block = index / CLIENT_UPDATE_MASK_BITS; block < _blockCount; ++block)
         {
-            ClientUpdateMaskType maskPart = 0;
-            for (uint32 j = 0; j < CLIENT_UPDATE_MASK_BITS; ++j)
-                if (_bits[CLIENT_UPDATE_MASK_BITS * i + j])
-                    maskPart |= 1 << j;
+            ClientUpdateMaskType bits = _bits[block];
+            if (block == index / CLIENT_UPDATE_MASK_BITS)
+                bits &= ~ClientUpdateMaskType(0) << (index % CLIENT_UPDATE_MASK_BITS);
 
-            *data << maskPart;
+            if (bits)
+                return std::min<uint32>(block * CLIENT_UPDATE_MASK_BITS + std::countr_zero(bits), _fieldCount);
         }
+
+        return _fieldCount;
+    }
+
+    void AppendToPacket(ByteBuffer* data)
+    {
+        for (uint32 i = 0; i < GetBlockCount(); ++i)
+            *data << _bits[i];
     }
 
     [[nodiscard]] uint32 GetBlockCount() const { return _blockCount; }
@@ -70,14 +85,14 @@ public:
         _fieldCount = valuesCount;
         _blockCount = (valuesCount + CLIENT_UPDATE_MASK_BITS - 1) / CLIENT_UPDATE_MASK_BITS;
 
-        _bits = new uint8[_blockCount * CLIENT_UPDATE_MASK_BITS];
-        memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+        _bits = new ClientUpdateMaskType[_blockCount];
+        memset(_bits, 0, sizeof(ClientUpdateMaskType) * _blockCount);
     }
 
     void Clear()
     {
         if (_bits)
-            memset(_bits, 0, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+            memset(_bits, 0, sizeof(ClientUpdateMaskType) * _blockCount);
     }
 
     UpdateMask& operator=(UpdateMask const& right)
@@ -86,23 +101,26 @@ public:
             return *this;
 
         SetCount(right.GetCount());
-        memcpy(_bits, right._bits, sizeof(uint8) * _blockCount * CLIENT_UPDATE_MASK_BITS);
+        memcpy(_bits, right._bits, sizeof(ClientUpdateMaskType) * _blockCount);
         return *this;
     }
 
     UpdateMask& operator&=(UpdateMask const& right)
     {
         ASSERT(right.GetCount() <= GetCount());
-        for (uint32 i = 0; i < _fieldCount; ++i)
+        for (uint32 i = 0; i < right._blockCount; ++i)
             _bits[i] &= right._bits[i];
 
+        for (uint32 i = right._blockCount; i < _blockCount; ++i)
+            _bits[i] = 0;
+
         return *this;
     }
 
     UpdateMask& operator|=(UpdateMask const& right)
     {
         ASSERT(right.GetCount() <= GetCount());
-        for (uint32 i = 0; i < _fieldCount; ++i)
+        for (uint32 i = 0; i < right._blockCount; ++i)
             _bits[i] |= right._bits[i];
 
         return *this;
@@ -118,7 +136,7 @@ public:
 private:
     uint32 _fieldCount{0};
     uint32 _blockCount{0};
-    uint8* _bits{nullptr};
+    ClientUpdateMaskType* _bits{nullptr};
 };
 
 #endif
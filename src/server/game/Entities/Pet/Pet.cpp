@@ -166,6 +166,54 @@ public:
     }
 };
 
+static PetStable::PetSnapshot ReadPetSnapshot(uint32 petNumber, SQLQueryHolderBase const& holder)
+{
+    PetStable::PetSnapshot snapshot;
+    snapshot.PetNumber = petNumber;
+
+    if (PreparedQueryResult result = holder.GetPreparedResult(PetLoadQueryHolder::AURAS))
+    {
+        snapshot.Auras.reserve(result->GetRowCount());
+        do
+        {
+            Field* fields = result->Fetch();
+            PetStable::PetSnapshot::Aura& aura = snapshot.Auras.emplace_back();
+            aura.CasterGuid = fields[0].Get<uint64>();
+            aura.SpellId = fields[1].Get<uint32>();
+            aura.EffectMask = fields[2].Get<uint8>();
+            aura.RecalculateMask = fields[3].Get<uint8>();
+            aura.StackCount = fields[4].Get<uint8>();
+            aura.Amount = { fields[5].Get<int32>(), fields[6].Get<int32>(), fields[7].Get<int32>() };
+            aura.BaseAmount = { fields[8].Get<int32>(), fields[9].Get<int32>(), fields[10].Get<int32>() };
+            aura.MaxDuration = fields[11].Get<int32>();
+            aura.RemainTime = fields[12].Get<int32>();
+            aura.RemainCharges = fields[13].Get<uint8>();
+        } while (result->NextRow());
+    }
+
+    if (PreparedQueryResult result = holder.GetPreparedResult(PetLoadQueryHolder::SPELLS))
+    {
+        snapshot.Spells.reserve(result->GetRowCount());
+        do
+        {
+            Field* fields = result->Fetch();
+            snapshot.Spells.push_back({ fields[0].Get<uint32>(), fields[1].Get<uint8>() });
+        } while (result->NextRow());
+    }
+
+    if (PreparedQueryResult result = holder.GetPreparedResult(PetLoadQueryHolder::COOLDOWNS))
+    {
+        snapshot.Cooldowns.reserve(result->GetRowCount());
+        do
+        {
+            Field* fields = result->Fetch();
+            snapshot.Cooldowns.push_back({ fields[0].Get<uint32>(), fields[1].Get<uint16>(), fields[2].Get<uint32>() });
+        } while (result->NextRow());
+    }
+
+    return snapshot;
+}
+
 std::pair<PetStable::PetInfo const*, PetSaveMode> Pet::GetLoadPetInfo(PetStable const& stable, uint32 petEntry, uint32 petnumber, bool current)
 {
     if (petnumber)
@@ -417,28 +465,20 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petEntry, uint32 petnumber, bool c
     if (owner->GetTypeId() == TYPEID_PLAYER && isControlled() && !isTemporarySummoned() && (getPetType() == SUMMON_PET || getPetType() == HUNTER_PET))
         owner->ToPlayer()->SetLastPetNumber(petInfo->PetNumber);
 
-    owner->GetSession()->AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(std::make_shared<PetLoadQueryHolder>(ownerid, petInfo->PetNumber)))
-        .AfterComplete([this, owner, session = owner->GetSession(), isTemporarySummon, current, lastSaveTime = petInfo->LastSaveTime, savedhealth = petInfo->Health, savedmana = petInfo->Mana, healthPct]
-        (SQLQueryHolderBase const& holder)
+    auto finishLoading = [this, owner, isTemporarySummon, current, lastSaveTime = petInfo->LastSaveTime, savedhealth = petInfo->Health, savedmana = petInfo->Mana, healthPct]
+        (PetStable::PetSnapshot const& data, std::unique_ptr<DeclinedName> declinedName)
     {
-        if (session->GetPlayer() != owner || owner->GetPet() != this)
-            return;
-
-        // passing previous checks ensure that 'this' is still valid
-        if (m_removed)
-            return;
-
         InitTalentForLevel(); // set original talents points before spell loading
 
         uint32 timediff = uint32(GameTime::GetGameTime().count() - lastSaveTime);
-        _LoadAuras(holder.GetPreparedResult(PetLoadQueryHolder::AURAS), timediff);
+        _LoadAuras(data.Auras, timediff);
 
         // load action bar, if data broken will fill later by default spells.
         if (!isTemporarySummon)
         {
-            _LoadSpells(holder.GetPreparedResult(PetLoadQueryHolder::SPELLS));
+            _LoadSpells(data.Spells);
             InitTalentForLevel(); // re-init to check talent count
-            _LoadSpellCooldowns(holder.GetPreparedResult(PetLoadQueryHolder::COOLDOWNS));
+            _LoadSpellCooldowns(data.Cooldowns);
             LearnPetPassives();
             InitLevelupSpellsForLevel();
             if (GetMap()->IsBattleArena())
@@ -457,16 +497,8 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petEntry, uint32 petnumber, bool c
         if (owner->GetGroup())
             owner->SetGroupUpdateFlag(GROUP_UPDATE_PET);
 
-        if (getPetType() == HUNTER_PET)
-        {
-            if (PreparedQueryResult result = holder.GetPreparedResult(PetLoadQueryHolder::DECLINED_NAMES))
-            {
-                m_declinedname = std::make_unique<DeclinedName>();
-                Field* fields = result->Fetch();
-                for (uint8 i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
-                    m_declinedname->name[i] = fields[i].Get<std::string>();
-            }
-        }
+        if (declinedName)
+            m_declinedname = std::move(declinedName);
 
         uint32 curHealth = savedhealth;
         if (healthPct)
@@ -494,6 +526,43 @@ bool Pet::LoadPetFromDB(Player* owner, uint32 petEntry, uint32 petnumber, bool c
         //LoadTemplateImmunities();
         //LoadMechanicTemplateImmunity();
         m_loading = false;
+    };
+
+    // the same pet coming back after a teleport or a temporary unsummon finds the rows of its last save in memory,
+    // declined names are not part of them
+    if (!forceLoadFromDB && petStable->Snapshot && petStable->Snapshot->PetNumber == petInfo->PetNumber &&
+        (getPetType() != HUNTER_PET || !sWorld->getBoolConfig(CONFIG_DECLINED_NAMES_USED)))
+    {
+        PetStable::PetSnapshot snapshot = std::move(*petStable->Snapshot);
+        petStable->Snapshot.reset();
+
+        finishLoading(snapshot, nullptr);
+        return true;
+    }
+
+    owner->GetSession()->AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(std::make_shared<PetLoadQueryHolder>(ownerid, petInfo->PetNumber)))
+        .AfterComplete([this, owner, session = owner->GetSession(), petNumber = petInfo->PetNumber, finishLoading](SQLQueryHolderBase const& holder)
+    {
+        if (session->GetPlayer() != owner || owner->GetPet() != this)
+            return;
+
+        // passing previous checks ensure that 'this' is still valid
+        if (m_removed)
+            return;
+
+        std::unique_ptr<DeclinedName> declinedName;
+        if (getPetType() == HUNTER_PET)
+        {
+            if (PreparedQueryResult result = holder.GetPreparedResult(PetLoadQueryHolder::DECLINED_NAMES))
+            {
+                declinedName = std::make_unique<DeclinedName>();
+                Field* fields = result->Fetch();
+                for (uint8 i = 0; i < MAX_DECLINED_NAME_CASES; ++i)
+                    declinedName->name[i] = fields[i].Get<std::string>();
+            }
+        }
+
+        finishLoading(ReadPetSnapshot(petNumber, holder), std::move(declinedName));
     });
 
     return true;
@@ -525,16 +594,19 @@ void Pet::SavePetToDB(PetSaveMode mode)
     uint32 curhealth = GetHealth();
     uint32 curmana = GetPower(POWER_MANA);
 
+    PetStable::PetSnapshot snapshot;
+    snapshot.PetNumber = m_charmInfo->GetPetNumber();
+
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     // save auras before possibly removing them
-    _SaveAuras(trans);
+    _SaveAuras(trans, snapshot.Auras);
 
     // stable and not in slot saves
     if (mode > PET_SAVE_AS_CURRENT)
         RemoveAllAuras();
 
-    _SaveSpells(trans);
-    _SaveSpellCooldowns(trans);
+    _SaveSpells(trans, snapshot.Spells);
+    _SaveSpellCooldowns(trans, snapshot.Cooldowns);
     CharacterDatabase.CommitTransaction(trans);
 
     // current/stable/not_in_slot
@@ -587,12 +659,17 @@ void Pet::SavePetToDB(PetSaveMode mode)
 
         trans->Append(stmt);
         CharacterDatabase.CommitTransaction(trans);
+
+        owner->GetPetStable()->Snapshot = std::move(snapshot);
     }
     // delete
     else
     {
         RemoveAllAuras();
         DeleteFromDB(m_charmInfo->GetPetNumber());
+
+        if (PetStable* petStable = owner->GetPetStable())
+            petStable->Snapshot.reset();
     }
 }
 
@@ -971,7 +1048,7 @@ bool Pet::CreateBaseAtCreature(Creature* creature)
     if (CreatureFamilyEntry const* cFamily = sCreatureFamilyStore.LookupEntry(cinfo->family))
         SetName(cFamily->Name[sWorld->GetDefaultDbcLocale()]);
     else
-        SetName(creature->GetNameForLocaleIdx(sObjectMgr->GetDBCLocaleIndex()));
+        SetName(std::string(creature->GetNameForLocaleIdx(sObjectMgr->GetDBCLocaleIndex())));
 
     return true;
 }
@@ -1470,24 +1547,22 @@ uint32 Pet::GetCurrentFoodBenefitLevel(uint32 itemlevel) const
         return 0;                                           //food too low level
 }
 
-void Pet::_LoadSpellCooldowns(PreparedQueryResult result)
+void Pet::_LoadSpellCooldowns(std::vector<PetStable::PetSnapshot::Cooldown> const& cooldownRows)
 {
     m_CreatureSpellCooldowns.clear();
 
-    if (result)
+    if (!cooldownRows.empty())
     {
         time_t curTime = GameTime::GetGameTime().count();
 
         PacketCooldowns cooldowns;
         WorldPacket data;
 
-        do
+        for (PetStable::PetSnapshot::Cooldown const& row : cooldownRows)
         {
-            Field* fields = result->Fetch();
-
-            uint32 spell_id = fields[0].Get<uint32>();
-            uint16 category = fields[1].Get<uint16>();
-            time_t db_time  = time_t(fields[2].Get<uint32>());
+            uint32 spell_id = row.SpellId;
+            uint16 category = row.Category;
+            time_t db_time  = time_t(row.EndTime);
 
             if (!sSpellMgr->GetSpellInfo(spell_id))
             {
@@ -1504,7 +1579,7 @@ void Pet::_LoadSpellCooldowns(PreparedQueryResult result)
             _AddCreatureSpellCooldown(spell_id, category, cooldown);
 
             LOG_DEBUG("entities.pet", "Pet (Number: {}) spell {} cooldown loaded ({} secs).", m_charmInfo->GetPetNumber(), spell_id, uint32(db_time - curTime));
-        } while (result->NextRow());
+        }
 
         if (!cooldowns.empty() && GetOwner())
         {
@@ -1514,7 +1589,7 @@ void Pet::_LoadSpellCooldowns(PreparedQueryResult result)
     }
 }
 
-void Pet::_SaveSpellCooldowns(CharacterDatabaseTransaction trans)
+void Pet::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, std::vector<PetStable::PetSnapshot::Cooldown>& cooldownRows)
 {
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PET_SPELL_COOLDOWNS);
     stmt->SetData(0, m_charmInfo->GetPetNumber());
@@ -1544,24 +1619,19 @@ void Pet::_SaveSpellCooldowns(CharacterDatabaseTransaction trans)
             stmt->SetData(2, itr2->second.category);
             stmt->SetData(3, cooldown);
             trans->Append(stmt);
+
+            cooldownRows.push_back({ itr2->first, itr2->second.category, cooldown });
         }
     }
 }
 
-void Pet::_LoadSpells(PreparedQueryResult result)
+void Pet::_LoadSpells(std::vector<PetStable::PetSnapshot::Spell> const& spellRows)
 {
-    if (result)
-    {
-        do
-        {
-            Field* fields = result->Fetch();
-
-            addSpell(fields[0].Get<uint32>(), ActiveStates(fields[1].Get<uint8>()), PETSPELL_UNCHANGED);
-        } while (result->NextRow());
-    }
+    for (PetStable::PetSnapshot::Spell const& row : spellRows)
+        addSpell(row.SpellId, ActiveStates(row.Active), PETSPELL_UNCHANGED);
 }
 
-void Pet::_SaveSpells(CharacterDatabaseTransaction trans)
+void Pet::_SaveSpells(CharacterDatabaseTransaction trans, std::vector<PetStable::PetSnapshot::Spell>& spellRows)
 {
     for (PetSpellMap::iterator itr = m_spells.begin(), next = m_spells.begin(); itr != m_spells.end(); itr = next)
     {
@@ -1608,89 +1678,84 @@ void Pet::_SaveSpells(CharacterDatabaseTransaction trans)
         }
         itr->second.state = PETSPELL_UNCHANGED;
     }
+
+    // the table now holds every spell that is not a family passive
+    for (PetSpellMap::const_iterator itr = m_spells.begin(); itr != m_spells.end(); ++itr)
+        if (itr->second.type != PETSPELL_FAMILY)
+            spellRows.push_back({ itr->first, uint8(itr->second.active) });
 }
 
-void Pet::_LoadAuras(PreparedQueryResult result, uint32 timediff)
+void Pet::_LoadAuras(std::vector<PetStable::PetSnapshot::Aura> const& auraRows, uint32 timediff)
 {
     LOG_DEBUG("entities.pet", "Loading auras for pet {}", GetGUID().ToString());
 
-    if (result)
-    {
-        do
+    for (PetStable::PetSnapshot::Aura const& row : auraRows)
+    {
+        int32 damage[3] = { row.Amount[0], row.Amount[1], row.Amount[2] };
+        int32 baseDamage[3] = { row.BaseAmount[0], row.BaseAmount[1], row.BaseAmount[2] };
+        ObjectGuid caster_guid = ObjectGuid(row.CasterGuid);
+        // nullptr guid stored - pet is the caster of the spell - see Pet::_SaveAuras
+        if (!caster_guid)
+            caster_guid = GetGUID();
+        uint32 spellid = row.SpellId;
+        uint8 effmask = row.EffectMask;
+        uint8 recalculatemask = row.RecalculateMask;
+        uint8 stackcount = row.StackCount;
+        int32 maxduration = row.MaxDuration;
+        int32 remaintime = row.RemainTime;
+        uint8 remaincharges = row.RemainCharges;
+
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellid);
+        if (!spellInfo)
         {
-            int32 damage[3];
-            int32 baseDamage[3];
-            Field* fields = result->Fetch();
-            ObjectGuid caster_guid = ObjectGuid(fields[0].Get<uint64>());
-            // nullptr guid stored - pet is the caster of the spell - see Pet::_SaveAuras
-            if (!caster_guid)
-                caster_guid = GetGUID();
-            uint32 spellid = fields[1].Get<uint32>();
-            uint8 effmask = fields[2].Get<uint8>();
-            uint8 recalculatemask = fields[3].Get<uint8>();
-            uint8 stackcount = fields[4].Get<uint8>();
-            damage[0] = fields[5].Get<int32>();
-            damage[1] = fields[6].Get<int32>();
-            damage[2] = fields[7].Get<int32>();
-            baseDamage[0] = fields[8].Get<int32>();
-            baseDamage[1] = fields[9].Get<int32>();
-            baseDamage[2] = fields[10].Get<int32>();
-            int32 maxduration = fields[11].Get<int32>();
-            int32 remaintime = fields[12].Get<int32>();
-            uint8 remaincharges = fields[13].Get<uint8>();
-
-            SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellid);
-            if (!spellInfo)
-            {
-                LOG_ERROR("entities.pet", "Unknown aura (spellid {}), ignore.", spellid);
-                continue;
-            }
+            LOG_ERROR("entities.pet", "Unknown aura (spellid {}), ignore.", spellid);
+            continue;
+        }
 
-            // avoid higher level auras if any, and adjust
-            SpellInfo const* scaledSpellInfo = spellInfo->GetAuraRankForLevel(GetLevel());
-            if (scaledSpellInfo != spellInfo)
-                spellInfo = scaledSpellInfo;
+        // avoid higher level auras if any, and adjust
+        SpellInfo const* scaledSpellInfo = spellInfo->GetAuraRankForLevel(GetLevel());
+        if (scaledSpellInfo != spellInfo)
+            spellInfo = scaledSpellInfo;
 
-            // again after level check
-            if (!spellInfo)
-                continue;
+        // again after level check
+        if (!spellInfo)
+            continue;
 
-            // negative effects should continue counting down after logout
-            if (remaintime != -1 && (!spellInfo->IsPositive() || spellInfo->HasAttribute(SPELL_ATTR4_AURA_EXPIRES_OFFLINE)))
+        // negative effects should continue counting down after logout
+        if (remaintime != -1 && (!spellInfo->IsPositive() || spellInfo->HasAttribute(SPELL_ATTR4_AURA_EXPIRES_OFFLINE)))
+        {
+            if (remaintime / IN_MILLISECONDS <= int32(timediff))
             {
-                if (remaintime / IN_MILLISECONDS <= int32(timediff))
-                {
-                    continue;
-                }
-
-                remaintime -= timediff * IN_MILLISECONDS;
+                continue;
             }
 
-            // prevent wrong values of remaincharges
-            if (spellInfo->ProcCharges)
-            {
-                if (remaincharges <= 0 || remaincharges > spellInfo->ProcCharges)
-                    remaincharges = spellInfo->ProcCharges;
-            }
-            else
-                remaincharges = 0;
+            remaintime -= timediff * IN_MILLISECONDS;
+        }
 
-            if (Aura* aura = Aura::TryCreate(spellInfo, effmask, this, nullptr, &baseDamage[0], nullptr, caster_guid))
+        // prevent wrong values of remaincharges
+        if (spellInfo->ProcCharges)
+        {
+            if (remaincharges <= 0 || remaincharges > spellInfo->ProcCharges)
+                remaincharges = spellInfo->ProcCharges;
+        }
+        else
+            remaincharges = 0;
+
+        if (Aura* aura = Aura::TryCreate(spellInfo, effmask, this, nullptr, &baseDamage[0], nullptr, caster_guid))
+        {
+            if (!aura->CanBeSaved())
             {
-                if (!aura->CanBeSaved())
-                {
-                    aura->Remove();
-                    continue;
-                }
-                aura->SetLoadedState(maxduration, remaintime, remaincharges, stackcount, recalculatemask, &damage[0]);
-                aura->ApplyForTargets();
-                LOG_DEBUG("entities.pet", "Added aura spellid {}, effectmask {}", spellInfo->Id, effmask);
+                aura->Remove();
+                continue;
             }
-        } while (result->NextRow());
+            aura->SetLoadedState(maxduration, remaintime, remaincharges, stackcount, recalculatemask, &damage[0]);
+            aura->ApplyForTargets();
+            LOG_DEBUG("entities.pet", "Added aura spellid {}, effectmask {}", spellInfo->Id, effmask);
+        }
     }
 }
 
-void Pet::_SaveAuras(CharacterDatabaseTransaction trans)
+void Pet::_SaveAuras(CharacterDatabaseTransaction trans, std::vector<PetStable::PetSnapshot::Aura>& auraRows)
 {
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_PET_AURAS);
     stmt->SetData(0, m_charmInfo->GetPetNumber());
@@ -1750,24 +1815,36 @@ void Pet::_SaveAuras(CharacterDatabaseTransaction trans)
         // don't save guid of caster in case we are caster of the spell - guid for pet is generated every pet load, so it won't match saved guid anyways
         ObjectGuid casterGUID = (itr->second->GetCasterGUID() == GetGUID()) ? ObjectGuid::Empty : itr->second->GetCasterGUID();
 
+        PetStable::PetSnapshot::Aura& row = auraRows.emplace_back();
+        row.CasterGuid = casterGUID.GetRawValue();
+        row.SpellId = itr->second->GetId();
+        row.EffectMask = effMask;
+        row.RecalculateMask = recalculateMask;
+        row.StackCount = itr->second->GetStackAmount();
+        row.Amount = { damage[0], damage[1], damage[2] };
+        row.BaseAmount = { baseDamage[0], baseDamage[1], baseDamage[2] };
+        row.MaxDuration = itr->second->GetMaxDuration();
+        row.RemainTime = itr->second->GetDuration();
+        row.RemainCharges = itr->second->GetCharges();
+
         uint8 index = 0;
 
         CharacterDatabasePreparedStatement* stmt2 = CharacterDatabase.GetPreparedStatement(CHAR_INS_PET_AURA);
         stmt2->SetData(index++, m_charmInfo->GetPetNumber());
-        stmt2->SetData(index++, casterGUID.GetRawValue());
-        stmt2->SetData(index++, itr->second->GetId());
-        stmt2->SetData(index++, effMask);
-        stmt2->SetData(index++, recalculateMask);
-        stmt2->SetData(index++, itr->second->GetStackAmount());
-        stmt2->SetData(index++, damage[0]);
-        stmt2->SetData(index++, damage[1]);
-        stmt2->SetData(index++, damage[2]);
-        stmt2->SetData(index++, baseDamage[0]);
-        stmt2->SetData(index++, baseDamage[1]);
-        stmt2->SetData(index++, baseDamage[2]);
-        stmt2->SetData(index++, itr->second->GetMaxDuration());
-        stmt2->SetData(index++, itr->second->GetDuration());
-        stmt2->SetData(index++, itr->second->GetCharges());
+        stmt2->SetData(index++, row.CasterGuid);
+        stmt2->SetData(index++, row.SpellId);
+        stmt2->SetData(index++, row.EffectMask);
+        stmt2->SetData(index++, row.RecalculateMask);
+        stmt2->SetData(index++, row.StackCount);
+        stmt2->SetData(index++, row.Amount[0]);
+        stmt2->SetData(index++, row.Amount[1]);
+        stmt2->SetData(index++, row.Amount[2]);
+        stmt2->SetData(index++, row.BaseAmount[0]);
+        stmt2->SetData(index++, row.BaseAmount[1]);
+        stmt2->SetData(index++, row.BaseAmount[2]);
+        stmt2->SetData(index++, row.MaxDuration);
+        stmt2->SetData(index++, row.RemainTime);
+        stmt2->SetData(index++, row.RemainCharges);
         trans->Append(stmt2);
     }
 }
@@ -2186,6 +2263,11 @@ void Pet::resetTalentsForAllPetsOf(Player* owner, Pet* onlinePet /*= nullptr*/)
         return;
     }
 
+    if (petStable->Snapshot && petIds.count(petStable->Snapshot->PetNumber))
+    {
+        petStable->Snapshot.reset();
+    }
+
     bool need_comma = false;
     std::ostringstream ss;
     ss << "DELETE FROM pet_spell WHERE guid IN (";
@@ -100,13 +100,13 @@ public:
     void ClearCastWhenWillAvailable();
     void RemoveSpellCooldown(uint32 spell_id, bool update /* = false */);
 
-    void _SaveSpellCooldowns(CharacterDatabaseTransaction trans);
-    void _SaveAuras(CharacterDatabaseTransaction trans);
-    void _SaveSpells(CharacterDatabaseTransaction trans);
+    void _SaveSpellCooldowns(CharacterDatabaseTransaction trans, std::vector<PetStable::PetSnapshot::Cooldown>& cooldownRows);
+    void _SaveAuras(CharacterDatabaseTransaction trans, std::vector<PetStable::PetSnapshot::Aura>& auraRows);
+    void _SaveSpells(CharacterDatabaseTransaction trans, std::vector<PetStable::PetSnapshot::Spell>& spellRows);
 
-    void _LoadSpellCooldowns(PreparedQueryResult result);
-    void _LoadAuras(PreparedQueryResult result, uint32 timediff);
-    void _LoadSpells(PreparedQueryResult result);
+    void _LoadSpellCooldowns(std::vector<PetStable::PetSnapshot::Cooldown> const& cooldownRows);
+    void _LoadAuras(std::vector<PetStable::PetSnapshot::Aura> const& auraRows, uint32 timediff);
+    void _LoadSpells(std::vector<PetStable::PetSnapshot::Spell> const& spellRows);
 
     bool addSpell(uint32 spellId, ActiveStates active = ACT_DECIDE, PetSpellState state = PETSPELL_NEW, PetSpellType type = PETSPELL_NORMAL);
     bool learnSpell(uint32 spell_id);
@@ -222,10 +222,48 @@ public:
         bool WasRenamed = false;
     };
 
+    /// Rows of pet_aura, pet_spell and pet_spell_cooldown written by the last save of a pet.
+    /// Loading the same pet again (teleports, resummons) uses them instead of querying the database.
+    struct PetSnapshot
+    {
+        struct Aura
+        {
+            uint64 CasterGuid = 0;
+            uint32 SpellId = 0;
+            uint8 EffectMask = 0;
+            uint8 RecalculateMask = 0;
+            uint8 StackCount = 0;
+            std::array<int32, 3> Amount = { };              // MAX_SPELL_EFFECTS
+            std::array<int32, 3> BaseAmount = { };
+            int32 MaxDuration = 0;
+            int32 RemainTime = 0;
+            uint8 RemainCharges = 0;
+        };
+
+        struct Spell
+        {
+            uint32 SpellId = 0;
+            uint8 Active = 0;
+        };
+
+        struct Cooldown
+        {
+            uint32 SpellId = 0;
+            uint16 Category = 0;
+            uint32 EndTime = 0;                             // unix time, as stored in the database
+        };
+
+        uint32 PetNumber = 0;
+        std::vector<Aura> Auras;
+        std::vector<Spell> Spells;
+        std::vector<Cooldown> Cooldowns;
+    };
+
     Optional<PetInfo> CurrentPet;                                   // PET_SAVE_AS_CURRENT
     std::array<Optional<PetInfo>, MAX_PET_STABLES> StabledPets;     // PET_SAVE_FIRST_STABLE_SLOT - PET_SAVE_LAST_STABLE_SLOT
     uint32 MaxStabledPets = 0;
     std::vector<PetInfo> UnslottedPets;                             // PET_SAVE_NOT_IN_SLOT
+    Optional<PetSnapshot> Snapshot;                                 // of the pet saved last
 
     [[nodiscard]] PetInfo const* GetUnslottedHunterPet() const
     {
@@ -158,6 +158,10 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
 
     m_ingametime = 0;
 
+    m_visibilityPassStamps[0] = 0;
+    m_visibilityPassStamps[1] = 0;
+    m_visibilityBudgetRange = 0.0f;
+
     m_ExtraFlags = 0;
 
     m_spellModTakingSpell = nullptr;
@@ -178,6 +182,7 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
 
     m_zoneUpdateId = uint32(-1);
     m_zoneUpdateTimer = 0;
+    m_positionDataValid = false;
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
 
@@ -199,6 +204,7 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     // group is initialized in the reference constructor
     SetGroupInvite(nullptr);
     m_groupUpdateMask = 0;
+    m_nextThrottledGroupUpdate = 0ms;
     m_auraRaidUpdateMask = 0;
     m_bPassOnGroupLoot = false;
 
@@ -273,12 +279,14 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
     ////////////////////Rest System/////////////////////
 
     m_mailsUpdated = false;
+    m_mailedItemsLoaded = false;
     unReadMails = 0;
     m_nextMailDelivereTime = time_t(0);
 
     m_resetTalentsCost = 0;
     m_resetTalentsTime = 0;
     m_itemUpdateQueueBlocked = false;
+    m_enchantDurationTime = 0;
 
     for (uint8 i = 0; i < MAX_MOVE_TYPE; ++i)
         m_forced_speed_changes[i] = 0;
@@ -375,6 +383,8 @@ Player::Player(WorldSession* session): Unit(true), m_mover(this)
 
     m_MonthlyQuestChanged = false;
 
+    m_questGiverStatusEpoch = 0;
+
     m_SeasonalQuestChanged = false;
 
     SetPendingBind(0, 0);
@@ -1603,6 +1613,7 @@ bool Player::TeleportToEntryPoint()
 
     WorldLocation loc = m_entryPointData.joinPos;
     m_entryPointData.joinPos.m_mapId = MAPID_INVALID;
+    m_entryPointChanged = true;
 
     if (loc.m_mapId == MAPID_INVALID)
     {
@@ -1740,6 +1751,9 @@ void Player::RemoveFromWorld()
     ///- The player should only be removed when logging out
     Unit::RemoveFromWorld();
 
+    // the next map has different terrain at the same coordinates
+    m_positionDataValid = false;
+
     if (m_uint32Values)
     {
         if (WorldObject* viewpoint = GetViewpoint())
@@ -1750,6 +1764,22 @@ void Player::RemoveFromWorld()
     }
 }
 
+void Player::UpdatePositionDataIfMoved()
+{
+    if (m_positionDataValid && IsInDist(&m_positionDataPos, sWorld->getFloatConfig(CONFIG_PLAYER_TERRAIN_UPDATE_DISTANCE)))
+        return;
+
+    UpdatePositionData();
+}
+
+void Player::ProcessPositionDataChanged(PositionFullTerrainStatus const& data)
+{
+    Unit::ProcessPositionDataChanged(data);
+
+    m_positionDataPos.Relocate(GetPositionX(), GetPositionY(), GetPositionZ());
+    m_positionDataValid = true;
+}
+
 void Player::RegenerateAll()
 {
     //if (m_regenTimer <= 500)
@@ -3603,10 +3633,6 @@ void Player::_LoadSpellCooldowns(PreparedQueryResult result)
 
 void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
-
     time_t curTime = GameTime::GetGameTime().count();
     uint32 curMSTime = GameTime::GetGameTimeMS().count();
     uint32 infTime = curMSTime + infinityCooldownDelayCheck;
@@ -3644,9 +3670,21 @@ void Player::_SaveSpellCooldowns(CharacterDatabaseTransaction trans, bool logout
         else
             ++itr;
     }
+    // cooldowns are stored as absolute end times, skip the rewrite if the rows didn't change since the last save
+    std::string cooldowns = ss.str();
+    std::size_t hash = std::hash<std::string>()(cooldowns);
+    if (m_savedSpellCooldownsHash == hash)
+        return;
+
+    m_savedSpellCooldownsHash = hash;
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_SPELL_COOLDOWN);
+    stmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
     // if something changed execute
     if (!first_round)
-        trans->Append(ss.str().c_str());
+        trans->Append(cooldowns);
 }
 
 uint32 Player::resetTalentsCost() const
@@ -4608,7 +4646,7 @@ Corpse* Player::CreateCorpse()
 
     // we do not need to save corpses for BG/arenas
     if (!GetMap()->IsBattlegroundOrArena())
-        corpse->SaveToDB();
+        GetMap()->SaveCorpse(corpse);
 
     return corpse;
 }
@@ -4755,7 +4793,7 @@ void Player::DurabilityPointsLoss(Item* item, int32 points)
         if (pNewDurability > 0 && pOldDurability == 0 && item->IsEquipped())
             _ApplyItemMods(item, item->GetSlot(), true);
 
-        item->SetState(ITEM_CHANGED, this);
+        item->SetState(ITEM_CHANGED, this, ITEM_CHANGED_FIELD_DURABILITY);
     }
 }
 
@@ -4853,7 +4891,7 @@ uint32 Player::DurabilityRepair(uint16 pos, bool cost, float discountMod, bool g
     }
 
     item->SetUInt32Value(ITEM_FIELD_DURABILITY, maxDurability);
-    item->SetState(ITEM_CHANGED, this);
+    item->SetState(ITEM_CHANGED, this, ITEM_CHANGED_FIELD_DURABILITY);
 
     // reapply mods for total broken and repaired item if equipped
     if (IsEquipmentPos(pos) && !curDurability)
@@ -7635,7 +7673,7 @@ void Player::SendQuestGiverStatusMultiple()
     WorldPacket data(SMSG_QUESTGIVER_STATUS_MULTIPLE, 4);
     data << uint32(count); // placeholder
 
-    for (GuidUnorderedSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (GuidFlatSet::const_iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
         uint32 questStatus = DIALOG_STATUS_NONE;
 
@@ -9542,7 +9580,7 @@ void Player::VehicleSpellInitialize()
             continue;
         }
 
-        ConditionList conditions = sConditionMgr->GetConditionsForVehicleSpell(vehicle->GetEntry(), spellId);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForVehicleSpell(vehicle->GetEntry(), spellId);
         if (!sConditionMgr->IsObjectMeetToConditions(this, vehicle, conditions))
         {
             LOG_DEBUG("condition", "VehicleSpellInitialize: conditions not met for Vehicle entry {} spell {}", vehicle->ToCreature()->GetEntry(), spellId);
@@ -10699,7 +10737,7 @@ bool Player::BuyItemFromVendorSlot(ObjectGuid vendorguid, uint32 vendorslot, uin
         return false;
     }
 
-    ConditionList conditions = sConditionMgr->GetConditionsForNpcVendorEvent(creature->GetEntry(), item);
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNpcVendorEvent(creature->GetEntry(), item);
     if (!sConditionMgr->IsObjectMeetToConditions(this, creature, conditions))
     {
         //LOG_DEBUG("condition", "BuyItemFromVendor: conditions not met for creature entry {} item {}", creature->GetEntry(), item);
@@ -11230,6 +11268,7 @@ void Player::ToggleMetaGemsActive(uint8 exceptslot, bool apply)
 
 void Player::SetEntryPoint()
 {
+    m_entryPointChanged = true;
     m_entryPointData.joinPos.m_mapId = MAPID_INVALID;
     m_entryPointData.ClearTaxiPath();
 
@@ -11651,8 +11690,19 @@ void Player::SendUpdateToOutOfRangeGroupMembers()
 {
     if (m_groupUpdateMask == GROUP_UPDATE_FLAG_NONE)
         return;
+
     if (Group* group = GetGroup())
+    {
+        Milliseconds const now = GameTime::GetGameTimeMS();
+
+        // raid frames of large raids can live with the power, position and auras of far away members lagging a bit
+        if (!(m_groupUpdateMask & ~GROUP_UPDATE_THROTTLED) && now < m_nextThrottledGroupUpdate &&
+            group->isRaidGroup() && group->GetMembersCount() > sWorld->getIntConfig(CONFIG_GROUP_OUT_OF_RANGE_UPDATE_MEMBERS))
+            return;
+
         group->UpdatePlayerOutOfRange(this);
+        m_nextThrottledGroupUpdate = now + Milliseconds(sWorld->getIntConfig(CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL));
+    }
 
     m_groupUpdateMask = GROUP_UPDATE_FLAG_NONE;
     m_auraRaidUpdateMask = 0;
@@ -12046,6 +12096,7 @@ void Player::SetDailyQuestStatus(uint32 quest_id)
                     SetUInt32Value(PLAYER_FIELD_DAILY_QUESTS_1 + quest_daily_idx, quest_id);
                     m_lastDailyQuestTime = GameTime::GetGameTime().count();              // last daily quest time
                     m_DailyQuestChanged = true;
+                    InvalidateQuestGiverStatus();
                     break;
                 }
             }
@@ -12055,6 +12106,7 @@ void Player::SetDailyQuestStatus(uint32 quest_id)
             m_DFQuests.insert(quest_id);
             m_lastDailyQuestTime = GameTime::GetGameTime().count();
             m_DailyQuestChanged = true;
+            InvalidateQuestGiverStatus();
         }
     }
 }
@@ -12079,6 +12131,7 @@ void Player::SetWeeklyQuestStatus(uint32 quest_id)
 {
     m_weeklyquests.insert(quest_id);
     m_WeeklyQuestChanged = true;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::SetSeasonalQuestStatus(uint32 quest_id)
@@ -12089,12 +12142,14 @@ void Player::SetSeasonalQuestStatus(uint32 quest_id)
 
     m_seasonalquests[quest->GetEventIdForQuest()].insert(quest_id);
     m_SeasonalQuestChanged = true;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::SetMonthlyQuestStatus(uint32 quest_id)
 {
     m_monthlyquests.insert(quest_id);
     m_MonthlyQuestChanged = true;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::ResetDailyQuestStatus()
@@ -12107,6 +12162,7 @@ void Player::ResetDailyQuestStatus()
     // DB data deleted in caller
     m_DailyQuestChanged = false;
     m_lastDailyQuestTime = 0;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::ResetWeeklyQuestStatus()
@@ -12117,6 +12173,7 @@ void Player::ResetWeeklyQuestStatus()
     m_weeklyquests.clear();
     // DB data deleted in caller
     m_WeeklyQuestChanged = false;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::ResetSeasonalQuestStatus(uint16 event_id)
@@ -12127,6 +12184,7 @@ void Player::ResetSeasonalQuestStatus(uint16 event_id)
     m_seasonalquests.erase(event_id);
     // DB data deleted in caller
     m_SeasonalQuestChanged = false;
+    InvalidateQuestGiverStatus();
 }
 
 void Player::ResetMonthlyQuestStatus()
@@ -12137,6 +12195,7 @@ void Player::ResetMonthlyQuestStatus()
     m_monthlyquests.clear();
     // DB data deleted in caller
     m_MonthlyQuestChanged = false;
+    InvalidateQuestGiverStatus();
 }
 
 Battleground* Player::GetBattleground(bool create) const
@@ -14230,7 +14289,7 @@ bool Player::CanSeeSpellClickOn(Creature const* c) const
         if (!itr->second.IsFitToRequirements(this, c))
             return false;
 
-        ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(c->GetEntry(), itr->second.spellId);
+        ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(c->GetEntry(), itr->second.spellId);
         ConditionSourceInfo info = ConditionSourceInfo(const_cast<Player*>(this), const_cast<Creature*>(c));
         if (sConditionMgr->IsObjectMeetToConditions(info, conds))
             return true;
@@ -14244,7 +14303,7 @@ bool Player::CanSeeVendor(Creature const* creature) const
     if (!creature->HasNpcFlag(UNIT_NPC_FLAG_VENDOR))
         return true;
 
-    ConditionList conditions = sConditionMgr->GetConditionsForNpcVendorEvent(creature->GetEntry(), 0);
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNpcVendorEvent(creature->GetEntry(), 0);
     if (!sConditionMgr->IsObjectMeetToConditions(const_cast<Player*>(this), const_cast<Creature*>(creature), conditions))
     {
         return false;
@@ -14537,6 +14596,11 @@ void Player::_SaveEquipmentSets(CharacterDatabaseTransaction trans)
 
 void Player::_SaveEntryPoint(CharacterDatabaseTransaction trans)
 {
+    if (!m_entryPointChanged)
+        return;
+
+    m_entryPointChanged = false;
+
     // xinef: dont save joinpos with invalid mapid
     MapEntry const* mEntry = sMapStore.LookupEntry(m_entryPointData.joinPos.GetMapId());
     if (!mEntry)
@@ -15812,9 +15876,12 @@ void Player::_LoadPetStable(uint8 petStableSlots, PreparedQueryResult result)
 
 void Player::_SaveInstanceTimeRestrictions(CharacterDatabaseTransaction trans)
 {
-    if (_instanceResetTimes.empty())
+    // expired entries are dropped on load, so only new entries need a save
+    if (!_instanceResetTimesChanged)
         return;
 
+    _instanceResetTimesChanged = false;
+
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ACCOUNT_INSTANCE_LOCK_TIMES);
     stmt->SetData(0, GetSession()->GetAccountId());
     trans->Append(stmt);
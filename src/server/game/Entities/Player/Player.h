@@ -25,6 +25,7 @@
 #include "DBCStores.h"
 #include "DatabaseEnvFwd.h"
 #include "EnumFlag.h"
+#include "FlatHashContainers.h"
 #include "GroupReference.h"
 #include "InstanceSaveMgr.h"
 #include "Item.h"
@@ -36,6 +37,7 @@
 #include "PlayerSettings.h"
 #include "PlayerTaxi.h"
 #include "QuestDef.h"
+#include "RewardedQuestSet.h"
 #include "SpellAuras.h"
 #include "SpellInfo.h"
 #include "SpellMgr.h"
@@ -206,7 +208,8 @@ struct SpellCooldown
     bool needSendToClient: 1;
 };
 
-typedef std::map<uint32, SpellCooldown> SpellCooldowns;
+// looked up for every cast, iteration order is not relied upon
+typedef Acore::FlatHashMap<uint32, SpellCooldown> SpellCooldowns;
 typedef std::unordered_map<uint32 /*instanceId*/, time_t/*releaseTime*/> InstanceTimeMap;
 
 enum TrainerSpellState
@@ -441,12 +444,13 @@ struct Runes
 struct EnchantDuration
 {
     EnchantDuration()  = default;;
-    EnchantDuration(Item* _item, EnchantmentSlot _slot, uint32 _leftduration) : item(_item), slot(_slot),
-        leftduration(_leftduration) { ASSERT(item); };
+    EnchantDuration(Item* _item, EnchantmentSlot _slot, uint32 _enchantId, uint64 _expireTime) : item(_item), slot(_slot),
+        enchantId(_enchantId), expireTime(_expireTime) { ASSERT(item); };
 
     Item* item{nullptr};
     EnchantmentSlot slot{MAX_ENCHANTMENT_SLOT};
-    uint32 leftduration{0};
+    uint32 enchantId{0};                                    // enchantment the duration was started for
+    uint64 expireTime{0};                                   // on the enchantment clock of the owner
 };
 
 typedef std::list<EnchantDuration> EnchantDurationList;
@@ -613,7 +617,6 @@ enum AtLoginFlags
 };
 
 typedef std::map<uint32, QuestStatusData> QuestStatusMap;
-typedef std::unordered_set<uint32> RewardedQuestSet;
 
 //               quest,  keep
 typedef std::map<uint32, bool> QuestStatusSaveMap;
@@ -871,7 +874,6 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOAD_INVENTORY               = 8,
     PLAYER_LOGIN_QUERY_LOAD_ACTIONS                 = 9,
     PLAYER_LOGIN_QUERY_LOAD_MAILS                   = 10,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS              = 11,
     PLAYER_LOGIN_QUERY_LOAD_SOCIAL_LIST             = 13,
     PLAYER_LOGIN_QUERY_LOAD_HOME_BIND               = 14,
     PLAYER_LOGIN_QUERY_LOAD_SPELL_COOLDOWNS         = 15,
@@ -1263,6 +1265,7 @@ public:
     [[nodiscard]] uint8 GetBankBagSlotCount() const { return GetByteValue(PLAYER_BYTES_2, 2); }
     void SetBankBagSlotCount(uint8 count) { SetByteValue(PLAYER_BYTES_2, 2, count); }
     [[nodiscard]] bool HasItemCount(uint32 item, uint32 count = 1, bool inBankAlso = false) const;
+    void UpdateItemCountIndex(Item* item);                 // stack count of an indexed item changed
     bool HasItemFitToSpellRequirements(SpellInfo const* spellInfo, Item const* ignoreItem = nullptr) const;
     bool CanNoReagentCast(SpellInfo const* spellInfo) const;
     [[nodiscard]] bool HasItemOrGemWithIdEquipped(uint32 item, uint32 count, uint8 except_slot = NULL_SLOT) const;
@@ -1371,6 +1374,7 @@ public:
     CinematicMgr* GetCinematicMgr() const { return _cinematicMgr; }
 
     void UpdateEnchantTime(uint32 time);
+    [[nodiscard]] uint32 GetEnchantmentLeftDuration(EnchantDuration const& duration) const { return duration.expireTime > m_enchantDurationTime ? uint32(duration.expireTime - m_enchantDurationTime) : 0; }
     void UpdateSoulboundTradeItems();
     void AddTradeableItem(Item* item);
     void RemoveTradeableItem(Item* item);
@@ -1459,6 +1463,7 @@ public:
     void RemoveRewardedQuest(uint32 questId, bool update = true);
     void SendQuestUpdate(uint32 questId);
     QuestGiverStatus GetQuestDialogStatus(Object* questGiver);
+    void InvalidateQuestGiverStatus() { ++m_questGiverStatusEpoch; } // quest state, rewards or reputation changed
     float GetQuestRate(bool isDFQuest = false);
     void SetDailyQuestStatus(uint32 quest_id);
     bool IsDailyQuestDone(uint32 quest_id);
@@ -1579,6 +1584,7 @@ public:
     static void DeleteOldCharacters(uint32 keepDays);
 
     bool m_mailsUpdated;
+    bool m_mailedItemsLoaded;
 
     void SetBindPoint(ObjectGuid guid);
     void SendTalentWipeConfirm(ObjectGuid guid);
@@ -1614,7 +1620,7 @@ public:
     [[nodiscard]] size_t GetRewardedQuestCount() const { return m_RewardedQuests.size(); }
     [[nodiscard]] bool IsQuestRewarded(uint32 quest_id) const
     {
-        return m_RewardedQuests.find(quest_id) != m_RewardedQuests.end();
+        return m_RewardedQuests.contains(quest_id);
     }
 
     [[nodiscard]] Unit* GetSelectedUnit() const;
@@ -1667,6 +1673,9 @@ public:
         return !!mMitems.erase(itemLowGuid);
     }
 
+    // items of the mails are only loaded when the mailbox is used for the first time
+    void LoadMailedItems();
+
     void PetSpellInitialize();
     void CharmSpellInitialize();
     void PossessSpellInitialize();
@@ -1999,6 +2008,8 @@ public:
     bool UpdatePosition(const Position& pos, bool teleport = false) { return UpdatePosition(pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), pos.GetOrientation(), teleport); }
 
     void ProcessTerrainStatusUpdate() override;
+    // queries the terrain status again only once the player moved Player.TerrainUpdateDistance away from the last query
+    void UpdatePositionDataIfMoved();
 
     void SendMessageToSet(WorldPacket const* data, bool self) const override { SendMessageToSetInRange(data, GetVisibilityRange(), self, true); } // pussywizard!
     void SendMessageToSetInRange(WorldPacket const* data, float dist, bool self, bool includeMargin = false, Player const* skipped_rcvr = nullptr) const override; // pussywizard!
@@ -2357,12 +2368,21 @@ public:
     void SetEntryPoint();
 
     // currently visible objects at player client
-    GuidUnorderedSet m_clientGUIDs;
+    GuidFlatSet m_clientGUIDs;
     std::vector<Unit*> m_newVisible; // pussywizard
+    // stamps of the previous normal and large object visibility passes, 0 if that pass had to check every object
+    uint64 m_visibilityPassStamps[2];
+    float m_visibilityBudgetRange; // 0 if other players aren't limited
 
     [[nodiscard]] bool HaveAtClient(WorldObject const* u) const;
     [[nodiscard]] bool HaveAtClient(ObjectGuid guid) const;
 
+    // Visibility.PlayerBudget: in crowds other players are only shown up to a range that keeps their number about
+    // the budget, players that matter to us (group, target, attackers, hostile casters) are shown regardless
+    [[nodiscard]] bool IsWithinVisibilityBudget(WorldObject const* target) const;
+    void UpdateVisibilityBudget(uint32 visiblePlayers);
+    [[nodiscard]] float GetVisibilityBudgetRange() const { return m_visibilityBudgetRange; }
+
     [[nodiscard]] bool IsNeverVisible() const override;
 
     bool IsVisibleGloballyFor(Player const* player) const;
@@ -2429,7 +2449,10 @@ public:
     void AddInstanceEnterTime(uint32 instanceId, time_t enterTime)
     {
         if (_instanceResetTimes.find(instanceId) == _instanceResetTimes.end())
+        {
             _instanceResetTimes.insert(InstanceTimeMap::value_type(instanceId, enterTime + HOUR));
+            _instanceResetTimesChanged = true;
+        }
     }
 
     // last used pet number (for BG's)
@@ -2617,6 +2640,9 @@ public:
 
     // Performance Varibales
     bool m_NeedToSaveGlyphs;
+    // Signatures of the rows written by the last save of data without per-row change tracking
+    Optional<std::size_t> m_savedAurasHash;
+    Optional<std::size_t> m_savedSpellCooldownsHash;
     // Mount block bug
     uint32 m_MountBlockId;
     // Real stats
@@ -2650,6 +2676,7 @@ public:
     /*********************************************************/
 
     EntryPointData m_entryPointData;
+    bool m_entryPointChanged = false;
 
     /*********************************************************/
     /***                    QUEST SYSTEM                   ***/
@@ -2675,7 +2702,7 @@ public:
     void _LoadAuras(PreparedQueryResult result, uint32 timediff);
     void _LoadGlyphAuras();
     void _LoadInventory(PreparedQueryResult result, uint32 timeDiff);
-    void _LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult);
+    void _LoadMail(PreparedQueryResult mailsResult);
     static Item* _LoadMailedItem(ObjectGuid const& playerGuid, Player* player, uint32 mailId, Mail* mail, Field* fields);
     void _LoadQuestStatus(PreparedQueryResult result);
     void _LoadQuestStatusRewarded(PreparedQueryResult result);
@@ -2755,6 +2782,20 @@ public:
     Item* m_items[PLAYER_SLOTS_COUNT];
     uint32 m_currentBuybackSlot;
 
+    // stack counts of the items in the slots GetItemCount looks at, kept up to date as items are stored, removed and split
+    struct ItemCountIndexEntry
+    {
+        uint32 Carried = 0;
+        uint32 Bank = 0;
+    };
+
+    void AddToItemCountIndex(Item* item, uint8 bag, uint8 slot);
+    void RemoveFromItemCountIndex(Item* item);
+    void ApplyItemCountIndex(Item const* item, uint32 count, bool inBank, bool apply);
+    [[nodiscard]] bool HasItemInCountIndex(uint32 entry) const;      // any stack of the entry stored, carried or banked
+    Acore::FlatHashMap<uint32, ItemCountIndexEntry> m_itemCountIndex;              // by item entry
+    Acore::FlatHashMap<uint32, ItemCountIndexEntry> m_itemLimitCategoryCountIndex; // by ItemLimitCategory
+
     std::vector<Item*> m_itemUpdateQueue;
     bool m_itemUpdateQueueBlocked;
 
@@ -2767,6 +2808,18 @@ public:
     QuestStatusSaveMap m_RewardedQuestsSave;
     void SendQuestGiverStatusMultiple();
 
+    // quest relation part of GetQuestDialogStatus() by giver entry, valid while the epochs and the level match
+    struct QuestGiverStatusCacheEntry
+    {
+        uint32 Epoch;
+        uint32 GlobalEpoch;
+        uint8 Level;
+        QuestGiverStatus Status;
+    };
+
+    Acore::FlatHashMap<uint64, QuestGiverStatusCacheEntry> m_questGiverStatusCache; // by type id << 32 | entry
+    uint32 m_questGiverStatusEpoch;
+
     SkillStatusMap mSkillStatus;
 
     uint32 m_GuildIdInvited;
@@ -2798,7 +2851,8 @@ public:
     //uint32 m_pad;
     //        Spell* m_spellModTakingSpell;  // Spell for which charges are dropped in spell::finish
 
-    EnchantDurationList m_enchantDuration;
+    EnchantDurationList m_enchantDuration;                  // ordered by expire time
+    uint64 m_enchantDurationTime;                           // sum of the update diffs the enchantment durations ran for
     ItemDurationList m_itemDuration;
     ItemDurationList m_itemSoulboundTradeable;
     std::mutex m_soulboundTradableLock;
@@ -2830,6 +2884,10 @@ public:
     uint32 m_zoneUpdateTimer;
     uint32 m_areaUpdateId;
 
+    void ProcessPositionDataChanged(PositionFullTerrainStatus const& data) override;
+    Position m_positionDataPos;                                     // where the current terrain status was queried
+    bool m_positionDataValid;
+
     uint32 m_deathTimer;
     time_t m_deathExpireTime;
 
@@ -2862,6 +2920,7 @@ public:
     Group* m_groupInvite;
     uint32 m_groupUpdateMask;
     uint64 m_auraRaidUpdateMask;
+    Milliseconds m_nextThrottledGroupUpdate;
     bool m_bPassOnGroupLoot;
 
     // last used pet number (for BG's)
@@ -2950,6 +3009,7 @@ private:
     uint32 m_ChampioningFaction;
 
     InstanceTimeMap _instanceResetTimes;
+    bool _instanceResetTimesChanged = false;
     uint32 _pendingBindId;
     uint32 _pendingBindTimer;
 
@@ -2970,6 +3030,7 @@ private:
     bool _wasOutdoor;
 
     PlayerSettingMap m_charSettingsMap;
+    std::set<std::string> m_charSettingsChanged;
 
     Seconds m_creationTime;
 };
@@ -517,6 +517,7 @@ void Player::AddQuest(Quest const* quest, Object* questGiver)
 
     // check for repeatable quests status reset
     questStatusData.Status = QUEST_STATUS_INCOMPLETE;
+    InvalidateQuestGiverStatus();
     questStatusData.Explored = false;
 
     if (quest->HasSpecialFlag(QUEST_SPECIAL_FLAGS_DELIVER))
@@ -821,6 +822,7 @@ void Player::RewardQuest(Quest const* quest, uint32 reward, Object* questGiver,
     RemoveActiveQuest(quest_id, false);
     m_RewardedQuests.insert(quest_id);
     m_RewardedQuestsSave[quest_id] = true;
+    InvalidateQuestGiverStatus();
 
     if (announce)
         SendQuestReward(quest, XP);
@@ -1152,7 +1154,7 @@ bool Player::SatisfyQuestStatus(Quest const* qInfo, bool msg) const
 
 bool Player::SatisfyQuestConditions(Quest const* qInfo, bool msg)
 {
-    ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, qInfo->GetQuestId());
+    ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, qInfo->GetQuestId());
     if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
     {
         if (msg)
@@ -1475,6 +1477,7 @@ void Player::SetQuestStatus(uint32 questId, QuestStatus status, bool update /*=
     if (Quest const* quest = sObjectMgr->GetQuestTemplate(questId))
     {
         m_QuestStatus[questId].Status = status;
+        InvalidateQuestGiverStatus();
 
         if (quest->GetQuestMethod() && !quest->IsAutoComplete())
         {
@@ -1493,6 +1496,7 @@ void Player::RemoveActiveQuest(uint32 questId, bool update /*= true*/)
     {
         m_QuestStatus.erase(itr);
         m_QuestStatusSave[questId] = false;
+        InvalidateQuestGiverStatus();
     }
 
     if (update)
@@ -1506,11 +1510,10 @@ void Player::RemoveActiveQuest(uint32 questId, bool update /*= true*/)
 
 void Player::RemoveRewardedQuest(uint32 questId, bool update /*= true*/)
 {
-    RewardedQuestSet::iterator rewItr = m_RewardedQuests.find(questId);
-    if (rewItr != m_RewardedQuests.end())
+    if (m_RewardedQuests.erase(questId))
     {
-        m_RewardedQuests.erase(rewItr);
         m_RewardedQuestsSave[questId] = false;
+        InvalidateQuestGiverStatus();
     }
 
     if (update)
@@ -1619,6 +1622,15 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
             return DIALOG_STATUS_NONE;
     }
 
+    // the relations only depend on the quest state of the player, unless a quest has conditions or needs a skill
+    uint64 const cacheKey = (uint64(questgiver->GetTypeId()) << 32) | questgiver->GetEntry();
+    uint32 const globalEpoch = sObjectMgr->GetQuestGiverStatusEpoch();
+    auto cached = m_questGiverStatusCache.find(cacheKey);
+    if (cached != m_questGiverStatusCache.end() && cached->second.Epoch == m_questGiverStatusEpoch &&
+        cached->second.GlobalEpoch == globalEpoch && cached->second.Level == GetLevel())
+        return cached->second.Status;
+
+    bool cacheable = true;
     QuestGiverStatus result = DIALOG_STATUS_NONE;
 
     for (QuestRelations::const_iterator i = qir.first; i != qir.second; ++i)
@@ -1629,7 +1641,10 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
         if (!quest)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
+        if (!conditions.empty() || quest->GetRequiredSkill())
+            cacheable = false;
+
         if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
             continue;
 
@@ -1662,7 +1677,10 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
         if (!quest)
             continue;
 
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId());
+        if (!conditions.empty() || quest->GetRequiredSkill())
+            cacheable = false;
+
         if (!sConditionMgr->IsObjectMeetToConditions(this, conditions))
             continue;
 
@@ -1738,6 +1756,9 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object* questgiver)
             result = result2;
     }
 
+    if (cacheable)
+        m_questGiverStatusCache[cacheKey] = { m_questGiverStatusEpoch, globalEpoch, GetLevel(), result };
+
     return result;
 }
 
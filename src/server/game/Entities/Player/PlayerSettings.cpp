@@ -95,25 +95,33 @@ void Player::_SavePlayerSettings(CharacterDatabaseTransaction trans)
         return;
     }
 
-    for (auto& itr : m_charSettingsMap)
+    for (std::string const& source : m_charSettingsChanged)
     {
+        auto itr = m_charSettingsMap.find(source);
+        if (itr == m_charSettingsMap.end())
+            continue;
+
         std::ostringstream data;
 
-        for (auto& setting : itr.second)
+        for (auto& setting : itr->second)
         {
             data << setting.value << ' ';
         }
 
         CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CHAR_SETTINGS);
         stmt->SetData(0, GetGUID().GetCounter());
-        stmt->SetData(1, itr.first);
+        stmt->SetData(1, itr->first);
         stmt->SetData(2, data.str());
         trans->Append(stmt);
     }
+
+    m_charSettingsChanged.clear();
 }
 
 void Player::UpdatePlayerSetting(std::string source, uint8 index, uint32 value)
 {
+    m_charSettingsChanged.insert(source);
+
     auto itr = m_charSettingsMap.find(source);
     uint8 size = index + 1;
 
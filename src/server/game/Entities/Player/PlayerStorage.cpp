@@ -46,6 +46,7 @@
 #include "Log.h"
 #include "LootItemStorage.h"
 #include "MapMgr.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
@@ -72,6 +73,7 @@
 #include "Weather.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <bit>
 
 /// @todo: this import is not necessary for compilation and marked as unused by the IDE
 //  however, for some reasons removing it would cause a damn linking issue
@@ -353,43 +355,40 @@ InventoryResult Player::CanUnequipItems(uint32 item, uint32 count) const
 uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
 {
     uint32 count = 0;
-    for (uint8 i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; i++)
-        if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-            if (pItem != skipItem &&  pItem->GetEntry() == item)
-                count += pItem->GetCount();
+    auto itr = m_itemCountIndex.find(item);
+    if (itr != m_itemCountIndex.end())
+        count = itr->second.Carried + (inBankAlso ? itr->second.Bank : 0);
 
-    for (uint8 i = KEYRING_SLOT_START; i < CURRENCYTOKEN_SLOT_END; ++i)
-        if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-            if (pItem != skipItem && pItem->GetEntry() == item)
-                count += pItem->GetCount();
-
-    for (uint8 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-        if (Bag* pBag = GetBagByPos(i))
-            count += pBag->GetItemCount(item, skipItem);
+    if (skipItem && skipItem->GetCountIndexOwner() == this && skipItem->GetEntry() == item && (inBankAlso || !skipItem->IsIndexedInBank()))
+        count -= skipItem->GetIndexedCount();
 
+    // gems socketed into other items only count when checking the unique limit of a gem
     if (skipItem && skipItem->GetTemplate()->GemProperties)
-        for (uint8 i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
-            if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-                if (pItem != skipItem && pItem->GetTemplate()->Socket[0].Color)
-                    count += pItem->GetGemCountWithID(item);
-
-    if (inBankAlso)
     {
-        // checking every item from 39 to 74 (including bank bags)
-        for (uint8 i = BANK_SLOT_ITEM_START; i < BANK_SLOT_BAG_END; ++i)
-            if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-                if (pItem != skipItem && pItem->GetEntry() == item)
-                    count += pItem->GetCount();
+        auto countGems = [&](Item* pItem)
+        {
+            if (pItem && pItem != skipItem && pItem->GetTemplate()->Socket[0].Color)
+                count += pItem->GetGemCountWithID(item);
+        };
 
-        for (uint8 i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
+        for (uint8 i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
+            countGems(GetItemByPos(INVENTORY_SLOT_BAG_0, i));
+
+        for (uint8 i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
             if (Bag* pBag = GetBagByPos(i))
-                count += pBag->GetItemCount(item, skipItem);
+                for (uint32 j = 0; j < pBag->GetBagSize(); ++j)
+                    countGems(pBag->GetItemByPos(j));
 
-        if (skipItem && skipItem->GetTemplate()->GemProperties)
+        if (inBankAlso)
+        {
             for (uint8 i = BANK_SLOT_ITEM_START; i < BANK_SLOT_ITEM_END; ++i)
-                if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-                    if (pItem != skipItem && pItem->GetTemplate()->Socket[0].Color)
-                        count += pItem->GetGemCountWithID(item);
+                countGems(GetItemByPos(INVENTORY_SLOT_BAG_0, i));
+
+            for (uint8 i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
+                if (Bag* pBag = GetBagByPos(i))
+                    for (uint32 j = 0; j < pBag->GetBagSize(); ++j)
+                        countGems(pBag->GetItemByPos(j));
+        }
     }
 
     return count;
@@ -398,34 +397,12 @@ uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
 uint32 Player::GetItemCountWithLimitCategory(uint32 limitCategory, Item* skipItem) const
 {
     uint32 count = 0;
-    for (int i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; ++i)
-        if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-            if (pItem != skipItem)
-                if (ItemTemplate const* pProto = pItem->GetTemplate())
-                    if (pProto->ItemLimitCategory == limitCategory)
-                        count += pItem->GetCount();
-
-    for (int i = KEYRING_SLOT_START; i < CURRENCYTOKEN_SLOT_END; ++i)
-        if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-            if (pItem != skipItem)
-                if (ItemTemplate const* pProto = pItem->GetTemplate())
-                    if (pProto->ItemLimitCategory == limitCategory)
-                        count += pItem->GetCount();
-
-    for (int i = INVENTORY_SLOT_BAG_START; i < INVENTORY_SLOT_BAG_END; ++i)
-        if (Bag* pBag = GetBagByPos(i))
-            count += pBag->GetItemCountWithLimitCategory(limitCategory, skipItem);
-
-    for (int i = BANK_SLOT_ITEM_START; i < BANK_SLOT_BAG_END; ++i)
-        if (Item* pItem = GetItemByPos(INVENTORY_SLOT_BAG_0, i))
-            if (pItem != skipItem)
-                if (ItemTemplate const* pProto = pItem->GetTemplate())
-                    if (pProto->ItemLimitCategory == limitCategory)
-                        count += pItem->GetCount();
+    auto itr = m_itemLimitCategoryCountIndex.find(limitCategory);
+    if (itr != m_itemLimitCategoryCountIndex.end())
+        count = itr->second.Carried + itr->second.Bank;
 
-    for (int i = BANK_SLOT_BAG_START; i < BANK_SLOT_BAG_END; ++i)
-        if (Bag* pBag = GetBagByPos(i))
-            count += pBag->GetItemCountWithLimitCategory(limitCategory, skipItem);
+    if (skipItem && skipItem->GetCountIndexOwner() == this && skipItem->GetTemplate()->ItemLimitCategory == limitCategory)
+        count -= skipItem->GetIndexedCount();
 
     return count;
 }
@@ -680,6 +657,10 @@ bool Player::IsValidPos(uint8 bag, uint8 slot, bool explicit_pos)
 
 bool Player::HasItemCount(uint32 item, uint32 count, bool inBankAlso) const
 {
+    // items put up in a trade window do not count, only then the slots have to be walked
+    if (!m_trade)
+        return GetItemCount(item, inBankAlso) >= count;
+
     uint32 tempcount = 0;
     for (uint8 i = EQUIPMENT_SLOT_START; i < INVENTORY_SLOT_ITEM_END; i++)
     {
@@ -751,6 +732,100 @@ bool Player::HasItemCount(uint32 item, uint32 count, bool inBankAlso) const
     return false;
 }
 
+// Mirrors the slots GetItemCount walks: equipment, backpack, keyring and currency are carried, bank slots are bank,
+// items in a bag go wherever the bag is and buyback slots are not counted at all
+enum ItemCountRegion
+{
+    ITEM_COUNT_REGION_NONE,
+    ITEM_COUNT_REGION_CARRIED,
+    ITEM_COUNT_REGION_BANK
+};
+
+static ItemCountRegion GetItemCountRegion(uint8 bag, uint8 slot)
+{
+    if (bag != INVENTORY_SLOT_BAG_0)
+    {
+        if (bag >= INVENTORY_SLOT_BAG_START && bag < INVENTORY_SLOT_BAG_END)
+            return ITEM_COUNT_REGION_CARRIED;
+
+        if (bag >= BANK_SLOT_BAG_START && bag < BANK_SLOT_BAG_END)
+            return ITEM_COUNT_REGION_BANK;
+
+        return ITEM_COUNT_REGION_NONE;
+    }
+
+    if (slot < INVENTORY_SLOT_ITEM_END || (slot >= KEYRING_SLOT_START && slot < CURRENCYTOKEN_SLOT_END))
+        return ITEM_COUNT_REGION_CARRIED;
+
+    if (slot >= BANK_SLOT_ITEM_START && slot < BANK_SLOT_BAG_END)
+        return ITEM_COUNT_REGION_BANK;
+
+    return ITEM_COUNT_REGION_NONE;
+}
+
+void Player::ApplyItemCountIndex(Item const* item, uint32 count, bool inBank, bool apply)
+{
+    ItemCountIndexEntry& entry = m_itemCountIndex[item->GetEntry()];
+    uint32& entryCount = inBank ? entry.Bank : entry.Carried;
+    entryCount = apply ? entryCount + count : entryCount - count;
+
+    if (uint32 limitCategory = item->GetTemplate()->ItemLimitCategory)
+    {
+        ItemCountIndexEntry& category = m_itemLimitCategoryCountIndex[limitCategory];
+        uint32& categoryCount = inBank ? category.Bank : category.Carried;
+        categoryCount = apply ? categoryCount + count : categoryCount - count;
+    }
+}
+
+void Player::AddToItemCountIndex(Item* item, uint8 bag, uint8 slot)
+{
+    RemoveFromItemCountIndex(item);
+
+    ItemCountRegion region = GetItemCountRegion(bag, slot);
+    if (region == ITEM_COUNT_REGION_NONE)
+        return;
+
+    bool inBank = region == ITEM_COUNT_REGION_BANK;
+    ApplyItemCountIndex(item, item->GetCount(), inBank, true);
+    item->SetCountIndexState(this, item->GetCount(), inBank);
+
+    // a bag brings its contents along
+    if (bag == INVENTORY_SLOT_BAG_0)
+        if (Bag* pBag = item->ToBag())
+            for (uint32 i = 0; i < pBag->GetBagSize(); ++i)
+                if (Item* bagItem = pBag->GetItemByPos(i))
+                    AddToItemCountIndex(bagItem, slot, i);
+}
+
+void Player::RemoveFromItemCountIndex(Item* item)
+{
+    if (item->GetCountIndexOwner() != this)
+        return;
+
+    ApplyItemCountIndex(item, item->GetIndexedCount(), item->IsIndexedInBank(), false);
+    item->SetCountIndexState(nullptr, 0, false);
+
+    if (Bag* pBag = item->ToBag())
+        for (uint32 i = 0; i < pBag->GetBagSize(); ++i)
+            if (Item* bagItem = pBag->GetItemByPos(i))
+                RemoveFromItemCountIndex(bagItem);
+}
+
+bool Player::HasItemInCountIndex(uint32 entry) const
+{
+    auto itr = m_itemCountIndex.find(entry);
+    return itr != m_itemCountIndex.end() && (itr->second.Carried || itr->second.Bank);
+}
+
+void Player::UpdateItemCountIndex(Item* item)
+{
+    bool inBank = item->IsIndexedInBank();
+    ApplyItemCountIndex(item, item->GetIndexedCount(), inBank, false);
+    ApplyItemCountIndex(item, item->GetCount(), inBank, true);
+    item->SetCountIndexState(this, item->GetCount(), inBank);
+}
+
+
 bool Player::HasItemOrGemWithIdEquipped(uint32 item, uint32 count, uint8 except_slot) const
 {
     uint32 tempcount = 0;
@@ -1028,21 +1103,26 @@ InventoryResult Player::CanStoreItem_InBag(uint8 bag, ItemPosCountVec& dest, Ite
     if (!ItemCanGoIntoBag(pProto, pBagProto))
         return EQUIP_ERR_ITEM_DOESNT_GO_INTO_BAG;
 
-    for (uint32 j = 0; j < pBag->GetBagSize(); j++)
+    // if merge only the used slots, if !merge only the free ones
+    uint64 slots = merge ? pBag->GetUsedSlotMask() : pBag->GetFreeSlotMask();
+
+    // ignore move item (this slot will be empty at move)
+    if (pSrcItem && pBag->GetItemByPos(pSrcItem->GetSlot()) == pSrcItem)
+        slots ^= uint64(1) << pSrcItem->GetSlot();
+
+    // no stack of this item is stored anywhere, nothing to merge with
+    if (merge && !HasItemInCountIndex(pProto->ItemId))
+        slots = 0;
+
+    for (; slots; slots &= slots - 1)
     {
+        uint32 j = std::countr_zero(slots);
+
         // skip specific slot already processed in first called CanStoreItem_InSpecificSlot
         if (j == skip_slot)
             continue;
 
-        Item* pItem2 = GetItemByPos(bag, j);
-
-        // ignore move item (this slot will be empty at move)
-        if (pItem2 == pSrcItem)
-            pItem2 = nullptr;
-
-        // if merge skip empty, if !merge skip non-empty
-        if ((pItem2 != nullptr) != merge)
-            continue;
+        Item* pItem2 = merge ? GetItemByPos(bag, j) : nullptr;
 
         uint32 need_space = pProto->GetMaxStackSize();
 
@@ -1079,6 +1159,10 @@ InventoryResult Player::CanStoreItem_InInventorySlots(uint8 slot_begin, uint8 sl
     if (pSrcItem && pSrcItem->IsNotEmptyBag())
         return EQUIP_ERR_CAN_ONLY_DO_WITH_EMPTY_BAGS;
 
+    // no stack of this item is stored anywhere, nothing to merge with
+    if (merge && !HasItemInCountIndex(pProto->ItemId))
+        return EQUIP_ERR_OK;
+
     for (uint32 j = slot_begin; j < slot_end; j++)
     {
         // skip specific slot already processed in first called CanStoreItem_InSpecificSlot
@@ -2669,6 +2753,8 @@ Item* Player::_StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool
         else
             pBag->StoreItem(slot, pItem, update);
 
+        AddToItemCountIndex(pItem, bag, slot);
+
         if (IsInWorld() && update)
         {
             pItem->AddToWorld();
@@ -2907,6 +2993,7 @@ void Player::VisualizeItem(uint8 slot, Item* pItem)
     pItem->SetGuidValue(ITEM_FIELD_OWNER, GetGUID());
     pItem->SetSlot(slot);
     pItem->SetContainer(nullptr);
+    AddToItemCountIndex(pItem, INVENTORY_SLOT_BAG_0, slot);
 
     if (slot < EQUIPMENT_SLOT_END)
         SetVisibleItemSlot(slot, pItem);
@@ -2926,6 +3013,8 @@ void Player::RemoveItem(uint8 bag, uint8 slot, bool update, bool swap)
     {
         LOG_DEBUG("entities.player.items", "STORAGE: RemoveItem bag = {}, slot = {}, item = {}", bag, slot, pItem->GetEntry());
 
+        RemoveFromItemCountIndex(pItem);
+
         RemoveEnchantmentDurations(pItem);
         RemoveItemDurations(pItem);
         RemoveTradeableItem(pItem);
@@ -3050,6 +3139,8 @@ void Player::DestroyItem(uint8 bag, uint8 slot, bool update)
             for (uint8 i = 0; i < MAX_BAG_SIZE; ++i)
                 DestroyItem(slot, i, update);
 
+        RemoveFromItemCountIndex(pItem);
+
         if (pItem->HasFlag(ITEM_FIELD_FLAGS, ITEM_FIELD_FLAG_WRAPPED))
         {
             CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GIFT);
@@ -3873,8 +3964,10 @@ void Player::SwapItem(uint16 src, uint16 dst)
                     if (!bagItem)
                         continue;
 
+                    RemoveFromItemCountIndex(bagItem);
                     fullBag->RemoveItem(i, true);
                     emptyBag->StoreItem(count, bagItem, true);
+                    AddToItemCountIndex(bagItem, emptyBag->GetSlot(), count);
                     bagItem->SetState(ITEM_CHANGED, this);
 
                     ++count;
@@ -4177,26 +4270,27 @@ void Player::UpdateItemDuration(uint32 time, bool realtimeonly)
     }
 }
 
+/// Durations whose enchantment got cleared or replaced without going through AddEnchantmentDuration are left behind
+static bool IsEnchantDurationCurrent(EnchantDuration const& duration)
+{
+    return duration.item->GetEnchantmentId(duration.slot) == duration.enchantId;
+}
+
 void Player::UpdateEnchantTime(uint32 time)
 {
-    for (EnchantDurationList::iterator itr = m_enchantDuration.begin(), next; itr != m_enchantDuration.end(); itr = next)
+    m_enchantDurationTime += time;
+
+    // the list is ordered by expire time, so only expired entries are touched
+    while (!m_enchantDuration.empty() && m_enchantDuration.front().expireTime <= m_enchantDurationTime)
     {
-        ASSERT(itr->item);
-        next = itr;
-        if (!itr->item->GetEnchantmentId(itr->slot))
-        {
-            next = m_enchantDuration.erase(itr);
-        }
-        else if (itr->leftduration <= time)
-        {
-            ApplyEnchantment(itr->item, itr->slot, false, false);
-            itr->item->ClearEnchantment(itr->slot);
-            next = m_enchantDuration.erase(itr);
-        }
-        else if (itr->leftduration > time)
+        EnchantDuration const duration = m_enchantDuration.front();
+        m_enchantDuration.pop_front();
+
+        ASSERT(duration.item);
+        if (IsEnchantDurationCurrent(duration))
         {
-            itr->leftduration -= time;
-            ++next;
+            ApplyEnchantment(duration.item, duration.slot, false, false);
+            duration.item->ClearEnchantment(duration.slot);
         }
     }
 }
@@ -4221,7 +4315,8 @@ void Player::RemoveEnchantmentDurations(Item* item)
         if (itr->item == item)
         {
             // save duration in item
-            item->SetEnchantmentDuration(EnchantmentSlot(itr->slot), itr->leftduration, this);
+            if (IsEnchantDurationCurrent(*itr))
+                item->SetEnchantmentDuration(EnchantmentSlot(itr->slot), GetEnchantmentLeftDuration(*itr), this);
             itr = m_enchantDuration.erase(itr);
         }
         else
@@ -4301,7 +4396,8 @@ void Player::AddEnchantmentDuration(Item* item, EnchantmentSlot slot, uint32 dur
     {
         if (itr->item == item && itr->slot == slot)
         {
-            itr->item->SetEnchantmentDuration(itr->slot, itr->leftduration, this);
+            if (IsEnchantDurationCurrent(*itr))
+                itr->item->SetEnchantmentDuration(itr->slot, GetEnchantmentLeftDuration(*itr), this);
             m_enchantDuration.erase(itr);
             break;
         }
@@ -4309,7 +4405,11 @@ void Player::AddEnchantmentDuration(Item* item, EnchantmentSlot slot, uint32 dur
     if (item && duration > 0)
     {
         GetSession()->SendItemEnchantTimeUpdate(GetGUID(), item->GetGUID(), slot, uint32(duration / 1000));
-        m_enchantDuration.push_back(EnchantDuration(item, slot, duration));
+
+        uint64 expireTime = m_enchantDurationTime + duration;
+        EnchantDurationList::iterator itr = std::find_if(m_enchantDuration.begin(), m_enchantDuration.end(),
+            [expireTime](EnchantDuration const& other) { return other.expireTime > expireTime; });
+        m_enchantDuration.insert(itr, EnchantDuration(item, slot, item->GetEnchantmentId(slot), expireTime));
     }
 }
 
@@ -4745,7 +4845,8 @@ void Player::SendEnchantmentDurations()
 {
     for (EnchantDurationList::const_iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end(); ++itr)
     {
-        GetSession()->SendItemEnchantTimeUpdate(GetGUID(), itr->item->GetGUID(), itr->slot, uint32(itr->leftduration) / 1000);
+        if (IsEnchantDurationCurrent(*itr))
+            GetSession()->SendItemEnchantTimeUpdate(GetGUID(), itr->item->GetGUID(), itr->slot, GetEnchantmentLeftDuration(*itr) / 1000);
     }
 }
 
@@ -4753,7 +4854,8 @@ void Player::UpdateEnchantmentDurations()
 {
     for (EnchantDurationList::iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end(); ++itr)
     {
-        itr->item->SetEnchantmentDuration(itr->slot, itr->leftduration, this);
+        if (IsEnchantDurationCurrent(*itr))
+            itr->item->SetEnchantmentDuration(itr->slot, GetEnchantmentLeftDuration(*itr), this);
     }
 }
 
@@ -5176,6 +5278,7 @@ bool Player::LoadFromDB(ObjectGuid playerGuid, CharacterDatabaseQueryHolder cons
                 m_taxi.AddTaxiDestination(m_entryPointData.taxiPath[0]);
                 m_taxi.AddTaxiDestination(m_entryPointData.taxiPath[1]);
                 m_entryPointData.ClearTaxiPath();
+                m_entryPointChanged = true;
             }
         }
     }
@@ -5478,7 +5581,7 @@ bool Player::LoadFromDB(ObjectGuid playerGuid, CharacterDatabaseQueryHolder cons
     m_reputationMgr->LoadFromDB(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_REPUTATION));
 
     // xinef: load mails before inventory, so problematic items can be added to already loaded mails
-    _LoadMail(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAILS), holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS));
+    _LoadMail(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAILS));
 
     _LoadInventory(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_INVENTORY), time_diff);
 
@@ -6171,14 +6274,12 @@ Item* Player::_LoadMailedItem(ObjectGuid const& playerGuid, Player* player, uint
     return item;
 }
 
-void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult)
+void Player::_LoadMail(PreparedQueryResult mailsResult)
 {
     time_t cur_time = GameTime::GetGameTime().count();
 
     m_mail.clear();
 
-    std::unordered_map<uint32, Mail*> mailById;
-
     if (mailsResult)
     {
         do
@@ -6215,21 +6316,41 @@ void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mail
             m->state = MAIL_STATE_UNCHANGED;
 
             m_mail.push_back(m);
-            mailById[m->messageID] = m;
         } while (mailsResult->NextRow());
     }
 
-    if (mailItemsResult)
+    UpdateNextMailTimeAndUnreads();
+}
+
+void Player::LoadMailedItems()
+{
+    if (m_mailedItemsLoaded)
+        return;
+
+    m_mailedItemsLoaded = true;
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
+    stmt->SetData(0, GetGUID().GetCounter());
+    PreparedQueryResult result = CharacterDatabase.Query(stmt);
+    if (!result)
+        return;
+
+    std::unordered_map<uint32, Mail*> mailById;
+    for (Mail* mail : m_mail)
+        mailById[mail->messageID] = mail;
+
+    do
     {
-        do
-        {
-            Field* fields = mailItemsResult->Fetch();
-            uint32 mailId = fields[14].Get<uint32>();
-            _LoadMailedItem(GetGUID(), this, mailId, mailById[mailId], fields);
-        } while (mailItemsResult->NextRow());
-    }
+        Field* fields = result->Fetch();
 
-    UpdateNextMailTimeAndUnreads();
+        // mails received since login already brought their items along
+        if (GetMItem(fields[11].Get<uint32>()))
+            continue;
+
+        uint32 mailId = fields[14].Get<uint32>();
+        auto itr = mailById.find(mailId);
+        _LoadMailedItem(GetGUID(), this, mailId, itr != mailById.end() ? itr->second : nullptr, fields);
+    } while (result->NextRow());
 }
 
 void Player::LoadPet()
@@ -6337,7 +6458,6 @@ void Player::_LoadQuestStatusRewarded(PreparedQueryResult result)
 
     if (result)
     {
-        m_RewardedQuests.rehash(result->GetRowCount());
         do
         {
             Field* fields = result->Fetch();
@@ -7102,6 +7222,11 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
+    // keeps the next login of this account from overtaking the save in the async queue
+    trans->SetOrderingKey(GetSession()->GetAccountId());
+
+    std::size_t statementCount = trans->GetSize();
+
     _SaveCharacter(create, trans);
 
     if (m_mailsUpdated)                                     //save mails only when needed
@@ -7120,7 +7245,7 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     _SaveActions(trans);
     _SaveAuras(trans, logout);
     _SaveSkills(trans);
-    m_achievementMgr->SaveToDB(trans);
+    m_achievementMgr->SaveToDB(trans, logout);
     m_reputationMgr->SaveToDB(trans);
     _SaveEquipmentSets(trans);
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
@@ -7133,6 +7258,8 @@ void Player::SaveToDB(CharacterDatabaseTransaction trans, bool create, bool logo
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    METRIC_VALUE("player_save_statements", uint64(trans->GetSize() - statementCount));
+
     // save pet (hunter pet level and experience and all type pets health/mana).
     if (Pet* pet = GetPet())
         pet->SavePetToDB(PET_SAVE_AS_CURRENT);
@@ -7203,9 +7330,15 @@ void Player::_SaveActions(CharacterDatabaseTransaction trans)
 
 void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
-    stmt->SetData(0, GetGUID().GetCounter());
-    trans->Append(stmt);
+    CharacterDatabasePreparedStatement* stmt = nullptr;
+
+    // auras are rewritten as a whole, so only do it when any saved row differs from the previous save
+    std::vector<CharacterDatabasePreparedStatement*> inserts;
+    std::size_t hash = 0;
+    auto hashCombine = [&hash](auto value)
+    {
+        hash ^= std::hash<decltype(value)>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
 
     for (AuraMap::const_iterator itr = m_ownedAuras.begin(); itr != m_ownedAuras.end(); ++itr)
     {
@@ -7255,8 +7388,40 @@ void Player::_SaveAuras(CharacterDatabaseTransaction trans, bool logout)
         stmt->SetData(index++, itr->second->GetMaxDuration());
         stmt->SetData(index++, itr->second->GetDuration());
         stmt->SetData(index, itr->second->GetCharges());
-        trans->Append(stmt);
+        inserts.push_back(stmt);
+
+        hashCombine(itr->second->GetCasterGUID().GetRawValue());
+        hashCombine(itr->second->GetCastItemGUID().GetRawValue());
+        hashCombine(itr->second->GetId());
+        hashCombine(effMask);
+        hashCombine(recalculateMask);
+        hashCombine(itr->second->GetStackAmount());
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+        {
+            hashCombine(damage[i]);
+            hashCombine(baseDamage[i]);
+        }
+        hashCombine(itr->second->GetMaxDuration());
+        hashCombine(itr->second->GetDuration());
+        hashCombine(itr->second->GetCharges());
     }
+
+    if (m_savedAurasHash == hash)
+    {
+        for (CharacterDatabasePreparedStatement* insert : inserts)
+            delete insert;
+
+        return;
+    }
+
+    m_savedAurasHash = hash;
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_AURA);
+    stmt->SetData(0, GetGUID().GetCounter());
+    trans->Append(stmt);
+
+    for (CharacterDatabasePreparedStatement* insert : inserts)
+        trans->Append(insert);
 }
 
 void Player::_SaveInventory(CharacterDatabaseTransaction trans)
@@ -7318,13 +7483,18 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
 
     // update enchantment durations
     for (EnchantDurationList::iterator itr = m_enchantDuration.begin(); itr != m_enchantDuration.end(); ++itr)
-        itr->item->SetEnchantmentDuration(itr->slot, itr->leftduration, this);
+        if (IsEnchantDurationCurrent(*itr))
+            itr->item->SetEnchantmentDuration(itr->slot, GetEnchantmentLeftDuration(*itr), this);
 
     // if no changes
     if (m_itemUpdateQueue.empty())
         return;
 
     ObjectGuid::LowType lowGuid = GetGUID().GetCounter();
+
+    // Inventory rows are replaced by item guid and unique per slot, so they can be appended
+    // after all deletes and sent as multi-row statements
+    std::vector<CharacterDatabasePreparedStatement*> replaces;
     for (size_t i = 0; i < m_itemUpdateQueue.size(); ++i)
     {
         Item* item = m_itemUpdateQueue[i];
@@ -7377,12 +7547,16 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
         {
             case ITEM_NEW:
             case ITEM_CHANGED:
+                // the inventory row of an item that only lost or regained durability is unchanged
+                if (item->HasOnlyChangedFields(ITEM_CHANGED_FIELD_DURABILITY))
+                    break;
+
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_INVENTORY_ITEM);
                 stmt->SetData(0, lowGuid);
                 stmt->SetData(1, bag_guid);
                 stmt->SetData (2, item->GetSlot());
                 stmt->SetData(3, item->GetGUID().GetCounter());
-                trans->Append(stmt);
+                replaces.push_back(stmt);
                 break;
             case ITEM_REMOVED:
                 stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_INVENTORY_BY_ITEM);
@@ -7395,6 +7569,9 @@ void Player::_SaveInventory(CharacterDatabaseTransaction trans)
         item->SaveToDB(trans);                                   // item have unchanged inventory record and can be save standalone
     }
     m_itemUpdateQueue.clear();
+
+    for (CharacterDatabasePreparedStatement* replace : replaces)
+        trans->Append(replace);
 }
 
 void Player::_SaveMail(CharacterDatabaseTransaction trans)
@@ -7484,6 +7661,9 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction trans)
 
     bool keepAbandoned = !(sWorld->GetCleaningFlags() & CharacterDatabaseCleaner::CLEANING_FLAG_QUESTSTATUS);
 
+    // Every quest is saved at most once, so replaces can be appended after the deletes as multi-row statements
+    std::vector<CharacterDatabasePreparedStatement*> replaces;
+
     for (saveItr = m_QuestStatusSave.begin(); saveItr != m_QuestStatusSave.end(); ++saveItr)
     {
         if (saveItr->second)
@@ -7507,7 +7687,7 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction trans)
                     stmt->SetData(index++, statusItr->second.ItemCount[i]);
 
                 stmt->SetData(index, statusItr->second.PlayerCount);
-                trans->Append(stmt);
+                replaces.push_back(stmt);
             }
         }
         else
@@ -7521,6 +7701,11 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction trans)
 
     m_QuestStatusSave.clear();
 
+    for (CharacterDatabasePreparedStatement* replace : replaces)
+        trans->Append(replace);
+
+    replaces.clear();
+
     for (saveItr = m_RewardedQuestsSave.begin(); saveItr != m_RewardedQuestsSave.end(); ++saveItr)
     {
         if (saveItr->second)
@@ -7530,11 +7715,18 @@ void Player::_SaveQuestStatus(CharacterDatabaseTransaction trans)
 
         stmt->SetData(0, GetGUID().GetCounter());
         stmt->SetData(1, saveItr->first);
-        trans->Append(stmt);
+
+        if (saveItr->second)
+            replaces.push_back(stmt);
+        else
+            trans->Append(stmt);
     }
 
     m_RewardedQuestsSave.clear();
 
+    for (CharacterDatabasePreparedStatement* insert : replaces)
+        trans->Append(insert);
+
     if (!isTransaction)
         CharacterDatabase.CommitTransaction(trans);
 }
@@ -7659,6 +7851,7 @@ void Player::_SaveMonthlyQuestStatus(CharacterDatabaseTransaction trans)
 void Player::_SaveSkills(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement* stmt = nullptr;
+    std::vector<CharacterDatabasePreparedStatement*> inserts;
     // we don't need transactions here.
     for (SkillStatusMap::iterator itr = mSkillStatus.begin(); itr != mSkillStatus.end();)
     {
@@ -7691,7 +7884,7 @@ void Player::_SaveSkills(CharacterDatabaseTransaction trans)
                 stmt->SetData(1, uint16(itr->first));
                 stmt->SetData(2, value);
                 stmt->SetData(3, max);
-                trans->Append(stmt);
+                inserts.push_back(stmt);
 
                 break;
             case SKILL_CHANGED:
@@ -7710,12 +7903,19 @@ void Player::_SaveSkills(CharacterDatabaseTransaction trans)
 
         ++itr;
     }
+
+    // appended last so they can be sent as multi-row statements
+    for (CharacterDatabasePreparedStatement* insert : inserts)
+        trans->Append(insert);
 }
 
 void Player::_SaveSpells(CharacterDatabaseTransaction trans)
 {
     CharacterDatabasePreparedStatement* stmt = nullptr;
 
+    // Inserts are appended after all deletes so the transaction can send them as multi-row statements
+    std::vector<CharacterDatabasePreparedStatement*> inserts;
+
     for (PlayerSpellMap::iterator itr = m_spells.begin(); itr != m_spells.end();)
     {
         // xinef: skip temporary spells
@@ -7741,7 +7941,7 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
             stmt->SetData(0, GetGUID().GetCounter());
             stmt->SetData(1, itr->first);
             stmt->SetData(2, itr->second->specMask);
-            trans->Append(stmt);
+            inserts.push_back(stmt);
         }
 
         if (itr->second->State == PLAYERSPELL_REMOVED)
@@ -7755,6 +7955,9 @@ void Player::_SaveSpells(CharacterDatabaseTransaction trans)
             ++itr;
         }
     }
+
+    for (CharacterDatabasePreparedStatement* insert : inserts)
+        trans->Append(insert);
 }
 
 // save player stats -- only for external usage
@@ -30,6 +30,7 @@
 #include "OutdoorPvPMgr.h"
 #include "Pet.h"
 #include "Player.h"
+#include "ReputationMgr.h"
 #include "ScriptMgr.h"
 #include "SkillDiscovery.h"
 #include "SpellAuraEffects.h"
@@ -94,6 +95,9 @@ void Player::Update(uint32 p_time)
 
     UpdateAfkReport(now);
 
+    // reputation gained from kills and rewards of this update, in one packet
+    GetReputationMgr().SendPendingStates();
+
     // Xinef: update charm AI only if we are controlled by creature or
     // non-posses player charm
     if (IsCharmed() && !HasUnitFlag(UNIT_FLAG_POSSESSED))
@@ -1570,6 +1574,8 @@ void Player::UpdateObjectVisibility(bool forced, bool fromUpdate)
     if (!IsInWorld())
         return;
 
+    MarkVisibilityStateChanged();
+
     if (!forced)
         AddToNotify(NOTIFY_VISIBILITY_CHANGED);
     else if (!isBeingLoaded())
@@ -1585,14 +1591,14 @@ void Player::UpdateObjectVisibility(bool forced, bool fromUpdate)
 }
 
 template <class T>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, T* target,
+inline void UpdateVisibilityOf_helper(GuidFlatSet& s64, T* target,
                                       std::vector<Unit*>& /*v*/)
 {
     s64.insert(target->GetGUID());
 }
 
 template <>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, GameObject* target,
+inline void UpdateVisibilityOf_helper(GuidFlatSet& s64, GameObject* target,
                                       std::vector<Unit*>& /*v*/)
 {
     // @HACK: This is to prevent objects like deeprun tram from disappearing
@@ -1602,7 +1608,7 @@ inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, GameObject* target,
 }
 
 template <>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Creature* target,
+inline void UpdateVisibilityOf_helper(GuidFlatSet& s64, Creature* target,
                                       std::vector<Unit*>& v)
 {
     s64.insert(target->GetGUID());
@@ -1610,7 +1616,7 @@ inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Creature* target,
 }
 
 template <>
-inline void UpdateVisibilityOf_helper(GuidUnorderedSet& s64, Player* target,
+inline void UpdateVisibilityOf_helper(GuidFlatSet& s64, Player* target,
                                       std::vector<Unit*>& v)
 {
     s64.insert(target->GetGUID());
@@ -1635,7 +1641,7 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data,
 {
     if (HaveAtClient(target))
     {
-        if (!CanSeeOrDetect(target, false, true))
+        if (!CanSeeOrDetect(target, false, true) || !IsWithinVisibilityBudget(target))
         {
             BeforeVisibilityDestroy<T>(target, this);
 
@@ -1645,7 +1651,7 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data,
     }
     else
     {
-        if (CanSeeOrDetect(target, false, true))
+        if (CanSeeOrDetect(target, false, true) && IsWithinVisibilityBudget(target))
         {
             target->BuildCreateUpdateBlockForPlayer(&data, this);
             UpdateVisibilityOf_helper(m_clientGUIDs, target, visibleNow);
@@ -1668,7 +1674,7 @@ void Player::UpdateVisibilityOf(WorldObject* target)
 {
     if (HaveAtClient(target))
     {
-        if (!CanSeeOrDetect(target, false, true))
+        if (!CanSeeOrDetect(target, false, true) || !IsWithinVisibilityBudget(target))
         {
             if (target->GetTypeId() == TYPEID_UNIT)
                 BeforeVisibilityDestroy<Creature>(target->ToCreature(), this);
@@ -1679,7 +1685,7 @@ void Player::UpdateVisibilityOf(WorldObject* target)
     }
     else
     {
-        if (CanSeeOrDetect(target, false, true))
+        if (CanSeeOrDetect(target, false, true) && IsWithinVisibilityBudget(target))
         {
             target->SendUpdateToPlayer(this);
             m_clientGUIDs.insert(target->GetGUID());
@@ -1693,6 +1699,45 @@ void Player::UpdateVisibilityOf(WorldObject* target)
     }
 }
 
+bool Player::IsWithinVisibilityBudget(WorldObject const* target) const
+{
+    if (!m_visibilityBudgetRange || target->GetTypeId() != TYPEID_PLAYER)
+        return true;
+
+    if (GetExactDist2dSq(target) <= m_visibilityBudgetRange * m_visibilityBudgetRange)
+        return true;
+
+    Player const* player = target->ToPlayer();
+    if (IsInSameRaidWith(player) || GetTarget() == player->GetGUID() || (GetTransport() && GetTransport() == player->GetTransport()))
+        return true;
+
+    // players attacking us and hostile casters are shown over everyone else
+    if (player->GetTarget() == GetGUID() && player->IsInCombat())
+        return true;
+
+    return player->IsNonMeleeSpellCast(false) && IsHostileTo(player);
+}
+
+void Player::UpdateVisibilityBudget(uint32 visiblePlayers)
+{
+    uint32 const budget = sWorld->getIntConfig(CONFIG_VISIBILITY_PLAYER_BUDGET);
+    if (!budget || IsGameMaster() || GetMap()->IsBattlegroundOrArena())
+    {
+        m_visibilityBudgetRange = 0.0f;
+        return;
+    }
+
+    // shrink fast when over budget, grow back slowly so the range doesn't oscillate around the budget
+    float const sightRange = GetSightRange();
+    float range = m_visibilityBudgetRange ? m_visibilityBudgetRange : sightRange;
+    if (visiblePlayers > budget)
+        range = std::max(range * 0.8f, VISIBILITY_DISTANCE_TINY);
+    else if (visiblePlayers * 10 < budget * 9)
+        range += 5.0f;
+
+    m_visibilityBudgetRange = range < sightRange ? range : 0.0f;
+}
+
 void Player::UpdateTriggerVisibility()
 {
     if (m_clientGUIDs.empty())
@@ -1703,7 +1748,7 @@ void Player::UpdateTriggerVisibility()
 
     UpdateData  udata;
     WorldPacket packet;
-    for (GuidUnorderedSet::iterator itr = m_clientGUIDs.begin();
+    for (GuidFlatSet::iterator itr = m_clientGUIDs.begin();
          itr != m_clientGUIDs.end(); ++itr)
     {
         if ((*itr).IsCreatureOrVehicle())
@@ -1746,7 +1791,7 @@ void Player::UpdateForQuestWorldObjects()
 
     UpdateData  udata;
     WorldPacket packet;
-    for (GuidUnorderedSet::iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
+    for (GuidFlatSet::iterator itr = m_clientGUIDs.begin(); itr != m_clientGUIDs.end(); ++itr)
     {
         if ((*itr).IsGameObject())
         {
@@ -1767,7 +1812,7 @@ void Player::UpdateForQuestWorldObjects()
                 {
                     //! This code doesn't look right, but it was logically converted to condition system to do the exact
                     //! same thing it did before. It definitely needs to be overlooked for intended functionality.
-                    ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(obj->GetEntry(), _itr->second.spellId);
+                    ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(obj->GetEntry(), _itr->second.spellId);
                     bool buildUpdateBlock = false;
                     for (ConditionList::const_iterator jtr = conds.begin(); jtr != conds.end() && !buildUpdateBlock; ++jtr)
                         if ((*jtr)->ConditionType == CONDITION_QUESTREWARDED || (*jtr)->ConditionType == CONDITION_QUESTTAKEN)
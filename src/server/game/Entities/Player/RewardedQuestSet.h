@@ -0,0 +1,162 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _REWARDED_QUEST_SET_H
+#define _REWARDED_QUEST_SET_H
+
+#include "Define.h"
+#include <bit>
+#include <iterator>
+#include <unordered_set>
+#include <vector>
+
+/// Quests a player was rewarded for. Ids below DENSE_LIMIT, which covers all quests of the client,
+/// are kept in a bitset that grows up to the highest rewarded id, custom ids above it in a sparse set.
+class RewardedQuestSet
+{
+    typedef std::unordered_set<uint32> SparseSet;
+
+public:
+    static constexpr uint32 DENSE_LIMIT = 0x10000;
+
+    /// Dense ids in ascending order first, then the sparse ones
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = uint32;
+        using difference_type = std::ptrdiff_t;
+        using pointer = uint32 const*;
+        using reference = uint32;
+
+        const_iterator(RewardedQuestSet const* set, uint32 denseIndex, SparseSet::const_iterator sparseItr)
+            : _set(set), _denseIndex(denseIndex), _sparseItr(sparseItr) { }
+
+        uint32 operator*() const { return _denseIndex < _set->GetDenseSize() ? _denseIndex : *_sparseItr; }
+
+        const_iterator& operator++()
+        {
+            if (_denseIndex < _set->GetDenseSize())
+                _denseIndex = _set->FindNextDense(_denseIndex + 1);
+            else
+                ++_sparseItr;
+
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator itr = *this;
+            ++(*this);
+            return itr;
+        }
+
+        bool operator==(const_iterator const& right) const { return _denseIndex == right._denseIndex && _sparseItr == right._sparseItr; }
+        bool operator!=(const_iterator const& right) const { return !(*this == right); }
+
+    private:
+        RewardedQuestSet const* _set;
+        uint32 _denseIndex;
+        SparseSet::const_iterator _sparseItr;
+    };
+
+    typedef const_iterator iterator;
+
+    RewardedQuestSet() : _denseCount(0) { }
+
+    /// true if the quest was not in the set yet
+    bool insert(uint32 questId)
+    {
+        if (questId >= DENSE_LIMIT)
+            return _sparse.insert(questId).second;
+
+        uint32 const word = questId / BITS_PER_WORD;
+        if (word >= _dense.size())
+            _dense.resize(word + 1, 0);
+
+        uint64 const bit = uint64(1) << (questId % BITS_PER_WORD);
+        if (_dense[word] & bit)
+            return false;
+
+        _dense[word] |= bit;
+        ++_denseCount;
+        return true;
+    }
+
+    std::size_t erase(uint32 questId)
+    {
+        if (questId >= DENSE_LIMIT)
+            return _sparse.erase(questId);
+
+        if (!contains(questId))
+            return 0;
+
+        _dense[questId / BITS_PER_WORD] &= ~(uint64(1) << (questId % BITS_PER_WORD));
+        --_denseCount;
+        return 1;
+    }
+
+    [[nodiscard]] bool contains(uint32 questId) const
+    {
+        if (questId >= DENSE_LIMIT)
+            return _sparse.find(questId) != _sparse.end();
+
+        uint32 const word = questId / BITS_PER_WORD;
+        return word < _dense.size() && (_dense[word] >> (questId % BITS_PER_WORD)) & 1;
+    }
+
+    [[nodiscard]] std::size_t count(uint32 questId) const { return contains(questId) ? 1 : 0; }
+    [[nodiscard]] std::size_t size() const { return _denseCount + _sparse.size(); }
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    void clear()
+    {
+        _dense.clear();
+        _denseCount = 0;
+        _sparse.clear();
+    }
+
+    [[nodiscard]] const_iterator begin() const { return const_iterator(this, FindNextDense(0), _sparse.begin()); }
+    [[nodiscard]] const_iterator end() const { return const_iterator(this, GetDenseSize(), _sparse.end()); }
+
+private:
+    static constexpr uint32 BITS_PER_WORD = 64;
+
+    [[nodiscard]] uint32 GetDenseSize() const { return uint32(_dense.size()) * BITS_PER_WORD; }
+
+    /// first rewarded dense id at or after index, GetDenseSize() if there is none
+    [[nodiscard]] uint32 FindNextDense(uint32 index) const
+    {
+        for (uint32 word = index / BITS_PER_WORD; word < _dense.size(); ++word)
+        {
+            uint64 bits = _dense[word];
+            if (word == index / BITS_PER_WORD)
+                bits &= ~uint64(0) << (index % BITS_PER_WORD);
+
+            if (bits)
+                return word * BITS_PER_WORD + std::countr_zero(bits);
+        }
+
+        return GetDenseSize();
+    }
+
+    std::vector<uint64> _dense;
+    uint32 _denseCount;
+    SparseSet _sparse;
+};
+
+#endif
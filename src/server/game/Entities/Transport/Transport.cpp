@@ -32,7 +32,7 @@
 #include "World.h"
 #include "WorldModel.h"
 
-MotionTransport::MotionTransport() : Transport(), _transportInfo(nullptr), _isMoving(true), _pendingStop(false), _triggeredArrivalEvent(false), _triggeredDepartureEvent(false), _passengersLoaded(false), _delayedTeleport(false)
+MotionTransport::MotionTransport() : Transport(), _transportInfo(nullptr), _passengerPositionsOutdated(false), _isMoving(true), _pendingStop(false), _triggeredArrivalEvent(false), _triggeredDepartureEvent(false), _passengersLoaded(false), _delayedTeleport(false)
 {
     m_updateFlag = UPDATEFLAG_TRANSPORT | UPDATEFLAG_LOWGUID | UPDATEFLAG_STATIONARY_POSITION | UPDATEFLAG_ROTATION;
 }
@@ -211,19 +211,31 @@ void MotionTransport::Update(uint32 diff)
 
     // Set position
     _positionChangeTimer.Update(diff);
+    _passengerPositionTimer.Update(diff);
     if (_positionChangeTimer.Passed())
     {
         _positionChangeTimer.Reset(positionUpdateDelay);
         if (IsMoving())
         {
-            float t = CalculateSegmentPos(float(timer) * 0.001f);
-            G3D::Vector3 pos, dir;
-            _currentFrame->Spline->evaluate_percent(_currentFrame->Index, t, pos);
-            _currentFrame->Spline->evaluate_derivative(_currentFrame->Index, t, dir);
-            UpdatePosition(pos.x, pos.y, pos.z, NormalizeOrientation(std::atan2(dir.y, dir.x) + M_PI));
+            float x, y, z, o;
+            _currentFrame->GetPathPosition(timer, x, y, z, o);
+
+            // clients move the passengers along with the transport, the world positions on our side follow in steps
+            bool const updatePassengers = _passengerPositionTimer.Passed();
+            if (updatePassengers)
+                _passengerPositionTimer.Reset(sWorld->getIntConfig(CONFIG_TRANSPORT_PASSENGER_UPDATE_INTERVAL));
+
+            UpdatePosition(x, y, z, o, updatePassengers);
         }
         else
         {
+            if (_passengerPositionsOutdated)
+            {
+                UpdatePassengerPositions(_passengers);
+                UpdatePassengerPositions(_staticPassengers);
+                _passengerPositionsOutdated = false;
+            }
+
             /* There are four possible scenarios that trigger loading/unloading passengers:
               1. transport moves from inactive to active grid
               2. the grid that transport is currently in becomes active
@@ -246,7 +258,7 @@ void MotionTransport::DelayedUpdate(uint32  /*diff*/)
     DelayedTeleportTransport();
 }
 
-void MotionTransport::UpdatePosition(float x, float y, float z, float o)
+void MotionTransport::UpdatePosition(float x, float y, float z, float o, bool updatePassengers)
 {
     if (!GetMap()->IsGridLoaded(x, y)) // pussywizard: should not happen, but just in case
         GetMap()->LoadGrid(x, y);
@@ -254,6 +266,10 @@ void MotionTransport::UpdatePosition(float x, float y, float z, float o)
     Relocate(x, y, z, o);
     UpdateModelPosition();
 
+    _passengerPositionsOutdated = !updatePassengers;
+    if (!updatePassengers)
+        return;
+
     UpdatePassengerPositions(_passengers);
 
     if (_staticPassengers.empty())
@@ -473,37 +489,6 @@ void MotionTransport::MoveToNextWaypoint()
         _nextFrame = GetKeyFrames().begin();
 }
 
-float MotionTransport::CalculateSegmentPos(float now)
-{
-    KeyFrame const& frame = *_currentFrame;
-    const float speed = float(m_goInfo->moTransport.moveSpeed);
-    const float accel = float(m_goInfo->moTransport.accelRate);
-    float timeSinceStop = frame.TimeFrom + (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
-    float timeUntilStop = frame.TimeTo - (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
-    float segmentPos, dist;
-    float accelTime = _transportInfo->accelTime;
-    float accelDist = _transportInfo->accelDist;
-    // calculate from nearest stop, less confusing calculation...
-    if (timeSinceStop < timeUntilStop)
-    {
-        if (timeSinceStop < accelTime)
-            dist = 0.5f * accel * timeSinceStop * timeSinceStop;
-        else
-            dist = accelDist + (timeSinceStop - accelTime) * speed;
-        segmentPos = dist - frame.DistSinceStop;
-    }
-    else
-    {
-        if (timeUntilStop < _transportInfo->accelTime)
-            dist = 0.5f * accel * timeUntilStop * timeUntilStop;
-        else
-            dist = accelDist + (timeUntilStop - accelTime) * speed;
-        segmentPos = frame.DistUntilStop - dist;
-    }
-
-    return segmentPos / frame.NextDistFromPrev;
-}
-
 bool MotionTransport::TeleportTransport(uint32 newMapid, float x, float y, float z, float o)
 {
     Map const* oldMap = GetMap();
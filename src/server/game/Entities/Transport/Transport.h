@@ -57,7 +57,7 @@ public:
 
     void Update(uint32 diff) override;
     void DelayedUpdate(uint32 diff);
-    void UpdatePosition(float x, float y, float z, float o);
+    void UpdatePosition(float x, float y, float z, float o, bool updatePassengers = true);
 
     void AddPassenger(WorldObject* passenger, bool withAll = false) override;
     void RemovePassenger(WorldObject* passenger, bool withAll = false) override;
@@ -81,7 +81,6 @@ public:
     std::string GetDebugInfo() const override;
 private:
     void MoveToNextWaypoint();
-    float CalculateSegmentPos(float perc);
     bool TeleportTransport(uint32 newMapid, float x, float y, float z, float o);
     void DelayedTeleportTransport();
     void UpdatePassengerPositions(PassengerSet& passengers);
@@ -95,6 +94,8 @@ private:
     KeyFrameVec::const_iterator _currentFrame;
     KeyFrameVec::const_iterator _nextFrame;
     TimeTrackerSmall _positionChangeTimer;
+    TimeTrackerSmall _passengerPositionTimer;
+    bool _passengerPositionsOutdated;
     bool _isMoving;
     bool _pendingStop;
 
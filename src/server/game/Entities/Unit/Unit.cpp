@@ -70,6 +70,7 @@
 #include "Vehicle.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "ZoneProfiler.h"
 #include <math.h>
 
 float baseMoveSpeed[MAX_MOVE_TYPE] =
@@ -217,6 +218,8 @@ Unit::Unit(bool isWorldObject) : WorldObject(isWorldObject),
     m_AutoRepeatFirstCast(false),
     m_procDeep(0),
     m_removedAurasCount(0),
+    m_procAurasFlags(0),
+    m_procAurasGeneration(0),
     i_motionMaster(new MotionMaster(this)),
     m_regenTimer(0),
     m_ThreatMgr(this),
@@ -321,6 +324,7 @@ Unit::Unit(bool isWorldObject) : WorldObject(isWorldObject),
     m_last_notify_mstime = 0;
     m_delayed_unit_relocation_timer = 0;
     m_delayed_unit_ai_notify_timer = 0;
+    m_delayedVisibilityQueued = false;
     bRequestForcedVisibilityUpdate = false;
 
     m_applyResilience = false;
@@ -401,6 +405,8 @@ Unit::~Unit()
 
 void Unit::Update(uint32 p_time)
 {
+    PROFILE_ZONE("Unit::Update");
+
     sScriptMgr->OnUnitUpdate(this, p_time);
 
     // WARNING! Order of execution here is important, do not change.
@@ -420,7 +426,7 @@ void Unit::Update(uint32 p_time)
             {
                 m_delayed_unit_relocation_timer = 0;
                 //ExecuteDelayedUnitRelocationEvent();
-                FindMap()->i_objectsForDelayedVisibility.insert(this);
+                FindMap()->AddObjectForDelayedVisibility(this);
             }
             else
                 m_delayed_unit_relocation_timer -= p_time;
@@ -536,6 +542,7 @@ void Unit::Update(uint32 p_time)
     GetMotionMaster()->UpdateMotion(p_time);
 
     InvalidateValuesUpdateCache();
+    InvalidateMovementUpdateCache();
 }
 
 bool Unit::haveOffhandWeapon() const
@@ -4425,6 +4432,7 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
 
     AuraApplication* aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
+    _AddProcAura(aurApp);
 
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: even if it gets removed, it will be reapplied in a second
@@ -4521,6 +4529,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    _RemoveProcAura(aurApp);
 
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: event if it gets removed, it will be reapplied in a second
@@ -4643,12 +4652,90 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura)
     }
 }
 
+void Unit::_AddProcAura(AuraApplication* aurApp)
+{
+    if (m_procAurasGeneration != sSpellMgr->GetProcDataGeneration())
+        return; // the whole index is rebuilt on the next proc anyway
+
+    SpellInfo const* spellInfo = aurApp->GetBase()->GetSpellInfo();
+    uint32 procFlags = sSpellMgr->GetSpellProcEventFlags(spellInfo);
+    if (!procFlags)
+        return;
+
+    // same position as in m_appliedAuras, after all applications of the same spell
+    auto itr = std::upper_bound(m_procAuras.begin(), m_procAuras.end(), spellInfo->Id, [](uint32 spellId, ProcAuraEntry const& entry) { return spellId < entry.SpellId; });
+    m_procAuras.insert(itr, { spellInfo->Id, procFlags, aurApp });
+    m_procAurasFlags |= procFlags;
+}
+
+void Unit::_RemoveProcAura(AuraApplication* aurApp)
+{
+    auto itr = std::find_if(m_procAuras.begin(), m_procAuras.end(), [aurApp](ProcAuraEntry const& entry) { return entry.AurApp == aurApp; });
+    if (itr == m_procAuras.end())
+        return;
+
+    m_procAuras.erase(itr);
+    m_procAurasFlags = 0;
+    for (ProcAuraEntry const& entry : m_procAuras)
+        m_procAurasFlags |= entry.ProcFlags;
+}
+
+void Unit::_UpdateProcAuraIndex()
+{
+    uint32 generation = sSpellMgr->GetProcDataGeneration();
+    if (m_procAurasGeneration == generation)
+        return;
+
+    m_procAuras.clear();
+    m_procAurasFlags = 0;
+    m_procAurasGeneration = generation;
+    for (AuraApplicationMap::value_type const& pair : m_appliedAuras)
+        _AddProcAura(pair.second);
+}
+
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
     if (apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    _InvalidateAuraModifierCache(aurEff->GetAuraType());
+}
+
+void Unit::_InvalidateAuraModifierCache(AuraType auratype)
+{
+    for (auto itr = m_auraModifierCache.begin(); itr != m_auraModifierCache.end();)
+    {
+        if (AuraType(itr->first >> 33) == auratype)
+            itr = m_auraModifierCache.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+Unit::AuraModifierAggregate Unit::GetAuraModifierAggregate(AuraType auratype, Optional<uint32> miscMask) const
+{
+    uint64 key = (uint64(auratype) << 33) | (uint64(miscMask.has_value()) << 32) | miscMask.value_or(0);
+    auto itr = m_auraModifierCache.find(key);
+    if (itr != m_auraModifierCache.end())
+        return itr->second;
+
+    AuraModifierAggregate aggregate = { 0, 1.0f, 0, 0 };
+    for (AuraEffect const* aurEff : GetAuraEffectsByType(auratype))
+    {
+        if (miscMask && !(aurEff->GetMiscValue() & *miscMask))
+            continue;
+
+        int32 amount = aurEff->GetAmount();
+        aggregate.Total += amount;
+        AddPct(aggregate.Multiplier, amount);
+        aggregate.MaxPositive = std::max(aggregate.MaxPositive, amount);
+        aggregate.MaxNegative = std::min(aggregate.MaxNegative, amount);
+    }
+
+    m_auraModifierCache.emplace(key, aggregate);
+    return aggregate;
 }
 
 // All aura base removes should go threw this function!
@@ -5851,82 +5938,61 @@ int32 Unit::GetTotalAuraModifierAreaExclusive(AuraType auratype) const
 
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    if (mTotalAuraList.empty())
+    if (m_modAuras[auratype].empty())
         return 0;
 
-    int32 modifier = 0;
-
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetAmount();
-
-    return modifier;
+    return GetAuraModifierAggregate(auratype, std::nullopt).Total;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPct(multiplier, (*i)->GetAmount());
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
 
-    return multiplier;
+    return GetAuraModifierAggregate(auratype, std::nullopt).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype, std::nullopt).MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype, std::nullopt).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask)
-            modifier += (*i)->GetAmount();
-    }
-    return modifier;
+    return GetAuraModifierAggregate(auratype, misc_mask).Total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if (((*i)->GetMiscValue() & misc_mask))
-            AddPct(multiplier, (*i)->GetAmount());
+    if (m_modAuras[auratype].empty())
+        return 1.0f;
 
-    return multiplier;
+    return GetAuraModifierAggregate(auratype, misc_mask).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, const AuraEffect* except) const
 {
+    if (m_modAuras[auratype].empty())
+        return 0;
+
+    // the excluded effect is not part of the cached aggregate
+    if (!except)
+        return GetAuraModifierAggregate(auratype, misc_mask).MaxPositive;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -5941,16 +6007,10 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
+    if (m_modAuras[auratype].empty())
+        return 0;
 
-    return modifier;
+    return GetAuraModifierAggregate(auratype, misc_mask).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
@@ -6294,7 +6354,7 @@ void Unit::SendSpellNonMeleeDamageLog(SpellNonMeleeDamage* log)
     //    data << float(log->GlanceChance);
     //    data << float(log->CrushChance);
     //}
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage(&data);
 }
 
 void Unit::SendSpellNonMeleeDamageLog(Unit* target, SpellInfo const* spellInfo, uint32 Damage, SpellSchoolMask damageSchoolMask, uint32 AbsorbedDamage, uint32 Resist, bool PhysicalDamage, uint32 Blocked, bool CriticalHit /*= false*/, bool Split /*= false*/)
@@ -6381,7 +6441,18 @@ void Unit::SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo)
             return;
     }
 
-    SendMessageToSet(&data, true);
+    if (IsInWorld())
+        GetMap()->QueueCombatLog(this, data);
+    else
+        SendMessageToSet(&data, true);
+}
+
+void Unit::SendCombatLogMessage(WorldPacket const* data)
+{
+    if (IsInWorld() && sWorld->getBoolConfig(CONFIG_COMBAT_LOG_AGGREGATE))
+        GetMap()->QueueCombatLog(this, *data);
+    else
+        SendMessageToSet(data, true);
 }
 
 void Unit::SendSpellMiss(Unit* target, uint32 spellID, SpellMissInfo missInfo)
@@ -6502,7 +6573,7 @@ void Unit::SendAttackStateUpdate(CalcDamageInfo* damageInfo)
         data << uint32(0);
     }
 
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage(&data);
 }
 
 void Unit::SendAttackStateUpdate(uint32 HitInfo, Unit* target, uint8 /*SwingType*/, SpellSchoolMask damageSchoolMask, uint32 Damage, uint32 AbsorbDamage, uint32 Resist, VictimState TargetState, uint32 BlockedAmount)
@@ -10037,8 +10108,8 @@ void Unit::setPowerType(Powers new_powertype)
         if (player->NeedSendSpectatorData())
         {
             ArenaSpectator::SendCommand_UInt32Value(FindMap(), GetGUID(), "PWT", new_powertype);
-            ArenaSpectator::SendCommand_UInt32Value(FindMap(), GetGUID(), "MPW", new_powertype == POWER_RAGE || new_powertype == POWER_RUNIC_POWER ? GetMaxPower(new_powertype) / 10 : GetMaxPower(new_powertype));
-            ArenaSpectator::SendCommand_UInt32Value(FindMap(), GetGUID(), "CPW", new_powertype == POWER_RAGE || new_powertype == POWER_RUNIC_POWER ? GetPower(new_powertype) / 10 : GetPower(new_powertype));
+            ArenaSpectator::QueueCommand_UInt32Value(FindMap(), GetGUID(), "MPW", new_powertype == POWER_RAGE || new_powertype == POWER_RUNIC_POWER ? GetMaxPower(new_powertype) / 10 : GetMaxPower(new_powertype));
+            ArenaSpectator::QueueCommand_UInt32Value(FindMap(), GetGUID(), "CPW", new_powertype == POWER_RAGE || new_powertype == POWER_RUNIC_POWER ? GetPower(new_powertype) / 10 : GetPower(new_powertype));
         }
 }
 
@@ -11235,7 +11306,7 @@ void Unit::SendHealSpellLog(HealInfo const& healInfo, bool critical)
     data << uint32(healInfo.GetAbsorb()); // Absorb amount
     data << uint8(critical ? 1 : 0);
     data << uint8(0); // unused
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage(&data);
 }
 
 int32 Unit::HealBySpell(HealInfo& healInfo, bool critical)
@@ -11262,7 +11333,7 @@ void Unit::SendEnergizeSpellLog(Unit* victim, uint32 spellID, uint32 damage, Pow
     data << uint32(spellID);
     data << uint32(powerType);
     data << uint32(damage);
-    SendMessageToSet(&data, true);
+    SendCombatLogMessage(&data);
 }
 
 void Unit::EnergizeBySpell(Unit* victim, uint32 spellID, uint32 damage, Powers powerType)
@@ -14425,6 +14496,7 @@ void Unit::SetSpeed(UnitMoveType mtype, float rate, bool forced)
 
     m_speed_rate[mtype] = rate;
 
+    InvalidateMovementUpdateCache();
     propagateSpeedChange();
 
     WorldPacket data;
@@ -15492,7 +15564,7 @@ void Unit::SetHealth(uint32 val)
     {
         Player* player = ToPlayer();
         if (player->NeedSendSpectatorData())
-            ArenaSpectator::SendCommand_UInt32Value(FindMap(), GetGUID(), "CHP", val);
+            ArenaSpectator::QueueCommand_UInt32Value(FindMap(), GetGUID(), "CHP", val);
 
         if (player->GetGroup())
             player->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_CUR_HP);
@@ -15505,7 +15577,7 @@ void Unit::SetHealth(uint32 val)
                 if (Player* player = owner->ToPlayer())
                 {
                     if (player->NeedSendSpectatorData() && pet->GetCreatureTemplate()->family)
-                        ArenaSpectator::SendCommand_UInt32Value(player->FindMap(), player->GetGUID(), "PHP", (uint32)pet->GetHealthPct());
+                        ArenaSpectator::QueueCommand_UInt32Value(player->FindMap(), player->GetGUID(), "PHP", (uint32)pet->GetHealthPct());
 
                     if (player->GetGroup())
                         player->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_PET_CUR_HP);
@@ -15527,7 +15599,7 @@ void Unit::SetMaxHealth(uint32 val)
     {
         Player* player = ToPlayer();
         if (player->NeedSendSpectatorData())
-            ArenaSpectator::SendCommand_UInt32Value(FindMap(), GetGUID(), "MHP", val);
+            ArenaSpectator::QueueCommand_UInt32Value(FindMap(), GetGUID(), "MHP", val);
 
         if (player->GetGroup())
             player->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_MAX_HP);
@@ -15540,7 +15612,7 @@ void Unit::SetMaxHealth(uint32 val)
                 if (Player* player = owner->ToPlayer())
                 {
                     if (player->NeedSendSpectatorData() && pet->GetCreatureTemplate()->family)
-                        ArenaSpectator::SendCommand_UInt32Value(player->FindMap(), player->GetGUID(), "PHP", (uint32)pet->GetHealthPct());
+                        ArenaSpectator::QueueCommand_UInt32Value(player->FindMap(), player->GetGUID(), "PHP", (uint32)pet->GetHealthPct());
 
                     if (player->GetGroup())
                         player->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_PET_MAX_HP);
@@ -15577,7 +15649,7 @@ void Unit::SetPower(Powers power, uint32 val, bool withPowerUpdate /*= true*/, b
 
     if (withPowerUpdate)
     {
-        WorldPacket data(SMSG_POWER_UPDATE);
+        WorldPacket data(SMSG_POWER_UPDATE, GetPackGUID().size() + 1 + 4);
         data << GetPackGUID();
         data << uint8(power);
         data << uint32(val);
@@ -15590,7 +15662,7 @@ void Unit::SetPower(Powers power, uint32 val, bool withPowerUpdate /*= true*/, b
         Player* player = ToPlayer();
         if (getPowerType() == power && player->NeedSendSpectatorData())
         {
-            ArenaSpectator::SendCommand_UInt32Value(FindMap(), GetGUID(), "CPW", power == POWER_RAGE || power == POWER_RUNIC_POWER ? val / 10 : val);
+            ArenaSpectator::QueueCommand_UInt32Value(FindMap(), GetGUID(), "CPW", power == POWER_RAGE || power == POWER_RUNIC_POWER ? val / 10 : val);
         }
 
         if (player->GetGroup())
@@ -15627,7 +15699,7 @@ void Unit::SetMaxPower(Powers power, uint32 val)
     {
         Player* player = ToPlayer();
         if (getPowerType() == power && player->NeedSendSpectatorData())
-            ArenaSpectator::SendCommand_UInt32Value(FindMap(), GetGUID(), "MPW", power == POWER_RAGE || power == POWER_RUNIC_POWER ? val / 10 : val);
+            ArenaSpectator::QueueCommand_UInt32Value(FindMap(), GetGUID(), "MPW", power == POWER_RAGE || power == POWER_RUNIC_POWER ? val / 10 : val);
 
         if (player->GetGroup())
             player->SetGroupUpdateFlag(GROUP_UPDATE_FLAG_MAX_POWER);
@@ -16415,24 +16487,33 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, procPhase, procExtra, procSpell, damageInfo, healInfo, procAura, procAuraEffectIndex);
 
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+    // Fill procTriggered list, only auras reacting to one of the event's proc flags can pass IsTriggeredAtSpellProcEvent
+    _UpdateProcAuraIndex();
+    if (!(m_procAurasFlags & procFlag))
+        return;
+
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
+    for (std::size_t procIndex = 0; procIndex < m_procAuras.size(); ++procIndex)
     {
+        ProcAuraEntry const procEntry = m_procAuras[procIndex];
+        if (!(procEntry.ProcFlags & procFlag))
+            continue;
+
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == procEntry.SpellId)
             continue;
 
         // Xinef: Generic Item Equipment cooldown, -1 is a special marker
-        if (itr->second->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(itr->first, uint32(-1)))
+        if (procEntry.AurApp->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(procEntry.SpellId, uint32(-1)))
             continue;
 
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(procEntry.AurApp->GetBase());
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = procEntry.AurApp->GetBase()->GetSpellInfo();
 
         // only auras that have trigger spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -16445,7 +16526,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             active = true;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(procEntry.AurApp, eventInfo))
         {
             continue;
         }
@@ -16453,13 +16534,13 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool isTriggeredAtSpellProcEvent = IsTriggeredAtSpellProcEvent(target, triggerData.aura, attType, isVictim, active, triggerData.spellProcEvent, eventInfo);
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(itr->second, eventInfo, isTriggeredAtSpellProcEvent))
+        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(procEntry.AurApp, eventInfo, isTriggeredAtSpellProcEvent))
         {
             continue;
         }
 
         // do checks using conditions table
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL_PROC, spellProto->Id);
         ConditionSourceInfo condInfo = ConditionSourceInfo(eventInfo.GetActor(), eventInfo.GetActionTarget());
         if (!sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
         {
@@ -16473,9 +16554,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool hasTriggeredProc = false;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (procEntry.AurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = procEntry.AurApp->GetBase()->GetEffect(i);
 
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
@@ -19389,6 +19470,8 @@ void Unit::SetPhaseMask(uint32 newPhaseMask, bool update)
 
 void Unit::UpdateObjectVisibility(bool forced, bool /*fromUpdate*/)
 {
+    MarkVisibilityStateChanged();
+
     if (!forced)
         AddToNotify(NOTIFY_VISIBILITY_CHANGED);
     else
@@ -19822,7 +19905,7 @@ bool Unit::HandleSpellClick(Unit* clicker, int8 seatId)
             continue;
 
         //! Check database conditions
-        ConditionList conds = sConditionMgr->GetConditionsForSpellClickEvent(spellClickEntry, itr->second.spellId);
+        ConditionList const& conds = sConditionMgr->GetConditionsForSpellClickEvent(spellClickEntry, itr->second.spellId);
         ConditionSourceInfo info = ConditionSourceInfo(clicker, this);
         if (!sConditionMgr->IsObjectMeetToConditions(info, conds))
             continue;
@@ -20326,7 +20409,7 @@ void Unit::UpdateOrientation(float orientation)
 {
     SetOrientation(orientation);
     if (IsVehicle())
-        GetVehicleKit()->RelocatePassengers();
+        GetMap()->AddVehicleToPassengerRelocation(this);
 }
 
 //! Only server-side height update, does not broadcast to client
@@ -20334,7 +20417,7 @@ void Unit::UpdateHeight(float newZ)
 {
     Relocate(GetPositionX(), GetPositionY(), newZ);
     if (IsVehicle())
-        GetVehicleKit()->RelocatePassengers();
+        GetMap()->AddVehicleToPassengerRelocation(this);
 }
 
 void Unit::SendThreatListUpdate()
@@ -20738,7 +20821,7 @@ int32 Unit::CalculateAOEDamageReduction(int32 damage, uint32 schoolMask, Unit* c
     return damage;
 }
 
-void Unit::ExecuteDelayedUnitRelocationEvent()
+void Unit::ExecuteDelayedUnitRelocationEvent(std::vector<Creature*>* relocatedCreatures /*= nullptr*/)
 {
     this->RemoveFromNotify(NOTIFY_VISIBILITY_CHANGED);
     if (!this->IsInWorld() || this->IsDuringRemoveFromWorld())
@@ -20838,8 +20921,13 @@ void Unit::ExecuteDelayedUnitRelocationEvent()
 
         unit->m_last_notify_position.Relocate(unit->GetPositionX(), unit->GetPositionY(), unit->GetPositionZ());
 
-        Acore::CreatureRelocationNotifier relocate(*unit);
-        Cell::VisitAllObjects(unit, relocate, unit->GetVisibilityRange() + VISIBILITY_COMPENSATION);
+        if (relocatedCreatures)
+            relocatedCreatures->push_back(unit);
+        else
+        {
+            Acore::CreatureRelocationNotifier relocate(*unit);
+            Cell::VisitAllObjects(unit, relocate, unit->GetVisibilityRange() + VISIBILITY_COMPENSATION);
+        }
 
         this->AddToNotify(NOTIFY_AI_RELOCATION);
     }
@@ -21081,75 +21169,71 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     UpdateMask updateMask;
     updateMask.SetCount(m_valuesCount);
 
-    for (uint16 index = 0; index < m_valuesCount; ++index)
+    BuildValuesUpdateMask(updateType, flags, visibleFlag, visibleFlag & UF_FLAG_SPECIAL_INFO, updateMask);
+    if (HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK))
+        updateMask.SetBit(UNIT_FIELD_AURASTATE);
+
+    for (uint32 index = updateMask.FindNextSetBit(0); index < m_valuesCount; index = updateMask.FindNextSetBit(index + 1))
     {
-        if (_fieldNotifyFlags & flags[index] ||
-                ((flags[index] & visibleFlag) & UF_FLAG_SPECIAL_INFO) ||
-                ((updateType == UPDATETYPE_VALUES ? _changesMask.GetBit(index) : m_uint32Values[index]) && (flags[index] & visibleFlag)) ||
-                (index == UNIT_FIELD_AURASTATE && HasFlag(UNIT_FIELD_AURASTATE, PER_CASTER_AURA_STATE_MASK)))
+        if (index == UNIT_NPC_FLAGS)
         {
-            updateMask.SetBit(index);
-
-            if (index == UNIT_NPC_FLAGS)
-            {
-                cacheValue.posPointers.UnitNPCFlagsPos = int32(fieldBuffer.wpos());
-                fieldBuffer << m_uint32Values[UNIT_NPC_FLAGS];
-            }
-            else if (index == UNIT_FIELD_AURASTATE)
-            {
-                cacheValue.posPointers.UnitFieldAuraStatePos = int32(fieldBuffer.wpos());
-                fieldBuffer << uint32(0); // Fill in later.
-            }
-            // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
-            else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
-            {
-                // convert from float to uint32 and send
-                fieldBuffer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
-            }
-            // there are some float values which may be negative or can't get negative due to other checks
-            else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
-                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
-                     (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
-                     (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
-            {
-                fieldBuffer << uint32(m_floatValues[index]);
-            }
-            // Gamemasters should be always able to select units - remove not selectable flag
-            else if (index == UNIT_FIELD_FLAGS)
-            {
-                cacheValue.posPointers.UnitFieldFlagsPos = int32(fieldBuffer.wpos());
-                fieldBuffer << m_uint32Values[UNIT_FIELD_FLAGS];
-            }
-            // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
-            else if (index == UNIT_FIELD_DISPLAYID)
-            {
-                cacheValue.posPointers.UnitFieldDisplayPos = int32(fieldBuffer.wpos());
-                fieldBuffer << m_uint32Values[UNIT_FIELD_DISPLAYID];
-            }
-            else if (index == UNIT_DYNAMIC_FLAGS)
-            {
-                cacheValue.posPointers.UnitDynamicFlagsPos = int32(fieldBuffer.wpos());
-                uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
-                fieldBuffer << dynamicFlags;
-            }
-            else if (index == UNIT_FIELD_BYTES_2)
-            {
-                cacheValue.posPointers.UnitFieldBytes2Pos = int32(fieldBuffer.wpos());
-                fieldBuffer << m_uint32Values[index];
-            }
-            else if (index == UNIT_FIELD_FACTIONTEMPLATE)
-            {
-                cacheValue.posPointers.UnitFieldFactionTemplatePos = int32(fieldBuffer.wpos());
-                fieldBuffer << m_uint32Values[index];
-            }
-            else
-            {
-                if (sScriptMgr->ShouldTrackValuesUpdatePosByIndex(this, updateType, index))
-                    cacheValue.posPointers.other[index] = static_cast<uint32>(fieldBuffer.wpos());
+            cacheValue.posPointers.UnitNPCFlagsPos = int32(fieldBuffer.wpos());
+            fieldBuffer << m_uint32Values[UNIT_NPC_FLAGS];
+        }
+        else if (index == UNIT_FIELD_AURASTATE)
+        {
+            cacheValue.posPointers.UnitFieldAuraStatePos = int32(fieldBuffer.wpos());
+            fieldBuffer << uint32(0); // Fill in later.
+        }
+        // FIXME: Some values at server stored in float format but must be sent to client in uint32 format
+        else if (index >= UNIT_FIELD_BASEATTACKTIME && index <= UNIT_FIELD_RANGEDATTACKTIME)
+        {
+            // convert from float to uint32 and send
+            fieldBuffer << uint32(m_floatValues[index] < 0 ? 0 : m_floatValues[index]);
+        }
+        // there are some float values which may be negative or can't get negative due to other checks
+        else if ((index >= UNIT_FIELD_NEGSTAT0   && index <= UNIT_FIELD_NEGSTAT4) ||
+                 (index >= UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSPOSITIVE + 6)) ||
+                 (index >= UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE  && index <= (UNIT_FIELD_RESISTANCEBUFFMODSNEGATIVE + 6)) ||
+                 (index >= UNIT_FIELD_POSSTAT0   && index <= UNIT_FIELD_POSSTAT4))
+        {
+            fieldBuffer << uint32(m_floatValues[index]);
+        }
+        // Gamemasters should be always able to select units - remove not selectable flag
+        else if (index == UNIT_FIELD_FLAGS)
+        {
+            cacheValue.posPointers.UnitFieldFlagsPos = int32(fieldBuffer.wpos());
+            fieldBuffer << m_uint32Values[UNIT_FIELD_FLAGS];
+        }
+        // use modelid_a if not gm, _h if gm for CREATURE_FLAG_EXTRA_TRIGGER creatures
+        else if (index == UNIT_FIELD_DISPLAYID)
+        {
+            cacheValue.posPointers.UnitFieldDisplayPos = int32(fieldBuffer.wpos());
+            fieldBuffer << m_uint32Values[UNIT_FIELD_DISPLAYID];
+        }
+        else if (index == UNIT_DYNAMIC_FLAGS)
+        {
+            cacheValue.posPointers.UnitDynamicFlagsPos = int32(fieldBuffer.wpos());
+            uint32 dynamicFlags = m_uint32Values[UNIT_DYNAMIC_FLAGS] & ~(UNIT_DYNFLAG_TAPPED | UNIT_DYNFLAG_TAPPED_BY_PLAYER);
+            fieldBuffer << dynamicFlags;
+        }
+        else if (index == UNIT_FIELD_BYTES_2)
+        {
+            cacheValue.posPointers.UnitFieldBytes2Pos = int32(fieldBuffer.wpos());
+            fieldBuffer << m_uint32Values[index];
+        }
+        else if (index == UNIT_FIELD_FACTIONTEMPLATE)
+        {
+            cacheValue.posPointers.UnitFieldFactionTemplatePos = int32(fieldBuffer.wpos());
+            fieldBuffer << m_uint32Values[index];
+        }
+        else
+        {
+            if (sScriptMgr->ShouldTrackValuesUpdatePosByIndex(this, updateType, index))
+                cacheValue.posPointers.other[index] = static_cast<uint32>(fieldBuffer.wpos());
 
-                // send in current format (float as float, uint32 as uint32)
-                fieldBuffer << m_uint32Values[index];
-            }
+            // send in current format (float as float, uint32 as uint32)
+            fieldBuffer << m_uint32Values[index];
         }
     }
 
@@ -21171,6 +21255,39 @@ void Unit::BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target)
     _valuesUpdateCache.insert(std::pair<uint64, BuildValuesCachedBuffer>(cacheKey, std::move(cacheValue)));
 }
 
+void Unit::BuildCachedMovementUpdate(ByteBuffer* data, uint16 flags)
+{
+    uint32 const gameTime = GameTime::GetGameTimeMS().count();
+    uint32 const splineId = movespline->GetId();
+    ObjectGuid const victimGuid = GetVictim() ? GetVictim()->GetGUID() : ObjectGuid::Empty;
+
+    // The movement block carries the game time, so a cached block is at most reused within the tick it was built in.
+    // Speed changes drop the cache, everything else the block is built from is compared here.
+    MovementUpdateCachedBuffer& cache = _movementUpdateCache[flags];
+    if (cache.buffer.size() && cache.gameTime == gameTime && cache.splineId == splineId && cache.victimGuid == victimGuid &&
+        cache.movementFlags == GetUnitMovementFlags() && cache.extraMovementFlags == GetExtraUnitMovementFlags() &&
+        cache.fallTime == m_movementInfo.fallTime &&
+        cache.position.GetPositionX() == GetPositionX() && cache.position.GetPositionY() == GetPositionY() &&
+        cache.position.GetPositionZ() == GetPositionZ() && cache.position.GetOrientation() == GetOrientation())
+    {
+        data->append(cache.buffer);
+        return;
+    }
+
+    cache.buffer.clear();
+    BuildMovementUpdate(&cache.buffer, flags);
+
+    cache.gameTime = gameTime;
+    cache.position.Relocate(GetPositionX(), GetPositionY(), GetPositionZ(), GetOrientation());
+    cache.movementFlags = GetUnitMovementFlags();
+    cache.extraMovementFlags = GetExtraUnitMovementFlags();
+    cache.fallTime = m_movementInfo.fallTime;
+    cache.splineId = splineId;
+    cache.victimGuid = victimGuid;
+
+    data->append(cache.buffer);
+}
+
 void Unit::PatchValuesUpdate(ByteBuffer& valuesUpdateBuf, BuildValuesCachePosPointers& posPointers, Player* target)
 {
     Creature const* creature = ToCreature();
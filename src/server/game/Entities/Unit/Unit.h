@@ -25,6 +25,7 @@
 #include "HostileRefMgr.h"
 #include "ItemTemplate.h"
 #include "MotionMaster.h"
+#include "NodePoolAllocator.h"
 #include "Object.h"
 #include "Optional.h"
 #include "SpellAuraDefines.h"
@@ -1377,24 +1378,41 @@ struct BuildValuesCachedBuffer
     BuildValuesCachePosPointers posPointers;
 };
 
+// Movement block of a create update, reused while the unit state it was built from is unchanged.
+struct MovementUpdateCachedBuffer
+{
+    MovementUpdateCachedBuffer() : buffer(100), gameTime(0), movementFlags(0), extraMovementFlags(0), fallTime(0), splineId(0) {}
+
+    ByteBuffer buffer;
+
+    uint32 gameTime;
+    Position position;
+    uint32 movementFlags;
+    uint16 extraMovementFlags;
+    uint32 fallTime;
+    uint32 splineId;
+    ObjectGuid victimGuid;
+};
+
 class Unit : public WorldObject
 {
 public:
     typedef std::unordered_set<Unit*> AttackerSet;
     typedef std::set<Unit*> ControlSet;
 
-    typedef std::multimap<uint32,  Aura*> AuraMap;
+    // aura containers churn with every apply and remove, their nodes come from pooled free lists
+    typedef std::multimap<uint32,  Aura*, std::less<uint32>, Acore::NodePoolAllocator<std::pair<uint32 const, Aura*>>> AuraMap;
     typedef std::pair<AuraMap::const_iterator, AuraMap::const_iterator> AuraMapBounds;
     typedef std::pair<AuraMap::iterator, AuraMap::iterator> AuraMapBoundsNonConst;
 
-    typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
+    typedef std::multimap<uint32,  AuraApplication*, std::less<uint32>, Acore::NodePoolAllocator<std::pair<uint32 const, AuraApplication*>>> AuraApplicationMap;
     typedef std::pair<AuraApplicationMap::const_iterator, AuraApplicationMap::const_iterator> AuraApplicationMapBounds;
     typedef std::pair<AuraApplicationMap::iterator, AuraApplicationMap::iterator> AuraApplicationMapBoundsNonConst;
 
-    typedef std::multimap<AuraStateType,  AuraApplication*> AuraStateAurasMap;
+    typedef std::multimap<AuraStateType,  AuraApplication*, std::less<AuraStateType>, Acore::NodePoolAllocator<std::pair<AuraStateType const, AuraApplication*>>> AuraStateAurasMap;
     typedef std::pair<AuraStateAurasMap::const_iterator, AuraStateAurasMap::const_iterator> AuraStateAurasMapBounds;
 
-    typedef std::list<AuraEffect*> AuraEffectList;
+    typedef std::list<AuraEffect*, Acore::NodePoolAllocator<AuraEffect*>> AuraEffectList;
     typedef std::list<Aura*> AuraList;
     typedef std::list<AuraApplication*> AuraApplicationList;
     typedef std::list<DiminishingReturn> Diminishing;
@@ -1850,6 +1868,8 @@ public:
     void SendSpellNonMeleeReflectLog(SpellNonMeleeDamage* log, Unit* attacker);
     void SendSpellNonMeleeDamageLog(Unit* target, SpellInfo const* spellInfo, uint32 Damage, SpellSchoolMask damageSchoolMask, uint32 AbsorbedDamage, uint32 Resist, bool PhysicalDamage, uint32 Blocked, bool CriticalHit = false, bool Split = false);
     void SendPeriodicAuraLog(SpellPeriodicAuraLogInfo* pInfo);
+    // sends a damage, heal or energize log, queued on the map when CombatLog.Aggregate is enabled
+    void SendCombatLogMessage(WorldPacket const* data);
     void SendSpellMiss(Unit* target, uint32 spellID, SpellMissInfo missInfo);
     void SendSpellDamageResist(Unit* target, uint32 spellId);
     void SendSpellDamageImmune(Unit* target, uint32 spellId);
@@ -2004,6 +2024,7 @@ public:
     void _RemoveNoStackAurasDueToAura(Aura* aura);
     bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
     void _RegisterAuraEffect(AuraEffect* aurEff, bool apply);
+    void _InvalidateAuraModifierCache(AuraType auratype);
 
     // m_ownedAuras container management
     AuraMap&       GetOwnedAuras()       { return m_ownedAuras; }
@@ -2468,6 +2489,7 @@ public:
     void _EnterVehicle(Vehicle* vehicle, int8 seatId, AuraApplication const* aurApp = nullptr);
 
     void BuildMovementPacket(ByteBuffer* data) const;
+    void BuildCachedMovementUpdate(ByteBuffer* data, uint16 flags);
 
     [[nodiscard]] virtual bool CanSwim() const;
     [[nodiscard]] bool IsLevitating() const { return m_movementInfo.HasMovementFlag(MOVEMENTFLAG_DISABLE_GRAVITY); }
@@ -2505,8 +2527,10 @@ public:
     uint32 m_last_notify_mstime;
     uint16 m_delayed_unit_relocation_timer;
     uint16 m_delayed_unit_ai_notify_timer;
+    bool m_delayedVisibilityQueued; // in Map::i_objectsForDelayedVisibility
     bool bRequestForcedVisibilityUpdate;
-    void ExecuteDelayedUnitRelocationEvent();
+    // moved creatures are appended to relocatedCreatures instead of notifying nearby players, if given
+    void ExecuteDelayedUnitRelocationEvent(std::vector<Creature*>* relocatedCreatures = nullptr);
     void ExecuteDelayedUnitAINotifyEvent();
 
     // cooldowns
@@ -2602,11 +2626,37 @@ protected:
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+
+    // sums, multipliers and extremes of m_modAuras, per (aura type, misc mask), dropped whenever one of the effects changes
+    struct AuraModifierAggregate
+    {
+        int32 Total;
+        float Multiplier;
+        int32 MaxPositive;
+        int32 MaxNegative;
+    };
+    AuraModifierAggregate GetAuraModifierAggregate(AuraType auratype, Optional<uint32> miscMask) const;
+    mutable std::unordered_map<uint64, AuraModifierAggregate> m_auraModifierCache;
+
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;             // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
     uint32 m_interruptMask;
 
+    // applied auras that can proc in ProcDamageAndSpellFor, kept in m_appliedAuras order
+    struct ProcAuraEntry
+    {
+        uint32 SpellId;
+        uint32 ProcFlags;
+        AuraApplication* AurApp;
+    };
+    std::vector<ProcAuraEntry> m_procAuras;
+    uint32 m_procAurasFlags;                   // union of all ProcFlags in m_procAuras
+    uint32 m_procAurasGeneration;              // SpellMgr proc data generation m_procAuras was built with
+    void _AddProcAura(AuraApplication* aurApp);
+    void _RemoveProcAura(AuraApplication* aurApp);
+    void _UpdateProcAuraIndex();
+
     float m_auraModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_END];
     float m_weaponDamage[MAX_ATTACK][MAX_WEAPON_DAMAGE_RANGE][MAX_ITEM_PROTO_DAMAGES];
     bool m_canModifyStats;
@@ -2657,6 +2707,8 @@ private:
     void PatchValuesUpdate(ByteBuffer& valuesUpdateBuf, BuildValuesCachePosPointers& posPointers, Player* target);
     void InvalidateValuesUpdateCache() { _valuesUpdateCache.clear(); }
 
+    void InvalidateMovementUpdateCache() { _movementUpdateCache.clear(); }
+
 protected:
     void SetFeared(bool apply, Unit* fearedBy = nullptr, bool isFear = false);
     void SetConfused(bool apply);
@@ -2697,6 +2749,9 @@ private:
 
     typedef std::unordered_map<uint64 /*visibleFlag(uint32) + updateType(uint8)*/, BuildValuesCachedBuffer>  ValuesUpdateCache;
     ValuesUpdateCache _valuesUpdateCache;
+
+    typedef std::unordered_map<uint16 /*update flags*/, MovementUpdateCachedBuffer> MovementUpdateCache;
+    MovementUpdateCache _movementUpdateCache;
 };
 
 namespace Acore
@@ -28,7 +28,6 @@
 #include "Player.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
-#include "Transport.h"
 #include "UnitAI.h"
 #include "World.h"
 #include "WorldStatePackets.h"
@@ -1264,37 +1263,27 @@ void GameEventMgr::ApplyNewEvent(uint16 event_id)
 
 void GameEventMgr::UpdateEventNPCFlags(uint16 event_id)
 {
-    std::unordered_map<uint32, std::unordered_set<ObjectGuid::LowType>> creaturesByMap;
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> creaturesByMap;
 
     // go through the creatures whose npcflags are changed in the event
     for (NPCFlagList::iterator itr = mGameEventNPCFlags[event_id].begin(); itr != mGameEventNPCFlags[event_id].end(); ++itr)
     {
         // get the creature data from the low guid to get the entry, to be able to find out the whole guid
         if (CreatureData const* data = sObjectMgr->GetCreatureData(itr->first))
-            creaturesByMap[data->mapid].insert(itr->first);
+            creaturesByMap[data->mapid].push_back(itr->first);
     }
 
     for (auto const& p : creaturesByMap)
+        QueueMapActions(p.first, GameEventMapAction::UpdateNpcFlags, p.second);
+}
+
+void GameEventMgr::QueueMapActions(uint32 mapId, GameEventMapAction action, std::vector<ObjectGuid::LowType> const& spawnIds)
+{
+    sMapMgr->DoForAllMapsWithMapId(mapId, [action, &spawnIds](Map* map)
     {
-        sMapMgr->DoForAllMapsWithMapId(p.first, [this, &p](Map* map)
-        {
-            for (auto& spawnId : p.second)
-            {
-                auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(spawnId);
-                for (auto itr = creatureBounds.first; itr != creatureBounds.second; ++itr)
-                {
-                    Creature* creature = itr->second;
-                    uint32 npcflag = GetNPCFlag(creature);
-                    if (CreatureTemplate const* creatureTemplate = creature->GetCreatureTemplate())
-                        npcflag |= creatureTemplate->npcflag;
-
-                    creature->ReplaceAllNpcFlags(NPCFlags(npcflag));
-                    // reset gossip options, since the flag change might have added / removed some
-                    //cr->ResetGossipOptions();
-                }
-            }
-        });
-    }
+        for (ObjectGuid::LowType spawnId : spawnIds)
+            map->QueueGameEventAction(action, spawnId);
+    });
 }
 
 void GameEventMgr::UpdateBattlegroundSettings()
@@ -1334,15 +1323,11 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
         {
             sObjectMgr->AddCreatureToGrid(*itr, data);
 
-            // Spawn if necessary (loaded grids only)
+            // Spawn if necessary (loaded grids only), the map spawns it in its own update
             Map* map = sMapMgr->CreateBaseMap(data->mapid);
             // We use spawn coords to spawn
             if (!map->Instanceable() && map->IsGridLoaded(data->posX, data->posY))
-            {
-                Creature* creature = new Creature;
-                if (!creature->LoadCreatureFromDB(*itr, map))
-                    delete creature;
-            }
+                map->QueueGameEventAction(GameEventMapAction::SpawnCreature, *itr);
         }
     }
 
@@ -1364,17 +1349,7 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
             Map* map = sMapMgr->CreateBaseMap(data->mapid);
             // We use current coords to unspawn, not spawn coords since creature can have changed grid
             if (!map->Instanceable() && map->IsGridLoaded(data->posX, data->posY))
-            {
-                GameObject* pGameobject = sObjectMgr->IsGameObjectStaticTransport(data->id) ? new StaticTransport() : new GameObject();
-                //TODO: find out when it is add to map
-                if (!pGameobject->LoadGameObjectFromDB(*itr, map, false))
-                    delete pGameobject;
-                else
-                {
-                    if (pGameobject->isSpawnedByDefault())
-                        map->AddToMap(pGameobject);
-                }
-            }
+                map->QueueGameEventAction(GameEventMapAction::SpawnGameObject, *itr);
         }
     }
 
@@ -1400,6 +1375,9 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         return;
     }
 
+    // despawned by the maps in their own updates, every map with the id is visited once for all its spawns
+    std::unordered_map<uint32, std::vector<ObjectGuid::LowType>> spawnsByMap;
+
     for (GuidLowList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // check if it's needed by another event, if so, don't remove
@@ -1410,20 +1388,15 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
         {
             sObjectMgr->RemoveCreatureFromGrid(*itr, data);
-
-            sMapMgr->DoForAllMapsWithMapId(data->mapid, [&itr](Map* map)
-            {
-                auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = creatureBounds.first; itr2 != creatureBounds.second;)
-                {
-                    Creature* creature = itr2->second;
-                    ++itr2;
-                    creature->AddObjectToRemoveList();
-                }
-            });
+            spawnsByMap[data->mapid].push_back(*itr);
         }
     }
 
+    for (auto const& p : spawnsByMap)
+        QueueMapActions(p.first, GameEventMapAction::DespawnCreature, p.second);
+
+    spawnsByMap.clear();
+
     if (internal_event_id >= int32(mGameEventGameobjectGuids.size()))
     {
         LOG_ERROR("gameevent", "GameEventMgr::GameEventUnspawn attempt access to out of range mGameEventGameobjectGuids element {} (size: {})",
@@ -1440,19 +1413,13 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         if (GameObjectData const* data = sObjectMgr->GetGameObjectData(*itr))
         {
             sObjectMgr->RemoveGameobjectFromGrid(*itr, data);
-
-            sMapMgr->DoForAllMapsWithMapId(data->mapid, [&itr](Map* map)
-            {
-                auto gameobjectBounds = map->GetGameObjectBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = gameobjectBounds.first; itr2 != gameobjectBounds.second;)
-                {
-                    GameObject* go = itr2->second;
-                    ++itr2;
-                    go->AddObjectToRemoveList();
-                }
-            });
+            spawnsByMap[data->mapid].push_back(*itr);
         }
     }
+
+    for (auto const& p : spawnsByMap)
+        QueueMapActions(p.first, GameEventMapAction::DespawnGameObject, p.second);
+
     if (internal_event_id >= int32(mGameEventPoolIds.size()))
     {
         LOG_ERROR("gameevent", "GameEventMgr::GameEventUnspawn attempt access to out of range mGameEventPoolIds element {} (size: {})", internal_event_id, mGameEventPoolIds.size());
@@ -1580,6 +1547,8 @@ bool GameEventMgr::hasGameObjectActiveEventExcept(ObjectGuid::LowType go_guid, u
 
 void GameEventMgr::UpdateEventQuests(uint16 event_id, bool activate)
 {
+    sObjectMgr->InvalidateQuestGiverStatus();
+
     QuestRelList::iterator itr;
     for (itr = mGameEventCreatureQuests[event_id].begin(); itr != mGameEventCreatureQuests[event_id].end(); ++itr)
     {
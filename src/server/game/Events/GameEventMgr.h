@@ -93,6 +93,7 @@ struct NPCVendorEntry
 class Player;
 class Creature;
 class Quest;
+enum class GameEventMapAction : uint8;
 
 class GameEventMgr
 {
@@ -134,6 +135,7 @@ private:
     void UpdateEventQuests(uint16 event_id, bool activate);
     void UpdateWorldStates(uint16 event_id, bool Activate);
     void UpdateEventNPCFlags(uint16 event_id);
+    void QueueMapActions(uint32 mapId, GameEventMapAction action, std::vector<ObjectGuid::LowType> const& spawnIds);
     void UpdateEventNPCVendor(uint16 event_id, bool activate);
     void UpdateBattlegroundSettings();
     void RunSmartAIScripts(uint16 event_id, bool activate);    //! Runs SMART_EVENT_GAME_EVENT_START/_END SAI
@@ -0,0 +1,204 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_CONCURRENTGUIDINDEX_H
+#define ACORE_CONCURRENTGUIDINDEX_H
+
+#include "ObjectGuid.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/**
+ * Open addressing ObjectGuid -> T* index with wait-free lookups.
+ *
+ * Writers must be serialized externally (HashMapHolder holds its unique lock), readers
+ * take no lock at all and never write shared memory. Removed entries keep their key
+ * with a null value, so a guid always maps to the same slot until the table is rebuilt.
+ * Rebuilt tables are retired and released after a grace period that readers can not
+ * possibly still be in, as lookups only touch the table for the duration of a probe.
+ */
+template<class T>
+class ConcurrentGuidIndex
+{
+    struct Slot
+    {
+        std::atomic<uint64> Key{ 0 };
+        std::atomic<T*> Value{ nullptr };
+    };
+
+    struct Table
+    {
+        explicit Table(std::size_t capacity) : Mask(capacity - 1), Slots(new Slot[capacity]) { }
+
+        std::size_t const Mask;
+        std::unique_ptr<Slot[]> Slots;
+        std::size_t UsedSlots = 0;      // writer only, slots with a key (live or removed)
+        std::size_t LiveEntries = 0;    // writer only
+    };
+
+    struct RetiredTable
+    {
+        std::unique_ptr<Table> Data;
+        std::chrono::steady_clock::time_point RetireTime;
+    };
+
+    static constexpr std::size_t MIN_CAPACITY = 256;
+    static constexpr std::chrono::seconds RETIRE_GRACE_PERIOD = std::chrono::seconds(30);
+
+public:
+    ConcurrentGuidIndex() : _table(new Table(MIN_CAPACITY)) { }
+
+    ~ConcurrentGuidIndex()
+    {
+        delete _table.load(std::memory_order_relaxed);
+    }
+
+    ConcurrentGuidIndex(ConcurrentGuidIndex const&) = delete;
+    ConcurrentGuidIndex& operator=(ConcurrentGuidIndex const&) = delete;
+
+    T* Find(ObjectGuid guid) const
+    {
+        uint64 key = guid.GetRawValue();
+        if (!key)
+            return nullptr;
+
+        Table const* table = _table.load(std::memory_order_acquire);
+        for (std::size_t i = Hash(key) & table->Mask;; i = (i + 1) & table->Mask)
+        {
+            Slot const& slot = table->Slots[i];
+            uint64 slotKey = slot.Key.load(std::memory_order_acquire);
+            if (slotKey == key)
+                return slot.Value.load(std::memory_order_acquire);
+
+            if (!slotKey)
+                return nullptr;
+        }
+    }
+
+    // writer side, externally serialized
+    void Insert(ObjectGuid guid, T* object)
+    {
+        uint64 key = guid.GetRawValue();
+        if (!key)
+            return;
+
+        Table* table = _table.load(std::memory_order_relaxed);
+        if (Slot* slot = FindSlot(table, key))
+        {
+            if (!slot->Value.load(std::memory_order_relaxed))
+                ++table->LiveEntries;
+
+            slot->Value.store(object, std::memory_order_release);
+            return;
+        }
+
+        // keep load factor (including removed keys) below 1/2 so probes stay short and always terminate
+        if ((table->UsedSlots + 1) * 2 > table->Mask + 1)
+            table = Rebuild(table);
+
+        InsertNew(table, key, object);
+    }
+
+    void Remove(ObjectGuid guid)
+    {
+        Table* table = _table.load(std::memory_order_relaxed);
+        if (Slot* slot = FindSlot(table, guid.GetRawValue()))
+        {
+            if (slot->Value.exchange(nullptr, std::memory_order_release))
+                --table->LiveEntries;
+        }
+    }
+
+private:
+    static std::size_t Hash(uint64 key)
+    {
+        // murmur3 finalizer, guids of one type only differ in the low bits
+        key ^= key >> 33;
+        key *= UI64LIT(0xff51afd7ed558ccd);
+        key ^= key >> 33;
+        key *= UI64LIT(0xc4ceb9fe1a85ec53);
+        key ^= key >> 33;
+        return std::size_t(key);
+    }
+
+    static Slot* FindSlot(Table* table, uint64 key)
+    {
+        if (!key)
+            return nullptr;
+
+        for (std::size_t i = Hash(key) & table->Mask;; i = (i + 1) & table->Mask)
+        {
+            Slot& slot = table->Slots[i];
+            uint64 slotKey = slot.Key.load(std::memory_order_relaxed);
+            if (slotKey == key)
+                return &slot;
+
+            if (!slotKey)
+                return nullptr;
+        }
+    }
+
+    static void InsertNew(Table* table, uint64 key, T* object)
+    {
+        for (std::size_t i = Hash(key) & table->Mask;; i = (i + 1) & table->Mask)
+        {
+            Slot& slot = table->Slots[i];
+            if (slot.Key.load(std::memory_order_relaxed))
+                continue;
+
+            // value first, a reader seeing the key must see the object
+            slot.Value.store(object, std::memory_order_relaxed);
+            slot.Key.store(key, std::memory_order_release);
+            ++table->UsedSlots;
+            ++table->LiveEntries;
+            return;
+        }
+    }
+
+    Table* Rebuild(Table* table)
+    {
+        std::size_t capacity = MIN_CAPACITY;
+        while (capacity < (table->LiveEntries + 1) * 4)
+            capacity *= 2;
+
+        Table* rebuilt = new Table(capacity);
+        for (std::size_t i = 0; i <= table->Mask; ++i)
+        {
+            Slot const& slot = table->Slots[i];
+            if (T* object = slot.Value.load(std::memory_order_relaxed))
+                InsertNew(rebuilt, slot.Key.load(std::memory_order_relaxed), object);
+        }
+
+        _table.store(rebuilt, std::memory_order_release);
+
+        auto now = std::chrono::steady_clock::now();
+        std::erase_if(_retiredTables, [now](RetiredTable const& retired)
+        {
+            return now - retired.RetireTime > RETIRE_GRACE_PERIOD;
+        });
+
+        _retiredTables.push_back({ std::unique_ptr<Table>(table), now });
+        return rebuilt;
+    }
+
+    std::atomic<Table*> _table;
+    std::vector<RetiredTable> _retiredTables;
+};
+
+#endif
@@ -16,6 +16,7 @@
  */
 
 #include "ObjectAccessor.h"
+#include "ConcurrentGuidIndex.h"
 #include "Corpse.h"
 #include "Creature.h"
 #include "DynamicObject.h"
@@ -42,6 +43,7 @@ void HashMapHolder<T>::Insert(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer()[o->GetGUID()] = o;
+    GetIndex().Insert(o->GetGUID(), o);
 }
 
 template<class T>
@@ -50,15 +52,14 @@ void HashMapHolder<T>::Remove(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer().erase(o->GetGUID());
+    GetIndex().Remove(o->GetGUID());
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : nullptr;
+    // lock free, see ConcurrentGuidIndex
+    return GetIndex().Find(guid);
 }
 
 template<class T>
@@ -68,6 +69,13 @@ auto HashMapHolder<T>::GetContainer() -> MapType&
     return _objectMap;
 }
 
+template<class T>
+ConcurrentGuidIndex<T>& HashMapHolder<T>::GetIndex()
+{
+    static ConcurrentGuidIndex<T> _objectIndex;
+    return _objectIndex;
+}
+
 template<class T>
 std::shared_mutex* HashMapHolder<T>::GetLock()
 {
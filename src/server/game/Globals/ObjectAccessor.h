@@ -40,6 +40,9 @@ class Transport;
 class StaticTransport;
 class MotionTransport;
 
+template <class T>
+class ConcurrentGuidIndex;
+
 template <class T>
 class HashMapHolder
 {
@@ -59,6 +62,9 @@ public:
     static MapType& GetContainer();
 
     static std::shared_mutex* GetLock();
+
+private:
+    static ConcurrentGuidIndex<T>& GetIndex();
 };
 
 namespace ObjectAccessor
@@ -52,12 +52,19 @@
 #include "Util.h"
 #include "Vehicle.h"
 #include "World.h"
+#include "WorldSnapshot.h"
 #include <boost/algorithm/string.hpp>
 
 ScriptMapMap sSpellScripts;
 ScriptMapMap sEventScripts;
 ScriptMapMap sWaypointScripts;
 
+template<class T>
+static void LogDenseIdIndex(std::string_view name, Acore::DenseIdIndex<T> const& index)
+{
+    LOG_INFO("server.loading", ">> {} index: {} entries in {} slots, {} KB", name, index.GetEntryCount(), index.GetSlotCount(), index.GetMemoryUsage() / 1024);
+}
+
 std::string GetScriptsTableNameByType(ScriptsType type)
 {
     std::string res = "";
@@ -357,6 +364,7 @@ ObjectMgr::ObjectMgr():
     _hiPetNumber(1),
     _creatureSpawnId(1),
     _gameObjectSpawnId(1),
+    _questGiverStatusEpoch(0),
     DBCLocaleIndex(LOCALE_enUS)
 {
     for (uint8 i = 0; i < MAX_CLASSES; ++i)
@@ -444,6 +452,24 @@ void ObjectMgr::AddLocaleString(std::string&& s, LocaleConstant locale, std::vec
     }
 }
 
+void ObjectMgr::AddLocaleString(std::string_view s, LocaleConstant locale, LocaleStrings& data)
+{
+    if (!s.empty())
+    {
+        if (data.size() <= size_t(locale))
+            data.resize(locale + 1);
+
+        data[locale] = GetLocaleStringPool().Intern(s);
+    }
+}
+
+Acore::StringPool& ObjectMgr::GetLocaleStringPool()
+{
+    // never shrinks, the views stay valid through table reloads
+    static Acore::StringPool pool;
+    return pool;
+}
+
 void ObjectMgr::LoadCreatureLocales()
 {
     uint32 oldMSTime = getMSTime();
@@ -466,8 +492,8 @@ void ObjectMgr::LoadCreatureLocales()
             continue;
 
         CreatureLocale& data = _creatureLocaleStore[ID];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.Name);
-        AddLocaleString(fields[3].Get<std::string>(), locale, data.Title);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Name);
+        AddLocaleString(fields[3].Get<std::string_view>(), locale, data.Title);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Creature Locale Strings in {} ms", (unsigned long)_creatureLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -497,8 +523,8 @@ void ObjectMgr::LoadGossipMenuItemsLocales()
             continue;
 
         GossipMenuItemsLocale& data = _gossipMenuItemsLocaleStore[MAKE_PAIR32(MenuID, OptionID)];
-        AddLocaleString(fields[3].Get<std::string>(), locale, data.OptionText);
-        AddLocaleString(fields[4].Get<std::string>(), locale, data.BoxText);
+        AddLocaleString(fields[3].Get<std::string_view>(), locale, data.OptionText);
+        AddLocaleString(fields[4].Get<std::string_view>(), locale, data.BoxText);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Gossip Menu Option Locale Strings in {} ms", (uint32)_gossipMenuItemsLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -567,7 +593,7 @@ void ObjectMgr::LoadPointOfInterestLocales()
             continue;
 
         PointOfInterestLocale& data = _pointOfInterestLocaleStore[ID];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.Name);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Name);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Points Of Interest Locale Strings in {} ms", (uint32)_pointOfInterestLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -600,7 +626,7 @@ void ObjectMgr::LoadCreatureTemplates()
     }
 
     _creatureTemplateStore.rehash(result->GetRowCount());
-    _creatureTemplateStoreFast.clear();
+    _creatureTemplateIndex.Clear();
 
     uint32 count = 0;
     do
@@ -613,7 +639,7 @@ void ObjectMgr::LoadCreatureTemplates()
     // We load the creature models after loading but before checking
     LoadCreatureTemplateModels();
 
-    sScriptMgr->OnAfterDatabaseLoadCreatureTemplates(_creatureTemplateStoreFast);
+    sScriptMgr->OnAfterDatabaseLoadCreatureTemplates(_creatureTemplateIndex.GetEntries());
 
     LoadCreatureTemplateResistances();
     LoadCreatureTemplateSpells();
@@ -625,6 +651,7 @@ void ObjectMgr::LoadCreatureTemplates()
         itr->second.InitializeQueryData();
     }
 
+    LogDenseIdIndex("Creature template", _creatureTemplateIndex);
     LOG_INFO("server.loading", ">> Loaded {} Creature Definitions in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
@@ -641,14 +668,8 @@ void ObjectMgr::LoadCreatureTemplate(Field* fields, bool triggerHook)
 
     CreatureTemplate& creatureTemplate = _creatureTemplateStore[entry];
 
-    // enlarge the fast cache as necessary
-    if (_creatureTemplateStoreFast.size() < entry + 1)
-    {
-        _creatureTemplateStoreFast.resize(entry + 1, nullptr);
-    }
-
-    // load a pointer to this creatureTemplate into the fast cache
-    _creatureTemplateStoreFast[entry] = &creatureTemplate;
+    // load a pointer to this creatureTemplate into the fast index
+    _creatureTemplateIndex.Set(entry, &creatureTemplate);
 
     // build the creatureTemplate
     creatureTemplate.Entry = entry;
@@ -756,7 +777,7 @@ void ObjectMgr::LoadCreatureTemplate(Field* fields, bool triggerHook)
     // useful if the creature template load is being triggered from outside this class
     if (triggerHook)
     {
-        sScriptMgr->OnAfterDatabaseLoadCreatureTemplates(_creatureTemplateStoreFast);
+        sScriptMgr->OnAfterDatabaseLoadCreatureTemplates(_creatureTemplateIndex.GetEntries());
     }
 
 }
@@ -2162,8 +2183,15 @@ void ObjectMgr::LoadCreatures()
 {
     uint32 oldMSTime = getMSTime();
 
+    if (LoadCreaturesFromSnapshot())
+    {
+        LOG_INFO("server.loading", ">> Loaded {} Creatures from the world snapshot in {} ms", _creatureDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+        LOG_INFO("server.loading", " ");
+        return;
+    }
+
     //                                                     0         1    2    3    4        5            6           7           8            9              10            11
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id1, id2, id3, map, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, wander_distance, "
+    StreamedQueryResult result = WorldDatabase.StreamQuery("SELECT creature.guid, id1, id2, id3, map, equipment_id, position_x, position_y, position_z, orientation, spawntimesecs, wander_distance, "
                          //      12            13       14          15           16         17         18          19             20                 21                    22
                          "currentwaypoint, curhealth, curmana, MovementType, spawnMask, phaseMask, eventEntry, pool_entry, creature.npcflag, creature.unit_flags, creature.dynamicflags, "
                          //       23
@@ -2187,7 +2215,12 @@ void ObjectMgr::LoadCreatures()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    _creatureDataStore.rehash(result->GetRowCount());
+    // zone and area updates have to run against the database on every start
+    bool const writeSnapshot = sWorldSnapshot->IsEnabled() && !sWorld->getBoolConfig(CONFIG_CALCULATE_CREATURE_ZONE_AREA_DATA);
+    ByteBuffer snapshot;
+    if (writeSnapshot)
+        snapshot << uint32(0);
+
     uint32 count = 0;
     do
     {
@@ -2346,13 +2379,75 @@ void ObjectMgr::LoadCreatures()
         if (gameEvent == 0 && PoolId == 0)
             AddCreatureToGrid(spawnId, &data);
 
+        if (writeSnapshot)
+        {
+            snapshot << uint32(spawnId) << data.id1 << data.id2 << data.id3 << data.mapid << data.phaseMask << data.equipmentId;
+            snapshot << data.posX << data.posY << data.posZ << data.orientation << data.spawntimesecs << data.wander_distance;
+            snapshot << data.currentwaypoint << data.curhealth << data.curmana << data.movementType << data.spawnMask;
+            snapshot << data.npcflag << data.unit_flags << data.dynamicflags << GetScriptName(data.ScriptId);
+            snapshot << uint8(gameEvent == 0 && PoolId == 0);
+        }
+
         ++count;
     } while (result->NextRow());
 
+    if (writeSnapshot)
+    {
+        snapshot.put<uint32>(0, count);
+        sWorldSnapshot->Save("creature", snapshot);
+    }
+
+    _creatureDataIndex.Build(_creatureDataStore);
+    LogDenseIdIndex("Creature spawn", _creatureDataIndex);
+
     LOG_INFO("server.loading", ">> Loaded {} Creatures in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
 
+bool ObjectMgr::LoadCreaturesFromSnapshot()
+{
+    if (sWorld->getBoolConfig(CONFIG_CALCULATE_CREATURE_ZONE_AREA_DATA))
+        return false;
+
+    ByteBuffer snapshot;
+    if (!sWorldSnapshot->Load("creature", snapshot))
+        return false;
+
+    // decode everything first, a broken file must not leave half of the spawns in the grids
+    CreatureDataContainer creatures;
+    std::vector<ObjectGuid::LowType> gridSpawns;
+    try
+    {
+        uint32 count = snapshot.read<uint32>();
+        creatures.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            ObjectGuid::LowType spawnId = snapshot.read<uint32>();
+            CreatureData& data = creatures[spawnId];
+            snapshot >> data.id1 >> data.id2 >> data.id3 >> data.mapid >> data.phaseMask >> data.equipmentId;
+            snapshot >> data.posX >> data.posY >> data.posZ >> data.orientation >> data.spawntimesecs >> data.wander_distance;
+            snapshot >> data.currentwaypoint >> data.curhealth >> data.curmana >> data.movementType >> data.spawnMask;
+            snapshot >> data.npcflag >> data.unit_flags >> data.dynamicflags;
+            data.ScriptId = GetScriptId(snapshot.ReadCString());
+            if (snapshot.read<uint8>())
+                gridSpawns.push_back(spawnId);
+        }
+    }
+    catch (ByteBufferException const&)
+    {
+        LOG_ERROR("server.loading", "World snapshot of creature is corrupted, loading it from the database.");
+        return false;
+    }
+
+    _creatureDataStore = std::move(creatures);
+    _creatureDataIndex.Build(_creatureDataStore);
+    LogDenseIdIndex("Creature spawn", _creatureDataIndex);
+    for (ObjectGuid::LowType spawnId : gridSpawns)
+        AddCreatureToGrid(spawnId, &_creatureDataStore[spawnId]);
+
+    return true;
+}
+
 void ObjectMgr::AddCreatureToGrid(ObjectGuid::LowType guid, CreatureData const* data)
 {
     uint8 mask = data->spawnMask;
@@ -2491,8 +2586,15 @@ void ObjectMgr::LoadGameobjects()
 {
     uint32 oldMSTime = getMSTime();
 
+    if (LoadGameobjectsFromSnapshot())
+    {
+        LOG_INFO("server.loading", ">> Loaded {} Gameobjects from the world snapshot in {} ms", _gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
+        LOG_INFO("server.loading", " ");
+        return;
+    }
+
     //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
+    StreamedQueryResult result = WorldDatabase.StreamQuery("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
                          //   7          8          9          10         11             12            13     14         15         16          17
                          "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnMask, phaseMask, eventEntry, pool_entry, "
                          //   18
@@ -2515,7 +2617,12 @@ void ObjectMgr::LoadGameobjects()
                 if (GetMapDifficultyData(i, Difficulty(k)))
                     spawnMasks[i] |= (1 << k);
 
-    _gameObjectDataStore.rehash(result->GetRowCount());
+    bool const writeSnapshot = sWorldSnapshot->IsEnabled() && !sWorld->getBoolConfig(CONFIG_CALCULATE_GAMEOBJECT_ZONE_AREA_DATA);
+    ByteBuffer snapshot;
+    uint32 count = 0;
+    if (writeSnapshot)
+        snapshot << uint32(0);
+
     do
     {
         Field* fields = result->Fetch();
@@ -2650,12 +2757,72 @@ void ObjectMgr::LoadGameobjects()
 
         if (gameEvent == 0 && PoolId == 0)                      // if not this is to be managed by GameEvent System or Pool system
             AddGameobjectToGrid(guid, &data);
+
+        if (writeSnapshot)
+        {
+            snapshot << uint32(guid) << data.id << data.mapid << data.phaseMask;
+            snapshot << data.posX << data.posY << data.posZ << data.orientation;
+            snapshot << data.rotation.x << data.rotation.y << data.rotation.z << data.rotation.w;
+            snapshot << data.spawntimesecs << GetScriptName(data.ScriptId) << data.animprogress << uint8(data.go_state);
+            snapshot << data.spawnMask << data.artKit << uint8(gameEvent == 0 && PoolId == 0);
+            ++count;
+        }
     } while (result->NextRow());
 
+    if (writeSnapshot)
+    {
+        snapshot.put<uint32>(0, count);
+        sWorldSnapshot->Save("gameobject", snapshot);
+    }
+
     LOG_INFO("server.loading", ">> Loaded {} Gameobjects in {} ms", (unsigned long)_gameObjectDataStore.size(), GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
 
+bool ObjectMgr::LoadGameobjectsFromSnapshot()
+{
+    if (sWorld->getBoolConfig(CONFIG_CALCULATE_GAMEOBJECT_ZONE_AREA_DATA))
+        return false;
+
+    ByteBuffer snapshot;
+    if (!sWorldSnapshot->Load("gameobject", snapshot))
+        return false;
+
+    GameObjectDataContainer gameObjects;
+    std::vector<ObjectGuid::LowType> gridSpawns;
+    try
+    {
+        uint32 count = snapshot.read<uint32>();
+        gameObjects.reserve(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            ObjectGuid::LowType guid = snapshot.read<uint32>();
+            GameObjectData& data = gameObjects[guid];
+            snapshot >> data.id >> data.mapid >> data.phaseMask;
+            snapshot >> data.posX >> data.posY >> data.posZ >> data.orientation;
+            snapshot >> data.rotation.x >> data.rotation.y >> data.rotation.z >> data.rotation.w;
+            snapshot >> data.spawntimesecs;
+            data.ScriptId = GetScriptId(snapshot.ReadCString());
+            snapshot >> data.animprogress;
+            data.go_state = GOState(snapshot.read<uint8>());
+            snapshot >> data.spawnMask >> data.artKit;
+            if (snapshot.read<uint8>())
+                gridSpawns.push_back(guid);
+        }
+    }
+    catch (ByteBufferException const&)
+    {
+        LOG_ERROR("server.loading", "World snapshot of gameobject is corrupted, loading it from the database.");
+        return false;
+    }
+
+    _gameObjectDataStore = std::move(gameObjects);
+    for (ObjectGuid::LowType guid : gridSpawns)
+        AddGameobjectToGrid(guid, &_gameObjectDataStore[guid]);
+
+    return true;
+}
+
 void ObjectMgr::AddGameobjectToGrid(ObjectGuid::LowType guid, GameObjectData const* data)
 {
     uint8 mask = data->spawnMask;
@@ -2705,8 +2872,8 @@ void ObjectMgr::LoadItemLocales()
             continue;
 
         ItemLocale& data = _itemLocaleStore[ID];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.Name);
-        AddLocaleString(fields[3].Get<std::string>(), locale, data.Description);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Name);
+        AddLocaleString(fields[3].Get<std::string_view>(), locale, data.Description);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Item Locale Strings in {} ms", (uint32)_itemLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -2717,7 +2884,7 @@ void ObjectMgr::LoadItemTemplates()
     uint32 oldMSTime = getMSTime();
 
     //                                                 0      1       2               3              4        5        6       7          8         9        10        11           12
-    QueryResult result = WorldDatabase.Query("SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, FlagsExtra, BuyCount, BuyPrice, SellPrice, InventoryType, "
+    StreamedQueryResult result = WorldDatabase.StreamQuery("SELECT entry, class, subclass, SoundOverrideSubclass, name, displayid, Quality, Flags, FlagsExtra, BuyCount, BuyPrice, SellPrice, InventoryType, "
                          //                                              13              14           15          16             17               18                19              20
                          "AllowableClass, AllowableRace, ItemLevel, RequiredLevel, RequiredSkill, RequiredSkillRank, requiredspell, requiredhonorrank, "
                          //                                              21                      22                       23               24        25          26             27           28
@@ -2756,7 +2923,6 @@ void ObjectMgr::LoadItemTemplates()
         return;
     }
 
-    _itemTemplateStore.reserve(result->GetRowCount());
     uint32 count = 0;
     // original inspiration https://github.com/TrinityCore/TrinityCore/commit/0c44bd33ee7b42c924859139a9f4b04cf2b91261
     bool enforceDBCAttributes = sWorld->getBoolConfig(CONFIG_DBC_ENFORCE_ITEM_ATTRIBUTES);
@@ -3279,20 +3445,8 @@ void ObjectMgr::LoadItemTemplates()
         ++count;
     } while (result->NextRow());
 
-    // pussywizard:
-    {
-        uint32 max = 0;
-        for (ItemTemplateContainer::const_iterator itr = _itemTemplateStore.begin(); itr != _itemTemplateStore.end(); ++itr)
-            if (itr->first > max)
-                max = itr->first;
-        if (max)
-        {
-            _itemTemplateStoreFast.clear();
-            _itemTemplateStoreFast.resize(max + 1, nullptr);
-            for (ItemTemplateContainer::iterator itr = _itemTemplateStore.begin(); itr != _itemTemplateStore.end(); ++itr)
-                _itemTemplateStoreFast[itr->first] = &(itr->second);
-        }
-    }
+    _itemTemplateIndex.Build(_itemTemplateStore);
+    LogDenseIdIndex("Item template", _itemTemplateIndex);
 
     for (ItemTemplateContainer::iterator itr = _itemTemplateStore.begin(); itr != _itemTemplateStore.end(); ++itr)
         itr->second.InitializeQueryData();
@@ -3326,7 +3480,7 @@ void ObjectMgr::LoadItemTemplates()
 
 ItemTemplate const* ObjectMgr::GetItemTemplate(uint32 entry)
 {
-    return entry < _itemTemplateStoreFast.size() ? _itemTemplateStoreFast[entry] : nullptr;
+    return _itemTemplateIndex.Find(entry);
 }
 
 void ObjectMgr::LoadItemSetNameLocales()
@@ -3351,7 +3505,7 @@ void ObjectMgr::LoadItemSetNameLocales()
             continue;
 
         ItemSetNameLocale& data = _itemSetNameLocaleStore[ID];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.Name);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Name);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Item Set Name Locale Strings in {} ms", uint32(_itemSetNameLocaleStore.size()), GetMSTimeDiffToNow(oldMSTime));
@@ -4409,10 +4563,13 @@ void ObjectMgr::LoadQuests()
 {
     uint32 oldMSTime = getMSTime();
 
+    InvalidateQuestGiverStatus();
+
     // For reload case
     for (QuestMap::const_iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
         delete itr->second;
     _questTemplates.clear();
+    _questTemplateIndex.Clear();
 
     mExclusiveQuestGroups.clear();
 
@@ -4462,23 +4619,8 @@ void ObjectMgr::LoadQuests()
         _questTemplates[newQuest->GetQuestId()] = newQuest;
     } while (result->NextRow());
 
-    // pussywizard:
-    {
-        uint32 max = 0;
-        for (QuestMap::const_iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
-            if (itr->first > max)
-                max = itr->first;
-        if (max)
-        {
-            _questTemplatesFast.clear();
-            _questTemplatesFast.resize(max + 1, nullptr);
-            for (QuestMap::iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
-                _questTemplatesFast[itr->first] = itr->second;
-        }
-    }
-
-    for (QuestMap::iterator itr = _questTemplates.begin(); itr != _questTemplates.end(); ++itr)
-        itr->second->InitializeQueryData();
+    _questTemplateIndex.Build(_questTemplates);
+    LogDenseIdIndex("Quest template", _questTemplateIndex);
 
     std::map<uint32, uint32> usedMailTemplates;
 
@@ -5196,14 +5338,14 @@ void ObjectMgr::LoadQuestLocales()
             continue;
 
         QuestLocale& data = _questLocaleStore[ID];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.Title);
-        AddLocaleString(fields[3].Get<std::string>(), locale, data.Details);
-        AddLocaleString(fields[4].Get<std::string>(), locale, data.Objectives);
-        AddLocaleString(fields[5].Get<std::string>(), locale, data.AreaDescription);
-        AddLocaleString(fields[6].Get<std::string>(), locale, data.CompletedText);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Title);
+        AddLocaleString(fields[3].Get<std::string_view>(), locale, data.Details);
+        AddLocaleString(fields[4].Get<std::string_view>(), locale, data.Objectives);
+        AddLocaleString(fields[5].Get<std::string_view>(), locale, data.AreaDescription);
+        AddLocaleString(fields[6].Get<std::string_view>(), locale, data.CompletedText);
 
         for (uint8 i = 0; i < 4; ++i)
-            AddLocaleString(fields[i + 7].Get<std::string>(), locale, data.ObjectiveText[i]);
+            AddLocaleString(fields[i + 7].Get<std::string_view>(), locale, data.ObjectiveText[i]);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Quest Locale Strings in {} ms", (uint32)_questLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -5694,6 +5836,7 @@ void ObjectMgr::ValidateSpellScripts()
     }
 
     uint32 count = 0;
+    _spellScriptHookMaskStore.clear();
 
     for (SpellScriptsContainer::iterator itr = _spellScriptsStore.begin(); itr != _spellScriptsStore.end();)
     {
@@ -5707,6 +5850,7 @@ void ObjectMgr::ValidateSpellScripts()
             SpellScript* spellScript = sitr->first->GetSpellScript();
             AuraScript* auraScript = sitr->first->GetAuraScript();
             bool valid = true;
+            SpellScriptHookMasks hookMasks;
             if (!spellScript && !auraScript)
             {
                 LOG_ERROR("sql.sql", "Functions GetSpellScript() and GetAuraScript() of script `{}` do not return objects - script skipped", GetScriptName(sitr->second->second));
@@ -5718,6 +5862,7 @@ void ObjectMgr::ValidateSpellScripts()
                 spellScript->_Register();
                 if (!spellScript->_Validate(spellInfo))
                     valid = false;
+                hookMasks.SpellHooks = spellScript->_GetRegisteredHookMask();
                 delete spellScript;
             }
             if (auraScript)
@@ -5726,12 +5871,19 @@ void ObjectMgr::ValidateSpellScripts()
                 auraScript->_Register();
                 if (!auraScript->_Validate(spellInfo))
                     valid = false;
+                hookMasks.AuraHooks = auraScript->_GetRegisteredHookMask();
                 delete auraScript;
             }
             if (!valid)
             {
                 _spellScriptsStore.erase(sitr->second);
             }
+            else
+            {
+                SpellScriptHookMasks& spellHookMasks = _spellScriptHookMaskStore[spellInfo->Id];
+                spellHookMasks.SpellHooks |= hookMasks.SpellHooks;
+                spellHookMasks.AuraHooks |= hookMasks.AuraHooks;
+            }
         }
         ++count;
     }
@@ -5802,6 +5954,30 @@ PageText const* ObjectMgr::GetPageText(uint32 pageEntry)
     return nullptr;
 }
 
+void ObjectMgr::InitializeQueriesData(QueryDataGroup mask)
+{
+    uint32 oldMSTime = getMSTime();
+
+    if (mask & QUERY_DATA_GAMEOBJECTS)
+        for (auto& [entry, gameObjectTemplate] : _gameObjectTemplateStore)
+            gameObjectTemplate.InitializeQueryData();
+
+    if (mask & QUERY_DATA_GOSSIP_TEXTS)
+        for (auto& [textId, gossipText] : _gossipTextStore)
+            gossipText.InitializeQueryData(textId);
+
+    if (mask & QUERY_DATA_PAGE_TEXTS)
+        for (auto& [pageId, pageText] : _pageTextStore)
+            pageText.InitializeQueryData(pageId);
+
+    if (mask & QUERY_DATA_QUESTS)
+        for (auto& [questId, quest] : _questTemplates)
+            quest->InitializeQueryData();
+
+    LOG_INFO("server.loading", ">> Initialized Query Data in {} ms", GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
 void ObjectMgr::LoadPageTextLocales()
 {
     uint32 oldMSTime = getMSTime();
@@ -5825,7 +6001,7 @@ void ObjectMgr::LoadPageTextLocales()
             continue;
 
         PageTextLocale& data = _pageTextLocaleStore[ID];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.Text);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Text);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Page Text Locale Strings in {} ms", (uint32)_pageTextLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -6078,8 +6254,8 @@ void ObjectMgr::LoadNpcTextLocales()
         NpcTextLocale& data = _npcTextLocaleStore[ID];
         for (uint8 i = 0; i < MAX_GOSSIP_TEXT_OPTIONS; ++i)
         {
-            AddLocaleString(fields[2 + i * 2].Get<std::string>(), locale, data.Text_0[i]);
-            AddLocaleString(fields[3 + i * 2].Get<std::string>(), locale, data.Text_1[i]);
+            AddLocaleString(fields[2 + i * 2].Get<std::string_view>(), locale, data.Text_0[i]);
+            AddLocaleString(fields[3 + i * 2].Get<std::string_view>(), locale, data.Text_1[i]);
         }
     } while (result->NextRow());
 
@@ -6384,7 +6560,7 @@ void ObjectMgr::LoadQuestGreetingsLocales()
             continue;
 
         QuestGreetingLocale& data = _questGreetingLocaleStore[MAKE_PAIR32(type, id)];
-        AddLocaleString(fields[3].Get<std::string>(), locale, data.Greeting);
+        AddLocaleString(fields[3].Get<std::string_view>(), locale, data.Greeting);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} quest greeting Locale Strings in {} ms", (uint32)_questGreetingLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -6414,7 +6590,7 @@ void ObjectMgr::LoadQuestOfferRewardLocale()
             continue;
 
         QuestOfferRewardLocale& data = _questOfferRewardLocaleStore[id];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.RewardText);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.RewardText);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Quest Offer Reward Locale Strings in {} ms", _questOfferRewardLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -6443,7 +6619,7 @@ void ObjectMgr::LoadQuestRequestItemsLocale()
             continue;
 
         QuestRequestItemsLocale& data = _questRequestItemsLocaleStore[id];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.CompletionText);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.CompletionText);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Quest Request Items Locale Strings in {} ms", _questRequestItemsLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -7085,8 +7261,8 @@ void ObjectMgr::LoadGameObjectLocales()
             continue;
 
         GameObjectLocale& data = _gameObjectLocaleStore[ID];
-        AddLocaleString(fields[2].Get<std::string>(), locale, data.Name);
-        AddLocaleString(fields[3].Get<std::string>(), locale, data.CastBarCaption);
+        AddLocaleString(fields[2].Get<std::string_view>(), locale, data.Name);
+        AddLocaleString(fields[3].Get<std::string_view>(), locale, data.CastBarCaption);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Gameobject Locale Strings in {} ms", (uint32)_gameObjectLocaleStore.size(), GetMSTimeDiffToNow(oldMSTime));
@@ -7179,6 +7355,7 @@ void ObjectMgr::LoadGameObjectTemplate()
         uint32 entry = fields[0].Get<uint32>();
 
         GameObjectTemplate& got = _gameObjectTemplateStore[entry];
+        _gameObjectTemplateIndex.Set(entry, &got);
 
         got.entry          = entry;
         got.type           = uint32(fields[1].Get<uint8>());
@@ -7336,6 +7513,7 @@ void ObjectMgr::LoadGameObjectTemplate()
         ++count;
     } while (result->NextRow());
 
+    LogDenseIdIndex("Game object template", _gameObjectTemplateIndex);
     LOG_INFO("server.loading", ">> Loaded {} Game Object Templates in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
@@ -7716,6 +7894,7 @@ void ObjectMgr::LoadReputationSpilloverTemplate()
 
     if (!result)
     {
+        BuildReputationSpillover();
         LOG_INFO("server.loading", ">> Loaded `reputation_spillover_template`, table is empty.");
         LOG_INFO("server.loading", " ");
         return;
@@ -7818,10 +7997,59 @@ void ObjectMgr::LoadReputationSpilloverTemplate()
         ++count;
     } while (result->NextRow());
 
+    BuildReputationSpillover();
+
     LOG_INFO("server.loading", ">> Loaded {} Reputation Spillover Template in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
 
+void ObjectMgr::BuildReputationSpillover()
+{
+    _repSpilloverStore.clear();
+
+    auto addTeamFactions = [](RepSpilloverList& spillover, FactionEntry const* source, SimpleFactionsList const* team)
+    {
+        for (uint32 factionId : *team)
+            if (FactionEntry const* faction = sFactionStore.LookupEntry(factionId))
+                if (faction != source)
+                    spillover.push_back({ faction, faction->spilloverRateIn, ReputationRank(faction->spilloverMaxRankIn) });
+    };
+
+    for (FactionEntry const* factionEntry : sFactionStore)
+    {
+        RepSpilloverInfo info;
+
+        // if spillover definition exists in DB, override DBC
+        if (RepSpilloverTemplate const* repTemplate = GetRepSpilloverTemplate(factionEntry->ID))
+        {
+            info.FromTemplate = true;
+            for (uint32 i = 0; i < MAX_SPILLOVER_FACTIONS; ++i)
+                if (repTemplate->faction[i])
+                    if (FactionEntry const* faction = sFactionStore.LookupEntry(repTemplate->faction[i]))
+                        info.Factions.push_back({ faction, repTemplate->faction_rate[i], ReputationRank(repTemplate->faction_rank[i]) });
+        }
+        // check for sub-factions that receive spillover
+        else if (SimpleFactionsList const* subFactions = GetFactionTeamList(factionEntry->ID))
+            addTeamFactions(info.Factions, factionEntry, subFactions);
+        // if has no sub-factions, check for factions with same parent
+        else if (factionEntry->team && factionEntry->spilloverRateOut != 0.0f)
+        {
+            info.Parent = sFactionStore.LookupEntry(factionEntry->team);
+            if (!info.Parent)
+                continue;
+
+            info.RateOut = factionEntry->spilloverRateOut;
+            if (SimpleFactionsList const* sisterFactions = GetFactionTeamList(factionEntry->team))
+                addTeamFactions(info.SisterFactions, factionEntry, sisterFactions);
+        }
+
+        if (info.Factions.empty() && !info.Parent)
+            continue;
+
+        _repSpilloverStore[factionEntry->ID] = std::move(info);
+    }
+}
+
 void ObjectMgr::LoadPointsOfInterest()
 {
     uint32 oldMSTime = getMSTime();
@@ -8028,6 +8256,7 @@ void ObjectMgr::DeleteCreatureData(ObjectGuid::LowType guid)
         RemoveCreatureFromGrid(guid, data);
 
     _creatureDataStore.erase(guid);
+    _creatureDataIndex.Remove(guid);
 }
 
 void ObjectMgr::DeleteGOData(ObjectGuid::LowType guid)
@@ -8045,6 +8274,7 @@ void ObjectMgr::LoadQuestRelationsHelper(QuestRelations& map, std::string const&
     uint32 oldMSTime = getMSTime();
 
     map.clear();                                            // need for reload case
+    InvalidateQuestGiverStatus();
 
     uint32 count = 0;
 
@@ -9947,11 +10177,7 @@ void ObjectMgr::LoadFactionChangeTitles()
 
 GameObjectTemplate const* ObjectMgr::GetGameObjectTemplate(uint32 entry)
 {
-    GameObjectTemplateContainer::const_iterator itr = _gameObjectTemplateStore.find(entry);
-    if (itr != _gameObjectTemplateStore.end())
-        return &(itr->second);
-
-    return nullptr;
+    return _gameObjectTemplateIndex.Find(entry);
 }
 
 bool ObjectMgr::IsGameObjectStaticTransport(uint32 entry)
@@ -9971,7 +10197,7 @@ GameObjectTemplateAddon const* ObjectMgr::GetGameObjectTemplateAddon(uint32 entr
 
 CreatureTemplate const* ObjectMgr::GetCreatureTemplate(uint32 entry)
 {
-    return entry < _creatureTemplateStoreFast.size() ? _creatureTemplateStoreFast[entry] : nullptr;
+    return _creatureTemplateIndex.Find(entry);
 }
 
 VehicleAccessoryList const* ObjectMgr::GetVehicleAccessoryList(Vehicle* veh) const
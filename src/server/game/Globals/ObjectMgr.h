@@ -23,6 +23,7 @@
 #include "Corpse.h"
 #include "Creature.h"
 #include "DatabaseEnv.h"
+#include "DenseIdIndex.h"
 #include "DynamicObject.h"
 #include "GameObject.h"
 #include "GossipDef.h"
@@ -35,6 +36,7 @@
 #include "ObjectAccessor.h"
 #include "ObjectDefines.h"
 #include "QuestDef.h"
+#include "StringPool.h"
 #include "TemporarySummon.h"
 #include "VehicleDefines.h"
 #include <functional>
@@ -56,10 +58,24 @@ struct PlayerLevelInfo;
 #pragma pack(push, 1)
 #endif
 
+enum QueryDataGroup
+{
+    QUERY_DATA_GAMEOBJECTS  = 0x01,
+    QUERY_DATA_GOSSIP_TEXTS = 0x02,
+    QUERY_DATA_PAGE_TEXTS   = 0x04,
+    QUERY_DATA_QUESTS       = 0x08,
+
+    QUERY_DATA_ALL          = 0xFF
+};
+
 struct PageText
 {
     std::string Text;
     uint16 NextPage;
+    LocalizedQueryData QueryData;           // SMSG_PAGE_TEXT_QUERY_RESPONSE, built by ObjectMgr::InitializeQueriesData
+
+    [[nodiscard]] WorldPacket BuildQueryData(uint32 pageId, LocaleConstant locale) const;
+    void InitializeQueryData(uint32 pageId);
 };
 
 /// Key for storing temp summon data in TempSummonDataContainer
@@ -387,6 +403,15 @@ typedef std::multimap<uint32, ScriptInfo> ScriptMap;
 typedef std::map<uint32, ScriptMap > ScriptMapMap;
 typedef std::multimap<uint32, uint32> SpellScriptsContainer;
 typedef std::pair<SpellScriptsContainer::iterator, SpellScriptsContainer::iterator> SpellScriptsBounds;
+
+// hooks the scripts of a spell register, known at startup so casts can skip the ones nobody uses
+struct SpellScriptHookMasks
+{
+    uint32 SpellHooks = 0;                                  // mask of (1 << SpellScriptHookType)
+    uint32 AuraHooks = 0;                                   // mask of (1 << AuraScriptHookType)
+};
+
+typedef std::unordered_map<uint32 /*spellId*/, SpellScriptHookMasks> SpellScriptHookMaskContainer;
 extern ScriptMapMap sSpellScripts;
 extern ScriptMapMap sEventScripts;
 extern ScriptMapMap sWaypointScripts;
@@ -578,6 +603,25 @@ struct RepSpilloverTemplate
     uint32 faction_rank[MAX_SPILLOVER_FACTIONS];
 };
 
+struct RepSpillover
+{
+    FactionEntry const* Faction;
+    float Rate;
+    ReputationRank MaxRank;                                 // no spillover is received above this rank
+};
+
+typedef std::vector<RepSpillover> RepSpilloverList;
+
+// Spillover targets of a faction, resolved from `reputation_spillover_template` or the faction teams in Faction.dbc
+struct RepSpilloverInfo
+{
+    bool FromTemplate = false;
+    float RateOut = 1.0f;
+    RepSpilloverList Factions;                              // sub-factions or template factions, always receive spillover
+    FactionEntry const* Parent = nullptr;                   // receives the spillover instead of SisterFactions if it has own standing
+    RepSpilloverList SisterFactions;
+};
+
 struct PointOfInterest
 {
     uint32 ID;
@@ -602,7 +646,7 @@ struct QuestGreeting
 
 struct QuestGreetingLocale
 {
-    std::vector<std::string> Greeting;
+    LocaleStrings Greeting;
 };
 
 typedef std::unordered_map<uint32, QuestGreetingLocale> QuestGreetingLocaleContainer;
@@ -751,6 +795,7 @@ public:
     typedef std::unordered_map<uint32, RepRewardRate > RepRewardRateContainer;
     typedef std::unordered_map<uint32, ReputationOnKillEntry> RepOnKillContainer;
     typedef std::unordered_map<uint32, RepSpilloverTemplate> RepSpilloverTemplateContainer;
+    typedef std::unordered_map<uint32, RepSpilloverInfo> RepSpilloverContainer;
 
     typedef std::unordered_map<uint32, PointOfInterest> PointOfInterestContainer;
 
@@ -781,7 +826,7 @@ public:
     CreatureMovementData const* GetCreatureMovementOverride(ObjectGuid::LowType spawnId) const;
     ItemTemplate const* GetItemTemplate(uint32 entry);
     [[nodiscard]] ItemTemplateContainer const* GetItemTemplateStore() const { return &_itemTemplateStore; }
-    [[nodiscard]] std::vector<ItemTemplate*> const* GetItemTemplateStoreFast() const { return &_itemTemplateStoreFast; }
+    [[nodiscard]] std::vector<ItemTemplate*> const* GetItemTemplateStoreFast() const { return &_itemTemplateIndex.GetEntries(); }
 
     ItemSetNameEntry const* GetItemSetNameEntry(uint32 itemId)
     {
@@ -831,7 +876,7 @@ public:
 
     [[nodiscard]] Quest const* GetQuestTemplate(uint32 quest_id) const
     {
-        return quest_id < _questTemplatesFast.size() ? _questTemplatesFast[quest_id] : nullptr;
+        return _questTemplateIndex.Find(quest_id);
     }
 
     [[nodiscard]] QuestMap const& GetQuestTemplates() const { return _questTemplates; }
@@ -893,6 +938,11 @@ public:
 
     uint32 GetAreaTriggerScriptId(uint32 trigger_id);
     SpellScriptsBounds GetSpellScriptsBounds(uint32 spell_id);
+    [[nodiscard]] SpellScriptHookMasks GetSpellScriptHookMasks(uint32 spellId) const
+    {
+        SpellScriptHookMaskContainer::const_iterator itr = _spellScriptHookMaskStore.find(spellId);
+        return itr != _spellScriptHookMaskStore.end() ? itr->second : SpellScriptHookMasks();
+    }
 
     [[nodiscard]] RepRewardRate const* GetRepRewardRate(uint32 factionId) const
     {
@@ -922,6 +972,15 @@ public:
         return nullptr;
     }
 
+    [[nodiscard]] RepSpilloverInfo const* GetRepSpillover(uint32 factionId) const
+    {
+        RepSpilloverContainer::const_iterator itr = _repSpilloverStore.find(factionId);
+        if (itr != _repSpilloverStore.end())
+            return &itr->second;
+
+        return nullptr;
+    }
+
     [[nodiscard]] PointOfInterest const* GetPointOfInterest(uint32 id) const
     {
         PointOfInterestContainer::const_iterator itr = _pointsOfInterestStore.find(id);
@@ -1006,6 +1065,10 @@ public:
         return _creatureQuestInvolvedRelations.equal_range(creature_entry);
     }
 
+    // changes whenever quest givers may show another status to every player, see Player::GetQuestDialogStatus
+    [[nodiscard]] uint32 GetQuestGiverStatusEpoch() const { return _questGiverStatusEpoch; }
+    void InvalidateQuestGiverStatus() { ++_questGiverStatusEpoch; }
+
     void LoadEventScripts();
     void LoadSpellScripts();
     void LoadWaypointScripts();
@@ -1074,6 +1137,8 @@ public:
     void LoadPageTexts();
     PageText const* GetPageText(uint32 pageEntry);
 
+    void InitializeQueriesData(QueryDataGroup mask);
+
     void LoadPlayerInfo();
     void LoadPetLevelInfo();
     void LoadExplorationBaseXP();
@@ -1200,11 +1265,19 @@ public:
     [[nodiscard]] CreatureDataContainer const& GetAllCreatureData() const { return _creatureDataStore; }
     [[nodiscard]] CreatureData const* GetCreatureData(ObjectGuid::LowType spawnId) const
     {
+        if (_creatureDataIndex.Covers(spawnId))
+            return _creatureDataIndex.Find(spawnId);
+
         CreatureDataContainer::const_iterator itr = _creatureDataStore.find(spawnId);
         if (itr == _creatureDataStore.end()) return nullptr;
         return &itr->second;
     }
-    CreatureData& NewOrExistCreatureData(ObjectGuid::LowType spawnId) { return _creatureDataStore[spawnId]; }
+    CreatureData& NewOrExistCreatureData(ObjectGuid::LowType spawnId)
+    {
+        CreatureData& data = _creatureDataStore[spawnId];
+        _creatureDataIndex.Set(spawnId, &data);
+        return data;
+    }
     void DeleteCreatureData(ObjectGuid::LowType spawnId);
     [[nodiscard]] ObjectGuid GetLinkedRespawnGuid(ObjectGuid guid) const
     {
@@ -1414,13 +1487,21 @@ public:
     }
 
     static void AddLocaleString(std::string&& s, LocaleConstant locale, std::vector<std::string>& data);
-    static std::string_view GetLocaleString(std::vector<std::string> const& data, size_t locale)
+    // s is interned in the locale string pool, identical texts of all *_locale tables share one copy
+    static void AddLocaleString(std::string_view s, LocaleConstant locale, LocaleStrings& data);
+    static Acore::StringPool& GetLocaleStringPool();
+    static std::string_view GetLocaleString(LocaleStrings const& data, size_t locale)
     {
         if (locale < data.size())
             return data[locale];
         else
             return {};
     }
+    static inline void GetLocaleString(LocaleStrings const& data, int loc_idx, std::string& value)
+    {
+        if (data.size() > size_t(loc_idx) && !data[loc_idx].empty())
+            value = data[loc_idx];
+    }
     static inline void GetLocaleString(const std::vector<std::string>& data, int loc_idx, std::string& value)
     {
         if (data.size() > size_t(loc_idx) && !data[loc_idx].empty())
@@ -1471,7 +1552,7 @@ private:
     std::map<HighGuid, std::unique_ptr<ObjectGuidGeneratorBase>> _guidGenerators;
 
     QuestMap _questTemplates;
-    std::vector<Quest*> _questTemplatesFast; // pussywizard
+    Acore::DenseIdIndex<Quest> _questTemplateIndex;
 
     typedef std::unordered_map<uint32, GossipText> GossipTextContainer;
     typedef std::unordered_map<uint32, uint32> QuestAreaTriggerContainer;
@@ -1490,6 +1571,7 @@ private:
     RepRewardRateContainer _repRewardRateStore;
     RepOnKillContainer _repOnKillStore;
     RepSpilloverTemplateContainer _repSpilloverTemplateStore;
+    RepSpilloverContainer _repSpilloverStore;
 
     GossipMenusContainer _gossipMenusStore;
     GossipMenuItemsContainer _gossipMenuItemsStore;
@@ -1501,6 +1583,7 @@ private:
     QuestRelations _goQuestInvolvedRelations;
     QuestRelations _creatureQuestRelations;
     QuestRelations _creatureQuestInvolvedRelations;
+    uint32 _questGiverStatusEpoch;
 
     //character reserved names
     typedef std::set<std::wstring> ReservedNamesContainer;
@@ -1517,6 +1600,7 @@ private:
     SpellClickInfoContainer _spellClickInfoStore;
 
     SpellScriptsContainer _spellScriptsStore;
+    SpellScriptHookMaskContainer _spellScriptHookMaskStore;
 
     VehicleAccessoryContainer _vehicleTemplateAccessoryStore;
     VehicleAccessoryContainer _vehicleAccessoryStore;
@@ -1530,6 +1614,8 @@ private:
     void LoadScripts(ScriptsType type);
     void LoadQuestRelationsHelper(QuestRelations& map, std::string const& table, bool starter, bool go);
     void PlayerCreateInfoAddItemHelper(uint32 race_, uint32 class_, uint32 itemId, int32 count);
+    bool LoadCreaturesFromSnapshot();
+    bool LoadGameobjectsFromSnapshot();
 
     MailLevelRewardContainer _mailLevelRewardStore;
 
@@ -1542,6 +1628,7 @@ private:
     PlayerClassInfo* _playerClassInfo[MAX_CLASSES];
 
     void BuildPlayerLevelInfo(uint8 race, uint8 class_, uint8 level, PlayerLevelInfo* plinfo) const;
+    void BuildReputationSpillover();
 
     PlayerInfo* _playerInfo[MAX_RACES][MAX_CLASSES];
 
@@ -1568,9 +1655,11 @@ private:
     CellObjectGuidsMap _emptyCellObjectGuidsMap;
     CellObjectGuids _emptyCellObjectGuids;
     CreatureDataContainer _creatureDataStore;
+    // spawn ids above the limit stay map lookups, keeps the index below 32 MB with sparse guid ranges
+    Acore::DenseIdIndex<CreatureData> _creatureDataIndex{ 4 * 1024 * 1024 };
     CreatureTemplateContainer _creatureTemplateStore;
     CreatureCustomIDsContainer _creatureCustomIDsStore;
-    std::vector<CreatureTemplate*> _creatureTemplateStoreFast; // pussywizard
+    Acore::DenseIdIndex<CreatureTemplate> _creatureTemplateIndex;
     CreatureModelContainer _creatureModelStore;
     CreatureAddonContainer _creatureAddonStore;
     CreatureAddonContainer _creatureTemplateAddonStore;
@@ -1584,13 +1673,14 @@ private:
     GameObjectDataContainer _gameObjectDataStore;
     GameObjectLocaleContainer _gameObjectLocaleStore;
     GameObjectTemplateContainer _gameObjectTemplateStore;
+    Acore::DenseIdIndex<GameObjectTemplate> _gameObjectTemplateIndex;
     GameObjectTemplateAddonContainer _gameObjectTemplateAddonStore;
     /// Stores temp summon data grouped by summoner's entry, summoner's type and group id
     TempSummonDataContainer _tempSummonDataStore;
 
     BroadcastTextContainer _broadcastTextStore;
     ItemTemplateContainer _itemTemplateStore;
-    std::vector<ItemTemplate*> _itemTemplateStoreFast; // pussywizard
+    Acore::DenseIdIndex<ItemTemplate> _itemTemplateIndex;
     ItemLocaleContainer _itemLocaleStore;
     ItemSetNameLocaleContainer _itemSetNameLocaleStore;
     QuestLocaleContainer _questLocaleStore;
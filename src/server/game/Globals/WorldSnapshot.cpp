@@ -0,0 +1,149 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldSnapshot.h"
+#include "ByteBuffer.h"
+#include "Config.h"
+#include "DatabaseEnv.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "Timer.h"
+#include "Util.h"
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    constexpr uint32 SNAPSHOT_MAGIC = 0x53534341; // "ACSS"
+
+    // bump whenever the payload layout of any store changes
+    constexpr uint32 SNAPSHOT_VERSION = 1;
+}
+
+WorldSnapshot* WorldSnapshot::instance()
+{
+    static WorldSnapshot instance;
+    return &instance;
+}
+
+void WorldSnapshot::Initialize()
+{
+    _directory = sConfigMgr->GetOption<std::string>("WorldSnapshot.Directory", "");
+    if (_directory.empty())
+        return;
+
+    uint32 oldMSTime = getMSTime();
+
+    // the applied updates describe the world database content as long as it is only changed through them
+    Acore::Crypto::SHA1 hash;
+    hash.UpdateData(GitRevision::GetHash());
+    hash.UpdateData(reinterpret_cast<uint8 const*>(&SNAPSHOT_VERSION), sizeof(SNAPSHOT_VERSION));
+
+    uint32 count = 0;
+    if (QueryResult result = WorldDatabase.Query("SELECT `name`, `hash` FROM `updates` ORDER BY `name`"))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            hash.UpdateData(fields[0].Get<std::string>());
+            hash.UpdateData(fields[1].Get<std::string>());
+            ++count;
+        } while (result->NextRow());
+    }
+
+    hash.Finalize();
+    _key = hash.GetDigest();
+
+    LOG_INFO("server.loading", ">> World snapshot key {} from {} applied updates in {} ms", ByteArrayToHexStr(_key), count, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
+bool WorldSnapshot::Load(std::string const& store, ByteBuffer& data) const
+{
+    if (!IsEnabled())
+        return false;
+
+    std::ifstream file(GetFileName(store), std::ios::in | std::ios::binary);
+    if (!file)
+        return false;
+
+    uint32 magic = 0;
+    uint32 version = 0;
+    Acore::Crypto::SHA1::Digest key{};
+    uint64 size = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(key.data()), key.size());
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+    if (!file || magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION || key != _key || !size)
+    {
+        LOG_INFO("server.loading", "World snapshot of {} is outdated, loading it from the database.", store);
+        return false;
+    }
+
+    data.resize(size);
+    file.read(reinterpret_cast<char*>(data.contents()), size);
+    if (!file || uint64(file.gcount()) != size)
+    {
+        LOG_ERROR("server.loading", "World snapshot of {} is truncated, loading it from the database.", store);
+        data.clear();
+        return false;
+    }
+
+    return true;
+}
+
+void WorldSnapshot::Save(std::string const& store, ByteBuffer const& data) const
+{
+    if (!IsEnabled())
+        return;
+
+    // write next to the old file and swap it in, a crash while writing must not leave a valid looking header
+    std::string const fileName = GetFileName(store);
+    std::string const tempName = fileName + ".tmp";
+    {
+        std::ofstream file(tempName, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            LOG_ERROR("server.loading", "World snapshot of {} can't be written to {}.", store, tempName);
+            return;
+        }
+
+        uint64 size = data.wpos();
+        file.write(reinterpret_cast<char const*>(&SNAPSHOT_MAGIC), sizeof(SNAPSHOT_MAGIC));
+        file.write(reinterpret_cast<char const*>(&SNAPSHOT_VERSION), sizeof(SNAPSHOT_VERSION));
+        file.write(reinterpret_cast<char const*>(_key.data()), _key.size());
+        file.write(reinterpret_cast<char const*>(&size), sizeof(size));
+        file.write(reinterpret_cast<char const*>(data.contents()), size);
+        if (!file.flush())
+        {
+            LOG_ERROR("server.loading", "World snapshot of {} can't be written to {}.", store, tempName);
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempName, fileName, error);
+    if (error)
+        LOG_ERROR("server.loading", "World snapshot of {} can't be moved to {}: {}", store, fileName, error.message());
+}
+
+std::string WorldSnapshot::GetFileName(std::string const& store) const
+{
+    return (std::filesystem::path(_directory) / (store + ".snapshot")).string();
+}
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WORLDSNAPSHOT_H
+#define _WORLDSNAPSHOT_H
+
+#include "CryptoHash.h"
+#include "Define.h"
+#include <string>
+
+class ByteBuffer;
+
+/*
+ * Binary copies of world stores, written after a successful load from the world
+ * database and read back on the next start instead of querying it. Every store is
+ * its own file under WorldSnapshot.Directory; a file is only used when its key matches
+ * the applied world database updates and the core revision it was written by.
+ */
+class AC_GAME_API WorldSnapshot
+{
+public:
+    static WorldSnapshot* instance();
+
+    void Initialize();
+
+    [[nodiscard]] bool IsEnabled() const { return !_directory.empty(); }
+
+    // Fills data with the payload of the given store, false if there is no valid snapshot of it
+    bool Load(std::string const& store, ByteBuffer& data) const;
+    void Save(std::string const& store, ByteBuffer const& data) const;
+
+private:
+    [[nodiscard]] std::string GetFileName(std::string const& store) const;
+
+    std::string _directory;
+    Acore::Crypto::SHA1::Digest _key{};
+};
+
+#define sWorldSnapshot WorldSnapshot::instance()
+
+#endif
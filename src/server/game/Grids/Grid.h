@@ -36,6 +36,18 @@
 // forward declaration
 template<class A, class T, class O> class GridLoader;
 
+// Binds every object list of a container to the occupancy of its cell
+class GridOccupancyBinder
+{
+public:
+    explicit GridOccupancyBinder(GridOccupancy* occupancy) : i_occupancy(occupancy) { }
+
+    template<class T> void Visit(GridRefMgr<T>& m) { m.SetOccupancy(i_occupancy); }
+
+private:
+    GridOccupancy* i_occupancy;
+};
+
 template
 <
     class ACTIVE_OBJECT,
@@ -47,11 +59,47 @@ class Grid
     // allows the GridLoader to access its internals
     template<class A, class T, class O> friend class GridLoader;
 public:
+    Grid()
+    {
+        GridOccupancyBinder gridBinder(&i_gridObjectOccupancy);
+        TypeContainerVisitor<GridOccupancyBinder, TypeMapContainer<GRID_OBJECT_TYPES> > gridVisitor(gridBinder);
+        gridVisitor.Visit(i_container);
+
+        GridOccupancyBinder worldBinder(&i_worldObjectOccupancy);
+        TypeContainerVisitor<GridOccupancyBinder, TypeMapContainer<WORLD_OBJECT_TYPES> > worldVisitor(worldBinder);
+        worldVisitor.Visit(i_objects);
+    }
+
+    Grid(Grid const&) = delete;
+    Grid& operator=(Grid const&) = delete;
+
     /** destructor to clean up its resources. This includes unloading the
     grid if it has not been unload.
     */
     ~Grid() = default;
 
+    /** the cell object counts also count for the given grid wide occupancies
+     */
+    void SetOccupancyParents(GridOccupancy* gridObjectOccupancy, GridOccupancy* worldObjectOccupancy)
+    {
+        i_gridObjectOccupancy.SetParent(gridObjectOccupancy);
+        i_worldObjectOccupancy.SetParent(worldObjectOccupancy);
+    }
+
+    // No grid objects in the cell
+    template<class T>
+    [[nodiscard]] bool IsEmpty(TypeContainerVisitor<T, TypeMapContainer<GRID_OBJECT_TYPES> > const& /*visitor*/) const
+    {
+        return i_gridObjectOccupancy.IsEmpty();
+    }
+
+    // No world objects in the cell
+    template<class T>
+    [[nodiscard]] bool IsEmpty(TypeContainerVisitor<T, TypeMapContainer<WORLD_OBJECT_TYPES> > const& /*visitor*/) const
+    {
+        return i_worldObjectOccupancy.IsEmpty();
+    }
+
     /** an object of interested enters the grid
      */
     template<class SPECIFIC_OBJECT> void AddWorldObject(SPECIFIC_OBJECT* obj)
@@ -123,6 +171,10 @@ public:
         return i_container.GetElements().IsEmpty();
     }*/
 private:
+    // declared first, the object lists report to them until they are destroyed
+    GridOccupancy i_gridObjectOccupancy;
+    GridOccupancy i_worldObjectOccupancy;
+
     TypeMapContainer<GRID_OBJECT_TYPES> i_container;
     TypeMapContainer<WORLD_OBJECT_TYPES> i_objects;
     //typedef std::set<void*> ActiveGridObjects;
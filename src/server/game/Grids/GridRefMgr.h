@@ -19,16 +19,53 @@
 #define _GRIDREFMANAGER
 
 #include "RefMgr.h"
+#include <atomic>
 
 template<class OBJECT>
 class GridReference;
 
+/// Number of objects in a cell or in a whole grid, a cell counter also counts for the grid it belongs to.
+/// Searches read it to skip cells and grids without walking their object lists.
+class GridOccupancy
+{
+public:
+    GridOccupancy() : _count(0), _parent(nullptr) { }
+
+    void SetParent(GridOccupancy* parent) { _parent = parent; }
+
+    void Increase()
+    {
+        _count.fetch_add(1, std::memory_order_relaxed);
+        if (_parent)
+            _parent->Increase();
+    }
+
+    void Decrease()
+    {
+        _count.fetch_sub(1, std::memory_order_relaxed);
+        if (_parent)
+            _parent->Decrease();
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return !_count.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint32> _count;
+    GridOccupancy* _parent;
+};
+
 template<class OBJECT>
 class GridRefMgr : public RefMgr<GridRefMgr<OBJECT>, OBJECT>
 {
 public:
     typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
 
+    GridRefMgr() : _occupancy(nullptr) { }
+
+    // lists of grid cells report their size changes to the occupancy of the cell
+    void SetOccupancy(GridOccupancy* occupancy) { _occupancy = occupancy; }
+    [[nodiscard]] GridOccupancy* GetOccupancy() const { return _occupancy; }
+
     GridReference<OBJECT>* getFirst() { return (GridReference<OBJECT>*)RefMgr<GridRefMgr<OBJECT>, OBJECT>::getFirst(); }
     GridReference<OBJECT>* getLast() { return (GridReference<OBJECT>*)RefMgr<GridRefMgr<OBJECT>, OBJECT>::getLast(); }
 
@@ -36,5 +73,8 @@ public:
     iterator end() { return iterator(nullptr); }
     iterator rbegin() { return iterator(getLast()); }
     iterator rend() { return iterator(nullptr); }
+
+private:
+    GridOccupancy* _occupancy;
 };
 #endif
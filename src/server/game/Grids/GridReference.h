@@ -32,16 +32,25 @@ protected:
         // called from link()
         this->getTarget()->insertFirst(this);
         this->getTarget()->incSize();
+        if (auto* occupancy = this->getTarget()->GetOccupancy())
+            occupancy->Increase();
     }
     void targetObjectDestroyLink() override
     {
         // called from unlink()
-        if (this->isValid()) this->getTarget()->decSize();
+        if (this->isValid())
+        {
+            this->getTarget()->decSize();
+            if (auto* occupancy = this->getTarget()->GetOccupancy())
+                occupancy->Decrease();
+        }
     }
     void sourceObjectDestroyLink() override
     {
         // called from invalidate()
         this->getTarget()->decSize();
+        if (auto* occupancy = this->getTarget()->GetOccupancy())
+            occupancy->Decrease();
     }
 public:
     GridReference() : Reference<GridRefMgr<OBJECT>, OBJECT>() {}
@@ -25,6 +25,7 @@
 #include "GridReference.h"
 #include "Timer.h"
 #include "Util.h"
+#include <bitset>
 
 template
 <
@@ -40,6 +41,9 @@ public:
     NGrid(uint32 id, int32 x, int32 y)
         : i_gridId(id), i_x(x), i_y(y), i_GridObjectDataLoaded(false)
     {
+        for (uint32 cellX = 0; cellX < N; ++cellX)
+            for (uint32 cellY = 0; cellY < N; ++cellY)
+                i_cells[cellX][cellY].SetOccupancyParents(&i_gridObjectOccupancy, &i_worldObjectOccupancy);
     }
 
     GridType& GetGridType(const uint32 x, const uint32 y)
@@ -64,6 +68,9 @@ public:
     }
     [[nodiscard]] bool isGridObjectDataLoaded() const { return i_GridObjectDataLoaded; }
     void setGridObjectDataLoaded(bool pLoaded) { i_GridObjectDataLoaded = pLoaded; }
+    // the database spawns of a loaded grid are created per Grid (cell), all at once unless grids are loaded staged
+    [[nodiscard]] bool isCellObjectDataLoaded(uint32 x, uint32 y) const { return i_CellObjectDataLoaded.test(x * N + y); }
+    void setCellObjectDataLoaded(uint32 x, uint32 y) { i_CellObjectDataLoaded.set(x * N + y); }
 
     /*
     template<class SPECIFIC_OBJECT> void AddWorldObject(const uint32 x, const uint32 y, SPECIFIC_OBJECT *obj)
@@ -96,6 +103,19 @@ public:
                 GetGridType(x, y).Visit(visitor);
     }
 
+    // No objects of the visited container in any Grid (cell) of the NGrid (grid)
+    template<class T>
+    [[nodiscard]] bool IsEmpty(TypeContainerVisitor<T, TypeMapContainer<GRID_OBJECT_TYPES> > const& /*visitor*/) const
+    {
+        return i_gridObjectOccupancy.IsEmpty();
+    }
+
+    template<class T>
+    [[nodiscard]] bool IsEmpty(TypeContainerVisitor<T, TypeMapContainer<WORLD_OBJECT_TYPES> > const& /*visitor*/) const
+    {
+        return i_worldObjectOccupancy.IsEmpty();
+    }
+
     // Visit a single Grid (cell) in NGrid (grid)
     template<class T, class TT>
     void VisitGrid(const uint32 x, const uint32 y, TypeContainerVisitor<T, TypeMapContainer<TT> >& visitor)
@@ -108,7 +128,11 @@ private:
     GridReference<NGrid<N, ACTIVE_OBJECT, WORLD_OBJECT_TYPES, GRID_OBJECT_TYPES> > i_Reference;
     int32 i_x;
     int32 i_y;
+    // declared before the cells, which report to them until they are destroyed
+    GridOccupancy i_gridObjectOccupancy;
+    GridOccupancy i_worldObjectOccupancy;
     GridType i_cells[N][N];
     bool i_GridObjectDataLoaded;
+    std::bitset<N * N> i_CellObjectDataLoaded;
 };
 #endif
@@ -16,15 +16,63 @@
  */
 
 #include "GridNotifiers.h"
+#include "CinematicMgr.h"
+#include "ConditionMgr.h"
 #include "Map.h"
 #include "ObjectAccessor.h"
 #include "SpellMgr.h"
 #include "Transport.h"
 #include "UpdateData.h"
+#include "World.h"
 #include "WorldPacket.h"
+#include <limits>
 
 using namespace Acore;
 
+VisibleNotifier::VisibleNotifier(Player& player, bool gobjOnly, bool largeOnly) :
+    i_player(player), vis_guids(player.m_clientGUIDs), i_visibleNow(player.m_newVisible), i_gobjOnly(gobjOnly), i_largeOnly(largeOnly), i_previousPass(0), i_visiblePlayers(0)
+{
+    i_visibleNow.clear();
+
+    // Only the seer's own state is stamped, anything else that changes what the player sees makes the pass check every object
+    bool const incremental = sWorld->getBoolConfig(CONFIG_VISIBILITY_INCREMENTAL) && player.IsAlive() && player.m_seer == &player &&
+        !player.GetFarSightDistance() && !player.GetCinematicMgr()->IsOnCinematic() && !player.GetMap()->IsBattlegroundOrArena();
+
+    uint64& passStamp = player.m_visibilityPassStamps[largeOnly ? 1 : 0];
+    if (incremental && passStamp && player.GetVisibilityStamp() <= passStamp)
+        i_previousPass = passStamp;
+
+    // gameobject only passes don't check every object the previous pass stamp stands for
+    if (!gobjOnly)
+        passStamp = incremental ? WorldObject::NewVisibilityStamp() : 0;
+}
+
+bool VisibleNotifier::IsVisibilityUnchanged(WorldObject const* obj, bool atClient) const
+{
+    if (!i_previousPass || !atClient || !obj->IsVisibilityStateUnchangedSince(i_previousPass))
+        return false;
+
+    switch (obj->GetTypeId())
+    {
+        case TYPEID_PLAYER:
+            // players are seen depending on group and team state, which isn't stamped
+            return false;
+        case TYPEID_UNIT:
+        {
+            Creature const* creature = obj->ToCreature();
+            if (creature->GetVehicleBase() || sConditionMgr->HasConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_CREATURE_VISIBILITY, creature->GetEntry()))
+                return false;
+            break;
+        }
+        default:
+            break;
+    }
+
+    // the full check compares against the bounding radius, which only makes it more permissive
+    float const sightRange = i_player.GetSightRange(obj);
+    return i_player.GetExactDistSq(obj) <= sightRange * sightRange;
+}
+
 void VisibleNotifier::Visit(GameObjectMapType& m)
 {
     for (GameObjectMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
@@ -33,13 +81,17 @@ void VisibleNotifier::Visit(GameObjectMapType& m)
         if (i_largeOnly != go->IsVisibilityOverridden())
             continue;
 
-        vis_guids.erase(go->GetGUID());
-        i_player.UpdateVisibilityOf(go, i_data, i_visibleNow);
+        bool const atClient = vis_guids.erase(go->GetGUID());
+        if (!IsVisibilityUnchanged(go, atClient))
+            i_player.UpdateVisibilityOf(go, i_data, i_visibleNow);
     }
 }
 
 void VisibleNotifier::SendToSelf()
 {
+    if (!i_largeOnly && !i_gobjOnly)
+        i_player.UpdateVisibilityBudget(i_visiblePlayers);
+
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = i_player.GetTransport())
@@ -70,7 +122,7 @@ void VisibleNotifier::SendToSelf()
             }
         }
 
-    for (GuidUnorderedSet::const_iterator it = vis_guids.begin(); it != vis_guids.end(); ++it)
+    for (GuidFlatSet::const_iterator it = vis_guids.begin(); it != vis_guids.end(); ++it)
     {
         if (WorldObject* obj = ObjectAccessor::GetWorldObject(i_player, *it))
         {
@@ -173,23 +225,49 @@ void PlayerRelocationNotifier::Visit(PlayerMapType& m)
         Player* player = iter->GetSource();
         vis_guids.erase(player->GetGUID());
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
+        if (i_player.HaveAtClient(player))
+            ++i_visiblePlayers;
+
         player->UpdateVisibilityOf(&i_player); // this notifier with different Visit(PlayerMapType&) than VisibleNotifier is needed to update visibility of self for other players when we move (eg. stealth detection changes)
     }
 }
 
+inline void CreaturePlayerRelocationWorker(Creature* c, Player* player)
+{
+    // NOTIFY_VISIBILITY_CHANGED does not guarantee that player will do it himself (because distance is also checked), but screw it, it's not that important
+    if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+        player->UpdateVisibilityOf(c);
+
+    // NOTIFY_AI_RELOCATION does not guarantee that player will do it himself (because distance is also checked), but screw it, it's not that important
+    if (!player->m_seer->isNeedNotify(NOTIFY_AI_RELOCATION) && !c->IsMoveInLineOfSightStrictlyDisabled())
+        CreatureUnitRelocationWorker(c, player);
+}
+
 void CreatureRelocationNotifier::Visit(PlayerMapType& m)
+{
+    for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
+        CreaturePlayerRelocationWorker(&i_creature, iter->GetSource());
+}
+
+void CreatureRelocationBatchNotifier::Visit(PlayerMapType& m)
 {
     for (PlayerMapType::iterator iter = m.begin(); iter != m.end(); ++iter)
     {
         Player* player = iter->GetSource();
+        CellCoord const p = Acore::ComputeCellCoord(player->GetPositionX(), player->GetPositionY());
 
-        // NOTIFY_VISIBILITY_CHANGED does not guarantee that player will do it himself (because distance is also checked), but screw it, it's not that important
-        if (!player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
-            player->UpdateVisibilityOf(&i_creature);
+        for (auto const& [creature, area] : i_creatures)
+        {
+            if (p.x_coord < area.low_bound.x_coord || p.x_coord > area.high_bound.x_coord ||
+                p.y_coord < area.low_bound.y_coord || p.y_coord > area.high_bound.y_coord)
+                continue;
+
+            // AI reactions to a previous player may have removed the creature
+            if (!creature->IsInWorld() || creature->IsDuringRemoveFromWorld())
+                continue;
 
-        // NOTIFY_AI_RELOCATION does not guarantee that player will do it himself (because distance is also checked), but screw it, it's not that important
-        if (!player->m_seer->isNeedNotify(NOTIFY_AI_RELOCATION) && !i_creature.IsMoveInLineOfSightStrictlyDisabled())
-            CreatureUnitRelocationWorker(&i_creature, player);
+            CreaturePlayerRelocationWorker(creature, player);
+        }
     }
 }
 
@@ -345,8 +423,31 @@ void ObjectUpdater::Visit(GridRefMgr<T>& m)
     {
         obj = iter->GetSource();
         ++iter;
-        if (obj->IsInWorld() && (i_largeOnly == obj->IsVisibilityOverridden()))
+        if (!obj->IsInWorld() || (i_largeOnly != obj->IsVisibilityOverridden()))
+            continue;
+
+        if constexpr (std::is_same_v<T, Creature>)
+        {
+            // no counting here, this updater may be shared by region update threads
+            if (i_idleCreatureInterval > 1 && obj->IsIdleForUpdate())
+            {
+                if ((obj->GetGUID().GetCounter() + i_idleTick) % i_idleCreatureInterval == 0)
+                    obj->Update(i_idleCreatureTimeDiff);
+                continue;
+            }
+        }
+
+        if (i_idleInterval <= 1 || obj->isActiveObject() || (obj->ToUnit() && obj->ToUnit()->IsInCombat()))
+        {
             obj->Update(i_timeDiff);
+            continue;
+        }
+
+        // spread idle objects over the interval by their guid
+        if ((obj->GetGUID().GetCounter() + i_idleTick) % i_idleInterval == 0)
+            obj->Update(i_idleTimeDiff);
+        else
+            ++i_skippedObjects;
     }
 }
 
@@ -383,3 +484,84 @@ bool AnyDeadUnitSpellTargetInRangeCheck::operator()(Creature* u)
 template void ObjectUpdater::Visit<Creature>(CreatureMapType&);
 template void ObjectUpdater::Visit<GameObject>(GameObjectMapType&);
 template void ObjectUpdater::Visit<DynamicObject>(DynamicObjectMapType&);
+
+void WorldObjectCandidates::Add(WorldObject* object)
+{
+    Objects.push_back(object);
+    X.push_back(object->GetPositionX());
+    Y.push_back(object->GetPositionY());
+    Z.push_back(object->GetPositionZ());
+    // gameobjects are range checked against their model bounds
+    Size.push_back(object->GetTypeId() == TYPEID_GAMEOBJECT ? std::numeric_limits<float>::infinity() : object->GetObjectSize());
+}
+
+void WorldObjectCandidates::FilterInRange(Position const* center, float range, std::vector<uint8>& inRange) const
+{
+    std::size_t count = Objects.size();
+    inRange.resize(count);
+
+    float cx = center->GetPositionX();
+    float cy = center->GetPositionY();
+    float cz = center->GetPositionZ();
+    float const* x = X.data();
+    float const* y = Y.data();
+    float const* z = Z.data();
+    float const* size = Size.data();
+    uint8* result = inRange.data();
+
+    // branch free so the compiler can vectorize it, the small margin keeps it conservative
+    // against rounding differences to the exact check that follows
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float dx = x[i] - cx;
+        float dy = y[i] - cy;
+        float dz = z[i] - cz;
+        float maxDist = range + size[i] + 0.01f;
+        result[i] = uint8(dx * dx + dy * dy + dz * dz < maxDist * maxDist);
+    }
+}
+
+void WorldObjectCandidateGatherer::Visit(PlayerMapType& m)
+{
+    if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_PLAYER))
+        return;
+
+    for (PlayerMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+        i_candidates.Add(itr->GetSource());
+}
+
+void WorldObjectCandidateGatherer::Visit(CreatureMapType& m)
+{
+    if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CREATURE))
+        return;
+
+    for (CreatureMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+        i_candidates.Add(itr->GetSource());
+}
+
+void WorldObjectCandidateGatherer::Visit(CorpseMapType& m)
+{
+    if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_CORPSE))
+        return;
+
+    for (CorpseMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+        i_candidates.Add(itr->GetSource());
+}
+
+void WorldObjectCandidateGatherer::Visit(GameObjectMapType& m)
+{
+    if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_GAMEOBJECT))
+        return;
+
+    for (GameObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+        i_candidates.Add(itr->GetSource());
+}
+
+void WorldObjectCandidateGatherer::Visit(DynamicObjectMapType& m)
+{
+    if (!(i_mapTypeMask & GRID_MAP_TYPE_MASK_DYNAMICOBJECT))
+        return;
+
+    for (DynamicObjectMapType::iterator itr = m.begin(); itr != m.end(); ++itr)
+        i_candidates.Add(itr->GetSource());
+}
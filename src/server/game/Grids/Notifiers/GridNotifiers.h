@@ -41,21 +41,22 @@ namespace Acore
     struct VisibleNotifier
     {
         Player& i_player;
-        GuidUnorderedSet vis_guids;
+        GuidFlatSet vis_guids;
         std::vector<Unit*>& i_visibleNow;
         bool i_gobjOnly;
         bool i_largeOnly;
+        uint64 i_previousPass;
+        uint32 i_visiblePlayers;
         UpdateData i_data;
 
-        VisibleNotifier(Player& player, bool gobjOnly, bool largeOnly) :
-            i_player(player), vis_guids(player.m_clientGUIDs), i_visibleNow(player.m_newVisible), i_gobjOnly(gobjOnly), i_largeOnly(largeOnly)
-        {
-            i_visibleNow.clear();
-        }
+        VisibleNotifier(Player& player, bool gobjOnly, bool largeOnly);
 
         void Visit(GameObjectMapType&);
         template<class T> void Visit(GridRefMgr<T>& m);
         void SendToSelf(void);
+
+        // true if the object is at client and can't have become invisible since the previous pass (Visibility.Incremental)
+        bool IsVisibilityUnchanged(WorldObject const* obj, bool atClient) const;
     };
 
     struct VisibleChangesNotifier
@@ -85,6 +86,16 @@ namespace Acore
         void Visit(PlayerMapType&);
     };
 
+    // relocation of creatures standing in the same cell, the union of their cell areas is visited once
+    // and every player is notified about the creatures whose own cell area contains it
+    struct CreatureRelocationBatchNotifier
+    {
+        std::vector<std::pair<Creature*, CellArea>> const& i_creatures;
+        explicit CreatureRelocationBatchNotifier(std::vector<std::pair<Creature*, CellArea>> const& creatures) : i_creatures(creatures) {}
+        template<class T> void Visit(GridRefMgr<T>&) {}
+        void Visit(PlayerMapType&);
+    };
+
     struct AIRelocationNotifier
     {
         Unit& i_unit;
@@ -98,14 +109,23 @@ namespace Acore
     {
         WorldObject const* i_source;
         WorldPacket const* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage;     // built on first delivery, queued by reference for every receiver
+        std::vector<std::shared_ptr<WorldPacket const>> const* i_sharedMessages;   // if set, sent instead of i_message
         uint32 i_phaseMask;
         float i_distSq;
         TeamId teamId;
         Player const* skipped_receiver;
+        uint32 i_delivered;                                     // packets queued, only counted for i_sharedMessages
         MessageDistDeliverer(WorldObject const* src, WorldPacket const* msg, float dist, bool own_team_only = false, Player const* skipped = nullptr)
-            : i_source(src), i_message(msg), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            : i_source(src), i_message(msg), i_sharedMessages(nullptr), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
             , teamId((own_team_only && src->GetTypeId() == TYPEID_PLAYER) ? src->ToPlayer()->GetTeamId() : TEAM_NEUTRAL)
-            , skipped_receiver(skipped)
+            , skipped_receiver(skipped), i_delivered(0)
+        {
+        }
+        // delivers all messages in order with a single grid search
+        MessageDistDeliverer(WorldObject const* src, std::vector<std::shared_ptr<WorldPacket const>> const& msgs, float dist)
+            : i_source(src), i_message(nullptr), i_sharedMessages(&msgs), i_phaseMask(src->GetPhaseMask()), i_distSq(dist * dist)
+            , teamId(TEAM_NEUTRAL), skipped_receiver(nullptr), i_delivered(0)
         {
         }
         void Visit(PlayerMapType& m);
@@ -122,7 +142,19 @@ namespace Acore
             if (!player->HaveAtClient(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            if (i_sharedMessages)
+            {
+                for (std::shared_ptr<WorldPacket const> const& message : *i_sharedMessages)
+                    player->GetSession()->SendPacket(message);
+
+                i_delivered += i_sharedMessages->size();
+                return;
+            }
+
+            if (!i_sharedMessage)
+                i_sharedMessage = WorldSession::MakeSharedPacket(*i_message);
+
+            player->GetSession()->SendPacket(i_sharedMessage);
         }
     };
 
@@ -130,6 +162,7 @@ namespace Acore
     {
         Unit* i_source;
         WorldPacket* i_message;
+        std::shared_ptr<WorldPacket const> i_sharedMessage;
         uint32 i_phaseMask;
         float i_distSq;
         MessageDistDelivererToHostile(Unit* src, WorldPacket* msg, float dist)
@@ -147,7 +180,10 @@ namespace Acore
             if (player == i_source || !player->HaveAtClient(i_source) || player->IsFriendlyTo(i_source))
                 return;
 
-            player->GetSession()->SendPacket(i_message);
+            if (!i_sharedMessage)
+                i_sharedMessage = WorldSession::MakeSharedPacket(*i_message);
+
+            player->GetSession()->SendPacket(i_sharedMessage);
         }
     };
 
@@ -155,7 +191,36 @@ namespace Acore
     {
         uint32 i_timeDiff;
         bool i_largeOnly;
-        explicit ObjectUpdater(const uint32 diff, bool largeOnly) : i_timeDiff(diff), i_largeOnly(largeOnly) {}
+
+        // idle objects (out of combat, not active) are updated every i_idleInterval ticks only, with accumulated diff
+        uint32 i_idleInterval;
+        uint32 i_idleTick;
+        uint32 i_idleTimeDiff;
+        uint32 i_skippedObjects;
+
+        // creatures for which Creature::IsIdleForUpdate() holds are updated every i_idleCreatureInterval ticks only,
+        // even in cells next to players
+        uint32 i_idleCreatureInterval;
+        uint32 i_idleCreatureTimeDiff;
+
+        explicit ObjectUpdater(const uint32 diff, bool largeOnly) : i_timeDiff(diff), i_largeOnly(largeOnly),
+            i_idleInterval(1), i_idleTick(0), i_idleTimeDiff(diff), i_skippedObjects(0),
+            i_idleCreatureInterval(1), i_idleCreatureTimeDiff(diff) {}
+
+        void SetIdleThrottle(uint32 interval, uint32 tick, uint32 accumulatedDiff)
+        {
+            i_idleInterval = std::max<uint32>(interval, 1);
+            i_idleTick = tick;
+            i_idleTimeDiff = accumulatedDiff;
+        }
+
+        void SetIdleCreatureThrottle(uint32 interval, uint32 tick, uint32 accumulatedDiff)
+        {
+            i_idleCreatureInterval = std::max<uint32>(interval, 1);
+            i_idleTick = tick;
+            i_idleCreatureTimeDiff = accumulatedDiff;
+        }
+
         template<class T> void Visit(GridRefMgr<T>& m);
         void Visit(PlayerMapType&) {}
         void Visit(CorpseMapType&) {}
@@ -231,6 +296,36 @@ namespace Acore
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
     };
 
+    // candidate objects of an area search with their positions kept in separate arrays,
+    // so many of them can be range filtered in plain loops before any per object check
+    struct WorldObjectCandidates
+    {
+        std::vector<WorldObject*> Objects;
+        std::vector<float> X, Y, Z;
+        std::vector<float> Size;                            // infinite for objects that need their own range check
+
+        void Add(WorldObject* object);
+        // inRange[i] is false only if Objects[i] is certainly farther than range (+ its size) from center
+        void FilterInRange(Position const* center, float range, std::vector<uint8>& inRange) const;
+    };
+
+    struct WorldObjectCandidateGatherer
+    {
+        uint32 i_mapTypeMask;
+        WorldObjectCandidates& i_candidates;
+
+        WorldObjectCandidateGatherer(WorldObjectCandidates& candidates, uint32 mapTypeMask = GRID_MAP_TYPE_MASK_ALL)
+            : i_mapTypeMask(mapTypeMask), i_candidates(candidates) { }
+
+        void Visit(PlayerMapType& m);
+        void Visit(CreatureMapType& m);
+        void Visit(CorpseMapType& m);
+        void Visit(GameObjectMapType& m);
+        void Visit(DynamicObjectMapType& m);
+
+        template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+    };
+
     template<class Check>
     struct WorldObjectListSearcher : ContainerInserter<WorldObject*>
     {
@@ -28,6 +28,7 @@
 #include "UpdateData.h"
 #include "WorldPacket.h"
 #include "WorldSession.h"
+#include <type_traits>
 
 template<class T>
 inline void Acore::VisibleNotifier::Visit(GridRefMgr<T>& m)
@@ -41,8 +42,13 @@ inline void Acore::VisibleNotifier::Visit(GridRefMgr<T>& m)
         if (i_largeOnly != iter->GetSource()->IsVisibilityOverridden())
             continue;
 
-        vis_guids.erase(iter->GetSource()->GetGUID());
-        i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
+        bool const atClient = vis_guids.erase(iter->GetSource()->GetGUID());
+        if (!IsVisibilityUnchanged(iter->GetSource(), atClient))
+            i_player.UpdateVisibilityOf(iter->GetSource(), i_data, i_visibleNow);
+
+        if constexpr (std::is_same_v<T, Player>)
+            if (i_player.HaveAtClient(iter->GetSource()))
+                ++i_visiblePlayers;
     }
 }
 
@@ -185,29 +185,35 @@ void ObjectGridLoader::LoadN(void)
     i_gameObjects = 0;
     i_creatures = 0;
     i_corpses = 0;
-    i_cell.data.Part.cell_y = 0;
     for (uint32 x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
-    {
-        i_cell.data.Part.cell_x = x;
         for (uint32 y = 0; y < MAX_NUMBER_OF_CELLS; ++y)
-        {
-            i_cell.data.Part.cell_y = y;
+            LoadCell(x, y);
 
-            //Load creatures and game objects
-            {
-                TypeContainerVisitor<ObjectGridLoader, GridTypeMapContainer> visitor(*this);
-                i_grid.VisitGrid(x, y, visitor);
-            }
+    LOG_DEBUG("maps", "{} GameObjects, {} Creatures, and {} Corpses/Bones loaded for grid {} on map {}", i_gameObjects, i_creatures, i_corpses, i_grid.GetGridId(), i_map->GetId());
+}
 
-            //Load corpses (not bones)
-            {
-                ObjectWorldLoader worker(*this);
-                TypeContainerVisitor<ObjectWorldLoader, WorldTypeMapContainer> visitor(worker);
-                i_grid.VisitGrid(x, y, visitor);
-            }
-        }
+void ObjectGridLoader::LoadCell(uint32 x, uint32 y)
+{
+    if (i_grid.isCellObjectDataLoaded(x, y))
+        return;
+
+    i_grid.setCellObjectDataLoaded(x, y);
+
+    i_cell.data.Part.cell_x = x;
+    i_cell.data.Part.cell_y = y;
+
+    //Load creatures and game objects
+    {
+        TypeContainerVisitor<ObjectGridLoader, GridTypeMapContainer> visitor(*this);
+        i_grid.VisitGrid(x, y, visitor);
+    }
+
+    //Load corpses (not bones)
+    {
+        ObjectWorldLoader worker(*this);
+        TypeContainerVisitor<ObjectWorldLoader, WorldTypeMapContainer> visitor(worker);
+        i_grid.VisitGrid(x, y, visitor);
     }
-    LOG_DEBUG("maps", "{} GameObjects, {} Creatures, and {} Corpses/Bones loaded for grid {} on map {}", i_gameObjects, i_creatures, i_corpses, i_grid.GetGridId(), i_map->GetId());
 }
 
 template<class T>
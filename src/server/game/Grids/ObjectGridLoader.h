@@ -41,6 +41,8 @@ public:
     void Visit(DynamicObjectMapType&) const {}
 
     void LoadN(void);
+    // loads a single cell of the grid, nothing if it was loaded before
+    void LoadCell(uint32 x, uint32 y);
 
     template<class T> static void SetObjectCell(T* obj, CellCoord const& cellCoord);
 
@@ -1711,19 +1711,31 @@ void Group::UpdatePlayerOutOfRange(Player* player)
     if (!player || !player->IsInWorld())
         return;
 
-    WorldPacket data;
-    player->GetSession()->BuildPartyMemberStatsChangedPacket(player, &data);
+    // built for the first member out of range only, members in range see the changes through object updates
+    std::shared_ptr<WorldPacket const> sharedData;
 
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* member = itr->GetSource();
         if (member && (!member->IsInMap(player) || !member->IsWithinDist(player, member->GetSightRange(player), false)))
-            member->GetSession()->SendPacket(&data);
+        {
+            if (!sharedData)
+            {
+                WorldPacket data;
+                player->GetSession()->BuildPartyMemberStatsChangedPacket(player, &data);
+                sharedData = WorldSession::MakeSharedPacket(data);
+            }
+
+            member->GetSession()->SendPacket(sharedData);
+        }
     }
 }
 
 void Group::BroadcastPacket(WorldPacket const* packet, bool ignorePlayersInBGRaid, int group, ObjectGuid ignore)
 {
+    // every member queues the same buffer instead of a copy of the packet
+    std::shared_ptr<WorldPacket const> sharedPacket;
+
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         Player* player = itr->GetSource();
@@ -1731,7 +1743,12 @@ void Group::BroadcastPacket(WorldPacket const* packet, bool ignorePlayersInBGRai
             continue;
 
         if (group == -1 || itr->getSubGroup() == group)
-            player->GetSession()->SendPacket(packet);
+        {
+            if (!sharedPacket)
+                sharedPacket = WorldSession::MakeSharedPacket(*packet);
+
+            player->GetSession()->SendPacket(sharedPacket);
+        }
     }
 }
 
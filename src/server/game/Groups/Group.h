@@ -119,6 +119,8 @@ enum GroupUpdateFlags
     GROUP_UPDATE_FLAG_VEHICLE_SEAT      = 0x00080000,       // uint32 vehicle_seat_id (index from VehicleSeat.dbc)
     GROUP_UPDATE_PET                    = 0x0007FC00,       // all pet flags
     GROUP_UPDATE_FULL                   = 0x0007FFFF,       // all known flags
+    GROUP_UPDATE_THROTTLED              = GROUP_UPDATE_FLAG_CUR_POWER | GROUP_UPDATE_FLAG_POSITION | GROUP_UPDATE_FLAG_AURAS |
+                                          GROUP_UPDATE_FLAG_PET_CUR_POWER | GROUP_UPDATE_FLAG_PET_AURAS, // may wait for Group.OutOfRangeUpdate.Interval in large raids
 };
 
 enum lfgGroupFlags
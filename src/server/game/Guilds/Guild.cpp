@@ -39,6 +39,7 @@
 
 #define MAX_GUILD_BANK_TAB_TEXT_LEN 500
 #define EMBLEM_PRICE 10 * GOLD
+#define GUILD_ROSTER_CACHE_TIME 60                         // seconds
 
 std::string _GetGuildEventString(GuildEvents event)
 {
@@ -178,13 +179,9 @@ Guild::LogEntry::LogEntry(uint32 guildId, ObjectGuid::LowType guid) :
 // EventLogEntry
 void Guild::EventLogEntry::SaveToDB(CharacterDatabaseTransaction trans) const
 {
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_EVENTLOG);
-    stmt->SetData(0, m_guildId);
-    stmt->SetData(1, m_guid);
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
-
+    // log guids cycle through the max record count, the new entry replaces the oldest row
     uint8 index = 0;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_EVENTLOG);
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GUILD_EVENTLOG);
     stmt->SetData(  index, m_guildId);
     stmt->SetData(++index, m_guid);
     stmt->SetData (++index, uint8(m_eventType));
@@ -213,15 +210,7 @@ void Guild::EventLogEntry::WritePacket(WorldPackets::Guild::GuildEventLogQueryRe
 void Guild::BankEventLogEntry::SaveToDB(CharacterDatabaseTransaction trans) const
 {
     uint8 index = 0;
-
-    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GUILD_BANK_EVENTLOG);
-    stmt->SetData(  index, m_guildId);
-    stmt->SetData(++index, m_guid);
-    stmt->SetData (++index, m_bankTabId);
-    CharacterDatabase.ExecuteOrAppend(trans, stmt);
-
-    index = 0;
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_INS_GUILD_BANK_EVENTLOG);
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GUILD_BANK_EVENTLOG);
     stmt->SetData(  index, m_guildId);
     stmt->SetData(++index, m_guid);
     stmt->SetData (++index, m_bankTabId);
@@ -1035,7 +1024,8 @@ Guild::Guild():
     m_id(0),
     m_createdDate(0),
     m_accountsNumber(0),
-    m_bankMoney(0)
+    m_bankMoney(0),
+    m_rosterExpireTime(0)
 {
 }
 
@@ -1171,7 +1161,8 @@ void Guild::UpdateMemberData(Player* player, uint8 dataid, uint32 value)
                 LOG_ERROR("guild", "Guild::UpdateMemberData: Called with incorrect DATAID {} (value {})", dataid, value);
                 return;
         }
-        //HandleRoster();
+
+        _InvalidateRoster();
     }
 }
 
@@ -1182,6 +1173,8 @@ void Guild::OnPlayerStatusChange(Player* player, uint32 flag, bool state)
         if (state)
             member->AddFlag(flag);
         else member->RemFlag(flag);
+
+        _InvalidateRoster();
     }
 }
 
@@ -1201,6 +1194,26 @@ bool Guild::SetName(std::string_view const& name)
 }
 
 void Guild::HandleRoster(WorldSession* session)
+{
+    // the days since the last logout of offline members go stale, so the cache is rebuilt now and then anyway
+    time_t now = GameTime::GetGameTime().count();
+    if (now >= m_rosterExpireTime)
+    {
+        _InvalidateRoster();
+        m_rosterExpireTime = now + GUILD_ROSTER_CACHE_TIME;
+    }
+
+    // members allowed to view officer notes get their own copy of the roster
+    bool sendOfficerNote = _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE);
+    std::shared_ptr<WorldPacket const>& rosterPacket = m_rosterPackets[sendOfficerNote ? 1 : 0];
+    if (!rosterPacket)
+        rosterPacket = _BuildRosterPacket(sendOfficerNote);
+
+    LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [{}]", session->GetPlayerInfo());
+    session->SendPacket(rosterPacket);
+}
+
+std::shared_ptr<WorldPacket const> Guild::_BuildRosterPacket(bool sendOfficerNote) const
 {
     WorldPackets::Guild::GuildRoster roster;
 
@@ -1218,7 +1231,6 @@ void Guild::HandleRoster(WorldSession* session)
         }
     }
 
-    bool sendOfficerNote = _HasRankRight(session->GetPlayer(), GR_RIGHT_VIEWOFFNOTE);
     roster.MemberData.reserve(m_members.size());
     for (auto const& [guid, member] : m_members)
     {
@@ -1243,8 +1255,7 @@ void Guild::HandleRoster(WorldSession* session)
     roster.WelcomeText = m_motd;
     roster.InfoText = m_info;
 
-    LOG_DEBUG("guild", "SMSG_GUILD_ROSTER [{}]", session->GetPlayerInfo());
-    session->SendPacket(roster.Write());
+    return WorldSession::MakeSharedPacket(*roster.Write());
 }
 
 void Guild::HandleQuery(WorldSession* session)
@@ -1280,6 +1291,7 @@ void Guild::HandleSetMOTD(WorldSession* session, std::string_view motd)
     else
     {
         m_motd = motd;
+        _InvalidateRoster();
 
         sScriptMgr->OnGuildMOTDChanged(this, m_motd);
 
@@ -1301,6 +1313,7 @@ void Guild::HandleSetInfo(WorldSession* session, std::string_view info)
     if (_HasRankRight(session->GetPlayer(), GR_RIGHT_MODIFY_GUILD_INFO))
     {
         m_info = info;
+        _InvalidateRoster();
 
         sScriptMgr->OnGuildInfoChanged(this, m_info);
 
@@ -1345,6 +1358,7 @@ void Guild::HandleSetLeader(WorldSession* session, std::string_view name)
         {
             _SetLeaderGUID(*pNewLeader);
             pOldLeader->ChangeRank(GR_OFFICER);
+            _InvalidateRoster();
             _BroadcastEvent(GE_LEADER_CHANGED, ObjectGuid::Empty, player->GetName(), pNewLeader->GetName());
         }
     }
@@ -1376,6 +1390,7 @@ void Guild::HandleSetMemberNote(WorldSession* session, std::string_view name, st
         else
             member->SetOfficerNote(note);
 
+        _InvalidateRoster();
         HandleRoster(session);
     }
 }
@@ -1389,6 +1404,7 @@ void Guild::HandleSetRankInfo(WorldSession* session, uint8 rankId, std::string_v
     {
         rankInfo->SetName(name);
         rankInfo->SetRights(rights);
+        _InvalidateRoster();
         _SetRankBankMoneyPerDay(rankId, moneyPerDay);
 
         for (auto& rightsAndSlot : rightsAndSlots)
@@ -1613,6 +1629,7 @@ void Guild::HandleUpdateMemberRank(WorldSession* session, std::string_view name,
 
         uint32 newRankId = member->GetRankId() + (demote ? 1 : -1);
         member->ChangeRank(newRankId);
+        _InvalidateRoster();
         _LogEvent(demote ? GUILD_EVENT_LOG_DEMOTE_PLAYER : GUILD_EVENT_LOG_PROMOTE_PLAYER, player->GetGUID(), member->GetGUID(), newRankId);
         _BroadcastEvent(demote ? GE_DEMOTION : GE_PROMOTION, ObjectGuid::Empty, player->GetName(), member->GetName(), _GetRankName(newRankId));
     }
@@ -1654,6 +1671,7 @@ void Guild::HandleRemoveRank(WorldSession* session, uint8 rankId)
 
     // match what the sql statement does
     m_ranks.erase(m_ranks.begin() + rankId, m_ranks.end());
+    _InvalidateRoster();
 
     _BroadcastEvent(GE_RANK_DELETED, ObjectGuid::Empty, std::to_string(m_ranks.size()));
 }
@@ -1744,6 +1762,7 @@ void Guild::HandleMemberLogout(WorldSession* session)
         member->SetStats(player);
         member->UpdateLogoutTime();
         member->ResetFlags();
+        _InvalidateRoster();
     }
     _BroadcastEvent(GE_SIGNED_OFF, player->GetGUID(), player->GetName());
 }
@@ -1774,7 +1793,7 @@ void Guild::SendInfo(WorldSession* session) const
 
 void Guild::SendEventLog(WorldSession* session) const
 {
-    std::list<EventLogEntry> const& eventLog = m_eventLog.GetGuildLog();
+    std::deque<EventLogEntry> const& eventLog = m_eventLog.GetGuildLog();
 
     WorldPackets::Guild::GuildEventLogQueryResults packet;
     packet.Entry.reserve(eventLog.size());
@@ -1791,7 +1810,7 @@ void Guild::SendBankLog(WorldSession* session, uint8 tabId) const
     // GUILD_BANK_MAX_TABS send by client for money log
     if (tabId < _GetPurchasedTabsSize() || tabId == GUILD_BANK_MAX_TABS)
     {
-        std::list<BankEventLogEntry> const& bankEventLog = m_bankEventLog[tabId].GetGuildLog();
+        std::deque<BankEventLogEntry> const& bankEventLog = m_bankEventLog[tabId].GetGuildLog();
 
         WorldPackets::Guild::GuildBankLogQueryResults packet;
         packet.Tab = tabId;
@@ -1890,6 +1909,7 @@ void Guild::SendLoginInfo(WorldSession* session)
     {
         member->SetStats(player);
         member->AddFlag(GUILDMEMBER_STATUS_ONLINE);
+        _InvalidateRoster();
     }
 }
 
@@ -2243,6 +2263,7 @@ bool Guild::AddMember(ObjectGuid guid, uint8 rankId)
     CharacterDatabaseTransaction trans(nullptr);
     member.SaveToDB(trans);
 
+    _InvalidateRoster();
     _UpdateAccountsNumber();
     _LogEvent(GUILD_EVENT_LOG_JOIN_GUILD, guid);
     _BroadcastEvent(GE_JOINED, guid, name);
@@ -2297,6 +2318,7 @@ void Guild::DeleteMember(ObjectGuid guid, bool isDisbanding, bool isKicked, bool
     sScriptMgr->OnGuildRemoveMember(this, player, isDisbanding, isKicked);
 
     m_members.erase(lowguid);
+    _InvalidateRoster();
 
     // If player not online data in data field will be loaded from guild tabs no need to update it !!
     if (player)
@@ -2320,6 +2342,7 @@ bool Guild::ChangeMemberRank(ObjectGuid guid, uint8 newRank)
         if (Member* member = GetMember(guid))
         {
             member->ChangeRank(newRank);
+            _InvalidateRoster();
 
             if (newRank == GR_GUILDMASTER)
             {
@@ -2395,6 +2418,7 @@ void Guild::_CreateNewBankTab()
     ++tabId;
     for (auto& m_rank : m_ranks)
         m_rank.CreateMissingTabsIfNeeded(tabId, trans, false);
+    _InvalidateRoster();
 
     CharacterDatabase.CommitTransaction(trans);
 }
@@ -2425,6 +2449,7 @@ bool Guild::_CreateRank(std::string_view name, uint32 rights)
     // Ranks represent sequence 0, 1, 2, ... where 0 means guildmaster
     RankInfo info(m_id, newRankId, name, rights, 0);
     m_ranks.push_back(info);
+    _InvalidateRoster();
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
     info.CreateMissingTabsIfNeeded(_GetPurchasedTabsSize(), trans);
@@ -2490,6 +2515,7 @@ void Guild::_SetLeaderGUID(Member& pLeader)
 {
     m_leaderGuid = pLeader.GetGUID();
     pLeader.ChangeRank(GR_GUILDMASTER);
+    _InvalidateRoster();
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GUILD_LEADER);
     stmt->SetData(0, m_leaderGuid.GetCounter());
@@ -2500,7 +2526,10 @@ void Guild::_SetLeaderGUID(Member& pLeader)
 void Guild::_SetRankBankMoneyPerDay(uint8 rankId, uint32 moneyPerDay)
 {
     if (RankInfo* rankInfo = GetRankInfo(rankId))
+    {
         rankInfo->SetBankMoneyPerDay(moneyPerDay);
+        _InvalidateRoster();
+    }
 }
 
 void Guild::_SetRankBankTabRightsAndSlots(uint8 rankId, GuildBankRightsAndSlots rightsAndSlots, bool saveToDB)
@@ -2509,7 +2538,10 @@ void Guild::_SetRankBankTabRightsAndSlots(uint8 rankId, GuildBankRightsAndSlots
         return;
 
     if (RankInfo* rankInfo = GetRankInfo(rankId))
+    {
         rankInfo->SetBankTabSlotsAndRights(rightsAndSlots, saveToDB);
+        _InvalidateRoster();
+    }
 }
 
 inline std::string Guild::_GetRankName(uint8 rankId) const
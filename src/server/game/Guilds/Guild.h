@@ -24,6 +24,7 @@
 #include "Player.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <deque>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -498,12 +499,13 @@ private:
         template <typename... Ts>
         void AddEvent(CharacterDatabaseTransaction trans, Ts&&... args);
         uint32 GetNextGUID();
-        std::list<Entry>& GetGuildLog() { return m_log; }
-        std::list<Entry> const& GetGuildLog() const { return m_log; }
+        std::deque<Entry>& GetGuildLog() { return m_log; }
+        std::deque<Entry> const& GetGuildLog() const { return m_log; }
 
     private:
         uint32 m_guildId;
-        std::list<Entry> m_log;
+        // oldest first, a full holder drops its front for every added entry
+        std::deque<Entry> m_log;
         uint32 const m_maxRecords;
         uint32 m_nextGUID;
     };
@@ -802,6 +804,10 @@ protected:
     LogHolder<EventLogEntry> m_eventLog;
     std::array<LogHolder<BankEventLogEntry>, GUILD_BANK_MAX_TABS + 1> m_bankEventLog = {};
 
+    // serialized SMSG_GUILD_ROSTER without and with officer notes, shared by all members asking for it
+    std::array<std::shared_ptr<WorldPacket const>, 2> m_rosterPackets;
+    time_t m_rosterExpireTime;
+
 private:
     inline uint8 _GetRanksSize() const { return uint8(m_ranks.size()); }
     inline const RankInfo* GetRankInfo(uint8 rankId) const { return rankId < _GetRanksSize() ? &m_ranks[rankId] : nullptr; }
@@ -816,6 +822,10 @@ private:
 
     inline uint8 _GetLowestRankId() const { return uint8(m_ranks.size() - 1); }
 
+    // called on every change of the members, ranks, MOTD or info shown in the roster
+    void _InvalidateRoster() { m_rosterPackets = {}; }
+    std::shared_ptr<WorldPacket const> _BuildRosterPacket(bool sendOfficerNote) const;
+
     inline uint8 _GetPurchasedTabsSize() const { return uint8(m_bankTabs.size()); }
     inline BankTab* GetBankTab(uint8 tabId) { return tabId < m_bankTabs.size() ? &m_bankTabs[tabId] : nullptr; }
     inline BankTab const* GetBankTab(uint8 tabId) const { return tabId < m_bankTabs.size() ? &m_bankTabs[tabId] : nullptr; }
@@ -129,10 +129,6 @@ bool LoginQueryHolder::Initialize()
     stmt->SetData(1, uint32(GameTime::GetGameTime().count()));
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAILS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
-    stmt->SetData(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS, stmt);
-
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_SOCIALLIST);
     stmt->SetData(0, lowGuid);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_SOCIAL_LIST, stmt);
@@ -781,19 +777,56 @@ void WorldSession::HandlePlayerLoginOpcode(WorldPacket& recvData)
         return;
     }
 
-    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder)).AfterComplete([this](SQLQueryHolderBase const& holder)
+    // don't load the character before a save queued by a previous logout was sent
+    holder->SetOrderingKey(GetAccountId());
+
+    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder)).AfterComplete([this, holder](SQLQueryHolderBase const& /*result*/)
     {
-        HandlePlayerLoginFromDB(static_cast<LoginQueryHolder const&>(holder));
+        // the characters are added to the world at a limited rate, the rest waits in ProcessPendingPlayerLogin()
+        _pendingLoginHolder = holder;
+        ProcessPendingPlayerLogin();
     });
 }
 
-void WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder const& holder)
+void WorldSession::ProcessPendingPlayerLogin()
+{
+    if (!_pendingLoginHolder)
+        return;
+
+    std::chrono::steady_clock::time_point const start = std::chrono::steady_clock::now();
+
+    // the character was loaded by a previous update. A closed connection doesn't wait for the budget,
+    // the session is removed right after and must not take a character that isn't on its map with it
+    if (_pendingLoginPlayer)
+    {
+        if (!IsSocketClosed() && !sWorld->CanFinishPlayerLogin())
+            return;
+
+        Player* pCurrChar = std::exchange(_pendingLoginPlayer, nullptr);
+        std::shared_ptr<LoginQueryHolder> holder = std::move(_pendingLoginHolder);
+        HandlePlayerLoginToWorld(pCurrChar, *holder);
+    }
+    else
+    {
+        if (!sWorld->TryStartPlayerLogin())
+            return;
+
+        _pendingLoginPlayer = HandlePlayerLoginFromDB(*_pendingLoginHolder);
+        if (!_pendingLoginPlayer)
+            _pendingLoginHolder.reset();
+    }
+
+    sWorld->AddPlayerLoginTime(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - start));
+}
+
+/// First login stage: creates the character from the query results, nullptr if it can't be loaded
+Player* WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder const& holder)
 {
+    METRIC_TIMER("player_login_time", METRIC_TAG("stage", "Load"));
+
     ObjectGuid playerGuid = holder.GetGuid();
 
     Player* pCurrChar = new Player(this);
-    // for send server info and strings (config)
-    ChatHandler chH = ChatHandler(pCurrChar->GetSession());
 
     // "GetAccountId() == db stored account id" checked in LoadFromDB (prevent login not own character using cheating tools)
     if (!pCurrChar->LoadFromDB(playerGuid, holder))
@@ -802,10 +835,21 @@ void WorldSession::HandlePlayerLoginFromDB(LoginQueryHolder const& holder)
         KickPlayer("WorldSession::HandlePlayerLogin Player::LoadFromDB failed"); // disconnect client, player no set to session and it will not deleted or saved at kick
         delete pCurrChar; // delete it manually
         m_playerLoading = false;
-        return;
+        return nullptr;
     }
 
     pCurrChar->GetMotionMaster()->Initialize();
+    return pCurrChar;
+}
+
+/// Second login stage, one update after the first: sends the login packets and adds the character to its map
+void WorldSession::HandlePlayerLoginToWorld(Player* pCurrChar, LoginQueryHolder const& holder)
+{
+    METRIC_TIMER("player_login_time", METRIC_TAG("stage", "AddToWorld"));
+
+    // for send server info and strings (config)
+    ChatHandler chH = ChatHandler(pCurrChar->GetSession());
+
     pCurrChar->SendDungeonDifficulty(false);
 
     WorldPacket data(SMSG_LOGIN_VERIFY_WORLD, 20);
@@ -56,6 +56,7 @@ bool WorldSession::CanOpenMailBox(ObjectGuid guid)
     else
         return false;
 
+    _player->LoadMailedItems();
     return true;
 }
 
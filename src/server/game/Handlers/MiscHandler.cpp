@@ -284,20 +284,20 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
     data << uint32(matchCount);         // placeholder, count of players matching criteria
     data << uint32(displaycount);       // placeholder, count of players displayed
 
-    for (auto const& target : sWhoListCacheMgr->GetWhoList())
+    auto processTarget = [&](WhoListPlayerInfo const& target)
     {
         if (AccountMgr::IsPlayerAccount(security))
         {
             // player can see member of other team only if CONFIG_ALLOW_TWO_SIDE_WHO_LIST
             if (target.GetTeamId() != team && !allowTwoSideWhoList)
             {
-                continue;
+                return;
             }
 
             // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if CONFIG_GM_IN_WHO_LIST
             if (target.GetSecurity() > AccountTypes(gmLevelInWhoList))
             {
-                continue;
+                return;
             }
         }
 
@@ -305,28 +305,28 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
         if ((_player->GetGUID() != target.GetGuid() && !target.IsVisible()) &&
             (AccountMgr::IsPlayerAccount(_player->GetSession()->GetSecurity()) || target.GetSecurity() > _player->GetSession()->GetSecurity()))
         {
-            continue;
+            return;
         }
 
         // check if target's level is in level range
         uint8 lvl = target.GetLevel();
         if (lvl < levelMin || lvl > levelMax)
         {
-            continue;
+            return;
         }
 
         // check if class matches classmask
         uint8 class_ = target.GetClass();
         if (!(classmask & (1 << class_)))
         {
-            continue;
+            return;
         }
 
         // check if race matches racemask
         uint32 race = target.GetRace();
         if (!(racemask & (1 << race)))
         {
-            continue;
+            return;
         }
 
         uint32 playerZoneId = target.GetZoneId();
@@ -346,26 +346,22 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
 
         if (!showZones)
         {
-            continue;
+            return;
         }
 
         std::wstring const& wideplayername = target.GetWidePlayerName();
         if (!(wpacketPlayerName.empty() || wideplayername.find(wpacketPlayerName) != std::wstring::npos))
         {
-            continue;
+            return;
         }
 
         std::wstring const& wideguildname = target.GetWideGuildName();
         if (!(wpacketGuildName.empty() || wideguildname.find(wpacketGuildName) != std::wstring::npos))
         {
-            continue;
+            return;
         }
 
-        std::string aname;
-        if (AreaTableEntry const* areaEntry = sAreaTableStore.LookupEntry(playerZoneId))
-        {
-            aname = areaEntry->area_name[GetSessionDbcLocale()];
-        }
+        std::wstring const& wideareaname = sWhoListCacheMgr->GetWideAreaName(playerZoneId, GetSessionDbcLocale());
 
         bool s_show = true;
         for (uint32 i = 0; i < strCount; ++i)
@@ -374,7 +370,7 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
             {
                 if (wideguildname.find(str[i]) != std::wstring::npos ||
                     wideplayername.find(str[i]) != std::wstring::npos ||
-                    Utf8FitTo(aname, str[i]))
+                    wideareaname.find(str[i]) != std::wstring::npos)
                 {
                     s_show = true;
                     break;
@@ -386,14 +382,14 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
 
         if (!s_show)
         {
-            continue;
+            return;
         }
 
         // 49 is maximum player count sent to client - can be overridden
         // through config, but is unstable
         if ((matchCount++) >= sWorld->getIntConfig(CONFIG_MAX_WHO_LIST_RETURN))
         {
-            continue;
+            return;
         }
 
         data << target.GetPlayerName();                   // player name
@@ -405,6 +401,27 @@ void WorldSession::HandleWhoOpcode(WorldPacket& recvData)
         data << uint32(playerZoneId);                     // player zone id
 
         ++displaycount;
+    };
+
+    // the who list is indexed by zone and ordered by level, only walk the entries the request can match
+    if (zonesCount)
+    {
+        WhoListInfoVector const& whoList = sWhoListCacheMgr->GetWhoList();
+        for (uint32 i = 0; i < zonesCount; ++i)
+        {
+            if (std::find(zoneids.begin(), zoneids.begin() + i, zoneids[i]) != zoneids.begin() + i)
+                continue;
+
+            if (std::vector<std::size_t> const* zonePlayers = sWhoListCacheMgr->GetWhoListByZone(zoneids[i]))
+                for (std::size_t index : *zonePlayers)
+                    processTarget(whoList[index]);
+        }
+    }
+    else
+    {
+        auto [begin, end] = sWhoListCacheMgr->GetWhoListByLevel(levelMin, levelMax);
+        for (auto itr = begin; itr != end; ++itr)
+            processTarget(*itr);
     }
 
     data.put(0, displaycount);                            // insert right count, count displayed
@@ -19,6 +19,7 @@
 #define __NPCHANDLER_H
 
 #include "Define.h"
+#include "LocalizedQueryData.h"
 #include <vector>
 
 struct QEmote
@@ -44,18 +45,22 @@ struct GossipTextOption
 struct GossipText
 {
     GossipTextOption Options[MAX_GOSSIP_TEXT_OPTIONS];
+    LocalizedQueryData QueryData;           // SMSG_NPC_TEXT_UPDATE, built by ObjectMgr::InitializeQueriesData
+
+    [[nodiscard]] WorldPacket BuildQueryData(uint32 textId, LocaleConstant locale) const;
+    void InitializeQueryData(uint32 textId);
 };
 
 struct PageTextLocale
 {
-    std::vector<std::string> Text;
+    LocaleStrings Text;
 };
 
 struct NpcTextLocale
 {
     NpcTextLocale() { Text_0.resize(8); Text_1.resize(8); }
 
-    std::vector<std::vector<std::string>> Text_0;
-    std::vector<std::vector<std::string>> Text_1;
+    std::vector<LocaleStrings> Text_0;
+    std::vector<LocaleStrings> Text_1;
 };
 #endif
@@ -168,6 +168,45 @@ void WorldSession::HandleCreatureQueryOpcode(WorldPacket& recvData)
     }
 }
 
+WorldPacket GameObjectTemplate::BuildQueryData(LocaleConstant locale) const
+{
+    std::string Name = name;
+    std::string CastBarCaption = castBarCaption;
+
+    if (GameObjectLocale const* gameObjectLocale = sObjectMgr->GetGameObjectLocale(entry))
+    {
+        ObjectMgr::GetLocaleString(gameObjectLocale->Name, locale, Name);
+        ObjectMgr::GetLocaleString(gameObjectLocale->CastBarCaption, locale, CastBarCaption);
+    }
+
+    WorldPacket data(SMSG_GAMEOBJECT_QUERY_RESPONSE, 150);
+    data << uint32(entry);
+    data << uint32(type);
+    data << uint32(displayId);
+    data << Name;
+    data << uint8(0) << uint8(0) << uint8(0);           // name2, name3, name4
+    data << IconName;                                   // 2.0.3, string. Icon name to use instead of default icon for go's (ex: "Attack" makes sword)
+    data << CastBarCaption;                             // 2.0.3, string. Text will appear in Cast Bar when using GO (ex: "Collecting")
+    data << unk1;                                       // 2.0.3, string
+    data.append(raw.data, MAX_GAMEOBJECT_DATA);
+    data << float(size);                                // go size
+
+    GameObjectQuestItemList const* items = sObjectMgr->GetGameObjectQuestItemList(entry);
+    if (items)
+        for (size_t i = 0; i < MAX_GAMEOBJECT_QUEST_ITEMS; ++i)
+            data << (i < items->size() ? uint32((*items)[i]) : uint32(0));
+    else
+        for (size_t i = 0; i < MAX_GAMEOBJECT_QUEST_ITEMS; ++i)
+            data << uint32(0);
+
+    return data;
+}
+
+void GameObjectTemplate::InitializeQueryData()
+{
+    QueryData.Initialize(sObjectMgr->GetGameObjectLocale(entry) != nullptr, [this](LocaleConstant locale) { return BuildQueryData(locale); });
+}
+
 /// Only _static_ data is sent in this packet !!!
 void WorldSession::HandleGameObjectQueryOpcode(WorldPacket& recvData)
 {
@@ -179,44 +218,16 @@ void WorldSession::HandleGameObjectQueryOpcode(WorldPacket& recvData)
     const GameObjectTemplate* info = sObjectMgr->GetGameObjectTemplate(entry);
     if (info)
     {
-        std::string Name;
-        std::string IconName;
-        std::string CastBarCaption;
-
-        Name = info->name;
-        IconName = info->IconName;
-        CastBarCaption = info->castBarCaption;
-
-        LocaleConstant localeConstant = GetSessionDbLocaleIndex();
-        if (localeConstant >= LOCALE_enUS)
-            if (GameObjectLocale const* gameObjectLocale = sObjectMgr->GetGameObjectLocale(entry))
-            {
-                ObjectMgr::GetLocaleString(gameObjectLocale->Name, localeConstant, Name);
-                ObjectMgr::GetLocaleString(gameObjectLocale->CastBarCaption, localeConstant, CastBarCaption);
-            }
-
         LOG_DEBUG("network", "WORLD: CMSG_GAMEOBJECT_QUERY '{}' - Entry: {}. ", info->name, entry);
-        WorldPacket data (SMSG_GAMEOBJECT_QUERY_RESPONSE, 150);
-        data << uint32(entry);
-        data << uint32(info->type);
-        data << uint32(info->displayId);
-        data << Name;
-        data << uint8(0) << uint8(0) << uint8(0);           // name2, name3, name4
-        data << IconName;                                   // 2.0.3, string. Icon name to use instead of default icon for go's (ex: "Attack" makes sword)
-        data << CastBarCaption;                             // 2.0.3, string. Text will appear in Cast Bar when using GO (ex: "Collecting")
-        data << info->unk1;                                 // 2.0.3, string
-        data.append(info->raw.data, MAX_GAMEOBJECT_DATA);
-        data << float(info->size);                          // go size
-
-        GameObjectQuestItemList const* items = sObjectMgr->GetGameObjectQuestItemList(entry);
-        if (items)
-            for (size_t i = 0; i < MAX_GAMEOBJECT_QUEST_ITEMS; ++i)
-                data << (i < items->size() ? uint32((*items)[i]) : uint32(0));
+
+        if (WorldPacket const* data = info->QueryData.Get(GetSessionDbLocaleIndex()))
+            SendPacket(data);
         else
-            for (size_t i = 0; i < MAX_GAMEOBJECT_QUEST_ITEMS; ++i)
-                data << uint32(0);
+        {
+            WorldPacket packet = info->BuildQueryData(GetSessionDbLocaleIndex());
+            SendPacket(&packet);
+        }
 
-        SendPacket(&data);
         LOG_DEBUG("network", "WORLD: Sent SMSG_GAMEOBJECT_QUERY_RESPONSE");
     }
     else
@@ -277,6 +288,70 @@ void WorldSession::HandleCorpseQueryOpcode(WorldPacket& /*recvData*/)
     SendPacket(&data);
 }
 
+WorldPacket GossipText::BuildQueryData(uint32 textId, LocaleConstant locale) const
+{
+    WorldPacket data(SMSG_NPC_TEXT_UPDATE, 100);          // guess size
+    data << textId;
+
+    std::string text0[MAX_GOSSIP_TEXT_OPTIONS], text1[MAX_GOSSIP_TEXT_OPTIONS];
+
+    for (uint8 i = 0; i < MAX_GOSSIP_TEXT_OPTIONS; ++i)
+    {
+        BroadcastText const* bct = sObjectMgr->GetBroadcastText(Options[i].BroadcastTextID);
+        if (bct)
+        {
+            text0[i] = bct->GetText(locale, GENDER_MALE, true);
+            text1[i] = bct->GetText(locale, GENDER_FEMALE, true);
+        }
+        else
+        {
+            text0[i] = Options[i].Text_0;
+            text1[i] = Options[i].Text_1;
+        }
+
+        if (locale != DEFAULT_LOCALE && !bct)
+        {
+            if (NpcTextLocale const* npcTextLocale = sObjectMgr->GetNpcTextLocale(textId))
+            {
+                ObjectMgr::GetLocaleString(npcTextLocale->Text_0[i], locale, text0[i]);
+                ObjectMgr::GetLocaleString(npcTextLocale->Text_1[i], locale, text1[i]);
+            }
+        }
+
+        data << Options[i].Probability;
+
+        if (text0[i].empty())
+            data << text1[i];
+        else
+            data << text0[i];
+
+        if (text1[i].empty())
+            data << text0[i];
+        else
+            data << text1[i];
+
+        data << Options[i].Language;
+
+        for (uint8 j = 0; j < MAX_GOSSIP_TEXT_EMOTES; ++j)
+        {
+            data << Options[i].Emotes[j]._Delay;
+            data << Options[i].Emotes[j]._Emote;
+        }
+    }
+
+    return data;
+}
+
+void GossipText::InitializeQueryData(uint32 textId)
+{
+    // broadcast texts carry their own locales
+    bool localized = sObjectMgr->GetNpcTextLocale(textId) != nullptr;
+    for (uint8 i = 0; i < MAX_GOSSIP_TEXT_OPTIONS && !localized; ++i)
+        localized = Options[i].BroadcastTextID && sObjectMgr->GetBroadcastText(Options[i].BroadcastTextID);
+
+    QueryData.Initialize(localized, [this, textId](LocaleConstant locale) { return BuildQueryData(textId, locale); });
+}
+
 void WorldSession::HandleNpcTextQueryOpcode(WorldPacket& recvData)
 {
     uint32 textID;
@@ -288,12 +363,11 @@ void WorldSession::HandleNpcTextQueryOpcode(WorldPacket& recvData)
     recvData >> guid;
 
     GossipText const* gossip = sObjectMgr->GetGossipText(textID);
-
-    WorldPacket data(SMSG_NPC_TEXT_UPDATE, 100);          // guess size
-    data << textID;
-
     if (!gossip)
     {
+        WorldPacket data(SMSG_NPC_TEXT_UPDATE, 100);          // guess size
+        data << textID;
+
         for (uint8 i = 0; i < MAX_GOSSIP_TEXT_OPTIONS; ++i)
         {
             data << float(0);
@@ -307,62 +381,39 @@ void WorldSession::HandleNpcTextQueryOpcode(WorldPacket& recvData)
             data << uint32(0);
             data << uint32(0);
         }
+
+        SendPacket(&data);
     }
+    else if (WorldPacket const* data = gossip->QueryData.Get(GetSessionDbLocaleIndex()))
+        SendPacket(data);
     else
     {
-        std::string text0[MAX_GOSSIP_TEXT_OPTIONS], text1[MAX_GOSSIP_TEXT_OPTIONS];
-        LocaleConstant locale = GetSessionDbLocaleIndex();
-
-        for (uint8 i = 0; i < MAX_GOSSIP_TEXT_OPTIONS; ++i)
-        {
-            BroadcastText const* bct = sObjectMgr->GetBroadcastText(gossip->Options[i].BroadcastTextID);
-            if (bct)
-            {
-                text0[i] = bct->GetText(locale, GENDER_MALE, true);
-                text1[i] = bct->GetText(locale, GENDER_FEMALE, true);
-            }
-            else
-            {
-                text0[i] = gossip->Options[i].Text_0;
-                text1[i] = gossip->Options[i].Text_1;
-            }
-
-            if (locale != DEFAULT_LOCALE && !bct)
-            {
-                if (NpcTextLocale const* npcTextLocale = sObjectMgr->GetNpcTextLocale(textID))
-                {
-                    ObjectMgr::GetLocaleString(npcTextLocale->Text_0[i], locale, text0[i]);
-                    ObjectMgr::GetLocaleString(npcTextLocale->Text_1[i], locale, text1[i]);
-                }
-            }
-
-            data << gossip->Options[i].Probability;
-
-            if (text0[i].empty())
-                data << text1[i];
-            else
-                data << text0[i];
-
-            if (text1[i].empty())
-                data << text0[i];
-            else
-                data << text1[i];
-
-            data << gossip->Options[i].Language;
-
-            for (uint8 j = 0; j < MAX_GOSSIP_TEXT_EMOTES; ++j)
-            {
-                data << gossip->Options[i].Emotes[j]._Delay;
-                data << gossip->Options[i].Emotes[j]._Emote;
-            }
-        }
+        WorldPacket packet = gossip->BuildQueryData(textID, GetSessionDbLocaleIndex());
+        SendPacket(&packet);
     }
 
-    SendPacket(&data);
-
     LOG_DEBUG("network", "WORLD: Sent SMSG_NPC_TEXT_UPDATE");
 }
 
+WorldPacket PageText::BuildQueryData(uint32 pageId, LocaleConstant locale) const
+{
+    std::string text = Text;
+    if (PageTextLocale const* pageTextLocale = sObjectMgr->GetPageTextLocale(pageId))
+        ObjectMgr::GetLocaleString(pageTextLocale->Text, locale, text);
+
+    // guess size
+    WorldPacket data(SMSG_PAGE_TEXT_QUERY_RESPONSE, 50);
+    data << pageId;
+    data << text;
+    data << uint32(NextPage);
+    return data;
+}
+
+void PageText::InitializeQueryData(uint32 pageId)
+{
+    QueryData.Initialize(sObjectMgr->GetPageTextLocale(pageId) != nullptr, [this, pageId](LocaleConstant locale) { return BuildQueryData(pageId, locale); });
+}
+
 /// Only _static_ data is sent in this packet !!!
 void WorldSession::HandlePageTextQueryOpcode(WorldPacket& recvData)
 {
@@ -373,30 +424,28 @@ void WorldSession::HandlePageTextQueryOpcode(WorldPacket& recvData)
     while (pageID)
     {
         PageText const* pageText = sObjectMgr->GetPageText(pageID);
-        // guess size
-        WorldPacket data(SMSG_PAGE_TEXT_QUERY_RESPONSE, 50);
-        data << pageID;
-
         if (!pageText)
         {
+            // guess size
+            WorldPacket data(SMSG_PAGE_TEXT_QUERY_RESPONSE, 50);
+            data << pageID;
             data << "Item page missing.";
             data << uint32(0);
+            SendPacket(&data);
             pageID = 0;
         }
         else
         {
-            std::string Text = pageText->Text;
-
-            int loc_idx = GetSessionDbLocaleIndex();
-            if (loc_idx >= 0)
-                if (PageTextLocale const* player = sObjectMgr->GetPageTextLocale(pageID))
-                    ObjectMgr::GetLocaleString(player->Text, loc_idx, Text);
+            if (WorldPacket const* data = pageText->QueryData.Get(GetSessionDbLocaleIndex()))
+                SendPacket(data);
+            else
+            {
+                WorldPacket packet = pageText->BuildQueryData(pageID, GetSessionDbLocaleIndex());
+                SendPacket(&packet);
+            }
 
-            data << Text;
-            data << uint32(pageText->NextPage);
             pageID = pageText->NextPage;
         }
-        SendPacket(&data);
 
         LOG_DEBUG("network", "WORLD: Sent SMSG_PAGE_TEXT_QUERY_RESPONSE");
     }
@@ -32,6 +32,7 @@
 #include "Timer.h"
 #include "Transport.h"
 #include "World.h"
+#include <unordered_set>
 
 uint16 InstanceSaveMgr::ResetTimeDelay[] = {3600, 900, 300, 60, 0};
 PlayerBindStorage InstanceSaveMgr::playerBindStorage;
@@ -462,7 +463,7 @@ void InstanceSaveMgr::Update()
 {
     time_t now = GameTime::GetGameTime().count();
     time_t t;
-    bool resetOccurred = false;
+    std::vector<InstResetEvent> resets;
 
     while (!m_resetTimeQueue.empty())
     {
@@ -476,34 +477,86 @@ void InstanceSaveMgr::Update()
             // global reset/warning for a certain map
             time_t resetTime = GetResetTimeFor(event.mapid, event.difficulty);
             bool warn = event.type < 5;
-            _ResetOrWarnAll(event.mapid, event.difficulty, warn, resetTime);
             if (warn)
             {
+                _ResetOrWarnAll(event.mapid, event.difficulty, true, resetTime);
+
                 // schedule the next warning/reset
                 ++event.type;
                 ScheduleReset(resetTime - ResetTimeDelay[event.type - 1], event);
             }
             else
-                resetOccurred = true;
+                resets.push_back(event);
         }
         m_resetTimeQueue.erase(m_resetTimeQueue.begin());
     }
 
-    // pussywizard: send updated calendar and raid info
-    if (resetOccurred)
+    if (!resets.empty() && _ResetAll(resets))
     {
+        // pussywizard: send updated calendar and raid info, spread over the next updates
         LOG_INFO("instance.save", "Instance ID reset occurred, sending updated calendar and raid info to all players!");
-        WorldPacket dummy;
+        m_resetNotifyQueue.clear();
         for (SessionMap::const_iterator itr = sWorld->GetAllSessions().begin(); itr != sWorld->GetAllSessions().end(); ++itr)
-            if (Player* plr = itr->second->GetPlayer())
+            if (itr->second->GetPlayer())
+                m_resetNotifyQueue.push_back(itr->first);
+    }
+
+    _SendResetNotifications();
+}
+
+void InstanceSaveMgr::_SendResetNotifications()
+{
+    WorldPacket dummy;
+    for (uint32 count = 0; count < RESET_NOTIFICATIONS_PER_UPDATE && !m_resetNotifyQueue.empty(); ++count)
+    {
+        uint32 accountId = m_resetNotifyQueue.front();
+        m_resetNotifyQueue.pop_front();
+
+        // sessions that logged out in the meantime get the new data at their next login
+        if (WorldSession* session = sWorld->FindSession(accountId))
+            if (Player* plr = session->GetPlayer())
             {
-                itr->second->HandleCalendarGetCalendar(dummy);
+                session->HandleCalendarGetCalendar(dummy);
                 plr->SendRaidInfo();
             }
     }
 }
 
-void InstanceSaveMgr::_ResetSave(InstanceSaveHashMap::iterator& itr)
+bool InstanceSaveMgr::_ResetAll(std::vector<InstResetEvent> const& events)
+{
+    std::unordered_set<uint32 /*PAIR32(map, difficulty)*/> mapDifficulties;
+    std::vector<std::pair<InstResetEvent, time_t>> validEvents;
+    for (InstResetEvent const& event : events)
+    {
+        time_t resetTime = GetResetTimeFor(event.mapid, event.difficulty);
+        if (_ScheduleNextReset(event.mapid, event.difficulty, resetTime))
+        {
+            mapDifficulties.insert(MAKE_PAIR32(event.mapid, event.difficulty));
+            validEvents.emplace_back(event, resetTime);
+        }
+    }
+
+    if (validEvents.empty())
+        return false;
+
+    // remove all binds to instances of the given maps and delete from db (delete per instance id, no mass deletion!)
+    // do this after new reset times are calculated, one pass over the saves and one transaction for all maps reset at once
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    for (InstanceSaveHashMap::iterator itr = m_instanceSaveById.begin(), itr2; itr != m_instanceSaveById.end(); )
+    {
+        itr2 = itr++;
+        if (mapDifficulties.count(MAKE_PAIR32(itr2->second->GetMapId(), itr2->second->GetDifficulty())))
+            _ResetSave(itr2, trans);
+    }
+    CharacterDatabase.CommitTransaction(trans);
+
+    for (auto const& [event, resetTime] : validEvents)
+        _ResetOrWarnAll(event.mapid, event.difficulty, false, resetTime);
+
+    return true;
+}
+
+void InstanceSaveMgr::_ResetSave(InstanceSaveHashMap::iterator& itr, CharacterDatabaseTransaction trans)
 {
     lock_instLists = true;
 
@@ -520,11 +573,13 @@ void InstanceSaveMgr::_ResetSave(InstanceSaveHashMap::iterator& itr)
         // delete character_instance per id, delete instance per id
         CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_INSTANCE_BY_INSTANCE);
         stmt->SetData(0, itr->second->GetInstanceId());
-        CharacterDatabase.Execute(stmt);
+        trans->Append(stmt);
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_INSTANCE_BY_INSTANCE);
         stmt->SetData(0, itr->second->GetInstanceId());
-        CharacterDatabase.Execute(stmt);
-        DeleteInstanceSavedData(itr->second->GetInstanceId());
+        trans->Append(stmt);
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_DELETE_INSTANCE_SAVED_DATA);
+        stmt->SetData(0, itr->second->GetInstanceId());
+        trans->Append(stmt);
 
         // clear respawn times if the map is already unloaded and won't do it by itself
         if (!sMapMgr->FindMap(itr->second->GetMapId(), itr->second->GetInstanceId()))
@@ -537,15 +592,13 @@ void InstanceSaveMgr::_ResetSave(InstanceSaveHashMap::iterator& itr)
     }
     else
     {
-        // delete character_instance per id where extended = 0, transtaction with set extended = 0, transaction is used to avoid mysql thread races
-        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+        // delete character_instance per id where extended = 0, then set extended = 0, the transaction keeps them in order
         CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_INSTANCE_BY_INSTANCE_NOT_EXTENDED);
         stmt->SetData(0, itr->second->GetInstanceId());
         trans->Append(stmt);
         stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_CHAR_INSTANCE_SET_NOT_EXTENDED);
         stmt->SetData(0, itr->second->GetInstanceId());
         trans->Append(stmt);
-        CharacterDatabase.CommitTransaction(trans);
 
         // update reset time and extended reset time for instance save
         itr->second->SetResetTime(GetResetTimeFor(itr->second->GetMapId(), itr->second->GetDifficulty()));
@@ -555,52 +608,49 @@ void InstanceSaveMgr::_ResetSave(InstanceSaveHashMap::iterator& itr)
     lock_instLists = false;
 }
 
-void InstanceSaveMgr::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime)
+bool InstanceSaveMgr::_ScheduleNextReset(uint32 mapid, Difficulty difficulty, time_t resetTime)
 {
-    // global reset for all instances of the given map
     MapEntry const* mapEntry = sMapStore.LookupEntry(mapid);
     if (!mapEntry->Instanceable())
-        return;
+        return false;
 
-    time_t now = GameTime::GetGameTime().count();
-
-    if (!warn)
+    MapDifficulty const* mapDiff = GetMapDifficultyData(mapid, difficulty);
+    if (!mapDiff || !mapDiff->resetTime)
     {
-        MapDifficulty const* mapDiff = GetMapDifficultyData(mapid, difficulty);
-        if (!mapDiff || !mapDiff->resetTime)
-        {
-            LOG_ERROR("instance.save", "InstanceSaveMgr::ResetOrWarnAll: not valid difficulty or no reset delay for map {}", mapid);
-            return;
-        }
+        LOG_ERROR("instance.save", "InstanceSaveMgr::ResetOrWarnAll: not valid difficulty or no reset delay for map {}", mapid);
+        return false;
+    }
 
-        // calculate the next reset time
-        uint32 diff = sWorld->getIntConfig(CONFIG_INSTANCE_RESET_TIME_HOUR) * HOUR;
+    // calculate the next reset time
+    uint32 diff = sWorld->getIntConfig(CONFIG_INSTANCE_RESET_TIME_HOUR) * HOUR;
 
-        uint32 period = uint32(((mapDiff->resetTime * sWorld->getRate(RATE_INSTANCE_RESET_TIME)) / DAY) * DAY);
-        if (period < DAY)
-            period = DAY;
+    uint32 period = uint32(((mapDiff->resetTime * sWorld->getRate(RATE_INSTANCE_RESET_TIME)) / DAY) * DAY);
+    if (period < DAY)
+        period = DAY;
 
-        uint32 next_reset = uint32(((resetTime + MINUTE) / DAY * DAY) + period + diff);
-        SetResetTimeFor(mapid, difficulty, next_reset);
-        SetExtendedResetTimeFor(mapid, difficulty, next_reset + period);
-        ScheduleReset(time_t(next_reset - 3600), InstResetEvent(1, mapid, difficulty));
+    uint32 next_reset = uint32(((resetTime + MINUTE) / DAY * DAY) + period + diff);
+    SetResetTimeFor(mapid, difficulty, next_reset);
+    SetExtendedResetTimeFor(mapid, difficulty, next_reset + period);
+    ScheduleReset(time_t(next_reset - 3600), InstResetEvent(1, mapid, difficulty));
 
-        // update it in the DB
-        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GLOBAL_INSTANCE_RESETTIME);
-        stmt->SetData(0, next_reset);
-        stmt->SetData(1, uint16(mapid));
-        stmt->SetData(2, uint8(difficulty));
-        CharacterDatabase.Execute(stmt);
+    // update it in the DB
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_GLOBAL_INSTANCE_RESETTIME);
+    stmt->SetData(0, next_reset);
+    stmt->SetData(1, uint16(mapid));
+    stmt->SetData(2, uint8(difficulty));
+    CharacterDatabase.Execute(stmt);
 
-        // remove all binds to instances of the given map and delete from db (delete per instance id, no mass deletion!)
-        // do this after new reset time is calculated
-        for (InstanceSaveHashMap::iterator itr = m_instanceSaveById.begin(), itr2; itr != m_instanceSaveById.end(); )
-        {
-            itr2 = itr++;
-            if (itr2->second->GetMapId() == mapid && itr2->second->GetDifficulty() == difficulty)
-                _ResetSave(itr2);
-        }
-    }
+    return true;
+}
+
+void InstanceSaveMgr::_ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime)
+{
+    // global reset for all instances of the given map, the saves are reset by _ResetAll before
+    MapEntry const* mapEntry = sMapStore.LookupEntry(mapid);
+    if (!mapEntry->Instanceable())
+        return;
+
+    time_t now = GameTime::GetGameTime().count();
 
     // now loop all existing maps to warn / reset
     Map const* map = sMapMgr->CreateBaseMap(mapid);
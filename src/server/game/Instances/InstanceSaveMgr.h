@@ -23,10 +23,12 @@
 #include "Define.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
+#include <deque>
 #include <list>
 #include <map>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 struct InstanceTemplate;
 struct MapEntry;
@@ -190,13 +192,20 @@ protected:
     static BoundInstancesMap emptyBoundInstancesMap;
 
 private:
+    // sessions getting the new calendar and raid info after a reset, per update
+    static constexpr uint32 RESET_NOTIFICATIONS_PER_UPDATE = 200;
+
+    bool _ResetAll(std::vector<InstResetEvent> const& events);
+    bool _ScheduleNextReset(uint32 mapid, Difficulty difficulty, time_t resetTime);
     void _ResetOrWarnAll(uint32 mapid, Difficulty difficulty, bool warn, time_t resetTime);
-    void _ResetSave(InstanceSaveHashMap::iterator& itr);
+    void _ResetSave(InstanceSaveHashMap::iterator& itr, CharacterDatabaseTransaction trans);
+    void _SendResetNotifications();
     bool lock_instLists{false};
     InstanceSaveHashMap m_instanceSaveById;
     ResetTimeByMapDifficultyMap m_resetTimeByMapDifficulty;
     ResetTimeByMapDifficultyMap m_resetExtendedTimeByMapDifficulty;
     ResetTimeQueue m_resetTimeQueue;
+    std::deque<uint32 /*accountId*/> m_resetNotifyQueue;
 };
 
 #define sInstanceSaveMgr InstanceSaveMgr::instance()
@@ -121,12 +121,25 @@ private:
     LootGroup& operator=(LootGroup const&);
 };
 
+LootStore::~LootStore()
+{
+    Clear();
+
+    if (m_PreparedTemplates)
+        DeleteTemplates(*m_PreparedTemplates);
+}
+
 //Remove all data and free all memory
 void LootStore::Clear()
 {
-    for (LootTemplateMap::const_iterator itr = m_LootTemplates.begin(); itr != m_LootTemplates.end(); ++itr)
+    DeleteTemplates(m_LootTemplates);
+}
+
+void LootStore::DeleteTemplates(LootTemplateMap& lootTemplates)
+{
+    for (LootTemplateMap::const_iterator itr = lootTemplates.begin(); itr != lootTemplates.end(); ++itr)
         delete itr->second;
-    m_LootTemplates.clear();
+    lootTemplates.clear();
 }
 
 // Checks validity of the loot store
@@ -141,11 +154,40 @@ void LootStore::Verify() const
 // All checks of the loaded template are called from here, no error reports at loot generation required
 uint32 LootStore::LoadLootTable()
 {
-    LootTemplateMap::const_iterator tab;
-
     // Clearing store (for reloading case)
     Clear();
 
+    // a reload prepared in the background already did the reading
+    {
+        std::lock_guard<std::mutex> lock(m_PreparedLock);
+        if (m_PreparedTemplates)
+        {
+            m_LootTemplates.swap(*m_PreparedTemplates);
+            m_PreparedTemplates.reset();
+            return m_PreparedCount;
+        }
+    }
+
+    return LoadLootTable(m_LootTemplates);
+}
+
+void LootStore::PrepareReload()
+{
+    auto lootTemplates = std::make_unique<LootTemplateMap>();
+    uint32 count = LoadLootTable(*lootTemplates);
+
+    std::lock_guard<std::mutex> lock(m_PreparedLock);
+    if (m_PreparedTemplates)
+        DeleteTemplates(*m_PreparedTemplates);
+
+    m_PreparedTemplates = std::move(lootTemplates);
+    m_PreparedCount = count;
+}
+
+uint32 LootStore::LoadLootTable(LootTemplateMap& lootTemplates) const
+{
+    LootTemplateMap::const_iterator tab;
+
     //                                                  0     1            2               3         4         5             6
     QueryResult result = WorldDatabase.Query("SELECT Entry, Item, Reference, Chance, QuestRequired, LootMode, GroupId, MinCount, MaxCount FROM {}", GetName());
 
@@ -191,13 +233,13 @@ uint32 LootStore::LoadLootTable()
         // Looking for the template of the entry
         // often entries are put together
         // cppcheck-suppress eraseDereference
-        if (m_LootTemplates.empty() || tab->first != entry)
+        if (lootTemplates.empty() || tab->first != entry)
         {
             // Searching the template (in case template Id changed)
-            tab = m_LootTemplates.find(entry);
-            if (tab == m_LootTemplates.end())
+            tab = lootTemplates.find(entry);
+            if (tab == lootTemplates.end())
             {
-                std::pair< LootTemplateMap::iterator, bool > pr = m_LootTemplates.insert(LootTemplateMap::value_type(entry, new LootTemplate()));
+                std::pair< LootTemplateMap::iterator, bool > pr = lootTemplates.insert(LootTemplateMap::value_type(entry, new LootTemplate()));
                 tab = pr.first;
             }
         }
@@ -209,7 +251,9 @@ uint32 LootStore::LoadLootTable()
         ++count;
     } while (result->NextRow());
 
-    Verify();                                           // Checks validity of the loot store
+    // Checks validity of the loot store
+    for (LootTemplateMap::const_iterator i = lootTemplates.begin(); i != lootTemplates.end(); ++i)
+        i->second->Verify(*this, i->first);
 
     return count;
 }
@@ -503,6 +547,9 @@ void Loot::AddItem(LootStoreItem const& item)
     std::vector<LootItem>& lootItems = item.needs_quest ? quest_items : items;
     uint32 limit = item.needs_quest ? MAX_NR_QUEST_ITEMS : MAX_NR_LOOT_ITEMS;
 
+    // the owner is the same for every stack
+    Player* player = ObjectAccessor::FindPlayer(lootOwnerGUID);
+
     for (uint32 i = 0; i < stacks && lootItems.size() < limit; ++i)
     {
         LootItem generatedLoot(item);
@@ -513,7 +560,7 @@ void Loot::AddItem(LootStoreItem const& item)
 
         // In some cases, a dropped item should be visible/lootable only for some players in group
         bool canSeeItemInLootWindow = false;
-        if (auto player = ObjectAccessor::FindPlayer(lootOwnerGUID))
+        if (player)
         {
             if (auto group = player->GetGroup())
             {
@@ -567,8 +614,8 @@ bool Loot::FillLoot(uint32 lootId, LootStore const& store, Player* lootOwner, bo
         return false;
     }
 
-    items.reserve(MAX_NR_LOOT_ITEMS);
-    quest_items.reserve(MAX_NR_QUEST_ITEMS);
+    // no reserve up to MAX_NR_LOOT_ITEMS here: most corpses drop a few items and many are never looted at all
+    store.CountFill();
 
     // Initial group is 0, top level set to True
     tab->Process(*this, store, lootMode, lootOwner, 0, true);          // Processing is done there, callback via Loot::AddItem()
@@ -1269,41 +1316,58 @@ void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
 }
 
 // Rolls an item from the group, returns nullptr if all miss their chances
+// Entries failing the selector are skipped in place, the lists are not copied for every roll
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const
 {
-    LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    LootGroupInvalidSelector invalidSelector(loot, lootMode);
 
-    if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
+    bool rolled = false;
+    float roll = 0.0f;
+
+    for (LootStoreItem* item : ExplicitlyChanced)          // First explicitly chanced entries are checked
     {
-        float roll = (float)rand_chance();
+        if (invalidSelector(item))
+            continue;
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
+        if (!rolled)
         {
-            LootStoreItem* item = *itr;
-            float chance = item->chance;
+            roll = (float)rand_chance();
+            rolled = true;
+        }
 
-            if (!sScriptMgr->OnItemRoll(player, item, chance, loot, store))
-                return nullptr;
+        // check each explicitly chanced entry in the template and modify its chance based on quality.
+        float chance = item->chance;
 
-            if (chance >= 100.0f)
-                return item;
+        if (!sScriptMgr->OnItemRoll(player, item, chance, loot, store))
+            return nullptr;
 
-            roll -= chance;
-            if (roll < 0)
-                return item;
-        }
+        if (chance >= 100.0f)
+            return item;
+
+        roll -= chance;
+        if (roll < 0)
+            return item;
     }
 
     if (!sScriptMgr->OnBeforeLootEqualChanced(player, EqualChanced, loot, store))
         return nullptr;
 
-    possibleLoot = EqualChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
-    if (!possibleLoot.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-        return Acore::Containers::SelectRandomContainerElement(possibleLoot);
+    // If nothing selected yet - an item is taken from equal-chanced part
+    uint32 possibleCount = std::count_if(EqualChanced.begin(), EqualChanced.end(), [&](LootStoreItem* item) { return !invalidSelector(item); });
+    if (!possibleCount)
+        return nullptr;                                        // Empty drop from the group
+
+    uint32 selected = urand(0, possibleCount - 1);
+    for (LootStoreItem* item : EqualChanced)
+    {
+        if (invalidSelector(item))
+            continue;
+
+        if (!selected--)
+            return item;
+    }
 
-    return nullptr;                                            // Empty drop from the group
+    return nullptr;
 }
 
 // True if group includes at least 1 quest drop entry
@@ -1887,7 +1951,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
         {
             if ((*i)->itemid == uint32(cond->SourceEntry))
             {
-                (*i)->conditions.push_back(cond);
+                ConditionMgr::AddToConditionList((*i)->conditions, cond);
                 return true;
             }
         }
@@ -1908,7 +1972,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -1921,7 +1985,7 @@ bool LootTemplate::addConditionItem(Condition* cond)
                 {
                     if ((*i)->itemid == uint32(cond->SourceEntry))
                     {
-                        (*i)->conditions.push_back(cond);
+                        ConditionMgr::AddToConditionList((*i)->conditions, cond);
                         return true;
                     }
                 }
@@ -24,8 +24,11 @@
 #include "ObjectGuid.h"
 #include "RefMgr.h"
 #include "SharedDefines.h"
+#include <atomic>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -210,9 +213,12 @@ public:
     explicit LootStore(char const* name, char const* entryName, bool ratesAllowed)
         : m_name(name), m_entryName(entryName), m_ratesAllowed(ratesAllowed) {}
 
-    virtual ~LootStore() { Clear(); }
+    virtual ~LootStore();
 
     uint32 LoadAndCollectLootIds(LootIdSet& ids_set);
+    // Reads the table into a map of its own, the next LoadAndCollectLootIds swaps it in instead of querying the table again.
+    // Leaves the live templates alone, so it may run off the world thread while loot is rolled from this store.
+    void PrepareReload();
     void ResetConditions();
 
     void Verify() const;
@@ -231,14 +237,28 @@ public:
     [[nodiscard]] char const* GetName() const { return m_name; }
     [[nodiscard]] char const* GetEntryName() const { return m_entryName; }
     [[nodiscard]] bool IsRatesAllowed() const { return m_ratesAllowed; }
+
+    // loot filled from this store and loot cleared again without anybody opening it, read and reset by the metrics
+    void CountFill() const { ++m_fillCount; }
+    void CountUnopenedFill() const { ++m_unopenedFillCount; }
+    uint64 TakeFillCount() const { return m_fillCount.exchange(0); }
+    uint64 TakeUnopenedFillCount() const { return m_unopenedFillCount.exchange(0); }
 protected:
     uint32 LoadLootTable();
+    uint32 LoadLootTable(LootTemplateMap& lootTemplates) const;
     void Clear();
 private:
+    static void DeleteTemplates(LootTemplateMap& lootTemplates);
+
     LootTemplateMap m_LootTemplates;
+    std::unique_ptr<LootTemplateMap> m_PreparedTemplates;
+    uint32 m_PreparedCount{0};
+    std::mutex m_PreparedLock;
     char const* m_name;
     char const* m_entryName;
     bool m_ratesAllowed;
+    mutable std::atomic<uint64> m_fillCount{0};
+    mutable std::atomic<uint64> m_unopenedFillCount{0};
 };
 
 class LootTemplate
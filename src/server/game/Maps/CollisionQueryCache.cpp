@@ -0,0 +1,125 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CollisionQueryCache.h"
+#include "Timer.h"
+#include <cmath>
+#include <cstring>
+
+std::atomic<uint64> CollisionQueryCache::_hits{0};
+std::atomic<uint64> CollisionQueryCache::_misses{0};
+
+CollisionQueryCache::CollisionQueryCache(uint32 size) : _generation(0)
+{
+    // round up to a power of two so slots are picked with a mask
+    uint32 slots = 1;
+    while (slots < size)
+        slots <<= 1;
+
+    _mask = slots - 1;
+    _heights.Slots.resize(slots);
+    _lineOfSight.Slots.resize(slots);
+    _areaInfo.Slots.resize(slots);
+}
+
+int32 CollisionQueryCache::Quantize(float value)
+{
+    return int32(std::floor(value * COLLISION_CACHE_RESOLUTION));
+}
+
+CollisionQueryCache::Key CollisionQueryCache::MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, int32 extra)
+{
+    return { { Quantize(x1), Quantize(y1), Quantize(z1), Quantize(x2), Quantize(y2), Quantize(z2), extra } };
+}
+
+uint32 CollisionQueryCache::SlotIndex(Key const& key) const
+{
+    uint64 hash = 0;
+    for (int32 v : key.Values)
+        hash = (hash ^ uint32(v)) * 0x100000001B3ULL;
+
+    return uint32(hash ^ (hash >> 32)) & _mask;
+}
+
+template<class T>
+bool CollisionQueryCache::Find(Table<T>& table, Key const& key, T& value)
+{
+    uint32 index = SlotIndex(key);
+    {
+        std::lock_guard<std::mutex> guard(table.Locks[index % COLLISION_CACHE_LOCKS]);
+        Slot<T> const& slot = table.Slots[index];
+        if (slot.Used && slot.Generation == _generation && slot.Id == key && getMSTimeDiff(slot.StoreTime, getMSTime()) < COLLISION_CACHE_LIFETIME)
+        {
+            value = slot.Value;
+            ++_hits;
+            return true;
+        }
+    }
+
+    ++_misses;
+    return false;
+}
+
+template<class T>
+void CollisionQueryCache::Store(Table<T>& table, Key const& key, T const& value)
+{
+    uint32 index = SlotIndex(key);
+    std::lock_guard<std::mutex> guard(table.Locks[index % COLLISION_CACHE_LOCKS]);
+    Slot<T>& slot = table.Slots[index];
+    slot.Id = key;
+    slot.Value = value;
+    slot.StoreTime = getMSTime();
+    slot.Generation = _generation;
+    slot.Used = true;
+}
+
+static int32 FloatBits(float value)
+{
+    int32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+bool CollisionQueryCache::FindHeight(float x, float y, float z, float maxSearchDist, float& height)
+{
+    return Find(_heights, MakeKey(x, y, z, 0.0f, 0.0f, 0.0f, FloatBits(maxSearchDist)), height);
+}
+
+void CollisionQueryCache::StoreHeight(float x, float y, float z, float maxSearchDist, float height)
+{
+    Store(_heights, MakeKey(x, y, z, 0.0f, 0.0f, 0.0f, FloatBits(maxSearchDist)), height);
+}
+
+bool CollisionQueryCache::FindLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 ignoreFlags, bool& inSight)
+{
+    return Find(_lineOfSight, MakeKey(x1, y1, z1, x2, y2, z2, int32(ignoreFlags)), inSight);
+}
+
+void CollisionQueryCache::StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 ignoreFlags, bool inSight)
+{
+    Store(_lineOfSight, MakeKey(x1, y1, z1, x2, y2, z2, int32(ignoreFlags)), inSight);
+}
+
+bool CollisionQueryCache::FindAreaInfo(float x, float y, float z, AreaInfo& info)
+{
+    return Find(_areaInfo, MakeKey(x, y, z, 0.0f, 0.0f, 0.0f, 0), info);
+}
+
+void CollisionQueryCache::StoreAreaInfo(float x, float y, float z, AreaInfo const& info)
+{
+    Store(_areaInfo, MakeKey(x, y, z, 0.0f, 0.0f, 0.0f, 0), info);
+}
@@ -0,0 +1,113 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_COLLISION_QUERY_CACHE_H
+#define ACORE_COLLISION_QUERY_CACHE_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#define COLLISION_CACHE_LIFETIME   10000   // ms an entry is trusted
+#define COLLISION_CACHE_RESOLUTION 16.0f   // lattice cells per yard used to hash positions
+#define COLLISION_CACHE_LOCKS      16
+
+/**
+ * Direct mapped cache for the static (vmap) part of the height, line of sight
+ * and area queries of one map. Positions are hashed on a fine lattice, so
+ * repeated queries from nearly the same spot share an entry. Entries expire
+ * after COLLISION_CACHE_LIFETIME, and loading or unloading a vmap tile of the
+ * map drops all of them. Gameobject collision depends on phases and spawns and
+ * is never cached. All methods are thread safe.
+ */
+class CollisionQueryCache
+{
+public:
+    struct AreaInfo
+    {
+        bool Found;
+        float Z;
+        uint32 Flags;
+        int32 AdtId;
+        int32 RootId;
+        int32 GroupId;
+    };
+
+    explicit CollisionQueryCache(uint32 size);
+
+    bool FindHeight(float x, float y, float z, float maxSearchDist, float& height);
+    void StoreHeight(float x, float y, float z, float maxSearchDist, float height);
+
+    bool FindLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 ignoreFlags, bool& inSight);
+    void StoreLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 ignoreFlags, bool inSight);
+
+    bool FindAreaInfo(float x, float y, float z, AreaInfo& info);
+    void StoreAreaInfo(float x, float y, float z, AreaInfo const& info);
+
+    // drops every entry, called when the map's static collision changes
+    void Clear() { ++_generation; }
+
+    static uint64 TakeHits() { return _hits.exchange(0); }
+    static uint64 TakeMisses() { return _misses.exchange(0); }
+
+private:
+    struct Key
+    {
+        std::array<int32, 7> Values;
+
+        bool operator==(Key const& other) const { return Values == other.Values; }
+    };
+
+    template<class T>
+    struct Slot
+    {
+        Key Id;
+        T Value;
+        uint32 StoreTime;
+        uint32 Generation;
+        bool Used = false;
+    };
+
+    template<class T>
+    struct Table
+    {
+        std::vector<Slot<T>> Slots;
+        std::array<std::mutex, COLLISION_CACHE_LOCKS> Locks;
+    };
+
+    static Key MakeKey(float x1, float y1, float z1, float x2, float y2, float z2, int32 extra);
+    static int32 Quantize(float value);
+    [[nodiscard]] uint32 SlotIndex(Key const& key) const;
+
+    template<class T>
+    bool Find(Table<T>& table, Key const& key, T& value);
+    template<class T>
+    void Store(Table<T>& table, Key const& key, T const& value);
+
+    uint32 _mask;
+    std::atomic<uint32> _generation;
+    Table<float> _heights;
+    Table<bool> _lineOfSight;
+    Table<AreaInfo> _areaInfo;
+
+    static std::atomic<uint64> _hits;
+    static std::atomic<uint64> _misses;
+};
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridPrefetcher.h"
+#include "MMapMgr.h"
+#include "Map.h"
+#include "MapTree.h"
+#include "ProcessPriority.h"
+#include "World.h"
+
+namespace
+{
+    // prefetched terrain nobody asked for is dropped after this time
+    constexpr std::chrono::seconds PREFETCH_EXPIRE_TIME(60);
+    // keeps a wrong prediction from piling up terrain
+    constexpr size_t MAX_PREFETCHED_GRIDS = 64;
+}
+
+GridPrefetcher::~GridPrefetcher() = default;
+
+void GridPrefetcher::activate(size_t num_threads)
+{
+    _workerThreads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&GridPrefetcher::WorkerThread, this, i));
+}
+
+void GridPrefetcher::deactivate()
+{
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _workerThreads.clear();
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _queued.clear();
+    _ready.clear();
+}
+
+void GridPrefetcher::Prefetch(uint32 mapId, int gx, int gy)
+{
+    uint32 key = MakeKey(mapId, gx, gy);
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto now = std::chrono::steady_clock::now();
+        for (auto itr = _ready.begin(); itr != _ready.end();)
+        {
+            if (now - itr->second.LoadTime > PREFETCH_EXPIRE_TIME)
+                itr = _ready.erase(itr);
+            else
+                ++itr;
+        }
+
+        if (_ready.size() + _queued.size() >= MAX_PREFETCHED_GRIDS || _ready.count(key) || !_queued.insert(key).second)
+            return;
+    }
+
+    _queue.Push(new Request{ mapId, gx, gy });
+}
+
+GridMap* GridPrefetcher::TakeGridMap(uint32 mapId, int gx, int gy)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _ready.find(MakeKey(mapId, gx, gy));
+    if (itr == _ready.end())
+        return nullptr;
+
+    GridMap* terrain = itr->second.Terrain.release();
+    _ready.erase(itr);
+    ++_hits;
+    return terrain;
+}
+
+void GridPrefetcher::ReadAhead(std::string const& fileName)
+{
+    // only pulls the file into the page cache, the map thread reads it again
+    if (FILE* file = fopen(fileName.c_str(), "rb"))
+    {
+        char buffer[64 * 1024];
+        while (fread(buffer, 1, sizeof(buffer), file) == sizeof(buffer));
+        fclose(file);
+    }
+}
+
+void GridPrefetcher::Load(Request const& request)
+{
+    std::string dataPath = sWorld->GetDataPath();
+
+    std::string mapFileName = Acore::StringFormatFmt("{}maps/{:03}{:02}{:02}.map", dataPath, request.MapId, request.GridX, request.GridY);
+    std::unique_ptr<GridMap> terrain = std::make_unique<GridMap>();
+
+    // failures are left to the map thread, it loads the grid again and reports the error
+    if (!terrain->loadData(const_cast<char*>(mapFileName.c_str())))
+        terrain = nullptr;
+
+    ReadAhead(dataPath + "vmaps/" + VMAP::StaticMapTree::getTileFileName(request.MapId, request.GridX, request.GridY));
+    ReadAhead(MMAP::MMapMgr::GetTileFileName(request.MapId, request.GridX, request.GridY));
+
+    uint32 key = MakeKey(request.MapId, request.GridX, request.GridY);
+
+    std::lock_guard<std::mutex> guard(_lock);
+    _queued.erase(key);
+    if (terrain)
+        _ready[key] = { std::move(terrain), std::chrono::steady_clock::now() };
+}
+
+void GridPrefetcher::WorkerThread(size_t workerIndex)
+{
+    SetupCurrentThread("GridPrefetch", uint32(workerIndex));
+
+    while (true)
+    {
+        Request* request = nullptr;
+
+        _queue.WaitAndPop(request);
+        if (!request)
+            return;
+
+        Load(*request);
+        delete request;
+    }
+}
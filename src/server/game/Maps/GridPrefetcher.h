@@ -0,0 +1,87 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GRID_PREFETCHER_H_INCLUDED
+#define _GRID_PREFETCHER_H_INCLUDED
+
+#include "Define.h"
+#include "LockFreePCQueue.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class GridMap;
+
+/*
+ * Background threads loading the terrain of grids players are about to enter.
+ * The GridMap is loaded completely and handed to the map thread by TakeGridMap,
+ * the vmap and mmap tiles of the grid are read ahead so the map thread inserts
+ * them from the page cache.
+ */
+class GridPrefetcher
+{
+public:
+    GridPrefetcher() = default;
+    ~GridPrefetcher();
+
+    void activate(size_t num_threads);
+    void deactivate();
+    [[nodiscard]] bool activated() const { return !_workerThreads.empty(); }
+
+    // gx and gy are grid file coordinates as used by Map::LoadMap
+    void Prefetch(uint32 mapId, int gx, int gy);
+    // return: the prefetched terrain of the grid, owned by the caller, or nullptr
+    GridMap* TakeGridMap(uint32 mapId, int gx, int gy);
+
+    uint32 TakeHits() { return _hits.exchange(0); }
+
+private:
+    struct Request
+    {
+        uint32 MapId;
+        int GridX;
+        int GridY;
+    };
+
+    struct ReadyGrid
+    {
+        std::unique_ptr<GridMap> Terrain;
+        std::chrono::steady_clock::time_point LoadTime;
+    };
+
+    static uint32 MakeKey(uint32 mapId, int gx, int gy) { return (mapId << 12) | (uint32(gx) << 6) | uint32(gy); }
+    static void ReadAhead(std::string const& fileName);
+
+    void WorkerThread(size_t workerIndex);
+    void Load(Request const& request);
+
+    WorkerQueue<Request*> _queue;
+    std::vector<std::thread> _workerThreads;
+
+    std::mutex _lock;
+    std::unordered_set<uint32> _queued;
+    std::unordered_map<uint32, ReadyGrid> _ready;  // predictions not taken yet expire
+
+    std::atomic<uint32> _hits{0};
+};
+
+#endif //_GRID_PREFETCHER_H_INCLUDED
@@ -19,8 +19,11 @@
 #include "Battleground.h"
 #include "CellImpl.h"
 #include "Chat.h"
+#include "CollisionQueryCache.h"
 #include "DisableMgr.h"
+#include "DynamicVisibility.h"
 #include "DynamicTree.h"
+#include "GameEventMgr.h"
 #include "GameTime.h"
 #include "Geometry.h"
 #include "GridNotifiers.h"
@@ -28,7 +31,10 @@
 #include "InstanceScript.h"
 #include "LFGMgr.h"
 #include "MapInstanced.h"
+#include "MapMgr.h"
+#include "MapRegionUpdater.h"
 #include "Metric.h"
+#include "MetricRegistry.h"
 #include "MiscPackets.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
@@ -36,10 +42,17 @@
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "ScriptMgr.h"
+#include "TickArena.h"
 #include "Transport.h"
 #include "VMapFactory.h"
 #include "Vehicle.h"
+#include "WaypointMovementGenerator.h"
 #include "Weather.h"
+#include "ZoneProfiler.h"
+
+#define GRID_PREFETCH_INTERVAL      1000    // ms between two predictions of the grids players are heading to
+#define GRID_PREFETCH_LOOKAHEAD     20.0f   // seconds of straight movement looked ahead
+#define GRID_PREFETCH_TAXI_NODES    20      // taxi path nodes looked ahead
 
 union u_map_magic
 {
@@ -75,8 +88,8 @@ Map::~Map()
         obj->ResetMap();
     }
 
-    if (!m_scriptSchedule.empty())
-        sScriptMgr->DecreaseScheduledScriptCount(m_scriptSchedule.size());
+    if (_scheduledScriptActions)
+        sScriptMgr->DecreaseScheduledScriptCount(_scheduledScriptActions);
 
     //MMAP::MMapFactory::createOrGetMMapMgr()->unloadMap(GetId());
     MMAP::MMapFactory::createOrGetMMapMgr()->unloadMapInstance(GetId(), i_InstanceId);
@@ -168,6 +181,8 @@ void Map::LoadVMap(int gx, int gy)
     {
         case VMAP::VMAP_LOAD_RESULT_OK:
             LOG_DEBUG("maps", "VMAP loaded name:{}, id:{}, x:{}, y:{} (vmap rep.: x:{}, y:{})", GetMapName(), GetId(), gx, gy, gx, gy);
+            if (CollisionQueryCache* cache = GetCollisionCache())
+                cache->Clear();
             break;
         case VMAP::VMAP_LOAD_RESULT_ERROR:
             LOG_DEBUG("maps", "Could not load VMAP name:{}, id:{}, x:{}, y:{} (vmap rep.: x:{}, y:{})", GetMapName(), GetId(), gx, gy, gx, gy);
@@ -211,17 +226,72 @@ void Map::LoadMap(int gx, int gy, bool reload)
     tmp = new char[len];
     snprintf(tmp, len, (char*)(sWorld->GetDataPath() + "maps/%03u%02u%02u.map").c_str(), GetId(), gx, gy);
     LOG_DEBUG("maps", "Loading map {}", tmp);
-    // loading data
-    GridMaps[gx][gy] = new GridMap();
-    if (!GridMaps[gx][gy]->loadData(tmp))
+    // loading data, the terrain may already have been loaded in the background
+    GridMaps[gx][gy] = reload ? nullptr : sMapMgr->GetGridPrefetcher()->TakeGridMap(GetId(), gx, gy);
+    if (!GridMaps[gx][gy])
     {
-        LOG_ERROR("maps", "Error loading map file: \n {}\n", tmp);
+        GridMaps[gx][gy] = new GridMap();
+        if (!GridMaps[gx][gy]->loadData(tmp))
+        {
+            LOG_ERROR("maps", "Error loading map file: \n {}\n", tmp);
+        }
     }
     delete [] tmp;
 
     sScriptMgr->OnLoadGridMap(this, GridMaps[gx][gy], gx, gy);
 }
 
+void Map::PrefetchGrids()
+{
+    if (Instanceable() || !sMapMgr->GetGridPrefetcher()->activated())
+        return;
+
+    for (MapReference const& ref : m_mapRefMgr)
+    {
+        Player* player = ref.GetSource();
+        if (!player || !player->IsInWorld())
+            continue;
+
+        if (player->IsInFlight())
+        {
+            if (player->GetMotionMaster()->GetCurrentMovementGeneratorType() != FLIGHT_MOTION_TYPE)
+                continue;
+
+            FlightPathMovementGenerator* flight = static_cast<FlightPathMovementGenerator*>(player->GetMotionMaster()->top());
+            TaxiPathNodeList const& path = flight->GetPath();
+            uint32 lastNode = std::min<uint32>(flight->GetCurrentNode() + GRID_PREFETCH_TAXI_NODES, path.size());
+            for (uint32 i = flight->GetCurrentNode(); i < lastNode; ++i)
+                if (path[i]->mapid == GetId())
+                    PrefetchGridAt(path[i]->x, path[i]->y);
+        }
+        else if (player->HasUnitMovementFlag(MOVEMENTFLAG_FORWARD))
+        {
+            float speed = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : MOVE_RUN);
+            float distance = speed * GRID_PREFETCH_LOOKAHEAD;
+            for (float step = SIZE_OF_GRIDS / 2; step < distance + SIZE_OF_GRIDS / 2; step += SIZE_OF_GRIDS / 2)
+            {
+                float dist = std::min(step, distance);
+                PrefetchGridAt(player->GetPositionX() + dist * std::cos(player->GetOrientation()),
+                    player->GetPositionY() + dist * std::sin(player->GetOrientation()));
+            }
+        }
+    }
+}
+
+void Map::PrefetchGridAt(float x, float y)
+{
+    GridCoord p = Acore::ComputeGridCoord(x, y);
+    if (!p.IsCoordValid() || getNGrid(p.x_coord, p.y_coord))
+        return;
+
+    int gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+    if (GridMaps[gx][gy])
+        return;
+
+    sMapMgr->GetGridPrefetcher()->Prefetch(GetId(), gx, gy);
+}
+
 void Map::LoadMapAndVMap(int gx, int gy)
 {
     LoadMap(gx, gy);
@@ -236,9 +306,16 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
     m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
     _instanceResetPeriod(0), m_activeNonPlayersIter(m_activeNonPlayers.end()),
-    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
+    _transportsUpdateIter(_transports.end()), i_scriptLock(false), _scheduledScriptActions(0),
+    _respawnSaveTimer(0), _gridPrefetchTimer(0), _defaultLight(GetDefaultMapLight(id)), _lastUpdateCost(0), _updateTimeHistogram(nullptr),
+    _collectRegionCells(false), _regionUpdateActive(false), _stagedGridLoading(false),
+    _gridLoads(0), _cellLoads(0), _gridLoadTime(0),
+    _idleUpdateTick(0), _idleUpdateDiffs(), _idleObjectsSkipped(0), _quiescentAIUpdates(0),
+    _gameEventActionsApplied(0)
 {
     m_parentMap = (_parent ? _parent : this);
+    _stagedGridLoading = IsWorldMap() && sWorld->getBoolConfig(CONFIG_STAGED_GRID_LOADING);
+
     for (unsigned int idx = 0; idx < MAX_NUMBER_OF_GRIDS; ++idx)
     {
         for (unsigned int j = 0; j < MAX_NUMBER_OF_GRIDS; ++j)
@@ -249,6 +326,10 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
         }
     }
 
+    if (!_parent)
+        if (uint32 cacheSize = sWorld->getIntConfig(CONFIG_VMAP_QUERY_CACHE_SIZE))
+            _collisionCache = std::make_unique<CollisionQueryCache>(cacheSize);
+
     //lets initialize visibility distance for map
     Map::InitVisibilityDistance();
 
@@ -324,8 +405,8 @@ void Map::AddToGrid(Corpse* obj, Cell const& cell)
     // Both corpses loaded from database and these freshly generated by Player::CreateCoprse are added to _corpsesByCell
     // ObjectGridLoader loads all corpses from _corpsesByCell even if they were already added to grid before it was loaded
     // so we need to explicitly check it here (Map::AddToGrid is only called from Player::BuildPlayerRepop, not from ObjectGridLoader)
-    // to avoid failing an assertion in GridObject::AddToGrid
-    if (grid->isGridObjectDataLoaded())
+    // to avoid failing an assertion in GridObject::AddToGrid, per cell since staged grids load their cells one by one
+    if (grid->isCellObjectDataLoaded(cell.CellX(), cell.CellY()))
     {
         if (obj->IsWorldObject())
             grid->GetGridType(cell.CellX(), cell.CellY()).AddWorldObject(obj);
@@ -476,19 +557,52 @@ bool Map::EnsureGridLoaded(const Cell& cell)
         //{
         LOG_DEBUG("maps", "Loading grid[{}, {}] for map {} instance {}", cell.GridX(), cell.GridY(), GetId(), i_InstanceId);
 
+        PROFILE_ZONE("Map::EnsureGridLoaded");
+        auto const loadStart = std::chrono::steady_clock::now();
+
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
 
         ObjectGridLoader loader(*grid, this, cell);
-        loader.LoadN();
+        if (_stagedGridLoading)
+            loader.LoadCell(cell.CellX(), cell.CellY());
+        else
+            loader.LoadN();
 
         Balance();
+
+        ++_gridLoads;
+        _gridLoadTime += std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - loadStart);
         return true;
         //}
     }
 
+    // staged grids create the spawns of the other cells once something needs them, not from the region threads though
+    if (_stagedGridLoading && !_regionUpdateActive && !grid->isCellObjectDataLoaded(cell.CellX(), cell.CellY()))
+    {
+        auto const loadStart = std::chrono::steady_clock::now();
+
+        ObjectGridLoader loader(*grid, this, cell);
+        loader.LoadCell(cell.CellX(), cell.CellY());
+
+        ++_cellLoads;
+        _gridLoadTime += std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - loadStart);
+        return true;
+    }
+
     return false;
 }
 
+bool Map::IsGridLoaded(float x, float y) const
+{
+    GridCoord const p = Acore::ComputeGridCoord(x, y);
+    if (!IsGridLoaded(p))
+        return false;
+
+    // a staged grid is only loaded where its cell spawns exist, anything spawned elsewhere gets created with the cell
+    Cell const cell(x, y);
+    return getNGrid(p.x_coord, p.y_coord)->isCellObjectDataLoaded(cell.CellX(), cell.CellY());
+}
+
 void Map::LoadGrid(float x, float y)
 {
     EnsureGridLoaded(Cell(x, y));
@@ -554,6 +668,8 @@ void Map::InitializeObject(GameObject*  /*obj*/)
 template<class T>
 bool Map::AddToMap(T* obj, bool checkTransport)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     //TODO: Needs clean up. An object should not be added to map twice.
     if (obj->IsInWorld())
     {
@@ -684,9 +800,20 @@ void Map::VisitNearbyCellsOfPlayer(Player* player, TypeContainerVisitor<Acore::O
                 continue;
 
             markCellLarge(cell_id);
+
+            if (_collectRegionCells)
+            {
+                _regionLargeCells.push_back(cell_id);
+                continue;
+            }
+
             CellCoord pair(x, y);
             Cell cell(pair);
 
+            // staged grids create their cells within visibility range only
+            if (_stagedGridLoading)
+                cell.SetNoCreate();
+
             Visit(cell, largeGridVisitor);
             Visit(cell, largeWorldVisitor);
         }
@@ -716,6 +843,20 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Acore::Objec
                 continue;
 
             markCell(cell_id);
+
+            if (_collectRegionCells)
+            {
+                _regionCells.push_back(cell_id);
+
+                if (!isCellMarkedLarge(cell_id))
+                {
+                    markCellLarge(cell_id);
+                    _regionLargeCells.push_back(cell_id);
+                }
+
+                continue;
+            }
+
             CellCoord pair(x, y);
             Cell cell(pair);
             //cell.SetNoCreate(); // in mmaps this is missing
@@ -735,6 +876,11 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Acore::Objec
 
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
+    PROFILE_ZONE("Map::Update");
+
+    // temporary containers of the update are dropped at once when it ends
+    Acore::TickArenaScope arenaScope;
+
     if (t_diff)
         _dynamicTree.update(t_diff);
 
@@ -751,7 +897,26 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         }
     }
 
-    _creatureRespawnScheduler.Update(t_diff);
+    ProcessCreatureRespawns();
+
+    ApplyGameEventActions();
+
+    // corpses created or turned into bones since the last update, in one transaction
+    SaveCorpseData();
+
+    _respawnSaveTimer += t_diff;
+    if (_respawnSaveTimer >= sWorld->getIntConfig(CONFIG_RESPAWN_SAVE_INTERVAL))
+    {
+        _respawnSaveTimer = 0;
+        SaveRespawnTimes();
+    }
+
+    _gridPrefetchTimer += t_diff;
+    if (_gridPrefetchTimer >= GRID_PREFETCH_INTERVAL)
+    {
+        _gridPrefetchTimer = 0;
+        PrefetchGrids();
+    }
 
     if (!t_diff)
     {
@@ -766,6 +931,7 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
             player->Update(s_diff);
         }
 
+        SendCombatLogs();
         HandleDelayedVisibility();
         return;
     }
@@ -774,6 +940,18 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     resetMarkedCells();
     resetMarkedCellsLarge();
 
+    // idle objects are updated every few ticks only, with the diffs of the skipped ticks summed up
+    auto accumulatedIdleDiff = [this](uint32 interval)
+    {
+        uint32 accumulatedDiff = 0;
+        for (uint32 i = 0; i < interval; ++i)
+            accumulatedDiff += _idleUpdateDiffs[(_idleUpdateTick + MAX_IDLE_OBJECT_UPDATE_INTERVAL - i) % MAX_IDLE_OBJECT_UPDATE_INTERVAL];
+        return accumulatedDiff;
+    };
+
+    if (IsWorldMap())
+        _idleUpdateDiffs[_idleUpdateTick % MAX_IDLE_OBJECT_UPDATE_INTERVAL] = t_diff;
+
     Acore::ObjectUpdater updater(t_diff, false);
 
     // for creature
@@ -783,6 +961,13 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 
     // for large creatures
     Acore::ObjectUpdater largeObjectUpdater(t_diff, true);
+
+    if (IsWorldMap())
+    {
+        uint32 interval = std::min<uint32>(sWorld->getIntConfig(CONFIG_MAP_IDLE_CREATURE_UPDATE_INTERVAL), MAX_IDLE_OBJECT_UPDATE_INTERVAL);
+        updater.SetIdleCreatureThrottle(interval, _idleUpdateTick, accumulatedIdleDiff(interval));
+        largeObjectUpdater.SetIdleCreatureThrottle(interval, _idleUpdateTick, accumulatedIdleDiff(interval));
+    }
     TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_large_object_update(largeObjectUpdater);
     TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer  > world_large_object_update(largeObjectUpdater);
 
@@ -790,17 +975,8 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     std::vector<Creature*> updateList;
     updateList.reserve(10);
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
-    {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
-
-        if (!obj || !obj->IsInWorld())
-            continue;
-
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update, grid_large_object_update, world_large_object_update);
-    }
+    // continents can have their cells updated in parallel, the loops below only collect the cells then
+    _collectRegionCells = IsWorldMap() && sMapMgr->GetRegionUpdater()->activated();
 
     // the player iterator is stored in the map object
     // to make sure calls to Map::Remove don't invalidate it
@@ -849,6 +1025,46 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         }
     }
 
+    if (_collectRegionCells)
+    {
+        _collectRegionCells = false;
+        UpdateCellRegions(t_diff);
+    }
+
+    // cells reached only by non-player active objects have no player in visibility range,
+    // idle objects there may be updated at a lower rate
+    Acore::ObjectUpdater idleUpdater(t_diff, false);
+    Acore::ObjectUpdater largeIdleUpdater(t_diff, true);
+    if (IsWorldMap())
+    {
+        uint32 interval = DynamicVisibilityMgr::GetIdleObjectUpdateInterval(sWorld->getIntConfig(CONFIG_MAP_IDLE_OBJECT_UPDATE_INTERVAL));
+        interval = std::min<uint32>(interval, MAX_IDLE_OBJECT_UPDATE_INTERVAL);
+        uint32 accumulatedDiff = accumulatedIdleDiff(interval);
+
+        idleUpdater.SetIdleThrottle(interval, _idleUpdateTick, accumulatedDiff);
+        largeIdleUpdater.SetIdleThrottle(interval, _idleUpdateTick, accumulatedDiff);
+        ++_idleUpdateTick;
+    }
+
+    TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_idle_update(idleUpdater);
+    TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer > world_idle_update(idleUpdater);
+    TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_large_idle_update(largeIdleUpdater);
+    TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer > world_large_idle_update(largeIdleUpdater);
+
+    // non-player active objects, increasing iterator in the loop in case of object removal
+    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+    {
+        WorldObject* obj = *m_activeNonPlayersIter;
+        ++m_activeNonPlayersIter;
+
+        if (!obj || !obj->IsInWorld())
+            continue;
+
+        VisitNearbyCellsOf(obj, grid_idle_update, world_idle_update, grid_large_idle_update, world_large_idle_update);
+    }
+
+    _idleObjectsSkipped = idleUpdater.i_skippedObjects + largeIdleUpdater.i_skippedObjects;
+
     for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();) // pussywizard: transports updated after VisitNearbyCellsOf, grids around are loaded, everything ok
     {
         MotionTransport* transport = *_transportsUpdateIter;
@@ -860,6 +1076,7 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         transport->Update(t_diff);
     }
 
+    SendCombatLogs();
     SendObjectUpdates();
 
     ///- Process necessary scripts
@@ -870,6 +1087,7 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
         i_scriptLock = false;
     }
 
+    RelocateVehiclePassengers();
     MoveAllCreaturesInMoveList();
     MoveAllGameObjectsInMoveList();
     MoveAllDynamicObjectsInMoveList();
@@ -885,15 +1103,333 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         METRIC_TAG("map_id", std::to_string(GetId())),
         METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    if (_scheduledScriptActions)
+        METRIC_VALUE("map_script_actions_pending", uint64(_scheduledScriptActions),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    if (_idleObjectsSkipped)
+        METRIC_VALUE("map_idle_objects_skipped", uint64(_idleObjectsSkipped),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    // grids stay loaded until their map unloads, repeated loads show up as instances being created again
+    if (_gridLoads || _cellLoads)
+    {
+        METRIC_VALUE("map_grid_loads", uint64(_gridLoads),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        METRIC_VALUE("map_cell_loads", uint64(_cellLoads),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        METRIC_VALUE("map_grid_load_time", _gridLoadTime,
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        _gridLoads = 0;
+        _cellLoads = 0;
+        _gridLoadTime = Microseconds::zero();
+    }
+
+    if (uint32 quiescentAIUpdates = _quiescentAIUpdates.exchange(0, std::memory_order_relaxed))
+        METRIC_VALUE("map_ai_updates_skipped", uint64(quiescentAIUpdates),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    if (_gameEventActionsApplied)
+    {
+        size_t pending;
+        {
+            std::lock_guard<std::mutex> guard(_gameEventActionsLock);
+            pending = _gameEventActions.size();
+        }
+
+        METRIC_VALUE("map_game_event_actions_applied", uint64(_gameEventActionsApplied),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        METRIC_VALUE("map_game_event_actions_pending", uint64(pending),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        _gameEventActionsApplied = 0;
+    }
+}
+
+void Map::QueueGameEventAction(GameEventMapAction action, ObjectGuid::LowType spawnId)
+{
+    std::lock_guard<std::mutex> guard(_gameEventActionsLock);
+    _gameEventActions.emplace_back(action, spawnId);
+}
+
+void Map::ApplyGameEventActions()
+{
+    std::vector<std::pair<GameEventMapAction, ObjectGuid::LowType>> actions;
+    {
+        std::lock_guard<std::mutex> guard(_gameEventActionsLock);
+        if (_gameEventActions.empty())
+            return;
+
+        size_t count = _gameEventActions.size();
+        if (uint32 limit = sWorld->getIntConfig(CONFIG_EVENT_MAP_ACTIONS_PER_UPDATE))
+            count = std::min<size_t>(count, limit);
+
+        actions.assign(_gameEventActions.begin(), _gameEventActions.begin() + count);
+        _gameEventActions.erase(_gameEventActions.begin(), _gameEventActions.begin() + count);
+    }
+
+    for (auto const& [action, spawnId] : actions)
+        ApplyGameEventAction(action, spawnId);
+
+    _gameEventActionsApplied += actions.size();
+}
+
+void Map::ApplyGameEventAction(GameEventMapAction action, ObjectGuid::LowType spawnId)
+{
+    switch (action)
+    {
+        case GameEventMapAction::SpawnCreature:
+        {
+            // the grid may have been unloaded since the spawn was queued, loading it again spawns the creature
+            CreatureData const* data = sObjectMgr->GetCreatureData(spawnId);
+            if (!data || !IsGridLoaded(data->posX, data->posY))
+                break;
+
+            Creature* creature = new Creature;
+            if (!creature->LoadCreatureFromDB(spawnId, this))
+                delete creature;
+            break;
+        }
+        case GameEventMapAction::SpawnGameObject:
+        {
+            // also skips gameobjects that a grid load in the meantime has spawned already
+            GameObjectData const* data = sObjectMgr->GetGameObjectData(spawnId);
+            if (!data || !IsGridLoaded(data->posX, data->posY) || _gameobjectBySpawnIdStore.count(spawnId))
+                break;
+
+            GameObject* gameobject = sObjectMgr->IsGameObjectStaticTransport(data->id) ? new StaticTransport() : new GameObject();
+            if (!gameobject->LoadGameObjectFromDB(spawnId, this, false))
+                delete gameobject;
+            else if (gameobject->isSpawnedByDefault())
+                AddToMap(gameobject);
+            break;
+        }
+        case GameEventMapAction::DespawnCreature:
+        {
+            auto creatureBounds = _creatureBySpawnIdStore.equal_range(spawnId);
+            for (auto itr = creatureBounds.first; itr != creatureBounds.second;)
+            {
+                Creature* creature = itr->second;
+                ++itr;
+                creature->AddObjectToRemoveList();
+            }
+            break;
+        }
+        case GameEventMapAction::DespawnGameObject:
+        {
+            auto gameobjectBounds = _gameobjectBySpawnIdStore.equal_range(spawnId);
+            for (auto itr = gameobjectBounds.first; itr != gameobjectBounds.second;)
+            {
+                GameObject* go = itr->second;
+                ++itr;
+                go->AddObjectToRemoveList();
+            }
+            break;
+        }
+        case GameEventMapAction::UpdateNpcFlags:
+        {
+            auto creatureBounds = _creatureBySpawnIdStore.equal_range(spawnId);
+            for (auto itr = creatureBounds.first; itr != creatureBounds.second; ++itr)
+            {
+                Creature* creature = itr->second;
+                uint32 npcflag = sGameEventMgr->GetNPCFlag(creature);
+                if (CreatureTemplate const* creatureTemplate = creature->GetCreatureTemplate())
+                    npcflag |= creatureTemplate->npcflag;
+
+                creature->ReplaceAllNpcFlags(NPCFlags(npcflag));
+            }
+            break;
+        }
+    }
+}
+
+void Map::UpdateCellRegions(uint32 t_diff)
+{
+    struct CellRegion
+    {
+        std::vector<uint32> Cells;
+        std::vector<uint32> LargeCells;
+    };
+
+    // a region is one grid, grids sharing a colour are never adjacent so they can be updated at the same time
+    std::array<std::unordered_map<uint32 /*gridId*/, CellRegion>, 4> colours;
+
+    auto addCell = [&](uint32 cellId, bool large)
+    {
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+
+        // grids are loaded up front, loading them from the region threads is not safe
+        if (!large || !_stagedGridLoading)
+            EnsureGridLoaded(cell);
+        else if (!IsGridLoaded(GridCoord(cell.GridX(), cell.GridY())))
+            return;
+
+        uint32 colour = (cell.GridX() & 1) | ((cell.GridY() & 1) << 1);
+        CellRegion& region = colours[colour][cell.GridX() * MAX_NUMBER_OF_GRIDS + cell.GridY()];
+        (large ? region.LargeCells : region.Cells).push_back(cellId);
+    };
+
+    for (uint32 cellId : _regionCells)
+        addCell(cellId, false);
+
+    for (uint32 cellId : _regionLargeCells)
+        addCell(cellId, true);
+
+    _regionCells.clear();
+    _regionLargeCells.clear();
+
+    auto updateRegion = [this, t_diff](CellRegion const& region)
+    {
+        Acore::ObjectUpdater updater(t_diff, false);
+        TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
+        TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
+
+        Acore::ObjectUpdater largeObjectUpdater(t_diff, true);
+        TypeContainerVisitor<Acore::ObjectUpdater, GridTypeMapContainer  > grid_large_object_update(largeObjectUpdater);
+        TypeContainerVisitor<Acore::ObjectUpdater, WorldTypeMapContainer  > world_large_object_update(largeObjectUpdater);
+
+        for (uint32 cellId : region.Cells)
+        {
+            Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+            Visit(cell, grid_object_update);
+            Visit(cell, world_object_update);
+        }
+
+        for (uint32 cellId : region.LargeCells)
+        {
+            Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+            cell.SetNoCreate();
+            Visit(cell, grid_large_object_update);
+            Visit(cell, world_large_object_update);
+        }
+    };
+
+    // side effects on map-wide containers are serialized by AcquireRegionUpdateLock() and applied
+    // by the usual deferred processing (move lists, remove lists, delayed visibility) after this pass
+    _regionUpdateActive = true;
+
+    std::vector<MapRegionUpdater::RegionTask> tasks;
+    for (auto const& colour : colours)
+    {
+        tasks.clear();
+        tasks.reserve(colour.size());
+
+        for (auto const& [gridId, region] : colour)
+            tasks.push_back([&updateRegion, &region]() { updateRegion(region); });
+
+        sMapMgr->GetRegionUpdater()->Execute(tasks);
+    }
+
+    _regionUpdateActive = false;
+}
+
+void Map::AddObjectForDelayedVisibility(Unit* unit)
+{
+    auto guard = AcquireRegionUpdateLock();
+    if (unit->m_delayedVisibilityQueued)
+        return;
+
+    unit->m_delayedVisibilityQueued = true;
+    i_objectsForDelayedVisibility.push_back(unit);
 }
 
 void Map::HandleDelayedVisibility()
 {
     if (i_objectsForDelayedVisibility.empty())
         return;
-    for (std::unordered_set<Unit*>::iterator itr = i_objectsForDelayedVisibility.begin(); itr != i_objectsForDelayedVisibility.end(); ++itr)
-        (*itr)->ExecuteDelayedUnitRelocationEvent();
+
+    for (std::size_t i = 0; i < i_objectsForDelayedVisibility.size(); ++i)
+    {
+        Unit* unit = i_objectsForDelayedVisibility[i];
+        unit->m_delayedVisibilityQueued = false;
+        unit->ExecuteDelayedUnitRelocationEvent(&_relocatedCreatures);
+    }
+
     i_objectsForDelayedVisibility.clear();
+
+    NotifyRelocatedCreatures();
+}
+
+void Map::NotifyRelocatedCreatures()
+{
+    if (_relocatedCreatures.empty())
+        return;
+
+    auto cellOf = [](Creature const* creature)
+    {
+        return Acore::ComputeCellCoord(creature->GetPositionX(), creature->GetPositionY());
+    };
+
+    // creatures of a pack moving together end up next to each other
+    std::sort(_relocatedCreatures.begin(), _relocatedCreatures.end(), [&cellOf](Creature const* left, Creature const* right)
+    {
+        CellCoord const l = cellOf(left);
+        CellCoord const r = cellOf(right);
+        return l.y_coord != r.y_coord ? l.y_coord < r.y_coord : l.x_coord < r.x_coord;
+    });
+
+    std::vector<std::pair<Creature*, CellArea>> group;
+    for (std::size_t begin = 0, end = 0; begin < _relocatedCreatures.size(); begin = end)
+    {
+        CellCoord const standing = cellOf(_relocatedCreatures[begin]);
+        for (end = begin + 1; end < _relocatedCreatures.size() && cellOf(_relocatedCreatures[end]) == standing; ++end) { }
+
+        // a creature alone in its cell searches exactly like before
+        if (end - begin == 1)
+        {
+            Creature* creature = _relocatedCreatures[begin];
+            if (!creature->IsInWorld() || creature->IsDuringRemoveFromWorld())
+                continue;
+
+            Acore::CreatureRelocationNotifier relocate(*creature);
+            Cell::VisitWorldObjects(creature, relocate, creature->GetVisibilityRange() + VISIBILITY_COMPENSATION);
+            continue;
+        }
+
+        // the area every creature would have searched on its own, same radius as Cell::Visit
+        group.clear();
+        CellArea total(standing, standing);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Creature* creature = _relocatedCreatures[i];
+            float const radius = std::min<float>(creature->GetVisibilityRange() + VISIBILITY_COMPENSATION + creature->GetCombatReach(), SIZE_OF_GRIDS);
+            CellArea const area = Cell::CalculateCellArea(creature->GetPositionX(), creature->GetPositionY(), radius);
+
+            total.low_bound.x_coord = std::min(total.low_bound.x_coord, area.low_bound.x_coord);
+            total.low_bound.y_coord = std::min(total.low_bound.y_coord, area.low_bound.y_coord);
+            total.high_bound.x_coord = std::max(total.high_bound.x_coord, area.high_bound.x_coord);
+            total.high_bound.y_coord = std::max(total.high_bound.y_coord, area.high_bound.y_coord);
+            group.emplace_back(creature, area);
+        }
+
+        Acore::CreatureRelocationBatchNotifier relocate(group);
+        TypeContainerVisitor<Acore::CreatureRelocationBatchNotifier, WorldTypeMapContainer> visitor(relocate);
+        for (uint32 x = total.low_bound.x_coord; x <= total.high_bound.x_coord; ++x)
+        {
+            for (uint32 y = total.low_bound.y_coord; y <= total.high_bound.y_coord; ++y)
+            {
+                CellCoord cellCoord(x, y);
+                Cell cell(cellCoord);
+                cell.SetNoCreate();
+                Visit(cell, visitor);
+            }
+        }
+    }
+
+    _relocatedCreatures.clear();
 }
 
 struct ResetNotifier
@@ -938,6 +1474,8 @@ void Map::AfterPlayerUnlinkFromMap()
 template<class T>
 void Map::RemoveFromMap(T* obj, bool remove)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     bool inWorld = obj->IsInWorld() && obj->GetTypeId() >= TYPEID_UNIT && obj->GetTypeId() <= TYPEID_GAMEOBJECT;
     obj->RemoveFromWorld();
 
@@ -1014,8 +1552,8 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float o)
 
     player->Relocate(x, y, z, o);
     if (player->IsVehicle())
-        player->GetVehicleKit()->RelocatePassengers();
-    player->UpdatePositionData();
+        AddVehicleToPassengerRelocation(player);
+    player->UpdatePositionDataIfMoved();
     player->UpdateObjectVisibility(false);
 }
 
@@ -1036,7 +1574,7 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
 
     creature->Relocate(x, y, z, o);
     if (creature->IsVehicle())
-        creature->GetVehicleKit()->RelocatePassengers();
+        AddVehicleToPassengerRelocation(creature);
     creature->UpdatePositionData();
     creature->UpdateObjectVisibility(false);
 }
@@ -1082,8 +1620,40 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
     dynObj->UpdateObjectVisibility(false);
 }
 
+void Map::AddVehicleToPassengerRelocation(Unit* vehicle)
+{
+    auto guard = AcquireRegionUpdateLock();
+    _vehiclesToRelocatePassengers.insert(vehicle->GetGUID());
+}
+
+void Map::RelocateVehiclePassengers()
+{
+    // passengers that are vehicles themselves queue their own passengers while this runs
+    while (!_vehiclesToRelocatePassengers.empty())
+    {
+        GuidUnorderedSet vehicles;
+        vehicles.swap(_vehiclesToRelocatePassengers);
+
+        for (ObjectGuid const& guid : vehicles)
+        {
+            Unit* vehicle = nullptr;
+            if (guid.IsPlayer())
+                vehicle = ObjectAccessor::GetPlayer(this, guid);
+            else if (guid.IsPet())
+                vehicle = _objectsStore.Find<Pet>(guid);
+            else
+                vehicle = _objectsStore.Find<Creature>(guid);
+
+            if (vehicle && vehicle->IsInWorld() && vehicle->IsVehicle())
+                vehicle->GetVehicleKit()->RelocatePassengers();
+        }
+    }
+}
+
 void Map::AddCreatureToMoveList(Creature* c)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _creaturesToMove.push_back(c);
     c->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1091,12 +1661,16 @@ void Map::AddCreatureToMoveList(Creature* c)
 
 void Map::RemoveCreatureFromMoveList(Creature* c)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     if (c->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         c->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
 
 void Map::AddGameObjectToMoveList(GameObject* go)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _gameObjectsToMove.push_back(go);
     go->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1104,12 +1678,16 @@ void Map::AddGameObjectToMoveList(GameObject* go)
 
 void Map::RemoveGameObjectFromMoveList(GameObject* go)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     if (go->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         go->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_NONE)
         _dynamicObjectsToMove.push_back(dynObj);
     dynObj->_moveState = MAP_OBJECT_CELL_MOVE_ACTIVE;
@@ -1117,6 +1695,8 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj)
 
 void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     if (dynObj->_moveState == MAP_OBJECT_CELL_MOVE_ACTIVE)
         dynObj->_moveState = MAP_OBJECT_CELL_MOVE_INACTIVE;
 }
@@ -1247,6 +1827,8 @@ bool Map::UnloadGrid(NGridType& ngrid)
         // x and y are swapped
         VMAP::VMapFactory::createOrGetVMapMgr()->unloadMap(GetId(), gx, gy);
         MMAP::MMapFactory::createOrGetMMapMgr()->unloadMap(GetId(), gx, gy);
+        if (CollisionQueryCache* cache = GetCollisionCache())
+            cache->Clear();
     }
 
     GridMaps[gx][gy] = nullptr;
@@ -1274,15 +1856,33 @@ void Map::RemoveAllPlayers()
 
 void Map::UnloadAll()
 {
+    SaveRespawnTimes();
+    SaveCorpseData();
+
     // clear all delayed moves, useless anyway do this moves before map unload.
     _creaturesToMove.clear();
     _gameObjectsToMove.clear();
 
+    auto const unloadStart = std::chrono::steady_clock::now();
+    uint32 gridUnloads = 0;
+
     for (GridRefMgr<NGridType>::iterator i = GridRefMgr<NGridType>::begin(); i != GridRefMgr<NGridType>::end();)
     {
         NGridType& grid(*i->GetSource());
         ++i;
         UnloadGrid(grid); // deletes the grid and removes it from the GridRefMgr
+        ++gridUnloads;
+    }
+
+    if (gridUnloads)
+    {
+        METRIC_VALUE("map_grid_unloads", uint64(gridUnloads),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+        METRIC_VALUE("map_grid_unload_time", std::chrono::steady_clock::now() - unloadStart,
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
     }
 
     // pussywizard: crashfix, some npc can be left on transport (not a default passenger)
@@ -1313,6 +1913,8 @@ void Map::UnloadAll()
     _corpsesByCell.clear();
     _corpsesByPlayer.clear();
     _corpseBones.clear();
+    _corpseExpiryQueue.clear();
+    _corpseExpiryEntries.clear();
 }
 
 // *****************************
@@ -1343,9 +1945,15 @@ GridMap::GridMap()
     _liquidEntry = nullptr;
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
+    _liquidRunLevels = nullptr;
+    _liquidRunStarts = nullptr;
+    _liquidRowRuns = nullptr;
     _holes = nullptr;
+    _memoryUsage = 0;
 }
 
+std::atomic<std::size_t> GridMap::_loadedBytes{0};
+
 GridMap::~GridMap()
 {
     unloadData();
@@ -1356,6 +1964,15 @@ bool GridMap::loadData(char* filename)
     // Unload old data if exist
     unloadData();
 
+    // a failed load keeps what it read so far until the next unload
+    bool result = readData(filename);
+    _memoryUsage = GetMemoryUsage();
+    _loadedBytes += _memoryUsage;
+    return result;
+}
+
+bool GridMap::readData(char* filename)
+{
     map_fileheader header;
     // Not return error if file not found
     FILE* in = fopen(filename, "rb");
@@ -1408,6 +2025,9 @@ bool GridMap::loadData(char* filename)
 
 void GridMap::unloadData()
 {
+    _loadedBytes -= _memoryUsage;
+    _memoryUsage = 0;
+
     delete[] _areaMap;
     delete[] m_V9;
     delete[] m_V8;
@@ -1416,6 +2036,9 @@ void GridMap::unloadData()
     delete[] _liquidEntry;
     delete[] _liquidFlags;
     delete[] _liquidMap;
+    delete[] _liquidRunLevels;
+    delete[] _liquidRunStarts;
+    delete[] _liquidRowRuns;
     delete[] _holes;
     _areaMap = nullptr;
     m_V9 = nullptr;
@@ -1425,10 +2048,46 @@ void GridMap::unloadData()
     _liquidEntry = nullptr;
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
+    _liquidRunLevels = nullptr;
+    _liquidRunStarts = nullptr;
+    _liquidRowRuns = nullptr;
     _holes = nullptr;
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
+std::size_t GridMap::GetMemoryUsage() const
+{
+    std::size_t size = 0;
+    if (_areaMap)
+        size += 16 * 16 * sizeof(uint16);
+
+    if (_gridGetHeight == &GridMap::getHeightFromFloat)
+        size += (129 * 129 + 128 * 128) * sizeof(float);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint16)
+        size += (129 * 129 + 128 * 128) * sizeof(uint16);
+    else if (_gridGetHeight == &GridMap::getHeightFromUint8)
+        size += (129 * 129 + 128 * 128) * sizeof(uint8);
+
+    if (_maxHeight)
+        size += 2 * 3 * 3 * sizeof(int16);
+
+    if (_liquidEntry)
+        size += 16 * 16 * sizeof(uint16);
+
+    if (_liquidFlags)
+        size += 16 * 16 * sizeof(uint8);
+
+    if (_liquidMap)
+        size += std::size_t(_liquidWidth) * _liquidHeight * sizeof(float);
+    else if (_liquidRowRuns)
+        size += _liquidRowRuns[_liquidHeight] * (sizeof(float) + sizeof(uint8)) + (_liquidHeight + 1) * sizeof(uint16);
+
+    if (_holes)
+        size += 16 * 16 * sizeof(uint16);
+
+    return size;
+}
+
 bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     map_areaHeader header;
@@ -1486,6 +2145,7 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
                     fread(m_V8, sizeof(float), 128 * 128, in) != 128 * 128)
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
+            compactFloatHeights();
         }
     }
     else
@@ -1534,10 +2194,105 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
         _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
         if (fread(_liquidMap, sizeof(float), _liquidWidth * _liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
             return false;
+
+        compactLiquidMap();
     }
     return true;
 }
 
+// Float height maps whose range fits the precision map_extractor accepts for
+// MAP_HEIGHT_AS_INT16 are kept as uint16 in memory, at half the size
+void GridMap::compactFloatHeights()
+{
+    float minHeight = m_V9[0];
+    float maxHeight = m_V9[0];
+    for (uint32 i = 0; i < 129 * 129; ++i)
+    {
+        minHeight = std::min(minHeight, m_V9[i]);
+        maxHeight = std::max(maxHeight, m_V9[i]);
+    }
+    for (uint32 i = 0; i < 128 * 128; ++i)
+    {
+        minHeight = std::min(minHeight, m_V8[i]);
+        maxHeight = std::max(maxHeight, m_V8[i]);
+    }
+
+    if (!(maxHeight - minHeight < GRID_HEIGHT_INT16_LIMIT))
+        return;
+
+    float multiplier = (maxHeight - minHeight) / 65535;
+    auto quantize = [&](float height) { return multiplier > 0.0f ? uint16((height - minHeight) / multiplier + 0.5f) : uint16(0); };
+
+    uint16* v9 = new uint16[129 * 129];
+    uint16* v8 = new uint16[128 * 128];
+    for (uint32 i = 0; i < 129 * 129; ++i)
+        v9[i] = quantize(m_V9[i]);
+    for (uint32 i = 0; i < 128 * 128; ++i)
+        v8[i] = quantize(m_V8[i]);
+
+    delete[] m_V9;
+    delete[] m_V8;
+    m_uint16_V9 = v9;
+    m_uint16_V8 = v8;
+    _gridHeight = minHeight;
+    _gridIntHeightMultiplier = multiplier;
+    _gridGetHeight = &GridMap::getHeightFromUint16;
+}
+
+// Liquid height maps are mostly rows of equal levels, they are stored as runs
+// when that takes at most half the memory of the dense map
+void GridMap::compactLiquidMap()
+{
+    uint32 width = _liquidWidth;
+    uint32 height = _liquidHeight;
+    if (!width || !height)
+        return;
+
+    uint32 runs = 0;
+    for (uint32 row = 0; row < height; ++row)
+        for (uint32 col = 0; col < width; ++col)
+            if (!col || _liquidMap[row * width + col] != _liquidMap[row * width + col - 1])
+                ++runs;
+
+    if (runs * (sizeof(float) + sizeof(uint8)) + (height + 1) * sizeof(uint16) > width * height * sizeof(float) / 2)
+        return;
+
+    _liquidRunLevels = new float[runs];
+    _liquidRunStarts = new uint8[runs];
+    _liquidRowRuns = new uint16[height + 1];
+
+    uint32 run = 0;
+    for (uint32 row = 0; row < height; ++row)
+    {
+        _liquidRowRuns[row] = uint16(run);
+        for (uint32 col = 0; col < width; ++col)
+        {
+            if (!col || _liquidMap[row * width + col] != _liquidMap[row * width + col - 1])
+            {
+                _liquidRunLevels[run] = _liquidMap[row * width + col];
+                _liquidRunStarts[run] = uint8(col);
+                ++run;
+            }
+        }
+    }
+    _liquidRowRuns[height] = uint16(run);
+
+    delete[] _liquidMap;
+    _liquidMap = nullptr;
+}
+
+float GridMap::getLiquidMapLevel(int row, int col) const
+{
+    if (_liquidMap)
+        return _liquidMap[row * _liquidWidth + col];
+
+    // every row has a run starting at column 0, take the last one starting at or before col
+    uint8 const* begin = _liquidRunStarts + _liquidRowRuns[row];
+    uint8 const* end = _liquidRunStarts + _liquidRowRuns[row + 1];
+    uint8 const* run = std::upper_bound(begin, end, uint8(col)) - 1;
+    return _liquidRunLevels[run - _liquidRunStarts];
+}
+
 bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
 {
     if (fseek(in, offset, SEEK_SET) != 0)
@@ -1869,7 +2624,7 @@ float GridMap::getMinHeight(float x, float y) const
 
 float GridMap::getLiquidLevel(float x, float y) const
 {
-    if (!_liquidMap)
+    if (!hasLiquidMap())
         return _liquidLevel;
 
     x = MAP_RESOLUTION * (32 - x / SIZE_OF_GRIDS);
@@ -1883,7 +2638,7 @@ float GridMap::getLiquidLevel(float x, float y) const
     if (cy_int < 0 || cy_int >= _liquidWidth)
         return INVALID_HEIGHT;
 
-    return _liquidMap[cx_int * _liquidWidth + cy_int];
+    return getLiquidMapLevel(cx_int, cy_int);
 }
 
 // Get water state on map
@@ -1942,7 +2697,7 @@ inline LiquidData const GridMap::GetLiquidData(float x, float y, float z, float
             if (lx_int >= 0 && lx_int < _liquidHeight && ly_int >= 0 && ly_int < _liquidWidth)
             {
                 // Get water level
-                float liquid_level = _liquidMap ? _liquidMap[lx_int * _liquidWidth + ly_int] : _liquidLevel;
+                float liquid_level = hasLiquidMap() ? getLiquidMapLevel(lx_int, ly_int) : _liquidLevel;
                 // Get ground level
                 float ground_level = getHeight(x, y);
 
@@ -1995,21 +2750,26 @@ float Map::GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, fl
         if (ground)
             *ground = ground_z;
 
-        LiquidData const& liquidData = const_cast<Map*>(this)->GetLiquidData(phasemask, x, y, ground_z, collisionHeight, MAP_ALL_LIQUIDS);
-        switch (liquidData.Status)
-        {
-            case LIQUID_MAP_ABOVE_WATER:
-                return std::max<float>(liquidData.Level, ground_z);
-            case LIQUID_MAP_NO_WATER:
-                return ground_z;
-            default:
-                return liquidData.Level;
-        }
+        return GetWaterOrGroundLevelAboveFloor(phasemask, x, y, ground_z, collisionHeight);
     }
 
     return VMAP_INVALID_HEIGHT_VALUE;
 }
 
+float Map::GetWaterOrGroundLevelAboveFloor(uint32 phasemask, float x, float y, float groundZ, float collisionHeight) const
+{
+    LiquidData const& liquidData = const_cast<Map*>(this)->GetLiquidData(phasemask, x, y, groundZ, collisionHeight, MAP_ALL_LIQUIDS);
+    switch (liquidData.Status)
+    {
+        case LIQUID_MAP_ABOVE_WATER:
+            return std::max<float>(liquidData.Level, groundZ);
+        case LIQUID_MAP_NO_WATER:
+            return groundZ;
+        default:
+            return liquidData.Level;
+    }
+}
+
 Transport* Map::GetTransportForPos(uint32 phase, float x, float y, float z, WorldObject* worldobject)
 {
     G3D::Vector3 v(x, y, z + 2.0f);
@@ -2037,21 +2797,14 @@ Transport* Map::GetTransportForPos(uint32 phase, float x, float y, float z, Worl
     return nullptr;
 }
 
-float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+// picks the floor under z from the .map grid height and the vmap height
+static float SelectFloorHeight(float z, float gridHeight, float vmapHeight)
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    float gridHeight = GetGridHeight(x, y);
     if (G3D::fuzzyGe(z, gridHeight - GROUND_HEIGHT_TOLERANCE))
         mapHeight = gridHeight;
 
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    if (checkVMap)
-    {
-        VMAP::IVMapMgr* vmgr = VMAP::VMapFactory::createOrGetVMapMgr();
-        vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);   // look from a bit higher pos to find the floor
-    }
-
     // mapHeight set for any above raw ground Z or <= INVALID_HEIGHT
     // vmapheight set for any under Z value or <= INVALID_HEIGHT
     if (vmapHeight > INVALID_HEIGHT)
@@ -2074,6 +2827,26 @@ float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float
     return mapHeight;                               // explicitly use map data
 }
 
+float Map::GetHeight(float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    float gridHeight = GetGridHeight(x, y);
+
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
+    if (checkVMap)
+    {
+        CollisionQueryCache* cache = GetCollisionCache();
+        if (!cache || !cache->FindHeight(x, y, z, maxSearchDist, vmapHeight))
+        {
+            VMAP::IVMapMgr* vmgr = VMAP::VMapFactory::createOrGetVMapMgr();
+            vmapHeight = vmgr->getHeight(GetId(), x, y, z, maxSearchDist);   // look from a bit higher pos to find the floor
+            if (cache)
+                cache->StoreHeight(x, y, z, maxSearchDist, vmapHeight);
+        }
+    }
+
+    return SelectFloorHeight(z, gridHeight, vmapHeight);
+}
+
 float Map::GetGridHeight(float x, float y) const
 {
     if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
@@ -2110,7 +2883,30 @@ bool Map::GetAreaInfo(uint32 phaseMask, float x, float y, float z, uint32& flags
     int32 drootId;
     int32 dgroupId;
 
-    bool hasVmapAreaInfo = vmgr->GetAreaInfo(GetId(), x, y, vmap_z, vflags, vadtId, vrootId, vgroupId);
+    bool hasVmapAreaInfo;
+    CollisionQueryCache::AreaInfo cached;
+    CollisionQueryCache* cache = GetCollisionCache();
+    if (cache && cache->FindAreaInfo(x, y, z, cached))
+    {
+        hasVmapAreaInfo = cached.Found;
+        vmap_z = cached.Z;
+        vflags = cached.Flags;
+        vadtId = cached.AdtId;
+        vrootId = cached.RootId;
+        vgroupId = cached.GroupId;
+    }
+    else
+    {
+        hasVmapAreaInfo = vmgr->GetAreaInfo(GetId(), x, y, vmap_z, vflags, vadtId, vrootId, vgroupId);
+        if (cache)
+        {
+            if (hasVmapAreaInfo)
+                cache->StoreAreaInfo(x, y, z, { true, vmap_z, vflags, vadtId, vrootId, vgroupId });
+            else
+                cache->StoreAreaInfo(x, y, z, { false, vmap_z, 0, 0, 0, 0 });
+        }
+    }
+
     bool hasDynamicAreaInfo = _dynamicTree.GetAreaInfo(x, y, dynamic_z, phaseMask, dflags, dadtId, drootId, dgroupId);
     auto useVmap = [&]() { check_z = vmap_z; flags = vflags; adtId = vadtId; rootId = vrootId; groupId = vgroupId; };
     auto useDyn = [&]() { check_z = dynamic_z; flags = dflags; adtId = dadtId; rootId = drootId; groupId = dgroupId; };
@@ -2425,17 +3221,69 @@ void Map::GetFullTerrainStatusForPosition(uint32 /*phaseMask*/, float x, float y
             data.liquidInfo.Entry = liquidEntry;
         }
     }
-}
+}
+
+float Map::GetWaterLevel(float x, float y) const
+{
+    if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
+        return gmap->getLiquidLevel(x, y);
+    else
+        return 0;
+}
+
+bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    if (!sWorld->getBoolConfig(CONFIG_VMAP_BLIZZLIKE_PVP_LOS))
+    {
+        if (IsBattlegroundOrArena())
+        {
+            ignoreFlags = VMAP::ModelIgnoreFlags::Nothing;
+        }
+    }
+
+    if (!sWorld->getBoolConfig(CONFIG_VMAP_BLIZZLIKE_LOS_OPEN_WORLD))
+    {
+        if (IsWorldMap())
+        {
+            ignoreFlags = VMAP::ModelIgnoreFlags::Nothing;
+        }
+    }
+
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        bool inSight;
+        CollisionQueryCache* cache = GetCollisionCache();
+        if (!cache || !cache->FindLineOfSight(x1, y1, z1, x2, y2, z2, uint32(ignoreFlags), inSight))
+        {
+            inSight = VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags);
+            if (cache)
+                cache->StoreLineOfSight(x1, y1, z1, x2, y2, z2, uint32(ignoreFlags), inSight);
+        }
+
+        if (!inSight)
+        {
+            return false;
+        }
+    }
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT_ALL))
+    {
+        ignoreFlags = VMAP::ModelIgnoreFlags::Nothing;
+        if (!(checks & LINEOFSIGHT_CHECK_GOBJECT_M2))
+        {
+            ignoreFlags = VMAP::ModelIgnoreFlags::M2;
+        }
+
+        if (!_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, ignoreFlags))
+        {
+            return false;
+        }
+    }
 
-float Map::GetWaterLevel(float x, float y) const
-{
-    if (GridMap* gmap = const_cast<Map*>(this)->GetGrid(x, y))
-        return gmap->getLiquidLevel(x, y);
-    else
-        return 0;
+    return true;
 }
 
-bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+void Map::isInLineOfSight(std::vector<VMAP::LineOfSightQuery>& queries, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if (!sWorld->getBoolConfig(CONFIG_VMAP_BLIZZLIKE_PVP_LOS))
     {
@@ -2453,9 +3301,16 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
         }
     }
 
-    if ((checks & LINEOFSIGHT_CHECK_VMAP) && !VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
     {
-        return false;
+        VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), queries, ignoreFlags);
+    }
+    else
+    {
+        for (VMAP::LineOfSightQuery& query : queries)
+        {
+            query.InSight = true;
+        }
     }
 
     if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT_ALL))
@@ -2466,13 +3321,14 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
             ignoreFlags = VMAP::ModelIgnoreFlags::M2;
         }
 
-        if (!_dynamicTree.isInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, ignoreFlags))
+        for (VMAP::LineOfSightQuery& query : queries)
         {
-            return false;
+            if (query.InSight)
+            {
+                query.InSight = _dynamicTree.isInLineOfSight(query.X1, query.Y1, query.Z1, query.X2, query.Y2, query.Z2, phasemask, ignoreFlags);
+            }
         }
     }
-
-    return true;
 }
 
 bool Map::GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
@@ -2497,6 +3353,65 @@ float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=tr
     return std::max<float>(h1, h2);
 }
 
+void Map::GetHeight(uint32 phasemask, std::vector<VMAP::HeightQuery>& queries, bool vmap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
+{
+    // grid heights first, that also loads the vmap tiles the points are in
+    std::vector<float> gridHeights(queries.size(), VMAP_INVALID_HEIGHT_VALUE);
+    GridMap* gmap = nullptr;
+    int lastGx = -1, lastGy = -1;
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        VMAP::HeightQuery const& query = queries[i];
+        int gx = (int)(32 - query.X / SIZE_OF_GRIDS);
+        int gy = (int)(32 - query.Y / SIZE_OF_GRIDS);
+        if (gx != lastGx || gy != lastGy)
+        {
+            gmap = const_cast<Map*>(this)->GetGrid(query.X, query.Y);
+            lastGx = gx;
+            lastGy = gy;
+        }
+
+        if (gmap)
+            gridHeights[i] = gmap->getHeight(query.X, query.Y);
+    }
+
+    // vmap heights of the points the collision cache does not know, traced together
+    std::vector<float> vmapHeights(queries.size(), VMAP_INVALID_HEIGHT_VALUE);
+    if (vmap)
+    {
+        CollisionQueryCache* cache = GetCollisionCache();
+        std::vector<VMAP::HeightQuery> misses;
+        std::vector<std::size_t> missIndices;
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            VMAP::HeightQuery const& query = queries[i];
+            if (!cache || !cache->FindHeight(query.X, query.Y, query.Z, maxSearchDist, vmapHeights[i]))
+            {
+                misses.push_back({ query.X, query.Y, query.Z });
+                missIndices.push_back(i);
+            }
+        }
+
+        if (!misses.empty())
+        {
+            VMAP::VMapFactory::createOrGetVMapMgr()->getHeight(GetId(), misses, maxSearchDist);
+            for (std::size_t i = 0; i < misses.size(); ++i)
+            {
+                vmapHeights[missIndices[i]] = misses[i].Height;
+                if (cache)
+                    cache->StoreHeight(misses[i].X, misses[i].Y, misses[i].Z, maxSearchDist, misses[i].Height);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        VMAP::HeightQuery& query = queries[i];
+        float staticHeight = SelectFloorHeight(query.Z, gridHeights[i], vmapHeights[i]);
+        query.Height = std::max<float>(staticHeight, _dynamicTree.getHeight(query.X, query.Y, query.Z, maxSearchDist, phasemask));
+    }
+}
+
 bool Map::IsInWater(uint32 phaseMask, float x, float y, float pZ, float collisionHeight) const
 {
     LiquidData const& liquidData = const_cast<Map*>(this)->GetLiquidData(phaseMask, x, y, pZ, collisionHeight, MAP_ALL_LIQUIDS);
@@ -2583,7 +3498,7 @@ void Map::SendRemoveTransports(Player* player)
             (*itr)->BuildOutOfRangeUpdateBlock(&transData);
 
     // pussywizard: remove static transports from client
-    for (GuidUnorderedSet::const_iterator it = player->m_clientGUIDs.begin(); it != player->m_clientGUIDs.end(); )
+    for (GuidFlatSet::const_iterator it = player->m_clientGUIDs.begin(); it != player->m_clientGUIDs.end(); )
     {
         if ((*it).IsTransport())
         {
@@ -2609,26 +3524,171 @@ inline void Map::setNGrid(NGridType* grid, uint32 x, uint32 y)
     i_grids[x][y] = grid;
 }
 
-void Map::SendObjectUpdates()
+void Map::AddToCreatureEntryIndex(Creature* creature, uint32 entry)
+{
+    auto guard = AcquireRegionUpdateLock();
+    _creatureEntryIndex[entry].push_back(creature);
+}
+
+void Map::RemoveFromCreatureEntryIndex(Creature* creature, uint32 entry)
+{
+    auto guard = AcquireRegionUpdateLock();
+    auto itr = _creatureEntryIndex.find(entry);
+    if (itr == _creatureEntryIndex.end())
+        return;
+
+    std::vector<Creature*>& creatures = itr->second;
+    auto creatureItr = std::find(creatures.begin(), creatures.end(), creature);
+    if (creatureItr != creatures.end())
+    {
+        *creatureItr = creatures.back();
+        creatures.pop_back();
+    }
+
+    if (creatures.empty())
+        _creatureEntryIndex.erase(itr);
+}
+
+bool Map::GetCreaturesWithEntryInRange(std::list<Creature*>& creatures, WorldObject const* center, uint32 entry, float range) const
+{
+    // creatures of other cell regions may be moving right now, only the grid around the center is safe to read
+    if (_regionUpdateActive)
+        return false;
+
+    auto itr = _creatureEntryIndex.find(entry);
+    if (itr == _creatureEntryIndex.end())
+        return true;
+
+    if (itr->second.size() > MAX_CREATURE_ENTRY_INDEX_SCAN)
+        return false;
+
+    // same result as a CreatureListSearcher over the grid, which does not see world objects (player pets and such)
+    Acore::AllCreaturesOfEntryInRange check(center, entry, range);
+    for (Creature* creature : itr->second)
+        if (!creature->IsWorldObject() && creature->InSamePhase(center->GetPhaseMask()) && check(creature))
+            creatures.push_back(creature);
+
+    return true;
+}
+
+void Map::QueueCombatLog(Unit const* source, WorldPacket const& data)
+{
+    auto guard = AcquireRegionUpdateLock();
+    _combatLogs.emplace_back(source->GetGUID(), WorldSession::MakeSharedPacket(data));
+}
+
+void Map::SendCombatLogs()
+{
+    if (_combatLogs.empty())
+        return;
+
+    // group the logs by unit, keeping the order in which each unit produced them
+    std::stable_sort(_combatLogs.begin(), _combatLogs.end(), [](auto const& left, auto const& right)
+    {
+        return left.first < right.first;
+    });
+
+    float const range = sWorld->getFloatConfig(CONFIG_COMBAT_LOG_RANGE);
+    uint32 sources = 0;
+    uint32 delivered = 0;
+
+    for (auto itr = _combatLogs.begin(); itr != _combatLogs.end();)
+    {
+        ObjectGuid guid = itr->first;
+        _combatLogsBatch.clear();
+        for (; itr != _combatLogs.end() && itr->first == guid; ++itr)
+            _combatLogsBatch.push_back(std::move(itr->second));
+
+        Unit* source = nullptr;
+        if (guid.IsPlayer())
+            source = ObjectAccessor::GetPlayer(this, guid);
+        else if (guid.IsPet())
+            source = GetPet(guid);
+        else
+            source = GetCreature(guid);
+
+        // units that left the map in the meantime lose their last logs
+        if (source)
+        {
+            delivered += source->SendMessagesToSet(_combatLogsBatch, true, range);
+            ++sources;
+        }
+    }
+
+    METRIC_VALUE("map_combat_log_events", uint64(_combatLogs.size()),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_combat_log_sources", uint64(sources),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_combat_log_packets", uint64(delivered),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    _combatLogs.clear();
+    _combatLogsBatch.clear();
+}
+
+void Map::AddUpdateObject(Object* obj)
+{
+    auto guard = AcquireRegionUpdateLock();
+    obj->SetUpdateQueueIndex(_updateObjects.size());
+    _updateObjects.push_back(obj);
+}
+
+void Map::RemoveUpdateObject(Object* obj)
 {
-    UpdateDataMapType update_players;
-    UpdatePlayerSet player_set;
+    auto guard = AcquireRegionUpdateLock();
+
+    uint32 const index = obj->GetUpdateQueueIndex();
+    if (index < _updateObjects.size() && _updateObjects[index] == obj)
+    {
+        _updateObjects[index] = _updateObjects.back();
+        _updateObjects[index]->SetUpdateQueueIndex(index);
+        _updateObjects.pop_back();
+    }
+    else if (index < _updateObjectsBatch.size() && _updateObjectsBatch[index] == obj)
+        _updateObjectsBatch[index] = nullptr;   // removed while SendObjectUpdates builds its batch
+}
 
+void Map::SendObjectUpdates()
+{
+    // objects can be queued again while building, drain the queue in batches
     while (!_updateObjects.empty())
     {
-        Object* obj = *_updateObjects.begin();
-        ASSERT(obj->IsInWorld());
+        _updateObjectsBatch.swap(_updateObjects);
+
+        for (std::size_t i = 0; i < _updateObjectsBatch.size(); ++i)
+        {
+            if (Object* obj = _updateObjectsBatch[i])
+            {
+                ASSERT(obj->IsInWorld());
+                obj->BuildUpdate(_updateDatas, _updatePlayerSet);
+            }
+        }
 
-        _updateObjects.erase(_updateObjects.begin());
-        obj->BuildUpdate(update_players, player_set);
+        _updateObjectsBatch.clear();
     }
 
     WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    for (auto iter = _updateDatas.begin(); iter != _updateDatas.end();)
     {
+        // players that got nothing this tick may have left the map, drop their buffers without touching them
+        if (!iter->second.HasData())
+        {
+            iter = _updateDatas.erase(iter);
+            continue;
+        }
+
         iter->second.BuildPacket(packet);
         iter->first->GetSession()->SendPacket(&packet);
         packet.clear();                                     // clean the string
+
+        // keep the UpdateData allocation for the next tick
+        iter->second.Clear();
+        ++iter;
     }
 }
 
@@ -2654,7 +3714,12 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
-    i_objectsToRemove.insert(obj);
+    auto guard = AcquireRegionUpdateLock();
+    if (obj->IsInRemoveList())
+        return;
+
+    obj->SetInRemoveList(true);
+    i_objectsToRemove.push_back(obj);
     //LOG_DEBUG("maps", "Object ({}) added to removing list.", obj->GetGUID().ToString());
 }
 
@@ -2666,6 +3731,7 @@ void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
     if (obj->GetTypeId() != TYPEID_UNIT && obj->GetTypeId() != TYPEID_GAMEOBJECT)
         return;
 
+    auto guard = AcquireRegionUpdateLock();
     std::map<WorldObject*, bool>::iterator itr = i_objectsToSwitch.find(obj);
     if (itr == i_objectsToSwitch.end())
         i_objectsToSwitch.insert(itr, std::make_pair(obj, on));
@@ -2701,11 +3767,11 @@ void Map::RemoveAllObjectsInRemoveList()
     }
 
     //LOG_DEBUG("maps", "Object remover 1 check.");
-    while (!i_objectsToRemove.empty())
+    // removals can queue more objects, e.g. the summons of a despawned creature
+    for (std::size_t i = 0; i < i_objectsToRemove.size(); ++i)
     {
-        std::unordered_set<WorldObject*>::iterator itr = i_objectsToRemove.begin();
-        WorldObject* obj = *itr;
-        i_objectsToRemove.erase(itr);
+        WorldObject* obj = i_objectsToRemove[i];
+        obj->SetInRemoveList(false);
 
         switch (obj->GetTypeId())
         {
@@ -2739,6 +3805,8 @@ void Map::RemoveAllObjectsInRemoveList()
         }
     }
 
+    i_objectsToRemove.clear();
+
     //LOG_DEBUG("maps", "Object remover 2 check.");
 }
 
@@ -2751,10 +3819,24 @@ uint32 Map::GetPlayersCountExceptGMs() const
     return count;
 }
 
+uint32 Map::GetLoadedGridCount() const
+{
+    uint32 count = 0;
+    for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
+        for (uint32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
+            if (i_grids[x][y])
+                ++count;
+    return count;
+}
+
 void Map::SendToPlayers(WorldPacket const* data) const
 {
+    if (m_mapRefMgr.IsEmpty())
+        return;
+
+    std::shared_ptr<WorldPacket const> sharedData = WorldSession::MakeSharedPacket(*data);
     for (MapRefMgr::const_iterator itr = m_mapRefMgr.begin(); itr != m_mapRefMgr.end(); ++itr)
-        itr->GetSource()->GetSession()->SendPacket(data);
+        itr->GetSource()->GetSession()->SendPacket(sharedData);
 }
 
 template<class T>
@@ -3028,6 +4110,9 @@ bool InstanceMap::AddPlayerToMap(Player* player)
 
 void InstanceMap::Update(const uint32 t_diff, const uint32 s_diff, bool /*thread*/)
 {
+    // the instance script shares the arena of the map update
+    Acore::TickArenaScope arenaScope;
+
     Map::Update(t_diff, s_diff);
 
     if (t_diff)
@@ -3308,21 +4393,25 @@ void BattlegroundMap::RemoveAllPlayers()
 
 Corpse* Map::GetCorpse(ObjectGuid const guid)
 {
+    auto guard = AcquireRegionUpdateLock();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const guid)
 {
+    auto guard = AcquireRegionUpdateLock();
     return _objectsStore.Find<Creature>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const guid)
 {
+    auto guard = AcquireRegionUpdateLock();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const guid)
 {
+    auto guard = AcquireRegionUpdateLock();
     return _objectsStore.Find<Pet>(guid);
 }
 
@@ -3337,6 +4426,7 @@ Transport* Map::GetTransport(ObjectGuid guid)
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid guid)
 {
+    auto guard = AcquireRegionUpdateLock();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
@@ -3359,7 +4449,16 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _creatureRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = AcquireRegionUpdateLock();
+        _creatureRespawnTimes[spawnId] = respawnTime;
+
+        if (sWorld->getIntConfig(CONFIG_RESPAWN_SAVE_INTERVAL))
+        {
+            _pendingCreatureRespawnSaves.insert(spawnId);
+            return;
+        }
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3371,7 +4470,16 @@ void Map::SaveCreatureRespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTi
 
 void Map::RemoveCreatureRespawnTime(ObjectGuid::LowType spawnId)
 {
-    _creatureRespawnTimes.erase(spawnId);
+    {
+        auto guard = AcquireRegionUpdateLock();
+        _creatureRespawnTimes.erase(spawnId);
+
+        if (sWorld->getIntConfig(CONFIG_RESPAWN_SAVE_INTERVAL))
+        {
+            _pendingCreatureRespawnSaves.insert(spawnId);
+            return;
+        }
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3393,7 +4501,16 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
     if (GetInstanceResetPeriod() > 0 && respawnTime - now + 5 >= GetInstanceResetPeriod())
         respawnTime = now + YEAR;
 
-    _goRespawnTimes[spawnId] = respawnTime;
+    {
+        auto guard = AcquireRegionUpdateLock();
+        _goRespawnTimes[spawnId] = respawnTime;
+
+        if (sWorld->getIntConfig(CONFIG_RESPAWN_SAVE_INTERVAL))
+        {
+            _pendingGORespawnSaves.insert(spawnId);
+            return;
+        }
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3405,7 +4522,16 @@ void Map::SaveGORespawnTime(ObjectGuid::LowType spawnId, time_t& respawnTime)
 
 void Map::RemoveGORespawnTime(ObjectGuid::LowType spawnId)
 {
-    _goRespawnTimes.erase(spawnId);
+    {
+        auto guard = AcquireRegionUpdateLock();
+        _goRespawnTimes.erase(spawnId);
+
+        if (sWorld->getIntConfig(CONFIG_RESPAWN_SAVE_INTERVAL))
+        {
+            _pendingGORespawnSaves.insert(spawnId);
+            return;
+        }
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
     stmt->SetData(0, spawnId);
@@ -3447,11 +4573,102 @@ void Map::LoadRespawnTimes()
     }
 }
 
+void Map::SaveRespawnTimes()
+{
+    std::unordered_set<ObjectGuid::LowType> creatureSaves;
+    std::unordered_set<ObjectGuid::LowType> goSaves;
+    std::vector<std::pair<ObjectGuid::LowType, time_t>> creatureTimes;
+    std::vector<std::pair<ObjectGuid::LowType, time_t>> goTimes;
+
+    {
+        auto guard = AcquireRegionUpdateLock();
+        if (_pendingCreatureRespawnSaves.empty() && _pendingGORespawnSaves.empty())
+            return;
+
+        creatureSaves.swap(_pendingCreatureRespawnSaves);
+        goSaves.swap(_pendingGORespawnSaves);
+
+        // Saved rows are moved out of the pending sets, those left are deletes
+        for (auto itr = creatureSaves.begin(); itr != creatureSaves.end();)
+        {
+            auto time = _creatureRespawnTimes.find(*itr);
+            if (time == _creatureRespawnTimes.end())
+            {
+                ++itr;
+                continue;
+            }
+
+            creatureTimes.emplace_back(*time);
+            itr = creatureSaves.erase(itr);
+        }
+
+        for (auto itr = goSaves.begin(); itr != goSaves.end();)
+        {
+            auto time = _goRespawnTimes.find(*itr);
+            if (time == _goRespawnTimes.end())
+            {
+                ++itr;
+                continue;
+            }
+
+            goTimes.emplace_back(*time);
+            itr = goSaves.erase(itr);
+        }
+    }
+
+    // Consecutive REPLACEs are sent as multi-row statements by the transaction
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+    for (auto const& [spawnId, respawnTime] : creatureTimes)
+    {
+        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_CREATURE_RESPAWN);
+        stmt->SetData(0, spawnId);
+        stmt->SetData(1, uint32(respawnTime));
+        stmt->SetData(2, GetId());
+        stmt->SetData(3, GetInstanceId());
+        trans->Append(stmt);
+    }
+
+    for (auto const& [spawnId, respawnTime] : goTimes)
+    {
+        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_REP_GO_RESPAWN);
+        stmt->SetData(0, spawnId);
+        stmt->SetData(1, uint32(respawnTime));
+        stmt->SetData(2, GetId());
+        stmt->SetData(3, GetInstanceId());
+        trans->Append(stmt);
+    }
+
+    for (ObjectGuid::LowType spawnId : creatureSaves)
+    {
+        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CREATURE_RESPAWN);
+        stmt->SetData(0, spawnId);
+        stmt->SetData(1, GetId());
+        stmt->SetData(2, GetInstanceId());
+        trans->Append(stmt);
+    }
+
+    for (ObjectGuid::LowType spawnId : goSaves)
+    {
+        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_GO_RESPAWN);
+        stmt->SetData(0, spawnId);
+        stmt->SetData(1, GetId());
+        stmt->SetData(2, GetInstanceId());
+        trans->Append(stmt);
+    }
+
+    CharacterDatabase.CommitTransaction(trans);
+}
+
 void Map::DeleteRespawnTimes()
 {
     _creatureRespawnTimes.clear();
     _goRespawnTimes.clear();
 
+    // Replaced by the bulk delete
+    _pendingCreatureRespawnSaves.clear();
+    _pendingGORespawnSaves.clear();
+
     DeleteRespawnTimesInDB(GetId(), GetInstanceId());
 }
 
@@ -3596,6 +4813,8 @@ time_t Map::GetLinkedRespawnTime(ObjectGuid guid) const
 
 void Map::AddCorpse(Corpse* corpse)
 {
+    auto guard = AcquireRegionUpdateLock();
+
     corpse->SetMap(this);
 
     _corpsesByCell[corpse->GetCellCoord().GetId()].insert(corpse);
@@ -3603,6 +4822,8 @@ void Map::AddCorpse(Corpse* corpse)
         _corpsesByPlayer[corpse->GetOwnerGUID()] = corpse;
     else
         _corpseBones.insert(corpse);
+
+    _corpseExpiryEntries[corpse] = _corpseExpiryQueue.emplace(corpse->GetExpiryTime(), corpse);
 }
 
 void Map::RemoveCorpse(Corpse* corpse)
@@ -3618,11 +4839,48 @@ void Map::RemoveCorpse(Corpse* corpse)
         corpse->ResetMap();
     }
 
+    auto guard = AcquireRegionUpdateLock();
+
     _corpsesByCell[corpse->GetCellCoord().GetId()].erase(corpse);
     if (corpse->GetType() != CORPSE_BONES)
         _corpsesByPlayer.erase(corpse->GetOwnerGUID());
     else
         _corpseBones.erase(corpse);
+
+    auto expiry = _corpseExpiryEntries.find(corpse);
+    if (expiry != _corpseExpiryEntries.end())
+    {
+        _corpseExpiryQueue.erase(expiry->second);
+        _corpseExpiryEntries.erase(expiry);
+    }
+}
+
+void Map::SaveCorpse(Corpse* corpse)
+{
+    auto guard = AcquireRegionUpdateLock();
+
+    CharacterDatabasePreparedStatement*& stmt = _pendingCorpseSaves[corpse->GetOwnerGUID()];
+    delete stmt;
+    stmt = corpse->BuildSaveStatement();
+}
+
+void Map::SaveCorpseData()
+{
+    if (_pendingCorpseSaves.empty())
+        return;
+
+    // deletes go first so the inserts are consecutive and sent as multi-row statements,
+    // every owner has a single pending row so the order between owners doesn't matter
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    for (auto const& [ownerGuid, stmt] : _pendingCorpseSaves)
+        Corpse::DeleteFromDB(ownerGuid, trans);
+
+    for (auto const& [ownerGuid, stmt] : _pendingCorpseSaves)
+        if (stmt)
+            trans->Append(stmt);
+
+    CharacterDatabase.CommitTransaction(trans);
+    _pendingCorpseSaves.clear();
 }
 
 Corpse* Map::ConvertCorpseToBones(ObjectGuid const ownerGuid, bool insignia /*= false*/)
@@ -3633,10 +4891,14 @@ Corpse* Map::ConvertCorpseToBones(ObjectGuid const ownerGuid, bool insignia /*=
 
     RemoveCorpse(corpse);
 
-    // remove corpse from DB
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
-    corpse->DeleteFromDB(trans);
-    CharacterDatabase.CommitTransaction(trans);
+    // remove corpse from DB, along with the other corpse changes of this update
+    {
+        auto guard = AcquireRegionUpdateLock();
+
+        CharacterDatabasePreparedStatement*& stmt = _pendingCorpseSaves[ownerGuid];
+        delete stmt;
+        stmt = nullptr;
+    }
 
     Corpse* bones = NULL;
 
@@ -3682,37 +4944,96 @@ void Map::RemoveOldCorpses()
 {
     time_t now = GameTime::GetGameTime().count();
 
-    std::vector<ObjectGuid> corpses;
-    corpses.reserve(_corpsesByPlayer.size());
-
-    for (auto const& p : _corpsesByPlayer)
-        if (p.second->IsExpired(now))
-            corpses.push_back(p.first);
-
-    for (ObjectGuid const& ownerGuid : corpses)
-        ConvertCorpseToBones(ownerGuid);
+    // corpses are removed from the queue by RemoveCorpse, bones of expired corpses are queued an hour later
+    while (!_corpseExpiryQueue.empty() && _corpseExpiryQueue.begin()->first < now)
+    {
+        Corpse* corpse = _corpseExpiryQueue.begin()->second;
 
-    std::vector<Corpse*> expiredBones;
-    for (Corpse* bones : _corpseBones)
-        if (bones->IsExpired(now))
-            expiredBones.push_back(bones);
+        // ghost time was reset after the corpse was queued
+        if (!corpse->IsExpired(now))
+        {
+            _corpseExpiryQueue.erase(_corpseExpiryQueue.begin());
+            _corpseExpiryEntries[corpse] = _corpseExpiryQueue.emplace(corpse->GetExpiryTime(), corpse);
+            continue;
+        }
 
-    for (Corpse* bones : expiredBones)
-    {
-        RemoveCorpse(bones);
-        delete bones;
+        if (corpse->GetType() == CORPSE_BONES)
+        {
+            RemoveCorpse(corpse);
+            delete corpse;
+        }
+        else if (GetCorpseByPlayer(corpse->GetOwnerGUID()) == corpse)
+            ConvertCorpseToBones(corpse->GetOwnerGUID());
+        else
+        {
+            // replaced by a newer corpse of the owner, not reachable by ConvertCorpseToBones
+            _corpseExpiryEntries.erase(corpse);
+            _corpseExpiryQueue.erase(_corpseExpiryQueue.begin());
+        }
     }
 }
 
 void Map::ScheduleCreatureRespawn(ObjectGuid creatureGuid, Milliseconds respawnTimer)
 {
-    _creatureRespawnScheduler.Schedule(respawnTimer, [this, creatureGuid](TaskContext)
+    Creature* creature = GetCreature(creatureGuid);
+    if (!creature || creature->getDeathState() != DeathState::Dead)
+        return;
+
+    // respawn times are kept in seconds, round up so the creature is never back early
+    uint32 const respawnDelay = uint32((respawnTimer.count() + IN_MILLISECONDS - 1) / IN_MILLISECONDS);
+    if (creature->GetRespawnTime() > GameTime::GetGameTime().count() + respawnDelay)
+        creature->SetRespawnTime(respawnDelay);
+}
+
+void Map::QueueCreatureRespawn(ObjectGuid creatureGuid, time_t respawnTime)
+{
+    auto guard = AcquireRegionUpdateLock();
+    _creatureRespawnQueue[respawnTime].push_back(creatureGuid);
+}
+
+void Map::ProcessCreatureRespawns()
+{
+    time_t const now = GameTime::GetGameTime().count();
+    if (_creatureRespawnQueue.empty() || _creatureRespawnQueue.begin()->first > now)
+        return;
+
+    std::vector<std::pair<Creature*, time_t>> due;
+    while (!_creatureRespawnQueue.empty() && _creatureRespawnQueue.begin()->first <= now)
+    {
+        auto bucket = _creatureRespawnQueue.begin();
+        for (ObjectGuid const& guid : bucket->second)
+            if (Creature* creature = GetCreature(guid))
+                due.emplace_back(creature, bucket->first);
+
+        _creatureRespawnQueue.erase(bucket);
+    }
+
+    // linked spawns go last, a master due in the same pass is back by then and does not hold them back
+    std::stable_partition(due.begin(), due.end(), [](std::pair<Creature*, time_t> const& entry)
+    {
+        Creature const* creature = entry.first;
+        if (!creature->GetSpawnId())
+            return true;
+
+        CreatureData const* data = creature->GetCreatureData();
+        ObjectGuid const dbtableHighGuid = ObjectGuid::Create<HighGuid::Unit>(data ? data->id1 : creature->GetEntry(), creature->GetSpawnId());
+        return sObjectMgr->GetLinkedRespawnGuid(dbtableHighGuid).IsEmpty();
+    });
+
+    for (auto const& [creature, queuedTime] : due)
     {
-        if (Creature* creature = GetCreature(creatureGuid))
+        if (!creature->RespawnQueued(queuedTime))
+            continue;
+
+        // visibility of the respawned creatures is updated right away, grouped by the cell they stand in
+        if (creature->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
         {
-            creature->Respawn();
+            creature->m_delayed_unit_relocation_timer = 0;
+            creature->ExecuteDelayedUnitRelocationEvent(&_relocatedCreatures);
         }
-    });
+    }
+
+    NotifyRelocatedCreatures();
 }
 
 void Map::SendZoneDynamicInfo(Player* player)
@@ -4050,6 +5371,12 @@ void Map::LoadCorpseData()
 
 void Map::DeleteCorpseData()
 {
+    // all rows of the map go away below
+    for (auto const& [ownerGuid, stmt] : _pendingCorpseSaves)
+        delete stmt;
+
+    _pendingCorpseSaves.clear();
+
     // DELETE FROM corpse WHERE mapId = ? AND instanceId = ?
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CORPSES_FROM_MAP);
     stmt->SetData(0, GetId());
@@ -4057,6 +5384,15 @@ void Map::DeleteCorpseData()
     CharacterDatabase.Execute(stmt);
 }
 
+Acore::Metrics::Histogram& Map::GetUpdateTimeHistogram()
+{
+    if (!_updateTimeHistogram)
+        _updateTimeHistogram = &sMetricRegistry->GetHistogram("map_update_time_seconds", "Wall time of one map update",
+            { 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0 }, { { "map_id", std::to_string(GetId()) } });
+
+    return *_updateTimeHistogram;
+}
+
 std::string Map::GetDebugInfo() const
 {
     std::stringstream sstr;
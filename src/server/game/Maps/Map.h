@@ -21,6 +21,7 @@
 #include "Cell.h"
 #include "DBCStructure.h"
 #include "DataMap.h"
+#include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
@@ -34,8 +35,13 @@
 #include "SharedDefines.h"
 #include "TaskScheduler.h"
 #include "Timer.h"
+#include "UpdateData.h"
+#include <array>
+#include <atomic>
 #include <bitset>
+#include <deque>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -54,6 +60,7 @@ struct ScriptInfo;
 struct ScriptAction;
 struct Position;
 class Battleground;
+class CollisionQueryCache;
 class MapInstanced;
 class InstanceMap;
 class BattlegroundMap;
@@ -67,6 +74,8 @@ enum WeatherState : uint32;
 namespace VMAP
 {
     enum class ModelIgnoreFlags : uint32;
+    struct LineOfSightQuery;
+    struct HeightQuery;
 }
 
 namespace Acore
@@ -75,6 +84,11 @@ namespace Acore
     struct LargeObjectUpdater;
 }
 
+namespace Acore::Metrics
+{
+    class Histogram;
+}
+
 struct ScriptAction
 {
     ObjectGuid sourceGUID;
@@ -115,6 +129,9 @@ struct map_areaHeader
 #define MAP_HEIGHT_AS_INT8              0x0004
 #define MAP_HEIGHT_HAS_FLIGHT_BOUNDS    0x0008
 
+// height range map_extractor still stores as MAP_HEIGHT_AS_INT16, float grids within it are quantized on load
+#define GRID_HEIGHT_INT16_LIMIT         2048.0f
+
 struct map_heightHeader
 {
     uint32 fourcc;
@@ -165,6 +182,9 @@ enum LiquidStatus
 #define INVALID_HEIGHT       -100000.0f                     // for check, must be equal to VMAP_INVALID_HEIGHT, real value for unknown height is VMAP_INVALID_HEIGHT_VALUE
 #define MAX_FALL_DISTANCE     250000.0f                     // "unlimited fall" to find VMap ground if it is available, just larger than MAX_HEIGHT - INVALID_HEIGHT
 #define DEFAULT_HEIGHT_SEARCH     50.0f                     // default search distance to find height at nearby locations
+#define MAX_IDLE_OBJECT_UPDATE_INTERVAL 8
+#define MAX_CREATURE_ENTRY_INDEX_SCAN 64                    // entries spawned more often than this are searched through the grid
+
 #define MIN_UNLOAD_DELAY      1                             // immediate unload
 
 struct LiquidData
@@ -198,6 +218,16 @@ enum LineOfSightChecks
     LINEOFSIGHT_ALL_CHECKS          = LINEOFSIGHT_CHECK_VMAP | LINEOFSIGHT_CHECK_GOBJECT_ALL
 };
 
+// spawn changes of a starting or stopping game event, queued to the maps and applied by their updates
+enum class GameEventMapAction : uint8
+{
+    SpawnCreature,
+    SpawnGameObject,
+    DespawnCreature,
+    DespawnGameObject,
+    UpdateNpcFlags
+};
+
 class GridMap
 {
     uint32  _flags;
@@ -227,6 +257,10 @@ class GridMap
     uint16* _liquidEntry;
     uint8* _liquidFlags;
     float* _liquidMap;
+    // run-length form of _liquidMap, levels and start columns of the runs, first run of each row
+    float* _liquidRunLevels;
+    uint8* _liquidRunStarts;
+    uint16* _liquidRowRuns;
     uint16 _gridArea;
     uint16 _liquidGlobalEntry;
     uint8 _liquidGlobalFlags;
@@ -235,13 +269,22 @@ class GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
     uint16* _holes;
+    std::size_t _memoryUsage;
+
+    static std::atomic<std::size_t> _loadedBytes;
 
+    bool readData(char* filename);
     bool loadAreaData(FILE* in, uint32 offset, uint32 size);
     bool loadHeightData(FILE* in, uint32 offset, uint32 size);
     bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
     bool loadHolesData(FILE* in, uint32 offset, uint32 size);
     [[nodiscard]] bool isHole(int row, int col) const;
 
+    void compactFloatHeights();
+    void compactLiquidMap();
+    [[nodiscard]] bool hasLiquidMap() const { return _liquidMap || _liquidRunLevels; }
+    [[nodiscard]] float getLiquidMapLevel(int row, int col) const;
+
     // Get height functions and pointers
     typedef float (GridMap::*GetHeightPtr) (float x, float y) const;
     GetHeightPtr _gridGetHeight;
@@ -256,6 +299,11 @@ public:
     bool loadData(char* filaname);
     void unloadData();
 
+    /// return: bytes of the terrain arrays of this grid
+    [[nodiscard]] std::size_t GetMemoryUsage() const;
+    /// return: bytes of the terrain arrays of all loaded grids
+    static std::size_t GetLoadedBytes() { return _loadedBytes; }
+
     [[nodiscard]] uint16 getArea(float x, float y) const;
     [[nodiscard]] inline float getHeight(float x, float y) const {return (this->*_gridGetHeight)(x, y);}
     [[nodiscard]] float getMinHeight(float x, float y) const;
@@ -366,10 +414,7 @@ public:
         return !getNGrid(p.x_coord, p.y_coord);
     }
 
-    [[nodiscard]] bool IsGridLoaded(float x, float y) const
-    {
-        return IsGridLoaded(Acore::ComputeGridCoord(x, y));
-    }
+    [[nodiscard]] bool IsGridLoaded(float x, float y) const;
 
     void LoadGrid(float x, float y);
     void LoadAllCells();
@@ -386,8 +431,22 @@ public:
     // pussywizard: movemaps, mmaps
     [[nodiscard]] std::shared_mutex& GetMMapLock() const { return *(const_cast<std::shared_mutex*>(&MMapLock)); }
     // pussywizard:
-    std::unordered_set<Unit*> i_objectsForDelayedVisibility;
+    // units carry their own queued flag, so these per tick queues are plain vectors
+    std::vector<Unit*> i_objectsForDelayedVisibility;
+    void AddObjectForDelayedVisibility(Unit* unit);
     void HandleDelayedVisibility();
+    // notifies players around the creatures relocated by HandleDelayedVisibility, one grid search per cell they stand in
+    void NotifyRelocatedCreatures();
+    std::vector<Creature*> _relocatedCreatures;
+
+    // respawns the queued creatures that are due, their visibility is updated in one pass per cell
+    void ProcessCreatureRespawns();
+    // dead creatures bucketed by the second they respawn in, only the due buckets are looked at
+    std::map<time_t, GuidVector> _creatureRespawnQueue;
+
+    // combat logs are sent once per map update, all logs of a unit with one visibility search
+    void QueueCombatLog(Unit const* source, WorldPacket const& data);
+    void SendCombatLogs();
 
     // some calls like isInWater should not use vmaps due to processor power
     // can return INVALID_HEIGHT if under z+2 z coord not found height
@@ -432,6 +491,7 @@ public:
         CANNOT_ENTER_TOO_MANY_INSTANCES, // Player has entered too many instances recently
         CANNOT_ENTER_MAX_PLAYERS, // Target map already has the maximum number of players allowed
         CANNOT_ENTER_ZONE_IN_COMBAT, // A boss encounter is currently in progress on the target map
+        CANNOT_ENTER_NOT_HOSTED, // Target map is hosted by another world node of the realm
         CANNOT_ENTER_UNSPECIFIED_REASON
     };
 
@@ -476,6 +536,7 @@ public:
 
     [[nodiscard]] bool HavePlayers() const { return !m_mapRefMgr.IsEmpty(); }
     [[nodiscard]] uint32 GetPlayersCountExceptGMs() const;
+    [[nodiscard]] uint32 GetLoadedGridCount() const;
 
     void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
     void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
@@ -519,9 +580,18 @@ public:
     typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
     CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
 
+    // in-world creatures by entry, entry searches of rarely spawned creatures walk these instead of the grid
+    void AddToCreatureEntryIndex(Creature* creature, uint32 entry);
+    void RemoveFromCreatureEntryIndex(Creature* creature, uint32 entry);
+    // false if the grid has to be searched instead
+    bool GetCreaturesWithEntryInRange(std::list<Creature*>& creatures, WorldObject const* center, uint32 entry, float range) const;
+
     typedef std::unordered_multimap<ObjectGuid::LowType, GameObject*> GameObjectBySpawnIdContainer;
     GameObjectBySpawnIdContainer& GetGameObjectBySpawnIdStore() { return _gameobjectBySpawnIdStore; }
 
+    // applied Event.MapActionsPerUpdate at a time by the map update, in queue order
+    void QueueGameEventAction(GameEventMapAction action, ObjectGuid::LowType spawnId);
+
     [[nodiscard]] std::unordered_set<Corpse*> const* GetCorpsesInCell(uint32 cellId) const
     {
         auto itr = _corpsesByCell.find(cellId);
@@ -550,8 +620,14 @@ public:
     [[nodiscard]] BattlegroundMap const* ToBattlegroundMap() const { if (IsBattlegroundOrArena()) return reinterpret_cast<BattlegroundMap const*>(this); return nullptr; }
 
     float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = DEFAULT_COLLISION_HEIGHT) const;
+    // water level above an already known floor height, as returned by GetWaterOrGroundLevel
+    [[nodiscard]] float GetWaterOrGroundLevelAboveFloor(uint32 phasemask, float x, float y, float groundZ, float collisionHeight = DEFAULT_COLLISION_HEIGHT) const;
     [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
+    // resolves many points at once, each grid is looked up once per run of points and the static collision is traced in packets
+    void GetHeight(uint32 phasemask, std::vector<VMAP::HeightQuery>& queries, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+    // checks many segments at once, the static collision is traced in packets and only the segments still in sight are checked against gameobjects
+    void isInLineOfSight(std::vector<VMAP::LineOfSightQuery>& queries, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, PathGenerator *path, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
@@ -594,16 +670,24 @@ public:
     void RemoveGORespawnTime(ObjectGuid::LowType dbGuid);
     void LoadRespawnTimes();
     void DeleteRespawnTimes();
+    //! Writes the respawn times changed since the previous call in one transaction
+    void SaveRespawnTimes();
+    //! Queues the terrain of the grids moving players and taxi flights are heading to
+    void PrefetchGrids();
     [[nodiscard]] time_t GetInstanceResetPeriod() const { return _instanceResetPeriod; }
 
-    TaskScheduler _creatureRespawnScheduler;
-
+    //! Brings the respawn of a dead creature forward to respawnTimer from now
     void ScheduleCreatureRespawn(ObjectGuid /*creatureGuid*/, Milliseconds /*respawnTimer*/);
+    //! Wakes the dead creature once respawnTime is due, see ProcessCreatureRespawns()
+    void QueueCreatureRespawn(ObjectGuid creatureGuid, time_t respawnTime);
 
     void LoadCorpseData();
     void DeleteCorpseData();
     void AddCorpse(Corpse* corpse);
     void RemoveCorpse(Corpse* corpse);
+    //! Queues the corpse row for the next SaveCorpseData()
+    void SaveCorpse(Corpse* corpse);
+    void SaveCorpseData();
     Corpse* ConvertCorpseToBones(ObjectGuid const ownerGuid, bool insignia = false);
     void RemoveOldCorpses();
 
@@ -641,14 +725,19 @@ public:
         return GetGuidSequenceGenerator<high>().Generate();
     }
 
-    void AddUpdateObject(Object* obj)
-    {
-        _updateObjects.insert(obj);
-    }
+    void AddUpdateObject(Object* obj);
+    void RemoveUpdateObject(Object* obj);
 
-    void RemoveUpdateObject(Object* obj)
+    // the passengers of a moved vehicle follow it once per update, no matter how often it moved
+    void AddVehicleToPassengerRelocation(Unit* vehicle);
+
+    // Serializes changes to map-wide containers while cell regions are updated in parallel, no-op otherwise
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> AcquireRegionUpdateLock()
     {
-        _updateObjects.erase(obj);
+        if (_regionUpdateActive)
+            return std::unique_lock<std::recursive_mutex>(_regionUpdateLock);
+
+        return std::unique_lock<std::recursive_mutex>();
     }
 
     size_t GetActiveNonPlayersCount() const
@@ -656,6 +745,18 @@ public:
         return m_activeNonPlayers.size();
     }
 
+    // number of idle objects whose update was skipped during the last update
+    [[nodiscard]] uint32 GetIdleObjectsSkipped() const { return _idleObjectsSkipped; }
+
+    // creatures whose AI reported nothing to do, counted from the (possibly parallel) cell updates
+    void CountQuiescentAIUpdate() { _quiescentAIUpdates.fetch_add(1, std::memory_order_relaxed); }
+
+    // wall time (microseconds) of the last update, used by MapUpdater to schedule the most expensive maps first
+    [[nodiscard]] uint32 GetLastUpdateCost() const { return _lastUpdateCost; }
+    void SetLastUpdateCost(uint32 cost) { _lastUpdateCost = cost; }
+    // update time series of the metric exporter, shared by all instances of the map
+    Acore::Metrics::Histogram& GetUpdateTimeHistogram();
+
     virtual std::string GetDebugInfo() const;
 
 private:
@@ -678,6 +779,9 @@ private:
     std::vector<GameObject*> _gameObjectsToMove;
     std::vector<DynamicObject*> _dynamicObjectsToMove;
 
+    void RelocateVehiclePassengers();
+    GuidUnorderedSet _vehiclesToRelocatePassengers;
+
     [[nodiscard]] bool IsGridLoaded(const GridCoord&) const;
     void EnsureGridCreated_i(const GridCoord&);
 
@@ -698,8 +802,13 @@ private:
 
     void UpdateActiveCells(const float& x, const float& y, const uint32 t_diff);
 
+    void UpdateCellRegions(uint32 t_diff);
+
     void SendObjectUpdates();
 
+    void ApplyGameEventActions();
+    void ApplyGameEventAction(GameEventMapAction action, ObjectGuid::LowType spawnId);
+
 protected:
     std::mutex Lock;
     std::mutex GridLock;
@@ -711,6 +820,9 @@ protected:
     uint32 m_unloadTimer;
     float m_VisibleDistance;
     DynamicMapTree _dynamicTree;
+    std::unique_ptr<CollisionQueryCache> _collisionCache;   // only base maps own one, instances share their parent's
+
+    [[nodiscard]] CollisionQueryCache* GetCollisionCache() const { return m_parentMap->_collisionCache.get(); }
     time_t _instanceResetPeriod; // pussywizard
 
     MapRefMgr m_mapRefMgr;
@@ -744,12 +856,17 @@ private:
     std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP* TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells_large;
 
     bool i_scriptLock;
-    std::unordered_set<WorldObject*> i_objectsToRemove;
+    std::vector<WorldObject*> i_objectsToRemove;
     std::map<WorldObject*, bool> i_objectsToSwitch;
     std::unordered_set<WorldObject*> i_worldObjects;
 
-    typedef std::multimap<time_t, ScriptAction> ScriptScheduleMap;
+    // actions are bucketed by the second they are due, actions of a bucket run in scheduling order
+    typedef std::map<time_t, std::vector<ScriptAction>> ScriptScheduleMap;
     ScriptScheduleMap m_scriptSchedule;
+    std::vector<std::vector<ScriptAction>> _scriptBucketPool;   // drained buckets kept for their capacity
+    std::size_t _scheduledScriptActions;
+
+    void _ScheduleScriptAction(time_t when, ScriptAction const& action);
 
     // Type specific code for add/remove to/from grid
     template<class T>
@@ -782,6 +899,14 @@ private:
     std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t> _creatureRespawnTimes;
     std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t> _goRespawnTimes;
 
+    // Respawn times changed since the last SaveRespawnTimes, deleted ones are no longer in the maps above
+    std::unordered_set<ObjectGuid::LowType /*dbGUID*/> _pendingCreatureRespawnSaves;
+    std::unordered_set<ObjectGuid::LowType /*dbGUID*/> _pendingGORespawnSaves;
+    uint32 _respawnSaveTimer;
+    uint32 _gridPrefetchTimer;
+
+    void PrefetchGridAt(float x, float y);
+
     ZoneDynamicInfoMap _zoneDynamicInfo;
     uint32 _defaultLight;
 
@@ -798,12 +923,58 @@ private:
     std::map<HighGuid, std::unique_ptr<ObjectGuidGeneratorBase>> _guidGenerators;
     MapStoredObjectTypesContainer _objectsStore;
     CreatureBySpawnIdContainer _creatureBySpawnIdStore;
+    std::unordered_map<uint32, std::vector<Creature*>> _creatureEntryIndex;
     GameObjectBySpawnIdContainer _gameobjectBySpawnIdStore;
     std::unordered_map<uint32/*cellId*/, std::unordered_set<Corpse*>> _corpsesByCell;
     std::unordered_map<ObjectGuid, Corpse*> _corpsesByPlayer;
     std::unordered_set<Corpse*> _corpseBones;
 
-    std::unordered_set<Object*> _updateObjects;
+    // corpses and bones by expiry time, RemoveOldCorpses only looks at the due ones
+    typedef std::multimap<time_t, Corpse*> CorpseExpiryQueue;
+    CorpseExpiryQueue _corpseExpiryQueue;
+    std::unordered_map<Corpse*, CorpseExpiryQueue::iterator> _corpseExpiryEntries;
+
+    // corpse rows to write by owner since the last SaveCorpseData, nullptr only deletes the row
+    std::unordered_map<ObjectGuid, CharacterDatabasePreparedStatement*> _pendingCorpseSaves;
+
+    // objects with m_objectUpdated set, each knows its index so it can be swapped out on removal
+    std::vector<Object*> _updateObjects;
+
+    // SendObjectUpdates() scratch containers, kept between ticks so their buffers are reused
+    std::vector<Object*> _updateObjectsBatch;
+    std::vector<std::pair<ObjectGuid, std::shared_ptr<WorldPacket const>>> _combatLogs;
+    std::vector<std::shared_ptr<WorldPacket const>> _combatLogsBatch;
+    std::unordered_map<Player*, UpdateData> _updateDatas;
+    GuidUnorderedSet _updatePlayerSet;
+
+    uint32 _lastUpdateCost;
+    Acore::Metrics::Histogram* _updateTimeHistogram;
+
+    // continents only: cells are collected by VisitNearbyCellsOf and then updated per region by MapRegionUpdater
+    bool _collectRegionCells;
+    std::vector<uint32> _regionCells;
+    std::vector<uint32> _regionLargeCells;
+    bool _regionUpdateActive;
+    std::recursive_mutex _regionUpdateLock;
+
+    // continents only: the cells of a loaded grid create their spawns once they are visited without NoCreate
+    bool _stagedGridLoading;
+
+    // grid and staged cell loads since the last map update, reported as metrics
+    uint32 _gridLoads;
+    uint32 _cellLoads;
+    Microseconds _gridLoadTime;
+
+    // idle object throttling, the diffs of the last ticks are summed up for the objects updated this tick
+    uint32 _idleUpdateTick;
+    std::array<uint32, MAX_IDLE_OBJECT_UPDATE_INTERVAL> _idleUpdateDiffs;
+    uint32 _idleObjectsSkipped;
+    std::atomic<uint32> _quiescentAIUpdates;
+
+    // queued by GameEventMgr, which may run outside of the update of this map
+    std::mutex _gameEventActionsLock;
+    std::deque<std::pair<GameEventMapAction, ObjectGuid::LowType>> _gameEventActions;
+    uint32 _gameEventActionsApplied;
 };
 
 enum InstanceResetMethod
@@ -879,8 +1050,16 @@ inline void Map::Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& vis
 
     if (!cell.NoCreate() || IsGridLoaded(GridCoord(x, y)))
     {
-        EnsureGridLoaded(cell);
-        getNGrid(x, y)->VisitGrid(cell_x, cell_y, visitor);
+        // NoCreate visits of a loaded grid leave staged cells as they are
+        if (!cell.NoCreate())
+            EnsureGridLoaded(cell);
+
+        // large radius searches cover many empty cells, skip them and whole empty grids by their object counts
+        NGridType* grid = getNGrid(x, y);
+        if (grid->IsEmpty(visitor) || grid->GetGridType(cell_x, cell_y).IsEmpty(visitor))
+            return;
+
+        grid->VisitGrid(cell_x, cell_y, visitor);
     }
 }
 
@@ -54,7 +54,7 @@ void MapInstanced::Update(const uint32 t, const uint32 s_diff, bool /*thread*/)
     {
         if (i->second->CanUnload(t))
         {
-            if (!DestroyInstance(i))                             // iterator incremented
+            if (!DestroyInstance(i, true))                       // iterator incremented
             {
                 //m_unloadTimer
             }
@@ -99,6 +99,19 @@ void MapInstanced::UnloadAll()
 
     m_InstancedMaps.clear();
 
+    DeleteUnloadedInstances();
+
+    for (std::vector<InstanceMap*>& pool : m_IdleInstances)
+    {
+        for (InstanceMap* map : pool)
+        {
+            map->UnloadAll();
+            delete map;
+        }
+
+        pool.clear();
+    }
+
     // Unload own grids (just dummy(placeholder) grids, neccesary to unload GridMaps!)
     Map::UnloadAll();
 }
@@ -168,10 +181,14 @@ Map* MapInstanced::CreateInstanceForPlayer(const uint32 mapId, Player* player)
         }
         else
         {
-            uint32 newInstanceId = sMapMgr->GenerateInstanceId();
-            ASSERT(!FindInstanceMap(newInstanceId)); // pussywizard: instance with new id can't exist
             Difficulty diff = player->GetGroup() ? player->GetGroup()->GetDifficulty(IsRaid()) : player->GetDifficulty(IsRaid());
-            map = CreateInstance(newInstanceId, nullptr, diff);
+            map = TakeIdleInstance(diff);
+            if (!map)
+            {
+                uint32 newInstanceId = sMapMgr->GenerateInstanceId();
+                ASSERT(!FindInstanceMap(newInstanceId)); // pussywizard: instance with new id can't exist
+                map = CreateInstance(newInstanceId, nullptr, diff);
+            }
         }
     }
 
@@ -220,6 +237,56 @@ InstanceMap* MapInstanced::CreateInstance(uint32 InstanceId, InstanceSave* save,
     return map;
 }
 
+InstanceMap* MapInstanced::TakeIdleInstance(Difficulty difficulty)
+{
+    std::lock_guard<std::mutex> guard(Lock);
+
+    // the pools are kept per difficulty the map is really created with
+    GetDownscaledMapDifficultyData(GetId(), difficulty);
+
+    std::vector<InstanceMap*>& pool = m_IdleInstances[difficulty];
+    if (pool.empty())
+        return nullptr;
+
+    InstanceMap* map = pool.back();
+    pool.pop_back();
+
+    LOG_DEBUG("maps", "MapInstanced::TakeIdleInstance: idle map instance {} for {} taken with difficulty {}", map->GetInstanceId(), GetId(), difficulty ? "heroic" : "normal");
+
+    sInstanceSaveMgr->AddInstanceSave(GetId(), map->GetInstanceId(), difficulty);
+
+    m_InstancedMaps[map->GetInstanceId()] = map;
+    return map;
+}
+
+bool MapInstanced::RefillIdleInstances(uint32 poolSize)
+{
+    for (uint8 i = 0; i < MAX_DIFFICULTY; ++i)
+    {
+        Difficulty difficulty = Difficulty(i);
+        if (m_IdleInstances[i].size() >= poolSize || !GetMapDifficultyData(GetId(), difficulty))
+            continue;
+
+        // all instances share the terrain, vmaps and mmaps loaded by this map, have the entrance grid ready before the first one
+        if (AreaTriggerTeleport const* entrance = sObjectMgr->GetMapEntranceTrigger(GetId()))
+            EnsureGridCreated(Acore::ComputeGridCoord(entrance->target_X, entrance->target_Y));
+
+        // same as a new instance in CreateInstance(), the instance save is only added when the map is taken
+        InstanceMap* map = new InstanceMap(GetId(), sMapMgr->GenerateInstanceId(), difficulty, this);
+        ASSERT(map->IsDungeon());
+
+        map->LoadRespawnTimes();
+        map->LoadCorpseData();
+        map->CreateInstanceScript(false, "", 0);
+
+        std::lock_guard<std::mutex> guard(Lock);
+        m_IdleInstances[i].push_back(map);
+        return true;
+    }
+
+    return false;
+}
+
 BattlegroundMap* MapInstanced::CreateBattleground(uint32 InstanceId, Battleground* bg)
 {
     // load/create a map
@@ -246,7 +313,7 @@ BattlegroundMap* MapInstanced::CreateBattleground(uint32 InstanceId, Battlegroun
 }
 
 // increments the iterator after erase
-bool MapInstanced::DestroyInstance(InstancedMaps::iterator& itr)
+bool MapInstanced::DestroyInstance(InstancedMaps::iterator& itr, bool deferUnload /*= false*/)
 {
     itr->second->RemoveAllPlayers();
 
@@ -258,6 +325,15 @@ bool MapInstanced::DestroyInstance(InstancedMaps::iterator& itr)
 
     sScriptMgr->OnDestroyInstance(this, itr->second);
 
+    // MapMgr::Update() deletes the map once the workers finished, before anything else can look for it
+    if (deferUnload && sMapMgr->GetMapUpdater()->activated())
+    {
+        sMapMgr->GetMapUpdater()->schedule_unload(*itr->second);
+        m_UnloadedInstances.push_back(itr->second);
+        m_InstancedMaps.erase(itr++);
+        return true;
+    }
+
     itr->second->UnloadAll();
 
     // erase map
@@ -267,6 +343,14 @@ bool MapInstanced::DestroyInstance(InstancedMaps::iterator& itr)
     return true;
 }
 
+void MapInstanced::DeleteUnloadedInstances()
+{
+    for (Map* map : m_UnloadedInstances)
+        delete map;
+
+    m_UnloadedInstances.clear();
+}
+
 Map::EnterState MapInstanced::CannotEnter(Player* /*player*/, bool /*loginCheck*/)
 {
     //ABORT();
@@ -21,6 +21,8 @@
 #include "DBCEnums.h"
 #include "InstanceSaveMgr.h"
 #include "Map.h"
+#include <array>
+#include <vector>
 
 class MapInstanced : public Map
 {
@@ -44,15 +46,25 @@ public:
         InstancedMaps::const_iterator i = m_InstancedMaps.find(instanceId);
         return(i == m_InstancedMaps.end() ? nullptr : i->second);
     }
-    bool DestroyInstance(InstancedMaps::iterator& itr);
+    // deferUnload: the grids are unloaded by a map worker, the map is deleted by DeleteUnloadedInstances()
+    bool DestroyInstance(InstancedMaps::iterator& itr, bool deferUnload = false);
+    // called after the map workers finished
+    void DeleteUnloadedInstances();
 
     InstancedMaps& GetInstancedMaps() { return m_InstancedMaps; }
     void InitVisibilityDistance() override;
 
+    // return: true if a map was added to one of the idle pools, at most one per call
+    bool RefillIdleInstances(uint32 poolSize);
+
 private:
     InstanceMap* CreateInstance(uint32 InstanceId, InstanceSave* save, Difficulty difficulty);
+    InstanceMap* TakeIdleInstance(Difficulty difficulty);
     BattlegroundMap* CreateBattleground(uint32 InstanceId, Battleground* bg);
 
     InstancedMaps m_InstancedMaps;
+    std::vector<Map*> m_UnloadedInstances;
+    // maps created ahead for new instances, per difficulty, not updated until taken
+    std::array<std::vector<InstanceMap*>, MAX_DIFFICULTY> m_IdleInstances;
 };
 #endif
@@ -17,6 +17,7 @@
 
 #include "MapMgr.h"
 #include "Chat.h"
+#include "Config.h"
 #include "DatabaseEnv.h"
 #include "GridDefines.h"
 #include "Group.h"
@@ -28,11 +29,19 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Opcodes.h"
+#include "PathfindingService.h"
 #include "Player.h"
 #include "ScriptMgr.h"
+#include "StringConvert.h"
+#include "Tokenize.h"
 #include "Transport.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <tuple>
 
 MapMgr::MapMgr()
 {
@@ -57,7 +66,89 @@ void MapMgr::Initialize()
 
     // Start mtmaps if needed
     if (num_threads > 0)
-        m_updater.activate(num_threads);
+    {
+        MapUpdater::ClassThreadCounts dedicatedThreads = {};
+        dedicatedThreads[MAP_UPDATE_CLASS_CONTINENT] = sWorld->getIntConfig(CONFIG_NUMTHREADS_CONTINENT_MAPS);
+        dedicatedThreads[MAP_UPDATE_CLASS_DUNGEON] = sWorld->getIntConfig(CONFIG_NUMTHREADS_DUNGEON_MAPS);
+        dedicatedThreads[MAP_UPDATE_CLASS_RAID] = sWorld->getIntConfig(CONFIG_NUMTHREADS_RAID_MAPS);
+        dedicatedThreads[MAP_UPDATE_CLASS_BATTLEGROUND] = sWorld->getIntConfig(CONFIG_NUMTHREADS_BATTLEGROUND_MAPS);
+        dedicatedThreads[MAP_UPDATE_CLASS_ARENA] = sWorld->getIntConfig(CONFIG_NUMTHREADS_ARENA_MAPS);
+
+        m_updater.activate(num_threads, dedicatedThreads);
+    }
+
+    // helper threads for parallel cell region updates on continents
+    int region_threads(sWorld->getIntConfig(CONFIG_NUMTHREADS_MAP_REGIONS));
+    if (region_threads > 0)
+        m_regionUpdater.activate(region_threads);
+
+    // worker threads for the Detour queries of chasing and fleeing units
+    int pathfinding_threads(sWorld->getIntConfig(CONFIG_NUMTHREADS_PATHFINDING));
+    if (pathfinding_threads > 0)
+        sPathfindingService->Initialize(pathfinding_threads);
+
+    // background loading of the terrain ahead of moving players
+    int prefetch_threads(sWorld->getIntConfig(CONFIG_NUMTHREADS_GRID_PREFETCH));
+    if (prefetch_threads > 0)
+        m_gridPrefetcher.activate(prefetch_threads);
+
+    LoadHostedMaps();
+    LoadIdleInstancePoolMaps();
+}
+
+void MapMgr::LoadHostedMaps()
+{
+    _hostedMaps.clear();
+
+    std::string hostedMaps = sConfigMgr->GetOption<std::string>("Node.HostedMaps", "");
+    for (std::string_view token : Acore::Tokenize(hostedMaps, ' ', false))
+    {
+        Optional<uint32> mapId = Acore::StringTo<uint32>(token);
+        if (!mapId || !sMapStore.LookupEntry(*mapId))
+        {
+            LOG_ERROR("server.loading", "Node.HostedMaps contains invalid map id '{}', ignored.", token);
+            continue;
+        }
+
+        _hostedMaps.insert(*mapId);
+    }
+
+    if (!_hostedMaps.empty())
+        LOG_INFO("server.loading", "This node hosts {} maps, teleports to other maps are refused.", _hostedMaps.size());
+}
+
+void MapMgr::LoadIdleInstancePoolMaps()
+{
+    _idleInstancePoolMaps.clear();
+
+    if (!sWorld->getIntConfig(CONFIG_INSTANCE_IDLE_MAP_POOL_SIZE))
+        return;
+
+    std::string poolMaps = sConfigMgr->GetOption<std::string>("Instance.IdleMapPool.Maps", "");
+    for (std::string_view token : Acore::Tokenize(poolMaps, ' ', false))
+    {
+        Optional<uint32> mapId = Acore::StringTo<uint32>(token);
+        MapEntry const* entry = mapId ? sMapStore.LookupEntry(*mapId) : nullptr;
+        if (!entry || !entry->IsDungeon())
+        {
+            LOG_ERROR("server.loading", "Instance.IdleMapPool.Maps contains '{}' which is no dungeon or raid map id, ignored.", token);
+            continue;
+        }
+
+        if (!IsMapHosted(*mapId))
+            continue;
+
+        _idleInstancePoolMaps.push_back(*mapId);
+    }
+}
+
+void MapMgr::RefillIdleInstancePools()
+{
+    // one map per update keeps the cost of refilling out of the way of player teleports
+    for (uint32 mapId : _idleInstancePoolMaps)
+        if (MapInstanced* map = CreateBaseMap(mapId)->ToMapInstanced())
+            if (map->RefillIdleInstances(sWorld->getIntConfig(CONFIG_INSTANCE_IDLE_MAP_POOL_SIZE)))
+                return;
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -133,6 +224,13 @@ Map::EnterState MapMgr::PlayerCannotEnter(uint32 mapid, Player* player, bool log
     if (!entry)
         return Map::CANNOT_ENTER_NO_ENTRY;
 
+    // sessions are not handed over to other nodes, a map hosted elsewhere cannot be entered from here
+    if (!IsMapHosted(mapid))
+    {
+        player->SendTransferAborted(mapid, TRANSFER_ABORT_MAP_NOT_ALLOWED);
+        return Map::CANNOT_ENTER_NOT_HOSTED;
+    }
+
     if (!entry->IsDungeon())
         return Map::CAN_ENTER;
 
@@ -270,7 +368,15 @@ void MapMgr::Update(uint32 diff)
     }
 
     if (m_updater.activated())
+    {
         m_updater.wait();
+        m_updater.ReportClassTimes();
+
+        // instances unloaded by the workers, deleted before sessions can create them again
+        for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
+            if (MapInstanced* map = iter->second->ToMapInstanced())
+                map->DeleteUnloadedInstances();
+    }
 
     if (mapUpdateStep < 3)
     {
@@ -290,6 +396,8 @@ void MapMgr::Update(uint32 diff)
         mapUpdateStep = 0;
         i_timer[3].SetCurrent(0);
     }
+
+    RefillIdleInstancePools();
 }
 
 void MapMgr::DoDelayedMovesAndRemoves()
@@ -324,6 +432,12 @@ bool MapMgr::IsValidMAP(uint32 mapid, bool startUp)
 
 void MapMgr::UnloadAll()
 {
+    if (sPathfindingService->IsEnabled())
+        sPathfindingService->Shutdown();
+
+    if (m_gridPrefetcher.activated())
+        m_gridPrefetcher.deactivate();
+
     for (MapMapType::iterator iter = i_maps.begin(); iter != i_maps.end();)
     {
         iter->second->UnloadAll();
@@ -333,6 +447,85 @@ void MapMgr::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    if (m_regionUpdater.activated())
+        m_regionUpdater.deactivate();
+}
+
+void MapMgr::SaveWarmRestartGrids(std::string const& fileName)
+{
+    // instances are not kept, players in them are moved out on login anyway when the instance is gone
+    std::set<std::tuple<uint32, uint32, uint32>> grids;
+    for (auto const& [mapId, map] : i_maps)
+    {
+        if (map->Instanceable())
+            continue;
+
+        for (MapReference const& ref : map->GetPlayers())
+        {
+            GridCoord const gridCoord = Acore::ComputeGridCoord(ref.GetSource()->GetPositionX(), ref.GetSource()->GetPositionY());
+            grids.emplace(mapId, gridCoord.x_coord, gridCoord.y_coord);
+        }
+    }
+
+    std::ofstream out(fileName, std::ios::out | std::ios::trunc);
+    if (!out)
+    {
+        LOG_ERROR("maps", "MapMgr::SaveWarmRestartGrids: Could not write {}", fileName);
+        return;
+    }
+
+    out << std::time(nullptr) << '\n';
+    for (auto const& [mapId, x, y] : grids)
+        out << mapId << ' ' << x << ' ' << y << '\n';
+
+    LOG_INFO("server.worldserver", "Saved {} grids with players for the next start to {}", grids.size(), fileName);
+}
+
+void MapMgr::LoadWarmRestartGrids(std::string const& fileName, uint32 maxAgeSeconds)
+{
+    std::ifstream in(fileName);
+    if (!in)
+        return;
+
+    uint32 oldMSTime = getMSTime();
+
+    int64 savedTime = 0;
+    in >> savedTime;
+
+    // the file is only written at shutdown, an old one means the players have spread out since
+    if (!in || std::time(nullptr) - savedTime > int64(maxAgeSeconds))
+    {
+        LOG_INFO("server.loading", ">> Skipped the warm restart grids of {}, the file is too old", fileName);
+        in.close();
+        std::filesystem::remove(fileName);
+        return;
+    }
+
+    uint32 count = 0;
+    uint32 mapId, x, y;
+    while (in >> mapId >> x >> y)
+    {
+        if (x >= MAX_NUMBER_OF_GRIDS || y >= MAX_NUMBER_OF_GRIDS || !IsMapHosted(mapId))
+            continue;
+
+        MapEntry const* mapEntry = sMapStore.LookupEntry(mapId);
+        if (!mapEntry || mapEntry->Instanceable())
+            continue;
+
+        // center of the grid, see Map::LoadAllCells
+        if (Map* map = CreateBaseMap(mapId))
+        {
+            map->LoadGrid((x + 0.5f - CENTER_GRID_ID) * SIZE_OF_GRIDS, (y + 0.5f - CENTER_GRID_ID) * SIZE_OF_GRIDS);
+            ++count;
+        }
+    }
+
+    in.close();
+    std::filesystem::remove(fileName);
+
+    LOG_INFO("server.loading", ">> Loaded {} grids players were in before the restart in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
 }
 
 void MapMgr::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
@@ -21,11 +21,14 @@
 #include "Common.h"
 #include "Define.h"
 #include "Map.h"
+#include "GridPrefetcher.h"
 #include "MapInstanced.h"
+#include "MapRegionUpdater.h"
 #include "MapUpdater.h"
 #include "Object.h"
 
 #include <mutex>
+#include <unordered_set>
 
 class Transport;
 class StaticTransport;
@@ -140,6 +143,9 @@ public:
     void DoDelayedMovesAndRemoves();
 
     Map::EnterState PlayerCannotEnter(uint32 mapid, Player* player, bool loginCheck = false);
+
+    /// False for maps another world node of the realm is configured to host
+    [[nodiscard]] bool IsMapHosted(uint32 mapId) const { return _hostedMaps.empty() || _hostedMaps.count(mapId); }
     void InitializeVisibilityDistanceInfo();
 
     /* statistics */
@@ -151,7 +157,13 @@ public:
     void RegisterInstanceId(uint32 instanceId);
     uint32 GenerateInstanceId();
 
+    // Grids holding players at a clean shutdown, loaded by the next start before it accepts players
+    void SaveWarmRestartGrids(std::string const& fileName);
+    void LoadWarmRestartGrids(std::string const& fileName, uint32 maxAgeSeconds);
+
     MapUpdater* GetMapUpdater() { return &m_updater; }
+    MapRegionUpdater* GetRegionUpdater() { return &m_regionUpdater; }
+    GridPrefetcher* GetGridPrefetcher() { return &m_gridPrefetcher; }
 
     template<typename Worker>
     void DoForAllMaps(Worker&& worker);
@@ -174,9 +186,17 @@ private:
     IntervalTimer i_timer[4]; // continents, bgs/arenas, instances, total from the beginning
     uint8 mapUpdateStep;
 
+    void LoadHostedMaps();
+    void LoadIdleInstancePoolMaps();
+    void RefillIdleInstancePools();
+
     InstanceIds _instanceIds;
     uint32 _nextInstanceId;
+    std::unordered_set<uint32> _hostedMaps;
+    std::vector<uint32> _idleInstancePoolMaps;
     MapUpdater m_updater;
+    MapRegionUpdater m_regionUpdater;
+    GridPrefetcher m_gridPrefetcher;
 };
 
 template<typename Worker>
@@ -0,0 +1,125 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapRegionUpdater.h"
+#include "DatabaseEnv.h"
+#include "HeapAllocator.h"
+#include "ProcessPriority.h"
+#include "TickArena.h"
+#include "World.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+struct MapRegionUpdater::Batch
+{
+    explicit Batch(std::vector<RegionTask> const& tasks) : Tasks(tasks), NextTask(0), FinishedTasks(0) { }
+
+    std::vector<RegionTask> Tasks;    // copied, late helpers may still look at a finished batch
+    std::atomic<size_t> NextTask;
+    std::atomic<size_t> FinishedTasks;
+
+    std::mutex Lock;
+    std::condition_variable Finished;
+};
+
+void MapRegionUpdater::activate(size_t num_threads)
+{
+    _workerThreads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerThreads.push_back(std::thread(&MapRegionUpdater::WorkerThread, this, i));
+}
+
+void MapRegionUpdater::deactivate()
+{
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _workerThreads.clear();
+}
+
+void MapRegionUpdater::Execute(std::vector<RegionTask> const& tasks)
+{
+    if (tasks.empty())
+        return;
+
+    if (tasks.size() == 1 || !activated())
+    {
+        for (RegionTask const& task : tasks)
+            task();
+
+        return;
+    }
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>(tasks);
+
+    // the calling thread handles one share of the work itself
+    size_t helpers = std::min(tasks.size() - 1, _workerThreads.size());
+    for (size_t i = 0; i < helpers; ++i)
+        _queue.Push(batch);
+
+    RunTasks(*batch);
+
+    std::unique_lock<std::mutex> guard(batch->Lock);
+    while (batch->FinishedTasks < tasks.size())
+        batch->Finished.wait(guard);
+}
+
+void MapRegionUpdater::RunTasks(Batch& batch)
+{
+    // helpers have no map update of their own around the tasks
+    Acore::TickArenaScope arenaScope;
+
+    size_t taskIndex;
+    while ((taskIndex = batch.NextTask++) < batch.Tasks.size())
+    {
+        batch.Tasks[taskIndex]();
+
+        if (++batch.FinishedTasks == batch.Tasks.size())
+        {
+            std::lock_guard<std::mutex> guard(batch.Lock);
+            batch.Finished.notify_all();
+        }
+    }
+}
+
+void MapRegionUpdater::WorkerThread(size_t workerIndex)
+{
+    SetupCurrentThread("MapRegion", uint32(workerIndex));
+
+    if (sWorld->getBoolConfig(CONFIG_MAP_WORKER_HEAP_ARENAS))
+        Acore::Heap::UseThreadArena("map_worker");
+
+    LoginDatabase.WarnAboutSyncQueries(true);
+    CharacterDatabase.WarnAboutSyncQueries(true);
+    WorldDatabase.WarnAboutSyncQueries(true);
+
+    while (true)
+    {
+        std::shared_ptr<Batch> batch;
+
+        _queue.WaitAndPop(batch);
+        if (!batch)
+            return;
+
+        RunTasks(*batch);
+    }
+}
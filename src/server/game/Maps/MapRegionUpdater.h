@@ -0,0 +1,59 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAP_REGION_UPDATER_H_INCLUDED
+#define _MAP_REGION_UPDATER_H_INCLUDED
+
+#include "Define.h"
+#include "LockFreePCQueue.h"
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*
+ * Helper threads used by Map::Update to process independent cell regions of a
+ * single continent in parallel. The thread calling Execute() takes part in the
+ * work, so a map update thread never blocks waiting for an idle pool.
+ * World::UpdateSessions uses its own instance for session-local packets.
+ */
+class MapRegionUpdater
+{
+public:
+    typedef std::function<void()> RegionTask;
+
+    MapRegionUpdater() = default;
+    ~MapRegionUpdater() = default;
+
+    void activate(size_t num_threads);
+    void deactivate();
+    [[nodiscard]] bool activated() const { return !_workerThreads.empty(); }
+
+    // runs all tasks and returns once every one of them has finished
+    void Execute(std::vector<RegionTask> const& tasks);
+
+private:
+    struct Batch;
+
+    void WorkerThread(size_t workerIndex);
+    static void RunTasks(Batch& batch);
+
+    WorkerQueue<std::shared_ptr<Batch>> _queue;
+    std::vector<std::thread> _workerThreads;
+};
+
+#endif //_MAP_REGION_UPDATER_H_INCLUDED
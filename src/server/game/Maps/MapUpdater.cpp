@@ -17,37 +17,72 @@
 
 #include "MapUpdater.h"
 #include "DatabaseEnv.h"
+#include "HeapAllocator.h"
 #include "LFGMgr.h"
 #include "Map.h"
 #include "Metric.h"
+#include "MetricRegistry.h"
+#include "ProcessPriority.h"
+#include "World.h"
+#include <algorithm>
+#include <chrono>
 
 class UpdateRequest
 {
 public:
-    UpdateRequest() = default;
+    explicit UpdateRequest(uint32 cost) : _cost(cost) { }
     virtual ~UpdateRequest() = default;
 
     virtual void call() = 0;
+
+    // last measured execution time in microseconds, used for scheduling only
+    [[nodiscard]] uint32 GetCost() const { return _cost; }
+
+private:
+    uint32 _cost;
 };
 
+namespace
+{
+    uint32 ElapsedMicroseconds(std::chrono::steady_clock::time_point start)
+    {
+        return uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
 class MapUpdateRequest : public UpdateRequest
 {
 public:
-    MapUpdateRequest(Map& m, MapUpdater& u, uint32 d, uint32 sd)
-        : m_map(m), m_updater(u), m_diff(d), s_diff(sd)
+    MapUpdateRequest(Map& m, MapUpdater& u, MapUpdateClass c, uint32 d, uint32 sd)
+        : UpdateRequest(m.GetLastUpdateCost()), m_map(m), m_updater(u), m_class(c), m_diff(d), s_diff(sd)
     {
     }
 
     void call() override
     {
         METRIC_TIMER("map_update_time_diff", METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         m_map.Update(m_diff, s_diff);
+
+        uint32 cost = ElapsedMicroseconds(start);
+        m_map.SetLastUpdateCost(cost);
+
+        METRIC_VALUE("map_update_cost", cost,
+            METRIC_TAG("map_id", std::to_string(m_map.GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(m_map.GetInstanceId())));
+
+        if (sMetric->IsExporterEnabled())
+            m_map.GetUpdateTimeHistogram().Observe(cost / 1000000.0);
+
+        m_updater.AddClassUpdateCost(m_class, cost);
         m_updater.update_finished();
     }
 
 private:
     Map& m_map;
     MapUpdater& m_updater;
+    MapUpdateClass m_class;
     uint32 m_diff;
     uint32 s_diff;
 };
@@ -55,11 +90,13 @@ private:
 class LFGUpdateRequest : public UpdateRequest
 {
 public:
-    LFGUpdateRequest(MapUpdater& u, uint32 d) : m_updater(u), m_diff(d) {}
+    LFGUpdateRequest(MapUpdater& u, uint32 d, uint32 cost) : UpdateRequest(cost), m_updater(u), m_diff(d) {}
 
     void call() override
     {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
         sLFGMgr->Update(m_diff, 1);
+        m_updater.SetLFGUpdateCost(ElapsedMicroseconds(start));
         m_updater.update_finished();
     }
 private:
@@ -67,26 +104,103 @@ private:
     uint32 m_diff;
 };
 
-MapUpdater::MapUpdater(): pending_requests(0)
+class MapUnloadRequest : public UpdateRequest
+{
+public:
+    MapUnloadRequest(Map& m, MapUpdater& u, MapUpdateClass c)
+        : UpdateRequest(m.GetLastUpdateCost()), m_map(m), m_updater(u), m_class(c)
+    {
+    }
+
+    void call() override
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        m_map.UnloadAll();
+
+        m_updater.AddClassUpdateCost(m_class, ElapsedMicroseconds(start));
+        m_updater.update_finished();
+    }
+
+private:
+    Map& m_map;
+    MapUpdater& m_updater;
+    MapUpdateClass m_class;
+};
+
+MapUpdater::MapUpdater(): _classPools(), _cancelationToken(false), pending_requests(0), _lfgUpdateCost(0)
 {
 }
 
-void MapUpdater::activate(size_t num_threads)
+MapUpdateClass MapUpdater::GetUpdateClass(Map const& map)
 {
-    _workerThreads.reserve(num_threads);
-    for (size_t i = 0; i < num_threads; ++i)
+    if (map.IsBattleArena())
+        return MAP_UPDATE_CLASS_ARENA;
+
+    if (map.IsBattleground())
+        return MAP_UPDATE_CLASS_BATTLEGROUND;
+
+    if (map.IsRaid())
+        return MAP_UPDATE_CLASS_RAID;
+
+    if (map.IsDungeon())
+        return MAP_UPDATE_CLASS_DUNGEON;
+
+    return MAP_UPDATE_CLASS_CONTINENT;
+}
+
+char const* MapUpdater::GetUpdateClassName(MapUpdateClass updateClass)
+{
+    switch (updateClass)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        case MAP_UPDATE_CLASS_CONTINENT:
+            return "continent";
+        case MAP_UPDATE_CLASS_DUNGEON:
+            return "dungeon";
+        case MAP_UPDATE_CLASS_RAID:
+            return "raid";
+        case MAP_UPDATE_CLASS_BATTLEGROUND:
+            return "battleground";
+        case MAP_UPDATE_CLASS_ARENA:
+            return "arena";
+        default:
+            return "unknown";
     }
 }
 
+void MapUpdater::activate(size_t num_threads, ClassThreadCounts const& dedicatedThreads)
+{
+    auto createPool = [this](size_t threads)
+    {
+        WorkerPool* pool = _pools.emplace_back(std::make_unique<WorkerPool>()).get();
+        pool->Queues.reserve(threads);
+        for (size_t i = 0; i < threads; ++i)
+            pool->Queues.push_back(std::make_unique<WorkerQueue>());
+
+        return pool;
+    };
+
+    WorkerPool* sharedPool = createPool(num_threads);
+    for (uint8 updateClass = 0; updateClass < MAX_MAP_UPDATE_CLASSES; ++updateClass)
+        _classPools[updateClass] = dedicatedThreads[updateClass] ? createPool(dedicatedThreads[updateClass]) : sharedPool;
+
+    // workers are numbered across all pools, the shared ones first
+    size_t workerIndex = 0;
+    for (auto& pool : _pools)
+        for (size_t i = 0; i < pool->Queues.size(); ++i)
+            _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, pool.get(), i, workerIndex++));
+}
+
 void MapUpdater::deactivate()
 {
     _cancelationToken = true;
 
     wait();
 
-    _queue.Cancel();
+    for (auto& pool : _pools)
+    {
+        std::lock_guard<std::mutex> guard(pool->WorkLock);
+        pool->WorkCondition.notify_all();
+    }
 
     for (auto& thread : _workerThreads)
     {
@@ -95,6 +209,17 @@ void MapUpdater::deactivate()
             thread.join();
         }
     }
+
+    for (auto& pool : _pools)
+    {
+        for (auto& queue : pool->Queues)
+        {
+            for (UpdateRequest* request : queue->Requests)
+                delete request;
+
+            queue->Requests.clear();
+        }
+    }
 }
 
 void MapUpdater::wait()
@@ -109,20 +234,34 @@ void MapUpdater::wait()
 
 void MapUpdater::schedule_update(Map& map, uint32 diff, uint32 s_diff)
 {
-    std::lock_guard<std::mutex> guard(_lock);
-
-    ++pending_requests;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++pending_requests;
+    }
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff, s_diff));
+    MapUpdateClass updateClass = GetUpdateClass(map);
+    Enqueue(*_classPools[updateClass], new MapUpdateRequest(map, *this, updateClass, diff, s_diff));
 }
 
 void MapUpdater::schedule_lfg_update(uint32 diff)
 {
-    std::lock_guard<std::mutex> guard(_lock);
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++pending_requests;
+    }
 
-    ++pending_requests;
+    Enqueue(*_pools.front(), new LFGUpdateRequest(*this, diff, _lfgUpdateCost));
+}
 
-    _queue.Push(new LFGUpdateRequest(*this, diff));
+void MapUpdater::schedule_unload(Map& map)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++pending_requests;
+    }
+
+    MapUpdateClass updateClass = GetUpdateClass(map);
+    Enqueue(*_classPools[updateClass], new MapUnloadRequest(map, *this, updateClass));
 }
 
 bool MapUpdater::activated()
@@ -139,19 +278,136 @@ void MapUpdater::update_finished()
     _condition.notify_all();
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::AddClassUpdateCost(MapUpdateClass updateClass, uint32 cost)
+{
+    ClassTimes& times = _classTimes[updateClass];
+    times.TotalCost += cost;
+    ++times.Updates;
+
+    uint32 maxCost = times.MaxCost;
+    while (cost > maxCost && !times.MaxCost.compare_exchange_weak(maxCost, cost)) { }
+}
+
+void MapUpdater::ReportClassTimes()
 {
+    for (uint8 updateClass = 0; updateClass < MAX_MAP_UPDATE_CLASSES; ++updateClass)
+    {
+        ClassTimes& times = _classTimes[updateClass];
+        uint32 const updates = times.Updates.exchange(0);
+        uint64 const totalCost = times.TotalCost.exchange(0);
+        uint32 const maxCost = times.MaxCost.exchange(0);
+
+        if (!updates)
+            continue;
+
+        char const* className = GetUpdateClassName(MapUpdateClass(updateClass));
+        METRIC_VALUE("map_update_class_time", totalCost, METRIC_TAG("class", className));
+        METRIC_VALUE("map_update_class_max", maxCost, METRIC_TAG("class", className));
+        METRIC_VALUE("map_update_class_maps", updates, METRIC_TAG("class", className));
+    }
+}
+
+void MapUpdater::Enqueue(WorkerPool& pool, UpdateRequest* request)
+{
+    // hand the request to the worker with the least amount of queued work
+    WorkerQueue* target = pool.Queues.front().get();
+    for (auto& queue : pool.Queues)
+        if (queue->QueuedCost < target->QueuedCost)
+            target = queue.get();
+
+    {
+        std::lock_guard<std::mutex> guard(target->Lock);
+
+        auto itr = target->Requests.begin();
+        while (itr != target->Requests.end() && (*itr)->GetCost() >= request->GetCost())
+            ++itr;
+
+        target->Requests.insert(itr, request);
+        target->QueuedCost += request->GetCost();
+    }
+
+    std::lock_guard<std::mutex> guard(pool.WorkLock);
+    ++pool.UnclaimedRequests;
+    pool.WorkCondition.notify_one();
+}
+
+UpdateRequest* MapUpdater::PopOwn(WorkerPool& pool, size_t queueIndex)
+{
+    WorkerQueue& queue = *pool.Queues[queueIndex];
+    std::lock_guard<std::mutex> guard(queue.Lock);
+
+    if (queue.Requests.empty())
+        return nullptr;
+
+    // own work is processed most expensive first
+    UpdateRequest* request = queue.Requests.front();
+    queue.Requests.pop_front();
+    queue.QueuedCost -= request->GetCost();
+    return request;
+}
+
+UpdateRequest* MapUpdater::Steal(WorkerPool& pool, size_t queueIndex)
+{
+    // prefer the most loaded queue, any other non-empty queue will do otherwise
+    std::vector<WorkerQueue*> victims;
+    victims.reserve(pool.Queues.size());
+    for (size_t i = 0; i < pool.Queues.size(); ++i)
+        if (i != queueIndex)
+            victims.push_back(pool.Queues[i].get());
+
+    std::sort(victims.begin(), victims.end(), [](WorkerQueue const* left, WorkerQueue const* right)
+    {
+        return left->QueuedCost > right->QueuedCost;
+    });
+
+    for (WorkerQueue* victim : victims)
+    {
+        std::lock_guard<std::mutex> guard(victim->Lock);
+        if (victim->Requests.empty())
+            continue;
+
+        // steal from the cheap end, the owner keeps its expensive maps
+        UpdateRequest* request = victim->Requests.back();
+        victim->Requests.pop_back();
+        victim->QueuedCost -= request->GetCost();
+        return request;
+    }
+
+    return nullptr;
+}
+
+void MapUpdater::WorkerThread(WorkerPool* pool, size_t queueIndex, size_t workerIndex)
+{
+    SetupCurrentThread("MapUpdater", uint32(workerIndex));
+
+    if (sWorld->getBoolConfig(CONFIG_MAP_WORKER_HEAP_ARENAS))
+        Acore::Heap::UseThreadArena("map_worker");
+
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
 
     while (1)
     {
-        UpdateRequest* request = nullptr;
+        {
+            // claim one queued request, it is guaranteed to be in one of the queues of the pool
+            std::unique_lock<std::mutex> guard(pool->WorkLock);
+            while (!pool->UnclaimedRequests && !_cancelationToken)
+                pool->WorkCondition.wait(guard);
 
-        _queue.WaitAndPop(request);
-        if (_cancelationToken)
-            return;
+            if (!pool->UnclaimedRequests)
+                return;
+
+            --pool->UnclaimedRequests;
+        }
+
+        UpdateRequest* request = nullptr;
+        while (!request)
+        {
+            request = PopOwn(*pool, queueIndex);
+            if (!request)
+                request = Steal(*pool, queueIndex);
+        }
 
         request->call();
 
@@ -19,39 +19,110 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
-#include "PCQueue.h"
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 class Map;
 class UpdateRequest;
 
+// Maps of a class can be given their own workers, so a slow continent tick does not delay arenas
+enum MapUpdateClass : uint8
+{
+    MAP_UPDATE_CLASS_CONTINENT,
+    MAP_UPDATE_CLASS_DUNGEON,
+    MAP_UPDATE_CLASS_RAID,
+    MAP_UPDATE_CLASS_BATTLEGROUND,
+    MAP_UPDATE_CLASS_ARENA,
+    MAX_MAP_UPDATE_CLASSES
+};
+
+/*
+ * Work-stealing map update scheduler.
+ *
+ * Every worker owns a queue of requests kept sorted by the last measured update
+ * cost of the map (longest first). New requests go to the worker with the least
+ * queued cost, and a worker that runs out of work steals the cheapest request
+ * (usually an instance or battleground) from the most loaded queue.
+ *
+ * Workers are grouped in pools. The shared pool updates every map class without
+ * dedicated workers; a dedicated pool only updates maps of its own class and its
+ * workers never steal from, or are stolen from by, other pools.
+ */
 class MapUpdater
 {
 public:
+    typedef std::array<uint32, MAX_MAP_UPDATE_CLASSES> ClassThreadCounts;
+
     MapUpdater();
     ~MapUpdater() = default;
 
+    static MapUpdateClass GetUpdateClass(Map const& map);
+    static char const* GetUpdateClassName(MapUpdateClass updateClass);
+
     void schedule_update(Map& map, uint32 diff, uint32 s_diff);
     void schedule_lfg_update(uint32 diff);
+    // unloads the grids of a map that was taken out of its parent, the caller deletes it after wait()
+    void schedule_unload(Map& map);
     void wait();
-    void activate(size_t num_threads);
+    void activate(size_t num_threads, ClassThreadCounts const& dedicatedThreads = {});
     void deactivate();
     bool activated();
     void update_finished();
 
+    void SetLFGUpdateCost(uint32 cost) { _lfgUpdateCost = cost; }
+
+    // accounts a finished map update to its class, sent as metrics by ReportClassTimes()
+    void AddClassUpdateCost(MapUpdateClass updateClass, uint32 cost);
+    // sends the update time of every class since the last call, called once per world tick after wait()
+    void ReportClassTimes();
+
 private:
-    void WorkerThread();
+    struct WorkerQueue
+    {
+        std::mutex Lock;
+        std::deque<UpdateRequest*> Requests;    // sorted by cost, most expensive first
+        std::atomic<uint64> QueuedCost = 0;
+    };
+
+    struct WorkerPool
+    {
+        std::vector<std::unique_ptr<WorkerQueue>> Queues;
 
-    ProducerConsumerQueue<UpdateRequest*> _queue;
+        // number of queued requests not yet claimed by a worker of the pool
+        std::mutex WorkLock;
+        std::condition_variable WorkCondition;
+        size_t UnclaimedRequests = 0;
+    };
 
+    struct ClassTimes
+    {
+        std::atomic<uint64> TotalCost = 0;      // microseconds
+        std::atomic<uint32> MaxCost = 0;
+        std::atomic<uint32> Updates = 0;
+    };
+
+    void WorkerThread(WorkerPool* pool, size_t queueIndex, size_t workerIndex);
+    void Enqueue(WorkerPool& pool, UpdateRequest* request);
+    UpdateRequest* PopOwn(WorkerPool& pool, size_t queueIndex);
+    UpdateRequest* Steal(WorkerPool& pool, size_t queueIndex);
+
+    std::vector<std::unique_ptr<WorkerPool>> _pools;    // the shared pool first
+    std::array<WorkerPool*, MAX_MAP_UPDATE_CLASSES> _classPools;
+    std::array<ClassTimes, MAX_MAP_UPDATE_CLASSES> _classTimes;
     std::vector<std::thread> _workerThreads;
     std::atomic<bool> _cancelationToken;
 
     std::mutex _lock;
     std::condition_variable _condition;
     size_t pending_requests;
+
+    std::atomic<uint32> _lfgUpdateCost;
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -32,6 +32,38 @@ TransportTemplate::~TransportTemplate()
         delete *itr;
 }
 
+void KeyFrame::GetPathPosition(uint32 pathTime, float& x, float& y, float& z, float& o) const
+{
+    uint32 const elapsed = pathTime > DepartureTime ? pathTime - DepartureTime : 0;
+    size_t const index = std::min<size_t>(elapsed / TRANSPORT_PATH_SAMPLE_INTERVAL, Samples.size() - 1);
+    TransportPathSample const& from = Samples[index];
+    if (index + 1 == Samples.size())
+    {
+        x = from.X;
+        y = from.Y;
+        z = from.Z;
+        o = from.O;
+        return;
+    }
+
+    // the last interval ends at NextArriveTime and can be shorter
+    TransportPathSample const& to = Samples[index + 1];
+    uint32 const intervalStart = index * TRANSPORT_PATH_SAMPLE_INTERVAL;
+    uint32 const intervalLength = std::min<uint32>(TRANSPORT_PATH_SAMPLE_INTERVAL, NextArriveTime - DepartureTime - intervalStart);
+    float const t = std::min(float(elapsed - intervalStart) / float(intervalLength), 1.0f);
+
+    x = from.X + (to.X - from.X) * t;
+    y = from.Y + (to.Y - from.Y) * t;
+    z = from.Z + (to.Z - from.Z) * t;
+
+    // turn the short way round
+    float turn = Position::NormalizeOrientation(to.O - from.O);
+    if (turn > float(M_PI))
+        turn -= float(2 * M_PI);
+
+    o = Position::NormalizeOrientation(from.O + turn * t);
+}
+
 TransportMgr::TransportMgr() { }
 
 TransportMgr::~TransportMgr() { }
@@ -111,6 +143,35 @@ public:
     Movement::PointsArray& _points;
 };
 
+// Share of the spline segment of the frame the transport covered at the given path time (in seconds)
+static float CalculateSegmentPos(TransportTemplate const* transport, KeyFrame const& frame, float speed, float accel, float now)
+{
+    float timeSinceStop = frame.TimeFrom + (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
+    float timeUntilStop = frame.TimeTo - (now - (1.0f / IN_MILLISECONDS) * frame.DepartureTime);
+    float segmentPos, dist;
+    float accelTime = transport->accelTime;
+    float accelDist = transport->accelDist;
+    // calculate from nearest stop, less confusing calculation...
+    if (timeSinceStop < timeUntilStop)
+    {
+        if (timeSinceStop < accelTime)
+            dist = 0.5f * accel * timeSinceStop * timeSinceStop;
+        else
+            dist = accelDist + (timeSinceStop - accelTime) * speed;
+        segmentPos = dist - frame.DistSinceStop;
+    }
+    else
+    {
+        if (timeUntilStop < accelTime)
+            dist = 0.5f * accel * timeUntilStop * timeUntilStop;
+        else
+            dist = accelDist + (timeUntilStop - accelTime) * speed;
+        segmentPos = frame.DistUntilStop - dist;
+    }
+
+    return segmentPos / frame.NextDistFromPrev;
+}
+
 void TransportMgr::GeneratePath(GameObjectTemplate const* goInfo, TransportTemplate* transport)
 {
     uint32 pathId = goInfo->moTransport.taxiPathId;
@@ -344,6 +405,31 @@ void TransportMgr::GeneratePath(GameObjectTemplate const* goInfo, TransportTempl
     keyFrames.back().NextArriveTime = keyFrames.back().DepartureTime;
 
     transport->pathTime = keyFrames.back().DepartureTime;
+
+    // sample the splines once here, moving transports only interpolate between the samples
+    for (KeyFrame& frame : keyFrames)
+    {
+        if (frame.NextDistFromPrev <= 0.0f || frame.NextArriveTime <= frame.DepartureTime)
+        {
+            // nothing to travel, the transport waits at the node or teleports away from it
+            frame.Samples.push_back({ frame.Node->x, frame.Node->y, frame.Node->z, frame.InitialOrientation });
+            continue;
+        }
+
+        uint32 const duration = frame.NextArriveTime - frame.DepartureTime;
+        frame.Samples.reserve(duration / TRANSPORT_PATH_SAMPLE_INTERVAL + 2);
+        for (uint32 time = 0;; time = std::min(time + TRANSPORT_PATH_SAMPLE_INTERVAL, duration))
+        {
+            float t = CalculateSegmentPos(transport, frame, speed, accel, float(frame.DepartureTime + time) * 0.001f);
+            G3D::Vector3 pos, dir;
+            frame.Spline->evaluate_percent(frame.Index, t, pos);
+            frame.Spline->evaluate_derivative(frame.Index, t, dir);
+            frame.Samples.push_back({ pos.x, pos.y, pos.z, Position::NormalizeOrientation(std::atan2(dir.y, dir.x) + M_PI) });
+
+            if (time == duration)
+                break;
+        }
+    }
 }
 
 void TransportMgr::AddPathNodeToTransport(uint32 transportEntry, uint32 timeSeg, TransportAnimationEntry const* node)
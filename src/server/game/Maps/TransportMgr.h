@@ -38,6 +38,17 @@ typedef std::set<MotionTransport*>               TransportSet;
 typedef std::unordered_map<uint32, TransportSet>      TransportMap;
 typedef std::unordered_map<uint32, std::set<uint32> > TransportInstanceMap;
 
+// Time between two precomputed positions of a transport path, in milliseconds
+#define TRANSPORT_PATH_SAMPLE_INTERVAL 100
+
+struct TransportPathSample
+{
+    float X;
+    float Y;
+    float Z;
+    float O;
+};
+
 struct KeyFrame
 {
     explicit KeyFrame(TaxiPathNodeEntry const* node) : Index(0), Node(node), InitialOrientation(0.0f),
@@ -63,8 +74,14 @@ struct KeyFrame
     float NextDistFromPrev;
     uint32 NextArriveTime;
 
+    // Positions on the way to the next frame, one every TRANSPORT_PATH_SAMPLE_INTERVAL from DepartureTime, the last one at NextArriveTime
+    std::vector<TransportPathSample> Samples;
+
     bool IsTeleportFrame() const { return Teleport; }
     bool IsStopFrame() const { return Node->actionFlag == 2; }
+
+    // Interpolates the position at the given path time between DepartureTime and NextArriveTime from the samples
+    void GetPathPosition(uint32 pathTime, float& x, float& y, float& z, float& o) const;
 };
 
 struct TransportTemplate
@@ -59,10 +59,15 @@ bool AuctionListItemsDelayEvent::Execute()
     wstrToLower(wsearchedname);
 
     uint32 searchTimeout = sWorld->getIntConfig(CONFIG_AUCTION_HOUSE_SEARCH_TIMEOUT);
-    bool result = auctionHouse->BuildListAuctionItems(data, plr,
-                  wsearchedname, _listfrom, _levelmin, _levelmax, _usable,
-                  _auctionSlotID, _auctionMainCategory, _auctionSubCategory, _quality,
-                  count, totalcount, _getAll, _sortOrder, Milliseconds(searchTimeout));
+    bool result;
+    {
+        // other listing threads search in parallel, the world thread waits before it changes the auctions
+        std::shared_lock<std::shared_mutex> lock(sAuctionMgr->GetListingLock());
+        result = auctionHouse->BuildListAuctionItems(data, plr,
+                 wsearchedname, _listfrom, _levelmin, _levelmax, _usable,
+                 _auctionSlotID, _auctionMainCategory, _auctionSubCategory, _quality,
+                 count, totalcount, _getAll, _sortOrder, Milliseconds(searchTimeout));
+    }
 
     if (result)
     {
@@ -74,3 +79,34 @@ bool AuctionListItemsDelayEvent::Execute()
 
     return true;
 }
+
+void AsyncAuctionListingMgr::Update(Milliseconds diff)
+{
+    std::lock_guard<std::mutex> guard(auctionListingTempLock);
+    auctionListingDiff += diff;
+}
+
+Optional<AuctionListItemsDelayEvent> AsyncAuctionListingMgr::PopReadyEvent()
+{
+    std::lock_guard<std::mutex> guard(auctionListingTempLock);
+
+    auctionListingList.splice(auctionListingList.end(), auctionListingListTemp);
+
+    Milliseconds diff = auctionListingDiff;
+    auctionListingDiff = Milliseconds::zero();
+
+    for (AuctionListItemsDelayEvent& delayEvent : auctionListingList)
+        delayEvent._pickupTimer = delayEvent._pickupTimer > diff ? delayEvent._pickupTimer - diff : Milliseconds::zero();
+
+    for (auto itr = auctionListingList.begin(); itr != auctionListingList.end(); ++itr)
+    {
+        if (itr->_pickupTimer != Milliseconds::zero())
+            continue;
+
+        Optional<AuctionListItemsDelayEvent> delayEvent = std::move(*itr);
+        auctionListingList.erase(itr);
+        return delayEvent;
+    }
+
+    return {};
+}
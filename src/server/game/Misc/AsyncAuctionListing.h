@@ -19,6 +19,7 @@
 #define __ASYNCAUCTIONLISTING_H
 
 #include "AuctionHouseMgr.h"
+#include "Optional.h"
 
 #include <mutex>
 
@@ -65,13 +66,13 @@ public:
 class AsyncAuctionListingMgr
 {
 public:
-    static void Update(Milliseconds diff) { auctionListingDiff += diff; }
-    static Milliseconds GetDiff() { return auctionListingDiff; }
-    static void ResetDiff() { auctionListingDiff = Milliseconds::zero(); }
-    static std::list<AuctionListItemsDelayEvent>& GetList() { return auctionListingList; }
+    static void Update(Milliseconds diff);
     static std::list<AuctionListItemsDelayEvent>& GetTempList() { return auctionListingListTemp; }
     static std::mutex& GetTempLock() { return auctionListingTempLock; }
 
+    /// Called by the auction listing threads, takes the next listing whose delay has passed
+    static Optional<AuctionListItemsDelayEvent> PopReadyEvent();
+
 private:
     static Milliseconds auctionListingDiff;
     static std::list<AuctionListItemsDelayEvent> auctionListingList;
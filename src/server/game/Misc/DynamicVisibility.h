@@ -19,6 +19,7 @@
 #define __DYNAMICVISIBILITY_H
 
 #include "Common.h"
+#include <algorithm>
 
 struct VisibilitySettingData
 {
@@ -51,6 +52,8 @@ public:
     static uint32 GetVisibilityNotifyDelay(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].visibilityNotifyDelay; }
     static uint32 GetAINotifyDelay(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].aiNotifyDelay; }
     static float GetReqMoveDistSq(uint32 map_type) { return VisibilitySettings[visibilitySettingsIndex][map_type].requiredMoveDistanceSq; }
+    // idle objects are updated at full rate below 500 players, then one more tick apart per interval, up to maxInterval
+    static uint32 GetIdleObjectUpdateInterval(uint32 maxInterval) { return std::max<uint32>(1, std::min<uint32>(maxInterval, visibilitySettingsIndex + 1)); }
 protected:
     static uint8 visibilitySettingsIndex;
 };
@@ -309,13 +309,15 @@ void MotionMaster::MoveChase(Unit* target,  std::optional<ChaseRange> dist, std:
     {
         LOG_DEBUG("movement.motionmaster", "Player ({}) chase to {} ({})",
             _owner->GetGUID().ToString(), target->GetTypeId() == TYPEID_PLAYER ? "player" : "creature", target->GetGUID().ToString());
-        Mutate(new ChaseMovementGenerator<Player>(target, dist, angle), MOTION_SLOT_ACTIVE);
+        if (!RetargetChase<Player>(target, dist, angle))
+            Mutate(new ChaseMovementGenerator<Player>(target, dist, angle), MOTION_SLOT_ACTIVE);
     }
     else
     {
         LOG_DEBUG("movement.motionmaster", "Creature ({}) chase to {} ({})",
             _owner->GetGUID().ToString(), target->GetTypeId() == TYPEID_PLAYER ? "player" : "creature", target->GetGUID().ToString());
-        Mutate(new ChaseMovementGenerator<Creature>(target, dist, angle), MOTION_SLOT_ACTIVE);
+        if (!RetargetChase<Creature>(target, dist, angle))
+            Mutate(new ChaseMovementGenerator<Creature>(target, dist, angle), MOTION_SLOT_ACTIVE);
     }
 }
 
@@ -433,6 +435,25 @@ void MotionMaster::MovePoint(uint32 id, float x, float y, float z, bool generate
     }
 }
 
+void MotionMaster::MovePoint(uint32 id, Movement::PointsArray const& path, MovementSlot slot)
+{
+    // Xinef: do not allow to move with UNIT_FLAG_DISABLE_MOVE
+    if (_owner->HasUnitFlag(UNIT_FLAG_DISABLE_MOVE) || path.empty())
+        return;
+
+    G3D::Vector3 const& dest = path.back();
+    if (_owner->GetTypeId() == TYPEID_PLAYER)
+    {
+        LOG_DEBUG("movement.motionmaster", "Player ({}) targeted point along a path (Id: {} X: {} Y: {} Z: {})", _owner->GetGUID().ToString(), id, dest.x, dest.y, dest.z);
+        Mutate(new PointMovementGenerator<Player>(id, dest.x, dest.y, dest.z, 0.0f, 0.0f, &path), slot);
+    }
+    else
+    {
+        LOG_DEBUG("movement.motionmaster", "Creature ({}) targeted point along a path (ID: {} X: {} Y: {} Z: {})", _owner->GetGUID().ToString(), id, dest.x, dest.y, dest.z);
+        Mutate(new PointMovementGenerator<Creature>(id, dest.x, dest.y, dest.z, 0.0f, 0.0f, &path), slot);
+    }
+}
+
 void MotionMaster::MoveSplinePath(Movement::PointsArray* path)
 {
     // Xinef: do not allow to move with UNIT_FLAG_DISABLE_MOVE
@@ -456,7 +477,7 @@ void MotionMaster::MoveSplinePath(uint32 path_id)
     WaypointPath const* path = sWaypointMgr->GetPath(path_id);
     for (uint8 i = 0; i < path->size(); ++i)
     {
-        WaypointData const* node = path->at(i);
+        WaypointData const* node = &path->at(i);
         points->push_back(G3D::Vector3(node->x, node->y, node->z));
     }
 
@@ -797,6 +818,32 @@ void MotionMaster::Mutate(MovementGenerator* m, MovementSlot slot)
     }
 }
 
+// Mobs switching targets chase again and again, the generator they already have is finalized and reused for the new target
+template<class T>
+bool MotionMaster::RetargetChase(Unit* target, std::optional<ChaseRange> dist, std::optional<ChaseAngle> angle)
+{
+    // an updating generator is only replaced, it must stay untouched until its update returns
+    if (_top == MOTION_SLOT_ACTIVE && (_cleanFlag & MMCF_UPDATE))
+        return false;
+
+    ChaseMovementGenerator<T>* chase = dynamic_cast<ChaseMovementGenerator<T>*>(Impl[MOTION_SLOT_ACTIVE]);
+    if (!chase)
+        return false;
+
+    chase->Finalize(_owner);
+    chase->Retarget(target, dist, angle);
+
+    if (_top > MOTION_SLOT_ACTIVE)
+        _needInit[MOTION_SLOT_ACTIVE] = true;
+    else
+    {
+        _needInit[MOTION_SLOT_ACTIVE] = false;
+        chase->Initialize(_owner);
+    }
+
+    return true;
+}
+
 void MotionMaster::MovePath(uint32 path_id, bool repeatable)
 {
     if (!path_id)
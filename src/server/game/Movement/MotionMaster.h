@@ -211,6 +211,7 @@ public:
     void MovePoint(uint32 id, const Position& pos, bool generatePath = true, bool forceDestination = true)
     { MovePoint(id, pos.m_positionX, pos.m_positionY, pos.m_positionZ, generatePath, forceDestination, MOTION_SLOT_ACTIVE, pos.GetOrientation()); }
     void MovePoint(uint32 id, float x, float y, float z, bool generatePath = true, bool forceDestination = true, MovementSlot slot = MOTION_SLOT_ACTIVE, float orientation = 0.0f);
+    void MovePoint(uint32 id, Movement::PointsArray const& path, MovementSlot slot = MOTION_SLOT_ACTIVE); // walks a path computed by the caller, ending at its last point
     void MoveSplinePath(Movement::PointsArray* path);
     void MoveSplinePath(uint32 path_id);
 
@@ -246,6 +247,8 @@ public:
     bool GetDestination(float& x, float& y, float& z);
 private:
     void Mutate(MovementGenerator* m, MovementSlot slot);                  // use Move* functions instead
+    template<class T>
+    bool RetargetChase(Unit* target, std::optional<ChaseRange> dist, std::optional<ChaseAngle> angle);
 
     void DirectClean(bool reset);
     void DelayedClean();
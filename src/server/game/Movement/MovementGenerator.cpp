@@ -17,11 +17,57 @@
 
 #include "MovementGenerator.h"
 #include "IdleMovementGenerator.h"
+#include "NodePoolAllocator.h"
 
 MovementGenerator::~MovementGenerator()
 {
 }
 
+// size classes of 64 bytes, larger generators use the global heap
+template<std::size_t SizeClass>
+using MovementGeneratorPool = Acore::Impl::NodePool<SizeClass * 64>;
+static std::atomic<uint64> MovementGeneratorCreations{0};
+
+void* MovementGenerator::operator new(std::size_t size)
+{
+    ++MovementGeneratorCreations;
+    switch ((size + 63) / 64)
+    {
+        case 1: return MovementGeneratorPool<1>::Allocate();
+        case 2: return MovementGeneratorPool<2>::Allocate();
+        case 3: return MovementGeneratorPool<3>::Allocate();
+        case 4: return MovementGeneratorPool<4>::Allocate();
+        case 5: return MovementGeneratorPool<5>::Allocate();
+        case 6: return MovementGeneratorPool<6>::Allocate();
+        default: return ::operator new(size);
+    }
+}
+
+void MovementGenerator::operator delete(void* ptr, std::size_t size)
+{
+    switch ((size + 63) / 64)
+    {
+        case 1: MovementGeneratorPool<1>::Deallocate(ptr); break;
+        case 2: MovementGeneratorPool<2>::Deallocate(ptr); break;
+        case 3: MovementGeneratorPool<3>::Deallocate(ptr); break;
+        case 4: MovementGeneratorPool<4>::Deallocate(ptr); break;
+        case 5: MovementGeneratorPool<5>::Deallocate(ptr); break;
+        case 6: MovementGeneratorPool<6>::Deallocate(ptr); break;
+        default: ::operator delete(ptr); break;
+    }
+}
+
+uint64 MovementGenerator::TakeCreationCount()
+{
+    return MovementGeneratorCreations.exchange(0);
+}
+
+std::size_t MovementGenerator::GetPoolReservedBytes()
+{
+    return MovementGeneratorPool<1>::ReservedBytes() + MovementGeneratorPool<2>::ReservedBytes() + MovementGeneratorPool<3>::ReservedBytes() +
+        MovementGeneratorPool<4>::ReservedBytes() + MovementGeneratorPool<5>::ReservedBytes() + MovementGeneratorPool<6>::ReservedBytes();
+}
+
 MovementGenerator* IdleMovementFactory::Create(Unit* /*object*/) const
 {
     static IdleMovementGenerator instance;
@@ -31,6 +31,14 @@ class MovementGenerator
 public:
     virtual ~MovementGenerator();
 
+    // every Move* call creates a generator, they are recycled through per thread pools of a few size classes
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+    // generators created since the last call
+    static uint64 TakeCreationCount();
+    // memory held by the pools, in use or free
+    static std::size_t GetPoolReservedBytes();
+
     virtual void Initialize(Unit*) = 0;
     virtual void Finalize(Unit*) = 0;
 
@@ -92,6 +92,15 @@ bool FleeingMovementGenerator<T>::DoUpdate(T* owner, uint32 diff)
     else
         _interrupt = false;
 
+    // the previous flee path is kept until the new one is solved
+    if (_path && _path->IsPathPending())
+    {
+        if (_path->UpdatePendingPath())
+            MoveAlongPath(owner);
+
+        return true;
+    }
+
     _timer.Update(diff);
     if (!_interrupt && _timer.Passed() && owner->movespline->Finalized())
     {
@@ -139,8 +148,20 @@ void FleeingMovementGenerator<T>::SetTargetLocation(T* owner)
     }
 
     _path->SetPathLengthLimit(30.0f);
-    bool result = _path->CalculatePath(destination.GetPositionX(), destination.GetPositionY(), destination.GetPositionZ());
-    if (!result || (_path->GetPathType() & PathType(PATHFIND_NOPATH | PATHFIND_SHORTCUT | PATHFIND_FARFROMPOLY)))
+    if (!_path->CalculatePathAsync(destination.GetPositionX(), destination.GetPositionY(), destination.GetPositionZ()))
+    {
+        _timer.Reset(100);
+        return;
+    }
+
+    if (!_path->IsPathPending())
+        MoveAlongPath(owner);
+}
+
+template<class T>
+void FleeingMovementGenerator<T>::MoveAlongPath(T* owner)
+{
+    if (_path->GetPathType() & PathType(PATHFIND_NOPATH | PATHFIND_SHORTCUT | PATHFIND_FARFROMPOLY))
     {
         _timer.Reset(100);
         return;
@@ -227,6 +248,8 @@ template bool FleeingMovementGenerator<Player>::DoUpdate(Player*, uint32);
 template bool FleeingMovementGenerator<Creature>::DoUpdate(Creature*, uint32);
 template void FleeingMovementGenerator<Player>::SetTargetLocation(Player*);
 template void FleeingMovementGenerator<Creature>::SetTargetLocation(Creature*);
+template void FleeingMovementGenerator<Player>::MoveAlongPath(Player*);
+template void FleeingMovementGenerator<Creature>::MoveAlongPath(Creature*);
 template void FleeingMovementGenerator<Player>::GetPoint(Player*, Position&);
 template void FleeingMovementGenerator<Creature>::GetPoint(Creature*, Position&);
 
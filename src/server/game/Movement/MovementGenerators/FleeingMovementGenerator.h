@@ -35,6 +35,7 @@ class FleeingMovementGenerator : public MovementGeneratorMedium< T, FleeingMovem
 
     private:
         void SetTargetLocation(T*);
+        void MoveAlongPath(T*);
         void GetPoint(T*, Position& position);
 
         std::unique_ptr<PathGenerator> _path;
@@ -24,13 +24,14 @@
 #include "MMapMgr.h"
 #include "Map.h"
 #include "Metric.h"
+#include "PathfindingService.h"
 
  ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false), _forceDestination(false),
     _slopeCheck(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
-    _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _endPosition(G3D::Vector3::zero()), _source(owner), _sourceGuid(owner->GetGUID()), _navMesh(nullptr),
+    _navMeshQuery(nullptr), _pathCache(nullptr), _asyncSolve(false), _asyncFallback(false), _normalizePending(false), _pointPathPending(false)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
@@ -40,6 +41,7 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
         MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
         _navMesh = mmap->GetNavMesh(mapId);
         _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetInstanceId());
+        _pathCache = mmap->GetPathCache(mapId);
     }
 
     CreateFilter();
@@ -47,6 +49,8 @@ PathGenerator::PathGenerator(WorldObject const* owner) :
 
 PathGenerator::~PathGenerator()
 {
+    if (_pendingRequest)
+        _pendingRequest->Abandoned = true;
 }
 
 bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest)
@@ -64,6 +68,77 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
 
     METRIC_DETAILED_EVENT("mmap_events", "CalculatePath", "");
 
+    if (InitializePath(x, y, z, destX, destY, destZ, forceDest))
+        BuildPolyPath(GetStartPosition(), GetEndPosition());
+
+    return true;
+}
+
+bool PathGenerator::CalculatePathAsync(float destX, float destY, float destZ, bool forceDest)
+{
+    if (_pendingRequest)
+    {
+        _pendingRequest->Abandoned = true;
+        _pendingRequest = nullptr;
+    }
+
+    // slope checks and raycasts need map data in the middle of the Detour queries
+    if (!sPathfindingService->IsEnabled() || _slopeCheck || _useRaycast)
+        return CalculatePath(destX, destY, destZ, forceDest);
+
+    float x, y, z;
+    _source->GetPosition(x, y, z);
+
+    if (!Acore::IsValidMapCoord(destX, destY, destZ) || !Acore::IsValidMapCoord(x, y, z))
+        return false;
+
+    METRIC_DETAILED_EVENT("mmap_events", "CalculatePathAsync", "");
+
+    if (!InitializePath(x, y, z, destX, destY, destZ, forceDest))
+        return true;
+
+    std::unique_ptr<PathGenerator> solver(new PathGenerator(*this));
+    solver->_asyncSolve = true;
+
+    _pendingRequest = sPathfindingService->Submit(std::move(solver), _source->GetMapId(), _navMesh);
+    return true;
+}
+
+bool PathGenerator::UpdatePendingPath()
+{
+    if (!_pendingRequest)
+        return true;
+
+    if (!_pendingRequest->Done)
+        return false;
+
+    std::shared_ptr<PathfindingRequest> request = std::move(_pendingRequest);
+
+    PathGenerator const* solver = request->Path.get();
+    if (!solver || solver->_asyncFallback)
+    {
+        // the nav mesh changed meanwhile or the worker needed map data, solve it here from the current position
+        G3D::Vector3 dest = GetEndPosition();
+        CalculatePath(dest.x, dest.y, dest.z, _forceDestination);
+        return true;
+    }
+
+    memcpy(_pathPolyRefs, solver->_pathPolyRefs, sizeof(_pathPolyRefs));
+    _polyLength = solver->_polyLength;
+    _pathPoints = solver->_pathPoints;
+    _type = solver->_type;
+    _actualEndPosition = solver->_actualEndPosition;
+
+    if (solver->_pointPathPending)
+        FinishPointPath();
+    else if (solver->_normalizePending)
+        NormalizePath();
+
+    return true;
+}
+
+bool PathGenerator::InitializePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest)
+{
     G3D::Vector3 dest(destX, destY, destZ);
     SetEndPosition(dest);
 
@@ -80,15 +155,19 @@ bool PathGenerator::CalculatePath(float x, float y, float z, float destX, float
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
+        return false;
     }
 
     UpdateFilter();
-
-    BuildPolyPath(start, dest);
     return true;
 }
 
+void PathGenerator::SolveAsync(dtNavMeshQuery const* query)
+{
+    _navMeshQuery = query;
+    BuildPolyPath(GetStartPosition(), GetEndPosition());
+}
+
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
 {
     if (!polyPath || !polyPathSize)
@@ -172,15 +251,21 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
     _type = PathType(PATHFIND_NORMAL);
 
-    Creature const* creature = _source->ToCreature();
-
     // we have a hole in our mesh
     // make shortcut path and mark it as NOPATH ( with flying and swimming exception )
     // its up to caller how he will use this info
     if (startPoly == INVALID_POLYREF || endPoly == INVALID_POLYREF)
     {
+        // the swim and fly checks need the map
+        if (_asyncSolve)
+        {
+            _asyncFallback = true;
+            return;
+        }
+
         BuildShortcut();
 
+        Creature const* creature = _source->ToCreature();
         bool canSwim = creature ? creature->CanSwim() : true;
         bool path = creature ? creature->CanFly() : true;
         bool waterPath = IsWaterPath(_pathPoints);
@@ -209,6 +294,13 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
     // we just need to remove/normalize paths between 2 adjacent points
     if (startFarFromPoly || endFarFromPoly)
     {
+        // the liquid checks need the map
+        if (_asyncSolve)
+        {
+            _asyncFallback = true;
+            return;
+        }
+
         bool buildShortcut = false;
 
         auto liquidDataStart = _source->GetMap()->GetLiquidData(_source->GetPhaseMask(), startPos.x, startPos.y, startPos.z, _source->GetCollisionHeight(), MAP_ALL_LIQUIDS);
@@ -385,7 +477,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
             // this is probably an error state, but we'll leave it
             // and hopefully recover on the next Update
             // we still need to copy our preffix
-            LOG_ERROR("movement", "PathGenerator::BuildPolyPath: Path Build failed {}", _source->GetGUID().ToString());
+            LOG_ERROR("movement", "PathGenerator::BuildPolyPath: Path Build failed {}", _sourceGuid.ToString());
         }
 
         // new path = prefix + suffix - overlap
@@ -472,21 +564,33 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
         else
         {
-            dtResult = _navMeshQuery->findPath(
-                startPoly,          // start polygon
-                endPoly,            // end polygon
-                startPoint,         // start position
-                endPoint,           // end position
-                &_filter,           // polygon search filter
-                _pathPolyRefs,     // [out] path
-                (int*)&_polyLength,
-                MAX_PATH_LENGTH);   // max number of polygons in output path
+            // reuse the corridor of an earlier path between the same polygons, only the point path is rebuilt
+            MMAP::PathCacheKey cacheKey = { startPoly, endPoly, _filter.getIncludeFlags(), _filter.getExcludeFlags() };
+            if (_pathCache && _pathCache->Find(cacheKey, _pathPolyRefs, _polyLength, MAX_PATH_LENGTH))
+            {
+                dtResult = DT_SUCCESS;
+            }
+            else
+            {
+                dtResult = _navMeshQuery->findPath(
+                    startPoly,          // start polygon
+                    endPoly,            // end polygon
+                    startPoint,         // start position
+                    endPoint,           // end position
+                    &_filter,           // polygon search filter
+                    _pathPolyRefs,     // [out] path
+                    (int*)&_polyLength,
+                    MAX_PATH_LENGTH);   // max number of polygons in output path
+
+                if (_pathCache && _polyLength && dtStatusSucceed(dtResult))
+                    _pathCache->Insert(cacheKey, _pathPolyRefs, _polyLength);
+            }
         }
 
         if (!_polyLength || dtStatusFailed(dtResult))
         {
             // only happens if we passed bad data to findPath(), or navmesh is messed up
-            LOG_ERROR("movement", "PathGenerator::BuildPolyPath: {} Path Build failed: 0 length path", _source->GetGUID().ToString());
+            LOG_ERROR("movement", "PathGenerator::BuildPolyPath: {} Path Build failed: 0 length path", _sourceGuid.ToString());
             BuildShortcut();
             _type = PATHFIND_NOPATH;
             return;
@@ -495,7 +599,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
     if (!_polyLength)
     {
-        LOG_ERROR("movement", "PathGenerator::BuildPolyPath: {} Path Build failed: 0 length path", _source->GetGUID().ToString());
+        LOG_ERROR("movement", "PathGenerator::BuildPolyPath: {} Path Build failed: 0 length path", _sourceGuid.ToString());
         BuildShortcut();
         _type = PATHFIND_NOPATH;
         return;
@@ -525,7 +629,7 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
     if (_useRaycast)
     {
         // _straightLine uses raycast and it currently doesn't support building a point path, only a 2-point path with start and hitpoint/end is returned
-        LOG_ERROR("movement", "PathGenerator::BuildPointPath() called with _useRaycast for unit {}", _source->GetGUID().ToString());
+        LOG_ERROR("movement", "PathGenerator::BuildPointPath() called with _useRaycast for unit {}", _sourceGuid.ToString());
         BuildShortcut();
         _type = PATHFIND_NOPATH;
         return;
@@ -582,10 +686,22 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
     for (uint32 i = 0; i < pointCount; ++i)
         _pathPoints[i] = G3D::Vector3(pathPoints[i * VERTEX_SIZE + 2], pathPoints[i * VERTEX_SIZE], pathPoints[i * VERTEX_SIZE + 1]);
 
+    // the remaining steps depend on map heights
+    if (_asyncSolve)
+    {
+        _pointPathPending = true;
+        return;
+    }
+
+    FinishPointPath();
+}
+
+void PathGenerator::FinishPointPath()
+{
     NormalizePath();
 
     // first point is always our current location - we need the next one
-    SetActualEndPosition(_pathPoints[pointCount - 1]);
+    SetActualEndPosition(_pathPoints[_pathPoints.size() - 1]);
 
     // force the given destination, if needed
     if (_forceDestination &&
@@ -609,10 +725,13 @@ void PathGenerator::BuildPointPath(const float* startPoint, const float* endPoin
 
 void PathGenerator::NormalizePath()
 {
-    for (uint32 i = 0; i < _pathPoints.size(); ++i)
+    if (_asyncSolve)
     {
-        _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
+        _normalizePending = true;
+        return;
     }
+
+    _source->UpdateAllowedPositionZ(_pathPoints);
 }
 
 void PathGenerator::BuildShortcut()
@@ -876,7 +995,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
 
         if (dtStatusFailed(_navMeshQuery->getPolyHeight(polys[0], result, &result[1])))
             LOG_DEBUG("maps", "PathGenerator::FindSmoothPath: Cannot find height at position X: {} Y: {} Z: {} for {}",
-                result[2], result[0], result[1], _source->GetGUID().ToString());
+                result[2], result[0], result[1], _sourceGuid.ToString());
         result[1] += 0.5f;
         dtVcopy(iterPos, result);
 
@@ -24,11 +24,14 @@
 #include "MMapMgr.h"
 #include "MapDefines.h"
 #include "MoveSplineInitArgs.h"
+#include "ObjectGuid.h"
 #include "SharedDefines.h"
 #include <G3D/Vector3.h>
+#include <memory>
 
 class Unit;
 class WorldObject;
+struct PathfindingRequest;
 
 // 74*4.0f=296y number_of_points*interval = max_path_len
 // this is way more than actual evade range
@@ -66,6 +69,14 @@ class PathGenerator
         // return: true if new path was calculated, false otherwise (no change needed)
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
         bool CalculatePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest);
+
+        // Same as CalculatePath, but leaves the Detour queries to the pathfinding service when it is enabled.
+        // The previous path stays available until UpdatePendingPath() returns true.
+        bool CalculatePathAsync(float destX, float destY, float destZ, bool forceDest = false);
+        [[nodiscard]] bool IsPathPending() const { return _pendingRequest != nullptr; }
+        // return: true if the path requested by CalculatePathAsync is available
+        bool UpdatePendingPath();
+
         [[nodiscard]] bool IsInvalidDestinationZ(Unit const* target) const;
         [[nodiscard]] bool IsWalkableClimb(float const* v1, float const* v2) const;
         [[nodiscard]] bool IsWalkableClimb(float x, float y, float z, float destX, float destY, float destZ) const;
@@ -129,6 +140,11 @@ class PathGenerator
         }
 
     private:
+        friend class PathfindingService;
+
+        // copies are only made for the pathfinding service
+        PathGenerator(PathGenerator const& other) = default;
+
         dtPolyRef _pathPolyRefs[MAX_PATH_LENGTH];   // array of detour polygon references
         uint32 _polyLength;                         // number of polygons in the path
 
@@ -146,15 +162,25 @@ class PathGenerator
         G3D::Vector3 _actualEndPosition;    // {x, y, z} of the closest possible point to given destination
 
         WorldObject const* const _source;       // the object that is moving
+        ObjectGuid _sourceGuid;                 // guid of the object that is moving, for logs outside of the map thread
         dtNavMesh const* _navMesh;              // the nav mesh
         dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        MMAP::PathCache* _pathCache;            // corridors already found on this map, can be nullptr
 
         dtQueryFilterExt _filter;  // use single filter for all movements, update it when needed
 
+        bool _asyncSolve;           // solved by a pathfinding worker, steps needing map data are left to the map thread
+        bool _asyncFallback;        // the worker hit a case that needs map data, solve it again on the map thread
+        bool _normalizePending;     // NormalizePath() was skipped by the worker
+        bool _pointPathPending;     // FinishPointPath() was skipped by the worker
+        std::shared_ptr<PathfindingRequest> _pendingRequest;
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
         void NormalizePath();
+        bool InitializePath(float x, float y, float z, float destX, float destY, float destZ, bool forceDest);
+        void SolveAsync(dtNavMeshQuery const* query);
 
         [[nodiscard]] bool InRange(G3D::Vector3 const& p1, G3D::Vector3 const& p2, float r, float h) const;
         [[nodiscard]] float Dist3DSqr(G3D::Vector3 const& p1, G3D::Vector3 const& p2) const;
@@ -166,6 +192,7 @@ class PathGenerator
 
         void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
         void BuildPointPath(float const* startPoint, float const* endPoint);
+        void FinishPointPath();
         void BuildShortcut();
 
         [[nodiscard]] NavTerrain GetNavTerrain(float x, float y, float z) const;
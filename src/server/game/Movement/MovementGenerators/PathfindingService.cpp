@@ -0,0 +1,136 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathfindingService.h"
+#include "Log.h"
+#include "MMapFactory.h"
+#include "PathGenerator.h"
+#include "ProcessPriority.h"
+#include <chrono>
+#include <shared_mutex>
+#include <unordered_map>
+
+PathfindingRequest::PathfindingRequest(std::unique_ptr<PathGenerator> path, uint32 mapId, dtNavMesh const* navMesh) :
+    Path(std::move(path)), MapId(mapId), NavMesh(navMesh), Done(false), Abandoned(false)
+{
+}
+
+PathfindingRequest::~PathfindingRequest() = default;
+
+PathfindingService* PathfindingService::instance()
+{
+    static PathfindingService instance;
+    return &instance;
+}
+
+void PathfindingService::Initialize(uint32 numThreads)
+{
+    _workerThreads.reserve(numThreads);
+    for (uint32 i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&PathfindingService::WorkerThread, this, i));
+
+    if (numThreads)
+        LOG_INFO("server.loading", ">> Started {} pathfinding threads", numThreads);
+}
+
+void PathfindingService::Shutdown()
+{
+    _queue.Cancel();
+
+    for (auto& thread : _workerThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _workerThreads.clear();
+}
+
+std::shared_ptr<PathfindingRequest> PathfindingService::Submit(std::unique_ptr<PathGenerator> path, uint32 mapId, dtNavMesh const* navMesh)
+{
+    std::shared_ptr<PathfindingRequest> request = std::make_shared<PathfindingRequest>(std::move(path), mapId, navMesh);
+
+    ++_queueSize;
+    _queue.Push(request);
+    return request;
+}
+
+PathfindingSolveStats PathfindingService::TakeSolveStats()
+{
+    PathfindingSolveStats stats;
+    stats.Solved = _solvedCount.exchange(0);
+    uint64 micros = _solveMicros.exchange(0);
+    stats.AvgMicros = stats.Solved ? uint32(micros / stats.Solved) : 0;
+    stats.MaxMicros = _maxSolveMicros.exchange(0);
+    return stats;
+}
+
+void PathfindingService::WorkerThread(size_t workerIndex)
+{
+    SetupCurrentThread("Pathfinding", uint32(workerIndex));
+
+    MMAP::MMapMgr* mmap = MMAP::MMapFactory::createOrGetMMapMgr();
+
+    // dtNavMeshQuery is not thread safe, each worker needs its own per map
+    std::unordered_map<uint32, dtNavMeshQuery*> queries;
+
+    while (true)
+    {
+        std::shared_ptr<PathfindingRequest> request;
+
+        _queue.WaitAndPop(request);
+        if (!request)
+            break;
+
+        --_queueSize;
+
+        if (request->Abandoned)
+            continue;
+
+        auto start = std::chrono::steady_clock::now();
+
+        {
+            std::shared_lock<std::shared_mutex> lock(mmap->GetNavMeshLock());
+
+            dtNavMeshQuery* query = nullptr;
+            if (mmap->GetNavMesh(request->MapId) == request->NavMesh)
+            {
+                dtNavMeshQuery*& mapQuery = queries[request->MapId];
+                if (!mapQuery)
+                    mapQuery = dtAllocNavMeshQuery();
+
+                if (mapQuery->getAttachedNavMesh() == request->NavMesh || dtStatusSucceed(mapQuery->init(request->NavMesh, 1024)))
+                    query = mapQuery;
+            }
+
+            if (query)
+                request->Path->SolveAsync(query);
+            else
+                request->Path.reset();
+        }
+
+        uint32 micros = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        ++_solvedCount;
+        _solveMicros += micros;
+
+        uint32 maxMicros = _maxSolveMicros;
+        while (micros > maxMicros && !_maxSolveMicros.compare_exchange_weak(maxMicros, micros));
+
+        request->Done = true;
+    }
+
+    for (auto& query : queries)
+        dtFreeNavMeshQuery(query.second);
+}
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PATHFINDING_SERVICE_H
+#define _PATHFINDING_SERVICE_H
+
+#include "Define.h"
+#include "PCQueue.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+class PathGenerator;
+class dtNavMesh;
+
+struct PathfindingRequest
+{
+    PathfindingRequest(std::unique_ptr<PathGenerator> path, uint32 mapId, dtNavMesh const* navMesh);
+    ~PathfindingRequest();
+
+    std::unique_ptr<PathGenerator> Path;    // private copy solved by the worker, reset if the nav mesh went away
+    uint32 MapId;
+    dtNavMesh const* NavMesh;               // mesh the request was prepared against
+    std::atomic<bool> Done;
+    std::atomic<bool> Abandoned;            // the owner no longer waits for the result
+};
+
+struct PathfindingSolveStats
+{
+    uint32 Solved = 0;
+    uint32 AvgMicros = 0;
+    uint32 MaxMicros = 0;
+};
+
+/*
+ * Worker threads running the Detour part of PathGenerator::CalculatePathAsync.
+ * Every worker keeps its own dtNavMeshQuery per map, the map thread picks the
+ * result up on one of its next updates.
+ */
+class PathfindingService
+{
+public:
+    static PathfindingService* instance();
+
+    void Initialize(uint32 numThreads);
+    void Shutdown();
+    [[nodiscard]] bool IsEnabled() const { return !_workerThreads.empty(); }
+
+    std::shared_ptr<PathfindingRequest> Submit(std::unique_ptr<PathGenerator> path, uint32 mapId, dtNavMesh const* navMesh);
+
+    [[nodiscard]] uint32 GetQueueSize() const { return _queueSize; }
+    // requests solved since the previous call
+    PathfindingSolveStats TakeSolveStats();
+
+private:
+    PathfindingService() = default;
+    ~PathfindingService() = default;
+
+    void WorkerThread(size_t workerIndex);
+
+    ProducerConsumerQueue<std::shared_ptr<PathfindingRequest>> _queue;
+    std::vector<std::thread> _workerThreads;
+    std::atomic<uint32> _queueSize{0};
+    std::atomic<uint32> _solvedCount{0};
+    std::atomic<uint64> _solveMicros{0};
+    std::atomic<uint32> _maxSolveMicros{0};
+};
+
+#define sPathfindingService PathfindingService::instance()
+
+#endif
@@ -18,6 +18,7 @@
 #include "RandomMovementGenerator.h"
 #include "Creature.h"
 #include "CreatureGroups.h"
+#include "IVMapMgr.h"
 #include "Map.h"
 #include "MapMgr.h"
 #include "MoveSpline.h"
@@ -35,6 +36,40 @@ RandomMovementGenerator<Creature>::~RandomMovementGenerator()
     delete _pathGenerator;
 }
 
+template<>
+void RandomMovementGenerator<Creature>::_updateDestinationLevels(Creature* creature)
+{
+    Map* map = creature->GetMap();
+    _destinationLevels.assign(_destinationPoints.size(), VMAP_INVALID_HEIGHT_VALUE);
+    _destinationGrounds.assign(_destinationPoints.size(), INVALID_HEIGHT);
+
+    // same lookups as GetMapWaterOrGroundLevel, but the floor of all points is traced at once
+    std::vector<VMAP::HeightQuery> queries;
+    std::vector<uint8> indices;
+    for (uint8 i = 0; i < _destinationPoints.size(); ++i)
+    {
+        G3D::Vector3 const& point = _destinationPoints[i];
+        if (Acore::IsValidMapCoord(point.x, point.y) && map->GetGrid(point.x, point.y))
+        {
+            queries.push_back({ point.x, point.y, point.z + Z_OFFSET_FIND_HEIGHT });
+            indices.push_back(i);
+        }
+    }
+
+    if (queries.empty())
+        return;
+
+    map->GetHeight(creature->GetPhaseMask(), queries, true, DEFAULT_HEIGHT_SEARCH);
+
+    float collisionHeight = std::max(creature->GetCollisionHeight(), Z_OFFSET_FIND_HEIGHT);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        VMAP::HeightQuery const& query = queries[i];
+        _destinationGrounds[indices[i]] = query.Height;
+        _destinationLevels[indices[i]] = map->GetWaterOrGroundLevelAboveFloor(creature->GetPhaseMask(), query.X, query.Y, query.Height, collisionHeight);
+    }
+}
+
 template<>
 void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
 {
@@ -83,8 +118,11 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
             return;
         }
 
-        float ground = INVALID_HEIGHT;
-        float levelZ = creature->GetMapWaterOrGroundLevel(x, y, z, &ground);
+        if (_destinationLevels.size() != _destinationPoints.size())
+            _updateDestinationLevels(creature);
+
+        float ground = _destinationGrounds[newPoint];
+        float levelZ = _destinationLevels[newPoint];
         float newZ = INVALID_HEIGHT;
 
         // flying creature
@@ -219,6 +257,10 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
     init.SetWalk(walk);
     init.Launch();
 
+    //Call for creature group update, before the path may be dropped from the cache below
+    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
+        creature->GetFormation()->LeaderMoveTo(finalPoint.x, finalPoint.y, finalPoint.z, 0, &finalPath);
+
     ++_moveCount;
     if (roll_chance_i((int32) _moveCount * 25 + 10))
     {
@@ -227,10 +269,6 @@ void RandomMovementGenerator<Creature>::_setRandomLocation(Creature* creature)
     }
     if (sWorld->getBoolConfig(CONFIG_DONT_CACHE_RANDOM_MOVEMENT_PATHS))
         _preComputedPaths.erase(pathIdx);
-
-    //Call for creature group update
-    if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
-        creature->GetFormation()->LeaderMoveTo(finalPoint.x, finalPoint.y, finalPoint.z, 0);
 }
 
 template<>
@@ -255,6 +293,8 @@ void RandomMovementGenerator<Creature>::DoInitialize(Creature* creature)
             float factor = 0.5f + rand_norm() * 0.5f;
             _destinationPoints.push_back(G3D::Vector3(_initialPosition.GetPositionX() + _wanderDistance * cos(angle)*factor, _initialPosition.GetPositionY() + _wanderDistance * std::sin(angle)*factor, _initialPosition.GetPositionZ()));
         }
+
+        _updateDestinationLevels(creature);
     }
 
     creature->AddUnitState(UNIT_STATE_ROAMING | UNIT_STATE_ROAMING_MOVE);
@@ -50,6 +50,7 @@ public:
     ~RandomMovementGenerator();
 
     void _setRandomLocation(T*);
+    void _updateDestinationLevels(T*);
     void DoInitialize(T*);
     void DoFinalize(T*);
     void DoReset(T*);
@@ -63,6 +64,8 @@ private:
     float _wanderDistance;
     PathGenerator* _pathGenerator;
     std::vector<G3D::Vector3> _destinationPoints;
+    // water or ground level and floor height of every destination point, resolved in one batched height query
+    std::vector<float> _destinationLevels, _destinationGrounds;
     std::vector<uint8> _validPointsVector[RANDOM_POINTS_NUMBER + 1];
     uint8 _currentPoint;
     std::map<uint16, Movement::PointsArray> _preComputedPaths;
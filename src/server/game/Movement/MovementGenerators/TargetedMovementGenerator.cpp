@@ -138,6 +138,15 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
         }
     }
 
+    // keep following the current spline until the new path is solved
+    if (i_path && i_path->IsPathPending())
+    {
+        if (i_path->UpdatePendingPath())
+            LaunchPath(owner, target, _pendingDestination, _pendingShortenPath, maxTarget);
+
+        return true;
+    }
+
     // if we're done moving, we want to clean up
     if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && owner->movespline->Finalized())
     {
@@ -216,8 +225,7 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
             if (owner->IsHovering())
                 owner->UpdateAllowedPositionZ(x, y, z);
 
-            bool success = i_path->CalculatePath(x, y, z, forceDest);
-            if (!success || i_path->GetPathType() & PATHFIND_NOPATH)
+            if (!i_path->CalculatePathAsync(x, y, z, forceDest))
             {
                 if (cOwner)
                 {
@@ -228,42 +236,68 @@ bool ChaseMovementGenerator<T>::DoUpdate(T* owner, uint32 time_diff)
                 return true;
             }
 
-            if (shortenPath)
-                i_path->ShortenPathUntilDist(G3D::Vector3(x, y, z), maxTarget);
-
-            if (cOwner)
+            if (i_path->IsPathPending())
             {
-                cOwner->SetCannotReachTarget();
+                _pendingDestination = G3D::Vector3(x, y, z);
+                _pendingShortenPath = shortenPath;
+                return true;
             }
 
-            bool walk = false;
-            if (cOwner && !cOwner->IsPet())
-            {
-                switch (cOwner->GetMovementTemplate().GetChase())
-                {
-                case CreatureChaseMovementType::CanWalk:
-                    walk = owner->IsWalking();
-                    break;
-                case CreatureChaseMovementType::AlwaysWalk:
-                    walk = true;
-                    break;
-                default:
-                    break;
-                }
-            }
+            LaunchPath(owner, target, G3D::Vector3(x, y, z), shortenPath, maxTarget);
+        }
+    }
 
-            owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
-            i_recalculateTravel = true;
+    return true;
+}
 
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(i_path->GetPath());
-            init.SetFacing(target);
-            init.SetWalk(walk);
-            init.Launch();
+template<class T>
+void ChaseMovementGenerator<T>::LaunchPath(T* owner, Unit* target, G3D::Vector3 const& dest, bool shortenPath, float maxTarget)
+{
+    Creature* cOwner = owner->ToCreature();
+
+    if (i_path->GetPathType() & PATHFIND_NOPATH)
+    {
+        if (cOwner)
+        {
+            cOwner->SetCannotReachTarget(target->GetGUID());
         }
+
+        owner->StopMoving();
+        return;
     }
 
-    return true;
+    if (shortenPath)
+        i_path->ShortenPathUntilDist(dest, maxTarget);
+
+    if (cOwner)
+    {
+        cOwner->SetCannotReachTarget();
+    }
+
+    bool walk = false;
+    if (cOwner && !cOwner->IsPet())
+    {
+        switch (cOwner->GetMovementTemplate().GetChase())
+        {
+        case CreatureChaseMovementType::CanWalk:
+            walk = owner->IsWalking();
+            break;
+        case CreatureChaseMovementType::AlwaysWalk:
+            walk = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
+    i_recalculateTravel = true;
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(i_path->GetPath());
+    init.SetFacing(target);
+    init.SetWalk(walk);
+    init.Launch();
 }
 
 //-----------------------------------------------//
@@ -302,6 +336,21 @@ void ChaseMovementGenerator<T>::DoReset(T* owner)
     DoInitialize(owner);
 }
 
+template<class T>
+void ChaseMovementGenerator<T>::Retarget(Unit* target, Optional<ChaseRange> range, Optional<ChaseAngle> angle)
+{
+    i_target.link(target, this);
+    i_path = nullptr;
+    i_recheckDistance.Reset(0);
+    i_recalculateTravel = true;
+    _pendingShortenPath = false;
+    _lastTargetPosition.reset();
+    _range = range;
+    _angle = angle;
+    _movingTowards = true;
+    _mutualChase = true;
+}
+
 template<class T>
 void ChaseMovementGenerator<T>::MovementInform(T* owner)
 {
@@ -566,6 +615,8 @@ template void ChaseMovementGenerator<Player>::DoFinalize(Player*);
 template void ChaseMovementGenerator<Creature>::DoFinalize(Creature*);
 template void ChaseMovementGenerator<Player>::DoReset(Player*);
 template void ChaseMovementGenerator<Creature>::DoReset(Creature*);
+template void ChaseMovementGenerator<Player>::Retarget(Unit*, Optional<ChaseRange>, Optional<ChaseAngle>);
+template void ChaseMovementGenerator<Creature>::Retarget(Unit*, Optional<ChaseRange>, Optional<ChaseAngle>);
 template bool ChaseMovementGenerator<Player>::DoUpdate(Player*, uint32);
 template bool ChaseMovementGenerator<Creature>::DoUpdate(Creature*, uint32);
 template void ChaseMovementGenerator<Unit>::MovementInform(Unit*);
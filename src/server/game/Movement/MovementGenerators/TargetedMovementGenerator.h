@@ -54,18 +54,26 @@ public:
 
     void unitSpeedChanged() { _lastTargetPosition.reset(); }
     Unit* GetTarget() const { return i_target.getTarget(); }
+    // turns the finalized generator into a fresh one chasing the given target, see MotionMaster::MoveChase
+    void Retarget(Unit* target, Optional<ChaseRange> range, Optional<ChaseAngle> angle);
 
     bool EnableWalking() const { return false; }
     bool HasLostTarget(Unit* unit) const { return unit->GetVictim() != this->GetTarget(); }
 
 private:
+    void LaunchPath(T* owner, Unit* target, G3D::Vector3 const& dest, bool shortenPath, float maxTarget);
+
     std::unique_ptr<PathGenerator> i_path;
     TimeTrackerSmall i_recheckDistance;
     bool i_recalculateTravel;
 
+    // destination of a path still being solved by the pathfinding service
+    G3D::Vector3 _pendingDestination;
+    bool _pendingShortenPath = false;
+
     Optional<Position> _lastTargetPosition;
-    Optional<ChaseRange> const _range;
-    Optional<ChaseAngle> const _angle;
+    Optional<ChaseRange> _range;
+    Optional<ChaseAngle> _angle;
     bool _movingTowards = true;
     bool _mutualChase = true;
 };
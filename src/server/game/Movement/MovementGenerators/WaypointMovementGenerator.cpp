@@ -28,6 +28,10 @@
 #include "Spell.h"
 #include "Transport.h"
 #include "World.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 void WaypointMovementGenerator<Creature>::LoadPath(Creature* creature)
 {
@@ -75,22 +79,22 @@ void WaypointMovementGenerator<Creature>::OnArrived(Creature* creature)
     creature->ClearUnitState(UNIT_STATE_ROAMING_MOVE);
     m_isArrivalDone = true;
 
-    if (i_path->at(i_currentNode)->event_id && urand(0, 99) < i_path->at(i_currentNode)->event_chance)
+    if (i_path->at(i_currentNode).event_id && urand(0, 99) < i_path->at(i_currentNode).event_chance)
     {
         LOG_DEBUG("maps.script", "Creature movement start script {} at point {} for {}.",
-            i_path->at(i_currentNode)->event_id, i_currentNode, creature->GetGUID().ToString());
+            i_path->at(i_currentNode).event_id, i_currentNode, creature->GetGUID().ToString());
         creature->ClearUnitState(UNIT_STATE_ROAMING_MOVE);
-        creature->GetMap()->ScriptsStart(sWaypointScripts, i_path->at(i_currentNode)->event_id, creature, nullptr);
+        creature->GetMap()->ScriptsStart(sWaypointScripts, i_path->at(i_currentNode).event_id, creature, nullptr);
     }
 
     // Inform script
     MovementInform(creature);
     creature->UpdateWaypointID(i_currentNode);
 
-    if (i_path->at(i_currentNode)->delay)
+    if (i_path->at(i_currentNode).delay)
     {
         creature->ClearUnitState(UNIT_STATE_ROAMING_MOVE);
-        Stop(i_path->at(i_currentNode)->delay);
+        Stop(i_path->at(i_currentNode).delay);
     }
 }
 
@@ -113,9 +117,9 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
         // Xinef: not true... update this at every waypoint!
         //if ((i_currentNode == i_path->size() - 1) && !repeating) // If that's our last waypoint
         {
-            float x = i_path->at(i_currentNode)->x;
-            float y = i_path->at(i_currentNode)->y;
-            float z = i_path->at(i_currentNode)->z;
+            float x = i_path->at(i_currentNode).x;
+            float y = i_path->at(i_currentNode).y;
+            float z = i_path->at(i_currentNode).z;
             float o = creature->GetOrientation();
 
             if (!transportPath)
@@ -152,7 +156,7 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
         return true;
     }
 
-    WaypointData const* node = i_path->at(i_currentNode);
+    WaypointData const* node = &i_path->at(i_currentNode);
 
     m_isArrivalDone = false;
 
@@ -171,9 +175,24 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
 
     float z = node->z;
     creature->UpdateAllowedPositionZ(node->x, node->y, z);
+
+    // the path is kept to lay out the formation members along it
+    Movement::PointsArray path;
+    if (!transportPath)
+    {
+        PathGenerator generator(creature);
+        if (generator.CalculatePath(node->x, node->y, z, true) && !(generator.GetPathType() & PATHFIND_NOPATH))
+            path = generator.GetPath();
+    }
+
     //! Do not use formationDest here, MoveTo requires transport offsets due to DisableTransportPathTransformations() call
     //! but formationDest contains global coordinates
-    init.MoveTo(node->x, node->y, z, true, true);
+    if (transportPath)
+        init.MoveTo(node->x, node->y, z, true, true);
+    else if (path.empty())
+        init.MoveTo(node->x, node->y, z);
+    else
+        init.MovebyPath(path);
 
     if (node->orientation.has_value() && node->delay > 0)
         init.SetFacing(*node->orientation);
@@ -200,7 +219,7 @@ bool WaypointMovementGenerator<Creature>::StartMove(Creature* creature)
 
     //Call for creature group update
     if (creature->GetFormation() && creature->GetFormation()->GetLeader() == creature)
-        creature->GetFormation()->LeaderMoveTo(formationDest.x, formationDest.y, formationDest.z, node->move_type);
+        creature->GetFormation()->LeaderMoveTo(formationDest.x, formationDest.y, formationDest.z, node->move_type, path.empty() ? nullptr : &path);
 
     return true;
 }
@@ -238,7 +257,7 @@ bool WaypointMovementGenerator<Creature>::DoUpdate(Creature* creature, uint32 di
             bool finished = creature->movespline->Finalized();
             // xinef: code to detect pre-empetively if we should start movement to next waypoint
             // xinef: do not start pre-empetive movement if current node has delay or we are ending waypoint movement
-            //if (!finished && !i_path->at(i_currentNode)->delay && ((i_currentNode != i_path->size() - 1) || repeating))
+            //if (!finished && !i_path->at(i_currentNode).delay && ((i_currentNode != i_path->size() - 1) || repeating))
             //    finished = (creature->movespline->_Spline().length(creature->movespline->_currentSplineIdx() + 1) - creature->movespline->timePassed()) < 200;
 
             if (finished)
@@ -306,47 +325,106 @@ bool IsNodeIncludedInShortenedPath(TaxiPathNodeEntry const* p1, TaxiPathNodeEntr
     return p1->mapid != p2->mapid || std::pow(p1->x - p2->x, 2) + std::pow(p1->y - p2->y, 2) > SKIP_SPLINE_POINT_DISTANCE_SQ;
 }
 
-void FlightPathMovementGenerator::LoadPath(Player* player)
+namespace
 {
-    _pointsForPathSwitch.clear();
-    std::deque<uint32> const& taxi = player->m_taxi.GetPath();
-    float discount = player->GetReputationPriceDiscount(player->m_taxi.GetFlightMasterFactionTemplate());
-    for (uint32 src = 0, dst = 1; dst < taxi.size(); src = dst++)
+    /// Shortened node list and undiscounted hop prices of one taxi route, shared by all players flying it
+    struct TaxiRoute
     {
-        uint32 path, cost;
-        sObjectMgr->GetTaxiPath(taxi[src], taxi[dst], path, cost);
-        if (path > sTaxiPathNodesByPath.size())
+        struct PathSwitch
         {
-            return;
-        }
+            uint32 PathIndex;
+            uint32 Cost;
+        };
 
-        TaxiPathNodeList const& nodes = sTaxiPathNodesByPath[path];
-        if (!nodes.empty())
+        TaxiPathNodeList Nodes;
+        std::vector<PathSwitch> PathSwitches;
+        bool Complete = true;
+    };
+
+    // routes come from the client hop by hop, cap the memo so odd combinations cannot grow it forever
+    constexpr std::size_t TAXI_ROUTE_CACHE_LIMIT = 4096;
+
+    std::map<std::vector<uint32>, std::shared_ptr<TaxiRoute const>> TaxiRouteCache;
+    std::shared_mutex TaxiRouteCacheLock;
+
+    std::shared_ptr<TaxiRoute const> BuildTaxiRoute(std::vector<uint32> const& taxi)
+    {
+        std::shared_ptr<TaxiRoute> route = std::make_shared<TaxiRoute>();
+        TaxiPathNodeList& path = route->Nodes;
+        for (uint32 src = 0, dst = 1; dst < taxi.size(); src = dst++)
         {
-            TaxiPathNodeEntry const* start = nodes[0];
-            TaxiPathNodeEntry const* end = nodes[nodes.size() - 1];
-            bool passedPreviousSegmentProximityCheck = false;
-            for (uint32 i = 0; i < nodes.size(); ++i)
+            uint32 pathId, cost;
+            sObjectMgr->GetTaxiPath(taxi[src], taxi[dst], pathId, cost);
+            if (pathId >= sTaxiPathNodesByPath.size())
             {
-                if (passedPreviousSegmentProximityCheck || !src || i_path.empty() || IsNodeIncludedInShortenedPath(i_path[i_path.size() - 1], nodes[i]))
+                route->Complete = false;
+                break;
+            }
+
+            TaxiPathNodeList const& nodes = sTaxiPathNodesByPath[pathId];
+            if (!nodes.empty())
+            {
+                TaxiPathNodeEntry const* start = nodes[0];
+                TaxiPathNodeEntry const* end = nodes[nodes.size() - 1];
+                bool passedPreviousSegmentProximityCheck = false;
+                for (uint32 i = 0; i < nodes.size(); ++i)
                 {
-                    if ((!src || (IsNodeIncludedInShortenedPath(start, nodes[i]) && i >= 2)) &&
-                        (dst == taxi.size() - 1 || (IsNodeIncludedInShortenedPath(end, nodes[i]) && i < nodes.size() - 1)))
+                    if (passedPreviousSegmentProximityCheck || !src || path.empty() || IsNodeIncludedInShortenedPath(path[path.size() - 1], nodes[i]))
                     {
-                        passedPreviousSegmentProximityCheck = true;
-                        i_path.push_back(nodes[i]);
+                        if ((!src || (IsNodeIncludedInShortenedPath(start, nodes[i]) && i >= 2)) &&
+                            (dst == taxi.size() - 1 || (IsNodeIncludedInShortenedPath(end, nodes[i]) && i < nodes.size() - 1)))
+                        {
+                            passedPreviousSegmentProximityCheck = true;
+                            path.push_back(nodes[i]);
+                        }
+                    }
+                    else
+                    {
+                        path.pop_back();
+                        --route->PathSwitches.back().PathIndex;
                     }
-                }
-                else
-                {
-                    i_path.pop_back();
-                    --_pointsForPathSwitch.back().PathIndex;
                 }
             }
+
+            route->PathSwitches.push_back({ uint32(path.size() - 1), cost });
+        }
+
+        return route;
+    }
+
+    std::shared_ptr<TaxiRoute const> GetTaxiRoute(std::deque<uint32> const& taxiPath)
+    {
+        std::vector<uint32> taxi(taxiPath.begin(), taxiPath.end());
+
+        {
+            std::shared_lock<std::shared_mutex> lock(TaxiRouteCacheLock);
+            auto itr = TaxiRouteCache.find(taxi);
+            if (itr != TaxiRouteCache.end())
+                return itr->second;
         }
 
-        _pointsForPathSwitch.push_back({ uint32(i_path.size() - 1), int32(ceil(cost * discount)) });
+        std::shared_ptr<TaxiRoute const> route = BuildTaxiRoute(taxi);
+
+        std::unique_lock<std::shared_mutex> lock(TaxiRouteCacheLock);
+        if (TaxiRouteCache.size() < TAXI_ROUTE_CACHE_LIMIT)
+            TaxiRouteCache.emplace(std::move(taxi), route);
+
+        return route;
     }
+}
+
+void FlightPathMovementGenerator::LoadPath(Player* player)
+{
+    _pointsForPathSwitch.clear();
+    std::shared_ptr<TaxiRoute const> route = GetTaxiRoute(player->m_taxi.GetPath());
+    float discount = player->GetReputationPriceDiscount(player->m_taxi.GetFlightMasterFactionTemplate());
+
+    i_path.insert(i_path.end(), route->Nodes.begin(), route->Nodes.end());
+    for (TaxiRoute::PathSwitch const& pathSwitch : route->PathSwitches)
+        _pointsForPathSwitch.push_back({ pathSwitch.PathIndex, int32(ceil(pathSwitch.Cost * discount)) });
+
+    if (!route->Complete)
+        return;
 
     // TODO: fixes crash, but can be handled in a better way once we will know how to reproduce it.
     if (GetCurrentNode() >= i_path.size())
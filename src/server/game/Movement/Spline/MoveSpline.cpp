@@ -166,6 +166,7 @@ namespace Movement
         time_passed = 0;
         vertical_acceleration = 0.f;
         effect_start_time = 0;
+        createPathData.clear();
 
         // Check if its a stop spline
         if (args.flags.done)
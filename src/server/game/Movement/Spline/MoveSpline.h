@@ -20,6 +20,7 @@
 
 #include "MoveSplineInitArgs.h"
 #include "Spline.h"
+#include <vector>
 
 namespace Movement
 {
@@ -68,6 +69,9 @@ namespace Movement
         int32           point_Idx;
         int32           point_Idx_offset;
 
+        // path part of the create block, serialized for the first viewer and copied for the others until the next Initialize
+        mutable std::vector<uint8> createPathData;
+
         void init_spline(const MoveSplineInitArgs& args);
 
     protected:
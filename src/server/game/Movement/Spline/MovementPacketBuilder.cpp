@@ -189,14 +189,22 @@ namespace Movement
             data << move_spline.vertical_acceleration;      // added in 3.1
             data << move_spline.effect_start_time;          // added in 3.1
 
-            uint32 nodes = move_spline.getPath().size();
-            data << nodes;
-            if (nodes)
+            // create blocks are built on the map thread, so the cache needs no lock
+            if (move_spline.createPathData.empty())
             {
-                data.append<Vector3>(&move_spline.getPath()[0], nodes);
+                uint32 nodes = move_spline.getPath().size();
+                ByteBuffer path(4 + nodes * sizeof(Vector3) + 1 + sizeof(Vector3));
+                path << nodes;
+                if (nodes)
+                {
+                    path.append<Vector3>(&move_spline.getPath()[0], nodes);
+                }
+                path << uint8(move_spline.spline.mode());   // added in 3.1
+                path << (move_spline.isCyclic() ? Vector3::zero() : move_spline.FinalDestination());
+                move_spline.createPathData.assign(path.contents(), path.contents() + path.size());
             }
-            data << uint8(move_spline.spline.mode());       // added in 3.1
-            data << (move_spline.isCyclic() ? Vector3::zero() : move_spline.FinalDestination());
+
+            data.append(move_spline.createPathData.data(), move_spline.createPathData.size());
         }
     }
 }
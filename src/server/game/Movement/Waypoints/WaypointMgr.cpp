@@ -26,15 +26,6 @@ WaypointMgr::WaypointMgr()
 
 WaypointMgr::~WaypointMgr()
 {
-    for (WaypointPathContainer::iterator itr = _waypointStore.begin(); itr != _waypointStore.end(); ++itr)
-    {
-        for (WaypointPath::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            delete *it;
-
-        itr->second.clear();
-    }
-
-    _waypointStore.clear();
 }
 
 WaypointMgr* WaypointMgr::instance()
@@ -62,7 +53,7 @@ void WaypointMgr::Load()
     do
     {
         Field* fields = result->Fetch();
-        WaypointData* wp = new WaypointData();
+        WaypointData wp;
 
         uint32 pathId = fields[0].Get<uint32>();
         WaypointPath& path = _waypointStore[pathId];
@@ -77,42 +68,38 @@ void WaypointMgr::Load()
         Acore::NormalizeMapCoord(x);
         Acore::NormalizeMapCoord(y);
 
-        wp->id = fields[1].Get<uint32>();
-        wp->x = x;
-        wp->y = y;
-        wp->z = z;
-        wp->orientation = o;
-        wp->move_type = fields[6].Get<uint32>();
+        wp.id = fields[1].Get<uint32>();
+        wp.x = x;
+        wp.y = y;
+        wp.z = z;
+        wp.orientation = o;
+        wp.move_type = fields[6].Get<uint32>();
 
-        if (wp->move_type >= WAYPOINT_MOVE_TYPE_MAX)
+        if (wp.move_type >= WAYPOINT_MOVE_TYPE_MAX)
         {
-            //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp->id);
-            delete wp;
+            //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp.id);
             continue;
         }
 
-        wp->delay = fields[7].Get<uint32>();
-        wp->event_id = fields[8].Get<uint32>();
-        wp->event_chance = fields[9].Get<int16>();
+        wp.delay = fields[7].Get<uint32>();
+        wp.event_id = fields[8].Get<uint32>();
+        wp.event_chance = fields[9].Get<int16>();
 
         path.push_back(wp);
         ++count;
     } while (result->NextRow());
 
+    // Paths are immutable from here on, drop the growth slack of every node vector
+    for (auto& [pathId, path] : _waypointStore)
+        path.shrink_to_fit();
+
     LOG_INFO("server.loading", ">> Loaded {} waypoints in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
 
 void WaypointMgr::ReloadPath(uint32 id)
 {
-    WaypointPathContainer::iterator itr = _waypointStore.find(id);
-    if (itr != _waypointStore.end())
-    {
-        for (WaypointPath::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it)
-            delete *it;
-
-        _waypointStore.erase(itr);
-    }
+    _waypointStore.erase(id);
 
     WorldDatabasePreparedStatement* stmt = WorldDatabase.GetPreparedStatement(WORLD_SEL_WAYPOINT_DATA_BY_ID);
 
@@ -128,7 +115,7 @@ void WaypointMgr::ReloadPath(uint32 id)
     do
     {
         Field* fields = result->Fetch();
-        WaypointData* wp = new WaypointData();
+        WaypointData wp;
 
         float x = fields[1].Get<float>();
         float y = fields[2].Get<float>();
@@ -140,24 +127,25 @@ void WaypointMgr::ReloadPath(uint32 id)
         Acore::NormalizeMapCoord(x);
         Acore::NormalizeMapCoord(y);
 
-        wp->id = fields[0].Get<uint32>();
-        wp->x = x;
-        wp->y = y;
-        wp->z = z;
-        wp->orientation = o;
-        wp->move_type = fields[5].Get<uint32>();
+        wp.id = fields[0].Get<uint32>();
+        wp.x = x;
+        wp.y = y;
+        wp.z = z;
+        wp.orientation = o;
+        wp.move_type = fields[5].Get<uint32>();
 
-        if (wp->move_type >= WAYPOINT_MOVE_TYPE_MAX)
+        if (wp.move_type >= WAYPOINT_MOVE_TYPE_MAX)
         {
-            //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp->id);
-            delete wp;
+            //LOG_ERROR("sql.sql", "Waypoint {} in waypoint_data has invalid move_type, ignoring", wp.id);
             continue;
         }
 
-        wp->delay = fields[6].Get<uint32>();
-        wp->event_id = fields[7].Get<uint32>();
-        wp->event_chance = fields[8].Get<uint8>();
+        wp.delay = fields[6].Get<uint32>();
+        wp.event_id = fields[7].Get<uint32>();
+        wp.event_chance = fields[8].Get<uint8>();
 
         path.push_back(wp);
     } while (result->NextRow());
+
+    path.shrink_to_fit();
 }
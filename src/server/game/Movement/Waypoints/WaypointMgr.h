@@ -44,7 +44,8 @@ struct WaypointData
     uint8 event_chance;
 };
 
-typedef std::vector<WaypointData*> WaypointPath;
+// Nodes are stored by value so walking a path doesn't chase a pointer per node
+typedef std::vector<WaypointData> WaypointPath;
 typedef std::unordered_map<uint32, WaypointPath> WaypointPathContainer;
 
 class WaypointMgr
@@ -457,10 +457,21 @@ bool OPvPCapturePoint::Update(uint32 diff)
 void OutdoorPvP::SendUpdateWorldState(uint32 field, uint32 value)
 {
     if (_sendUpdate)
+        _pendingWorldStates.Set(field, value);
+}
+
+void OutdoorPvP::SendPendingWorldStates()
+{
+    if (_pendingWorldStates.IsEmpty())
+        return;
+
+    _pendingWorldStates.Flush([this](WorldPacket const* packet)
+    {
         for (auto const& _player : _players)
             for (auto itr : _player)
                 if (Player* const player = ObjectAccessor::FindPlayer(itr))
-                    player->SendUpdateWorldState(field, value);
+                    player->SendDirectMessage(packet);
+    });
 }
 
 void OPvPCapturePoint::SendUpdateWorldState(uint32 field, uint32 value)
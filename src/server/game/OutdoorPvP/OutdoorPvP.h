@@ -20,6 +20,7 @@
 
 #include "SharedDefines.h"
 #include "Util.h"
+#include "WorldStateBatch.h"
 #include "ZoneScript.h"
 #include <array>
 
@@ -219,8 +220,10 @@ public:
     void OnCreatureCreate(Creature* creature) override;
     void OnCreatureRemove(Creature* creature) override;
 
-    // send world state update to all players present
+    // send world state update to all players present, at the end of the tick
     void SendUpdateWorldState(uint32 field, uint32 value);
+    // called by OutdoorPvPMgr, sends the world states changed since the last call
+    void SendPendingWorldStates();
 
     // called by OutdoorPvPMgr, updates the objectives and if needed, sends new worldstateui information
     virtual bool Update(uint32 diff);
@@ -269,6 +272,7 @@ protected:
     std::array<PlayerSet, 2> _players;
     uint32 _typeId{};
     bool _sendUpdate{ true };
+    WorldStateBatch _pendingWorldStates;
     Map* _map{};
     std::unordered_map<ObjectGuid::LowType, GameObject*> _goScriptStore;
     std::unordered_map<ObjectGuid::LowType, Creature*> _creatureScriptStore;
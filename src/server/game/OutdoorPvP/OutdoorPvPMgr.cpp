@@ -168,6 +168,9 @@ void OutdoorPvPMgr::Update(uint32 diff)
 
         m_UpdateTimer = 0;
     }
+
+    for (auto const& itr : m_OutdoorPvPSet)
+        itr->SendPendingWorldStates();
 }
 
 bool OutdoorPvPMgr::HandleCustomSpell(Player* player, uint32 spellId, GameObject* go)
@@ -301,6 +301,9 @@ void PoolGroup<Pool>::RemoveOneRelation(uint32 child_pool_id)
     }
 }
 
+// Random picks tried before falling back to collecting all inactive entries of a pool
+static constexpr uint8 POOL_RANDOM_PICK_ATTEMPTS = 8;
+
 template <class T>
 void PoolGroup<T>::SpawnObject(ActivePoolData& spawns, uint32 limit, uint32 triggerFrom)
 {
@@ -338,6 +341,21 @@ void PoolGroup<T>::SpawnObject(ActivePoolData& spawns, uint32 limit, uint32 trig
             }
         }
 
+        // a single respawn in a large pool: draw random entries until an inactive one turns up instead of
+        // copying every inactive entry, gives the same uniform pick as long as most of the pool is inactive
+        if (!EqualChanced.empty() && rolledObjects.empty() && count == 1)
+        {
+            for (uint8 attempt = 0; attempt < POOL_RANDOM_PICK_ATTEMPTS; ++attempt)
+            {
+                PoolObject const& obj = EqualChanced[urand(0, EqualChanced.size() - 1)];
+                if (!spawns.IsActiveObject<T>(obj.guid))
+                {
+                    rolledObjects.push_back(obj);
+                    break;
+                }
+            }
+        }
+
         if (!EqualChanced.empty() && rolledObjects.empty())
         {
             std::copy_if(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(rolledObjects), [/*triggerFrom, */&spawns](PoolObject const& object)
@@ -40,7 +40,7 @@ class Pool                                                  // for Pool of Pool
 };
 
 typedef std::unordered_set<uint32> ActivePoolObjects;
-typedef std::map<uint32, uint32> ActivePoolPools;
+typedef std::unordered_map<uint32, uint32> ActivePoolPools;
 
 class ActivePoolData
 {
@@ -17,6 +17,7 @@
 
 #include "QuestDef.h"
 #include "Formulas.h"
+#include "ObjectMgr.h"
 #include "Opcodes.h"
 #include "Player.h"
 #include "World.h"
@@ -324,107 +325,134 @@ uint32 Quest::CalculateHonorGain(uint8 level) const
     return honor;
 }
 
-void Quest::InitializeQueryData()
+WorldPacket Quest::BuildQueryData(LocaleConstant locale) const
 {
-    queryData.Initialize(SMSG_QUEST_QUERY_RESPONSE, 1);
+    std::string questTitle           = GetTitle();
+    std::string questDetails         = GetDetails();
+    std::string questObjectives      = GetObjectives();
+    std::string questAreaDescription = GetAreaDescription();
+    std::string questCompletedText   = GetCompletedText();
 
-    queryData << uint32(GetQuestId());                    // quest id
-    queryData << uint32(GetQuestMethod());                // Accepted values: 0, 1 or 2. 0 == IsAutoComplete() (skip objectives/details)
-    queryData << uint32(GetQuestLevel());                 // may be -1, static data, in other cases must be used dynamic level: Player::GetQuestLevel (0 is not known, but assuming this is no longer valid for quest intended for client)
-    queryData << uint32(GetMinLevel());                   // min level
-    queryData << uint32(GetZoneOrSort());                 // zone or sort to display in quest log
+    std::string questObjectiveText[QUEST_OBJECTIVES_COUNT];
+    for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+        questObjectiveText[i] = ObjectiveText[i];
 
-    queryData << uint32(GetType());                       // quest type
-    queryData << uint32(GetSuggestedPlayers());           // suggested players count
+    if (QuestLocale const* localeData = sObjectMgr->GetQuestLocale(GetQuestId()))
+    {
+        ObjectMgr::GetLocaleString(localeData->Title, locale, questTitle);
+        ObjectMgr::GetLocaleString(localeData->Details, locale, questDetails);
+        ObjectMgr::GetLocaleString(localeData->Objectives, locale, questObjectives);
+        ObjectMgr::GetLocaleString(localeData->AreaDescription, locale, questAreaDescription);
+        ObjectMgr::GetLocaleString(localeData->CompletedText, locale, questCompletedText);
+
+        for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+            ObjectMgr::GetLocaleString(localeData->ObjectiveText[i], locale, questObjectiveText[i]);
+    }
 
-    queryData << uint32(GetRepObjectiveFaction());        // shown in quest log as part of quest objective
-    queryData << uint32(GetRepObjectiveValue());          // shown in quest log as part of quest objective
+    WorldPacket data(SMSG_QUEST_QUERY_RESPONSE, 100);       // guess size
 
-    queryData << uint32(GetRepObjectiveFaction2());       // shown in quest log as part of quest objective OPPOSITE faction
-    queryData << uint32(GetRepObjectiveValue2());         // shown in quest log as part of quest objective OPPOSITE faction
+    data << uint32(GetQuestId());                           // quest id
+    data << uint32(GetQuestMethod());                       // Accepted values: 0, 1 or 2. 0 == IsAutoComplete() (skip objectives/details)
+    data << uint32(GetQuestLevel());                        // may be -1, static data, in other cases must be used dynamic level: Player::GetQuestLevel (0 is not known, but assuming this is no longer valid for quest intended for client)
+    data << uint32(GetMinLevel());                          // min level
+    data << uint32(GetZoneOrSort());                        // zone or sort to display in quest log
 
-    queryData << uint32(GetNextQuestInChain());           // client will request this quest from NPC, if not 0
-    queryData << uint32(GetXPId());                       // used for calculating rewarded experience
+    data << uint32(GetType());                              // quest type
+    data << uint32(GetSuggestedPlayers());                  // suggested players count
 
-    if (HasFlag(QUEST_FLAGS_HIDDEN_REWARDS))
-        queryData << uint32(0);                           // Hide money rewarded
-    else
-        queryData << int32(GetRewOrReqMoney());           // reward money (below max lvl)
+    data << uint32(GetRepObjectiveFaction());               // shown in quest log as part of quest objective
+    data << uint32(GetRepObjectiveValue());                 // shown in quest log as part of quest objective
+
+    data << uint32(GetRepObjectiveFaction2());              // shown in quest log as part of quest objective OPPOSITE faction
+    data << uint32(GetRepObjectiveValue2());                // shown in quest log as part of quest objective OPPOSITE faction
+
+    data << uint32(GetNextQuestInChain());                  // client will request this quest from NPC, if not 0
+    data << uint32(GetXPId());                              // used for calculating rewarded experience
 
-    queryData << uint32(GetRewMoneyMaxLevel());           // used in XP calculation at client
-    queryData << uint32(GetRewSpell());                   // reward spell, this spell will display (icon) (casted if RewSpellCast == 0)
-    queryData << int32(GetRewSpellCast());                // casted spell
+    ASSERT(data.wpos() == QUERY_DATA_MONEY_OFFSET);
+    data << uint32(0);                                      // reward money, depends on the player level, see PlayerMenu::SendQuestQueryResponse
+
+    data << uint32(GetRewMoneyMaxLevel());                  // used in XP calculation at client
+    data << uint32(GetRewSpell());                          // reward spell, this spell will display (icon) (cast if RewSpellCast == 0)
+    data << int32(GetRewSpellCast());                       // cast spell
 
     // rewarded honor points
-    queryData << uint32(GetRewHonorAddition());
-    queryData << float(GetRewHonorMultiplier());
-    queryData << uint32(GetSrcItemId());                  // source item id
-    queryData << uint32(GetFlags() & 0xFFFF);             // quest flags
-    queryData << uint32(GetCharTitleId());                // CharTitleId, new 2.4.0, player gets this title (id from CharTitles)
-    queryData << uint32(GetPlayersSlain());               // players slain
-    queryData << uint32(GetBonusTalents());               // bonus talents
-    queryData << uint32(GetRewArenaPoints());             // bonus arena points
-    queryData << uint32(0);                                      // review rep show mask
+    data << uint32(GetRewHonorAddition());
+    data << float(GetRewHonorMultiplier());
+    data << uint32(GetSrcItemId());                         // source item id
+    data << uint32(GetFlags() & 0xFFFF);                    // quest flags
+    data << uint32(GetCharTitleId());                       // CharTitleId, new 2.4.0, player gets this title (id from CharTitles)
+    data << uint32(GetPlayersSlain());                      // players slain
+    data << uint32(GetBonusTalents());                      // bonus talents
+    data << uint32(GetRewArenaPoints());                    // bonus arena points
+    data << uint32(0);                                      // review rep show mask
 
     if (HasFlag(QUEST_FLAGS_HIDDEN_REWARDS))
     {
-        for (uint32 i = 0; i < QUEST_REWARDS_COUNT; ++i)
-            queryData << uint32(0) << uint32(0);
-        for (uint32 i = 0; i < QUEST_REWARD_CHOICES_COUNT; ++i)
-            queryData << uint32(0) << uint32(0);
+        for (uint8 i = 0; i < QUEST_REWARDS_COUNT; ++i)
+            data << uint32(0) << uint32(0);
+        for (uint8 i = 0; i < QUEST_REWARD_CHOICES_COUNT; ++i)
+            data << uint32(0) << uint32(0);
     }
     else
     {
-        for (uint32 i = 0; i < QUEST_REWARDS_COUNT; ++i)
+        for (uint8 i = 0; i < QUEST_REWARDS_COUNT; ++i)
         {
-            queryData << uint32(RewardItemId[i]);
-            queryData << uint32(RewardItemIdCount[i]);
+            data << uint32(RewardItemId[i]);
+            data << uint32(RewardItemIdCount[i]);
         }
-        for (uint32 i = 0; i < QUEST_REWARD_CHOICES_COUNT; ++i)
+        for (uint8 i = 0; i < QUEST_REWARD_CHOICES_COUNT; ++i)
         {
-            queryData << uint32(RewardChoiceItemId[i]);
-            queryData << uint32(RewardChoiceItemCount[i]);
+            data << uint32(RewardChoiceItemId[i]);
+            data << uint32(RewardChoiceItemCount[i]);
         }
     }
 
-    for (uint32 i = 0; i < QUEST_REPUTATIONS_COUNT; ++i)        // reward factions ids
-        queryData << uint32(RewardFactionId[i]);
+    for (uint8 i = 0; i < QUEST_REPUTATIONS_COUNT; ++i)        // reward factions ids
+        data << uint32(RewardFactionId[i]);
 
-    for (uint32 i = 0; i < QUEST_REPUTATIONS_COUNT; ++i)        // columnid+1 QuestFactionReward.dbc?
-        queryData << int32(RewardFactionValueId[i]);
+    for (uint8 i = 0; i < QUEST_REPUTATIONS_COUNT; ++i)        // columnid+1 QuestFactionReward.dbc?
+        data << int32(RewardFactionValueId[i]);
 
-    for (int i = 0; i < QUEST_REPUTATIONS_COUNT; ++i)           // unk (0)
-        queryData << int32(RewardFactionValueIdOverride[i]);
+    for (uint8 i = 0; i < QUEST_REPUTATIONS_COUNT; ++i)        // unk (0)
+        data << int32(RewardFactionValueIdOverride[i]);
 
-    queryData << GetPOIContinent();
-    queryData << GetPOIx();
-    queryData << GetPOIy();
-    queryData << GetPointOpt();
+    data << uint32(GetPOIContinent());
+    data << float(GetPOIx());
+    data << float(GetPOIy());
+    data << uint32(GetPointOpt());
 
-    queryData << GetTitle();
-    queryData << GetObjectives();
-    queryData << GetDetails();
-    queryData << GetAreaDescription();
-    queryData << GetCompletedText();                                  // display in quest objectives window once all objectives are completed
+    data << questTitle;
+    data << questObjectives;
+    data << questDetails;
+    data << questAreaDescription;
+    data << questCompletedText;                                 // display in quest objectives window once all objectives are completed
 
-    for (uint32 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+    for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
     {
         if (RequiredNpcOrGo[i] < 0)
-            queryData << uint32((RequiredNpcOrGo[i] * (-1)) | 0x80000000);    // client expects gameobject template id in form (id|0x80000000)
+            data << uint32((RequiredNpcOrGo[i] * (-1)) | 0x80000000);    // client expects gameobject template id in form (id|0x80000000)
         else
-            queryData << uint32(RequiredNpcOrGo[i]);
+            data << uint32(RequiredNpcOrGo[i]);
 
-        queryData << uint32(RequiredNpcOrGoCount[i]);
-        queryData << uint32(ItemDrop[i]);
-        queryData << uint32(0);                                  // req source count?
+        data << uint32(RequiredNpcOrGoCount[i]);
+        data << uint32(ItemDrop[i]);
+        data << uint32(0);                                  // req source count?
     }
 
-    for (uint32 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
+    for (uint8 i = 0; i < QUEST_ITEM_OBJECTIVES_COUNT; ++i)
     {
-        queryData << uint32(RequiredItemId[i]);
-        queryData << uint32(RequiredItemCount[i]);
+        data << uint32(RequiredItemId[i]);
+        data << uint32(RequiredItemCount[i]);
     }
 
-    for (uint32 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
-        queryData << ObjectiveText[i];
+    for (uint8 i = 0; i < QUEST_OBJECTIVES_COUNT; ++i)
+        data << questObjectiveText[i];
+
+    return data;
+}
+
+void Quest::InitializeQueryData()
+{
+    QueryData.Initialize(sObjectMgr->GetQuestLocale(GetQuestId()) != nullptr, [this](LocaleConstant locale) { return BuildQueryData(locale); });
 }
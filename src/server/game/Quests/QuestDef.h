@@ -21,6 +21,7 @@
 #include "DBCEnums.h"
 #include "DatabaseEnv.h"
 #include "Define.h"
+#include "LocalizedQueryData.h"
 #include "SharedDefines.h"
 #include "WorldPacket.h"
 #include <string>
@@ -182,24 +183,24 @@ struct QuestLocale
 {
     QuestLocale() { ObjectiveText.resize(QUEST_OBJECTIVES_COUNT); }
 
-    std::vector<std::string> Title;
-    std::vector<std::string> Details;
-    std::vector<std::string> Objectives;
-    std::vector<std::string> OfferRewardText;
-    std::vector<std::string> RequestItemsText;
-    std::vector<std::string> AreaDescription;
-    std::vector<std::string> CompletedText;
-    std::vector< std::vector<std::string> > ObjectiveText;
+    LocaleStrings Title;
+    LocaleStrings Details;
+    LocaleStrings Objectives;
+    LocaleStrings OfferRewardText;
+    LocaleStrings RequestItemsText;
+    LocaleStrings AreaDescription;
+    LocaleStrings CompletedText;
+    std::vector<LocaleStrings> ObjectiveText;
 };
 
 struct QuestRequestItemsLocale
 {
-    std::vector<std::string> CompletionText;
+    LocaleStrings CompletionText;
 };
 
 struct QuestOfferRewardLocale
 {
-    std::vector<std::string> RewardText;
+    LocaleStrings RewardText;
 };
 
 // This Quest class provides a convenient way to access a few pretotaled (cached) quest details,
@@ -324,8 +325,13 @@ public:
     typedef std::vector<uint32> PrevChainQuests;
     PrevChainQuests prevChainQuests;
 
-    WorldPacket queryData; // pussywizard
-    void InitializeQueryData(); // pussywizard
+    // SMSG_QUEST_QUERY_RESPONSE, built by ObjectMgr::InitializeQueriesData
+    // the reward money depends on the player level and is written at QUERY_DATA_MONEY_OFFSET when sending
+    static constexpr std::size_t QUERY_DATA_MONEY_OFFSET = 13 * sizeof(uint32);
+    LocalizedQueryData QueryData;
+
+    [[nodiscard]] WorldPacket BuildQueryData(LocaleConstant locale) const;
+    void InitializeQueryData();
 
     void SetEventIdForQuest(uint16 eventId) { _eventIdForQuest = eventId; }
     [[nodiscard]] uint16 GetEventIdForQuest() const { return _eventIdForQuest; }
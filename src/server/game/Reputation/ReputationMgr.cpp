@@ -246,7 +246,47 @@ void ReputationMgr::SendInitialReputations()
 void ReputationMgr::SendStates()
 {
     for (FactionStateList::iterator itr = _factions.begin(); itr != _factions.end(); ++itr)
-        SendState(&(itr->second));
+        itr->second.needSend = true;
+
+    _sendStatesPending = true;
+    SendPendingStates();
+}
+
+void ReputationMgr::SendPendingStates()
+{
+    if (!_sendStatesPending)
+        return;
+
+    _sendStatesPending = false;
+
+    uint32 count = 0;
+
+    WorldPacket data(SMSG_SET_FACTION_STANDING, 17);
+    data << float(0);
+    data << uint8(_sendFactionIncreased);
+
+    size_t p_count = data.wpos();
+    data << uint32(count);
+
+    for (FactionStateList::iterator itr = _factions.begin(); itr != _factions.end(); ++itr)
+    {
+        if (itr->second.needSend)
+        {
+            itr->second.needSend = false;
+            data << uint32(itr->second.ReputationListID);
+            data << uint32(itr->second.Standing);
+            ++count;
+        }
+    }
+
+    // already sent along with a SendState call
+    if (!count)
+        return;
+
+    _sendFactionIncreased = false; // Reset
+
+    data.put<uint32>(p_count, count);
+    _player->SendDirectMessage(&data);
 }
 
 void ReputationMgr::SendVisible(FactionState const* faction) const
@@ -268,6 +308,7 @@ void ReputationMgr::Initialize()
     _reveredFactionCount = 0;
     _exaltedFactionCount = 0;
     _sendFactionIncreased = false;
+    _sendStatesPending = false;
 
     for (unsigned int i = 1; i < sFactionStore.GetNumRows(); i++)
     {
@@ -300,59 +341,32 @@ bool ReputationMgr::SetReputation(FactionEntry const* factionEntry, float standi
 
     if (!noSpillOver)
     {
-        // if spillover definition exists in DB, override DBC
-        if (const RepSpilloverTemplate* repTemplate = sObjectMgr->GetRepSpilloverTemplate(factionEntry->ID))
-        {
-            for (uint32 i = 0; i < MAX_SPILLOVER_FACTIONS; ++i)
-            {
-                if (repTemplate->faction[i])
-                {
-                    if (_player->GetReputationRank(repTemplate->faction[i]) <= ReputationRank(repTemplate->faction_rank[i]))
-                    {
-                        // bonuses are already given, so just modify standing by rate
-                        float spilloverRep = standing * repTemplate->faction_rate[i];
-                        SetOneFactionReputation(sFactionStore.LookupEntry(repTemplate->faction[i]), spilloverRep, incremental);
-                    }
-                }
-            }
-        }
-        else
+        // spillover targets are resolved at load, see ObjectMgr::BuildReputationSpillover
+        if (RepSpilloverInfo const* spillover = sObjectMgr->GetRepSpillover(factionEntry->ID))
         {
-            float spillOverRepOut = float(standing);
-            // check for sub-factions that receive spillover
-            SimpleFactionsList const* flist = GetFactionTeamList(factionEntry->ID);
-            // if has no sub-factions, check for factions with same parent
-            if (!flist && factionEntry->team && factionEntry->spilloverRateOut != 0.0f)
+            float spillOverRepOut = standing * spillover->RateOut;
+            RepSpilloverList const* spilloverFactions = &spillover->Factions;
+            if (spillover->Parent)
             {
-                spillOverRepOut *= factionEntry->spilloverRateOut;
-                if (FactionEntry const* parent = sFactionStore.LookupEntry(factionEntry->team))
-                {
-                    FactionStateList::iterator parentState = _factions.find(parent->reputationListID);
-                    // some team factions have own reputation standing, in this case do not spill to other sub-factions
-                    if (parentState != _factions.end() && (parentState->second.Flags & FACTION_FLAG_SPECIAL))
-                    {
-                        SetOneFactionReputation(parent, spillOverRepOut, incremental);
-                    }
-                    else // spill to "sister" factions
-                    {
-                        flist = GetFactionTeamList(factionEntry->team);
-                    }
-                }
+                FactionStateList::iterator parentState = _factions.find(spillover->Parent->reputationListID);
+                // some team factions have own reputation standing, in this case do not spill to other sub-factions
+                if (parentState != _factions.end() && (parentState->second.Flags & FACTION_FLAG_SPECIAL))
+                    SetOneFactionReputation(spillover->Parent, spillOverRepOut, incremental);
+                else // spill to "sister" factions
+                    spilloverFactions = &spillover->SisterFactions;
             }
-            if (flist)
+
+            for (RepSpillover const& target : *spilloverFactions)
             {
-                // Spillover to affiliated factions
-                for (SimpleFactionsList::const_iterator itr = flist->begin(); itr != flist->end(); ++itr)
-                {
-                    if (FactionEntry const* factionEntryCalc = sFactionStore.LookupEntry(*itr))
-                    {
-                        if (factionEntryCalc == factionEntry || GetRank(factionEntryCalc) > ReputationRank(factionEntryCalc->spilloverMaxRankIn))
-                            continue;
-                        float spilloverRep = spillOverRepOut * factionEntryCalc->spilloverRateIn;
-                        if (spilloverRep != 0 || !incremental)
-                            res = SetOneFactionReputation(factionEntryCalc, spilloverRep, incremental);
-                    }
-                }
+                if (GetRank(target.Faction) > target.MaxRank)
+                    continue;
+
+                float spilloverRep = spillOverRepOut * target.Rate;
+                // bonuses of template spillover are already given, so just modify standing by rate
+                if (spillover->FromTemplate)
+                    SetOneFactionReputation(target.Faction, spilloverRep, incremental);
+                else if (spilloverRep != 0 || !incremental)
+                    res = SetOneFactionReputation(target.Faction, spilloverRep, incremental);
             }
         }
     }
@@ -370,7 +384,9 @@ bool ReputationMgr::SetReputation(FactionEntry const* factionEntry, float standi
         }
 
         // only this faction gets reported to client, even if it has no own visible standing
-        SendState(&faction->second);
+        // standings changed by several kills or rewards in one update are sent together
+        faction->second.needSend = true;
+        _sendStatesPending = true;
     }
     return res;
 }
@@ -426,6 +442,7 @@ bool ReputationMgr::SetOneFactionReputation(FactionEntry const* factionEntry, fl
             itr->second.Standing = standing - BaseRep;
             itr->second.needSend = true;
             itr->second.needSave = true;
+            _player->InvalidateQuestGiverStatus();
 
             SetVisible(&itr->second);
 
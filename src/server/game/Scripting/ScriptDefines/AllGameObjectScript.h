@@ -19,11 +19,32 @@
 #define SCRIPT_OBJECT_ALL_GAMEOBJECT_SCRIPT_H_
 
 #include "ScriptObject.h"
+#include <vector>
+
+enum AllGameObjectHook
+{
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_ADD_WORLD,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_SAVE_TO_DB,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_REMOVE_WORLD,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_UPDATE,
+    ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_GOSSIP_HELLO,
+    ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_GOSSIP_SELECT,
+    ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_GOSSIP_SELECT_CODE,
+    ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_QUEST_ACCEPT,
+    ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_QUEST_REWARD,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_DESTROYED,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_DAMAGED,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_MODIFY_HEALTH,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_LOOT_STATE_CHANGED,
+    ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_STATE_CHANGED,
+    ALLGAMEOBJECTHOOK_GET_GAMEOBJECT_AI,
+    ALLGAMEOBJECTHOOK_END
+};
 
 class AllGameObjectScript : public ScriptObject
 {
 protected:
-    AllGameObjectScript(const char* name);
+    AllGameObjectScript(const char* name, std::vector<uint16> enabledHooks = std::vector<uint16>());
 
 public:
     /**
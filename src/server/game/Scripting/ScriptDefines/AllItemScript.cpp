@@ -27,15 +27,9 @@ bool ScriptMgr::OnQuestAccept(Player* player, Item* item, Quest const* quest)
     ASSERT(item);
     ASSERT(quest);
 
-    auto ret = IsValidBoolScript<AllItemScript>([&](AllItemScript* script)
-    {
-        return !script->CanItemQuestAccept(player, item, quest);
-    });
-
-    if (ret && *ret)
-    {
-        return false;
-    }
+    for (auto const& script : ScriptRegistry<AllItemScript>::EnabledHooks[ALLITEMHOOK_CAN_ITEM_QUEST_ACCEPT])
+        if (!script->CanItemQuestAccept(player, item, quest))
+            return false;
 
     auto tempScript = ScriptRegistry<ItemScript>::GetScriptById(item->GetScriptId());
     ClearGossipMenuFor(player);
@@ -47,15 +41,9 @@ bool ScriptMgr::OnItemUse(Player* player, Item* item, SpellCastTargets const& ta
     ASSERT(player);
     ASSERT(item);
 
-    auto ret = IsValidBoolScript<AllItemScript>([&](AllItemScript* script)
-    {
-        return script->CanItemUse(player, item, targets);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllItemScript>::EnabledHooks[ALLITEMHOOK_CAN_ITEM_USE])
+        if (script->CanItemUse(player, item, targets))
+            return true;
 
     auto tempScript = ScriptRegistry<ItemScript>::GetScriptById(item->GetScriptId());
     return tempScript ? tempScript->OnUse(player, item, targets) : false;
@@ -66,15 +54,9 @@ bool ScriptMgr::OnItemExpire(Player* player, ItemTemplate const* proto)
     ASSERT(player);
     ASSERT(proto);
 
-    auto ret = IsValidBoolScript<AllItemScript>([&](AllItemScript* script)
-    {
-        return !script->CanItemExpire(player, proto);
-    });
-
-    if (ret && *ret)
-    {
-        return false;
-    }
+    for (auto const& script : ScriptRegistry<AllItemScript>::EnabledHooks[ALLITEMHOOK_CAN_ITEM_EXPIRE])
+        if (!script->CanItemExpire(player, proto))
+            return false;
 
     auto tempScript = ScriptRegistry<ItemScript>::GetScriptById(proto->ScriptId);
     return tempScript ? tempScript->OnExpire(player, proto) : false;
@@ -85,15 +67,9 @@ bool ScriptMgr::OnItemRemove(Player* player, Item* item)
     ASSERT(player);
     ASSERT(item);
 
-    auto ret = IsValidBoolScript<AllItemScript>([&](AllItemScript* script)
-    {
-        return !script->CanItemRemove(player, item);
-    });
-
-    if (ret && *ret)
-    {
-        return false;
-    }
+    for (auto const& script : ScriptRegistry<AllItemScript>::EnabledHooks[ALLITEMHOOK_CAN_ITEM_REMOVE])
+        if (!script->CanItemRemove(player, item))
+            return false;
 
     auto tempScript = ScriptRegistry<ItemScript>::GetScriptById(item->GetScriptId());
     return tempScript ? tempScript->OnRemove(player, item) : false;
@@ -115,10 +91,7 @@ void ScriptMgr::OnGossipSelect(Player* player, Item* item, uint32 sender, uint32
     ASSERT(player);
     ASSERT(item);
 
-    ExecuteScript<AllItemScript>([&](AllItemScript* script)
-    {
-        script->OnItemGossipSelect(player, item, sender, action);
-    });
+    CALL_ENABLED_HOOKS(AllItemScript, ALLITEMHOOK_ON_ITEM_GOSSIP_SELECT, script->OnItemGossipSelect(player, item, sender, action));
 
     if (auto tempScript = ScriptRegistry<ItemScript>::GetScriptById(item->GetScriptId()))
     {
@@ -131,10 +104,7 @@ void ScriptMgr::OnGossipSelectCode(Player* player, Item* item, uint32 sender, ui
     ASSERT(player);
     ASSERT(item);
 
-    ExecuteScript<AllItemScript>([&](AllItemScript* script)
-    {
-        script->OnItemGossipSelectCode(player, item, sender, action, code);
-    });
+    CALL_ENABLED_HOOKS(AllItemScript, ALLITEMHOOK_ON_ITEM_GOSSIP_SELECT_CODE, script->OnItemGossipSelectCode(player, item, sender, action, code));
 
     if (auto tempScript = ScriptRegistry<ItemScript>::GetScriptById(item->GetScriptId()))
     {
@@ -142,10 +112,15 @@ void ScriptMgr::OnGossipSelectCode(Player* player, Item* item, uint32 sender, ui
     }
 }
 
-AllItemScript::AllItemScript(const char* name) :
-    ScriptObject(name)
+AllItemScript::AllItemScript(const char* name, std::vector<uint16> enabledHooks)
+    : ScriptObject(name, ALLITEMHOOK_END)
 {
-    ScriptRegistry<AllItemScript>::AddScript(this);
+    // If empty - enable all available hooks.
+    if (enabledHooks.empty())
+        for (uint16 i = 0; i < ALLITEMHOOK_END; ++i)
+            enabledHooks.emplace_back(i);
+
+    ScriptRegistry<AllItemScript>::AddScript(this, std::move(enabledHooks));
 }
 
 ItemScript::ItemScript(const char* name) :
@@ -19,11 +19,23 @@
 #define SCRIPT_OBJECT_ALL_ITEM_SCRIPT_H_
 
 #include "ScriptObject.h"
+#include <vector>
+
+enum AllItemHook
+{
+    ALLITEMHOOK_CAN_ITEM_QUEST_ACCEPT,
+    ALLITEMHOOK_CAN_ITEM_USE,
+    ALLITEMHOOK_CAN_ITEM_REMOVE,
+    ALLITEMHOOK_CAN_ITEM_EXPIRE,
+    ALLITEMHOOK_ON_ITEM_GOSSIP_SELECT,
+    ALLITEMHOOK_ON_ITEM_GOSSIP_SELECT_CODE,
+    ALLITEMHOOK_END
+};
 
 class AllItemScript : public ScriptObject
 {
 protected:
-    AllItemScript(const char* name);
+    AllItemScript(const char* name, std::vector<uint16> enabledHooks = std::vector<uint16>());
 
 public:
     // Called when a player accepts a quest from the item.
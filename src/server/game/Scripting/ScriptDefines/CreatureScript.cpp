@@ -26,15 +26,9 @@ bool ScriptMgr::OnGossipHello(Player* player, Creature* creature)
     ASSERT(player);
     ASSERT(creature);
 
-    auto ret = IsValidBoolScript<AllCreatureScript>([&](AllCreatureScript* script)
-    {
-        return script->CanCreatureGossipHello(player, creature);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllCreatureScript>::EnabledHooks[ALLCREATUREHOOK_CAN_CREATURE_GOSSIP_HELLO])
+        if (script->CanCreatureGossipHello(player, creature))
+            return true;
 
     auto tempScript = ScriptRegistry<CreatureScript>::GetScriptById(creature->GetScriptId());
     ClearGossipMenuFor(player);
@@ -46,15 +40,9 @@ bool ScriptMgr::OnGossipSelect(Player* player, Creature* creature, uint32 sender
     ASSERT(player);
     ASSERT(creature);
 
-    auto ret = IsValidBoolScript<AllCreatureScript>([&](AllCreatureScript* script)
-    {
-        return script->CanCreatureGossipSelect(player, creature, sender, action);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllCreatureScript>::EnabledHooks[ALLCREATUREHOOK_CAN_CREATURE_GOSSIP_SELECT])
+        if (script->CanCreatureGossipSelect(player, creature, sender, action))
+            return true;
 
     auto tempScript = ScriptRegistry<CreatureScript>::GetScriptById(creature->GetScriptId());
     return tempScript ? tempScript->OnGossipSelect(player, creature, sender, action) : false;
@@ -66,15 +54,9 @@ bool ScriptMgr::OnGossipSelectCode(Player* player, Creature* creature, uint32 se
     ASSERT(creature);
     ASSERT(code);
 
-    auto ret = IsValidBoolScript<AllCreatureScript>([&](AllCreatureScript* script)
-    {
-        return script->CanCreatureGossipSelectCode(player, creature, sender, action, code);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllCreatureScript>::EnabledHooks[ALLCREATUREHOOK_CAN_CREATURE_GOSSIP_SELECT_CODE])
+        if (script->CanCreatureGossipSelectCode(player, creature, sender, action, code))
+            return true;
 
     auto tempScript = ScriptRegistry<CreatureScript>::GetScriptById(creature->GetScriptId());
     return tempScript ? tempScript->OnGossipSelectCode(player, creature, sender, action, code) : false;
@@ -86,15 +68,9 @@ bool ScriptMgr::OnQuestAccept(Player* player, Creature* creature, Quest const* q
     ASSERT(creature);
     ASSERT(quest);
 
-    auto ret = IsValidBoolScript<AllCreatureScript>([&](AllCreatureScript* script)
-    {
-        return script->CanCreatureQuestAccept(player, creature, quest);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllCreatureScript>::EnabledHooks[ALLCREATUREHOOK_CAN_CREATURE_QUEST_ACCEPT])
+        if (script->CanCreatureQuestAccept(player, creature, quest))
+            return true;
 
     auto tempScript = ScriptRegistry<CreatureScript>::GetScriptById(creature->GetScriptId());
     ClearGossipMenuFor(player);
@@ -129,15 +105,9 @@ bool ScriptMgr::OnQuestReward(Player* player, Creature* creature, Quest const* q
     ASSERT(creature);
     ASSERT(quest);
 
-    auto ret = IsValidBoolScript<AllCreatureScript>([&](AllCreatureScript* script)
-    {
-        return script->CanCreatureQuestReward(player, creature, quest, opt);
-    });
-
-    if (ret && *ret)
-    {
-        return false;
-    }
+    for (auto const& script : ScriptRegistry<AllCreatureScript>::EnabledHooks[ALLCREATUREHOOK_CAN_CREATURE_QUEST_REWARD])
+        if (script->CanCreatureQuestReward(player, creature, quest, opt))
+            return false;
 
     auto tempScript = ScriptRegistry<CreatureScript>::GetScriptById(creature->GetScriptId());
     ClearGossipMenuFor(player);
@@ -157,15 +127,9 @@ CreatureAI* ScriptMgr::GetCreatureAI(Creature* creature)
 {
     ASSERT(creature);
 
-    auto retAI = GetReturnAIScript<AllCreatureScript, CreatureAI>([creature](AllCreatureScript* script)
-    {
-        return script->GetCreatureAI(creature);
-    });
-
-    if (retAI)
-    {
-        return retAI;
-    }
+    for (auto const& script : ScriptRegistry<AllCreatureScript>::EnabledHooks[ALLCREATUREHOOK_GET_CREATURE_AI])
+        if (CreatureAI* scriptAI = script->GetCreatureAI(creature))
+            return scriptAI;
 
     auto tempScript = ScriptRegistry<CreatureScript>::GetScriptById(creature->GetScriptId());
     return tempScript ? tempScript->GetAI(creature) : nullptr;
@@ -174,20 +138,14 @@ CreatureAI* ScriptMgr::GetCreatureAI(Creature* creature)
 //Fires whenever the UNIT_BYTE2_FLAG_FFA_PVP bit is Changed on the player
 void ScriptMgr::OnFfaPvpStateUpdate(Creature* creature, bool InPvp)
 {
-    ExecuteScript<AllCreatureScript>([&](AllCreatureScript* script)
-        {
-            script->OnFfaPvpStateUpdate(creature, InPvp);
-        });
+    CALL_ENABLED_HOOKS(AllCreatureScript, ALLCREATUREHOOK_ON_FFA_PVP_STATE_UPDATE, script->OnFfaPvpStateUpdate(creature, InPvp));
 }
 
 void ScriptMgr::OnCreatureUpdate(Creature* creature, uint32 diff)
 {
     ASSERT(creature);
 
-    ExecuteScript<AllCreatureScript>([&](AllCreatureScript* script)
-    {
-        script->OnAllCreatureUpdate(creature, diff);
-    });
+    CALL_ENABLED_HOOKS(AllCreatureScript, ALLCREATUREHOOK_ON_ALL_CREATURE_UPDATE, script->OnAllCreatureUpdate(creature, diff));
 
     if (auto tempScript = ScriptRegistry<CreatureScript>::GetScriptById(creature->GetScriptId()))
     {
@@ -26,15 +26,9 @@ bool ScriptMgr::OnGossipHello(Player* player, GameObject* go)
     ASSERT(player);
     ASSERT(go);
 
-    auto ret = IsValidBoolScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        return script->CanGameObjectGossipHello(player, go);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllGameObjectScript>::EnabledHooks[ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_GOSSIP_HELLO])
+        if (script->CanGameObjectGossipHello(player, go))
+            return true;
 
     auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId());
     ClearGossipMenuFor(player);
@@ -46,15 +40,9 @@ bool ScriptMgr::OnGossipSelect(Player* player, GameObject* go, uint32 sender, ui
     ASSERT(player);
     ASSERT(go);
 
-    auto ret = IsValidBoolScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        return script->CanGameObjectGossipSelect(player, go, sender, action);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllGameObjectScript>::EnabledHooks[ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_GOSSIP_SELECT])
+        if (script->CanGameObjectGossipSelect(player, go, sender, action))
+            return true;
 
     auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId());
     return tempScript ? tempScript->OnGossipSelect(player, go, sender, action) : false;
@@ -66,15 +54,9 @@ bool ScriptMgr::OnGossipSelectCode(Player* player, GameObject* go, uint32 sender
     ASSERT(go);
     ASSERT(code);
 
-    auto ret = IsValidBoolScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        return script->CanGameObjectGossipSelectCode(player, go, sender, action, code);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllGameObjectScript>::EnabledHooks[ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_GOSSIP_SELECT_CODE])
+        if (script->CanGameObjectGossipSelectCode(player, go, sender, action, code))
+            return true;
 
     auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId());
     return tempScript ? tempScript->OnGossipSelectCode(player, go, sender, action, code) : false;
@@ -86,15 +68,9 @@ bool ScriptMgr::OnQuestAccept(Player* player, GameObject* go, Quest const* quest
     ASSERT(go);
     ASSERT(quest);
 
-    auto ret = IsValidBoolScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        return script->CanGameObjectQuestAccept(player, go, quest);
-    });
-
-    if (ret && *ret)
-    {
-        return true;
-    }
+    for (auto const& script : ScriptRegistry<AllGameObjectScript>::EnabledHooks[ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_QUEST_ACCEPT])
+        if (script->CanGameObjectQuestAccept(player, go, quest))
+            return true;
 
     auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId());
     ClearGossipMenuFor(player);
@@ -107,15 +83,9 @@ bool ScriptMgr::OnQuestReward(Player* player, GameObject* go, Quest const* quest
     ASSERT(go);
     ASSERT(quest);
 
-    auto ret = IsValidBoolScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        return script->CanGameObjectQuestReward(player, go, quest, opt);
-    });
-
-    if (ret && *ret)
-    {
-        return false;
-    }
+    for (auto const& script : ScriptRegistry<AllGameObjectScript>::EnabledHooks[ALLGAMEOBJECTHOOK_CAN_GAMEOBJECT_QUEST_REWARD])
+        if (script->CanGameObjectQuestReward(player, go, quest, opt))
+            return false;
 
     auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId());
     ClearGossipMenuFor(player);
@@ -135,10 +105,7 @@ void ScriptMgr::OnGameObjectDestroyed(GameObject* go, Player* player)
 {
     ASSERT(go);
 
-    ExecuteScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        script->OnGameObjectDestroyed(go, player);
-    });
+    CALL_ENABLED_HOOKS(AllGameObjectScript, ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_DESTROYED, script->OnGameObjectDestroyed(go, player));
 
     if (auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId()))
     {
@@ -150,10 +117,7 @@ void ScriptMgr::OnGameObjectDamaged(GameObject* go, Player* player)
 {
     ASSERT(go);
 
-    ExecuteScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        script->OnGameObjectDamaged(go, player);
-    });
+    CALL_ENABLED_HOOKS(AllGameObjectScript, ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_DAMAGED, script->OnGameObjectDamaged(go, player));
 
     if (auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId()))
     {
@@ -165,10 +129,7 @@ void ScriptMgr::OnGameObjectModifyHealth(GameObject* go, Unit* attackerOrHealer,
 {
     ASSERT(go);
 
-    ExecuteScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        script->OnGameObjectModifyHealth(go, attackerOrHealer, change, spellInfo);
-    });
+    CALL_ENABLED_HOOKS(AllGameObjectScript, ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_MODIFY_HEALTH, script->OnGameObjectModifyHealth(go, attackerOrHealer, change, spellInfo));
 
     if (auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId()))
     {
@@ -180,10 +141,7 @@ void ScriptMgr::OnGameObjectLootStateChanged(GameObject* go, uint32 state, Unit*
 {
     ASSERT(go);
 
-    ExecuteScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        script->OnGameObjectLootStateChanged(go, state, unit);
-    });
+    CALL_ENABLED_HOOKS(AllGameObjectScript, ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_LOOT_STATE_CHANGED, script->OnGameObjectLootStateChanged(go, state, unit));
 
     if (auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId()))
     {
@@ -195,10 +153,7 @@ void ScriptMgr::OnGameObjectStateChanged(GameObject* go, uint32 state)
 {
     ASSERT(go);
 
-    ExecuteScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        script->OnGameObjectStateChanged(go, state);
-    });
+    CALL_ENABLED_HOOKS(AllGameObjectScript, ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_STATE_CHANGED, script->OnGameObjectStateChanged(go, state));
 
     if (auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId()))
     {
@@ -210,10 +165,7 @@ void ScriptMgr::OnGameObjectUpdate(GameObject* go, uint32 diff)
 {
     ASSERT(go);
 
-    ExecuteScript<AllGameObjectScript>([&](AllGameObjectScript* script)
-    {
-        script->OnGameObjectUpdate(go, diff);
-    });
+    CALL_ENABLED_HOOKS(AllGameObjectScript, ALLGAMEOBJECTHOOK_ON_GAMEOBJECT_UPDATE, script->OnGameObjectUpdate(go, diff));
 
     if (auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId()))
     {
@@ -225,15 +177,9 @@ GameObjectAI* ScriptMgr::GetGameObjectAI(GameObject* go)
 {
     ASSERT(go);
 
-    auto retAI = GetReturnAIScript<AllGameObjectScript, GameObjectAI>([go](AllGameObjectScript* script)
-    {
-        return script->GetGameObjectAI(go);
-    });
-
-    if (retAI)
-    {
-        return retAI;
-    }
+    for (auto const& script : ScriptRegistry<AllGameObjectScript>::EnabledHooks[ALLGAMEOBJECTHOOK_GET_GAMEOBJECT_AI])
+        if (GameObjectAI* scriptAI = script->GetGameObjectAI(go))
+            return scriptAI;
 
     auto tempScript = ScriptRegistry<GameObjectScript>::GetScriptById(go->GetScriptId());
     return tempScript ? tempScript->GetAI(go) : nullptr;
@@ -20,6 +20,7 @@
 #include "LFGScripts.h"
 #include "InstanceScript.h"
 #include "ScriptObject.h"
+#include "ScriptReloadMgr.h"
 #include "ScriptSystem.h"
 #include "SmartAI.h"
 #include "SpellMgr.h"
@@ -36,6 +37,13 @@ namespace
         }
 
         ScriptRegistry<T>::ScriptPointerList.clear();
+
+        for (T* script : ScriptRegistry<T>::RetiredScripts)
+        {
+            delete script;
+        }
+
+        ScriptRegistry<T>::RetiredScripts.clear();
     }
 }
 
@@ -49,7 +57,8 @@ ScriptMgr::ScriptMgr()
     : _scriptCount(0),
     _scheduledScripts(0),
     _script_loader_callback(nullptr),
-    _modules_loader_callback(nullptr) { }
+    _modules_loader_callback(nullptr),
+    _swappingScriptModule(false) { }
 
 ScriptMgr::~ScriptMgr() { }
 
@@ -78,6 +87,9 @@ void ScriptMgr::Initialize()
     _script_loader_callback();
     _modules_loader_callback();
 
+    // Script modules built with the dynamic linkage
+    sScriptReloadMgr->Initialize();
+
     ScriptRegistry<AccountScript>::InitEnabledHooksIfNeeded(ACCOUNTHOOK_END);
     ScriptRegistry<AchievementScript>::InitEnabledHooksIfNeeded(ACHIEVEMENTHOOK_END);
     ScriptRegistry<ArenaScript>::InitEnabledHooksIfNeeded(ARENAHOOK_END);
@@ -162,6 +174,18 @@ void ScriptMgr::LoadDatabase()
 
     sScriptSystemMgr->LoadScriptWaypoints();
 
+    AddAfterLoadScripts();
+
+    FillSpellSummary();
+
+    CheckIfScriptsInDatabaseExist();
+
+    LOG_INFO("server.loading", ">> Loaded {} C++ scripts in {} ms", GetScriptCount(), GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
+void ScriptMgr::AddAfterLoadScripts()
+{
     // Add all scripts that must be loaded after db/maps
     ScriptRegistry<WorldMapScript>::AddALScripts();
     ScriptRegistry<BattlegroundMapScript>::AddALScripts();
@@ -177,13 +201,14 @@ void ScriptMgr::LoadDatabase()
     ScriptRegistry<ConditionScript>::AddALScripts();
     ScriptRegistry<TransportScript>::AddALScripts();
     ScriptRegistry<AchievementCriteriaScript>::AddALScripts();
+}
 
-    FillSpellSummary();
-
-    CheckIfScriptsInDatabaseExist();
-
-    LOG_INFO("server.loading", ">> Loaded {} C++ scripts in {} ms", GetScriptCount(), GetMSTimeDiffToNow(oldMSTime));
-    LOG_INFO("server.loading", " ");
+void ScriptMgr::SwapScriptModule(ScriptLoaderCallbackType script_loader_callback)
+{
+    _swappingScriptModule = true;
+    script_loader_callback();
+    AddAfterLoadScripts();
+    _swappingScriptModule = false;
 }
 
 void ScriptMgr::CheckIfScriptsInDatabaseExist()
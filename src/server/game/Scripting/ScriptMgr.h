@@ -145,9 +145,19 @@ public: /* Initialization */
         _modules_loader_callback = script_loader_callback;
     }
 
+    /// Invokes the loader of a swapped script module. Only database bound scripts
+    /// are accepted, they replace the registered scripts of the same name.
+    void SwapScriptModule(ScriptLoaderCallbackType script_loader_callback);
+    [[nodiscard]] bool IsSwappingScriptModule() const { return _swappingScriptModule; }
+
 public: /* Unloading */
     void Unload();
 
+private:
+    void AddAfterLoadScripts();
+
+public:
+
 public: /* SpellScriptLoader */
     void CreateSpellScripts(uint32 spellId, std::list<SpellScript*>& scriptVector);
     void CreateAuraScripts(uint32 spellId, std::list<AuraScript*>& scriptVector);
@@ -701,6 +711,8 @@ private:
 
     ScriptLoaderCallbackType _script_loader_callback;
     ModulesLoaderCallbackType _modules_loader_callback;
+
+    bool _swappingScriptModule;
 };
 
 #define sScriptMgr ScriptMgr::instance()
@@ -726,6 +738,9 @@ public:
     // The list of hook types with the list of enabled scripts for this specific hook.
     // With this approach, we wouldn't call all available hooks in case if we override just one hook.
     static EnabledHooksVector EnabledHooks;
+    // Scripts replaced by a script module swap. Objects created from them (AIs, spell scripts)
+    // may still be alive and reference them, so they are only deleted on unload.
+    static std::vector<TScript*> RetiredScripts;
 
     static void InitEnabledHooksIfNeeded(uint16 totalAvailableHooks)
     {
@@ -739,6 +754,14 @@ public:
         if (!_checkMemory(script))
             return;
 
+        // Hooks of scripts which aren't database bound stay with the module that registered them first
+        if (sScriptMgr->IsSwappingScriptModule() && !script->IsDatabaseBound())
+        {
+            LOG_WARN("scripts", "Script '{}' is not database bound and can't be swapped at runtime, skipped.", script->GetName());
+            delete script;
+            return;
+        }
+
         if (EnabledHooks.empty())
             InitEnabledHooksIfNeeded(script->GetTotalAvailableHooks());
 
@@ -771,7 +794,7 @@ public:
             {
                 if (!_checkMemory(script))
                 {
-                    return;
+                    continue;
                 }
 
                 // Get an ID for the script. An ID only exists if it's a script that is assigned in the database
@@ -780,7 +803,7 @@ public:
                 if (id)
                 {
                     // Try to find an existing script.
-                    TScript const* oldScript = nullptr;
+                    TScript* oldScript = nullptr;
                     for (auto iterator = ScriptPointerList.begin(); iterator != ScriptPointerList.end(); ++iterator)
                     {
                         // If the script names match...
@@ -803,7 +826,10 @@ public:
                                     break;
                                 }
 
-                        delete oldScript;
+                        if (sScriptMgr->IsSwappingScriptModule())
+                            RetiredScripts.push_back(oldScript);
+                        else
+                            delete oldScript;
                     }
 
                     // Assign new script!
@@ -833,6 +859,9 @@ public:
                 sScriptMgr->IncreaseScriptCount();
             }
         }
+
+        // Registered now, a later script module swap must not see them again
+        ALScripts.clear();
     }
 
     // Gets a script by its ID (assigned by ObjectMgr).
@@ -874,6 +903,7 @@ private:
 template<class TScript> std::map<uint32, TScript*> ScriptRegistry<TScript>::ScriptPointerList;
 template<class TScript> std::vector<std::pair<TScript*,std::vector<uint16>>> ScriptRegistry<TScript>::ALScripts;
 template<class TScript> std::vector<std::vector<TScript*>> ScriptRegistry<TScript>::EnabledHooks;
+template<class TScript> std::vector<TScript*> ScriptRegistry<TScript>::RetiredScripts;
 template<class TScript> uint32 ScriptRegistry<TScript>::_scriptIdCounter = 0;
 
 #endif
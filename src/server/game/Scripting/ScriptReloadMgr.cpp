@@ -0,0 +1,285 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScriptReloadMgr.h"
+#include "Config.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "ScriptMgr.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <cstring>
+
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+#  include <windows.h>
+#else
+#  include <dlfcn.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+#if AC_PLATFORM == AC_PLATFORM_WINDOWS
+    typedef HMODULE LibraryHandle;
+    constexpr char const* LIBRARY_EXTENSION = ".dll";
+
+    LibraryHandle OpenLibrary(fs::path const& path) { return LoadLibraryW(path.c_str()); }
+    void CloseLibrary(LibraryHandle handle) { FreeLibrary(handle); }
+    void* GetLibrarySymbol(LibraryHandle handle, char const* name) { return reinterpret_cast<void*>(GetProcAddress(handle, name)); }
+    std::string GetLibraryError() { return std::to_string(GetLastError()); }
+#else
+    typedef void* LibraryHandle;
+#  if AC_PLATFORM == AC_PLATFORM_APPLE
+    constexpr char const* LIBRARY_EXTENSION = ".dylib";
+#  else
+    constexpr char const* LIBRARY_EXTENSION = ".so";
+#  endif
+
+    // RTLD_LOCAL keeps the symbols of a swapped copy from binding to the previous one
+    LibraryHandle OpenLibrary(fs::path const& path) { return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL); }
+    void CloseLibrary(LibraryHandle handle) { dlclose(handle); }
+    void* GetLibrarySymbol(LibraryHandle handle, char const* name) { return dlsym(handle, name); }
+    std::string GetLibraryError() { char const* error = dlerror(); return error ? error : ""; }
+#endif
+
+    // Script module projects are named scripts_<module>, prefixed with lib on unix
+    bool IsScriptModuleFile(fs::path const& path)
+    {
+        std::string const name = path.filename().string();
+        return path.extension() == LIBRARY_EXTENSION && (name.starts_with("scripts_") || name.starts_with("libscripts_"));
+    }
+}
+
+/// A loaded copy of a script module library, see ScriptLoader.cpp.in.cmake for the exported functions
+class ScriptModule
+{
+public:
+    typedef char const*(*GetScriptModuleRevisionHashType)();
+    typedef char const*(*GetScriptModuleType)();
+    typedef char const*(*GetBuildDirectiveType)();
+
+    ScriptModule(LibraryHandle handle, fs::path sourcePath, fs::path cachePath)
+        : _handle(handle), _sourcePath(std::move(sourcePath)), _cachePath(std::move(cachePath)),
+        _getScriptModuleRevisionHash(nullptr), _getScriptModule(nullptr), _getBuildDirective(nullptr), _addScripts(nullptr) { }
+
+    ~ScriptModule()
+    {
+        CloseLibrary(_handle);
+
+        std::error_code error;
+        fs::remove(_cachePath, error);
+    }
+
+    ScriptModule(ScriptModule const&) = delete;
+    ScriptModule& operator=(ScriptModule const&) = delete;
+
+    bool ResolveFunctions()
+    {
+        _getScriptModuleRevisionHash = reinterpret_cast<GetScriptModuleRevisionHashType>(GetLibrarySymbol(_handle, "GetScriptModuleRevisionHash"));
+        _getScriptModule = reinterpret_cast<GetScriptModuleType>(GetLibrarySymbol(_handle, "GetScriptModule"));
+        _getBuildDirective = reinterpret_cast<GetBuildDirectiveType>(GetLibrarySymbol(_handle, "GetBuildDirective"));
+        _addScripts = reinterpret_cast<ScriptMgr::ScriptLoaderCallbackType>(GetLibrarySymbol(_handle, "AddScripts"));
+
+        return _getScriptModuleRevisionHash && _getScriptModule && _getBuildDirective && _addScripts;
+    }
+
+    [[nodiscard]] char const* GetRevisionHash() const { return _getScriptModuleRevisionHash(); }
+    [[nodiscard]] char const* GetName() const { return _getScriptModule(); }
+    [[nodiscard]] char const* GetBuildDirective() const { return _getBuildDirective(); }
+    [[nodiscard]] ScriptMgr::ScriptLoaderCallbackType GetScriptLoader() const { return _addScripts; }
+    [[nodiscard]] fs::path const& GetSourcePath() const { return _sourcePath; }
+
+private:
+    LibraryHandle _handle;
+    fs::path const _sourcePath;
+    fs::path const _cachePath;
+
+    GetScriptModuleRevisionHashType _getScriptModuleRevisionHash;
+    GetScriptModuleType _getScriptModule;
+    GetBuildDirectiveType _getBuildDirective;
+    ScriptMgr::ScriptLoaderCallbackType _addScripts;
+};
+
+ScriptReloadMgr::ScriptReloadMgr() : _loadCounter(0) { }
+
+ScriptReloadMgr::~ScriptReloadMgr() { }
+
+ScriptReloadMgr* ScriptReloadMgr::instance()
+{
+    static ScriptReloadMgr instance;
+    return &instance;
+}
+
+void ScriptReloadMgr::Initialize()
+{
+    std::string const directory = sConfigMgr->GetOption<std::string>("Scripts.ModulesDirectory", "");
+    if (directory.empty())
+        return;
+
+    std::error_code error;
+    if (!fs::is_directory(directory, error))
+    {
+        LOG_ERROR("scripts", "Scripts.ModulesDirectory '{}' is not a directory, dynamic script modules are disabled.", directory);
+        return;
+    }
+
+    _modulesDirectory = directory;
+
+    // Modules are loaded from copies so the build can overwrite the originals while they are in use
+    _cacheDirectory = _modulesDirectory / ".cache";
+    fs::remove_all(_cacheDirectory, error);
+    if (!fs::create_directories(_cacheDirectory, error))
+    {
+        LOG_ERROR("scripts", "Can't create the script module cache directory '{}', dynamic script modules are disabled.", _cacheDirectory.generic_string());
+        _modulesDirectory.clear();
+        return;
+    }
+
+    for (fs::directory_entry const& entry : fs::directory_iterator(_modulesDirectory, error))
+    {
+        if (!entry.is_regular_file() || !IsScriptModuleFile(entry.path()))
+            continue;
+
+        std::shared_ptr<ScriptModule> module = LoadModule(entry.path());
+        if (!module)
+            continue;
+
+        if (_modules.find(module->GetName()) != _modules.end())
+        {
+            LOG_ERROR("scripts", "Script module '{}' from {} is already loaded, skipped.", module->GetName(), entry.path().generic_string());
+            continue;
+        }
+
+        module->GetScriptLoader()();
+
+        LOG_INFO("server.loading", ">> Loaded script module {} ({})", module->GetName(), module->GetBuildDirective());
+
+        _modules[module->GetName()] = module;
+        _loadedModules.push_back(std::move(module));
+    }
+}
+
+void ScriptReloadMgr::Unload()
+{
+    _modules.clear();
+    _loadedModules.clear();
+
+    if (!_cacheDirectory.empty())
+    {
+        std::error_code error;
+        fs::remove_all(_cacheDirectory, error);
+    }
+}
+
+void ScriptReloadMgr::QueueModuleSwap(std::string const& name)
+{
+    std::lock_guard<std::mutex> lock(_queueLock);
+    _queuedSwaps.push_back(name);
+}
+
+void ScriptReloadMgr::Update()
+{
+    std::vector<std::string> swaps;
+    {
+        std::lock_guard<std::mutex> lock(_queueLock);
+        if (_queuedSwaps.empty())
+            return;
+
+        swaps.swap(_queuedSwaps);
+    }
+
+    for (std::string const& name : swaps)
+        SwapModule(name);
+}
+
+std::vector<std::string> ScriptReloadMgr::GetModuleNames() const
+{
+    std::vector<std::string> names;
+    names.reserve(_modules.size());
+
+    for (auto const& [name, module] : _modules)
+        names.push_back(name);
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::shared_ptr<ScriptModule> ScriptReloadMgr::LoadModule(fs::path const& path)
+{
+    fs::path cachePath = _cacheDirectory / Acore::StringFormat("{}_{}{}", path.stem().string(), ++_loadCounter, path.extension().string());
+
+    std::error_code error;
+    if (!fs::copy_file(path, cachePath, fs::copy_options::overwrite_existing, error))
+    {
+        LOG_ERROR("scripts", "Can't copy script module {} to {}: {}", path.generic_string(), cachePath.generic_string(), error.message());
+        return nullptr;
+    }
+
+    LibraryHandle handle = OpenLibrary(cachePath);
+    if (!handle)
+    {
+        LOG_ERROR("scripts", "Can't load script module {}: {}", path.generic_string(), GetLibraryError());
+        fs::remove(cachePath, error);
+        return nullptr;
+    }
+
+    auto module = std::make_shared<ScriptModule>(handle, path, std::move(cachePath));
+    if (!module->ResolveFunctions())
+    {
+        LOG_ERROR("scripts", "Library {} is not a script module, skipped.", path.generic_string());
+        return nullptr;
+    }
+
+    // Script objects cross the library boundary, both sides must come from the same sources
+    if (std::strcmp(module->GetRevisionHash(), GitRevision::GetHash()) != 0)
+    {
+        LOG_ERROR("scripts", "Script module {} was built from revision {} but the worldserver from {}, skipped.",
+            path.generic_string(), module->GetRevisionHash(), GitRevision::GetHash());
+        return nullptr;
+    }
+
+    return module;
+}
+
+void ScriptReloadMgr::SwapModule(std::string const& name)
+{
+    auto itr = _modules.find(name);
+    if (itr == _modules.end())
+    {
+        LOG_ERROR("scripts", "Script module '{}' is not loaded and can't be swapped.", name);
+        return;
+    }
+
+    std::shared_ptr<ScriptModule> module = LoadModule(itr->second->GetSourcePath());
+    if (!module)
+        return;
+
+    if (name != module->GetName())
+    {
+        LOG_ERROR("scripts", "Library {} now contains script module '{}' instead of '{}', swap aborted.",
+            itr->second->GetSourcePath().generic_string(), module->GetName(), name);
+        return;
+    }
+
+    sScriptMgr->SwapScriptModule(module->GetScriptLoader());
+
+    LOG_INFO("scripts", "Swapped script module {} ({}), creatures use the new scripts from their next respawn.", name, module->GetBuildDirective());
+
+    itr->second = module;
+    _loadedModules.push_back(std::move(module));
+}
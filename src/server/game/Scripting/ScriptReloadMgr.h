@@ -0,0 +1,76 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCRIPT_RELOAD_MGR_H
+#define SCRIPT_RELOAD_MGR_H
+
+#include "Define.h"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ScriptModule;
+
+/// Loads the script modules built with the "dynamic" linkage from Scripts.ModulesDirectory
+/// and swaps them at runtime on request.
+///
+/// A swapped module only replaces database bound scripts (creatures, gameobjects, spells, ...),
+/// creatures bind the new AI on their next respawn. The previous library stays mapped until
+/// shutdown since AIs and spell scripts created from it may still be alive.
+class AC_GAME_API ScriptReloadMgr
+{
+    ScriptReloadMgr();
+    ~ScriptReloadMgr();
+
+public:
+    static ScriptReloadMgr* instance();
+
+    /// Loads all script modules found in the modules directory, called from ScriptMgr::Initialize
+    void Initialize();
+    /// Releases all modules, must be called after ScriptMgr::Unload
+    void Unload();
+
+    /// Queues a swap of the given module, safe to call from any thread
+    void QueueModuleSwap(std::string const& name);
+    /// Swaps the queued modules, must be called while no map is updated
+    void Update();
+
+    [[nodiscard]] bool IsEnabled() const { return !_modulesDirectory.empty(); }
+    [[nodiscard]] std::vector<std::string> GetModuleNames() const;
+
+private:
+    std::shared_ptr<ScriptModule> LoadModule(std::filesystem::path const& path);
+    void SwapModule(std::string const& name);
+
+    std::filesystem::path _modulesDirectory;
+    std::filesystem::path _cacheDirectory;
+    uint32 _loadCounter;
+
+    // Active module per module name and all modules ever loaded, in load order
+    std::unordered_map<std::string, std::shared_ptr<ScriptModule>> _modules;
+    std::vector<std::shared_ptr<ScriptModule>> _loadedModules;
+
+    std::mutex _queueLock;
+    std::vector<std::string> _queuedSwaps;
+};
+
+#define sScriptReloadMgr ScriptReloadMgr::instance()
+
+#endif
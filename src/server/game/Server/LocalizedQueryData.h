@@ -0,0 +1,78 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LOCALIZED_QUERY_DATA_H_
+#define _LOCALIZED_QUERY_DATA_H_
+
+#include "Common.h"
+#include "WorldPacket.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+/// Prebuilt query response of one template, one packet for enUS plus one for every locale whose text differs
+class LocalizedQueryData
+{
+public:
+    LocalizedQueryData() { _index.fill(0); }
+
+    /// builder is called as WorldPacket(LocaleConstant), other locales than enUS are only built when localized is set
+    template<class Builder>
+    void Initialize(bool localized, Builder&& builder)
+    {
+        _packets.clear();
+        _index.fill(0);
+
+        _packets.push_back(builder(DEFAULT_LOCALE));
+        if (!localized)
+            return;
+
+        for (uint8 locale = DEFAULT_LOCALE + 1; locale < TOTAL_LOCALES; ++locale)
+        {
+            WorldPacket packet = builder(LocaleConstant(locale));
+            auto itr = std::find_if(_packets.begin(), _packets.end(), [&packet](WorldPacket const& other)
+            {
+                return other.size() == packet.size() && std::equal(packet.contents(), packet.contents() + packet.size(), other.contents());
+            });
+
+            _index[locale] = uint8(std::distance(_packets.begin(), itr));
+            if (itr == _packets.end())
+                _packets.push_back(std::move(packet));
+        }
+    }
+
+    void Clear()
+    {
+        _packets.clear();
+        _index.fill(0);
+    }
+
+    /// nullptr until Initialize() was called
+    [[nodiscard]] WorldPacket const* Get(LocaleConstant locale) const
+    {
+        if (_packets.empty())
+            return nullptr;
+
+        return &_packets[locale < TOTAL_LOCALES ? _index[locale] : 0];
+    }
+
+private:
+    std::vector<WorldPacket> _packets;
+    std::array<uint8, TOTAL_LOCALES> _index;
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeStats.h"
+#include "Metric.h"
+#include <algorithm>
+#include <bit>
+
+OpcodeHistogram::OpcodeHistogram()
+{
+    Reset();
+}
+
+uint32 OpcodeHistogram::GetBucketIndex(uint64 value)
+{
+    value = std::min<uint64>(value, std::numeric_limits<uint32>::max());
+    if (value < SUB_BUCKET_COUNT)
+        return uint32(value);
+
+    uint32 shift = uint32(std::bit_width(value)) - 1 - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKET_COUNT + uint32(value >> shift) - SUB_BUCKET_COUNT;
+}
+
+uint64 OpcodeHistogram::GetBucketUpperBound(uint32 index)
+{
+    if (index < SUB_BUCKET_COUNT)
+        return index;
+
+    uint32 shift = index / SUB_BUCKET_COUNT - 1;
+    return ((uint64(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) + 1) << shift) - 1;
+}
+
+void OpcodeHistogram::Record(uint64 value)
+{
+    _buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _total.fetch_add(value, std::memory_order_relaxed);
+
+    uint64 max = _max.load(std::memory_order_relaxed);
+    while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        ;
+}
+
+void OpcodeHistogram::Reset()
+{
+    for (std::atomic<uint32>& bucket : _buckets)
+        bucket.store(0, std::memory_order_relaxed);
+
+    _count.store(0, std::memory_order_relaxed);
+    _total.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+uint64 OpcodeHistogram::GetMean() const
+{
+    uint64 count = GetCount();
+    return count ? GetTotal() / count : 0;
+}
+
+uint64 OpcodeHistogram::GetPercentile(double percentile) const
+{
+    uint64 total = 0;
+    for (std::atomic<uint32> const& bucket : _buckets)
+        total += bucket.load(std::memory_order_relaxed);
+
+    if (!total)
+        return 0;
+
+    uint64 target = std::max<uint64>(1, uint64(total * std::clamp(percentile, 0.0, 100.0) / 100.0 + 0.5));
+    uint64 seen = 0;
+    for (uint32 i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target)
+            return std::min(GetBucketUpperBound(i), GetMax());
+    }
+
+    return GetMax();
+}
+
+OpcodeStatsMgr::OpcodeStatsMgr()
+{
+    for (std::atomic<OpcodeStats*>& stats : _stats)
+        stats.store(nullptr, std::memory_order_relaxed);
+}
+
+OpcodeStatsMgr* OpcodeStatsMgr::instance()
+{
+    static OpcodeStatsMgr instance;
+    return &instance;
+}
+
+OpcodeStats* OpcodeStatsMgr::GetOrCreateStats(OpcodeClient opcode)
+{
+    if (OpcodeStats* stats = _stats[opcode].load(std::memory_order_acquire))
+        return stats;
+
+    std::lock_guard<std::mutex> guard(_storageLock);
+    if (OpcodeStats* stats = _stats[opcode].load(std::memory_order_acquire))
+        return stats;
+
+    OpcodeStats* stats = _storage.emplace_back(std::make_unique<OpcodeStats>()).get();
+    _stats[opcode].store(stats, std::memory_order_release);
+    return stats;
+}
+
+void OpcodeStatsMgr::Record(OpcodeClient opcode, uint64 timeUs, uint64 bytes)
+{
+    if (opcode >= NUM_OPCODE_HANDLERS)
+        return;
+
+    OpcodeStats* stats = GetOrCreateStats(opcode);
+    stats->Time.Record(timeUs);
+    stats->Bytes.Record(bytes);
+    stats->IntervalTime.Record(timeUs);
+    stats->IntervalBytes.Record(bytes);
+}
+
+void OpcodeStatsMgr::LogMetrics()
+{
+    for (uint32 opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+    {
+        OpcodeStats* stats = _stats[opcode].load(std::memory_order_acquire);
+        if (!stats || !stats->IntervalTime.GetCount())
+            continue;
+
+        std::string name = GetOpcodeNameForLogging(static_cast<OpcodeClient>(opcode));
+        METRIC_VALUE("opcode_handler_count", stats->IntervalTime.GetCount(), METRIC_TAG("opcode", name));
+        METRIC_VALUE("opcode_handler_time_p50", stats->IntervalTime.GetPercentile(50.0), METRIC_TAG("opcode", name));
+        METRIC_VALUE("opcode_handler_time_p99", stats->IntervalTime.GetPercentile(99.0), METRIC_TAG("opcode", name));
+        METRIC_VALUE("opcode_handler_time_max", stats->IntervalTime.GetMax(), METRIC_TAG("opcode", name));
+        METRIC_VALUE("opcode_handler_bytes_p99", stats->IntervalBytes.GetPercentile(99.0), METRIC_TAG("opcode", name));
+
+        stats->IntervalTime.Reset();
+        stats->IntervalBytes.Reset();
+    }
+}
+
+void OpcodeStatsMgr::Reset()
+{
+    for (std::atomic<OpcodeStats*>& stats : _stats)
+    {
+        if (OpcodeStats* opcodeStats = stats.load(std::memory_order_acquire))
+        {
+            opcodeStats->Time.Reset();
+            opcodeStats->Bytes.Reset();
+            opcodeStats->IntervalTime.Reset();
+            opcodeStats->IntervalBytes.Reset();
+        }
+    }
+}
+
+OpcodeStats const* OpcodeStatsMgr::GetStats(OpcodeClient opcode) const
+{
+    if (opcode >= NUM_OPCODE_HANDLERS)
+        return nullptr;
+
+    return _stats[opcode].load(std::memory_order_acquire);
+}
+
+std::vector<std::pair<OpcodeClient, OpcodeStats const*>> OpcodeStatsMgr::GetTopOpcodes(std::size_t count) const
+{
+    std::vector<std::pair<OpcodeClient, OpcodeStats const*>> result;
+    for (uint32 opcode = 0; opcode < NUM_OPCODE_HANDLERS; ++opcode)
+        if (OpcodeStats const* stats = _stats[opcode].load(std::memory_order_acquire))
+            if (stats->Time.GetCount())
+                result.emplace_back(static_cast<OpcodeClient>(opcode), stats);
+
+    std::sort(result.begin(), result.end(), [](auto const& left, auto const& right)
+    {
+        return left.second->Time.GetTotal() > right.second->Time.GetTotal();
+    });
+
+    if (result.size() > count)
+        result.resize(count);
+
+    return result;
+}
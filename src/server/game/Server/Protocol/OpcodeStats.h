@@ -0,0 +1,94 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __OPCODESTATS_H
+#define __OPCODESTATS_H
+
+#include "Opcodes.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// Log-linear histogram (HDR style): 8 sub-buckets per power of two, about 12% relative error
+class AC_GAME_API OpcodeHistogram
+{
+public:
+    static constexpr uint32 SUB_BUCKET_BITS = 3;
+    static constexpr uint32 SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32 BUCKET_COUNT = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    OpcodeHistogram();
+
+    void Record(uint64 value);
+    void Reset();
+
+    [[nodiscard]] uint64 GetCount() const { return _count.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetTotal() const { return _total.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetMax() const { return _max.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetMean() const;
+    /// highest value equivalent to the bucket holding the given percentile (0-100)
+    [[nodiscard]] uint64 GetPercentile(double percentile) const;
+
+private:
+    static uint32 GetBucketIndex(uint64 value);
+    static uint64 GetBucketUpperBound(uint32 index);
+
+    std::array<std::atomic<uint32>, BUCKET_COUNT> _buckets;
+    std::atomic<uint64> _count;
+    std::atomic<uint64> _total;
+    std::atomic<uint64> _max;
+};
+
+struct OpcodeStats
+{
+    OpcodeHistogram Time;           // handler execution time in microseconds
+    OpcodeHistogram Bytes;          // bytes sent to the session by the handler
+    OpcodeHistogram IntervalTime;   // same as above, reset on every metric export
+    OpcodeHistogram IntervalBytes;
+};
+
+class AC_GAME_API OpcodeStatsMgr
+{
+    OpcodeStatsMgr();
+
+public:
+    static OpcodeStatsMgr* instance();
+
+    /// Thread safe, called from world and map threads
+    void Record(OpcodeClient opcode, uint64 timeUs, uint64 bytes);
+
+    /// Sends the histograms of the last interval to the metric database and resets them
+    void LogMetrics();
+    void Reset();
+
+    /// Opcodes sorted by total handler time, highest first
+    [[nodiscard]] std::vector<std::pair<OpcodeClient, OpcodeStats const*>> GetTopOpcodes(std::size_t count) const;
+    [[nodiscard]] OpcodeStats const* GetStats(OpcodeClient opcode) const;
+
+private:
+    OpcodeStats* GetOrCreateStats(OpcodeClient opcode);
+
+    std::array<std::atomic<OpcodeStats*>, NUM_OPCODE_HANDLERS> _stats;
+    std::vector<std::unique_ptr<OpcodeStats>> _storage;
+    std::mutex _storageLock;
+};
+
+#define sOpcodeStatsMgr OpcodeStatsMgr::instance()
+
+#endif
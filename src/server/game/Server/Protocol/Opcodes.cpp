@@ -183,7 +183,7 @@ void OpcodeTable::Initialize()
     /*0x034*/ DEFINE_HANDLER(CMSG_AUTH_SRP6_PROOF,                                                  STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
     /*0x035*/ DEFINE_HANDLER(CMSG_AUTH_SRP6_RECODE,                                                 STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
     /*0x036*/ DEFINE_HANDLER(CMSG_CHAR_CREATE,                                                      STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleCharCreateOpcode                   );
-    /*0x037*/ DEFINE_HANDLER(CMSG_CHAR_ENUM,                                                        STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleCharEnumOpcode                     );
+    /*0x037*/ DEFINE_HANDLER(CMSG_CHAR_ENUM,                                                        STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleCharEnumOpcode                    );
     /*0x038*/ DEFINE_HANDLER(CMSG_CHAR_DELETE,                                                      STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleCharDeleteOpcode                   );
     /*0x039*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_AUTH_SRP6_RESPONSE,                                 STATUS_NEVER);
     /*0x03A*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_CHAR_CREATE,                                        STATUS_NEVER);
@@ -650,8 +650,8 @@ void OpcodeTable::Initialize()
     /*0x207*/ DEFINE_HANDLER(CMSG_GMTICKET_UPDATETEXT,                                              STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleGMTicketUpdateOpcode               );
     /*0x208*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_GMTICKET_UPDATETEXT,                                STATUS_NEVER);
     /*0x209*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_ACCOUNT_DATA_TIMES,                                 STATUS_NEVER);
-    /*0x20A*/ DEFINE_HANDLER(CMSG_REQUEST_ACCOUNT_DATA,                                             STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleRequestAccountData                 );
-    /*0x20B*/ DEFINE_HANDLER(CMSG_UPDATE_ACCOUNT_DATA,                                              STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleUpdateAccountData                  );
+    /*0x20A*/ DEFINE_HANDLER(CMSG_REQUEST_ACCOUNT_DATA,                                             STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleRequestAccountData                );
+    /*0x20B*/ DEFINE_HANDLER(CMSG_UPDATE_ACCOUNT_DATA,                                              STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleUpdateAccountData                 );
     /*0x20C*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_UPDATE_ACCOUNT_DATA,                                STATUS_NEVER);
     /*0x20D*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_CLEAR_FAR_SIGHT_IMMEDIATE,                          STATUS_NEVER);
     /*0x20E*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_CHANGEPLAYER_DIFFICULTY_RESULT,                     STATUS_NEVER);
@@ -871,7 +871,7 @@ void OpcodeTable::Initialize()
     /*0x2E4*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_AREA_SPIRIT_HEALER_TIME,                            STATUS_NEVER);
     /*0x2E5*/ DEFINE_HANDLER(CMSG_GM_UNTEACH,                                                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
     /*0x2E6*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_WARDEN_DATA,                                        STATUS_NEVER);
-    /*0x2E7*/ DEFINE_HANDLER(CMSG_WARDEN_DATA,                                                      STATUS_AUTHED,     PROCESS_THREADSAFE,     &WorldSession::HandleWardenDataOpcode                   );
+    /*0x2E7*/ DEFINE_HANDLER(CMSG_WARDEN_DATA,                                                      STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleWardenDataOpcode               );
     /*0x2E8*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_GROUP_JOINED_BATTLEGROUND,                          STATUS_NEVER);
     /*0x2E9*/ DEFINE_HANDLER(MSG_BATTLEGROUND_PLAYER_POSITIONS,                                     STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleBattlegroundPlayerPositionsOpcode  );
     /*0x2EA*/ DEFINE_HANDLER(CMSG_PET_STOP_ATTACK,                                                  STATUS_LOGGEDIN,   PROCESS_INPLACE,        &WorldSession::HandlePetStopAttack                      );
@@ -1036,7 +1036,7 @@ void OpcodeTable::Initialize()
     /*0x389*/ DEFINE_HANDLER(CMSG_SET_TAXI_BENCHMARK_MODE,                                          STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleSetTaxiBenchmarkOpcode             );
     /*0x38A*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_JOINED_BATTLEGROUND_QUEUE,                          STATUS_NEVER);
     /*0x38B*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_REALM_SPLIT,                                        STATUS_NEVER);
-    /*0x38C*/ DEFINE_HANDLER(CMSG_REALM_SPLIT,                                                      STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleRealmSplitOpcode                   );
+    /*0x38C*/ DEFINE_HANDLER(CMSG_REALM_SPLIT,                                                      STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleRealmSplitOpcode                  );
     /*0x38D*/ DEFINE_HANDLER(CMSG_MOVE_CHNG_TRANSPORT,                                              STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleMovementOpcodes                    );
     /*0x38E*/ DEFINE_HANDLER(MSG_PARTY_ASSIGNMENT,                                                  STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandlePartyAssignmentOpcode              );
     /*0x38F*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_OFFER_PETITION_ERROR,                               STATUS_NEVER);
@@ -1071,7 +1071,7 @@ void OpcodeTable::Initialize()
     /*0x3AC*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_DISMOUNT,                                           STATUS_NEVER);
     /*0x3AD*/ DEFINE_HANDLER(MSG_MOVE_UPDATE_CAN_FLY,                                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
     /*0x3AE*/ DEFINE_HANDLER(MSG_RAID_READY_CHECK_CONFIRM,                                          STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
-    /*0x3AF*/ DEFINE_HANDLER(CMSG_VOICE_SESSION_ENABLE,                                             STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleVoiceSessionEnableOpcode           );
+    /*0x3AF*/ DEFINE_HANDLER(CMSG_VOICE_SESSION_ENABLE,                                             STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleVoiceSessionEnableOpcode          );
     /*0x3B0*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_VOICE_SESSION_ENABLE,                               STATUS_NEVER);
     /*0x3B1*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_VOICE_PARENTAL_CONTROLS,                            STATUS_NEVER);
     /*0x3B2*/ DEFINE_HANDLER(CMSG_GM_WHISPER,                                                       STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
@@ -1107,7 +1107,7 @@ void OpcodeTable::Initialize()
     /*0x3D0*/ DEFINE_HANDLER(CMSG_TARGET_CAST,                                                      STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
     /*0x3D1*/ DEFINE_HANDLER(CMSG_TARGET_SCRIPT_CAST,                                               STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
     /*0x3D2*/ DEFINE_HANDLER(CMSG_CHANNEL_DISPLAY_LIST,                                             STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleChannelDisplayListQuery            );
-    /*0x3D3*/ DEFINE_HANDLER(CMSG_SET_ACTIVE_VOICE_CHANNEL,                                         STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleSetActiveVoiceChannel              );
+    /*0x3D3*/ DEFINE_HANDLER(CMSG_SET_ACTIVE_VOICE_CHANNEL,                                         STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleSetActiveVoiceChannel             );
     /*0x3D4*/ DEFINE_HANDLER(CMSG_GET_CHANNEL_MEMBER_COUNT,                                         STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleGetChannelMemberCount              );
     /*0x3D5*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_CHANNEL_MEMBER_COUNT,                               STATUS_NEVER);
     /*0x3D6*/ DEFINE_HANDLER(CMSG_CHANNEL_VOICE_ON,                                                 STATUS_LOGGEDIN,   PROCESS_THREADSAFE,     &WorldSession::HandleChannelVoiceOnOpcode               );
@@ -1407,7 +1407,7 @@ void OpcodeTable::Initialize()
     /*0x4FC*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_DEBUG_SERVER_GEO,                                   STATUS_NEVER);
     /*0x4FD*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_LOOT_SLOT_CHANGED,                                  STATUS_NEVER);
     /*0x4FE*/ DEFINE_HANDLER(UMSG_UPDATE_GROUP_INFO,                                                STATUS_NEVER,      PROCESS_INPLACE,        &WorldSession::Handle_NULL                              );
-    /*0x4FF*/ DEFINE_HANDLER(CMSG_READY_FOR_ACCOUNT_DATA_TIMES,                                     STATUS_AUTHED,     PROCESS_THREADUNSAFE,   &WorldSession::HandleReadyForAccountDataTimes           );
+    /*0x4FF*/ DEFINE_HANDLER(CMSG_READY_FOR_ACCOUNT_DATA_TIMES,                                     STATUS_AUTHED,     PROCESS_THREADSAFE_SESSION, &WorldSession::HandleReadyForAccountDataTimes          );
     /*0x500*/ DEFINE_HANDLER(CMSG_QUERY_QUESTS_COMPLETED,                                           STATUS_LOGGEDIN,   PROCESS_INPLACE,        &WorldSession::HandleQueryQuestsCompleted               );
     /*0x501*/ DEFINE_SERVER_OPCODE_HANDLER(SMSG_QUERY_QUESTS_COMPLETED_RESPONSE,                    STATUS_NEVER);
     /*0x502*/ DEFINE_HANDLER(CMSG_GM_REPORT_LAG,                                                    STATUS_LOGGEDIN,   PROCESS_THREADUNSAFE,   &WorldSession::HandleReportLag                          );
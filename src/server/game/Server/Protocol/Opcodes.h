@@ -1365,7 +1365,8 @@ enum PacketProcessing
 {
     PROCESS_INPLACE = 0,                                    //process packet whenever we receive it - mostly for non-handled or non-implemented packets
     PROCESS_THREADUNSAFE,                                   //packet is not thread-safe - process it in World::UpdateSessions()
-    PROCESS_THREADSAFE                                      //packet is thread-safe - process it in Map::Update()
+    PROCESS_THREADSAFE,                                     //packet is thread-safe - process it in Map::Update()
+    PROCESS_THREADSAFE_SESSION                              //packet only touches its own session - process it in World::UpdateSessions(), in parallel with other sessions
 };
 
 class WorldSession;
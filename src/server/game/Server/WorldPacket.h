@@ -69,7 +69,12 @@ public:
     void Initialize(uint16 opcode, size_t newres = 200)
     {
         clear();
-        _storage.reserve(newres);
+        if (_storage.capacity() < newres)
+        {
+            PacketBufferPool::Release(std::move(_storage));
+            _storage = PacketBufferPool::Acquire(newres);
+        }
+
         m_opcode = opcode;
     }
 
@@ -33,8 +33,10 @@
 #include "Log.h"
 #include "MapMgr.h"
 #include "Metric.h"
+#include "MetricRegistry.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "OpcodeStats.h"
 #include "Opcodes.h"
 #include "OutdoorPvPMgr.h"
 #include "PacketUtilities.h"
@@ -50,11 +52,46 @@
 #include "World.h"
 #include "WorldPacket.h"
 #include "WorldSocket.h"
+#include "ZoneProfiler.h"
+#include <bit>
 #include <zlib.h>
 
 namespace
 {
     std::string const DefaultPlayerName = "<none>";
+
+    /// A heartbeat only repeats the full movement info of its mover, the next heartbeat of the same mover replaces it
+    bool IsSupersededHeartbeat(WorldPacket const& packet, WorldPacket const& next)
+    {
+        if (packet.GetOpcode() != MSG_MOVE_HEARTBEAT || next.GetOpcode() != MSG_MOVE_HEARTBEAT)
+            return false;
+
+        if (packet.empty() || next.empty())
+            return false;
+
+        // both packets start with the packed guid of the mover: the mask byte followed by one byte per set bit
+        std::size_t const guidSize = 1 + std::popcount(packet.contents()[0]);
+        if (packet.size() < guidSize || next.size() < guidSize)
+            return false;
+
+        return std::equal(packet.contents(), packet.contents() + guidSize, next.contents());
+    }
+
+    /// Counter of the metric exporter, registered the first time the opcode is handled
+    Acore::Metrics::Counter& GetHandledPacketCounter(OpcodeClient opcode)
+    {
+        static std::array<std::atomic<Acore::Metrics::Counter*>, NUM_OPCODE_HANDLERS> counters{};
+
+        Acore::Metrics::Counter* counter = counters[opcode].load(std::memory_order_acquire);
+        if (!counter)
+        {
+            counter = &sMetricRegistry->GetCounter("worldsession_handled_packets_total", "Client packets handled by world sessions",
+                { { "opcode", opcodeTable[opcode]->Name } });
+            counters[opcode].store(counter, std::memory_order_release);
+        }
+
+        return *counter;
+    }
 }
 
 bool MapSessionFilter::Process(WorldPacket* packet)
@@ -66,7 +103,7 @@ bool MapSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //we do not process thread-unsafe packets
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE || opHandle->ProcessingPlace == PROCESS_THREADSAFE_SESSION)
         return false;
 
     Player* player = m_pSession->GetPlayer();
@@ -88,7 +125,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE || opHandle->ProcessingPlace == PROCESS_THREADSAFE_SESSION)
         return true;
 
     //no player attached? -> our client! ^^
@@ -100,6 +137,12 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return !player->IsInWorld();
 }
 
+//session-local packets, processed concurrently for many sessions before World::UpdateSessions() walks the sessions
+bool ParallelSessionFilter::Process(WorldPacket* packet)
+{
+    return opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())]->ProcessingPlace == PROCESS_THREADSAFE_SESSION;
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, std::string&& name, std::shared_ptr<WorldSocket> sock, AccountTypes sec, uint8 expansion,
     time_t mute_time, LocaleConstant locale, uint32 recruiter, bool isARecruiter, bool skipQueue, uint32 TotalTime) :
@@ -126,11 +169,13 @@ WorldSession::WorldSession(uint32 id, std::string&& name, std::shared_ptr<WorldS
     m_sessionDbcLocale(sWorld->GetDefaultDbcLocale()),
     m_sessionDbLocaleIndex(locale),
     m_latency(0),
+    _sentPacketBytes(0),
     m_TutorialsChanged(false),
     recruiterId(recruiter),
     isRecruiter(isARecruiter),
     m_currentVendorEntry(0),
     _calendarEventCreationCooldown(0),
+    _pendingLoginPlayer(nullptr),
     _addonMessageReceiveCount(0),
     _timeSyncClockDeltaQueue(6),
     _timeSyncClockDelta(0),
@@ -157,6 +202,13 @@ WorldSession::~WorldSession()
 {
     LoginDatabase.Execute("UPDATE account SET totaltime = {} WHERE id = {}", GetTotalTime(), GetAccountId());
 
+    ///- a character loaded for login but never added to its map is discarded like a failed load
+    if (Player* player = std::exchange(_pendingLoginPlayer, nullptr))
+    {
+        SetPlayer(nullptr);
+        delete player;
+    }
+
     ///- unload player if not unloaded
     if (_player)
         LogoutPlayer(true);
@@ -211,9 +263,28 @@ ObjectGuid::LowType WorldSession::GetGuidLow() const
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet)
 {
-    if (!m_Socket)
+    if (!m_Socket || !CanSendPacket(*packet))
         return;
 
+    m_Socket->SendPacket(*packet);
+}
+
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!m_Socket || !CanSendPacket(*packet))
+        return;
+
+    m_Socket->SendPacket(packet);
+}
+
+std::shared_ptr<WorldPacket const> WorldSession::MakeSharedPacket(WorldPacket const& packet)
+{
+    return WorldSocket::MakeSharedPacket(packet);
+}
+
+/// Network use statistics and script hooks, returns false if the packet must not be sent
+bool WorldSession::CanSendPacket(WorldPacket const& packet)
+{
 #if defined(ACORE_DEBUG)
     // Code for network use statistic
     static uint64 sendPacketCount = 0;
@@ -230,10 +301,10 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     if ((cur_time - lastTime) < 60)
     {
         sendPacketCount += 1;
-        sendPacketBytes += packet->size();
+        sendPacketBytes += packet.size();
 
         sendLastPacketCount += 1;
-        sendLastPacketBytes += packet->size();
+        sendLastPacketBytes += packet.size();
     }
     else
     {
@@ -246,16 +317,15 @@ void WorldSession::SendPacket(WorldPacket const* packet)
 
         lastTime = cur_time;
         sendLastPacketCount = 1;
-        sendLastPacketBytes = packet->wpos();               // wpos is real written size
+        sendLastPacketBytes = packet.wpos();               // wpos is real written size
     }
 #endif                                                      // !ACORE_DEBUG
 
-    if (!sScriptMgr->CanPacketSend(this, *packet))
-    {
-        return;
-    }
+    if (!sScriptMgr->CanPacketSend(this, packet))
+        return false;
 
-    m_Socket->SendPacket(*packet);
+    _sentPacketBytes.fetch_add(packet.size(), std::memory_order_relaxed);
+    return true;
 }
 
 /// Add an incoming packet to the queue
@@ -264,6 +334,11 @@ void WorldSession::QueuePacket(WorldPacket* new_packet)
     _recvQueue.add(new_packet);
 }
 
+void WorldSession::QueuePackets(std::vector<WorldPacket*> const& packets)
+{
+    _recvQueue.add(packets.begin(), packets.end());
+}
+
 /// Logging helper for unexpected opcodes
 void WorldSession::LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char* reason)
 {
@@ -297,6 +372,71 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     HandleTeleportTimeout(updater.ProcessUnsafe());
 
+    time_t currentTime = GameTime::GetGameTime().count();
+    uint32 processedPackets = ProcessPackets(updater, currentTime);
+
+    METRIC_VALUE("processed_packets", processedPackets);
+    METRIC_VALUE("addon_messages", _addonMessageReceiveCount.load());
+    if (m_Socket)
+        METRIC_VALUE("send_queue_bytes", uint64(m_Socket->GetWriteQueueSize()));
+    _addonMessageReceiveCount = 0;
+
+    if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
+    {
+        // Send time sync packet every 10s.
+        if (_timeSyncTimer > 0)
+        {
+            if (diff >= _timeSyncTimer)
+            {
+                SendTimeSync();
+            }
+            else
+            {
+                _timeSyncTimer -= diff;
+            }
+        }
+    }
+
+    // before the callbacks, a character loaded by them is added to its map in the next update
+    if (updater.ProcessUnsafe())
+        ProcessPendingPlayerLogin();
+
+    ProcessQueryCallbacks();
+
+    //check if we are safe to proceed with logout
+    //logout procedure should happen only in World::UpdateSessions() method!!!
+    if (updater.ProcessUnsafe())
+    {
+        if (m_Socket && m_Socket->IsOpen() && _warden)
+        {
+            _warden->Update(diff);
+        }
+
+        if (ShouldLogOut(currentTime) && !m_playerLoading)
+        {
+            LogoutPlayer(true);
+        }
+
+        if (m_Socket && !m_Socket->IsOpen())
+        {
+            if (GetPlayer() && _warden)
+                _warden->Update(diff);
+
+            m_Socket = nullptr;
+        }
+
+        if (!m_Socket)
+        {
+            return false;                                       //Will remove this session from the world session map
+        }
+    }
+
+    return true;
+}
+
+/// Handles the queued packets accepted by the filter, returns the number of processed packets
+uint32 WorldSession::ProcessPackets(PacketFilter& updater, time_t currentTime)
+{
     ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
     WorldPacket* packet = nullptr;
@@ -305,18 +445,54 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
     bool deletePacket = true;
     std::vector<WorldPacket*> requeuePackets;
     uint32 processedPackets = 0;
-    time_t currentTime = GameTime::GetGameTime().count();
 
     constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 150;
 
-    while (m_Socket && _recvQueue.next(packet, updater))
+    bool const trackOpcodeStats = sWorld->getBoolConfig(CONFIG_OPCODE_STATS);
+    bool const exportMetrics = sMetric->IsExporterEnabled();
+    bool const coalesceHeartbeats = sWorld->getBoolConfig(CONFIG_COALESCE_MOVEMENT_HEARTBEATS);
+
+    // packets are taken from the queue in batches, one lock per batch instead of per packet.
+    // the filter still decides packet by packet, a handler may change what the next packet is allowed to do
+    std::size_t batchIndex = 0;
+    while (m_Socket)
     {
+        if (batchIndex == _recvBatch.size())
+        {
+            _recvBatch.clear();
+            batchIndex = 0;
+            if (!_recvQueue.take(_recvBatch, MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE + 1 - processedPackets))
+                break;
+        }
+
+        packet = _recvBatch[batchIndex];
+        if (!updater.Process(packet))
+            break;
+
+        ++batchIndex;
+
+        // a client that stalls sends its heartbeats in bursts, only the last one of a mover moves it
+        if (coalesceHeartbeats && batchIndex < _recvBatch.size() && IsSupersededHeartbeat(*packet, *_recvBatch[batchIndex]))
+        {
+            delete packet;
+            continue;
+        }
+
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
 
         METRIC_DETAILED_TIMER("worldsession_update_opcode_time", METRIC_TAG("opcode", opHandle->Name));
+        PROFILE_ZONE(opHandle->Name);
         LOG_DEBUG("network", "message id {} ({}) under READ", opcode, opHandle->Name);
 
+        std::chrono::steady_clock::time_point handlerStart;
+        uint64 handlerSentBytes = 0;
+        if (trackOpcodeStats)
+        {
+            handlerStart = std::chrono::steady_clock::now();
+            handlerSentBytes = _sentPacketBytes.load(std::memory_order_relaxed);
+        }
+
         try
         {
             switch (opHandle->Status)
@@ -452,6 +628,14 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             }
         }
 
+        // requeued packets are accounted when they are actually handled
+        if (exportMetrics && deletePacket)
+            GetHandledPacketCounter(opcode).Increment();
+
+        if (trackOpcodeStats && deletePacket)
+            sOpcodeStatsMgr->Record(opcode, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - handlerStart).count(),
+                _sentPacketBytes.load(std::memory_order_relaxed) - handlerSentBytes);
+
         if (deletePacket)
             delete packet;
 
@@ -465,59 +649,23 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
             break;
     }
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    // packets of the batch that were not handled go back in front of the queue, behind the delayed ones
+    requeuePackets.insert(requeuePackets.end(), _recvBatch.begin() + batchIndex, _recvBatch.end());
+    _recvBatch.clear();
 
-    METRIC_VALUE("processed_packets", processedPackets);
-    METRIC_VALUE("addon_messages", _addonMessageReceiveCount.load());
-    _addonMessageReceiveCount = 0;
-
-    if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
-    {
-        // Send time sync packet every 10s.
-        if (_timeSyncTimer > 0)
-        {
-            if (diff >= _timeSyncTimer)
-            {
-                SendTimeSync();
-            }
-            else
-            {
-                _timeSyncTimer -= diff;
-            }
-        }
-    }
-
-    ProcessQueryCallbacks();
-
-    //check if we are safe to proceed with logout
-    //logout procedure should happen only in World::UpdateSessions() method!!!
-    if (updater.ProcessUnsafe())
-    {
-        if (m_Socket && m_Socket->IsOpen() && _warden)
-        {
-            _warden->Update(diff);
-        }
-
-        if (ShouldLogOut(currentTime) && !m_playerLoading)
-        {
-            LogoutPlayer(true);
-        }
-
-        if (m_Socket && !m_Socket->IsOpen())
-        {
-            if (GetPlayer() && _warden)
-                _warden->Update(diff);
+    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
 
-            m_Socket = nullptr;
-        }
+    return processedPackets;
+}
 
-        if (!m_Socket)
-        {
-            return false;                                       //Will remove this session from the world session map
-        }
-    }
+/// Handles packets that only touch this session, called concurrently for different sessions from World::UpdateSessions()
+void WorldSession::ProcessParallelPackets()
+{
+    ParallelSessionFilter updater(this);
+    ProcessPackets(updater, GameTime::GetGameTime().count());
 
-    return true;
+    if (_warden && m_Socket && m_Socket->IsOpen())
+        _warden->ProcessParallel();
 }
 
 bool WorldSession::HandleSocketClosed()
@@ -1294,6 +1442,8 @@ void WorldSession::SetPlayer(Player* player)
 
 void WorldSession::ProcessQueryCallbacks()
 {
+    PROFILE_ZONE("WorldSession::ProcessQueryCallbacks");
+
     _queryProcessor.ProcessReadyCallbacks();
     _transactionCallbacks.ProcessReadyCallbacks();
     _queryHolderProcessor.ProcessReadyCallbacks();
@@ -262,6 +262,18 @@ public:
     bool Process(WorldPacket* packet) override;
 };
 
+//class used to filter packets handled in parallel in World::UpdateSessions()
+//only packets which do not touch anything but their own session pass
+class ParallelSessionFilter : public PacketFilter
+{
+public:
+    explicit ParallelSessionFilter(WorldSession* pSession) : PacketFilter(pSession) {}
+    ~ParallelSessionFilter() override = default;
+
+    bool Process(WorldPacket* packet) override;
+    [[nodiscard]] bool ProcessUnsafe() const override { return false; }
+};
+
 // Proxy structure to contain data passed to callback function,
 // only to prevent bloating the parameter list
 class CharacterCreateInfo
@@ -346,6 +358,10 @@ public:
     void WriteMovementInfo(WorldPacket* data, MovementInfo* mi);
 
     void SendPacket(WorldPacket const* packet);
+    /// queues a packet shared with other sessions without copying it, see MakeSharedPacket()
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
+    /// copies (and compresses if the socket would) a packet once so it can be sent to many sessions
+    static std::shared_ptr<WorldPacket const> MakeSharedPacket(WorldPacket const& packet);
     void SendNotification(const char* format, ...) ATTR_PRINTF(2, 3);
     void SendNotification(uint32 string_id, ...);
     void SendPetNameInvalid(uint32 error, std::string const& name, DeclinedName* declinedName);
@@ -410,7 +426,10 @@ public:
     bool DisallowHyperlinksAndMaybeKick(std::string_view str);
 
     void QueuePacket(WorldPacket* new_packet);
+    /// adds every packet parsed from one socket read with a single lock of the receive queue
+    void QueuePackets(std::vector<WorldPacket*> const& packets);
     bool Update(uint32 diff, PacketFilter& updater);
+    void ProcessParallelPackets();
 
     /// Handle the authentication waiting queue (to be completed)
     void SendAuthWaitQueue(uint32 position);
@@ -545,7 +564,9 @@ public:                                                 // opcodes handlers
     void HandleCharCreateOpcode(WorldPacket& recvPacket);
     void HandlePlayerLoginOpcode(WorldPacket& recvPacket);
     void HandleCharEnum(PreparedQueryResult result);
-    void HandlePlayerLoginFromDB(LoginQueryHolder const& holder);
+    Player* HandlePlayerLoginFromDB(LoginQueryHolder const& holder);
+    void HandlePlayerLoginToWorld(Player* pCurrChar, LoginQueryHolder const& holder);
+    void ProcessPendingPlayerLogin();
     void HandlePlayerLoginToCharInWorld(Player* pCurrChar);
     void HandlePlayerLoginToCharOutOfWorld(Player* pCurrChar);
     void HandleCharFactionOrRaceChange(WorldPacket& recvData);
@@ -1088,6 +1109,8 @@ private:
     QueryCallbackProcessor _queryProcessor;
     AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
     AsyncCallbackProcessor<SQLQueryHolderCallback> _queryHolderProcessor;
+    std::shared_ptr<LoginQueryHolder> _pendingLoginHolder;  // loaded character waiting for its turn to enter the world
+    Player* _pendingLoginPlayer;                            // character of _pendingLoginHolder loaded by a previous update, not yet on its map
 
     friend class World;
 protected:
@@ -1130,6 +1153,8 @@ private:
     // logging helper
     void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char* reason);
     void LogUnprocessedTail(WorldPacket* packet);
+    uint32 ProcessPackets(PacketFilter& updater, time_t currentTime);
+    bool CanSendPacket(WorldPacket const& packet);
 
     // EnumData helpers
     bool IsLegitCharacterForAccount(ObjectGuid guid)
@@ -1167,6 +1192,7 @@ private:
     LocaleConstant m_sessionDbcLocale;
     LocaleConstant m_sessionDbLocaleIndex;
     std::atomic<uint32> m_latency;
+    std::atomic<uint64> _sentPacketBytes;               // total bytes sent, used to account packet handler output
     AccountData m_accountData[NUM_ACCOUNT_DATA_TYPES];
     uint32 m_Tutorials[MAX_ACCOUNT_TUTORIAL_VALUES];
     bool   m_TutorialsChanged;
@@ -1174,6 +1200,7 @@ private:
     uint32 recruiterId;
     bool isRecruiter;
     LockedQueue<WorldPacket*> _recvQueue;
+    std::vector<WorldPacket*> _recvBatch;   // packets taken from _recvQueue by ProcessPackets()
     uint32 m_currentVendorEntry;
     ObjectGuid m_currentBankerGUID;
     uint32 _offlineTime;
@@ -23,6 +23,7 @@
 #include "DatabaseEnv.h"
 #include "GameTime.h"
 #include "IPLocation.h"
+#include "Metric.h"
 #include "Opcodes.h"
 #include "PacketLog.h"
 #include "Random.h"
@@ -35,82 +36,112 @@
 
 using boost::asio::ip::tcp;
 
-void compressBuff(void* dst, uint32* dst_size, void* src, int src_size)
+namespace
 {
-    z_stream c_stream;
+    /// Deflate state of one thread, kept for the lifetime of the thread and reset for every packet
+    /// instead of allocating the zlib window and hash tables again
+    class PacketCompressor
+    {
+    public:
+        PacketCompressor() : _stream(), _level(0) { }
+        PacketCompressor(PacketCompressor const&) = delete;
+        PacketCompressor& operator=(PacketCompressor const&) = delete;
 
-    c_stream.zalloc = (alloc_func)0;
-    c_stream.zfree = (free_func)0;
-    c_stream.opaque = (voidpf)0;
+        ~PacketCompressor()
+        {
+            if (_level)
+                deflateEnd(&_stream);
+        }
 
-    // default Z_BEST_SPEED (1)
-    int z_res = deflateInit(&c_stream, sWorld->getIntConfig(CONFIG_COMPRESSION));
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+        /// returns the size of the compressed data in dst, 0 on failure
+        uint32 Compress(uint8* dst, uint32 dstSize, uint8 const* src, uint32 srcSize, int32 level)
+        {
+            if (!Prepare(level))
+                return 0;
 
-    c_stream.next_out = (Bytef*)dst;
-    c_stream.avail_out = *dst_size;
-    c_stream.next_in = (Bytef*)src;
-    c_stream.avail_in = (uInt)src_size;
+            _stream.next_out = dst;
+            _stream.avail_out = dstSize;
+            _stream.next_in = const_cast<Bytef*>(src);
+            _stream.avail_in = srcSize;
 
-    z_res = deflate(&c_stream, Z_NO_FLUSH);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+            // dst is sized with compressBound() so a single call consumes the whole input
+            int z_res = deflate(&_stream, Z_FINISH);
+            if (z_res != Z_STREAM_END)
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
+                Discard();
+                return 0;
+            }
 
-    if (c_stream.avail_in != 0)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate not greedy)");
-        *dst_size = 0;
-        return;
-    }
+            return _stream.total_out;
+        }
 
-    z_res = deflate(&c_stream, Z_FINISH);
-    if (z_res != Z_STREAM_END)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflate should report Z_STREAM_END instead {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+    private:
+        bool Prepare(int32 level)
+        {
+            if (_level == level)
+            {
+                int z_res = deflateReset(&_stream);
+                if (z_res == Z_OK)
+                    return true;
 
-    z_res = deflateEnd(&c_stream);
-    if (z_res != Z_OK)
-    {
-        LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateEnd) Error code: {} ({})", z_res, zError(z_res));
-        *dst_size = 0;
-        return;
-    }
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateReset) Error code: {} ({})", z_res, zError(z_res));
+            }
 
-    *dst_size = c_stream.total_out;
+            // first packet of the thread or the level was changed by a config reload
+            Discard();
+
+            int z_res = deflateInit(&_stream, level);
+            if (z_res != Z_OK)
+            {
+                LOG_ERROR("entities.object", "Can't compress update packet (zlib: deflateInit) Error code: {} ({})", z_res, zError(z_res));
+                return false;
+            }
+
+            _level = level;
+            return true;
+        }
+
+        void Discard()
+        {
+            if (!_level)
+                return;
+
+            deflateEnd(&_stream);
+            _stream = z_stream();
+            _level = 0;
+        }
+
+        z_stream _stream;
+        int32 _level;
+    };
+
+    thread_local PacketCompressor threadCompressor;
+}
+
+bool EncryptableAndCompressiblePacket::NeedsCompression(WorldPacket const& packet)
+{
+    return packet.GetOpcode() == SMSG_UPDATE_OBJECT && packet.size() > sWorld->getIntConfig(CONFIG_COMPRESSION_THRESHOLD);
 }
 
 void EncryptableAndCompressiblePacket::CompressIfNeeded()
 {
-    if (!NeedsCompression())
+    if (!NeedsCompression(*_packet))
         return;
 
-    uint32 pSize = size();
+    uint32 pSize = _packet->size();
 
     uint32 destsize = compressBound(pSize);
-    ByteBuffer buf(destsize + sizeof(uint32));
-    buf.resize(destsize + sizeof(uint32));
+    std::shared_ptr<WorldPacket> compressed = std::make_shared<WorldPacket>(SMSG_COMPRESSED_UPDATE_OBJECT, destsize + sizeof(uint32));
+    compressed->resize(destsize + sizeof(uint32));
 
-    buf.put<uint32>(0, pSize);
-    compressBuff(const_cast<uint8*>(buf.contents()) + sizeof(uint32), &destsize, (void*)contents(), pSize);
+    compressed->put<uint32>(0, pSize);
+    destsize = threadCompressor.Compress(compressed->contents() + sizeof(uint32), destsize, _packet->contents(), pSize, sWorld->getIntConfig(CONFIG_COMPRESSION));
     if (destsize == 0)
         return;
 
-    buf.resize(destsize + sizeof(uint32));
-
-    ByteBuffer::operator=(std::move(buf));
-    SetOpcode(SMSG_COMPRESSED_UPDATE_OBJECT);
+    compressed->resize(destsize + sizeof(uint32));
+    _packet = std::move(compressed);
 }
 
 WorldSocket::WorldSocket(tcp::socket&& socket)
@@ -163,17 +194,63 @@ bool WorldSocket::Update()
     EncryptableAndCompressiblePacket* queued;
     if (_bufferQueue.Dequeue(queued))
     {
+        // a client that does not read its data makes the write queue grow without limit
+        std::size_t const writeQueueSize = GetWriteQueueSize();
+        uint32 const hardLimit = sWorld->getIntConfig(CONFIG_SEND_QUEUE_HARD_LIMIT);
+        if (hardLimit && writeQueueSize > hardLimit)
+        {
+            LOG_INFO("network", "WorldSocket::Update: {} has {} bytes waiting to be sent, closing connection", GetRemoteIpAddress().to_string(), writeQueueSize);
+
+            do
+                delete queued;
+            while (_bufferQueue.Dequeue(queued));
+
+            CloseSocket();
+            return false;
+        }
+
+        uint32 const softLimit = sWorld->getIntConfig(CONFIG_SEND_QUEUE_SOFT_LIMIT);
+        bool const dropSuperseded = softLimit && writeQueueSize > softLimit;
+        uint32 droppedPackets = 0;
+
         // Allocate buffer only when it's needed but not on every Update() call.
         MessageBuffer buffer(_sendBufferSize);
         std::size_t currentPacketSize;
         do
         {
+            // dropped before encryption, the client never sees a gap in the header stream
+            if (dropSuperseded && IsDroppable(queued->GetPacket()))
+            {
+                ++droppedPackets;
+                delete queued;
+                continue;
+            }
+
             queued->CompressIfNeeded();
-            ServerPktHeader header(queued->size() + 2, queued->GetOpcode());
+            WorldPacket const& packet = queued->GetPacket();
+            ServerPktHeader header(packet.size() + 2, packet.GetOpcode());
             if (queued->NeedsEncryption())
                 _authCrypt.EncryptSend(header.header, header.getHeaderLength());
 
-            currentPacketSize = queued->size() + header.getHeaderLength();
+            // large payloads are written straight from the packet storage, only the header goes to the buffer
+            if (packet.size() >= ZERO_COPY_PAYLOAD_SIZE)
+            {
+                if (buffer.GetRemainingSpace() < header.getHeaderLength())
+                {
+                    QueuePacket(std::move(buffer));
+                    buffer.Resize(_sendBufferSize);
+                }
+
+                buffer.Write(header.header, header.getHeaderLength());
+                QueuePacket(std::move(buffer));
+                QueueSharedBuffer(queued->GetSharedPacket(), packet.contents(), packet.size());
+                buffer.Resize(_sendBufferSize);
+
+                delete queued;
+                continue;
+            }
+
+            currentPacketSize = packet.size() + header.getHeaderLength();
 
             if (buffer.GetRemainingSpace() < currentPacketSize)
             {
@@ -184,8 +261,8 @@ bool WorldSocket::Update()
             if (buffer.GetRemainingSpace() >= currentPacketSize)
             {
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
             else    // Single packet larger than current buffer size
             {
@@ -197,8 +274,8 @@ bool WorldSocket::Update()
                     _sendBufferSize = currentPacketSize;
 
                 buffer.Write(header.header, header.getHeaderLength());
-                if (!queued->empty())
-                    buffer.Write(queued->contents(), queued->size());
+                if (!packet.empty())
+                    buffer.Write(packet.contents(), packet.size());
             }
 
             delete queued;
@@ -206,6 +283,9 @@ bool WorldSocket::Update()
 
         if (buffer.GetActiveSize() > 0)
             QueuePacket(std::move(buffer));
+
+        if (droppedPackets)
+            METRIC_VALUE("send_queue_dropped_packets", droppedPackets);
     }
 
     if (!BaseSocket::Update())
@@ -216,6 +296,24 @@ bool WorldSocket::Update()
     return true;
 }
 
+bool WorldSocket::IsDroppable(WorldPacket const& packet)
+{
+    // only packets the client gets a newer copy of soon anyway
+    switch (packet.GetOpcode())
+    {
+        case MSG_MOVE_HEARTBEAT:
+        case SMSG_PERIODICAURALOG:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool WorldSocket::HasPendingUpdate() const
+{
+    return BaseSocket::HasPendingUpdate() || !_queryProcessor.Empty();
+}
+
 void WorldSocket::HandleSendAuthSession()
 {
     WorldPacket packet(SMSG_AUTH_CHALLENGE, 40);
@@ -260,6 +358,7 @@ void WorldSocket::ReadHandler()
             // We just received nice new header
             if (!ReadHeaderHandler())
             {
+                QueueReceivedPackets();
                 CloseSocket();
                 return;
             }
@@ -287,6 +386,8 @@ void WorldSocket::ReadHandler()
 
         if (result != ReadDataHandlerResult::Ok)
         {
+            QueueReceivedPackets();
+
             if (result != ReadDataHandlerResult::WaitingForQuery)
             {
                 CloseSocket();
@@ -296,9 +397,32 @@ void WorldSocket::ReadHandler()
         }
     }
 
+    QueueReceivedPackets();
     AsyncRead();
 }
 
+void WorldSocket::QueueReceivedPackets()
+{
+    if (_receivedPackets.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> sessionGuard(_worldSessionLock);
+        if (_worldSession)
+        {
+            _worldSession->QueuePackets(_receivedPackets);
+            _receivedPackets.clear();
+            return;
+        }
+    }
+
+    // the session was removed while the packets were parsed
+    for (WorldPacket* packet : _receivedPackets)
+        delete packet;
+
+    _receivedPackets.clear();
+}
+
 bool WorldSocket::ReadHeaderHandler()
 {
     ASSERT(_headerBuffer.GetActiveSize() == sizeof(ClientPktHeader));
@@ -485,8 +609,8 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
         _worldSession->ResetTimeOutTime(false);
     }
 
-    // Copy the packet to the heap before enqueuing
-    _worldSession->QueuePacket(packetToQueue);
+    // Copy the packet to the heap before enqueuing, queued with the rest of this read
+    _receivedPackets.push_back(packetToQueue);
 
     return ReadDataHandlerResult::Ok;
 }
@@ -518,7 +642,27 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
     if (sPacketLog->CanLogPacket())
         sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
 
-    _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(packet, _authCrypt.IsInitialized()));
+    _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(std::make_shared<WorldPacket>(packet), _authCrypt.IsInitialized()));
+    RequestUpdate();
+}
+
+std::shared_ptr<WorldPacket const> WorldSocket::MakeSharedPacket(WorldPacket const& packet)
+{
+    EncryptableAndCompressiblePacket shared(std::make_shared<WorldPacket>(packet), false);
+    shared.CompressIfNeeded();
+    return shared.GetSharedPacket();
+}
+
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort());
+
+    _bufferQueue.Enqueue(new EncryptableAndCompressiblePacket(std::move(packet), _authCrypt.IsInitialized()));
+    RequestUpdate();
 }
 
 void WorldSocket::HandleAuthSession(WorldPacket & recvPacket)
@@ -30,23 +30,29 @@
 
 using boost::asio::ip::tcp;
 
-class EncryptableAndCompressiblePacket : public WorldPacket
+/// Send queue entry, references the packet so large payloads can be written without copying them again
+class EncryptableAndCompressiblePacket
 {
 public:
-    EncryptableAndCompressiblePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptableAndCompressiblePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : _packet(std::move(packet)), _encrypt(encrypt)
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
     bool NeedsEncryption() const { return _encrypt; }
 
-    bool NeedsCompression() const { return GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
+    static bool NeedsCompression(WorldPacket const& packet);
 
+    /// replaces the referenced packet with a compressed copy, the original is left untouched for other sockets
     void CompressIfNeeded();
 
+    WorldPacket const& GetPacket() const { return *_packet; }
+    std::shared_ptr<WorldPacket const> const& GetSharedPacket() const { return _packet; }
+
     std::atomic<EncryptableAndCompressiblePacket*> SocketQueueLink;
 
 private:
+    std::shared_ptr<WorldPacket const> _packet;
     bool _encrypt;
 };
 
@@ -72,6 +78,9 @@ class AC_GAME_API WorldSocket : public Socket<WorldSocket>
 {
     typedef Socket<WorldSocket> BaseSocket;
 
+    /// payloads of at least this size are not copied into the send buffer but written from the packet itself
+    static constexpr std::size_t ZERO_COPY_PAYLOAD_SIZE = 1024;
+
 public:
     WorldSocket(tcp::socket&& socket);
     ~WorldSocket();
@@ -81,8 +90,14 @@ public:
 
     void Start() override;
     bool Update() override;
+    [[nodiscard]] bool HasPendingUpdate() const override;
 
     void SendPacket(WorldPacket const& packet);
+    /// queues the packet without copying it, it must not be modified afterwards
+    void SendPacket(std::shared_ptr<WorldPacket const> packet);
+
+    /// copy of the packet for the shared SendPacket(), compressed up front so sockets do not compress it each
+    static std::shared_ptr<WorldPacket const> MakeSharedPacket(WorldPacket const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -99,8 +114,13 @@ protected:
     };
 
     ReadDataHandlerResult ReadDataHandler();
+    /// hands the packets parsed by the current read to the session at once
+    void QueueReceivedPackets();
 
 private:
+    /// packets that may be left out while the client is behind on reading
+    static bool IsDroppable(WorldPacket const& packet);
+
     void CheckIpCallback(PreparedQueryResult result);
 
     /// writes network.opcode log
@@ -129,6 +149,7 @@ private:
 
     MessageBuffer _headerBuffer;
     MessageBuffer _packetBuffer;
+    std::vector<WorldPacket*> _receivedPackets;
     MPSCQueue<EncryptableAndCompressiblePacket, &EncryptableAndCompressiblePacket::SocketQueueLink> _bufferQueue;
     std::size_t _sendBufferSize;
 
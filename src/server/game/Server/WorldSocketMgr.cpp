@@ -38,7 +38,7 @@ public:
 };
 
 WorldSocketMgr::WorldSocketMgr() :
-    BaseSocketMgr(), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true)
+    BaseSocketMgr(), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true), _tcpQuickAck(false), _busyPollMicroseconds(0)
 {
 }
 
@@ -51,6 +51,17 @@ WorldSocketMgr& WorldSocketMgr::Instance()
 bool WorldSocketMgr::StartWorldNetwork(Acore::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount)
 {
     _tcpNoDelay = sConfigMgr->GetOption<bool>("Network.TcpNodelay", true);
+    _tcpQuickAck = sConfigMgr->GetOption<bool>("Network.TcpQuickAck", false);
+    _busyPollMicroseconds = sConfigMgr->GetOption<int32>("Network.BusyPoll", 0);
+    _acceptorPerThread = sConfigMgr->GetOption<bool>("Network.ReusePort", false);
+
+#ifndef SO_REUSEPORT
+    if (_acceptorPerThread)
+    {
+        LOG_ERROR("network", "Network.ReusePort is not supported on this platform, using a single acceptor");
+        _acceptorPerThread = false;
+    }
+#endif
 
     int const max_connections = ACORE_MAX_LISTEN_CONNECTIONS;
     LOG_DEBUG("network", "Max allowed socket connections {}", max_connections);
@@ -68,7 +79,7 @@ bool WorldSocketMgr::StartWorldNetwork(Acore::Asio::IoContext& ioContext, std::s
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
-    _acceptor->AsyncAcceptWithCallback<&WorldSocketMgr::OnSocketAccept>();
+    AsyncAcceptWithCallback<&WorldSocketMgr::OnSocketAccept>();
 
     sScriptMgr->OnNetworkStart();
     return true;
@@ -109,6 +120,27 @@ void WorldSocketMgr::OnSocketOpen(tcp::socket&& sock, uint32 threadIndex)
         }
     }
 
+#if AC_PLATFORM == AC_PLATFORM_UNIX
+    // Linux only options, failures just leave the kernel defaults in place
+    if (_tcpQuickAck)
+    {
+        boost::system::error_code err;
+        sock.set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP, TCP_QUICKACK>(true), err);
+
+        if (err)
+            LOG_DEBUG("network", "WorldSocketMgr::OnSocketOpen sock.set_option(TCP_QUICKACK) err = {}", err.message());
+    }
+
+    if (_busyPollMicroseconds > 0)
+    {
+        boost::system::error_code err;
+        sock.set_option(boost::asio::detail::socket_option::integer<SOL_SOCKET, SO_BUSY_POLL>(_busyPollMicroseconds), err);
+
+        if (err)
+            LOG_DEBUG("network", "WorldSocketMgr::OnSocketOpen sock.set_option(SO_BUSY_POLL) err = {}", err.message());
+    }
+#endif
+
     BaseSocketMgr::OnSocketOpen(std::forward<tcp::socket>(sock), threadIndex);
 }
 
@@ -59,6 +59,8 @@ private:
     int32 _socketSystemSendBufferSize;
     int32 _socketApplicationSendBufferSize;
     bool _tcpNoDelay;
+    bool _tcpQuickAck;
+    int32 _busyPollMicroseconds;
 };
 
 #define sWorldSocketMgr WorldSocketMgr::Instance()
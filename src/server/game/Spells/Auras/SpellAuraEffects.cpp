@@ -428,6 +428,25 @@ void AuraEffect::GetApplicationList(std::list<AuraApplication*>& applicationList
     }
 }
 
+void AuraEffect::InvalidateTargetModifierCaches() const
+{
+    for (auto const& [guid, aurApp] : GetBase()->GetApplicationMap())
+        aurApp->GetTarget()->_InvalidateAuraModifierCache(GetAuraType());
+}
+
+void AuraEffect::SetAmount(int32 amount)
+{
+    m_amount = amount;
+    m_canBeRecalculated = false;
+    InvalidateTargetModifierCaches();
+}
+
+void AuraEffect::SetEnabled(bool enabled)
+{
+    m_isAuraEnabled = enabled;
+    InvalidateTargetModifierCaches();
+}
+
 uint32 AuraEffect::GetId() const
 {
     return m_spellInfo->Id;
@@ -726,7 +745,10 @@ void AuraEffect::ChangeAmount(int32 newAmount, bool mark, bool onStackOrReapply)
     if (handleMask & AURA_EFFECT_HANDLE_CHANGE_AMOUNT)
     {
         if (!mark)
+        {
             m_amount = newAmount;
+            InvalidateTargetModifierCaches();
+        }
         else
             SetAmount(newAmount);
         CalculateSpellMod();
@@ -206,6 +206,7 @@ public:
 
     // AuraScript
     void LoadScripts();
+    [[nodiscard]] bool HasScriptHook(uint8 hookType) const { return (m_scriptHookMask & (1 << hookType)) != 0; }
     bool CallScriptCheckAreaTargetHandlers(Unit* target);
     void CallScriptDispel(DispelInfo* dispelInfo);
     void CallScriptAfterDispel(DispelInfo* dispelInfo);
@@ -273,6 +274,7 @@ private:
     Unit::AuraApplicationList m_removedApplications;
 
     SpellInfo const* m_triggeredByAuraSpellInfo;
+    uint32 m_scriptHookMask;                            // mask of (1 << AuraScriptHookType) the scripts of the aura register
 };
 
 class UnitAura : public Aura
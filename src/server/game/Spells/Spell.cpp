@@ -54,6 +54,7 @@
 #include "Vehicle.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include "ZoneProfiler.h"
 
 /// @todo: this import is not necessary for compilation and marked as unused by the IDE
 //  however, for some reasons removing it would cause a damn linking issue
@@ -520,6 +521,9 @@ class SpellEvent : public BasicEvent
         SpellEvent(Spell* spell);
         ~SpellEvent();
 
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr, std::size_t size);
+
         bool Execute(uint64 e_time, uint32 p_time);
         void Abort(uint64 e_time);
         bool IsDeletable() const;
@@ -652,6 +656,8 @@ Spell::Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags,
     m_preCastSpell = 0;
     m_spellAura = nullptr;
     _scriptsLoaded = false;
+    _scriptHookMask = 0;
+    _scriptEffectHandleModes.fill(0);
 
     //Auto Shot & Shoot (wand)
     m_autoRepeat = m_spellInfo->IsAutoRepeatRangedSpell();
@@ -1223,8 +1229,7 @@ void Spell::SelectImplicitConeTargets(SpellEffIndex effIndex, SpellImplicitTarge
     if (uint32 containerTypeMask = GetSearcherTypeMask(objectType, condList))
     {
         Acore::WorldObjectSpellConeTargetCheck check(coneAngle, radius, m_caster, m_spellInfo, selectionType, condList);
-        Acore::WorldObjectListSearcher<Acore::WorldObjectSpellConeTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-        SearchTargets<Acore::WorldObjectListSearcher<Acore::WorldObjectSpellConeTargetCheck> >(searcher, containerTypeMask, m_caster, m_caster, radius);
+        SearchAreaTargetCandidates(targets, check, containerTypeMask, m_caster, radius);
 
         CallScriptObjectAreaTargetSelectHandlers(targets, effIndex, targetType);
 
@@ -1272,7 +1277,7 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
         case TARGET_REFERENCE_TYPE_LAST:
             {
                 // find last added target for this effect
-                for (std::list<TargetInfo>::reverse_iterator ihit = m_UniqueTargetInfo.rbegin(); ihit != m_UniqueTargetInfo.rend(); ++ihit)
+                for (TargetInfoList::reverse_iterator ihit = m_UniqueTargetInfo.rbegin(); ihit != m_UniqueTargetInfo.rend(); ++ihit)
                 {
                     if (ihit->effectMask & (1 << effIndex))
                     {
@@ -1328,6 +1333,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             Acore::Containers::RandomResize(targets, maxTargets);
         }
 
+        PrecomputeAreaTargetsLOS(targets);
+
         for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
         {
             if (Unit* unitTarget = (*itr)->ToUnit())
@@ -1335,6 +1342,8 @@ void Spell::SelectImplicitAreaTargets(SpellEffIndex effIndex, SpellImplicitTarge
             else if (GameObject* gObjTarget = (*itr)->ToGameObject())
                 AddGOTarget(gObjTarget, effMask);
         }
+
+        m_areaTargetsLOS.clear();
     }
 }
 
@@ -2169,6 +2178,20 @@ void Spell::SearchTargets(SEARCHER& searcher, uint32 containerMask, Unit* refere
     }
 }
 
+template<class CHECK>
+void Spell::SearchAreaTargetCandidates(std::list<WorldObject*>& targets, CHECK& check, uint32 containerMask, Position const* pos, float radius)
+{
+    Acore::WorldObjectCandidates candidates;
+    Acore::WorldObjectCandidateGatherer gatherer(candidates, containerMask);
+    SearchTargets<Acore::WorldObjectCandidateGatherer>(gatherer, containerMask, m_caster, pos, radius);
+
+    std::vector<uint8> inRange;
+    candidates.FilterInRange(pos, radius, inRange);
+    for (std::size_t i = 0; i < candidates.Objects.size(); ++i)
+        if (inRange[i] && check(candidates.Objects[i]))
+            targets.push_back(candidates.Objects[i]);
+}
+
 WorldObject* Spell::SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList)
 {
     WorldObject* target = nullptr;
@@ -2187,8 +2210,7 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, float range, Pos
     if (!containerTypeMask)
         return;
     Acore::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList);
-    Acore::WorldObjectListSearcher<Acore::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
-    SearchTargets<Acore::WorldObjectListSearcher<Acore::WorldObjectSpellAreaTargetCheck> > (searcher, containerTypeMask, m_caster, position, range);
+    SearchAreaTargetCandidates(targets, check, containerTypeMask, position, range);
 }
 
 void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectType, SpellTargetSelectionCategories  /*selectCategory*/, ConditionList* condList, bool isChainHeal)
@@ -2401,7 +2423,7 @@ void Spell::AddUnitTarget(Unit* target, uint32 effectMask, bool checkIfValid /*=
     ObjectGuid targetGUID = target->GetGUID();
 
     // Lookup target in already in list
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (targetGUID == ihit->targetGUID)             // Found in list
         {
@@ -2537,7 +2559,7 @@ void Spell::AddGOTarget(GameObject* go, uint32 effectMask)
     ObjectGuid targetGUID = go->GetGUID();
 
     // Lookup target in already in list
-    for (std::list<GOTargetInfo>::iterator ihit = m_UniqueGOTargetInfo.begin(); ihit != m_UniqueGOTargetInfo.end(); ++ihit)
+    for (GOTargetInfoList::iterator ihit = m_UniqueGOTargetInfo.begin(); ihit != m_UniqueGOTargetInfo.end(); ++ihit)
     {
         if (targetGUID == ihit->targetGUID)                 // Found in list
         {
@@ -2582,7 +2604,7 @@ void Spell::AddItemTarget(Item* item, uint32 effectMask)
         return;
 
     // Lookup target in already in list
-    for (std::list<ItemTargetInfo>::iterator ihit = m_UniqueItemInfo.begin(); ihit != m_UniqueItemInfo.end(); ++ihit)
+    for (ItemTargetInfoList::iterator ihit = m_UniqueItemInfo.begin(); ihit != m_UniqueItemInfo.end(); ++ihit)
     {
         if (item == ihit->item)                            // Found in list
         {
@@ -3406,7 +3428,7 @@ bool Spell::UpdateChanneledTargetList()
         range += std::min(3.0f, range * 0.1f); // 10% but no more than 3yd
     }
 
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (ihit->missCondition == SPELL_MISS_NONE && (channelTargetEffectMask & ihit->effectMask))
         {
@@ -3446,7 +3468,7 @@ bool Spell::UpdateChanneledTargetList()
     // Xinef: not all effects are covered, remove applications from all targets
     if (channelTargetEffectMask != 0)
     {
-        for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+        for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
             if (ihit->missCondition == SPELL_MISS_NONE && (channelAuraMask & ihit->effectMask))
                 if (Unit* unit = m_caster->GetGUID() == ihit->targetGUID ? m_caster : ObjectAccessor::GetUnit(*m_caster, ihit->targetGUID))
                     if (IsValidDeadOrAliveTarget(unit))
@@ -3733,7 +3755,7 @@ void Spell::cancel(bool bySelf)
         case SPELL_STATE_CASTING:
             if (!bySelf)
             {
-                for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                     if ((*ihit).missCondition == SPELL_MISS_NONE)
                         if (Unit* unit = m_caster->GetGUID() == ihit->targetGUID ? m_caster : ObjectAccessor::GetUnit(*m_caster, ihit->targetGUID))
                             unit->RemoveOwnedAura(m_spellInfo->Id, m_originalCasterGUID, 0, AURA_REMOVE_BY_CANCEL);
@@ -3975,7 +3997,7 @@ void Spell::_cast(bool skipCheck)
 
         uint32 procEx = PROC_EX_NORMAL_HIT;
 
-        for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+        for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
         {
             if (ihit->missCondition != SPELL_MISS_NONE)
             {
@@ -4133,10 +4155,10 @@ void Spell::handle_immediate()
     // process immediate effects (items, ground, etc.) also initialize some variables
     _handle_immediate_phase();
 
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
         DoAllEffectOnTarget(&(*ihit));
 
-    for (std::list<GOTargetInfo>::iterator ihit = m_UniqueGOTargetInfo.begin(); ihit != m_UniqueGOTargetInfo.end(); ++ihit)
+    for (GOTargetInfoList::iterator ihit = m_UniqueGOTargetInfo.begin(); ihit != m_UniqueGOTargetInfo.end(); ++ihit)
         DoAllEffectOnTarget(&(*ihit));
 
     FinishTargetProcessing();
@@ -4183,7 +4205,7 @@ uint64 Spell::handle_delayed(uint64 t_offset)
     bool single_missile = (m_targets.HasDst());
 
     // now recheck units targeting correctness (need before any effects apply to prevent adding immunity at first effect not allow apply second spell effect and similar cases)
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if (ihit->processed == false)
         {
@@ -4198,7 +4220,7 @@ uint64 Spell::handle_delayed(uint64 t_offset)
     }
 
     // now recheck gameobject targeting correctness
-    for (std::list<GOTargetInfo>::iterator ighit = m_UniqueGOTargetInfo.begin(); ighit != m_UniqueGOTargetInfo.end(); ++ighit)
+    for (GOTargetInfoList::iterator ighit = m_UniqueGOTargetInfo.begin(); ighit != m_UniqueGOTargetInfo.end(); ++ighit)
     {
         if (ighit->processed == false)
         {
@@ -4256,7 +4278,7 @@ void Spell::_handle_immediate_phase()
     }
 
     // process items
-    for (std::list<ItemTargetInfo>::iterator ihit = m_UniqueItemInfo.begin(); ihit != m_UniqueItemInfo.end(); ++ihit)
+    for (ItemTargetInfoList::iterator ihit = m_UniqueItemInfo.begin(); ihit != m_UniqueItemInfo.end(); ++ihit)
         DoAllEffectOnTarget(&(*ihit));
 }
 
@@ -4288,7 +4310,7 @@ void Spell::_handle_finish_phase()
 
     if (!IsAutoRepeat() && !IsNextMeleeSwingSpell())
         if (m_caster->GetCharmerOrOwnerPlayerOrPlayerItself())
-            for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+            for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
             {
                 // Xinef: Properly clear infinite cooldowns in some cases
                 if (ihit->targetGUID == m_caster->GetGUID() && ihit->missCondition != SPELL_MISS_NONE)
@@ -4314,7 +4336,7 @@ void Spell::_handle_finish_phase()
         }
 
         uint32 procEx = PROC_EX_NORMAL_HIT;
-        for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+        for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
         {
             if (ihit->missCondition != SPELL_MISS_NONE)
             {
@@ -4379,6 +4401,8 @@ void Spell::SendSpellCooldown()
 
 void Spell::update(uint32 difftime)
 {
+    PROFILE_ZONE("Spell::update");
+
     // update pointers based at it's GUIDs
     if (!UpdatePointers())
     {
@@ -4988,7 +5012,7 @@ void Spell::WriteSpellGoTargets(WorldPacket* data)
 {
     // This function also fill data for channeled spells:
     // m_needAliveTargetMask req for stop channelig if one target die
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         if ((*ihit).effectMask == 0)                  // No effect apply - all immuned add state
             // possibly SPELL_MISS_IMMUNE2 for this??
@@ -5004,7 +5028,7 @@ void Spell::WriteSpellGoTargets(WorldPacket* data)
     uint32 hit = 0;
     size_t hitPos = data->wpos();
     *data << (uint8)0; // placeholder
-    for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end() && hit < 255; ++ihit)
+    for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end() && hit < 255; ++ihit)
     {
         if ((*ihit).missCondition == SPELL_MISS_NONE)       // Add only hits
         {
@@ -5015,7 +5039,7 @@ void Spell::WriteSpellGoTargets(WorldPacket* data)
         }
     }
 
-    for (std::list<GOTargetInfo>::const_iterator ighit = m_UniqueGOTargetInfo.begin(); ighit != m_UniqueGOTargetInfo.end() && hit < 255; ++ighit)
+    for (GOTargetInfoList::const_iterator ighit = m_UniqueGOTargetInfo.begin(); ighit != m_UniqueGOTargetInfo.end() && hit < 255; ++ighit)
     {
         *data << ighit->targetGUID;                 // Always hits
         ++hit;
@@ -5024,7 +5048,7 @@ void Spell::WriteSpellGoTargets(WorldPacket* data)
     uint32 miss = 0;
     size_t missPos = data->wpos();
     *data << (uint8)0; // placeholder
-    for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end() && miss < 255; ++ihit)
+    for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end() && miss < 255; ++ihit)
     {
         if (ihit->missCondition != SPELL_MISS_NONE)        // Add only miss
         {
@@ -5302,7 +5326,7 @@ void Spell::TakePower()
     {
         if (PowerType == POWER_RAGE || PowerType == POWER_ENERGY || PowerType == POWER_RUNE || PowerType == POWER_RUNIC_POWER)
             if (ObjectGuid targetGUID = m_targets.GetUnitTargetGUID())
-                for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                     if (ihit->targetGUID == targetGUID)
                     {
                         if (ihit->missCondition != SPELL_MISS_NONE && ihit->missCondition != SPELL_MISS_BLOCK && ihit->missCondition != SPELL_MISS_ABSORB && ihit->missCondition != SPELL_MISS_REFLECT)
@@ -5577,7 +5601,7 @@ void Spell::HandleThreatSpells()
     // since 2.0.1 threat from positive effects also is distributed among all targets, so the overall caused threat is at most the defined bonus
     threat /= m_UniqueTargetInfo.size();
 
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         float threatToAdd = threat;
         if (ihit->missCondition != SPELL_MISS_NONE)
@@ -5606,6 +5630,11 @@ void Spell::HandleEffects(Unit* pUnitTarget, Item* pItemTarget, GameObject* pGOT
     gameObjTarget = pGOTarget;
     destTarget = &m_destTargets[i]._position;
 
+    // neither the effect handler nor a script does anything in this mode
+    uint8 modeMask = 1 << mode;
+    if (!((m_spellInfo->GetEffectHandleModes(i) | _scriptEffectHandleModes[i]) & modeMask))
+        return;
+
     uint8 eff = m_spellInfo->Effects[i].Effect;
 
     LOG_DEBUG("spells.aura", "Spell: {} Effect : {}", m_spellInfo->Id, eff);
@@ -5821,7 +5850,7 @@ SpellCastResult Spell::CheckCast(bool strict)
     {
         ConditionSourceInfo condInfo = ConditionSourceInfo(m_caster);
         condInfo.mConditionTargets[1] = m_targets.GetObjectTarget();
-        ConditionList conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL, m_spellInfo->Id);
+        ConditionList const& conditions = sConditionMgr->GetConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_SPELL, m_spellInfo->Id);
         if (!conditions.empty() && !sConditionMgr->IsObjectMeetToConditions(condInfo, conditions))
         {
             // mLastFailedCondition can be nullptr if there was an error processing the condition in Condition::Meets (i.e. wrong data for ConditionTarget or others)
@@ -7003,7 +7032,7 @@ bool Spell::CanAutoCast(Unit* target)
     {
         SelectSpellTargets();
         //check if among target units, our WANTED target is as well (->only self cast spells return false)
-        for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+        for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
             if (ihit->targetGUID == targetguid)
                 return true;
     }
@@ -7806,7 +7835,7 @@ void Spell::DelayedChannel()
 
     LOG_DEBUG("spells.aura", "Spell {} partially interrupted for {} ms, new duration: {} ms", m_spellInfo->Id, delaytime, m_timer);
 
-    for (std::list<TargetInfo>::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::const_iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
         if ((*ihit).missCondition == SPELL_MISS_NONE)
             if (Unit* unit = (m_caster->GetGUID() == ihit->targetGUID) ? m_caster : ObjectAccessor::GetUnit(*m_caster, ihit->targetGUID))
                 unit->DelayOwnedAuras(m_spellInfo->Id, m_originalCasterGUID, delaytime);
@@ -7973,33 +8002,22 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
         default: // normal case
         {
             uint32 losChecks = LINEOFSIGHT_ALL_CHECKS;
-            GameObject* gobCaster = nullptr;
-            if (m_originalCasterGUID.IsGameObject())
-            {
-                gobCaster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
-            }
-            else if (m_caster->GetEntry() == WORLD_TRIGGER)
+            if (!GetLOSChecks(losChecks))
             {
-                if (TempSummon* tempSummon = m_caster->ToTempSummon())
-                {
-                    gobCaster = tempSummon->GetSummonerGameObject();
-                }
+                return true;
             }
 
-            if (gobCaster)
+            if (target != m_caster)
             {
-                if (gobCaster->GetGOInfo()->IsIgnoringLOSChecks())
+                auto itr = m_areaTargetsLOS.find(target->GetGUID());
+                if (itr != m_areaTargetsLOS.end())
                 {
-                    return true;
+                    if (!itr->second)
+                    {
+                        return false;
+                    }
                 }
-
-                // If spell casted by gameobject then ignore M2 models
-                losChecks &= ~LINEOFSIGHT_CHECK_GOBJECT_M2;
-            }
-
-            if (target != m_caster)
-            {
-                if (m_targets.HasDst())
+                else if (m_targets.HasDst())
                 {
                     float x = m_targets.GetDstPos()->GetPositionX();
                     float y = m_targets.GetDstPos()->GetPositionY();
@@ -8022,6 +8040,103 @@ bool Spell::CheckEffectTarget(Unit const* target, uint32 eff) const
     return true;
 }
 
+/// Returns false if the spell was cast by a gameobject that ignores line of sight
+bool Spell::GetLOSChecks(uint32& losChecks) const
+{
+    losChecks = LINEOFSIGHT_ALL_CHECKS;
+    GameObject* gobCaster = nullptr;
+    if (m_originalCasterGUID.IsGameObject())
+    {
+        gobCaster = m_caster->GetMap()->GetGameObject(m_originalCasterGUID);
+    }
+    else if (m_caster->GetEntry() == WORLD_TRIGGER)
+    {
+        if (TempSummon* tempSummon = m_caster->ToTempSummon())
+        {
+            gobCaster = tempSummon->GetSummonerGameObject();
+        }
+    }
+
+    if (gobCaster)
+    {
+        if (gobCaster->GetGOInfo()->IsIgnoringLOSChecks())
+        {
+            return false;
+        }
+
+        // If spell casted by gameobject then ignore M2 models
+        losChecks &= ~LINEOFSIGHT_CHECK_GOBJECT_M2;
+    }
+
+    return true;
+}
+
+/// Checks the line of sight of all area targets in one batched query, CheckEffectTarget uses the results instead of tracing each target alone.
+/// Targets the batch can't represent exactly (other phase masks, other maps) are left to the per target check.
+void Spell::PrecomputeAreaTargetsLOS(std::list<WorldObject*> const& targets)
+{
+    m_areaTargetsLOS.clear();
+    if (targets.size() < 2 || m_spellInfo->HasAttribute(SPELL_ATTR2_IGNORE_LINE_OF_SIGHT))
+    {
+        return;
+    }
+
+    uint32 losChecks = LINEOFSIGHT_ALL_CHECKS;
+    if (!GetLOSChecks(losChecks))
+    {
+        return;
+    }
+
+    Position const* dst = m_targets.HasDst() ? m_targets.GetDstPos() : nullptr;
+    std::vector<VMAP::LineOfSightQuery> queries;
+    std::vector<ObjectGuid> guids;
+    queries.reserve(targets.size());
+    guids.reserve(targets.size());
+    for (WorldObject* target : targets)
+    {
+        Unit* unit = target->ToUnit();
+        if (!unit || unit == m_caster)
+        {
+            continue;
+        }
+
+        VMAP::LineOfSightQuery query;
+        if (dst)
+        {
+            // the dest check traces from the target with its own phase mask
+            if (!unit->IsInWorld() || unit->GetPhaseMask() != m_caster->GetPhaseMask())
+            {
+                continue;
+            }
+
+            unit->GetLineOfSightSegment(dst->GetPositionX(), dst->GetPositionY(), dst->GetPositionZ(), query);
+        }
+        else
+        {
+            if (!m_caster->IsInMap(unit))
+            {
+                continue;
+            }
+
+            m_caster->GetLineOfSightSegment(unit, query);
+        }
+
+        queries.push_back(query);
+        guids.push_back(unit->GetGUID());
+    }
+
+    if (queries.size() < 2)
+    {
+        return;
+    }
+
+    m_caster->GetMap()->isInLineOfSight(queries, m_caster->GetPhaseMask(), LineOfSightChecks(losChecks), VMAP::ModelIgnoreFlags::M2);
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        m_areaTargetsLOS[guids[i]] = queries[i].InSight;
+    }
+}
+
 bool Spell::IsNextMeleeSwingSpell() const
 {
     return m_spellInfo->HasAttribute(SPELL_ATTR0_ON_NEXT_SWING_NO_DAMAGE);
@@ -8057,21 +8172,70 @@ bool Spell::IsNeedSendToClient(bool go) const
 
 bool Spell::HaveTargetsForEffect(uint8 effect) const
 {
-    for (std::list<TargetInfo>::const_iterator itr = m_UniqueTargetInfo.begin(); itr != m_UniqueTargetInfo.end(); ++itr)
+    for (TargetInfoList::const_iterator itr = m_UniqueTargetInfo.begin(); itr != m_UniqueTargetInfo.end(); ++itr)
         if (itr->effectMask & (1 << effect))
             return true;
 
-    for (std::list<GOTargetInfo>::const_iterator itr = m_UniqueGOTargetInfo.begin(); itr != m_UniqueGOTargetInfo.end(); ++itr)
+    for (GOTargetInfoList::const_iterator itr = m_UniqueGOTargetInfo.begin(); itr != m_UniqueGOTargetInfo.end(); ++itr)
         if (itr->effectMask & (1 << effect))
             return true;
 
-    for (std::list<ItemTargetInfo>::const_iterator itr = m_UniqueItemInfo.begin(); itr != m_UniqueItemInfo.end(); ++itr)
+    for (ItemTargetInfoList::const_iterator itr = m_UniqueItemInfo.begin(); itr != m_UniqueItemInfo.end(); ++itr)
         if (itr->effectMask & (1 << effect))
             return true;
 
     return false;
 }
 
+// Spell objects are a few kilobytes, so their chunks are kept small
+typedef Acore::Impl::NodePool<sizeof(Spell), 16> SpellPool;
+typedef Acore::Impl::NodePool<sizeof(SpellEvent)> SpellEventPool;
+static std::atomic<uint64> SpellPoolAllocations{0};
+
+void* Spell::operator new(std::size_t size)
+{
+    ++SpellPoolAllocations;
+    if (size != sizeof(Spell))
+        return ::operator new(size);
+
+    return SpellPool::Allocate();
+}
+
+void Spell::operator delete(void* ptr, std::size_t size)
+{
+    if (size != sizeof(Spell))
+        ::operator delete(ptr);
+    else
+        SpellPool::Deallocate(ptr);
+}
+
+uint64 Spell::TakePoolAllocationCount()
+{
+    return SpellPoolAllocations.exchange(0);
+}
+
+std::size_t Spell::GetPoolReservedBytes()
+{
+    return SpellPool::ReservedBytes() + SpellEventPool::ReservedBytes();
+}
+
+void* SpellEvent::operator new(std::size_t size)
+{
+    ++SpellPoolAllocations;
+    if (size != sizeof(SpellEvent))
+        return ::operator new(size);
+
+    return SpellEventPool::Allocate();
+}
+
+void SpellEvent::operator delete(void* ptr, std::size_t size)
+{
+    if (size != sizeof(SpellEvent))
+        ::operator delete(ptr);
+    else
+        SpellEventPool::Deallocate(ptr);
+}
+
 SpellEvent::SpellEvent(Spell* spell) : BasicEvent()
 {
     m_Spell = spell;
@@ -8212,7 +8376,7 @@ void Spell::HandleLaunchPhase()
 
     PrepareTargetProcessing();
 
-    for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+    for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
     {
         TargetInfo& target = *ihit;
 
@@ -8455,6 +8619,12 @@ void Spell::LoadScripts()
     if (_scriptsLoaded)
         return;
     _scriptsLoaded = true;
+
+    // unscripted spells and spells scripted through their aura only have nothing to create for the cast
+    _scriptHookMask = sObjectMgr->GetSpellScriptHookMasks(m_spellInfo->Id).SpellHooks;
+    if (!_scriptHookMask)
+        return;
+
     sScriptMgr->CreateSpellScripts(m_spellInfo->Id, m_loadedScripts);
     for (std::list<SpellScript*>::iterator itr = m_loadedScripts.begin(); itr != m_loadedScripts.end();)
     {
@@ -8468,12 +8638,27 @@ void Spell::LoadScripts()
         }
         LOG_DEBUG("spells.aura", "Spell::LoadScripts: Script `{}` for spell `{}` is loaded now", (*itr)->_GetScriptName()->c_str(), m_spellInfo->Id);
         (*itr)->Register();
+
+        auto addHandleModes = [this](HookList<SpellScript::EffectHandler>& hooks, SpellEffectHandleModeMask mode)
+        {
+            for (SpellScript::EffectHandler& hook : hooks)
+                for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+                    if (hook.IsEffectAffected(m_spellInfo, i))
+                        _scriptEffectHandleModes[i] |= mode;
+        };
+        addHandleModes((*itr)->OnEffectLaunch, SPELL_EFFECT_HANDLE_MASK_LAUNCH);
+        addHandleModes((*itr)->OnEffectLaunchTarget, SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET);
+        addHandleModes((*itr)->OnEffectHit, SPELL_EFFECT_HANDLE_MASK_HIT);
+        addHandleModes((*itr)->OnEffectHitTarget, SPELL_EFFECT_HANDLE_MASK_HIT_TARGET);
         ++itr;
     }
 }
 
 void Spell::CallScriptBeforeCastHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_BEFORE_CAST))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_BEFORE_CAST);
@@ -8487,6 +8672,9 @@ void Spell::CallScriptBeforeCastHandlers()
 
 void Spell::CallScriptOnCastHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_ON_CAST))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_ON_CAST);
@@ -8500,6 +8688,9 @@ void Spell::CallScriptOnCastHandlers()
 
 void Spell::CallScriptAfterCastHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_AFTER_CAST))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_AFTER_CAST);
@@ -8514,6 +8705,9 @@ void Spell::CallScriptAfterCastHandlers()
 SpellCastResult Spell::CallScriptCheckCastHandlers()
 {
     SpellCastResult retVal = SPELL_CAST_OK;
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_CHECK_CAST))
+        return retVal;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_CHECK_CAST);
@@ -8586,6 +8780,9 @@ bool Spell::CallScriptEffectHandlers(SpellEffIndex effIndex, SpellEffectHandleMo
 
 void Spell::CallScriptBeforeHitHandlers(SpellMissInfo missInfo)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_BEFORE_HIT))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_BEFORE_HIT);
@@ -8599,6 +8796,9 @@ void Spell::CallScriptBeforeHitHandlers(SpellMissInfo missInfo)
 
 void Spell::CallScriptOnHitHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_HIT))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_HIT);
@@ -8612,6 +8812,9 @@ void Spell::CallScriptOnHitHandlers()
 
 void Spell::CallScriptAfterHitHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_AFTER_HIT))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_AFTER_HIT);
@@ -8625,6 +8828,9 @@ void Spell::CallScriptAfterHitHandlers()
 
 void Spell::CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_OBJECT_AREA_TARGET_SELECT))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_OBJECT_AREA_TARGET_SELECT);
@@ -8639,6 +8845,9 @@ void Spell::CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& ta
 
 void Spell::CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_OBJECT_TARGET_SELECT))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_OBJECT_TARGET_SELECT);
@@ -8653,6 +8862,9 @@ void Spell::CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffI
 
 void Spell::CallScriptDestinationTargetSelectHandlers(SpellDestination& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_DESTINATION_TARGET_SELECT))
+        return;
+
     for (std::list<SpellScript*>::iterator scritr = m_loadedScripts.begin(); scritr != m_loadedScripts.end(); ++scritr)
     {
         (*scritr)->_PrepareScriptCall(SPELL_SCRIPT_HOOK_DESTINATION_TARGET_SELECT);
@@ -19,6 +19,7 @@
 #define __SPELL_H
 
 #include "GridDefines.h"
+#include "NodePoolAllocator.h"
 #include "ObjectMgr.h"
 #include "PathGenerator.h"
 #include "SharedDefines.h"
@@ -236,6 +237,14 @@ enum SpellEffectHandleMode
     SPELL_EFFECT_HANDLE_HIT_TARGET,
 };
 
+enum SpellEffectHandleModeMask
+{
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH         = 1 << SPELL_EFFECT_HANDLE_LAUNCH,
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET  = 1 << SPELL_EFFECT_HANDLE_LAUNCH_TARGET,
+    SPELL_EFFECT_HANDLE_MASK_HIT            = 1 << SPELL_EFFECT_HANDLE_HIT,
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET     = 1 << SPELL_EFFECT_HANDLE_HIT_TARGET,
+};
+
 // Xinef: special structure containing data for channel target spells
 struct ChannelTargetData
 {
@@ -264,6 +273,8 @@ struct TargetInfo
     int32  damage;
 };
 
+typedef std::list<TargetInfo, Acore::NodePoolAllocator<TargetInfo>> TargetInfoList;
+
 static const uint32 SPELL_INTERRUPT_NONPLAYER = 32747;
 
 struct TriggeredByAuraSpellData
@@ -288,6 +299,14 @@ public:
     Spell(Unit* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, bool skipCheck = false);
     ~Spell();
 
+    // every cast allocates a Spell, they are recycled through per thread pools
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+    // Spell and SpellEvent allocations since the last call
+    static uint64 TakePoolAllocationCount();
+    // memory held by the Spell and SpellEvent pools
+    static std::size_t GetPoolReservedBytes();
+
     void EffectNULL(SpellEffIndex effIndex);
     void EffectUnused(SpellEffIndex effIndex);
     void EffectDistract(SpellEffIndex effIndex);
@@ -437,6 +456,8 @@ public:
 
     uint32 GetSearcherTypeMask(SpellTargetObjectTypes objType, ConditionList* condList);
     template<class SEARCHER> void SearchTargets(SEARCHER& searcher, uint32 containerMask, Unit* referer, Position const* pos, float radius);
+    // gathers all candidates around pos first, drops those out of radius in one pass and only then runs check on the rest
+    template<class CHECK> void SearchAreaTargetCandidates(std::list<WorldObject*>& targets, CHECK& check, uint32 containerMask, Position const* pos, float radius);
 
     WorldObject* SearchNearbyTarget(float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList = nullptr);
     void SearchAreaTargets(std::list<WorldObject*>& targets, float range, Position const* position, Unit* referer, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionList* condList);
@@ -487,6 +508,8 @@ public:
     void WriteAmmoToPacket(WorldPacket* data);
 
     bool CheckEffectTarget(Unit const* target, uint32 eff) const;
+    bool GetLOSChecks(uint32& losChecks) const;
+    void PrecomputeAreaTargetsLOS(std::list<WorldObject*> const& targets);
     bool CanAutoCast(Unit* target);
     void CheckSrc() { if (!m_targets.HasSrc()) m_targets.SetSrc(*m_caster); }
     void CheckDst() { if (!m_targets.HasDst()) m_targets.SetDst(*m_caster); }
@@ -584,7 +607,7 @@ public:
 
     // xinef: moved to public
     void LoadScripts();
-    std::list<TargetInfo>* GetUniqueTargetInfo() { return &m_UniqueTargetInfo; }
+    TargetInfoList* GetUniqueTargetInfo() { return &m_UniqueTargetInfo; }
 
     [[nodiscard]] uint32 GetTriggeredByAuraTickNumber() const { return m_triggeredByAuraSpell.tickNumber; }
 
@@ -679,7 +702,8 @@ public:
     // *****************************************
     // Spell target subsystem
     // *****************************************
-    std::list<TargetInfo> m_UniqueTargetInfo;
+    TargetInfoList m_UniqueTargetInfo;
+    std::unordered_map<ObjectGuid, bool> m_areaTargetsLOS;     // line of sight of the area targets being added, checked in one batch
     uint8 m_channelTargetEffectMask;                        // Mask req. alive targets
 
     struct GOTargetInfo
@@ -689,14 +713,16 @@ public:
         uint8  effectMask: 8;
         bool   processed: 1;
     };
-    std::list<GOTargetInfo> m_UniqueGOTargetInfo;
+    typedef std::list<GOTargetInfo, Acore::NodePoolAllocator<GOTargetInfo>> GOTargetInfoList;
+    GOTargetInfoList m_UniqueGOTargetInfo;
 
     struct ItemTargetInfo
     {
         Item*  item;
         uint8 effectMask;
     };
-    std::list<ItemTargetInfo> m_UniqueItemInfo;
+    typedef std::list<ItemTargetInfo, Acore::NodePoolAllocator<ItemTargetInfo>> ItemTargetInfoList;
+    ItemTargetInfoList m_UniqueItemInfo;
 
     SpellDestination m_destTargets[MAX_SPELL_EFFECTS];
 
@@ -724,6 +750,9 @@ public:
 
     // Scripting system
     bool _scriptsLoaded;
+    uint32 _scriptHookMask;                                         // mask of (1 << SpellScriptHookType) the scripts of the spell register
+    std::array<uint8, MAX_SPELL_EFFECTS> _scriptEffectHandleModes; // SpellEffectHandleModeMask of the effect hooks registered by m_loadedScripts
+    [[nodiscard]] bool HasScriptHook(uint8 hookType) const { return (_scriptHookMask & (1 << hookType)) != 0; }
     //void LoadScripts();
     void CallScriptBeforeCastHandlers();
     void CallScriptOnCastHandlers();
@@ -238,6 +238,176 @@ pEffect SpellEffects[TOTAL_SPELL_EFFECTS] =
     &Spell::EffectRemoveAura,                               //164 SPELL_EFFECT_REMOVE_AURA
 };
 
+// modes in which the handler above does any work, HandleEffects skips the others unless a script hooks them
+uint8 SpellEffectHandleModes[TOTAL_SPELL_EFFECTS] =
+{
+    0,                                                  //  0
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //  1 SPELL_EFFECT_INSTAKILL
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             //  2 SPELL_EFFECT_SCHOOL_DAMAGE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //  3 SPELL_EFFECT_DUMMY
+    0,                                                  //  4 SPELL_EFFECT_PORTAL_TELEPORT          unused
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //  5 SPELL_EFFECT_TELEPORT_UNITS
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //  6 SPELL_EFFECT_APPLY_AURA
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //  7 SPELL_EFFECT_ENVIRONMENTAL_DAMAGE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //  8 SPELL_EFFECT_POWER_DRAIN
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //  9 SPELL_EFFECT_HEALTH_LEECH
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 10 SPELL_EFFECT_HEAL
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 11 SPELL_EFFECT_BIND
+    0,                                                  // 12 SPELL_EFFECT_PORTAL
+    0,                                                  // 13 SPELL_EFFECT_RITUAL_BASE              unused
+    0,                                                  // 14 SPELL_EFFECT_RITUAL_SPECIALIZE        unused
+    0,                                                  // 15 SPELL_EFFECT_RITUAL_ACTIVATE_PORTAL   unused
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 16 SPELL_EFFECT_QUEST_COMPLETE
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 17 SPELL_EFFECT_WEAPON_DAMAGE_NOSCHOOL
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 18 SPELL_EFFECT_RESURRECT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 19 SPELL_EFFECT_ADD_EXTRA_ATTACKS
+    0,                                                  // 20 SPELL_EFFECT_DODGE                    one spell: Dodge
+    0,                                                  // 21 SPELL_EFFECT_EVADE                    one spell: Evade (DND)
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 22 SPELL_EFFECT_PARRY
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 23 SPELL_EFFECT_BLOCK                    one spell: Block
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 24 SPELL_EFFECT_CREATE_ITEM
+    0,                                                  // 25 SPELL_EFFECT_WEAPON
+    0,                                                  // 26 SPELL_EFFECT_DEFENSE                  one spell: Defense
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 27 SPELL_EFFECT_PERSISTENT_AREA_AURA
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 28 SPELL_EFFECT_SUMMON
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 29 SPELL_EFFECT_LEAP
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 30 SPELL_EFFECT_ENERGIZE
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 31 SPELL_EFFECT_WEAPON_PERCENT_DAMAGE
+    SPELL_EFFECT_HANDLE_MASK_HIT | SPELL_EFFECT_HANDLE_MASK_HIT_TARGET, // 32 SPELL_EFFECT_TRIGGER_MISSILE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 33 SPELL_EFFECT_OPEN_LOCK
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 34 SPELL_EFFECT_SUMMON_CHANGE_ITEM
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 35 SPELL_EFFECT_APPLY_AREA_AURA_PARTY
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 36 SPELL_EFFECT_LEARN_SPELL
+    0,                                                  // 37 SPELL_EFFECT_SPELL_DEFENSE            one spell: SPELLDEFENSE (DND)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 38 SPELL_EFFECT_DISPEL
+    0,                                                  // 39 SPELL_EFFECT_LANGUAGE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 40 SPELL_EFFECT_DUAL_WIELD
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 41 SPELL_EFFECT_JUMP
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH,                    // 42 SPELL_EFFECT_JUMP_DEST
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 43 SPELL_EFFECT_TELEPORT_UNITS_FACE_CASTER
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 44 SPELL_EFFECT_SKILL_STEP
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 45 SPELL_EFFECT_ADD_HONOR                honor/pvp related
+    0,                                                  // 46 SPELL_EFFECT_SPAWN client-side, unit appears as if it was just spawned
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 47 SPELL_EFFECT_TRADE_SKILL
+    0,                                                  // 48 SPELL_EFFECT_STEALTH                  one spell: Base Stealth
+    0,                                                  // 49 SPELL_EFFECT_DETECT                   one spell: Detect
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 50 SPELL_EFFECT_TRANS_DOOR
+    0,                                                  // 51 SPELL_EFFECT_FORCE_CRITICAL_HIT       unused
+    0,                                                  // 52 SPELL_EFFECT_GUARANTEE_HIT            one spell: zzOLDCritical Shot
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 53 SPELL_EFFECT_ENCHANT_ITEM
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 54 SPELL_EFFECT_ENCHANT_ITEM_TEMPORARY
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 55 SPELL_EFFECT_TAMECREATURE
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 56 SPELL_EFFECT_SUMMON_PET
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 57 SPELL_EFFECT_LEARN_PET_SPELL
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 58 SPELL_EFFECT_WEAPON_DAMAGE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 59 SPELL_EFFECT_CREATE_RANDOM_ITEM       create item base at spell specific loot
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 60 SPELL_EFFECT_PROFICIENCY
+    SPELL_EFFECT_HANDLE_MASK_HIT | SPELL_EFFECT_HANDLE_MASK_HIT_TARGET, // 61 SPELL_EFFECT_SEND_EVENT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 62 SPELL_EFFECT_POWER_BURN
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 63 SPELL_EFFECT_THREAT
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH | SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET, // 64 SPELL_EFFECT_TRIGGER_SPELL
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 65 SPELL_EFFECT_APPLY_AREA_AURA_RAID
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 66 SPELL_EFFECT_CREATE_MANA_GEM          (possibly recharge it, misc - is item ID)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 67 SPELL_EFFECT_HEAL_MAX_HEALTH
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 68 SPELL_EFFECT_INTERRUPT_CAST
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 69 SPELL_EFFECT_DISTRACT
+    0,                                                  // 70 SPELL_EFFECT_PULL                     one spell: Distract Move
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 71 SPELL_EFFECT_PICKPOCKET
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 72 SPELL_EFFECT_ADD_FARSIGHT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 73 SPELL_EFFECT_UNTRAIN_TALENTS
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 74 SPELL_EFFECT_APPLY_GLYPH
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 75 SPELL_EFFECT_HEAL_MECHANICAL          one spell: Mechanical Patch Kit
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 76 SPELL_EFFECT_SUMMON_OBJECT_WILD
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 77 SPELL_EFFECT_SCRIPT_EFFECT
+    0,                                                  // 78 SPELL_EFFECT_ATTACK
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 79 SPELL_EFFECT_SANCTUARY
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 80 SPELL_EFFECT_ADD_COMBO_POINTS
+    0,                                                  // 81 SPELL_EFFECT_CREATE_HOUSE             one spell: Create House (TEST)
+    0,                                                  // 82 SPELL_EFFECT_BIND_SIGHT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 83 SPELL_EFFECT_DUEL
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 84 SPELL_EFFECT_STUCK
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 85 SPELL_EFFECT_SUMMON_PLAYER
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 86 SPELL_EFFECT_ACTIVATE_OBJECT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 87 SPELL_EFFECT_GAMEOBJECT_DAMAGE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 88 SPELL_EFFECT_GAMEOBJECT_REPAIR
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 89 SPELL_EFFECT_GAMEOBJECT_SET_DESTRUCTION_STATE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 90 SPELL_EFFECT_KILL_CREDIT              Kill credit but only for single person
+    0,                                                  // 91 SPELL_EFFECT_THREAT_ALL               one spell: zzOLDBrainwash
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 92 SPELL_EFFECT_ENCHANT_HELD_ITEM
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 93 SPELL_EFFECT_FORCE_DESELECT
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 94 SPELL_EFFECT_SELF_RESURRECT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 95 SPELL_EFFECT_SKINNING
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             // 96 SPELL_EFFECT_CHARGE
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       // 97 SPELL_EFFECT_CAST_BUTTON (totem bar since 3.2.2a)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 98 SPELL_EFFECT_KNOCK_BACK
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                // 99 SPELL_EFFECT_DISENCHANT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //100 SPELL_EFFECT_INEBRIATE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //101 SPELL_EFFECT_FEED_PET
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //102 SPELL_EFFECT_DISMISS_PET
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //103 SPELL_EFFECT_REPUTATION
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //104 SPELL_EFFECT_SUMMON_OBJECT_SLOT1
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //105 SPELL_EFFECT_SUMMON_OBJECT_SLOT2
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //106 SPELL_EFFECT_SUMMON_OBJECT_SLOT3
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //107 SPELL_EFFECT_SUMMON_OBJECT_SLOT4
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //108 SPELL_EFFECT_DISPEL_MECHANIC
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //109 SPELL_EFFECT_RESURRECT_PET
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //110 SPELL_EFFECT_DESTROY_ALL_TOTEMS
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //111 SPELL_EFFECT_DURABILITY_DAMAGE
+    0,                                                  //112 SPELL_EFFECT_112
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //113 SPELL_EFFECT_RESURRECT_NEW
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //114 SPELL_EFFECT_ATTACK_ME
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //115 SPELL_EFFECT_DURABILITY_DAMAGE_PCT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //116 SPELL_EFFECT_SKIN_PLAYER_CORPSE       one spell: Remove Insignia, bg usage, required special corpse flags...
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //117 SPELL_EFFECT_SPIRIT_HEAL              one spell: Spirit Heal
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //118 SPELL_EFFECT_SKILL                    professions and more
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //119 SPELL_EFFECT_APPLY_AREA_AURA_PET
+    0,                                                  //120 SPELL_EFFECT_TELEPORT_GRAVEYARD       one spell: Graveyard Teleport Test
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             //121 SPELL_EFFECT_NORMALIZED_WEAPON_DMG
+    0,                                                  //122 SPELL_EFFECT_122                      unused
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //123 SPELL_EFFECT_SEND_TAXI                taxi/flight related (misc value is taxi path id)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //124 SPELL_EFFECT_PULL_TOWARDS
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //125 SPELL_EFFECT_MODIFY_THREAT_PERCENT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //126 SPELL_EFFECT_STEAL_BENEFICIAL_BUFF    spell steal effect?
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //127 SPELL_EFFECT_PROSPECTING              Prospecting spell
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //128 SPELL_EFFECT_APPLY_AREA_AURA_FRIEND
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //129 SPELL_EFFECT_APPLY_AREA_AURA_ENEMY
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //130 SPELL_EFFECT_REDIRECT_THREAT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //131 SPELL_EFFECT_PLAYER_NOTIFICATION      sound id in misc value (SoundEntries.dbc)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //132 SPELL_EFFECT_PLAY_MUSIC               sound id in misc value (SoundEntries.dbc)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //133 SPELL_EFFECT_UNLEARN_SPECIALIZATION   unlearn profession specialization
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //134 SPELL_EFFECT_KILL_CREDIT              misc value is creature entry
+    0,                                                  //135 SPELL_EFFECT_CALL_PET
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             //136 SPELL_EFFECT_HEAL_PCT
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //137 SPELL_EFFECT_ENERGIZE_PCT
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET,             //138 SPELL_EFFECT_LEAP_BACK                Leap back
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //139 SPELL_EFFECT_CLEAR_QUEST              Reset quest status (miscValue - quest ID)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //140 SPELL_EFFECT_FORCE_CAST
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //141 SPELL_EFFECT_FORCE_CAST_WITH_VALUE
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH | SPELL_EFFECT_HANDLE_MASK_LAUNCH_TARGET, //142 SPELL_EFFECT_TRIGGER_SPELL_WITH_VALUE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //143 SPELL_EFFECT_APPLY_AREA_AURA_OWNER
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //144 SPELL_EFFECT_KNOCK_BACK_DEST
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //145 SPELL_EFFECT_PULL_TOWARDS_DEST                      Black Hole Effect
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH,                    //146 SPELL_EFFECT_ACTIVATE_RUNE
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //147 SPELL_EFFECT_QUEST_FAIL               quest fail
+    SPELL_EFFECT_HANDLE_MASK_HIT | SPELL_EFFECT_HANDLE_MASK_HIT_TARGET, //148 SPELL_EFFECT_TRIGGER_MISSILE_SPELL_WITH_VALUE
+    SPELL_EFFECT_HANDLE_MASK_LAUNCH,                    //149 SPELL_EFFECT_CHARGE_DEST
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //150 SPELL_EFFECT_QUEST_START
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //151 SPELL_EFFECT_TRIGGER_SPELL_2
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //152 SPELL_EFFECT_SUMMON_RAF_FRIEND        summon Refer-a-Friend
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //153 SPELL_EFFECT_CREATE_TAMED_PET         misc value is creature entry
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //154 SPELL_EFFECT_DISCOVER_TAXI
+    SPELL_EFFECT_HANDLE_MASK_HIT,                       //155 SPELL_EFFECT_TITAN_GRIP Allows you to equip two-handed axes, maces and swords in one hand, but you attack $49152s1% slower than normal.
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //156 SPELL_EFFECT_ENCHANT_ITEM_PRISMATIC
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //157 SPELL_EFFECT_CREATE_ITEM_2            create item or create item template and replace by some randon spell loot item
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //158 SPELL_EFFECT_MILLING                  milling
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //159 SPELL_EFFECT_ALLOW_RENAME_PET         allow rename pet once again
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //160 SPELL_EFFECT_FORCE_CAST_2
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //161 SPELL_EFFECT_TALENT_SPEC_COUNT        second talent spec (learn/revert)
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //162 SPELL_EFFECT_TALENT_SPEC_SELECT       activate primary/secondary spec
+    0,                                                  //163 unused
+    SPELL_EFFECT_HANDLE_MASK_HIT_TARGET,                //164 SPELL_EFFECT_REMOVE_AURA
+};
+
 void Spell::EffectNULL(SpellEffIndex /*effIndex*/)
 {
     LOG_DEBUG("spells.aura", "WORLD: Spell Effect DUMMY");
@@ -339,7 +509,7 @@ void Spell::EffectSchoolDMG(SpellEffIndex effIndex)
                     if (m_spellInfo->HasAttribute(SPELL_ATTR0_CU_SHARE_DAMAGE))
                     {
                         uint32 count = 0;
-                        for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+                        for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
                             if (ihit->effectMask & (1 << effIndex))
                                 ++count;
 
@@ -3633,7 +3803,7 @@ void Spell::EffectWeaponDmg(SpellEffIndex effIndex)
     if (m_spellInfo->HasAttribute(SPELL_ATTR0_CU_SHARE_DAMAGE))
     {
         uint32 count = 0;
-        for (std::list<TargetInfo>::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
+        for (TargetInfoList::iterator ihit = m_UniqueTargetInfo.begin(); ihit != m_UniqueTargetInfo.end(); ++ihit)
             if (ihit->effectMask & (1 << effIndex))
                 ++count;
 
@@ -857,6 +857,7 @@ SpellInfo::SpellInfo(SpellEntry const* spellEntry)
     _isSpellValid = true;
     _isCritCapable = false;
     _requireCooldownInfo = false;
+    _effectHandleModes.fill(0);
 }
 
 SpellInfo::~SpellInfo()
@@ -375,12 +375,8 @@ public:
     int32  EquippedItemSubClassMask;
     int32  EquippedItemInventoryTypeMask;
     std::array<uint32, 2> TotemCategory;
-    std::array<uint32, 2> SpellVisual;
     uint32 SpellIconID;
-    uint32 ActiveIconID;
     uint32 SpellPriority;
-    std::array<char const*, 16> SpellName;
-    std::array<char const*, 16> Rank;
     uint32 MaxTargetLevel;
     uint32 MaxAffectedTargets;
     uint32 SpellFamilyName;
@@ -393,9 +389,16 @@ public:
     uint32 ExplicitTargetMask;
     SpellChainNode const* ChainEntry;
 
+    // display data, not read while casting; kept behind the fields above so those share fewer cache lines
+    std::array<uint32, 2> SpellVisual;
+    uint32 ActiveIconID;
+    std::array<char const*, 16> SpellName;
+    std::array<char const*, 16> Rank;
+
     // Mine
     AuraStateType _auraState;
     SpellSpecificType _spellSpecific;
+    std::array<uint8, MAX_SPELL_EFFECTS> _effectHandleModes;    // SpellEffectHandleModeMask of each effect, see SpellMgr::LoadSpellEffectHandleModes
     bool _isStackableWithRanks;
     bool _isSpellValid;
     bool _isCritCapable;
@@ -497,6 +500,7 @@ public:
 
     AuraStateType GetAuraState() const;
     SpellSpecificType GetSpellSpecific() const;
+    uint8 GetEffectHandleModes(uint8 effIndex) const { return _effectHandleModes[effIndex]; }
 
     float GetMinRange(bool positive = false) const;
     float GetMaxRange(bool positive = false, Unit* caster = nullptr, Spell* spell = nullptr) const;
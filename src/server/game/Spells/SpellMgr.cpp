@@ -33,6 +33,9 @@
 #include "SpellAuras.h"
 #include "SpellInfo.h"
 #include "World.h"
+#include "WorldLoadGraph.h"
+
+extern uint8 SpellEffectHandleModes[TOTAL_SPELL_EFFECTS];
 
 bool IsPrimaryProfessionSkill(uint32 skill)
 {
@@ -735,6 +738,20 @@ SpellProcEventEntry const* SpellMgr::GetSpellProcEvent(uint32 spellId) const
     return nullptr;
 }
 
+uint32 SpellMgr::GetSpellProcEventFlags(SpellInfo const* spellProto) const
+{
+    // auras with a new proc system entry are handled by TriggerAurasProcOnEvent
+    if (GetSpellProcEntry(spellProto->Id))
+        return 0;
+
+    // same choice as Unit::IsTriggeredAtSpellProcEvent
+    SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellProto->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return spellProto->ProcFlags;
+}
+
 bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, ProcEventInfo const& eventInfo, bool active) const
 {
     // No extra req need
@@ -1740,6 +1757,7 @@ void SpellMgr::LoadSpellProcEvents()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcEventMap.clear();                             // need for reload case
+    ++_procDataGeneration;
 
     //                                                0      1           2                3                 4                 5                 6          7       8          9             10       11
     QueryResult result = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, procFlags, procEx, procPhase, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -1834,6 +1852,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++_procDataGeneration;
 
     //                                                 0        1           2                3                 4                 5                 6          7              8              9         10              11             12      13        14
     QueryResult result = WorldDatabase.Query("SELECT SpellId, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, ProcFlags, SpellTypeMask, SpellPhaseMask, HitMask, AttributesMask, ProcsPerMinute, Chance, Cooldown, Charges FROM spell_proc");
@@ -2695,8 +2714,10 @@ void SpellMgr::LoadSpellInfoStore()
     UnloadSpellInfoStore();
     mSpellInfoMap.resize(sSpellStore.GetNumRows(), nullptr);
 
+    // one contiguous block instead of an allocation per spell, reserved up front so the pointers stay valid
+    mSpellInfoStorage.reserve(std::distance(sSpellStore.begin(), sSpellStore.end()));
     for (SpellEntry const* spellEntry : sSpellStore)
-        mSpellInfoMap[spellEntry->Id] = new SpellInfo(spellEntry);
+        mSpellInfoMap[spellEntry->Id] = &mSpellInfoStorage.emplace_back(spellEntry);
 
     for (uint32 spellIndex = 0; spellIndex < GetSpellInfoStoreSize(); ++spellIndex)
     {
@@ -2761,10 +2782,8 @@ SpellCooldownOverride SpellMgr::GetSpellCooldownOverride(uint32 spellId) const
 
 void SpellMgr::UnloadSpellInfoStore()
 {
-    for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
-        delete mSpellInfoMap[i];
-
     mSpellInfoMap.clear();
+    mSpellInfoStorage.clear();
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -2776,24 +2795,59 @@ void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
     }
 }
 
+void SpellMgr::ForEachSpellInfoParallel(std::string const& name, std::function<void(SpellInfo*)> const& pass)
+{
+    uint32 const threads = std::max<uint32>(sWorld->getIntConfig(CONFIG_NUMTHREADS_STARTUP_LOADERS), 1);
+    uint32 const size = GetSpellInfoStoreSize();
+    uint32 const step = std::max<uint32>((size + threads - 1) / threads, 1);
+
+    WorldLoadGraph loadGraph(name);
+    for (uint32 begin = 0; begin < size; begin += step)
+    {
+        uint32 const end = std::min(begin + step, size);
+        loadGraph.Add(name + " " + std::to_string(begin) + "-" + std::to_string(end), [this, &pass, begin, end]
+        {
+            for (uint32 i = begin; i < end; ++i)
+                if (SpellInfo* spellInfo = mSpellInfoMap[i])
+                    pass(spellInfo);
+        });
+    }
+
+    loadGraph.Run(threads);
+}
+
 void SpellMgr::LoadSpellSpecificAndAuraState()
 {
     uint32 oldMSTime = getMSTime();
 
-    SpellInfo* spellInfo = nullptr;
-    for (uint32 i = 0; i < GetSpellInfoStoreSize(); ++i)
+    // the aura state of a spell depends on its own spell specific only
+    ForEachSpellInfoParallel("Spell Specific And Aura State", [](SpellInfo* spellInfo)
     {
-        spellInfo = mSpellInfoMap[i];
-        if (!spellInfo)
-            continue;
         spellInfo->_spellSpecific = spellInfo->LoadSpellSpecific();
         spellInfo->_auraState = spellInfo->LoadAuraState();
-    }
+    });
 
     LOG_INFO("server.loading", ">> Loaded Spell Specific And Aura State in {} ms", GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
 
+void SpellMgr::LoadSpellEffectHandleModes()
+{
+    uint32 oldMSTime = getMSTime();
+
+    ForEachSpellInfoParallel("Spell Effect Handle Modes", [](SpellInfo* spellInfo)
+    {
+        for (uint8 j = 0; j < MAX_SPELL_EFFECTS; ++j)
+        {
+            uint32 effect = spellInfo->Effects[j].Effect;
+            spellInfo->_effectHandleModes[j] = effect < TOTAL_SPELL_EFFECTS ? SpellEffectHandleModes[effect] : 0;
+        }
+    });
+
+    LOG_INFO("server.loading", ">> Loaded Spell Effect Handle Modes in {} ms", GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
 void SpellMgr::LoadSpellInfoCustomAttributes()
 {
     uint32 const oldMSTime = getMSTime();
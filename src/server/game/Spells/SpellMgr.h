@@ -689,6 +689,10 @@ public:
     // Spell proc event table
     [[nodiscard]] SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
     bool IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, ProcEventInfo const& eventInfo, bool active) const;
+    // proc flags an aura of this spell reacts to in Unit::ProcDamageAndSpellFor, 0 if it never procs there
+    [[nodiscard]] uint32 GetSpellProcEventFlags(SpellInfo const* spellProto) const;
+    // changes whenever the proc tables are (re)loaded, cached proc data must be rebuilt then
+    [[nodiscard]] uint32 GetProcDataGeneration() const { return _procDataGeneration; }
 
     // Spell proc table
     [[nodiscard]] SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
@@ -759,6 +763,9 @@ public:
 private:
     SpellInfo* _GetSpellInfo(uint32 spellId) { return spellId < GetSpellInfoStoreSize() ? mSpellInfoMap[spellId] : nullptr; }
 
+    // Runs a load pass over spell id ranges with the startup loader threads, the pass must only touch the SpellInfo it gets
+    void ForEachSpellInfoParallel(std::string const& name, std::function<void(SpellInfo*)> const& pass);
+
     // Modifiers
 public:
     // Loading data at server startup
@@ -790,6 +797,7 @@ public:
     void LoadSpellInfoCustomAttributes();
     void LoadSpellInfoCorrections();
     void LoadSpellSpecificAndAuraState();
+    void LoadSpellEffectHandleModes();
 
 private:
     SpellDifficultySearcherMap mSpellDifficultySearcherMap;
@@ -802,6 +810,7 @@ private:
     SpellGroupStackMap         mSpellGroupStackMap;
     SpellProcEventMap          mSpellProcEventMap;
     SpellProcMap               mSpellProcMap;
+    uint32                     _procDataGeneration = 0;
     SpellBonusMap              mSpellBonusMap;
     SpellThreatMap             mSpellThreatMap;
     SpellMixologyMap           mSpellMixologyMap;
@@ -818,6 +827,7 @@ private:
     PetLevelupSpellMap         mPetLevelupSpellMap;
     PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
     SpellInfoMap               mSpellInfoMap;
+    std::vector<SpellInfo>     mSpellInfoStorage;              // backs mSpellInfoMap, in spell id order
     SpellCooldownOverrideMap   mSpellCooldownOverrideMap;
     TalentAdditionalSet        mTalentSpellAdditionalSet;
 };
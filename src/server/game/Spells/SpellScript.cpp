@@ -371,6 +371,32 @@ void SpellScript::_FinishScriptCall()
     m_currentScriptState = SPELL_SCRIPT_STATE_NONE;
 }
 
+uint32 SpellScript::_GetRegisteredHookMask() const
+{
+    uint32 mask = 0;
+    auto addHook = [&mask](bool registered, SpellScriptHookType hookType)
+    {
+        if (registered)
+            mask |= 1 << hookType;
+    };
+
+    addHook(!OnEffectLaunch.empty(), SPELL_SCRIPT_HOOK_EFFECT_LAUNCH);
+    addHook(!OnEffectLaunchTarget.empty(), SPELL_SCRIPT_HOOK_EFFECT_LAUNCH_TARGET);
+    addHook(!OnEffectHit.empty(), SPELL_SCRIPT_HOOK_EFFECT_HIT);
+    addHook(!OnEffectHitTarget.empty(), SPELL_SCRIPT_HOOK_EFFECT_HIT_TARGET);
+    addHook(!BeforeHit.empty(), SPELL_SCRIPT_HOOK_BEFORE_HIT);
+    addHook(!OnHit.empty(), SPELL_SCRIPT_HOOK_HIT);
+    addHook(!AfterHit.empty(), SPELL_SCRIPT_HOOK_AFTER_HIT);
+    addHook(!OnObjectAreaTargetSelect.empty(), SPELL_SCRIPT_HOOK_OBJECT_AREA_TARGET_SELECT);
+    addHook(!OnObjectTargetSelect.empty(), SPELL_SCRIPT_HOOK_OBJECT_TARGET_SELECT);
+    addHook(!OnDestinationTargetSelect.empty(), SPELL_SCRIPT_HOOK_DESTINATION_TARGET_SELECT);
+    addHook(!OnCheckCast.empty(), SPELL_SCRIPT_HOOK_CHECK_CAST);
+    addHook(!BeforeCast.empty(), SPELL_SCRIPT_HOOK_BEFORE_CAST);
+    addHook(!OnCast.empty(), SPELL_SCRIPT_HOOK_ON_CAST);
+    addHook(!AfterCast.empty(), SPELL_SCRIPT_HOOK_AFTER_CAST);
+    return mask;
+}
+
 bool SpellScript::IsInCheckCastHook() const
 {
     return m_currentScriptState == SPELL_SCRIPT_HOOK_CHECK_CAST;
@@ -982,6 +1008,42 @@ bool AuraScript::_IsDefaultActionPrevented()
     }
 }
 
+uint32 AuraScript::_GetRegisteredHookMask() const
+{
+    uint32 mask = 0;
+    auto addHook = [&mask](bool registered, AuraScriptHookType hookType)
+    {
+        if (registered)
+            mask |= 1 << hookType;
+    };
+
+    addHook(!OnEffectApply.empty(), AURA_SCRIPT_HOOK_EFFECT_APPLY);
+    addHook(!AfterEffectApply.empty(), AURA_SCRIPT_HOOK_EFFECT_AFTER_APPLY);
+    addHook(!OnEffectRemove.empty(), AURA_SCRIPT_HOOK_EFFECT_REMOVE);
+    addHook(!AfterEffectRemove.empty(), AURA_SCRIPT_HOOK_EFFECT_AFTER_REMOVE);
+    addHook(!OnEffectPeriodic.empty(), AURA_SCRIPT_HOOK_EFFECT_PERIODIC);
+    addHook(!OnEffectUpdatePeriodic.empty(), AURA_SCRIPT_HOOK_EFFECT_UPDATE_PERIODIC);
+    addHook(!DoEffectCalcAmount.empty(), AURA_SCRIPT_HOOK_EFFECT_CALC_AMOUNT);
+    addHook(!DoEffectCalcPeriodic.empty(), AURA_SCRIPT_HOOK_EFFECT_CALC_PERIODIC);
+    addHook(!DoEffectCalcSpellMod.empty(), AURA_SCRIPT_HOOK_EFFECT_CALC_SPELLMOD);
+    addHook(!OnEffectAbsorb.empty(), AURA_SCRIPT_HOOK_EFFECT_ABSORB);
+    addHook(!AfterEffectAbsorb.empty(), AURA_SCRIPT_HOOK_EFFECT_AFTER_ABSORB);
+    addHook(!OnEffectManaShield.empty(), AURA_SCRIPT_HOOK_EFFECT_MANASHIELD);
+    addHook(!AfterEffectManaShield.empty(), AURA_SCRIPT_HOOK_EFFECT_AFTER_MANASHIELD);
+    addHook(!OnEffectSplit.empty(), AURA_SCRIPT_HOOK_EFFECT_SPLIT);
+    addHook(!DoCheckAreaTarget.empty(), AURA_SCRIPT_HOOK_CHECK_AREA_TARGET);
+    addHook(!OnDispel.empty(), AURA_SCRIPT_HOOK_DISPEL);
+    addHook(!AfterDispel.empty(), AURA_SCRIPT_HOOK_AFTER_DISPEL);
+    addHook(!DoCheckProc.empty(), AURA_SCRIPT_HOOK_CHECK_PROC);
+    addHook(!DoAfterCheckProc.empty(), AURA_SCRIPT_HOOK_AFTER_CHECK_PROC);
+    addHook(!DoPrepareProc.empty(), AURA_SCRIPT_HOOK_PREPARE_PROC);
+    addHook(!OnProc.empty(), AURA_SCRIPT_HOOK_PROC);
+    addHook(!OnEffectProc.empty(), AURA_SCRIPT_HOOK_EFFECT_PROC);
+    addHook(!AfterEffectProc.empty(), AURA_SCRIPT_HOOK_EFFECT_AFTER_PROC);
+    addHook(!AfterProc.empty(), AURA_SCRIPT_HOOK_AFTER_PROC);
+    return mask;
+}
+
 void AuraScript::PreventDefaultAction()
 {
     switch (m_currentScriptState)
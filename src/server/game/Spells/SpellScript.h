@@ -302,6 +302,7 @@ public:
     bool _IsDefaultEffectPrevented(SpellEffIndex effIndex) { return m_hitPreventDefaultEffectMask & (1 << effIndex); }
     void _PrepareScriptCall(SpellScriptHookType hookType);
     void _FinishScriptCall();
+    uint32 _GetRegisteredHookMask() const; // mask of (1 << SpellScriptHookType) of the hooks that have handlers
     bool IsInCheckCastHook() const;
     bool IsInTargetHook() const;
     bool IsInHitPhase() const;
@@ -692,6 +693,7 @@ public:
     void _PrepareScriptCall(AuraScriptHookType hookType, AuraApplication const* aurApp = nullptr);
     void _FinishScriptCall();
     bool _IsDefaultActionPrevented();
+    uint32 _GetRegisteredHookMask() const; // mask of (1 << AuraScriptHookType) of the hooks that have handlers
 private:
     Aura* m_aura;
     AuraApplication const* m_auraApplication;
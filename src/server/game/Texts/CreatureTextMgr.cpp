@@ -189,7 +189,7 @@ void CreatureTextMgr::LoadCreatureTextLocales()
             continue;
 
         CreatureTextLocale& data = mLocaleTextMap[CreatureTextId(CreatureId, GroupId, ID)];
-        ObjectMgr::AddLocaleString(fields[4].Get<std::string>(), locale, data.Text);
+        ObjectMgr::AddLocaleString(fields[4].Get<std::string_view>(), locale, data.Text);
     } while (result->NextRow());
 
     LOG_INFO("server.loading", ">> Loaded {} Creature Text Locale in {} ms", uint32(mLocaleTextMap.size()), GetMSTimeDiffToNow(oldMSTime));
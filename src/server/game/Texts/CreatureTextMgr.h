@@ -52,7 +52,7 @@ struct CreatureTextEntry
 
 struct CreatureTextLocale
 {
-    std::vector<std::string> Text;
+    LocaleStrings Text;
 };
 
 struct CreatureTextId
@@ -18,9 +18,17 @@
 #include "UpdateTime.h"
 #include "Config.h"
 #include "Log.h"
+#include "Map.h"
+#include "MapMgr.h"
+#include "MetricRegistry.h"
 #include "Timer.h"
 #include <algorithm>
+#include <functional>
 #include <iterator>
+#include <tuple>
+
+// sections and maps listed for a slow update
+constexpr std::size_t SLOW_UPDATE_REPORT_COUNT = 5;
 
 // create instance
 WorldUpdateTime sWorldUpdateTime;
@@ -152,6 +160,7 @@ void WorldUpdateTime::LoadFromConfig()
 {
     _recordUpdateTimeInverval = Milliseconds(sConfigMgr->GetOption<uint32>("RecordUpdateTimeDiffInterval", 60000));
     _recordUpdateTimeMin = Milliseconds(sConfigMgr->GetOption<uint32>("MinRecordUpdateTimeDiff", 100));
+    _slowUpdateThreshold = sConfigMgr->GetOption<uint32>("SlowUpdateTimeThreshold", 0);
 }
 
 void WorldUpdateTime::SetRecordUpdateTimeInterval(Milliseconds t)
@@ -173,3 +182,69 @@ void WorldUpdateTime::RecordUpdateTime(Milliseconds gameTimeMs, uint32 diff, uin
         }
     }
 }
+
+void WorldUpdateTime::RecordSectionTime(std::string_view section, uint32 diff)
+{
+    UpdateSection& updateSection = _sections[section];
+    updateSection.Times.UpdateWithDiff(diff);
+
+    if (sMetric->IsExporterEnabled())
+    {
+        if (!updateSection.Histogram)
+            updateSection.Histogram = &sMetricRegistry->GetHistogram("world_update_section_seconds", "Wall time of one section of the world update",
+                { 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25 }, { { "section", std::string(section) } });
+
+        updateSection.Histogram->Observe(diff / 1000000.0);
+    }
+
+    _lastUpdateSections.emplace_back(section, diff);
+}
+
+void WorldUpdateTime::CheckSlowUpdate(uint32 diff)
+{
+    if (_slowUpdateThreshold && diff > _slowUpdateThreshold)
+    {
+        if (!_slowUpdateCounter)
+            _slowUpdateCounter = &sMetricRegistry->GetCounter("world_slow_updates_total", "World updates slower than SlowUpdateTimeThreshold");
+
+        _slowUpdateCounter->Increment();
+
+        std::size_t sectionCount = std::min(SLOW_UPDATE_REPORT_COUNT, _lastUpdateSections.size());
+        std::partial_sort(_lastUpdateSections.begin(), _lastUpdateSections.begin() + sectionCount, _lastUpdateSections.end(),
+            [](auto const& left, auto const& right) { return left.second > right.second; });
+
+        // map costs are the ones of their last update, which is the slow one for the maps updated every tick
+        std::vector<std::tuple<uint32 /*cost*/, uint32 /*mapId*/, uint32 /*instanceId*/>> maps;
+        sMapMgr->DoForAllMaps([&maps](Map* map)
+        {
+            maps.emplace_back(map->GetLastUpdateCost(), map->GetId(), map->GetInstanceId());
+        });
+
+        std::size_t mapCount = std::min(SLOW_UPDATE_REPORT_COUNT, maps.size());
+        std::partial_sort(maps.begin(), maps.begin() + mapCount, maps.end(), std::greater<>());
+
+        LOG_WARN("time.update", "Slow world update: {}ms, threshold {}ms. Slowest sections:", diff, _slowUpdateThreshold);
+        for (std::size_t i = 0; i < sectionCount; ++i)
+            LOG_WARN("time.update", " - {}: {}us", _lastUpdateSections[i].first, _lastUpdateSections[i].second);
+
+        LOG_WARN("time.update", "Slowest maps:");
+        for (std::size_t i = 0; i < mapCount; ++i)
+            LOG_WARN("time.update", " - Map {} instance {}: {}us", std::get<1>(maps[i]), std::get<2>(maps[i]), std::get<0>(maps[i]));
+    }
+
+    _lastUpdateSections.clear();
+}
+
+std::vector<std::pair<std::string_view, uint32>> WorldUpdateTime::GetSlowestSections(uint8 percentile, std::size_t count)
+{
+    std::vector<std::pair<std::string_view, uint32>> sections;
+    sections.reserve(_sections.size());
+
+    for (auto& [name, section] : _sections)
+        sections.emplace_back(name, section.Times.GetPercentile(percentile));
+
+    count = std::min(count, sections.size());
+    std::partial_sort(sections.begin(), sections.begin() + count, sections.end(), [](auto const& left, auto const& right) { return left.second > right.second; });
+    sections.resize(count);
+    return sections;
+}
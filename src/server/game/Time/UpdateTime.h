@@ -20,8 +20,18 @@
 
 #include "Define.h"
 #include "Duration.h"
+#include "Metric.h"
 #include <array>
+#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
+
+namespace Acore::Metrics
+{
+    class Counter;
+    class Histogram;
+}
 
 constexpr auto AVG_DIFF_COUNT = 500;
 
@@ -62,21 +72,72 @@ private:
     Milliseconds _recordedTime;
 };
 
+// Update times of one section of the world update, in microseconds
+class AC_GAME_API SectionUpdateTime : public UpdateTime
+{
+public:
+    SectionUpdateTime() : UpdateTime() { }
+};
+
 class AC_GAME_API WorldUpdateTime : public UpdateTime
 {
 public:
-    WorldUpdateTime() : UpdateTime(), _recordUpdateTimeInverval(0), _recordUpdateTimeMin(0), _lastRecordTime(0) { }
+    WorldUpdateTime() : UpdateTime(), _recordUpdateTimeInverval(0), _recordUpdateTimeMin(0), _lastRecordTime(0), _slowUpdateThreshold(0), _slowUpdateCounter(nullptr) { }
     void LoadFromConfig();
     void SetRecordUpdateTimeInterval(Milliseconds t);
     void RecordUpdateTime(Milliseconds gameTimeMs, uint32 diff, uint32 sessionCount);
     void RecordUpdateTimeDuration(std::string const& text);
 
+    //! Section names must have static storage, see WORLD_UPDATE_SECTION
+    void RecordSectionTime(std::string_view section, uint32 diff);
+    //! Logs the slowest sections and maps of the last update if diff exceeds SlowUpdateTimeThreshold
+    void CheckSlowUpdate(uint32 diff);
+    //! Sections with the highest given percentile, highest first
+    std::vector<std::pair<std::string_view, uint32>> GetSlowestSections(uint8 percentile, std::size_t count);
+
 private:
+    struct UpdateSection
+    {
+        SectionUpdateTime Times;
+        Acore::Metrics::Histogram* Histogram = nullptr;
+    };
+
     Milliseconds _recordUpdateTimeInverval;
     Milliseconds _recordUpdateTimeMin;
     Milliseconds _lastRecordTime;
+
+    std::map<std::string_view, UpdateSection> _sections;
+    std::vector<std::pair<std::string_view, uint32>> _lastUpdateSections;
+    uint32 _slowUpdateThreshold;
+    Acore::Metrics::Counter* _slowUpdateCounter;
 };
 
 AC_GAME_API extern WorldUpdateTime sWorldUpdateTime;
 
+class WorldUpdateSectionScope
+{
+public:
+    explicit WorldUpdateSectionScope(std::string_view section) : _section(section), _start(std::chrono::steady_clock::now()) { }
+
+    ~WorldUpdateSectionScope()
+    {
+        sWorldUpdateTime.RecordSectionTime(_section, uint32(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _start).count()));
+    }
+
+    WorldUpdateSectionScope(WorldUpdateSectionScope const&) = delete;
+    WorldUpdateSectionScope& operator=(WorldUpdateSectionScope const&) = delete;
+
+private:
+    std::string_view _section;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#define WORLD_UPDATE_SECTION_CONCAT_(a, b) a##b
+#define WORLD_UPDATE_SECTION_CONCAT(a, b) WORLD_UPDATE_SECTION_CONCAT_(a, b)
+
+// times a part of World::Update for the section percentiles and slow update reports, and as world_update_time metric
+#define WORLD_UPDATE_SECTION(section)                                                  \
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", section));                  \
+        WorldUpdateSectionScope WORLD_UPDATE_SECTION_CONCAT(__ac_update_section, __LINE__)(section)
+
 #endif
@@ -30,7 +30,7 @@
 #include "WorldSession.h"
 
 Warden::Warden() : _session(nullptr), _checkTimer(10000/*10 sec*/), _clientResponseTimer(0),
-    _dataSent(false), _module(nullptr), _initialized(false), _interrupted(false), _checkInProgress(false)
+    _dataSent(false), _module(nullptr), _initialized(false), _interrupted(false), _checkInProgress(false), _checksDue(false)
 {
     memset(_inputKey, 0, sizeof(_inputKey));
     memset(_outputKey, 0, sizeof(_outputKey));
@@ -95,6 +95,15 @@ void Warden::RequestModule()
 
 void Warden::Update(uint32 const diff)
 {
+    if (!_queuedPenalties.empty())
+    {
+        std::vector<std::pair<uint16, std::string>> penalties;
+        penalties.swap(_queuedPenalties);
+
+        for (auto const& [checkId, reason] : penalties)
+            ApplyPenalty(checkId, reason);
+    }
+
     if (!_initialized)
     {
         return;
@@ -115,11 +124,20 @@ void Warden::Update(uint32 const diff)
             }
         }
     }
+    else if (_checksDue)
+    {
+        // no parallel session pass ran since the request was due
+        RequestChecks();
+    }
     else
     {
         if (diff >= _checkTimer)
         {
-            RequestChecks();
+            // building the request hashes and encrypts, leave it to the session worker threads if there are any
+            if (sWorld->getIntConfig(CONFIG_NUMTHREADS_SESSIONS))
+                _checksDue = true;
+            else
+                RequestChecks();
         }
         else
         {
@@ -128,6 +146,12 @@ void Warden::Update(uint32 const diff)
     }
 }
 
+void Warden::ProcessParallel()
+{
+    if (_checksDue && _initialized && !_dataSent)
+        RequestChecks();
+}
+
 void Warden::DecryptData(uint8* buffer, uint32 length)
 {
     _inputCrypto.UpdateData(buffer, length);
@@ -194,6 +218,11 @@ static std::string GetWardenActionStr(uint32 action)
     return "UNHANDLED ACTION";
 }
 
+void Warden::QueuePenalty(uint16 checkId, std::string const& reason)
+{
+    _queuedPenalties.emplace_back(checkId, reason);
+}
+
 void Warden::ApplyPenalty(uint16 checkId, std::string const& reason)
 {
     WardenCheck const* checkData = sWardenCheckMgr->GetWardenDataById(checkId);
@@ -124,6 +124,8 @@ public:
     void SendModuleToClient();
     void RequestModule();
     void Update(uint32 const diff);
+    // Builds the check request Update() found due, called from the parallel session packet pass
+    void ProcessParallel();
     void DecryptData(uint8* buffer, uint32 length);
     void EncryptData(uint8* buffer, uint32 length);
 
@@ -132,6 +134,8 @@ public:
 
     // If no check is passed, the default action from config is executed
     void ApplyPenalty(uint16 checkId, std::string const& reason);
+    // Client data is verified outside of World::UpdateSessions(), the penalty is applied by the next Update()
+    void QueuePenalty(uint16 checkId, std::string const& reason);
 
     WardenPayloadMgr* GetPayloadMgr();
 
@@ -150,7 +154,9 @@ private:
     bool _initialized;
     bool _interrupted;
     bool _checkInProgress;
+    bool _checksDue;                             // request is built by ProcessParallel()
     uint32 _interruptCounter = 0;
+    std::vector<std::pair<uint16, std::string>> _queuedPenalties;
 };
 
 #endif
@@ -16,6 +16,7 @@
  */
 
 #include "WardenCheckMgr.h"
+#include "CryptoConstants.h"
 #include "Database/DatabaseEnv.h"
 #include "Log.h"
 #include "Util.h"
@@ -112,6 +113,7 @@ void WardenCheckMgr::LoadWardenChecks()
         {
             WardenCheckResult wr;
             wr.Result.SetHexStr(checkResult.c_str());
+            wr.ResultBytes = wr.Result.ToByteVector(checkType == MPQ_CHECK ? Acore::Crypto::Constants::SHA1_DIGEST_LENGTH_BYTES : length, false);
             CheckResultStore[id] = wr;
         }
 
@@ -147,7 +149,10 @@ void WardenCheckMgr::LoadWardenChecks()
             default:
             {
                 if (checkType == PAGE_CHECK_A || checkType == PAGE_CHECK_B || checkType == DRIVER_CHECK)
+                {
                     wardenCheck.Data.SetHexStr(data.c_str());
+                    wardenCheck.DataBytes = wardenCheck.Data.ToByteVector(24, false);
+                }
 
                 CheckIdPool[WARDEN_CHECK_OTHER_TYPE].push_back(id);
                 break;
@@ -20,6 +20,7 @@
 
 #include "Cryptography/BigNumber.h"
 #include <map>
+#include <vector>
 
 // EnumUtils: DESCRIBE THIS
 enum WardenActions : uint8
@@ -44,6 +45,7 @@ struct WardenCheck
 {
     uint8 Type;
     BigNumber Data;
+    std::vector<uint8> DataBytes;                           // Data as sent to the client, PAGE_CHECK, DRIVER
     uint32 Address;                                         // PROC_CHECK, MEM_CHECK, PAGE_CHECK
     uint8 Length;                                           // PROC_CHECK, MEM_CHECK, PAGE_CHECK
     std::string Str;                                        // LUA, MPQ, DRIVER
@@ -58,6 +60,7 @@ constexpr uint8 WARDEN_MAX_LUA_CHECK_LENGTH = 170;
 struct WardenCheckResult
 {
     BigNumber Result;                                       // MEM_CHECK
+    std::vector<uint8> ResultBytes;                         // Result as compared to the client reply, MEM_CHECK, MPQ
 };
 
 class WardenCheckMgr
@@ -155,7 +155,7 @@ void WardenMac::HandleHashResult(ByteBuffer& buff)
     if (memcmp(buff.contents() + 1, sha1.GetDigest().data(), 20) != 0)
     {
         LOG_DEBUG("warden", "Request hash reply: failed");
-        ApplyPenalty(0, "Request hash reply: failed");
+        QueuePenalty(0, "Request hash reply: failed");
         return;
     }
 
@@ -181,6 +181,8 @@ void WardenMac::RequestChecks()
 {
     LOG_DEBUG("warden", "Request data");
 
+    _checksDue = false;
+
     ByteBuffer buff;
     buff << uint8(WARDEN_SMSG_CHEAT_CHECKS_REQUEST);
 
@@ -22,6 +22,7 @@
 #include "GameTime.h"
 #include "HMAC.h"
 #include "Log.h"
+#include "Metric.h"
 #include "Opcodes.h"
 #include "Player.h"
 #include "SessionKeyGenerator.h"
@@ -234,7 +235,7 @@ void WardenWin::HandleHashResult(ByteBuffer& buff)
     if (memcmp(buff.contents() + 1, Module.ClientKeySeedHash, Acore::Crypto::Constants::SHA1_DIGEST_LENGTH_BYTES) != 0)
     {
         LOG_DEBUG("warden", "Request hash reply: failed");
-        ApplyPenalty(0, "Request hash reply: failed");
+        QueuePenalty(0, "Request hash reply: failed");
         return;
     }
 
@@ -275,8 +276,12 @@ void WardenWin::ForceChecks()
 
 void WardenWin::RequestChecks()
 {
+    METRIC_DETAILED_NO_THRESHOLD_TIMER("warden_time", METRIC_TAG("type", "Request checks"));
+
     LOG_DEBUG("warden", "Request data");
 
+    _checksDue = false;
+
     _checkInProgress = true;
 
     // If all checks were done, fill the todo list again
@@ -500,8 +505,7 @@ void WardenWin::RequestChecks()
             case PAGE_CHECK_A:
             case PAGE_CHECK_B:
             {
-                std::vector<uint8> data = check->Data.ToByteVector(24, false);
-                buff.append(data.data(), data.size());
+                buff.append(check->DataBytes.data(), check->DataBytes.size());
                 buff << uint32(check->Address);
                 buff << uint8(check->Length);
                 break;
@@ -514,8 +518,7 @@ void WardenWin::RequestChecks()
             }
             case DRIVER_CHECK:
             {
-                std::vector<uint8> data = check->Data.ToByteVector(24, false);
-                buff.append(data.data(), data.size());
+                buff.append(check->DataBytes.data(), check->DataBytes.size());
                 buff << uint8(index++);
                 break;
             }
@@ -561,6 +564,8 @@ void WardenWin::RequestChecks()
 
 void WardenWin::HandleData(ByteBuffer& buff)
 {
+    METRIC_DETAILED_NO_THRESHOLD_TIMER("warden_time", METRIC_TAG("type", "Verify checks"));
+
     LOG_DEBUG("warden", "Handle data");
 
     _dataSent = false;
@@ -577,7 +582,7 @@ void WardenWin::HandleData(ByteBuffer& buff)
 
         if (!_interrupted)
         {
-            ApplyPenalty(0, "Failed size checks in HandleData");
+            QueuePenalty(0, "Failed size checks in HandleData");
         }
 
         return;
@@ -590,7 +595,7 @@ void WardenWin::HandleData(ByteBuffer& buff)
 
         if (!_interrupted)
         {
-            ApplyPenalty(0, "Failed checksum in HandleData");
+            QueuePenalty(0, "Failed checksum in HandleData");
         }
 
         return;
@@ -649,8 +654,7 @@ void WardenWin::HandleData(ByteBuffer& buff)
 
             WardenCheckResult const* rs = sWardenCheckMgr->GetWardenResultById(checkId);
 
-            std::vector<uint8> result = rs->Result.ToByteVector(0, false);
-            if (memcmp(buff.contents() + buff.rpos(), result.data(), rd->Length) != 0)
+            if (memcmp(buff.contents() + buff.rpos(), rs->ResultBytes.data(), rd->Length) != 0)
             {
                 LOG_DEBUG("warden", "RESULT MEM_CHECK fail CheckId {} account Id {}", checkId, _session->GetAccountId());
                 checkFailed = checkId;
@@ -731,7 +735,7 @@ void WardenWin::HandleData(ByteBuffer& buff)
             }
 
             WardenCheckResult const* rs = sWardenCheckMgr->GetWardenResultById(checkId);
-            if (memcmp(buff.contents() + buff.rpos(), rs->Result.ToByteArray<20>(false).data(), Acore::Crypto::Constants::SHA1_DIGEST_LENGTH_BYTES) != 0) // SHA1
+            if (memcmp(buff.contents() + buff.rpos(), rs->ResultBytes.data(), Acore::Crypto::Constants::SHA1_DIGEST_LENGTH_BYTES) != 0) // SHA1
             {
                 LOG_DEBUG("warden", "RESULT MPQ_CHECK fail, CheckId {} account Id {}", checkId, _session->GetAccountId());
                 checkFailed = checkId;
@@ -748,7 +752,7 @@ void WardenWin::HandleData(ByteBuffer& buff)
 
     if (checkFailed > 0 && !_interrupted)
     {
-        ApplyPenalty(checkFailed, "");
+        QueuePenalty(checkFailed, "");
     }
 
     if (_interrupted)
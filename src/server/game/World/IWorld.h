@@ -25,10 +25,12 @@
 #include "QueryResult.h"
 #include "SharedDefines.h"
 #include <atomic>
+#include <functional>
 #include <list>
 #include <map>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 class WorldPacket;
 class WorldSession;
@@ -55,6 +57,9 @@ private:
 
 typedef std::unordered_map<uint32, WorldSession*> SessionMap;
 
+// Runs off the world thread and returns the step that swaps the result in, which runs on the world thread
+typedef std::function<std::function<void()>()> BackgroundReloadBuilder;
+
 // ServerMessages.dbc
 enum ServerMessageType
 {
@@ -144,6 +149,7 @@ enum WorldBoolConfigs
     CONFIG_PDUMP_NO_PATHS,
     CONFIG_PDUMP_NO_OVERWRITE,
     CONFIG_ENABLE_MMAPS, // pussywizard
+    CONFIG_MMAP_MAPPED_TILES,
     CONFIG_ENABLE_LOGIN_AFTER_DC, // pussywizard
     CONFIG_DONT_CACHE_RANDOM_MOVEMENT_PATHS, // pussywizard
     CONFIG_QUEST_IGNORE_AUTO_ACCEPT,
@@ -160,6 +166,7 @@ enum WorldBoolConfigs
     CONFIG_CLOSE_IDLE_CONNECTIONS,
     CONFIG_LFG_LOCATION_ALL, // Player can join LFG anywhere
     CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS,
+    CONFIG_STAGED_GRID_LOADING,
     CONFIG_ALLOW_TWO_SIDE_INTERACTION_EMOTE,
     CONFIG_ITEMDELETE_METHOD,
     CONFIG_ITEMDELETE_VENDOR,
@@ -182,9 +189,14 @@ enum WorldBoolConfigs
     CONFIG_OBJECT_SPARKLES,
     CONFIG_LOW_LEVEL_REGEN_BOOST,
     CONFIG_OBJECT_QUEST_MARKERS,
+    CONFIG_VISIBILITY_INCREMENTAL,
     CONFIG_STRICT_NAMES_RESERVED,
     CONFIG_STRICT_NAMES_PROFANITY,
     CONFIG_ALLOWS_RANK_MOD_FOR_PET_HEALTH,
+    CONFIG_OPCODE_STATS,
+    CONFIG_COALESCE_MOVEMENT_HEARTBEATS,
+    CONFIG_MAP_WORKER_HEAP_ARENAS,
+    CONFIG_COMBAT_LOG_AGGREGATE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -203,12 +215,19 @@ enum WorldFloatConfigs
     CONFIG_ARENA_WIN_RATING_MODIFIER_2,
     CONFIG_ARENA_LOSE_RATING_MODIFIER,
     CONFIG_ARENA_MATCHMAKER_RATING_MODIFIER,
+    CONFIG_PLAYER_TERRAIN_UPDATE_DISTANCE,
+    CONFIG_COMBAT_LOG_RANGE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
 enum WorldIntConfigs
 {
     CONFIG_COMPRESSION = 0,
+    CONFIG_COMPRESSION_THRESHOLD,
+    CONFIG_SEND_QUEUE_SOFT_LIMIT,
+    CONFIG_SEND_QUEUE_HARD_LIMIT,
+    CONFIG_MAX_PLAYER_LOGINS_PER_UPDATE,
+    CONFIG_PLAYER_LOGIN_TIME_PER_UPDATE,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
@@ -250,6 +269,7 @@ enum WorldIntConfigs
     CONFIG_INSTANCE_RESET_TIME_HOUR,
     CONFIG_INSTANCE_RESET_TIME_RELATIVE_TIMESTAMP,
     CONFIG_INSTANCE_UNLOAD_DELAY,
+    CONFIG_INSTANCE_IDLE_MAP_POOL_SIZE,
     CONFIG_MAX_PRIMARY_TRADE_SKILL,
     CONFIG_MIN_PETITION_SIGNS,
     CONFIG_GM_LOGIN_STATE,
@@ -261,6 +281,7 @@ enum WorldIntConfigs
     CONFIG_GM_LEVEL_IN_WHO_LIST,
     CONFIG_START_GM_LEVEL,
     CONFIG_GROUP_VISIBILITY,
+    CONFIG_VISIBILITY_PLAYER_BUDGET,
     CONFIG_MAIL_DELIVERY_DELAY,
     CONFIG_UPTIME_UPDATE,
     CONFIG_SKILL_CHANCE_ORANGE,
@@ -281,6 +302,7 @@ enum WorldIntConfigs
     CONFIG_CHATFLOOD_ADDON_MESSAGE_DELAY,
     CONFIG_CHATFLOOD_MUTE_TIME,
     CONFIG_EVENT_ANNOUNCE,
+    CONFIG_EVENT_MAP_ACTIONS_PER_UPDATE,
     CONFIG_CREATURE_FAMILY_ASSISTANCE_DELAY,
     CONFIG_CREATURE_FAMILY_ASSISTANCE_PERIOD,
     CONFIG_CREATURE_FAMILY_FLEE_DELAY,
@@ -338,6 +360,21 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_NUMTHREADS_MAP_REGIONS,
+    CONFIG_NUMTHREADS_CONTINENT_MAPS,
+    CONFIG_NUMTHREADS_DUNGEON_MAPS,
+    CONFIG_NUMTHREADS_RAID_MAPS,
+    CONFIG_NUMTHREADS_BATTLEGROUND_MAPS,
+    CONFIG_NUMTHREADS_ARENA_MAPS,
+    CONFIG_NUMTHREADS_PATHFINDING,
+    CONFIG_NUMTHREADS_GRID_PREFETCH,
+    CONFIG_MMAP_PATH_CACHE_SIZE,
+    CONFIG_VMAP_QUERY_CACHE_SIZE,
+    CONFIG_NUMTHREADS_SESSIONS,
+    CONFIG_NUMTHREADS_STARTUP_LOADERS,
+    CONFIG_MAP_IDLE_OBJECT_UPDATE_INTERVAL,
+    CONFIG_MAP_IDLE_CREATURE_UPDATE_INTERVAL,
+    CONFIG_RESPAWN_SAVE_INTERVAL,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_TELEPORT_TIMEOUT_NEAR, // pussywizard
@@ -347,6 +384,7 @@ enum WorldIntConfigs
     CONFIG_GUILD_EVENT_LOG_COUNT,
     CONFIG_GUILD_BANK_EVENT_LOG_COUNT,
     CONFIG_MIN_LEVEL_STAT_SAVE,
+    CONFIG_ACHIEVEMENT_STATISTIC_SAVE_THRESHOLD,
     CONFIG_RANDOM_BG_RESET_HOUR,
     CONFIG_CALENDAR_DELETE_OLD_EVENTS_HOUR,
     CONFIG_GUILD_RESET_HOUR,
@@ -419,6 +457,9 @@ enum WorldIntConfigs
     CONFIG_WATER_BREATH_TIMER,
     CONFIG_AUCTION_HOUSE_SEARCH_TIMEOUT,
     CONFIG_DAILY_RBG_MIN_LEVEL_AP_REWARD,
+    CONFIG_GROUP_OUT_OF_RANGE_UPDATE_MEMBERS,
+    CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL,
+    CONFIG_TRANSPORT_PASSENGER_UPDATE_INTERVAL,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -552,6 +593,9 @@ public:
     virtual bool RemoveQueuedPlayer(WorldSession* session) = 0;
     virtual int32 GetQueuePos(WorldSession*) = 0;
     virtual bool HasRecentlyDisconnected(WorldSession*) = 0;
+    virtual bool TryStartPlayerLogin() = 0;
+    [[nodiscard]] virtual bool CanFinishPlayerLogin() const = 0;
+    virtual void AddPlayerLoginTime(Microseconds time) = 0;
     [[nodiscard]] virtual bool getAllowMovement() const = 0;
     virtual void SetAllowMovement(bool allow) = 0;
     virtual void SetNewCharString(std::string const& str) = 0;
@@ -598,6 +642,8 @@ public:
     virtual uint32 GetNextWhoListUpdateDelaySecs() = 0;
     virtual void ProcessCliCommands() = 0;
     virtual void QueueCliCommand(CliCommandHolder* commandHolder) = 0;
+    virtual void QueueCliCommands(std::vector<CliCommandHolder*> const& commandHolders) = 0;
+    virtual bool QueueBackgroundReload(std::string const& name, BackgroundReloadBuilder builder) = 0;
     virtual void ForceGameEventUpdate() = 0;
     virtual void UpdateRealmCharCount(uint32 accid) = 0;
     [[nodiscard]] virtual LocaleConstant GetAvailableDbcLocale(LocaleConstant locale) const = 0;
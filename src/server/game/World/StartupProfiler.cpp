@@ -0,0 +1,216 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StartupProfiler.h"
+#include "Config.h"
+#include "GitRevision.h"
+#include "Log.h"
+#include "MySQLConnection.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    std::string EscapeJson(std::string_view text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+
+        return escaped;
+    }
+
+    double ToMS(uint64 microseconds)
+    {
+        return double(microseconds) / 1000.0;
+    }
+}
+
+StartupProfiler* StartupProfiler::instance()
+{
+    static StartupProfiler instance;
+    return &instance;
+}
+
+void StartupProfiler::Initialize()
+{
+    _enabled = sConfigMgr->GetOption<bool>("StartupProfiler.Enable", false);
+    _file = sConfigMgr->GetOption<std::string>("StartupProfiler.File", "");
+    _stages.clear();
+    _stageOpen = false;
+
+    if (_enabled)
+        _start = TakeSample();
+}
+
+void StartupProfiler::BeginStage(std::string_view name)
+{
+    LOG_INFO("server.loading", "{}", name);
+
+    if (!_enabled)
+        return;
+
+    EndStage();
+
+    Stage& stage = _stages.emplace_back();
+    stage.Name = name;
+    stage.Begin = TakeSample();
+    _stageOpen = true;
+}
+
+void StartupProfiler::Finish()
+{
+    if (!_enabled)
+        return;
+
+    EndStage();
+    LogSummary();
+
+    if (!_file.empty())
+        WriteTimeline();
+
+    _enabled = false;
+}
+
+StartupProfiler::Sample StartupProfiler::TakeSample()
+{
+    Sample sample;
+    sample.WallMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+    {
+        // FILETIME counts 100 ns intervals
+        auto toMicroseconds = [](FILETIME const& time) { return ((uint64(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10; };
+        sample.CpuMicroseconds = toMicroseconds(kernel) + toMicroseconds(user);
+    }
+
+    PROCESS_MEMORY_COUNTERS memory;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &memory, sizeof(memory)))
+        sample.PeakRssKB = memory.PeakWorkingSetSize / 1024;
+#else
+    rusage usage;
+    if (!getrusage(RUSAGE_SELF, &usage))
+    {
+        sample.CpuMicroseconds = uint64(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#ifdef __APPLE__
+        sample.PeakRssKB = uint64(usage.ru_maxrss) / 1024; // bytes on macOS
+#else
+        sample.PeakRssKB = uint64(usage.ru_maxrss);
+#endif
+    }
+#endif
+
+    MySQLQueryTotals const queries = MySQLConnection::GetQueryTotals();
+    sample.DbMicroseconds = queries.Microseconds;
+    sample.Queries = queries.Queries;
+    sample.Rows = queries.Rows;
+    return sample;
+}
+
+void StartupProfiler::EndStage()
+{
+    if (!_stageOpen)
+        return;
+
+    _stages.back().End = TakeSample();
+    _stageOpen = false;
+}
+
+void StartupProfiler::LogSummary() const
+{
+    static size_t const MAX_SUMMARY_STAGES = 20;
+
+    std::vector<Stage const*> sorted;
+    sorted.reserve(_stages.size());
+    for (Stage const& stage : _stages)
+        sorted.push_back(&stage);
+
+    std::sort(sorted.begin(), sorted.end(), [](Stage const* left, Stage const* right)
+    {
+        return left->End.WallMicroseconds - left->Begin.WallMicroseconds > right->End.WallMicroseconds - right->Begin.WallMicroseconds;
+    });
+
+    if (sorted.size() > MAX_SUMMARY_STAGES)
+        sorted.resize(MAX_SUMMARY_STAGES);
+
+    LOG_INFO("server.loading", " ");
+    LOG_INFO("server.loading", "Slowest of {} startup stages:", _stages.size());
+    LOG_INFO("server.loading", "{:>10} {:>10} {:>10} {:>8} {:>10} {:>10}  {}", "wall ms", "cpu ms", "db ms", "queries", "rows", "rss +KB", "stage");
+
+    auto logLine = [](std::string_view name, Sample const& begin, Sample const& end)
+    {
+        LOG_INFO("server.loading", "{:>10.1f} {:>10.1f} {:>10.1f} {:>8} {:>10} {:>10}  {}",
+            ToMS(end.WallMicroseconds - begin.WallMicroseconds), ToMS(end.CpuMicroseconds - begin.CpuMicroseconds),
+            ToMS(end.DbMicroseconds - begin.DbMicroseconds), end.Queries - begin.Queries, end.Rows - begin.Rows,
+            end.PeakRssKB - begin.PeakRssKB, name);
+    };
+
+    for (Stage const* stage : sorted)
+        logLine(stage->Name, stage->Begin, stage->End);
+
+    if (!_stages.empty())
+        logLine("Total", _start, _stages.back().End);
+
+    LOG_INFO("server.loading", " ");
+}
+
+void StartupProfiler::WriteTimeline() const
+{
+    std::ofstream out(_file, std::ios::out | std::ios::trunc);
+    if (!out)
+    {
+        LOG_ERROR("server.loading", "StartupProfiler: Could not write the startup timeline to {}", _file);
+        return;
+    }
+
+    Sample const& end = _stages.empty() ? _start : _stages.back().End;
+
+    out << Acore::StringFormatFmt("{{\n  \"revision\": \"{}\",\n  \"wall_ms\": {:.3f},\n  \"cpu_ms\": {:.3f},\n  \"db_ms\": {:.3f},\n  \"peak_rss_kb\": {},\n  \"stages\": [\n",
+        EscapeJson(GitRevision::GetFullVersion()), ToMS(end.WallMicroseconds - _start.WallMicroseconds), ToMS(end.CpuMicroseconds - _start.CpuMicroseconds),
+        ToMS(end.DbMicroseconds - _start.DbMicroseconds), end.PeakRssKB);
+
+    for (size_t i = 0; i < _stages.size(); ++i)
+    {
+        Stage const& stage = _stages[i];
+        out << Acore::StringFormatFmt("    {{ \"name\": \"{}\", \"start_ms\": {:.3f}, \"wall_ms\": {:.3f}, \"cpu_ms\": {:.3f}, \"db_ms\": {:.3f}, "
+            "\"queries\": {}, \"rows\": {}, \"peak_rss_delta_kb\": {} }}{}\n",
+            EscapeJson(stage.Name), ToMS(stage.Begin.WallMicroseconds - _start.WallMicroseconds),
+            ToMS(stage.End.WallMicroseconds - stage.Begin.WallMicroseconds), ToMS(stage.End.CpuMicroseconds - stage.Begin.CpuMicroseconds),
+            ToMS(stage.End.DbMicroseconds - stage.Begin.DbMicroseconds), stage.End.Queries - stage.Begin.Queries,
+            stage.End.Rows - stage.Begin.Rows, stage.End.PeakRssKB - stage.Begin.PeakRssKB, i + 1 < _stages.size() ? "," : "");
+    }
+
+    out << "  ]\n}\n";
+
+    LOG_INFO("server.loading", "StartupProfiler: Wrote the startup timeline to {}", _file);
+}
@@ -0,0 +1,80 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _STARTUP_PROFILER_H_INCLUDED
+#define _STARTUP_PROFILER_H_INCLUDED
+
+#include "Define.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Splits World::SetInitialWorldSettings into stages and records what every stage cost:
+ * wall time, process CPU time, time spent in synchronous queries, rows read and how much
+ * the peak resident set grew. A stage starts with its "Loading ..." line and ends where
+ * the next one starts. Loader threads are included in the CPU and query totals of the
+ * stage that started them. With StartupProfiler.Enable = 0 a stage only logs its name.
+ */
+class StartupProfiler
+{
+public:
+    static StartupProfiler* instance();
+
+    // Reads the config, called before the first stage
+    void Initialize();
+
+    // Logs the name to server.loading and starts a new stage, ending the current one
+    void BeginStage(std::string_view name);
+
+    // Ends the last stage, logs the summary table and writes the timeline to StartupProfiler.File
+    void Finish();
+
+private:
+    struct Sample
+    {
+        uint64 WallMicroseconds = 0;
+        uint64 CpuMicroseconds = 0;
+        uint64 DbMicroseconds = 0;
+        uint64 Queries = 0;
+        uint64 Rows = 0;
+        uint64 PeakRssKB = 0;
+    };
+
+    struct Stage
+    {
+        std::string Name;
+        Sample Begin;
+        Sample End;
+    };
+
+    static Sample TakeSample();
+
+    void EndStage();
+    void LogSummary() const;
+    void WriteTimeline() const;
+
+    bool _enabled = false;
+    std::string _file;
+    Sample _start;
+    std::vector<Stage> _stages;
+    bool _stageOpen = false;
+};
+
+#define sStartupProfiler StartupProfiler::instance()
+
+#endif // _STARTUP_PROFILER_H_INCLUDED
@@ -32,6 +32,7 @@
 #include "CalendarMgr.h"
 #include "Channel.h"
 #include "ChannelMgr.h"
+#include "CharacterCache.h"
 #include "CharacterDatabaseCleaner.h"
 #include "Chat.h"
 #include "ChatPackets.h"
@@ -62,6 +63,8 @@
 #include "M2Stores.h"
 #include "MMapFactory.h"
 #include "MapMgr.h"
+#include "MapRegionUpdater.h"
+#include "MemoryAccounting.h"
 #include "Metric.h"
 #include "MotdMgr.h"
 #include "ObjectMgr.h"
@@ -73,10 +76,13 @@
 #include "PoolMgr.h"
 #include "Realm.h"
 #include "ScriptMgr.h"
+#include "ScriptReloadMgr.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
+#include "Spell.h"
 #include "SpellMgr.h"
+#include "StartupProfiler.h"
 #include "TaskScheduler.h"
 #include "TicketMgr.h"
 #include "Transport.h"
@@ -92,13 +98,38 @@
 #include "WeatherMgr.h"
 #include "WhoListCacheMgr.h"
 #include "WorldPacket.h"
+#include "WorldLoadGraph.h"
 #include "WorldSession.h"
+#include "WorldSnapshot.h"
+#include "ZoneProfiler.h"
 #include <boost/asio/ip/address.hpp>
 #include <cmath>
 
 namespace
 {
     TaskScheduler playersSaveScheduler;
+
+    void RegisterMemoryEstimators()
+    {
+        sMemoryAccounting->Register("maps", []()
+        {
+            std::size_t size = 0;
+            sMapMgr->DoForAllMaps([&size](Map* map)
+            {
+                size += sizeof(Map) + map->GetLoadedGridCount() * sizeof(NGridType);
+            });
+            return size;
+        });
+        sMemoryAccounting->Register("terrain", []() { return GridMap::GetLoadedBytes(); });
+        sMemoryAccounting->Register("mmaps", []() { return MMAP::MMapFactory::createOrGetMMapMgr()->GetLoadedTileBytes(); });
+        sMemoryAccounting->Register("creatures", []() { return Creature::GetPoolReservedBytes(); });
+        sMemoryAccounting->Register("gameobjects", []() { return GameObject::GetPoolReservedBytes(); });
+        sMemoryAccounting->Register("spells", []() { return Spell::GetPoolReservedBytes(); });
+        sMemoryAccounting->Register("movement", []() { return MovementGenerator::GetPoolReservedBytes(); });
+        sMemoryAccounting->Register("sessions", []() { return sWorld->GetActiveAndQueuedSessionCount() * sizeof(WorldSession); });
+        sMemoryAccounting->Register("character_cache", []() { return sCharacterCache->GetMemoryUsage(); });
+        sMemoryAccounting->Register("auctions", []() { return sAuctionMgr->GetMemoryUsage(); });
+    }
 }
 
 std::atomic_long World::_stopEvent = false;
@@ -115,6 +146,8 @@ Realm realm;
 World::World()
 {
     _playerLimit = 0;
+    _playerLoginsThisUpdate = 0;
+    _playerLoginTimeThisUpdate = 0us;
     _allowedSecurityLevel = SEC_PLAYER;
     _allowMovement = true;
     _shutdownMask = 0;
@@ -143,6 +176,9 @@ World::World()
 /// World destructor
 World::~World()
 {
+    if (_sessionPacketUpdater)
+        _sessionPacketUpdater->deactivate();
+
     ///- Empty the kicked session set
     while (!_sessions.empty())
     {
@@ -343,6 +379,22 @@ bool World::HasRecentlyDisconnected(WorldSession* session)
     return false;
 }
 
+bool World::TryStartPlayerLogin()
+{
+    uint32 limit = getIntConfig(CONFIG_MAX_PLAYER_LOGINS_PER_UPDATE);
+    if ((limit && _playerLoginsThisUpdate >= limit) || !CanFinishPlayerLogin())
+        return false;
+
+    ++_playerLoginsThisUpdate;
+    return true;
+}
+
+bool World::CanFinishPlayerLogin() const
+{
+    uint32 budget = getIntConfig(CONFIG_PLAYER_LOGIN_TIME_PER_UPDATE);
+    return !budget || _playerLoginTimeThisUpdate < Milliseconds(budget);
+}
+
 int32 World::GetQueuePos(WorldSession* sess)
 {
     uint32 position = 1;
@@ -637,6 +689,7 @@ void World::LoadConfigSettings(bool reload)
         LOG_ERROR("server.loading", "Compression level ({}) must be in range 1..9. Using default compression level (1).", _int_configs[CONFIG_COMPRESSION]);
         _int_configs[CONFIG_COMPRESSION] = 1;
     }
+    _int_configs[CONFIG_COMPRESSION_THRESHOLD] = sConfigMgr->GetOption<int32>("Compression.Threshold", 100);
     _bool_configs[CONFIG_ADDON_CHANNEL]                   = sConfigMgr->GetOption<bool>("AddonChannel", true);
     _bool_configs[CONFIG_CLEAN_CHARACTER_DB]              = sConfigMgr->GetOption<bool>("CleanCharacterDB", false);
     _int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetOption<int32>("PersistentCharacterCleanFlags", 0);
@@ -662,6 +715,8 @@ void World::LoadConfigSettings(bool reload)
         _int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] = 0;
     }
 
+    _int_configs[CONFIG_ACHIEVEMENT_STATISTIC_SAVE_THRESHOLD] = sConfigMgr->GetOption<int32>("PlayerSave.Statistics.SaveThreshold", 5);
+
     _int_configs[CONFIG_INTERVAL_MAPUPDATE] = sConfigMgr->GetOption<int32>("MapUpdateInterval", 10);
     if (_int_configs[CONFIG_INTERVAL_MAPUPDATE] < MIN_MAP_UPDATE_DELAY)
     {
@@ -900,6 +955,7 @@ void World::LoadConfigSettings(bool reload)
     _int_configs[CONFIG_INSTANCE_RESET_TIME_HOUR]               = sConfigMgr->GetOption<int32>("Instance.ResetTimeHour", 4);
     _int_configs[CONFIG_INSTANCE_RESET_TIME_RELATIVE_TIMESTAMP] = sConfigMgr->GetOption<int32>("Instance.ResetTimeRelativeTimestamp", 1135814400);
     _int_configs[CONFIG_INSTANCE_UNLOAD_DELAY]                  = sConfigMgr->GetOption<int32>("Instance.UnloadDelay", 30 * MINUTE * IN_MILLISECONDS);
+    _int_configs[CONFIG_INSTANCE_IDLE_MAP_POOL_SIZE]            = sConfigMgr->GetOption<uint32>("Instance.IdleMapPool.Size", 0);
 
     _int_configs[CONFIG_MAX_PRIMARY_TRADE_SKILL] = sConfigMgr->GetOption<int32>("MaxPrimaryTradeSkill", 2);
     _int_configs[CONFIG_MIN_PETITION_SIGNS]      = sConfigMgr->GetOption<int32>("MinPetitionSigns", 9);
@@ -941,6 +997,17 @@ void World::LoadConfigSettings(bool reload)
 
     _bool_configs[CONFIG_OBJECT_QUEST_MARKERS] = sConfigMgr->GetOption<bool>("Visibility.ObjectQuestMarkers", true);
 
+    _bool_configs[CONFIG_VISIBILITY_INCREMENTAL] = sConfigMgr->GetOption<bool>("Visibility.Incremental", false);
+    _int_configs[CONFIG_VISIBILITY_PLAYER_BUDGET] = sConfigMgr->GetOption<uint32>("Visibility.PlayerBudget", 0);
+
+    _bool_configs[CONFIG_COMBAT_LOG_AGGREGATE] = sConfigMgr->GetOption<bool>("CombatLog.Aggregate", false);
+    _float_configs[CONFIG_COMBAT_LOG_RANGE] = sConfigMgr->GetOption<float>("CombatLog.Range", 0.0f);
+    if (_float_configs[CONFIG_COMBAT_LOG_RANGE] < 0.0f)
+    {
+        LOG_ERROR("server.loading", "CombatLog.Range ({}) must be >= 0. Using 0 instead.", _float_configs[CONFIG_COMBAT_LOG_RANGE]);
+        _float_configs[CONFIG_COMBAT_LOG_RANGE] = 0.0f;
+    }
+
     _int_configs[CONFIG_MAIL_DELIVERY_DELAY]   = sConfigMgr->GetOption<int32>("MailDeliveryDelay", HOUR);
 
     _int_configs[CONFIG_UPTIME_UPDATE]         = sConfigMgr->GetOption<int32>("UpdateUptimeInterval", 10);
@@ -1029,6 +1096,7 @@ void World::LoadConfigSettings(bool reload)
     _int_configs[CONFIG_CHAT_TIME_MUTE_FIRST_LOGIN] = sConfigMgr->GetOption<int32>("Chat.MuteTimeFirstLogin", 120);
 
     _int_configs[CONFIG_EVENT_ANNOUNCE] = sConfigMgr->GetOption<int32>("Event.Announce", 0);
+    _int_configs[CONFIG_EVENT_MAP_ACTIONS_PER_UPDATE] = sConfigMgr->GetOption<int32>("Event.MapActionsPerUpdate", 200);
 
     _float_configs[CONFIG_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS] = sConfigMgr->GetOption<float>("CreatureFamilyFleeAssistanceRadius", 30.0f);
     _float_configs[CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS]      = sConfigMgr->GetOption<float>("CreatureFamilyAssistanceRadius", 10.0f);
@@ -1275,6 +1343,8 @@ void World::LoadConfigSettings(bool reload)
     _bool_configs[CONFIG_ALLOW_JOIN_BG_AND_LFG] = sConfigMgr->GetOption<bool>("JoinBGAndLFG.Enable", false);
 
     _bool_configs[CONFIG_LEAVE_GROUP_ON_LOGOUT] = sConfigMgr->GetOption<bool>("LeaveGroupOnLogout.Enabled", false);
+    _int_configs[CONFIG_GROUP_OUT_OF_RANGE_UPDATE_MEMBERS] = sConfigMgr->GetOption<uint32>("Group.OutOfRangeUpdate.Members", 10);
+    _int_configs[CONFIG_GROUP_OUT_OF_RANGE_UPDATE_INTERVAL] = sConfigMgr->GetOption<uint32>("Group.OutOfRangeUpdate.Interval", 1000);
 
     _bool_configs[CONFIG_QUEST_POI_ENABLED] = sConfigMgr->GetOption<bool>("QuestPOI.Enabled", true);
 
@@ -1318,6 +1388,8 @@ void World::LoadConfigSettings(bool reload)
     bool enablePetLOS = sConfigMgr->GetOption<bool>("vmap.petLOS", true);
     _bool_configs[CONFIG_VMAP_BLIZZLIKE_PVP_LOS] = sConfigMgr->GetOption<bool>("vmap.BlizzlikePvPLOS", true);
     _bool_configs[CONFIG_VMAP_BLIZZLIKE_LOS_OPEN_WORLD] = sConfigMgr->GetOption<bool>("vmap.BlizzlikeLOSInOpenWorld", true);
+    _int_configs[CONFIG_VMAP_QUERY_CACHE_SIZE] = sConfigMgr->GetOption<int32>("vmap.QueryCacheSize", 1024);
+    _float_configs[CONFIG_PLAYER_TERRAIN_UPDATE_DISTANCE] = sConfigMgr->GetOption<float>("Player.TerrainUpdateDistance", 0.5f);
 
     if (!enableHeight)
         LOG_ERROR("server.loading", "VMap height checking disabled! Creatures movements and other various things WILL be broken! Expect no support.");
@@ -1345,6 +1417,31 @@ void World::LoadConfigSettings(bool reload)
     _bool_configs[CONFIG_SHOW_MUTE_IN_WORLD]         = sConfigMgr->GetOption<bool>("ShowMuteInWorld", false);
     _bool_configs[CONFIG_SHOW_BAN_IN_WORLD]          = sConfigMgr->GetOption<bool>("ShowBanInWorld", false);
     _int_configs[CONFIG_NUMTHREADS]                  = sConfigMgr->GetOption<int32>("MapUpdate.Threads", 1);
+    _int_configs[CONFIG_NUMTHREADS_MAP_REGIONS]      = sConfigMgr->GetOption<int32>("MapUpdate.RegionThreads", 0);
+    _int_configs[CONFIG_NUMTHREADS_CONTINENT_MAPS]   = sConfigMgr->GetOption<int32>("MapUpdate.Threads.Continent", 0);
+    _int_configs[CONFIG_NUMTHREADS_DUNGEON_MAPS]     = sConfigMgr->GetOption<int32>("MapUpdate.Threads.Dungeon", 0);
+    _int_configs[CONFIG_NUMTHREADS_RAID_MAPS]        = sConfigMgr->GetOption<int32>("MapUpdate.Threads.Raid", 0);
+    _int_configs[CONFIG_NUMTHREADS_BATTLEGROUND_MAPS] = sConfigMgr->GetOption<int32>("MapUpdate.Threads.Battleground", 0);
+    _int_configs[CONFIG_NUMTHREADS_ARENA_MAPS]       = sConfigMgr->GetOption<int32>("MapUpdate.Threads.Arena", 0);
+    _int_configs[CONFIG_NUMTHREADS_PATHFINDING]      = sConfigMgr->GetOption<int32>("MoveMaps.AsyncThreads", 0);
+    _int_configs[CONFIG_NUMTHREADS_GRID_PREFETCH]    = sConfigMgr->GetOption<int32>("MapUpdate.PrefetchThreads", 0);
+    _bool_configs[CONFIG_MAP_WORKER_HEAP_ARENAS]      = sConfigMgr->GetOption<bool>("MapUpdate.HeapArenas", false);
+    _int_configs[CONFIG_NUMTHREADS_SESSIONS]         = sConfigMgr->GetOption<int32>("SessionUpdate.Threads", 0);
+    _int_configs[CONFIG_NUMTHREADS_STARTUP_LOADERS]  = sConfigMgr->GetOption<int32>("StartupLoader.Threads", 1);
+    _int_configs[CONFIG_MAP_IDLE_OBJECT_UPDATE_INTERVAL] = sConfigMgr->GetOption<int32>("MapUpdate.IdleObjectInterval", 1);
+    if (_int_configs[CONFIG_MAP_IDLE_OBJECT_UPDATE_INTERVAL] < 1 || _int_configs[CONFIG_MAP_IDLE_OBJECT_UPDATE_INTERVAL] > MAX_IDLE_OBJECT_UPDATE_INTERVAL)
+    {
+        LOG_ERROR("server.loading", "MapUpdate.IdleObjectInterval ({}) must be in range 1..{}. Set to 1.", _int_configs[CONFIG_MAP_IDLE_OBJECT_UPDATE_INTERVAL], MAX_IDLE_OBJECT_UPDATE_INTERVAL);
+        _int_configs[CONFIG_MAP_IDLE_OBJECT_UPDATE_INTERVAL] = 1;
+    }
+
+    _int_configs[CONFIG_MAP_IDLE_CREATURE_UPDATE_INTERVAL] = sConfigMgr->GetOption<int32>("MapUpdate.IdleCreatureInterval", 1);
+    if (_int_configs[CONFIG_MAP_IDLE_CREATURE_UPDATE_INTERVAL] < 1 || _int_configs[CONFIG_MAP_IDLE_CREATURE_UPDATE_INTERVAL] > MAX_IDLE_OBJECT_UPDATE_INTERVAL)
+    {
+        LOG_ERROR("server.loading", "MapUpdate.IdleCreatureInterval ({}) must be in range 1..{}. Set to 1.", _int_configs[CONFIG_MAP_IDLE_CREATURE_UPDATE_INTERVAL], MAX_IDLE_OBJECT_UPDATE_INTERVAL);
+        _int_configs[CONFIG_MAP_IDLE_CREATURE_UPDATE_INTERVAL] = 1;
+    }
+    _int_configs[CONFIG_RESPAWN_SAVE_INTERVAL]       = sConfigMgr->GetOption<int32>("Respawn.SaveInterval", 10000);
     _int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetOption<int32>("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1384,6 +1481,8 @@ void World::LoadConfigSettings(bool reload)
     _bool_configs[CONFIG_PDUMP_NO_PATHS]     = sConfigMgr->GetOption<bool>("PlayerDump.DisallowPaths", true);
     _bool_configs[CONFIG_PDUMP_NO_OVERWRITE] = sConfigMgr->GetOption<bool>("PlayerDump.DisallowOverwrite", true);
     _bool_configs[CONFIG_ENABLE_MMAPS]       = sConfigMgr->GetOption<bool>("MoveMaps.Enable", true);
+    _int_configs[CONFIG_MMAP_PATH_CACHE_SIZE] = sConfigMgr->GetOption<int32>("MoveMaps.PathCacheSize", 512);
+    _bool_configs[CONFIG_MMAP_MAPPED_TILES]  = sConfigMgr->GetOption<bool>("MoveMaps.MappedTiles", false);
     MMAP::MMapFactory::InitializeDisabledMaps();
 
     // Wintergrasp
@@ -1400,6 +1499,7 @@ void World::LoadConfigSettings(bool reload)
 
     _bool_configs[CONFIG_ENABLE_CONTINENT_TRANSPORT]            = sConfigMgr->GetOption<bool>("IsContinentTransport.Enabled", true);
     _bool_configs[CONFIG_ENABLE_CONTINENT_TRANSPORT_PRELOADING] = sConfigMgr->GetOption<bool>("IsPreloadedContinentTransport.Enabled", false);
+    _int_configs[CONFIG_TRANSPORT_PASSENGER_UPDATE_INTERVAL]    = sConfigMgr->GetOption<uint32>("Transport.PassengerUpdateInterval", 200);
 
     _bool_configs[CONFIG_IP_BASED_ACTION_LOGGING] = sConfigMgr->GetOption<bool>("Allow.IP.Based.Action.Logging", false);
 
@@ -1417,6 +1517,7 @@ void World::LoadConfigSettings(bool reload)
 
     // Preload all grids of all non-instanced maps
     _bool_configs[CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS] = sConfigMgr->GetOption<bool>("PreloadAllNonInstancedMapGrids", false);
+    _bool_configs[CONFIG_STAGED_GRID_LOADING] = sConfigMgr->GetOption<bool>("StagedGridLoading", false);
 
     // ICC buff override
     _int_configs[CONFIG_ICC_BUFF_HORDE] = sConfigMgr->GetOption<int32>("ICC.Buff.Horde", 73822);
@@ -1432,6 +1533,13 @@ void World::LoadConfigSettings(bool reload)
 
     _int_configs[CONFIG_PACKET_SPOOF_BANDURATION] = sConfigMgr->GetOption<int32>("PacketSpoof.BanDuration", 86400);
 
+    _bool_configs[CONFIG_OPCODE_STATS] = sConfigMgr->GetOption<bool>("Network.OpcodeStats", false);
+    _int_configs[CONFIG_SEND_QUEUE_SOFT_LIMIT] = sConfigMgr->GetOption<int32>("Network.SendQueue.SoftLimit", 1048576);
+    _int_configs[CONFIG_SEND_QUEUE_HARD_LIMIT] = sConfigMgr->GetOption<int32>("Network.SendQueue.HardLimit", 67108864);
+    _int_configs[CONFIG_MAX_PLAYER_LOGINS_PER_UPDATE] = sConfigMgr->GetOption<int32>("PlayerLimit.LoginsPerUpdate", 10);
+    _int_configs[CONFIG_PLAYER_LOGIN_TIME_PER_UPDATE] = sConfigMgr->GetOption<int32>("PlayerLimit.LoginTimePerUpdate", 25);
+    _bool_configs[CONFIG_COALESCE_MOVEMENT_HEARTBEATS] = sConfigMgr->GetOption<bool>("Network.CoalesceMovementHeartbeats", true);
+
     // Random Battleground Rewards
     _int_configs[CONFIG_BG_REWARD_WINNER_HONOR_FIRST] = sConfigMgr->GetOption<int32>("Battleground.RewardWinnerHonorFirst", 30);
     _int_configs[CONFIG_BG_REWARD_WINNER_ARENA_FIRST] = sConfigMgr->GetOption<int32>("Battleground.RewardWinnerArenaFirst", 25);
@@ -1488,6 +1596,7 @@ void World::SetInitialWorldSettings()
 {
     ///- Server startup begin
     uint32 startupBegin = getMSTime();
+    sStartupProfiler->Initialize();
 
     ///- Initialize the random number generator
     srand((unsigned int)GameTime::GetGameTime().count());
@@ -1509,6 +1618,9 @@ void World::SetInitialWorldSettings()
     ///- Init highest guids before any table loading to prevent using not initialized guids in some code.
     sObjectMgr->SetHighestGuids();
 
+    ///- Key of the world snapshot, before any world table loading
+    sWorldSnapshot->Initialize();
+
     if (!sConfigMgr->isDryRun())
     {
         ///- Check the existence of the map files for all starting areas.
@@ -1534,7 +1646,7 @@ void World::SetInitialWorldSettings()
 
     ///- Loading strings. Getting no records means core load has to be canceled because no error message can be output.
     LOG_INFO("server.loading", " ");
-    LOG_INFO("server.loading", "Loading Acore Strings...");
+    sStartupProfiler->BeginStage("Loading Acore Strings...");
     if (!sObjectMgr->LoadAcoreStrings())
         exit(1);                                            // Error message displayed in function already
 
@@ -1556,7 +1668,7 @@ void World::SetInitialWorldSettings()
     sScriptMgr->OnLoadCustomDatabaseTable();
 
     ///- Load the DBC files
-    LOG_INFO("server.loading", "Initialize Data Stores...");
+    sStartupProfiler->BeginStage("Initialize Data Stores...");
     LoadDBCStores(_dataPath);
     DetectDBCLang();
 
@@ -1576,432 +1688,427 @@ void World::SetInitialWorldSettings()
 
     MMAP::MMapMgr* mmmgr = MMAP::MMapFactory::createOrGetMMapMgr();
     mmmgr->InitializeThreadUnsafe(mapIds);
+    mmmgr->SetPathCacheSize(getIntConfig(CONFIG_MMAP_PATH_CACHE_SIZE));
+    mmmgr->SetUseMappedTiles(getBoolConfig(CONFIG_MMAP_MAPPED_TILES));
 
-    LOG_INFO("server.loading", "Loading Game Graveyard...");
+    sStartupProfiler->BeginStage("Loading Game Graveyard...");
     sGraveyard->LoadGraveyardFromDB();
 
-    LOG_INFO("server.loading", "Initializing PlayerDump Tables...");
+    sStartupProfiler->BeginStage("Initializing PlayerDump Tables...");
     PlayerDump::InitializeTables();
 
     ///- Initilize static helper structures
     AIRegistry::Initialize();
 
-    LOG_INFO("server.loading", "Loading SpellInfo Store...");
+    sStartupProfiler->BeginStage("Loading SpellInfo Store...");
     sSpellMgr->LoadSpellInfoStore();
 
-    LOG_INFO("server.loading", "Loading Spell Cooldown Overrides...");
+    sStartupProfiler->BeginStage("Loading Spell Cooldown Overrides...");
     sSpellMgr->LoadSpellCooldownOverrides();
 
-    LOG_INFO("server.loading", "Loading SpellInfo Data Corrections...");
+    sStartupProfiler->BeginStage("Loading SpellInfo Data Corrections...");
     sSpellMgr->LoadSpellInfoCorrections();
 
-    LOG_INFO("server.loading", "Loading Spell Rank Data...");
+    sStartupProfiler->BeginStage("Loading Spell Rank Data...");
     sSpellMgr->LoadSpellRanks();
 
-    LOG_INFO("server.loading", "Loading Spell Specific And Aura State...");
+    sStartupProfiler->BeginStage("Loading Spell Specific And Aura State...");
     sSpellMgr->LoadSpellSpecificAndAuraState();
 
-    LOG_INFO("server.loading", "Loading SkillLineAbilityMultiMap Data...");
+    sStartupProfiler->BeginStage("Loading SkillLineAbilityMultiMap Data...");
     sSpellMgr->LoadSkillLineAbilityMap();
 
-    LOG_INFO("server.loading", "Loading SpellInfo Custom Attributes...");
+    sStartupProfiler->BeginStage("Loading SpellInfo Custom Attributes...");
     sSpellMgr->LoadSpellInfoCustomAttributes();
 
-    LOG_INFO("server.loading", "Loading GameObject Models...");
+    sStartupProfiler->BeginStage("Loading Spell Effect Handle Modes...");
+    sSpellMgr->LoadSpellEffectHandleModes();
+
+    sStartupProfiler->BeginStage("Loading GameObject Models...");
     LoadGameObjectModelList(_dataPath);
 
-    LOG_INFO("server.loading", "Loading Script Names...");
+    sStartupProfiler->BeginStage("Loading Script Names...");
     sObjectMgr->LoadScriptNames();
 
-    LOG_INFO("server.loading", "Loading Instance Template...");
+    sStartupProfiler->BeginStage("Loading Instance Template...");
     sObjectMgr->LoadInstanceTemplate();
 
-    LOG_INFO("server.loading", "Loading Character Cache...");
+    sStartupProfiler->BeginStage("Loading Character Cache...");
     sCharacterCache->LoadCharacterCacheStorage();
 
     // Must be called before `creature_respawn`/`gameobject_respawn` tables
-    LOG_INFO("server.loading", "Loading Instances...");
+    sStartupProfiler->BeginStage("Loading Instances...");
     sInstanceSaveMgr->LoadInstances();
 
-    LOG_INFO("server.loading", "Loading Broadcast Texts...");
-    sObjectMgr->LoadBroadcastTexts();
-    sObjectMgr->LoadBroadcastTextLocales();
-
-    LOG_INFO("server.loading", "Loading Localization Strings...");
+    sStartupProfiler->BeginStage("Loading Broadcast Texts, Localization Strings, Page Texts, Quest POI and GameTeleports...");
     uint32 oldMSTime = getMSTime();
-    sObjectMgr->LoadCreatureLocales();
-    sObjectMgr->LoadGameObjectLocales();
-    sObjectMgr->LoadItemLocales();
-    sObjectMgr->LoadItemSetNameLocales();
-    sObjectMgr->LoadQuestLocales();
-    sObjectMgr->LoadQuestOfferRewardLocale();
-    sObjectMgr->LoadQuestRequestItemsLocale();
-    sObjectMgr->LoadNpcTextLocales();
-    sObjectMgr->LoadPageTextLocales();
-    sObjectMgr->LoadGossipMenuItemsLocales();
-    sObjectMgr->LoadPointOfInterestLocales();
-    sObjectMgr->LoadPetNamesLocales();
+    {
+        // these loaders only fill their own containers, see WorldLoadGraph before adding one that reads other data
+        WorldLoadGraph loadGraph("Localization Strings");
+        loadGraph.Add("broadcast_text", [] { sObjectMgr->LoadBroadcastTexts(); });
+        loadGraph.Add("broadcast_text_locale", [] { sObjectMgr->LoadBroadcastTextLocales(); }, { "broadcast_text" });
+        loadGraph.Add("creature_template_locale", [] { sObjectMgr->LoadCreatureLocales(); });
+        loadGraph.Add("gameobject_template_locale", [] { sObjectMgr->LoadGameObjectLocales(); });
+        loadGraph.Add("item_template_locale", [] { sObjectMgr->LoadItemLocales(); });
+        loadGraph.Add("item_set_names_locale", [] { sObjectMgr->LoadItemSetNameLocales(); });
+        loadGraph.Add("quest_template_locale", [] { sObjectMgr->LoadQuestLocales(); });
+        loadGraph.Add("quest_offer_reward_locale", [] { sObjectMgr->LoadQuestOfferRewardLocale(); });
+        loadGraph.Add("quest_request_items_locale", [] { sObjectMgr->LoadQuestRequestItemsLocale(); });
+        loadGraph.Add("npc_text_locale", [] { sObjectMgr->LoadNpcTextLocales(); });
+        loadGraph.Add("page_text_locale", [] { sObjectMgr->LoadPageTextLocales(); });
+        loadGraph.Add("gossip_menu_option_locale", [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        loadGraph.Add("points_of_interest_locale", [] { sObjectMgr->LoadPointOfInterestLocales(); });
+        loadGraph.Add("pet_name_generation_locale", [] { sObjectMgr->LoadPetNamesLocales(); });
+        loadGraph.Add("page_text", [] { sObjectMgr->LoadPageTexts(); });
+        loadGraph.Add("quest_poi", [] { sObjectMgr->LoadQuestPOI(); });
+        loadGraph.Add("game_tele", [] { sObjectMgr->LoadGameTele(); });
+        loadGraph.Run(getIntConfig(CONFIG_NUMTHREADS_STARTUP_LOADERS));
+    }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
-    LOG_INFO("server.loading", ">> Localization Strings loaded in {} ms", GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", ">> Localization Strings loaded in {} ms, {} distinct texts in {} KB", GetMSTimeDiffToNow(oldMSTime),
+        ObjectMgr::GetLocaleStringPool().GetStringCount(), ObjectMgr::GetLocaleStringPool().GetMemoryUsage() / 1024);
     LOG_INFO("server.loading", " ");
 
-    LOG_INFO("server.loading", "Loading Page Texts...");
-    sObjectMgr->LoadPageTexts();
-
-    LOG_INFO("server.loading", "Loading Game Object Templates...");         // must be after LoadPageTexts
+    sStartupProfiler->BeginStage("Loading Game Object Templates...");         // must be after LoadPageTexts
     sObjectMgr->LoadGameObjectTemplate();
 
-    LOG_INFO("server.loading", "Loading Game Object Template Addons...");
+    sStartupProfiler->BeginStage("Loading Game Object Template Addons...");
     sObjectMgr->LoadGameObjectTemplateAddons();
 
-    LOG_INFO("server.loading", "Loading Transport Templates...");
+    sStartupProfiler->BeginStage("Loading Transport Templates...");
     sTransportMgr->LoadTransportTemplates();
 
-    LOG_INFO("server.loading", "Loading Spell Required Data...");
-    sSpellMgr->LoadSpellRequired();
-
-    LOG_INFO("server.loading", "Loading Spell Group Types...");
-    sSpellMgr->LoadSpellGroups();
-
-    LOG_INFO("server.loading", "Loading Spell Learn Skills...");
-    sSpellMgr->LoadSpellLearnSkills();                           // must be after LoadSpellRanks
-
-    LOG_INFO("server.loading", "Loading Spell Proc Event Conditions...");
-    sSpellMgr->LoadSpellProcEvents();
-
-    LOG_INFO("server.loading", "Loading Spell Proc Conditions and Data...");
-    sSpellMgr->LoadSpellProcs();
-
-    LOG_INFO("server.loading", "Loading Spell Bonus Data...");
-    sSpellMgr->LoadSpellBonuses();
-
-    LOG_INFO("server.loading", "Loading Aggro Spells Definitions...");
-    sSpellMgr->LoadSpellThreats();
-
-    LOG_INFO("server.loading", "Loading Mixology Bonuses...");
-    sSpellMgr->LoadSpellMixology();
-
-    LOG_INFO("server.loading", "Loading Spell Group Stack Rules...");
-    sSpellMgr->LoadSpellGroupStackRules();
+    sStartupProfiler->BeginStage("Loading Spell Required Data, Groups, Learn Skills, Procs, Bonuses, Threats and Mixology...");
+    {
+        // these loaders only read SpellInfo and fill their own SpellMgr containers
+        WorldLoadGraph loadGraph("Spell Data");
+        loadGraph.Add("spell_required", [] { sSpellMgr->LoadSpellRequired(); });
+        loadGraph.Add("spell_group", [] { sSpellMgr->LoadSpellGroups(); });
+        loadGraph.Add("spell_learn_skill", [] { sSpellMgr->LoadSpellLearnSkills(); });          // must be after LoadSpellRanks
+        loadGraph.Add("spell_proc_event", [] { sSpellMgr->LoadSpellProcEvents(); });
+        loadGraph.Add("spell_proc", [] { sSpellMgr->LoadSpellProcs(); });
+        loadGraph.Add("spell_bonus_data", [] { sSpellMgr->LoadSpellBonuses(); });
+        loadGraph.Add("spell_threat", [] { sSpellMgr->LoadSpellThreats(); });
+        loadGraph.Add("spell_mixology", [] { sSpellMgr->LoadSpellMixology(); });
+        loadGraph.Add("spell_group_stack_rules", [] { sSpellMgr->LoadSpellGroupStackRules(); }, { "spell_group" });
+        loadGraph.Run(getIntConfig(CONFIG_NUMTHREADS_STARTUP_LOADERS));
+    }
 
-    LOG_INFO("server.loading", "Loading NPC Texts...");
+    sStartupProfiler->BeginStage("Loading NPC Texts...");
     sObjectMgr->LoadGossipText();
 
-    LOG_INFO("server.loading", "Loading Enchant Spells Proc Datas...");
+    sStartupProfiler->BeginStage("Loading Enchant Spells Proc Datas...");
     sSpellMgr->LoadSpellEnchantProcData();
 
-    LOG_INFO("server.loading", "Loading Item Random Enchantments Table...");
+    sStartupProfiler->BeginStage("Loading Item Random Enchantments Table...");
     LoadRandomEnchantmentsTable();
 
-    LOG_INFO("server.loading", "Loading Disables");
+    sStartupProfiler->BeginStage("Loading Disables");
     DisableMgr::LoadDisables();                                  // must be before loading quests and items
 
-    LOG_INFO("server.loading", "Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
+    sStartupProfiler->BeginStage("Loading Items...");                         // must be after LoadRandomEnchantmentsTable and LoadPageTexts
     sObjectMgr->LoadItemTemplates();
 
-    LOG_INFO("server.loading", "Loading Item Set Names...");                // must be after LoadItemPrototypes
+    sStartupProfiler->BeginStage("Loading Item Set Names...");                // must be after LoadItemPrototypes
     sObjectMgr->LoadItemSetNames();
 
-    LOG_INFO("server.loading", "Loading Creature Model Based Info Data...");
+    sStartupProfiler->BeginStage("Loading Creature Model Based Info Data...");
     sObjectMgr->LoadCreatureModelInfo();
 
-    LOG_INFO("server.loading", "Loading Creature Custom IDs Config...");
+    sStartupProfiler->BeginStage("Loading Creature Custom IDs Config...");
     sObjectMgr->LoadCreatureCustomIDs();
 
-    LOG_INFO("server.loading", "Loading Creature Templates...");
+    sStartupProfiler->BeginStage("Loading Creature Templates...");
     sObjectMgr->LoadCreatureTemplates();
 
-    LOG_INFO("server.loading", "Loading Equipment Templates...");           // must be after LoadCreatureTemplates
+    sStartupProfiler->BeginStage("Loading Equipment Templates...");           // must be after LoadCreatureTemplates
     sObjectMgr->LoadEquipmentTemplates();
 
-    LOG_INFO("server.loading", "Loading Creature Template Addons...");
+    sStartupProfiler->BeginStage("Loading Creature Template Addons...");
     sObjectMgr->LoadCreatureTemplateAddons();
 
-    LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
+    sStartupProfiler->BeginStage("Loading Reputation Reward Rates...");
     sObjectMgr->LoadReputationRewardRate();
 
-    LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
+    sStartupProfiler->BeginStage("Loading Creature Reputation OnKill Data...");
     sObjectMgr->LoadReputationOnKill();
 
-    LOG_INFO("server.loading", "Loading Reputation Spillover Data..." );
+    sStartupProfiler->BeginStage("Loading Reputation Spillover Data...");
     sObjectMgr->LoadReputationSpilloverTemplate();
 
-    LOG_INFO("server.loading", "Loading Points Of Interest Data...");
+    sStartupProfiler->BeginStage("Loading Points Of Interest Data...");
     sObjectMgr->LoadPointsOfInterest();
 
-    LOG_INFO("server.loading", "Loading Creature Base Stats...");
+    sStartupProfiler->BeginStage("Loading Creature Base Stats...");
     sObjectMgr->LoadCreatureClassLevelStats();
 
-    LOG_INFO("server.loading", "Loading Creature Data...");
+    sStartupProfiler->BeginStage("Loading Creature Data...");
     sObjectMgr->LoadCreatures();
 
-    LOG_INFO("server.loading", "Loading Temporary Summon Data...");
+    sStartupProfiler->BeginStage("Loading Temporary Summon Data...");
     sObjectMgr->LoadTempSummons();                               // must be after LoadCreatureTemplates() and LoadGameObjectTemplates()
 
-    LOG_INFO("server.loading", "Loading Pet Levelup Spells...");
+    sStartupProfiler->BeginStage("Loading Pet Levelup Spells...");
     sSpellMgr->LoadPetLevelupSpellMap();
 
-    LOG_INFO("server.loading", "Loading Pet default Spells additional to Levelup Spells...");
+    sStartupProfiler->BeginStage("Loading Pet default Spells additional to Levelup Spells...");
     sSpellMgr->LoadPetDefaultSpells();
 
-    LOG_INFO("server.loading", "Loading Creature Addon Data...");
+    sStartupProfiler->BeginStage("Loading Creature Addon Data...");
     sObjectMgr->LoadCreatureAddons();                            // must be after LoadCreatureTemplates() and LoadCreatures()
 
-    LOG_INFO("server.loading", "Loading Creature Movement Overrides...");
+    sStartupProfiler->BeginStage("Loading Creature Movement Overrides...");
     sObjectMgr->LoadCreatureMovementOverrides(); // must be after LoadCreatures()
 
-    LOG_INFO("server.loading", "Loading Gameobject Data...");
+    sStartupProfiler->BeginStage("Loading Gameobject Data...");
     sObjectMgr->LoadGameobjects();
 
-    LOG_INFO("server.loading", "Loading GameObject Addon Data...");
+    sStartupProfiler->BeginStage("Loading GameObject Addon Data...");
     sObjectMgr->LoadGameObjectAddons();                          // must be after LoadGameObjectTemplate() and LoadGameobjects()
 
-    LOG_INFO("server.loading", "Loading GameObject Quest Items...");
+    sStartupProfiler->BeginStage("Loading GameObject Quest Items...");
     sObjectMgr->LoadGameObjectQuestItems();
 
-    LOG_INFO("server.loading", "Loading Creature Quest Items...");
+    sStartupProfiler->BeginStage("Loading Creature Quest Items...");
     sObjectMgr->LoadCreatureQuestItems();
 
-    LOG_INFO("server.loading", "Loading Creature Linked Respawn...");
+    sStartupProfiler->BeginStage("Loading Creature Linked Respawn...");
     sObjectMgr->LoadLinkedRespawn();                             // must be after LoadCreatures(), LoadGameObjects()
 
-    LOG_INFO("server.loading", "Loading Weather Data...");
+    sStartupProfiler->BeginStage("Loading Weather Data...");
     WeatherMgr::LoadWeatherData();
 
-    LOG_INFO("server.loading", "Loading Quests...");
+    sStartupProfiler->BeginStage("Loading Quests...");
     sObjectMgr->LoadQuests();                                    // must be loaded after DBCs, creature_template, item_template, gameobject tables
 
-    LOG_INFO("server.loading", "Checking Quest Disables");
+    sStartupProfiler->BeginStage("Checking Quest Disables");
     DisableMgr::CheckQuestDisables();                           // must be after loading quests
 
-    LOG_INFO("server.loading", "Loading Quest POI");
-    sObjectMgr->LoadQuestPOI();
-
-    LOG_INFO("server.loading", "Loading Quests Starters and Enders...");
+    sStartupProfiler->BeginStage("Loading Quests Starters and Enders...");
     sObjectMgr->LoadQuestStartersAndEnders();                    // must be after quest load
 
-    LOG_INFO("server.loading", "Loading Quest Greetings...");
+    sStartupProfiler->BeginStage("Loading Quest Greetings...");
     sObjectMgr->LoadQuestGreetings();                               // must be loaded after creature_template, gameobject_template tables
-    LOG_INFO("server.loading", "Loading Quest Greeting Locales...");
+    sStartupProfiler->BeginStage("Loading Quest Greeting Locales...");
     sObjectMgr->LoadQuestGreetingsLocales();                        // must be loaded after creature_template, gameobject_template tables
 
-    LOG_INFO("server.loading", "Loading Quest Money Rewards...");
+    sStartupProfiler->BeginStage("Loading Quest Money Rewards...");
     sObjectMgr->LoadQuestMoneyRewards();
 
-    LOG_INFO("server.loading", "Loading Objects Pooling Data...");
+    sStartupProfiler->BeginStage("Initializing Query Data...");
+    sObjectMgr->InitializeQueriesData(QUERY_DATA_ALL);           // must be after all templates and their locales
+
+    sStartupProfiler->BeginStage("Loading Objects Pooling Data...");
     sPoolMgr->LoadFromDB();
 
-    LOG_INFO("server.loading", "Loading Game Event Data...");               // must be after loading pools fully
+    sStartupProfiler->BeginStage("Loading Game Event Data...");               // must be after loading pools fully
     sGameEventMgr->LoadHolidayDates();                           // Must be after loading DBC
     sGameEventMgr->LoadFromDB();                                 // Must be after loading holiday dates
 
-    LOG_INFO("server.loading", "Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
+    sStartupProfiler->BeginStage("Loading UNIT_NPC_FLAG_SPELLCLICK Data..."); // must be after LoadQuests
     sObjectMgr->LoadNPCSpellClickSpells();
 
-    LOG_INFO("server.loading", "Loading Vehicle Template Accessories...");
+    sStartupProfiler->BeginStage("Loading Vehicle Template Accessories...");
     sObjectMgr->LoadVehicleTemplateAccessories();                // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
 
-    LOG_INFO("server.loading", "Loading Vehicle Accessories...");
+    sStartupProfiler->BeginStage("Loading Vehicle Accessories...");
     sObjectMgr->LoadVehicleAccessories();                       // must be after LoadCreatureTemplates() and LoadNPCSpellClickSpells()
 
-    LOG_INFO("server.loading", "Loading SpellArea Data...");                // must be after quest load
+    sStartupProfiler->BeginStage("Loading SpellArea Data...");                // must be after quest load
     sSpellMgr->LoadSpellAreas();
 
-    LOG_INFO("server.loading", "Loading Area Trigger Definitions");
+    sStartupProfiler->BeginStage("Loading Area Trigger Definitions");
     sObjectMgr->LoadAreaTriggers();
 
-    LOG_INFO("server.loading", "Loading Area Trigger Teleport Definitions...");
+    sStartupProfiler->BeginStage("Loading Area Trigger Teleport Definitions...");
     sObjectMgr->LoadAreaTriggerTeleports();
 
-    LOG_INFO("server.loading", "Loading Access Requirements...");
+    sStartupProfiler->BeginStage("Loading Access Requirements...");
     sObjectMgr->LoadAccessRequirements();                        // must be after item template load
 
-    LOG_INFO("server.loading", "Loading Quest Area Triggers...");
+    sStartupProfiler->BeginStage("Loading Quest Area Triggers...");
     sObjectMgr->LoadQuestAreaTriggers();                         // must be after LoadQuests
 
-    LOG_INFO("server.loading", "Loading Tavern Area Triggers...");
+    sStartupProfiler->BeginStage("Loading Tavern Area Triggers...");
     sObjectMgr->LoadTavernAreaTriggers();
 
-    LOG_INFO("server.loading", "Loading AreaTrigger Script Names...");
+    sStartupProfiler->BeginStage("Loading AreaTrigger Script Names...");
     sObjectMgr->LoadAreaTriggerScripts();
 
-    LOG_INFO("server.loading", "Loading LFG Entrance Positions..."); // Must be after areatriggers
+    sStartupProfiler->BeginStage("Loading LFG Entrance Positions..."); // Must be after areatriggers
     sLFGMgr->LoadLFGDungeons();
 
-    LOG_INFO("server.loading", "Loading Dungeon Boss Data...");
+    sStartupProfiler->BeginStage("Loading Dungeon Boss Data...");
     sObjectMgr->LoadInstanceEncounters();
 
-    LOG_INFO("server.loading", "Loading LFG Rewards...");
+    sStartupProfiler->BeginStage("Loading LFG Rewards...");
     sLFGMgr->LoadRewards();
 
-    LOG_INFO("server.loading", "Loading Graveyard-Zone Links...");
+    sStartupProfiler->BeginStage("Loading Graveyard-Zone Links...");
     sGraveyard->LoadGraveyardZones();
 
-    LOG_INFO("server.loading", "Loading Spell Pet Auras...");
+    sStartupProfiler->BeginStage("Loading Spell Pet Auras...");
     sSpellMgr->LoadSpellPetAuras();
 
-    LOG_INFO("server.loading", "Loading Spell Target Coordinates...");
+    sStartupProfiler->BeginStage("Loading Spell Target Coordinates...");
     sSpellMgr->LoadSpellTargetPositions();
 
-    LOG_INFO("server.loading", "Loading Enchant Custom Attributes...");
+    sStartupProfiler->BeginStage("Loading Enchant Custom Attributes...");
     sSpellMgr->LoadEnchantCustomAttr();
 
-    LOG_INFO("server.loading", "Loading linked Spells...");
+    sStartupProfiler->BeginStage("Loading linked Spells...");
     sSpellMgr->LoadSpellLinked();
 
-    LOG_INFO("server.loading", "Loading Player Create Data...");
+    sStartupProfiler->BeginStage("Loading Player Create Data...");
     sObjectMgr->LoadPlayerInfo();
 
-    LOG_INFO("server.loading", "Loading Exploration BaseXP Data...");
+    sStartupProfiler->BeginStage("Loading Exploration BaseXP Data...");
     sObjectMgr->LoadExplorationBaseXP();
 
-    LOG_INFO("server.loading", "Loading Pet Name Parts...");
+    sStartupProfiler->BeginStage("Loading Pet Name Parts...");
     sObjectMgr->LoadPetNames();
 
     CharacterDatabaseCleaner::CleanDatabase();
 
-    LOG_INFO("server.loading", "Loading The Max Pet Number...");
+    sStartupProfiler->BeginStage("Loading The Max Pet Number...");
     sObjectMgr->LoadPetNumber();
 
-    LOG_INFO("server.loading", "Loading Pet Level Stats...");
+    sStartupProfiler->BeginStage("Loading Pet Level Stats...");
     sObjectMgr->LoadPetLevelInfo();
 
-    LOG_INFO("server.loading", "Loading Player Level Dependent Mail Rewards...");
+    sStartupProfiler->BeginStage("Loading Player Level Dependent Mail Rewards...");
     sObjectMgr->LoadMailLevelRewards();
 
-    LOG_INFO("server.loading", "Load Mail Server Template...");
+    sStartupProfiler->BeginStage("Load Mail Server Template...");
     sObjectMgr->LoadMailServerTemplates();
 
     // Loot tables
     LoadLootTables();
 
-    LOG_INFO("server.loading", "Loading Skill Discovery Table...");
+    sStartupProfiler->BeginStage("Loading Skill Discovery Table...");
     LoadSkillDiscoveryTable();
 
-    LOG_INFO("server.loading", "Loading Skill Extra Item Table...");
+    sStartupProfiler->BeginStage("Loading Skill Extra Item Table...");
     LoadSkillExtraItemTable();
 
-    LOG_INFO("server.loading", "Loading Skill Perfection Data Table...");
+    sStartupProfiler->BeginStage("Loading Skill Perfection Data Table...");
     LoadSkillPerfectItemTable();
 
-    LOG_INFO("server.loading", "Loading Skill Fishing Base Level Requirements...");
+    sStartupProfiler->BeginStage("Loading Skill Fishing Base Level Requirements...");
     sObjectMgr->LoadFishingBaseSkillLevel();
 
-    LOG_INFO("server.loading", "Loading Achievements...");
+    sStartupProfiler->BeginStage("Loading Achievements...");
     sAchievementMgr->LoadAchievementReferenceList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Lists...");
+    sStartupProfiler->BeginStage("Loading Achievement Criteria Lists...");
     sAchievementMgr->LoadAchievementCriteriaList();
-    LOG_INFO("server.loading", "Loading Achievement Criteria Data...");
+    sStartupProfiler->BeginStage("Loading Achievement Criteria Data...");
     sAchievementMgr->LoadAchievementCriteriaData();
-    LOG_INFO("server.loading", "Loading Achievement Rewards...");
+    sStartupProfiler->BeginStage("Loading Achievement Rewards...");
     sAchievementMgr->LoadRewards();
-    LOG_INFO("server.loading", "Loading Achievement Reward Locales...");
+    sStartupProfiler->BeginStage("Loading Achievement Reward Locales...");
     sAchievementMgr->LoadRewardLocales();
-    LOG_INFO("server.loading", "Loading Completed Achievements...");
+    sStartupProfiler->BeginStage("Loading Completed Achievements...");
     sAchievementMgr->LoadCompletedAchievements();
 
     ///- Load dynamic data tables from the database
-    LOG_INFO("server.loading", "Loading Item Auctions...");
+    sStartupProfiler->BeginStage("Loading Item Auctions...");
     sAuctionMgr->LoadAuctionItems();
-    LOG_INFO("server.loading", "Loading Auctions...");
+    sStartupProfiler->BeginStage("Loading Auctions...");
     sAuctionMgr->LoadAuctions();
 
     sGuildMgr->LoadGuilds();
 
-    LOG_INFO("server.loading", "Loading ArenaTeams...");
+    sStartupProfiler->BeginStage("Loading ArenaTeams...");
     sArenaTeamMgr->LoadArenaTeams();
 
-    LOG_INFO("server.loading", "Loading Groups...");
+    sStartupProfiler->BeginStage("Loading Groups...");
     sGroupMgr->LoadGroups();
 
-    LOG_INFO("server.loading", "Loading Reserved Names...");
+    sStartupProfiler->BeginStage("Loading Reserved Names...");
     sObjectMgr->LoadReservedPlayersNames();
 
-    LOG_INFO("server.loading", "Loading Profanity Names...");
+    sStartupProfiler->BeginStage("Loading Profanity Names...");
     sObjectMgr->LoadProfanityPlayersNames();
 
-    LOG_INFO("server.loading", "Loading GameObjects for Quests...");
+    sStartupProfiler->BeginStage("Loading GameObjects for Quests...");
     sObjectMgr->LoadGameObjectForQuests();
 
-    LOG_INFO("server.loading", "Loading BattleMasters...");
+    sStartupProfiler->BeginStage("Loading BattleMasters...");
     sBattlegroundMgr->LoadBattleMastersEntry();
 
-    LOG_INFO("server.loading", "Loading GameTeleports...");
-    sObjectMgr->LoadGameTele();
-
-    LOG_INFO("server.loading", "Loading Gossip Menu...");
+    sStartupProfiler->BeginStage("Loading Gossip Menu...");
     sObjectMgr->LoadGossipMenu();
 
-    LOG_INFO("server.loading", "Loading Gossip Menu Options...");
+    sStartupProfiler->BeginStage("Loading Gossip Menu Options...");
     sObjectMgr->LoadGossipMenuItems();
 
-    LOG_INFO("server.loading", "Loading Vendors...");
+    sStartupProfiler->BeginStage("Loading Vendors...");
     sObjectMgr->LoadVendors();                                   // must be after load CreatureTemplate and ItemTemplate
 
-    LOG_INFO("server.loading", "Loading Trainers...");
+    sStartupProfiler->BeginStage("Loading Trainers...");
     sObjectMgr->LoadTrainerSpell();                              // must be after load CreatureTemplate
 
-    LOG_INFO("server.loading", "Loading Waypoints...");
+    sStartupProfiler->BeginStage("Loading Waypoints...");
     sWaypointMgr->Load();
 
-    LOG_INFO("server.loading", "Loading SmartAI Waypoints...");
+    sStartupProfiler->BeginStage("Loading SmartAI Waypoints...");
     sSmartWaypointMgr->LoadFromDB();
 
-    LOG_INFO("server.loading", "Loading Creature Formations...");
+    sStartupProfiler->BeginStage("Loading Creature Formations...");
     sFormationMgr->LoadCreatureFormations();
 
-    LOG_INFO("server.loading", "Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
+    sStartupProfiler->BeginStage("Loading World States...");              // must be loaded before battleground, outdoor PvP and conditions
     LoadWorldStates();
 
-    LOG_INFO("server.loading", "Loading Conditions...");
+    sStartupProfiler->BeginStage("Loading Conditions...");
     sConditionMgr->LoadConditions();
 
-    LOG_INFO("server.loading", "Loading Faction Change Achievement Pairs...");
+    sStartupProfiler->BeginStage("Loading Faction Change Achievement Pairs...");
     sObjectMgr->LoadFactionChangeAchievements();
 
-    LOG_INFO("server.loading", "Loading Faction Change Spell Pairs...");
+    sStartupProfiler->BeginStage("Loading Faction Change Spell Pairs...");
     sObjectMgr->LoadFactionChangeSpells();
 
-    LOG_INFO("server.loading", "Loading Faction Change Item Pairs...");
+    sStartupProfiler->BeginStage("Loading Faction Change Item Pairs...");
     sObjectMgr->LoadFactionChangeItems();
 
-    LOG_INFO("server.loading", "Loading Faction Change Reputation Pairs...");
+    sStartupProfiler->BeginStage("Loading Faction Change Reputation Pairs...");
     sObjectMgr->LoadFactionChangeReputations();
 
-    LOG_INFO("server.loading", "Loading Faction Change Title Pairs...");
+    sStartupProfiler->BeginStage("Loading Faction Change Title Pairs...");
     sObjectMgr->LoadFactionChangeTitles();
 
-    LOG_INFO("server.loading", "Loading Faction Change Quest Pairs...");
+    sStartupProfiler->BeginStage("Loading Faction Change Quest Pairs...");
     sObjectMgr->LoadFactionChangeQuests();
 
-    LOG_INFO("server.loading", "Loading GM Tickets...");
+    sStartupProfiler->BeginStage("Loading GM Tickets...");
     sTicketMgr->LoadTickets();
 
-    LOG_INFO("server.loading", "Loading GM Surveys...");
+    sStartupProfiler->BeginStage("Loading GM Surveys...");
     sTicketMgr->LoadSurveys();
 
-    LOG_INFO("server.loading", "Loading Client Addons...");
+    sStartupProfiler->BeginStage("Loading Client Addons...");
     AddonMgr::LoadFromDB();
 
     // pussywizard:
-    LOG_INFO("server.loading", "Deleting Invalid Mail Items...");
+    sStartupProfiler->BeginStage("Deleting Invalid Mail Items...");
     LOG_INFO("server.loading", " ");
     CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN item_instance ii ON mi.item_guid = ii.guid WHERE ii.guid IS NULL");
     CharacterDatabase.Execute("DELETE mi FROM mail_items mi LEFT JOIN mail m ON mi.mail_id = m.id WHERE m.id IS NULL");
     CharacterDatabase.Execute("UPDATE mail m LEFT JOIN mail_items mi ON m.id = mi.mail_id SET m.has_items=0 WHERE m.has_items<>0 AND mi.mail_id IS NULL");
 
     ///- Handle outdated emails (delete/return)
-    LOG_INFO("server.loading", "Returning Old Mails...");
+    sStartupProfiler->BeginStage("Returning Old Mails...");
     LOG_INFO("server.loading", " ");
     sObjectMgr->ReturnOrDeleteOldMails(false);
 
     ///- Load AutoBroadCast
-    LOG_INFO("server.loading", "Loading Autobroadcasts...");
+    sStartupProfiler->BeginStage("Loading Autobroadcasts...");
     sAutobroadcastMgr->LoadAutobroadcasts();
 
     ///- Load Motd
-    LOG_INFO("server.loading", "Loading Motd...");
+    sStartupProfiler->BeginStage("Loading Motd...");
     sMotdMgr->LoadMotd();
 
     ///- Load and initialize scripts
@@ -2009,36 +2116,36 @@ void World::SetInitialWorldSettings()
     sObjectMgr->LoadEventScripts();                              // must be after load Creature/Gameobject(Template/Data)
     sObjectMgr->LoadWaypointScripts();
 
-    LOG_INFO("server.loading", "Loading Spell Script Names...");
+    sStartupProfiler->BeginStage("Loading Spell Script Names...");
     sObjectMgr->LoadSpellScriptNames();
 
-    LOG_INFO("server.loading", "Loading Creature Texts...");
+    sStartupProfiler->BeginStage("Loading Creature Texts...");
     sCreatureTextMgr->LoadCreatureTexts();
 
-    LOG_INFO("server.loading", "Loading Creature Text Locales...");
+    sStartupProfiler->BeginStage("Loading Creature Text Locales...");
     sCreatureTextMgr->LoadCreatureTextLocales();
 
-    LOG_INFO("server.loading", "Loading Scripts...");
+    sStartupProfiler->BeginStage("Loading Scripts...");
     sScriptMgr->LoadDatabase();
 
-    LOG_INFO("server.loading", "Validating Spell Scripts...");
+    sStartupProfiler->BeginStage("Validating Spell Scripts...");
     sObjectMgr->ValidateSpellScripts();
 
-    LOG_INFO("server.loading", "Loading SmartAI Scripts...");
+    sStartupProfiler->BeginStage("Loading SmartAI Scripts...");
     sSmartScriptMgr->LoadSmartAIFromDB();
 
-    LOG_INFO("server.loading", "Loading Calendar Data...");
+    sStartupProfiler->BeginStage("Loading Calendar Data...");
     sCalendarMgr->LoadFromDB();
 
-    LOG_INFO("server.loading", "Initializing SpellInfo Precomputed Data..."); // must be called after loading items, professions, spells and pretty much anything
+    sStartupProfiler->BeginStage("Initializing SpellInfo Precomputed Data..."); // must be called after loading items, professions, spells and pretty much anything
     LOG_INFO("server.loading", " ");
     sObjectMgr->InitializeSpellInfoPrecomputedData();
 
-    LOG_INFO("server.loading", "Initialize Commands...");
+    sStartupProfiler->BeginStage("Initialize Commands...");
     Acore::ChatCommands::LoadCommandMap();
 
     ///- Initialize game time and timers
-    LOG_INFO("server.loading", "Initialize Game Time and Timers");
+    sStartupProfiler->BeginStage("Initialize Game Time and Timers");
     LOG_INFO("server.loading", " ");
 
     LoginDatabase.Execute("INSERT INTO uptime (realmid, starttime, uptime, revision) VALUES ({}, {}, 0, '{}')",
@@ -2066,11 +2173,17 @@ void World::SetInitialWorldSettings()
     _mail_expire_check_timer = GameTime::GetGameTime() + 6h;
 
     ///- Initialize MapMgr
-    LOG_INFO("server.loading", "Starting Map System");
+    sStartupProfiler->BeginStage("Starting Map System");
     LOG_INFO("server.loading", " ");
     sMapMgr->Initialize();
 
-    LOG_INFO("server.loading", "Starting Game Event system...");
+    if (uint32 sessionThreads = getIntConfig(CONFIG_NUMTHREADS_SESSIONS))
+    {
+        _sessionPacketUpdater = std::make_unique<MapRegionUpdater>();
+        _sessionPacketUpdater->activate(sessionThreads);
+    }
+
+    sStartupProfiler->BeginStage("Starting Game Event system...");
     LOG_INFO("server.loading", " ");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     _timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
@@ -2081,80 +2194,87 @@ void World::SetInitialWorldSettings()
     // Delete all custom channels which haven't been used for PreserveCustomChannelDuration days.
     Channel::CleanOldChannelsInDB();
 
-    LOG_INFO("server.loading", "Initializing Opcodes...");
+    sStartupProfiler->BeginStage("Initializing Opcodes...");
     opcodeTable.Initialize();
 
-    LOG_INFO("server.loading", "Starting Arena Season...");
+    sStartupProfiler->BeginStage("Starting Arena Season...");
     LOG_INFO("server.loading", " ");
     sGameEventMgr->StartArenaSeason();
 
     sTicketMgr->Initialize();
 
     ///- Initialize Battlegrounds
-    LOG_INFO("server.loading", "Starting Battleground System");
+    sStartupProfiler->BeginStage("Starting Battleground System");
     sBattlegroundMgr->LoadBattlegroundTemplates();
     sBattlegroundMgr->InitAutomaticArenaPointDistribution();
 
     ///- Initialize outdoor pvp
-    LOG_INFO("server.loading", "Starting Outdoor PvP System");
+    sStartupProfiler->BeginStage("Starting Outdoor PvP System");
     sOutdoorPvPMgr->InitOutdoorPvP();
 
     ///- Initialize Battlefield
-    LOG_INFO("server.loading", "Starting Battlefield System");
+    sStartupProfiler->BeginStage("Starting Battlefield System");
     sBattlefieldMgr->InitBattlefield();
 
-    LOG_INFO("server.loading", "Loading Transports...");
+    sStartupProfiler->BeginStage("Loading Transports...");
     sTransportMgr->SpawnContinentTransports();
 
     ///- Initialize Warden
-    LOG_INFO("server.loading", "Loading Warden Checks..." );
+    sStartupProfiler->BeginStage("Loading Warden Checks...");
     sWardenCheckMgr->LoadWardenChecks();
 
-    LOG_INFO("server.loading", "Loading Warden Action Overrides..." );
+    sStartupProfiler->BeginStage("Loading Warden Action Overrides...");
     sWardenCheckMgr->LoadWardenOverrides();
 
-    LOG_INFO("server.loading", "Deleting Expired Bans...");
+    sStartupProfiler->BeginStage("Deleting Expired Bans...");
     LoginDatabase.Execute("DELETE FROM ip_banned WHERE unbandate <= UNIX_TIMESTAMP() AND unbandate<>bandate");      // One-time query
 
-    LOG_INFO("server.loading", "Calculate Next Daily Quest Reset Time...");
+    sStartupProfiler->BeginStage("Calculate Next Daily Quest Reset Time...");
     InitDailyQuestResetTime();
 
-    LOG_INFO("server.loading", "Calculate Next Weekly Quest Reset Time..." );
+    sStartupProfiler->BeginStage("Calculate Next Weekly Quest Reset Time...");
     InitWeeklyQuestResetTime();
 
-    LOG_INFO("server.loading", "Calculate Next Monthly Quest Reset Time...");
+    sStartupProfiler->BeginStage("Calculate Next Monthly Quest Reset Time...");
     InitMonthlyQuestResetTime();
 
-    LOG_INFO("server.loading", "Calculate Random Battleground Reset Time..." );
+    sStartupProfiler->BeginStage("Calculate Random Battleground Reset Time...");
     InitRandomBGResetTime();
 
-    LOG_INFO("server.loading", "Calculate Deletion Of Old Calendar Events Time...");
+    sStartupProfiler->BeginStage("Calculate Deletion Of Old Calendar Events Time...");
     InitCalendarOldEventsDeletionTime();
 
-    LOG_INFO("server.loading", "Calculate Guild Cap Reset Time...");
+    sStartupProfiler->BeginStage("Calculate Guild Cap Reset Time...");
     LOG_INFO("server.loading", " ");
     InitGuildResetTime();
 
-    LOG_INFO("server.loading", "Load Petitions...");
+    sStartupProfiler->BeginStage("Load Petitions...");
     sPetitionMgr->LoadPetitions();
 
-    LOG_INFO("server.loading", "Load Petition Signs...");
+    sStartupProfiler->BeginStage("Load Petition Signs...");
     sPetitionMgr->LoadSignatures();
 
-    LOG_INFO("server.loading", "Load Stored Loot Items...");
+    sStartupProfiler->BeginStage("Load Stored Loot Items...");
     sLootItemStorage->LoadStorageFromDB();
 
-    LOG_INFO("server.loading", "Load Channel Rights...");
+    sStartupProfiler->BeginStage("Load Channel Rights...");
     ChannelMgr::LoadChannelRights();
 
-    LOG_INFO("server.loading", "Load Channels...");
+    sStartupProfiler->BeginStage("Load Channels...");
     ChannelMgr::LoadChannels();
 
     sScriptMgr->OnBeforeWorldInitialized();
 
+    std::string const warmRestartFile = sConfigMgr->GetOption<std::string>("WarmRestart.GridFile", "");
+    if (!warmRestartFile.empty() && !sWorld->getBoolConfig(CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS))
+    {
+        sStartupProfiler->BeginStage("Loading Grids Of The Players Before The Restart...");
+        sMapMgr->LoadWarmRestartGrids(warmRestartFile, sConfigMgr->GetOption<uint32>("WarmRestart.MaxAge", 600));
+    }
+
     if (sWorld->getBoolConfig(CONFIG_PRELOAD_ALL_NON_INSTANCED_MAP_GRIDS))
     {
-        LOG_INFO("server.loading", "Loading All Grids For All Non-Instanced Maps...");
+        sStartupProfiler->BeginStage("Loading All Grids For All Non-Instanced Maps...");
 
         for (uint32 i = 0; i < sMapStore.GetNumRows(); ++i)
         {
@@ -2173,6 +2293,10 @@ void World::SetInitialWorldSettings()
         }
     }
 
+    RegisterMemoryEstimators();
+
+    sStartupProfiler->Finish();
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
 
     LOG_INFO("server.loading", " ");
@@ -2184,7 +2308,7 @@ void World::SetInitialWorldSettings()
     if (sConfigMgr->isDryRun())
     {
         sMapMgr->UnloadAll();
-        LOG_INFO("server.loading", "AzerothCore Dry Run Completed, Terminating.");
+        sStartupProfiler->BeginStage("AzerothCore Dry Run Completed, Terminating.");
         exit(0);
     }
 }
@@ -2245,6 +2369,7 @@ void World::Update(uint32 diff)
 
     // Record update if recording set in log and diff is greater then minimum set in log
     sWorldUpdateTime.RecordUpdateTime(GameTime::GetGameTimeMS(), diff, GetActiveSessionCount());
+    sWorldUpdateTime.CheckSlowUpdate(diff);
 
     DynamicVisibilityMgr::Update(GetActiveSessionCount());
 
@@ -2270,13 +2395,13 @@ void World::Update(uint32 diff)
     ///- Update Who List Cache
     if (_timers[WUPDATE_WHO_LIST].Passed())
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update who list"));
+        WORLD_UPDATE_SECTION("Update who list");
         _timers[WUPDATE_WHO_LIST].Reset();
         sWhoListCacheMgr->Update();
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Check quest reset times"));
+        WORLD_UPDATE_SECTION("Check quest reset times");
 
         /// Handle daily quests reset time
         if (currentGameTime > _nextDailyQuestReset)
@@ -2299,26 +2424,26 @@ void World::Update(uint32 diff)
 
     if (currentGameTime > _nextRandomBGReset)
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Reset random BG"));
+        WORLD_UPDATE_SECTION("Reset random BG");
         ResetRandomBG();
     }
 
     if (currentGameTime > _nextCalendarOldEventsDeletionTime)
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Delete old calendar events"));
+        WORLD_UPDATE_SECTION("Delete old calendar events");
         CalendarDeleteOldEvents();
     }
 
     if (currentGameTime > _nextGuildReset)
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Reset guild cap"));
+        WORLD_UPDATE_SECTION("Reset guild cap");
         ResetGuildCap();
     }
 
     // pussywizard: handle auctions when the timer has passed
     if (_timers[WUPDATE_AUCTIONS].Passed())
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update expired auctions"));
+        WORLD_UPDATE_SECTION("Update expired auctions");
 
         _timers[WUPDATE_AUCTIONS].Reset();
 
@@ -2334,7 +2459,7 @@ void World::Update(uint32 diff)
         _mail_expire_check_timer = currentGameTime + 6h;
     }
 
-    METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update sessions"));
+    WORLD_UPDATE_SECTION("Update sessions");
     UpdateSessions(diff);
 
     /// <li> Handle weather updates when the timer has passed
@@ -2349,7 +2474,7 @@ void World::Update(uint32 diff)
     {
         if (_timers[WUPDATE_CLEANDB].Passed())
         {
-            METRIC_TIMER("world_update_time", METRIC_TAG("type", "Clean logs table"));
+            WORLD_UPDATE_SECTION("Clean logs table");
 
             _timers[WUPDATE_CLEANDB].Reset();
 
@@ -2361,56 +2486,64 @@ void World::Update(uint32 diff)
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update LFG 0"));
+        WORLD_UPDATE_SECTION("Update LFG 0");
         sLFGMgr->Update(diff, 0); // pussywizard: remove obsolete stuff before finding compatibility during map update
     }
 
     {
         ///- Update objects when the timer has passed (maps, transport, creatures, ...)
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update maps"));
+        WORLD_UPDATE_SECTION("Update maps");
         sMapMgr->Update(diff);
     }
 
+    // Maps are idle here, swap the script modules queued by .reload script_module
+    sScriptReloadMgr->Update();
+
     if (sWorld->getBoolConfig(CONFIG_AUTOBROADCAST))
     {
         if (_timers[WUPDATE_AUTOBROADCAST].Passed())
         {
-            METRIC_TIMER("world_update_time", METRIC_TAG("type", "Send autobroadcast"));
+            WORLD_UPDATE_SECTION("Send autobroadcast");
             _timers[WUPDATE_AUTOBROADCAST].Reset();
             sAutobroadcastMgr->SendAutobroadcasts();
         }
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update battlegrounds"));
+        WORLD_UPDATE_SECTION("Update battlegrounds");
         sBattlegroundMgr->Update(diff);
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update outdoor pvp"));
+        WORLD_UPDATE_SECTION("Update outdoor pvp");
         sOutdoorPvPMgr->Update(diff);
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update battlefields"));
+        WORLD_UPDATE_SECTION("Update battlefields");
         sBattlefieldMgr->Update(diff);
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update LFG 2"));
+        WORLD_UPDATE_SECTION("Update LFG 2");
         sLFGMgr->Update(diff, 2); // pussywizard: handle created proposals
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Process query callbacks"));
+        WORLD_UPDATE_SECTION("Process query callbacks");
         // execute callbacks from sql queries that were queued recently
         ProcessQueryCallbacks();
     }
 
+    {
+        WORLD_UPDATE_SECTION("Process background reloads");
+        ProcessBackgroundReloads();
+    }
+
     /// <li> Update uptime table
     if (_timers[WUPDATE_UPTIME].Passed())
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update uptime"));
+        WORLD_UPDATE_SECTION("Update uptime");
 
         _timers[WUPDATE_UPTIME].Reset();
 
@@ -2425,7 +2558,7 @@ void World::Update(uint32 diff)
     ///- Erase corpses once every 20 minutes
     if (_timers[WUPDATE_CORPSES].Passed())
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Remove old corpses"));
+        WORLD_UPDATE_SECTION("Remove old corpses");
         _timers[WUPDATE_CORPSES].Reset();
 
         sMapMgr->DoForAllMaps([](Map* map)
@@ -2437,7 +2570,7 @@ void World::Update(uint32 diff)
     ///- Process Game events when necessary
     if (_timers[WUPDATE_EVENTS].Passed())
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update game events"));
+        WORLD_UPDATE_SECTION("Update game events");
         _timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
         uint32 nextGameEvent = sGameEventMgr->Update();
         _timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);
@@ -2447,7 +2580,7 @@ void World::Update(uint32 diff)
     ///- Ping to keep MySQL connections alive
     if (_timers[WUPDATE_PINGDB].Passed())
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Ping MySQL"));
+        WORLD_UPDATE_SECTION("Ping MySQL");
         _timers[WUPDATE_PINGDB].Reset();
         LOG_DEBUG("sql.driver", "Ping MySQL to keep connection alive");
         CharacterDatabase.KeepAlive();
@@ -2456,29 +2589,29 @@ void World::Update(uint32 diff)
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update instance reset times"));
+        WORLD_UPDATE_SECTION("Update instance reset times");
         // update the instance reset times
         sInstanceSaveMgr->Update();
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Process cli commands"));
+        WORLD_UPDATE_SECTION("Process cli commands");
         // And last, but not least handle the issued cli commands
         ProcessCliCommands();
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update world scripts"));
+        WORLD_UPDATE_SECTION("Update world scripts");
         sScriptMgr->OnWorldUpdate(diff);
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update playersSaveScheduler"));
+        WORLD_UPDATE_SECTION("Update playersSaveScheduler");
         playersSaveScheduler.Update(diff);
     }
 
     {
-        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update metrics"));
+        WORLD_UPDATE_SECTION("Update metrics");
         // Stats logger update
         sMetric->Update();
         METRIC_VALUE("update_time_diff", diff);
@@ -2866,6 +2999,9 @@ void World::SendServerMessage(ServerMessageType messageID, std::string stringPar
 
 void World::UpdateSessions(uint32 diff)
 {
+    _playerLoginsThisUpdate = 0;
+    _playerLoginTimeThisUpdate = 0us;
+
     {
         METRIC_DETAILED_NO_THRESHOLD_TIMER("world_update_time",
             METRIC_TAG("type", "Add sessions"),
@@ -2879,6 +3015,9 @@ void World::UpdateSessions(uint32 diff)
         }
     }
 
+    if (_sessionPacketUpdater && _sessionPacketUpdater->activated())
+        ProcessParallelSessionPackets();
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = _sessions.begin(), next; itr != _sessions.end(); itr = next)
     {
@@ -2937,6 +3076,39 @@ void World::UpdateSessions(uint32 diff)
     }
 }
 
+void World::ProcessParallelSessionPackets()
+{
+    METRIC_DETAILED_NO_THRESHOLD_TIMER("world_update_time",
+        METRIC_TAG("type", "Parallel session packets"),
+        METRIC_TAG("parent_type", "Update sessions"));
+
+    _parallelSessions.clear();
+    for (auto const& [accountId, session] : _sessions)
+        if (!session->IsSocketClosed())
+            _parallelSessions.push_back(session);
+
+    if (_parallelSessions.empty())
+        return;
+
+    // a few chunks per thread, so one session with a long queue does not serialize the rest
+    std::size_t chunkCount = std::min<std::size_t>(_parallelSessions.size(), (getIntConfig(CONFIG_NUMTHREADS_SESSIONS) + 1) * 4);
+    std::size_t chunkSize = (_parallelSessions.size() + chunkCount - 1) / chunkCount;
+
+    std::vector<MapRegionUpdater::RegionTask> tasks;
+    tasks.reserve(chunkCount);
+    for (std::size_t begin = 0; begin < _parallelSessions.size(); begin += chunkSize)
+    {
+        std::size_t end = std::min(begin + chunkSize, _parallelSessions.size());
+        tasks.emplace_back([this, begin, end]()
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                _parallelSessions[i]->ProcessParallelPackets();
+        });
+    }
+
+    _sessionPacketUpdater->Execute(tasks);
+}
+
 // This handles the issued and queued CLI commands
 void World::ProcessCliCommands()
 {
@@ -2949,7 +3121,17 @@ void World::ProcessCliCommands()
         zprint = command->m_print;
         callbackArg = command->m_callbackArg;
         CliHandler handler(callbackArg, zprint);
+
+        auto const start = std::chrono::steady_clock::now();
         handler.ParseCommands(command->m_command);
+        std::chrono::microseconds const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        // tagged with the command name only, the arguments may hold names and passwords
+        std::string_view name(command->m_command);
+        name = name.substr(0, name.find(' '));
+        LOG_DEBUG("server.worldserver", "CLI command '{}' executed in {} us", name, elapsed.count());
+        METRIC_VALUE("cli_command_time", uint64(elapsed.count()), METRIC_TAG("command", std::string(name)));
+
         if (command->m_commandFinished)
             command->m_commandFinished(callbackArg, !handler.HasSentErrorMessage());
         delete command;
@@ -3247,9 +3429,52 @@ uint64 World::getWorldState(uint32 index) const
 
 void World::ProcessQueryCallbacks()
 {
+    PROFILE_ZONE("World::ProcessQueryCallbacks");
     _queryProcessor.ProcessReadyCallbacks();
 }
 
+bool World::QueueBackgroundReload(std::string const& name, BackgroundReloadBuilder builder)
+{
+    std::lock_guard<std::mutex> lock(_backgroundReloadLock);
+
+    // two builds of one table would race for the same staging area
+    for (BackgroundReload const& reload : _backgroundReloads)
+        if (reload.Name == name)
+            return false;
+
+    LOG_INFO("server.loading", "Reloading {} in the background...", name);
+    _backgroundReloads.push_back({ name, std::async(std::launch::async, std::move(builder)) });
+    return true;
+}
+
+void World::ProcessBackgroundReloads()
+{
+    PROFILE_ZONE("World::ProcessBackgroundReloads");
+
+    // a later reload may depend on an earlier one, e.g. reference loot before the tables using it
+    while (true)
+    {
+        std::function<void()> apply;
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(_backgroundReloadLock);
+            if (_backgroundReloads.empty() || _backgroundReloads.front().Apply.wait_for(0s) != std::future_status::ready)
+                return;
+
+            apply = _backgroundReloads.front().Apply.get();
+            name = _backgroundReloads.front().Name;
+        }
+
+        uint32 oldMSTime = getMSTime();
+        apply();
+        LOG_INFO("server.loading", ">> Swapped in background reload of {} in {} ms", name, GetMSTimeDiffToNow(oldMSTime));
+
+        // only dropped now so the same reload cannot be queued again while this one is swapped in
+        std::lock_guard<std::mutex> lock(_backgroundReloadLock);
+        _backgroundReloads.pop_front();
+    }
+}
+
 void World::RemoveOldCorpses()
 {
     _timers[WUPDATE_CORPSES].SetCurrent(_timers[WUPDATE_CORPSES].GetInterval());
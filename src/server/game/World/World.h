@@ -29,11 +29,15 @@
 #include "SharedDefines.h"
 #include "Timer.h"
 #include <atomic>
+#include <future>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
+class MapRegionUpdater;
 class Object;
 class WorldPacket;
 class WorldSocket;
@@ -207,6 +211,12 @@ public:
     int32 GetQueuePos(WorldSession*) override;
     bool HasRecentlyDisconnected(WorldSession*) override;
 
+    /// Counts a character loaded from the database in this update, false once the limit per update is reached
+    bool TryStartPlayerLogin() override;
+    /// False once the login stages of this update took longer than PlayerLimit.LoginTimePerUpdate
+    [[nodiscard]] bool CanFinishPlayerLogin() const override;
+    void AddPlayerLoginTime(Microseconds time) override { _playerLoginTimeThisUpdate += time; }
+
     /// \todo Actions on m_allowMovement still to be implemented
     /// Is movement allowed?
     [[nodiscard]] bool getAllowMovement() const override { return _allowMovement; }
@@ -327,6 +337,9 @@ public:
 
     void ProcessCliCommands() override;
     void QueueCliCommand(CliCommandHolder* commandHolder) override { _cliCmdQueue.add(commandHolder); }
+    /// Queues the commands at once, so they are all executed by the same world update
+    void QueueCliCommands(std::vector<CliCommandHolder*> const& commandHolders) override { _cliCmdQueue.add(commandHolders.begin(), commandHolders.end()); }
+    bool QueueBackgroundReload(std::string const& name, BackgroundReloadBuilder builder) override;
 
     void ForceGameEventUpdate() override;
 
@@ -399,6 +412,8 @@ private:
     typedef std::map<uint32, uint64> WorldStatesMap;
     WorldStatesMap _worldstates;
     uint32 _playerLimit;
+    uint32 _playerLoginsThisUpdate;
+    Microseconds _playerLoginTimeThisUpdate;
     AccountTypes _allowedSecurityLevel;
     LocaleConstant _defaultDbcLocale;                     // from config for one from loaded DBC locales
     uint32 _availableDbcLocaleMask;                       // by loaded DBC
@@ -431,12 +446,28 @@ private:
     void AddSession_(WorldSession* s);
     LockedQueue<WorldSession*> _addSessQueue;
 
+    // session-local packets (PROCESS_THREADSAFE_SESSION) handled in parallel before the serial session update
+    void ProcessParallelSessionPackets();
+    std::unique_ptr<MapRegionUpdater> _sessionPacketUpdater;
+    std::vector<WorldSession*> _parallelSessions;
+
     // used versions
     std::string _dbVersion;
 
     void ProcessQueryCallbacks();
     QueryCallbackProcessor _queryProcessor;
 
+    // reloads built on their own thread, swapped in by the world thread in queue order while no map is updating
+    struct BackgroundReload
+    {
+        std::string Name;
+        std::future<std::function<void()>> Apply;
+    };
+
+    void ProcessBackgroundReloads();
+    std::list<BackgroundReload> _backgroundReloads;
+    std::mutex _backgroundReloadLock;
+
     /**
      * @brief Executed when a World Session is being finalized. Be it from a normal login or via queue popping.
      *
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "WorldLoadGraph.h"
+#include "Errors.h"
+#include "Log.h"
+#include "Timer.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+void WorldLoadGraph::Add(std::string name, Loader loader, std::initializer_list<std::string_view> dependencies)
+{
+    uint32 stage = 0;
+    for (std::string_view dependency : dependencies)
+    {
+        auto itr = std::find_if(_nodes.begin(), _nodes.end(), [dependency](Node const& node) { return node.Name == dependency; });
+        WPFatal(itr != _nodes.end(), "WorldLoadGraph {}: loader {} depends on unknown loader {}", _name, name, dependency);
+        stage = std::max(stage, itr->Stage + 1);
+    }
+
+    _nodes.push_back({ std::move(name), std::move(loader), stage });
+}
+
+void WorldLoadGraph::Run(uint32 threads)
+{
+    uint32 oldMSTime = getMSTime();
+
+    if (threads <= 1)
+    {
+        for (Node const& node : _nodes)
+            node.Load();
+
+        _nodes.clear();
+        return;
+    }
+
+    uint32 stageCount = 0;
+    for (Node const& node : _nodes)
+        stageCount = std::max(stageCount, node.Stage + 1);
+
+    for (uint32 stage = 0; stage < stageCount; ++stage)
+    {
+        std::vector<Node const*> nodes;
+        for (Node const& node : _nodes)
+            if (node.Stage == stage)
+                nodes.push_back(&node);
+
+        uint32 stageMSTime = getMSTime();
+        RunStage(nodes, threads);
+        LOG_INFO("server.loading", ">> {} stage {} ({} loaders) finished in {} ms", _name, stage + 1, nodes.size(), GetMSTimeDiffToNow(stageMSTime));
+    }
+
+    LOG_INFO("server.loading", ">> {} loaded in {} stages with {} threads in {} ms", _name, stageCount, threads, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+    _nodes.clear();
+}
+
+void WorldLoadGraph::RunStage(std::vector<Node const*> const& nodes, uint32 threads) const
+{
+    std::atomic<std::size_t> nextNode(0);
+    auto worker = [&nodes, &nextNode]()
+    {
+        std::size_t index;
+        while ((index = nextNode++) < nodes.size())
+        {
+            uint32 nodeMSTime = getMSTime();
+            nodes[index]->Load();
+            LOG_DEBUG("server.loading", "Loader {} finished in {} ms", nodes[index]->Name, GetMSTimeDiffToNow(nodeMSTime));
+        }
+    };
+
+    // the calling thread handles one share of the work itself
+    std::vector<std::thread> helpers;
+    std::size_t helperCount = std::min<std::size_t>(nodes.size(), threads) - 1;
+    helpers.reserve(helperCount);
+    for (std::size_t i = 0; i < helperCount; ++i)
+        helpers.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& helper : helpers)
+        helper.join();
+}
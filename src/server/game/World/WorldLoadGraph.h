@@ -0,0 +1,64 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WORLD_LOAD_GRAPH_H_INCLUDED
+#define _WORLD_LOAD_GRAPH_H_INCLUDED
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Runs startup loaders that only depend on a few other loaders concurrently.
+ * Loaders are grouped into stages: a stage holds every loader whose dependencies
+ * were all loaded by earlier stages, and the loaders of one stage are run by
+ * several threads at once. Each thread issues its own synchronous queries, so
+ * WorldDatabase.SynchThreads limits how many of them really query in parallel.
+ * Loaders of one graph must never write to data used by another loader of the
+ * same graph unless it is declared as a dependency.
+ */
+class WorldLoadGraph
+{
+public:
+    typedef std::function<void()> Loader;
+
+    explicit WorldLoadGraph(std::string name) : _name(std::move(name)) { }
+
+    // dependencies must have been added before
+    void Add(std::string name, Loader loader, std::initializer_list<std::string_view> dependencies = { });
+
+    // loads everything and returns once all loaders have finished, threads <= 1 loads sequentially in insertion order
+    void Run(uint32 threads);
+
+private:
+    struct Node
+    {
+        std::string Name;
+        Loader Load;
+        uint32 Stage;
+    };
+
+    void RunStage(std::vector<Node const*> const& nodes, uint32 threads) const;
+
+    std::string _name;
+    std::vector<Node> _nodes;
+};
+
+#endif //_WORLD_LOAD_GRAPH_H_INCLUDED
@@ -28,20 +28,25 @@
 #include "Channel.h"
 #include "Chat.h"
 #include "CommandScript.h"
+#include "GameTime.h"
 #include "GossipDef.h"
 #include "GridNotifiersImpl.h"
+#include "HeapAllocator.h"
 #include "LFGMgr.h"
 #include "Language.h"
 #include "Log.h"
 #include "M2Stores.h"
 #include "MapMgr.h"
+#include "MemoryAccounting.h"
 #include "ObjectMgr.h"
+#include "OpcodeStats.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
 #include "SpellMgr.h"
 #include "Transport.h"
 #include "Warden.h"
 #include "World.h"
+#include "ZoneProfiler.h"
 #include <fstream>
 #include <set>
 
@@ -76,6 +81,21 @@ public:
             { "setphaseshift",  HandleDebugSendSetPhaseShiftCommand,   SEC_ADMINISTRATOR, Console::No },
             { "spellfail",      HandleDebugSendSpellFailCommand,       SEC_ADMINISTRATOR, Console::No }
         };
+        static ChatCommandTable debugProfileCommandTable =
+        {
+            { "start",          HandleDebugProfileStartCommand,        SEC_ADMINISTRATOR, Console::Yes },
+            { "stop",           HandleDebugProfileStopCommand,         SEC_ADMINISTRATOR, Console::Yes }
+        };
+        static ChatCommandTable debugOpcodeStatsCommandTable =
+        {
+            { "",               HandleDebugOpcodeStatsCommand,         SEC_ADMINISTRATOR, Console::Yes },
+            { "reset",          HandleDebugOpcodeStatsResetCommand,    SEC_ADMINISTRATOR, Console::Yes }
+        };
+        static ChatCommandTable debugHeapCommandTable =
+        {
+            { "dump",           HandleDebugHeapDumpCommand,            SEC_ADMINISTRATOR, Console::Yes },
+            { "stats",          HandleDebugHeapStatsCommand,           SEC_ADMINISTRATOR, Console::Yes }
+        };
         static ChatCommandTable debugCommandTable =
         {
             { "setbit",         HandleDebugSet32BitCommand,            SEC_ADMINISTRATOR, Console::No },
@@ -106,6 +126,10 @@ public:
             { "moveflags",      HandleDebugMoveflagsCommand,           SEC_ADMINISTRATOR, Console::No },
             { "unitstate",      HandleDebugUnitStateCommand,           SEC_ADMINISTRATOR, Console::No },
             { "objectcount",    HandleDebugObjectCountCommand,         SEC_ADMINISTRATOR, Console::Yes},
+            { "profile",        debugProfileCommandTable },
+            { "opcodestats",    debugOpcodeStatsCommandTable },
+            { "heap",           debugHeapCommandTable },
+            { "memory",         HandleDebugMemoryCommand,              SEC_ADMINISTRATOR, Console::Yes },
             { "dummy",          HandleDebugDummyCommand,               SEC_ADMINISTRATOR, Console::No }
         };
         static ChatCommandTable commandTable =
@@ -1289,6 +1313,137 @@ public:
         return true;
     }
 
+    static bool HandleDebugProfileStartCommand(ChatHandler* handler)
+    {
+#if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
+        handler->SendSysMessage("Zone profiling is not available in this build.");
+#else
+        if (sZoneProfiler->IsRecording())
+        {
+            handler->SendErrorMessage("Zone profiling is already running.");
+            return false;
+        }
+
+        sZoneProfiler->Start();
+        handler->SendSysMessage("Zone profiling started, use .debug profile stop to write the results.");
+#endif
+        return true;
+    }
+
+    static bool HandleDebugProfileStopCommand(ChatHandler* handler, Optional<std::string> name)
+    {
+        if (!sZoneProfiler->IsRecording())
+        {
+            handler->SendErrorMessage("Zone profiling is not running.");
+            return false;
+        }
+
+        std::string fileName = name ? *name : Acore::StringFormat("profile_%u", uint32(GameTime::GetGameTime().count()));
+        if (fileName.empty() || fileName.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-") != std::string::npos)
+        {
+            handler->SendErrorMessage("Invalid profile name, only letters, digits, '_' and '-' are allowed.");
+            return false;
+        }
+
+        std::string basePath = sLog->GetLogsDir() + fileName;
+        std::size_t eventCount = 0;
+        if (!sZoneProfiler->Stop(basePath, &eventCount))
+        {
+            handler->SendErrorMessage("Could not write profile to %s.json / %s.folded.", basePath, basePath);
+            return false;
+        }
+
+        handler->PSendSysMessage("Zone profile with %u events written to %s.json and %s.folded.", uint32(eventCount), basePath, basePath);
+        return true;
+    }
+
+    static bool HandleDebugOpcodeStatsCommand(ChatHandler* handler, Optional<uint32> count)
+    {
+        if (!sWorld->getBoolConfig(CONFIG_OPCODE_STATS))
+        {
+            handler->SendErrorMessage("Opcode statistics are disabled (Network.OpcodeStats).");
+            return false;
+        }
+
+        auto topOpcodes = sOpcodeStatsMgr->GetTopOpcodes(count.value_or(10));
+        if (topOpcodes.empty())
+        {
+            handler->SendSysMessage("No opcode statistics recorded yet.");
+            return true;
+        }
+
+        handler->SendSysMessage("Opcodes by total handler time (time in us, output in bytes):");
+        for (auto const& [opcode, stats] : topOpcodes)
+        {
+            handler->PSendSysMessage("%s: count %u total %u | time avg %u p50 %u p99 %u max %u | output avg %u p99 %u max %u",
+                GetOpcodeNameForLogging(opcode), uint32(stats->Time.GetCount()), uint32(stats->Time.GetTotal()),
+                uint32(stats->Time.GetMean()), uint32(stats->Time.GetPercentile(50.0)), uint32(stats->Time.GetPercentile(99.0)), uint32(stats->Time.GetMax()),
+                uint32(stats->Bytes.GetMean()), uint32(stats->Bytes.GetPercentile(99.0)), uint32(stats->Bytes.GetMax()));
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugOpcodeStatsResetCommand(ChatHandler* handler)
+    {
+        sOpcodeStatsMgr->Reset();
+        handler->SendSysMessage("Opcode statistics reset.");
+        return true;
+    }
+
+    static bool HandleDebugHeapDumpCommand(ChatHandler* handler, Optional<std::string> name)
+    {
+        std::string fileName = name ? *name : Acore::StringFormat("heap_%u", uint32(GameTime::GetGameTime().count()));
+        if (fileName.empty() || fileName.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_-") != std::string::npos)
+        {
+            handler->SendErrorMessage("Invalid heap profile name, only letters, digits, '_' and '-' are allowed.");
+            return false;
+        }
+
+        std::string path = sLog->GetLogsDir() + fileName + ".heap";
+        std::string error;
+        if (!Acore::Heap::DumpHeapProfile(path, error))
+        {
+            handler->SendErrorMessage("Could not write heap profile: %s.", error);
+            return false;
+        }
+
+        handler->PSendSysMessage("Heap profile written to %s.", path);
+        return true;
+    }
+
+    static bool HandleDebugMemoryCommand(ChatHandler* handler)
+    {
+        std::size_t total = 0;
+        handler->SendSysMessage("Estimated memory per subsystem:");
+        for (auto const& [subsystem, size] : sMemoryAccounting->Collect())
+        {
+            handler->PSendSysMessage("%s: %u KB", subsystem, uint32(size / 1024));
+            total += size;
+        }
+
+        handler->PSendSysMessage("Total: %u KB", uint32(total / 1024));
+        return true;
+    }
+
+    static bool HandleDebugHeapStatsCommand(ChatHandler* handler)
+    {
+        Acore::Heap::HeapStats stats;
+        if (!Acore::Heap::GetHeapStats(stats))
+        {
+            handler->PSendSysMessage("No heap statistics available from the %s allocator.", Acore::Heap::GetAllocatorName());
+            return true;
+        }
+
+        handler->PSendSysMessage("%s: allocated %u KB, active %u KB, resident %u KB, mapped %u KB, retained %u KB", Acore::Heap::GetAllocatorName(),
+            uint32(stats.Allocated / 1024), uint32(stats.Active / 1024), uint32(stats.Resident / 1024), uint32(stats.Mapped / 1024), uint32(stats.Retained / 1024));
+
+        for (Acore::Heap::ArenaStats const& arena : stats.Arenas)
+            handler->PSendSysMessage("Arena %s: allocated %u KB, resident %u KB", arena.Name, uint32(arena.Allocated / 1024), uint32(arena.Resident / 1024));
+
+        return true;
+    }
+
     class CreatureCountWorker
     {
     public:
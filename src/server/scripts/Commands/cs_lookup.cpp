@@ -200,7 +200,7 @@ public:
             {
                 if (creatureLocale->Name.size() > localeIndex && !creatureLocale->Name[localeIndex].empty())
                 {
-                    std::string name = creatureLocale->Name[localeIndex];
+                    std::string name(creatureLocale->Name[localeIndex]);
 
                     if (Utf8FitTo(name, wNamePart))
                     {
@@ -505,7 +505,7 @@ public:
                 {
                     if (il->Name.size() > ulocaleIndex && !il->Name[ulocaleIndex].empty())
                     {
-                        std::string name = il->Name[ulocaleIndex];
+                        std::string name(il->Name[ulocaleIndex]);
 
                         if (Utf8FitTo(name, wNamePart))
                         {
@@ -692,7 +692,7 @@ public:
             {
                 if (objectLocalte->Name.size() > localeIndex && !objectLocalte->Name[localeIndex].empty())
                 {
-                    std::string name = objectLocalte->Name[localeIndex];
+                    std::string name(objectLocalte->Name[localeIndex]);
 
                     if (Utf8FitTo(name, wNamePart))
                     {
@@ -793,7 +793,7 @@ public:
                 {
                     if (questLocale->Title.size() > ulocaleIndex && !questLocale->Title[ulocaleIndex].empty())
                     {
-                        std::string title = questLocale->Title[ulocaleIndex];
+                        std::string title(questLocale->Title[ulocaleIndex]);
 
                         if (Utf8FitTo(title, wNamePart))
                         {
@@ -33,10 +33,12 @@ EndScriptData */
 #include "GameGraveyard.h"
 #include "LFGMgr.h"
 #include "Language.h"
+#include "LootMgr.h"
 #include "MapMgr.h"
 #include "MotdMgr.h"
 #include "ObjectMgr.h"
 #include "ScriptMgr.h"
+#include "ScriptReloadMgr.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "SmartAI.h"
@@ -46,6 +48,8 @@ EndScriptData */
 #include "Tokenize.h"
 #include "WardenCheckMgr.h"
 #include "WaypointMgr.h"
+#include "World.h"
+#include "WorldPacket.h"
 
 using namespace Acore::ChatCommands;
 
@@ -151,6 +155,7 @@ public:
             { "skill_extra_item_template",     HandleReloadSkillExtraItemTemplateCommand,     SEC_ADMINISTRATOR, Console::Yes },
             { "skill_fishing_base_level",      HandleReloadSkillFishingBaseLevelCommand,      SEC_ADMINISTRATOR, Console::Yes },
             { "skinning_loot_template",        HandleReloadLootTemplatesSkinningCommand,      SEC_ADMINISTRATOR, Console::Yes },
+            { "script_module",                 HandleReloadScriptModuleCommand,               SEC_ADMINISTRATOR, Console::Yes },
             { "smart_scripts",                 HandleReloadSmartScripts,                      SEC_ADMINISTRATOR, Console::Yes },
             { "spell_required",                HandleReloadSpellRequiredCommand,              SEC_ADMINISTRATOR, Console::Yes },
             { "spell_area",                    HandleReloadSpellAreaCommand,                  SEC_ADMINISTRATOR, Console::Yes },
@@ -423,6 +428,7 @@ public:
         LOG_INFO("server.loading", "Re-Loading Broadcast texts...");
         sObjectMgr->LoadBroadcastTexts();
         sObjectMgr->LoadBroadcastTextLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_GOSSIP_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `broadcast_text` reloaded.");
         return true;
     }
@@ -570,6 +576,7 @@ public:
     {
         LOG_INFO("server.loading", "Re-Loading Quest Templates...");
         sObjectMgr->LoadQuests();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_QUESTS);
         handler->SendGlobalGMSysMessage("DB table `quest_template` (quest definitions) reloaded.");
 
         /// dependent also from `gameobject` but this table not reloaded anyway
@@ -579,16 +586,46 @@ public:
         return true;
     }
 
-    static bool HandleReloadLootTemplatesCreatureCommand(ChatHandler* handler)
+    // The table is read on a background thread, the world thread only swaps the new templates in and hands
+    // them the loot conditions already loaded, so the server does not stall on big tables
+    static bool QueueLootTemplatesReload(ChatHandler* handler, LootStore& store, ConditionSourceType conditionType, void (*load)())
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`creature_loot_template`)");
-        LoadLootTemplates_Creature();
-        LootTemplates_Creature.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `creature_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
+        std::string const name = store.GetName();
+        bool const queued = sWorld->QueueBackgroundReload(name, [&store, conditionType, load, name]() -> std::function<void()>
+        {
+            store.PrepareReload();
+
+            return [&store, conditionType, load, name]()
+            {
+                load();
+
+                // the reference table checks the references of every loot table itself
+                if (&store != &LootTemplates_Reference)
+                    store.CheckLootRefs();
+
+                sConditionMgr->AttachLootConditions(conditionType, store);
+
+                WorldPacket data;
+                ChatHandler::BuildChatPacket(data, CHAT_MSG_SYSTEM, LANG_UNIVERSAL, nullptr, nullptr, Acore::StringFormat("DB table `{}` reloaded.", name));
+                sWorld->SendGlobalGMMessage(&data);
+            };
+        });
+
+        if (!queued)
+        {
+            handler->SendErrorMessage("DB table `{}` is already being reloaded, please attempt reload later.", name);
+            return false;
+        }
+
+        handler->PSendSysMessage("Reloading DB table `{}` in the background.", name);
         return true;
     }
 
+    static bool HandleReloadLootTemplatesCreatureCommand(ChatHandler* handler)
+    {
+        return QueueLootTemplatesReload(handler, LootTemplates_Creature, CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE, &LoadLootTemplates_Creature);
+    }
+
     static bool HandleReloadCreatureMovementOverrideCommand(ChatHandler* handler)
     {
         LOG_INFO("server.loading", "Re-Loading Creature movement overrides...");
@@ -599,121 +636,62 @@ public:
 
     static bool HandleReloadLootTemplatesDisenchantCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`disenchant_loot_template`)");
-        LoadLootTemplates_Disenchant();
-        LootTemplates_Disenchant.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `disenchant_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Disenchant, CONDITION_SOURCE_TYPE_DISENCHANT_LOOT_TEMPLATE, &LoadLootTemplates_Disenchant);
     }
 
     static bool HandleReloadLootTemplatesFishingCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`fishing_loot_template`)");
-        LoadLootTemplates_Fishing();
-        LootTemplates_Fishing.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `fishing_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Fishing, CONDITION_SOURCE_TYPE_FISHING_LOOT_TEMPLATE, &LoadLootTemplates_Fishing);
     }
 
     static bool HandleReloadLootTemplatesGameobjectCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`gameobject_loot_template`)");
-        LoadLootTemplates_Gameobject();
-        LootTemplates_Gameobject.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `gameobject_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Gameobject, CONDITION_SOURCE_TYPE_GAMEOBJECT_LOOT_TEMPLATE, &LoadLootTemplates_Gameobject);
     }
 
     static bool HandleReloadLootTemplatesItemCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`item_loot_template`)");
-        LoadLootTemplates_Item();
-        LootTemplates_Item.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `item_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Item, CONDITION_SOURCE_TYPE_ITEM_LOOT_TEMPLATE, &LoadLootTemplates_Item);
     }
 
     static bool HandleReloadLootTemplatesMillingCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`milling_loot_template`)");
-        LoadLootTemplates_Milling();
-        LootTemplates_Milling.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `milling_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Milling, CONDITION_SOURCE_TYPE_MILLING_LOOT_TEMPLATE, &LoadLootTemplates_Milling);
     }
 
     static bool HandleReloadLootTemplatesPickpocketingCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`pickpocketing_loot_template`)");
-        LoadLootTemplates_Pickpocketing();
-        LootTemplates_Pickpocketing.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `pickpocketing_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Pickpocketing, CONDITION_SOURCE_TYPE_PICKPOCKETING_LOOT_TEMPLATE, &LoadLootTemplates_Pickpocketing);
     }
 
     static bool HandleReloadLootTemplatesProspectingCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`prospecting_loot_template`)");
-        LoadLootTemplates_Prospecting();
-        LootTemplates_Prospecting.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `prospecting_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Prospecting, CONDITION_SOURCE_TYPE_PROSPECTING_LOOT_TEMPLATE, &LoadLootTemplates_Prospecting);
     }
 
     static bool HandleReloadLootTemplatesMailCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`mail_loot_template`)");
-        LoadLootTemplates_Mail();
-        LootTemplates_Mail.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `mail_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Mail, CONDITION_SOURCE_TYPE_MAIL_LOOT_TEMPLATE, &LoadLootTemplates_Mail);
     }
 
     static bool HandleReloadLootTemplatesReferenceCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`reference_loot_template`)");
-        LoadLootTemplates_Reference();
-        handler->SendGlobalGMSysMessage("DB table `reference_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Reference, CONDITION_SOURCE_TYPE_REFERENCE_LOOT_TEMPLATE, &LoadLootTemplates_Reference);
     }
 
     static bool HandleReloadLootTemplatesSkinningCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`skinning_loot_template`)");
-        LoadLootTemplates_Skinning();
-        LootTemplates_Skinning.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `skinning_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Skinning, CONDITION_SOURCE_TYPE_SKINNING_LOOT_TEMPLATE, &LoadLootTemplates_Skinning);
     }
 
     static bool HandleReloadLootTemplatesSpellCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`spell_loot_template`)");
-        LoadLootTemplates_Spell();
-        LootTemplates_Spell.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `spell_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Spell, CONDITION_SOURCE_TYPE_SPELL_LOOT_TEMPLATE, &LoadLootTemplates_Spell);
     }
 
     static bool HandleReloadLootTemplatesPlayerCommand(ChatHandler* handler)
     {
-        LOG_INFO("server.loading", "Re-Loading Loot Tables... (`player_loot_template`)");
-        LoadLootTemplates_Player();
-        LootTemplates_Player.CheckLootRefs();
-        handler->SendGlobalGMSysMessage("DB table `player_loot_template` reloaded.");
-        sConditionMgr->LoadConditions(true);
-        return true;
+        return QueueLootTemplatesReload(handler, LootTemplates_Player, CONDITION_SOURCE_TYPE_PLAYER_LOOT_TEMPLATE, &LoadLootTemplates_Player);
     }
 
     static bool HandleReloadAcoreStringCommand(ChatHandler* handler)
@@ -935,6 +913,7 @@ public:
     {
         LOG_INFO("server.loading", "Re-Loading Page Texts...");
         sObjectMgr->LoadPageTexts();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_PAGE_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `page_texts` reloaded.");
         handler->SendGlobalGMSysMessage("You need to delete your client cache or change the cache number in config in order for your players see the changes.");
         return true;
@@ -1084,6 +1063,7 @@ public:
     {
         LOG_INFO("server.loading", "Re-Loading Gameobject Template Locale ... ");
         sObjectMgr->LoadGameObjectLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_GAMEOBJECTS);
         handler->SendGlobalGMSysMessage("DB table `gameobject_template_locale` reloaded.");
         return true;
     }
@@ -1116,6 +1096,7 @@ public:
     {
         LOG_INFO("server.loading", "Re-Loading NPC Text Locale ... ");
         sObjectMgr->LoadNpcTextLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_GOSSIP_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `npc_text_locale` reloaded.");
         return true;
     }
@@ -1124,6 +1105,7 @@ public:
     {
         LOG_INFO("server.loading", "Re-Loading Page Text Locale ... ");
         sObjectMgr->LoadPageTextLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_PAGE_TEXTS);
         handler->SendGlobalGMSysMessage("DB table `page_text_locale` reloaded.");
         handler->SendGlobalGMSysMessage("You need to delete your client cache or change the cache number in config in order for your players see the changes.");
         return true;
@@ -1141,6 +1123,7 @@ public:
     {
         LOG_INFO("server.loading", "Re-Loading Locales Quest ... ");
         sObjectMgr->LoadQuestLocales();
+        sObjectMgr->InitializeQueriesData(QUERY_DATA_QUESTS);
         handler->SendGlobalGMSysMessage("DB table `quest_template_locale` reloaded.");
         return true;
     }
@@ -1211,6 +1194,29 @@ public:
         return true;
     }
 
+    static bool HandleReloadScriptModuleCommand(ChatHandler* handler, Optional<std::string> name)
+    {
+        if (!sScriptReloadMgr->IsEnabled())
+        {
+            handler->SendErrorMessage("Dynamic script modules are disabled, set Scripts.ModulesDirectory to enable them.");
+            return false;
+        }
+
+        // Without a name list the modules which can be swapped
+        if (!name)
+        {
+            for (std::string const& module : sScriptReloadMgr->GetModuleNames())
+                handler->PSendSysMessage("{}", module);
+
+            return true;
+        }
+
+        LOG_INFO("server.loading", "Queueing swap of script module {}...", *name);
+        sScriptReloadMgr->QueueModuleSwap(*name);
+        handler->SendGlobalGMSysMessage("Script module swap queued, creatures use the new scripts from their next respawn.");
+        return true;
+    }
+
     static bool HandleReloadVehicleAccessoryCommand(ChatHandler* handler)
     {
         LOG_INFO("server.loading", "Reloading vehicle_accessory table...");
@@ -279,6 +279,10 @@ public:
                                  sWorldUpdateTime.GetPercentile(99),
                                  sWorldUpdateTime.GetPercentile(100));
 
+        handler->SendSysMessage("Slowest update sections (95th percentile):");
+        for (auto const& [section, time] : sWorldUpdateTime.GetSlowestSections(95, 3))
+            handler->PSendSysMessage("- %s: %uus", std::string(section).c_str(), time);
+
         //! Can't use sWorld->ShutdownMsg here in case of console command
         if (sWorld->IsShuttingDown())
             handler->PSendSysMessage(LANG_SHUTDOWN_TIMELEFT, secsToTimeString(sWorld->GetShutDownTimeLeft()).append(".").c_str());
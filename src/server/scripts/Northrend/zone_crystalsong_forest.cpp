@@ -41,7 +41,7 @@ struct npc_preparations_for_war_vehicle : public NullCreatureAI
 
     void InitializeAI() override
     {
-        WPPath* path = sSmartWaypointMgr->GetPath(me->GetEntry());
+        WPPath const* path = sSmartWaypointMgr->GetPath(me->GetEntry());
         if (!path || path->empty())
         {
             me->DespawnOrUnsummon(1);
@@ -55,7 +55,7 @@ struct npc_preparations_for_war_vehicle : public NullCreatureAI
         WPPath::const_iterator itr;
         while ((itr = path->find(wpCounter++)) != path->end())
         {
-            WayPoint* wp = itr->second;
+            WayPoint const* wp = &itr->second;
             pathPoints.push_back(G3D::Vector3(wp->x, wp->y, wp->z));
         }
 
@@ -1373,7 +1373,7 @@ public:
                 WaypointPath const* i_path = sWaypointMgr->GetPath(NPC_PLANE);
                 for (uint8 i = 0; i < i_path->size(); ++i)
                 {
-                    WaypointData const* node = i_path->at(i);
+                    WaypointData const* node = &i_path->at(i);
                     pathPoints.push_back(G3D::Vector3(node->x, node->y, node->z));
                 }
 
@@ -471,7 +471,7 @@ public:
                 WaypointPath const* i_path = sWaypointMgr->GetPath(me->GetWaypointPath());
                 for (uint8 i = 0; i < i_path->size(); ++i)
                 {
-                    WaypointData const* node = i_path->at(i);
+                    WaypointData const* node = &i_path->at(i);
                     pathPoints.push_back(G3D::Vector3(node->x, node->y, node->z));
                 }
 
@@ -873,7 +873,7 @@ public:
                                 WaypointPath const* i_path = sWaypointMgr->GetPath(NPC_DRAKE);
                                 for (uint8 i = 0; i < i_path->size(); ++i)
                                 {
-                                    WaypointData const* node = i_path->at(i);
+                                    WaypointData const* node = &i_path->at(i);
                                     pathPoints.push_back(G3D::Vector3(node->x, node->y, node->z));
                                 }
 
@@ -1118,7 +1118,7 @@ public:
                 WaypointPath const* i_path = sWaypointMgr->GetPath(me->GetEntry() * 100);
                 for (uint8 i = 0; i < i_path->size(); ++i)
                 {
-                    WaypointData const* node = i_path->at(i);
+                    WaypointData const* node = &i_path->at(i);
                     pathPoints.push_back(G3D::Vector3(node->x, node->y, node->z));
                 }
                 me->GetMotionMaster()->MoveSplinePath(&pathPoints);
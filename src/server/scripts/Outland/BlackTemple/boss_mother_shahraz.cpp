@@ -251,8 +251,8 @@ class spell_mother_shahraz_fatal_attraction : public SpellScript
 
     void SetDest(SpellDestination& dest)
     {
-        std::list<TargetInfo> const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-        for (std::list<TargetInfo>::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+        TargetInfoList const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
+        for (TargetInfoList::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
             if (Unit* target = ObjectAccessor::GetUnit(*GetCaster(), ihit->targetGUID))
             {
                 dest.Relocate(*target);
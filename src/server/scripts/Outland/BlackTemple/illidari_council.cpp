@@ -604,8 +604,8 @@ class spell_illidari_council_empyreal_balance : public SpellScript
         }
 
         float pct = (_sharedHealth / _sharedHealthMax) * 100.0f;
-        std::list<TargetInfo> const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
-        for (std::list<TargetInfo>::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
+        TargetInfoList const* targetsInfo = GetSpell()->GetUniqueTargetInfo();
+        for (TargetInfoList::const_iterator ihit = targetsInfo->begin(); ihit != targetsInfo->end(); ++ihit)
             if (Creature* target = ObjectAccessor::GetCreature(*GetCaster(), ihit->targetGUID))
             {
                 target->LowerPlayerDamageReq(target->GetMaxHealth());
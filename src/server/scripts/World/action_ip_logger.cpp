@@ -149,7 +149,7 @@ public:
             stmt->SetData(2, aType);
             stmt->SetData(3, playerGuid);
             stmt->SetData(4, systemNote.c_str());
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, DATABASE_QUEUE_BACKGROUND);
         }
         else // ... but for failed login, we query last_attempt_ip from account table. Which we do with an unique query
         {
@@ -160,7 +160,7 @@ public:
             stmt->SetData(2, aType);
             stmt->SetData(3, playerGuid);
             stmt->SetData(4, systemNote.c_str());
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, DATABASE_QUEUE_BACKGROUND);
         }
         return;
     }
@@ -256,7 +256,7 @@ public:
         // Seeing as the time differences should be minimal, we do not get unixtime and the timestamp right now;
         // Rather, we let it be added with the SQL query.
 
-        LoginDatabase.Execute(stmt);
+        LoginDatabase.Execute(stmt, DATABASE_QUEUE_BACKGROUND);
         return;
     }
 };
@@ -325,7 +325,7 @@ public:
         // Seeing as the time differences should be minimal, we do not get unixtime and the timestamp right now;
         // Rather, we let it be added with the SQL query.
 
-        LoginDatabase.Execute(stmt2);
+        LoginDatabase.Execute(stmt2, DATABASE_QUEUE_BACKGROUND);
         return;
     }
 };
@@ -17,6 +17,7 @@
 
 #include "DBCStore.h"
 #include "DBCDatabaseLoader.h"
+#include "DBCFileLoader.h"
 
 DBCStorageBase::DBCStorageBase(char const* fmt) : _fieldCount(0), _fileFormat(fmt), _dataTable(nullptr), _indexTableSize(0)
 {
@@ -33,19 +34,27 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
 {
     indexTable = nullptr;
 
-    DBCFileLoader dbc;
+    auto dbc = std::make_unique<DBCFileLoader>();
 
     // Check if load was sucessful, only then continue
-    if (!dbc.Load(path, _fileFormat))
+    if (!dbc->Load(path, _fileFormat))
         return false;
 
-    _fieldCount = dbc.GetCols();
+    _fieldCount = dbc->GetCols();
+
+    // records matching the structure are not copied, the store keeps the file mapped instead
+    if (dbc->HasStructureLayout(_fileFormat))
+    {
+        indexTable = dbc->AutoProduceIndex(_fileFormat, _indexTableSize);
+        _mappedFile = std::move(dbc);
+        return indexTable != nullptr;
+    }
 
     // load raw non-string data
-    _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
+    _dataTable = dbc->AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
     // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
+    if (char* stringBlock = dbc->AutoProduceStrings(_fileFormat, _dataTable))
         _stringPool.push_back(stringBlock);
 
     // error in dbc file at loading if nullptr
@@ -58,6 +67,10 @@ bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
     if (!indexTable)
         return false;
 
+    // no strings to localize
+    if (!std::strchr(_fileFormat, FT_STRING))
+        return true;
+
     DBCFileLoader dbc;
 
     // Check if load was successful, only then continue
@@ -22,8 +22,11 @@
 #include "DBCStorageIterator.h"
 #include "Errors.h"
 #include <cstring>
+#include <memory>
 #include <vector>
 
+class DBCFileLoader;
+
 /// Interface class for common access
 class DBCStorageBase
 {
@@ -48,6 +51,9 @@ protected:
     char* _dataTable;
     std::vector<char*> _stringPool;
     uint32 _indexTableSize;
+
+    // set instead of _dataTable when the records are used straight from the mapped file
+    std::unique_ptr<DBCFileLoader> _mappedFile;
 };
 
 template <class T>
@@ -24,6 +24,7 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "ProcessPriority.h"
 #include "Timer.h"
 #include <atomic>
 #include <boost/asio/ip/tcp.hpp>
@@ -40,6 +41,7 @@ class NetworkThread
 {
 public:
     NetworkThread() :
+        _updateQueue(std::make_shared<SocketUpdateQueue<SocketType>>([this]() { Acore::Asio::post(_ioContext, [this]() { UpdateSockets(); }); })),
         _ioContext(1), _acceptSocket(_ioContext), _updateTimer(_ioContext), _proxyHeaderReadingEnabled(false) { }
 
     virtual ~NetworkThread()
@@ -55,6 +57,7 @@ public:
     void Stop()
     {
         _stopped = true;
+        _updateQueue->Close();
         _ioContext.stop();
     }
 
@@ -95,6 +98,8 @@ public:
 
     tcp::socket* GetSocketForAccept() { return &_acceptSocket; }
 
+    Acore::Asio::IoContext& GetIoContext() { return _ioContext; }
+
     void EnableProxyProtocol() { _proxyHeaderReadingEnabled = true; }
 
 protected:
@@ -119,9 +124,7 @@ protected:
                     continue;
                 }
 
-                _sockets.emplace_back(sock);
-
-                sock->Start();
+                StartSocket(sock);
             }
 
             _newSockets.clear();
@@ -159,10 +162,7 @@ protected:
 
                 case PROXY_HEADER_READING_STATE_FINISHED:
                     newSocketsToRemoveIndexes.emplace_back(index);
-                    _sockets.emplace_back(sock);
-
-                    sock->Start();
-
+                    StartSocket(sock);
                     break;
 
                 default:
@@ -181,6 +181,9 @@ protected:
     {
         LOG_DEBUG("misc", "Network Thread Starting");
 
+        static std::atomic<uint32> threadIndex{0};
+        SetupCurrentThread("Network", threadIndex++);
+
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
         _ioContext.run();
@@ -188,6 +191,8 @@ protected:
         LOG_DEBUG("misc", "Network Thread exits");
         _newSockets.clear();
         _sockets.clear();
+        _polledSockets.clear();
+        _updatedSockets.clear();
     }
 
     void Update()
@@ -199,22 +204,62 @@ protected:
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
 
         AddNewSockets();
+        UpdateSockets();
+    }
+
+    void StartSocket(std::shared_ptr<SocketType> const& sock)
+    {
+        _sockets.emplace_back(sock);
 
-        _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [this](std::shared_ptr<SocketType> sock)
+        sock->SetUpdateQueue(_updateQueue);
+        sock->Start();
+        PollSocket(sock);
+    }
+
+    /// Keeps updating the socket on every timer tick until it has no pending work
+    void PollSocket(std::shared_ptr<SocketType> const& sock)
+    {
+        if (sock->TryKeepUpdateRequest())
+            _polledSockets.push_back(sock);
+    }
+
+    /// Updates the polled sockets and the ones queued since the last pass, idle sockets are not touched
+    void UpdateSockets()
+    {
+        if (_stopped)
+            return;
+
+        _updatedSockets.swap(_polledSockets);
+        _updateQueue->MoveTo(_updatedSockets);
+
+        bool removed = false;
+        for (std::shared_ptr<SocketType> const& sock : _updatedSockets)
         {
+            sock->ResetUpdateRequest();
+
             if (!sock->Update())
             {
+                if (!sock->MarkRemoved())
+                    continue;
+
                 if (sock->IsOpen())
                     sock->CloseSocket();
 
-                this->SocketRemoved(sock);
+                SocketRemoved(sock);
 
-                --this->_connections;
-                return true;
+                --_connections;
+                removed = true;
+                continue;
             }
 
-            return false;
-        }), _sockets.end());
+            if (sock->HasPendingUpdate())
+                PollSocket(sock);
+        }
+
+        if (removed)
+            _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [](std::shared_ptr<SocketType> const& sock) { return sock->IsRemoved(); }), _sockets.end());
+
+        _updatedSockets.clear();
     }
 
 private:
@@ -226,6 +271,10 @@ private:
     std::unique_ptr<std::thread> _thread;
 
     SocketContainer _sockets;
+    SocketContainer _polledSockets;     // sockets with pending work nothing will wake them for, eg. database callbacks
+    SocketContainer _updatedSockets;
+
+    std::shared_ptr<SocketUpdateQueue<SocketType>> _updateQueue;
 
     std::mutex _newSocketsLock;
     SocketContainer _newSockets;
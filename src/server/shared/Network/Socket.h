@@ -20,17 +20,22 @@
 
 #include "Log.h"
 #include "MessageBuffer.h"
+#include <algorithm>
 #include <atomic>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio.hpp>
 #include <functional>
+#include <deque>
 #include <memory>
-#include <queue>
+#include <mutex>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
 #define READ_BLOCK_SIZE 4096
+#define MAX_GATHER_WRITE_BUFFERS 64
 #ifdef BOOST_ASIO_HAS_IOCP
 #define AC_SOCKET_USE_IOCP
 #endif
@@ -47,13 +52,83 @@ enum ProxyHeaderAddressFamilyAndProtocol {
     PROXY_HEADER_ADDRESS_FAMILY_AND_PROTOCOL_TCP_V6 = 0x21,
 };
 
+/// Entry of the socket write queue, either owns its data or references a buffer shared with other sockets
+class SocketWriteBuffer
+{
+public:
+    SocketWriteBuffer(MessageBuffer&& buffer) : _buffer(std::move(buffer)), _data(nullptr), _size(0) { }
+    SocketWriteBuffer(std::shared_ptr<void const> owner, uint8 const* data, std::size_t size) : _buffer(0), _owner(std::move(owner)), _data(data), _size(size) { }
+
+    [[nodiscard]] uint8 const* GetReadPointer() { return _owner ? _data : _buffer.GetReadPointer(); }
+    [[nodiscard]] std::size_t GetActiveSize() const { return _owner ? _size : _buffer.GetActiveSize(); }
+
+    void ReadCompleted(std::size_t bytes)
+    {
+        if (_owner)
+        {
+            _data += bytes;
+            _size -= bytes;
+        }
+        else
+            _buffer.ReadCompleted(bytes);
+    }
+
+private:
+    MessageBuffer _buffer;
+    std::shared_ptr<void const> _owner;
+    uint8 const* _data;
+    std::size_t _size;
+};
+
+/// Sockets waiting for their next Update() on a network thread. Shared by the thread and its sockets,
+/// so sockets can queue themselves from any thread without keeping the network thread alive.
+template<class T>
+class SocketUpdateQueue
+{
+public:
+    explicit SocketUpdateQueue(std::function<void()> wakeup) : _wakeup(std::move(wakeup)) { }
+
+    void Enqueue(std::shared_ptr<T> sock)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (!_wakeup)
+            return;
+
+        _sockets.push_back(std::move(sock));
+
+        // one wakeup per batch, the network thread takes every queued socket at once
+        if (_sockets.size() == 1)
+            _wakeup();
+    }
+
+    void MoveTo(std::vector<std::shared_ptr<T>>& sockets)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        sockets.insert(sockets.end(), std::make_move_iterator(_sockets.begin()), std::make_move_iterator(_sockets.end()));
+        _sockets.clear();
+    }
+
+    /// Called when the network thread stops, later requests are dropped
+    void Close()
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _wakeup = nullptr;
+        _sockets.clear();
+    }
+
+private:
+    std::mutex _lock;
+    std::vector<std::shared_ptr<T>> _sockets;
+    std::function<void()> _wakeup;
+};
+
 template<class T>
 class Socket : public std::enable_shared_from_this<T>
 {
 public:
     explicit Socket(tcp::socket&& socket) : _socket(std::move(socket)), _remoteAddress(_socket.remote_endpoint().address()),
-        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _closed(false), _closing(false), _isWritingAsync(false),
-        _proxyHeaderReadingState(PROXY_HEADER_READING_STATE_NOT_STARTED)
+        _remotePort(_socket.remote_endpoint().port()), _readBuffer(), _writeQueueSize(0), _closed(false), _closing(false), _updateRequested(false),
+        _removed(false), _isWritingAsync(false), _proxyHeaderReadingState(PROXY_HEADER_READING_STATE_NOT_STARTED)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
     }
@@ -87,6 +162,32 @@ public:
         return true;
     }
 
+    /// True if the socket has to be updated again without anything waking it, eg. to poll database callbacks
+    [[nodiscard]] virtual bool HasPendingUpdate() const
+    {
+        return !_isWritingAsync && !_writeQueue.empty();
+    }
+
+    /// Set by the network thread before the socket is started
+    void SetUpdateQueue(std::shared_ptr<SocketUpdateQueue<T>> updateQueue) { _updateQueue = std::move(updateQueue); }
+
+    /// Queues the socket for an Update() on its network thread, idle sockets are never updated. Thread safe.
+    void RequestUpdate()
+    {
+        if (_updateQueue && !_updateRequested.exchange(true))
+            _updateQueue->Enqueue(this->shared_from_this());
+    }
+
+    /// Used by the network thread: the socket is taken for an update, new requests queue it again
+    void ResetUpdateRequest() { _updateRequested = false; }
+
+    /// Used by the network thread to keep polling the socket, false if it was queued meanwhile
+    [[nodiscard]] bool TryKeepUpdateRequest() { return !_updateRequested.exchange(true); }
+
+    /// Used by the network thread, true only the first time a closed socket is dropped from it
+    [[nodiscard]] bool MarkRemoved() { return !std::exchange(_removed, true); }
+    [[nodiscard]] bool IsRemoved() const { return _removed; }
+
     [[nodiscard]] boost::asio::ip::address GetRemoteIpAddress() const
     {
         return _remoteAddress;
@@ -141,13 +242,28 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueueSize += buffer.GetActiveSize();
+        _writeQueue.emplace_back(std::move(buffer));
+
+#ifdef AC_SOCKET_USE_IOCP
+        AsyncProcessQueue();
+#endif
+    }
+
+    /// Queues data without copying it, owner must keep data valid and unchanged until it is released
+    void QueueSharedBuffer(std::shared_ptr<void const> owner, uint8 const* data, std::size_t size)
+    {
+        _writeQueueSize += size;
+        _writeQueue.emplace_back(std::move(owner), data, size);
 
 #ifdef AC_SOCKET_USE_IOCP
         AsyncProcessQueue();
 #endif
     }
 
+    /// Bytes queued but not yet written to the socket. Thread safe.
+    [[nodiscard]] std::size_t GetWriteQueueSize() const { return _writeQueueSize.load(std::memory_order_relaxed); }
+
     [[nodiscard]] ProxyHeaderReadingState GetProxyHeaderReadingState() const { return _proxyHeaderReadingState; }
 
     [[nodiscard]] bool IsOpen() const { return !_closed && !_closing; }
@@ -165,10 +281,17 @@ public:
                 shutdownError.value(), shutdownError.message());
 
         OnClose();
+
+        // the network thread removes closed sockets in their next update
+        RequestUpdate();
     }
 
     /// Marks the socket for closing after write buffer becomes empty
-    void DelayedCloseSocket() { _closing = true; }
+    void DelayedCloseSocket()
+    {
+        _closing = true;
+        RequestUpdate();
+    }
 
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
@@ -184,8 +307,8 @@ protected:
         _isWritingAsync = true;
 
 #ifdef AC_SOCKET_USE_IOCP
-        MessageBuffer& buffer = _writeQueue.front();
-        _socket.async_write_some(boost::asio::buffer(buffer.GetReadPointer(), buffer.GetActiveSize()), std::bind(&Socket<T>::WriteHandler,
+        PrepareGatherBuffers();
+        _socket.async_write_some(_gatherBuffers, std::bind(&Socket<T>::WriteHandler,
             this->shared_from_this(), std::placeholders::_1, std::placeholders::_2));
 #else
         _socket.async_write_some(boost::asio::null_buffers(), std::bind(&Socket<T>::WriteHandlerWrapper,
@@ -215,6 +338,10 @@ private:
 
         _readBuffer.WriteCompleted(transferredBytes);
         ReadHandler();
+
+        // packets answered or database queries started by the handler
+        if (HasPendingUpdate())
+            RequestUpdate();
     }
 
     // ProxyReadHeaderHandler reads Proxy Protocol v2 header (v1 is not supported).
@@ -329,16 +456,48 @@ private:
         _proxyHeaderReadingState = PROXY_HEADER_READING_STATE_FINISHED;
     }
 
+    /// Collects the front of the write queue into one buffer sequence so it is written with a single writev/WSASend
+    std::size_t PrepareGatherBuffers()
+    {
+        _gatherBuffers.clear();
+
+        std::size_t totalSize = 0;
+        for (SocketWriteBuffer& buffer : _writeQueue)
+        {
+            if (_gatherBuffers.size() >= MAX_GATHER_WRITE_BUFFERS)
+                break;
+
+            _gatherBuffers.emplace_back(buffer.GetReadPointer(), buffer.GetActiveSize());
+            totalSize += buffer.GetActiveSize();
+        }
+
+        return totalSize;
+    }
+
+    void WriteCompleted(std::size_t bytes)
+    {
+        while (!_writeQueue.empty())
+        {
+            SocketWriteBuffer& front = _writeQueue.front();
+            std::size_t consumed = std::min(bytes, front.GetActiveSize());
+            front.ReadCompleted(consumed);
+            bytes -= consumed;
+            _writeQueueSize -= consumed;
+
+            if (front.GetActiveSize())
+                break;
+
+            _writeQueue.pop_front();
+        }
+    }
+
 #ifdef AC_SOCKET_USE_IOCP
     void WriteHandler(boost::system::error_code error, std::size_t transferedBytes)
     {
         if (!error)
         {
             _isWritingAsync = false;
-            _writeQueue.front().ReadCompleted(transferedBytes);
-
-            if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+            WriteCompleted(transferedBytes);
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -354,7 +513,15 @@ private:
     void WriteHandlerWrapper(boost::system::error_code /*error*/, std::size_t /*transferedBytes*/)
     {
         _isWritingAsync = false;
-        HandleQueue();
+
+        for (; HandleQueue();)
+            ;
+    }
+
+    void DropWriteQueueFront()
+    {
+        _writeQueueSize -= _writeQueue.front().GetActiveSize();
+        _writeQueue.pop_front();
     }
 
     bool HandleQueue()
@@ -362,12 +529,10 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        std::size_t bytesToSend = PrepareGatherBuffers();
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_gatherBuffers, error);
 
         if (error)
         {
@@ -376,7 +541,7 @@ private:
                 return AsyncProcessQueue();
             }
 
-            _writeQueue.pop();
+            DropWriteQueueFront();
 
             if (_closing && _writeQueue.empty())
             {
@@ -387,7 +552,7 @@ private:
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            DropWriteQueueFront();
 
             if (_closing && _writeQueue.empty())
             {
@@ -398,11 +563,11 @@ private:
         }
         else if (bytesSent < bytesToSend) // now n > 0
         {
-            queuedMessage.ReadCompleted(bytesSent);
+            WriteCompleted(bytesSent);
             return AsyncProcessQueue();
         }
 
-        _writeQueue.pop();
+        WriteCompleted(bytesSent);
 
         if (_closing && _writeQueue.empty())
         {
@@ -419,11 +584,17 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<SocketWriteBuffer> _writeQueue;
+    std::atomic<std::size_t> _writeQueueSize;
+    std::vector<boost::asio::const_buffer> _gatherBuffers;
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
 
+    std::shared_ptr<SocketUpdateQueue<T>> _updateQueue;
+    std::atomic<bool> _updateRequested;
+    bool _removed;
+
     bool _isWritingAsync;
 
     ProxyHeaderReadingState _proxyHeaderReadingState;
@@ -23,6 +23,7 @@
 #include "NetworkThread.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <memory>
+#include <vector>
 
 using boost::asio::ip::tcp;
 
@@ -32,46 +33,59 @@ class SocketMgr
 public:
     virtual ~SocketMgr()
     {
-        ASSERT(!_threads && !_acceptor && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
+        ASSERT(!_threads && !_acceptor && _threadAcceptors.empty() && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
     }
 
     virtual bool StartNetwork(Acore::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount)
     {
         ASSERT(threadCount > 0);
 
-        std::unique_ptr<AsyncAcceptor> acceptor;
-        try
+        _threadCount = threadCount;
+        _threads = std::unique_ptr<NetworkThread<SocketType>[]>(CreateThreads());
+
+        ASSERT(_threads);
+
+        if (_acceptorPerThread)
         {
-            acceptor = std::make_unique<AsyncAcceptor>(ioContext, bindIp, port);
+            // every network thread accepts on its own SO_REUSEPORT listener, no hand-off between threads
+            for (int32 i = 0; i < _threadCount; ++i)
+            {
+                std::unique_ptr<AsyncAcceptor> acceptor = CreateAcceptor(_threads[i].GetIoContext(), bindIp, port, true);
+                if (!acceptor)
+                    break;
+
+                acceptor->SetSocketFactory([this, i]() { return std::make_pair(_threads[i].GetSocketForAccept(), uint32(i)); });
+                _threadAcceptors.push_back(std::move(acceptor));
+            }
         }
-        catch (boost::system::system_error const& err)
+        else if (std::unique_ptr<AsyncAcceptor> acceptor = CreateAcceptor(ioContext, bindIp, port, false))
         {
-            LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
-            return false;
+            acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
+            _acceptor = std::move(acceptor);
         }
 
-        if (!acceptor->Bind())
+        if (!_acceptor && int32(_threadAcceptors.size()) != _threadCount)
         {
             LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
+            _threadAcceptors.clear();
+            _threads.reset();
+            _threadCount = 0;
             return false;
         }
 
-        _acceptor = std::move(acceptor);
-        _threadCount = threadCount;
-        _threads = std::unique_ptr<NetworkThread<SocketType>[]>(CreateThreads());
-
-        ASSERT(_threads);
-
         for (int32 i = 0; i < _threadCount; ++i)
             _threads[i].Start();
 
-        _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
         return true;
     }
 
     virtual void StopNetwork()
     {
-        _acceptor->Close();
+        if (_acceptor)
+            _acceptor->Close();
+
+        for (std::unique_ptr<AsyncAcceptor>& acceptor : _threadAcceptors)
+            acceptor->Close();
 
         for (int32 i = 0; i < _threadCount; ++i)
             _threads[i].Stop();
@@ -79,6 +93,7 @@ public:
         Wait();
 
         _acceptor.reset();
+        _threadAcceptors.clear();
         _threads.reset();
         _threadCount = 0;
     }
@@ -104,6 +119,8 @@ public:
 
     [[nodiscard]] int32 GetNetworkThreadCount() const { return _threadCount; }
 
+    [[nodiscard]] int32 GetConnectionCount(uint32 threadIndex) const { return _threads[threadIndex].GetConnectionCount(); }
+
     [[nodiscard]] uint32 SelectThreadWithMinConnections() const
     {
         uint32 min = 0;
@@ -126,9 +143,42 @@ protected:
 
     virtual NetworkThread<SocketType>* CreateThreads() const = 0;
 
+    /// Starts accepting on the shared acceptor or, with _acceptorPerThread, on the listener of every network thread
+    template<AsyncAcceptor::AcceptCallback acceptCallback>
+    void AsyncAcceptWithCallback()
+    {
+        if (_acceptor)
+            _acceptor->AsyncAcceptWithCallback<acceptCallback>();
+
+        for (std::unique_ptr<AsyncAcceptor>& acceptor : _threadAcceptors)
+            acceptor->AsyncAcceptWithCallback<acceptCallback>();
+    }
+
     std::unique_ptr<AsyncAcceptor> _acceptor;
+    std::vector<std::unique_ptr<AsyncAcceptor>> _threadAcceptors;
+    bool _acceptorPerThread{};
     std::unique_ptr<NetworkThread<SocketType>[]> _threads;
     int32 _threadCount{};
+
+private:
+    static std::unique_ptr<AsyncAcceptor> CreateAcceptor(Acore::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, bool reusePort)
+    {
+        std::unique_ptr<AsyncAcceptor> acceptor;
+        try
+        {
+            acceptor = std::make_unique<AsyncAcceptor>(ioContext, bindIp, port);
+        }
+        catch (boost::system::system_error const& err)
+        {
+            LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
+            return nullptr;
+        }
+
+        if (!acceptor->Bind(reusePort))
+            return nullptr;
+
+        return acceptor;
+    }
 };
 
 #endif // SocketMgr_h__
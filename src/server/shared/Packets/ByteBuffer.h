@@ -20,6 +20,7 @@
 
 #include "ByteConverter.h"
 #include "Define.h"
+#include "PacketBufferPool.h"
 #include <array>
 #include <cstring>
 #include <string>
@@ -72,15 +73,9 @@ public:
     constexpr static std::size_t DEFAULT_SIZE = 0x1000;
 
     // constructor
-    ByteBuffer()
-    {
-        _storage.reserve(DEFAULT_SIZE);
-    }
+    ByteBuffer() : _storage(PacketBufferPool::Acquire(DEFAULT_SIZE)) { }
 
-    explicit ByteBuffer(std::size_t reserve) : _rpos(0), _wpos(0)
-    {
-        _storage.reserve(reserve);
-    }
+    explicit ByteBuffer(std::size_t reserve) : _rpos(0), _wpos(0), _storage(PacketBufferPool::Acquire(reserve)) { }
 
     ByteBuffer(ByteBuffer&& buf) noexcept :
         _rpos(buf._rpos), _wpos(buf._wpos), _storage(std::move(buf._storage))
@@ -89,9 +84,18 @@ public:
         buf._wpos = 0;
     }
 
-    ByteBuffer(ByteBuffer const& right) = default;
+    ByteBuffer(ByteBuffer const& right) :
+        _rpos(right._rpos), _wpos(right._wpos), _storage(PacketBufferPool::Acquire(right._storage.size()))
+    {
+        _storage.assign(right._storage.begin(), right._storage.end());
+    }
+
     explicit ByteBuffer(MessageBuffer&& buffer);
-    virtual ~ByteBuffer() = default;
+
+    virtual ~ByteBuffer()
+    {
+        PacketBufferPool::Release(std::move(_storage));
+    }
 
     ByteBuffer& operator=(ByteBuffer const& right)
     {
@@ -113,6 +117,7 @@ public:
             right._rpos = 0;
             _wpos = right._wpos;
             right._wpos = 0;
+            PacketBufferPool::Release(std::move(_storage));
             _storage = std::move(right._storage);
         }
 
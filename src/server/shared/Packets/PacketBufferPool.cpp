@@ -0,0 +1,150 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PacketBufferPool.h"
+#include <array>
+#include <mutex>
+
+namespace
+{
+    // most packets fit the first two, 4096 is the ByteBuffer default
+    constexpr std::array<std::size_t, 5> SizeClasses = { 64, 256, 1024, 4096, 16384 };
+    constexpr std::size_t LocalCacheLimit = 32;
+    constexpr std::size_t TransferBatch = 16;
+    constexpr std::size_t SharedCacheLimit = 512;
+
+    using BufferList = std::vector<std::vector<uint8>>;
+    using BufferLists = std::array<BufferList, SizeClasses.size()>;
+
+    struct SharedCache
+    {
+        std::mutex Lock;
+        BufferLists Buffers;
+    };
+
+    SharedCache& GetSharedCache()
+    {
+        static SharedCache shared;
+        return shared;
+    }
+
+    // trivially destructible, so still usable while thread locals are torn down
+    bool& LocalCacheDestroyed()
+    {
+        thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    void MoveBuffers(BufferList& from, BufferList& to, std::size_t count, std::size_t limit)
+    {
+        while (count-- && !from.empty())
+        {
+            if (to.size() < limit)
+                to.push_back(std::move(from.back()));
+
+            from.pop_back();
+        }
+    }
+
+    struct LocalCache
+    {
+        BufferLists Buffers;
+
+        LocalCache()
+        {
+            for (BufferList& buffers : Buffers)
+                buffers.reserve(LocalCacheLimit + 1);
+        }
+
+        ~LocalCache()
+        {
+            LocalCacheDestroyed() = true;
+
+            SharedCache& shared = GetSharedCache();
+            std::lock_guard<std::mutex> lock(shared.Lock);
+            for (std::size_t i = 0; i < SizeClasses.size(); ++i)
+                MoveBuffers(Buffers[i], shared.Buffers[i], Buffers[i].size(), SharedCacheLimit);
+        }
+    };
+
+    LocalCache& GetLocalCache()
+    {
+        thread_local LocalCache local;
+        return local;
+    }
+}
+
+std::vector<uint8> PacketBufferPool::Acquire(std::size_t reserve)
+{
+    std::vector<uint8> storage;
+    if (!reserve)
+        return storage;
+
+    std::size_t sizeClass = 0;
+    while (sizeClass < SizeClasses.size() && SizeClasses[sizeClass] < reserve)
+        ++sizeClass;
+
+    if (sizeClass == SizeClasses.size() || LocalCacheDestroyed())
+    {
+        storage.reserve(reserve);
+        return storage;
+    }
+
+    BufferList& buffers = GetLocalCache().Buffers[sizeClass];
+    if (buffers.empty())
+    {
+        SharedCache& shared = GetSharedCache();
+        std::lock_guard<std::mutex> lock(shared.Lock);
+        MoveBuffers(shared.Buffers[sizeClass], buffers, TransferBatch, LocalCacheLimit);
+    }
+
+    if (buffers.empty())
+    {
+        // the full class size, so the buffer comes back into the same class
+        storage.reserve(SizeClasses[sizeClass]);
+        return storage;
+    }
+
+    storage = std::move(buffers.back());
+    buffers.pop_back();
+    return storage;
+}
+
+void PacketBufferPool::Release(std::vector<uint8>&& storage)
+{
+    std::size_t const capacity = storage.capacity();
+
+    // moved from buffers and ones that grew far past the largest class are left to the heap
+    if (capacity < SizeClasses.front() || capacity > SizeClasses.back() * 2 || LocalCacheDestroyed())
+        return;
+
+    std::size_t sizeClass = SizeClasses.size() - 1;
+    while (SizeClasses[sizeClass] > capacity)
+        --sizeClass;
+
+    storage.clear();
+
+    BufferList& buffers = GetLocalCache().Buffers[sizeClass];
+    buffers.push_back(std::move(storage));
+
+    if (buffers.size() > LocalCacheLimit)
+    {
+        SharedCache& shared = GetSharedCache();
+        std::lock_guard<std::mutex> lock(shared.Lock);
+        MoveBuffers(buffers, shared.Buffers[sizeClass], TransferBatch, SharedCacheLimit);
+    }
+}
@@ -0,0 +1,39 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PACKETBUFFERPOOL_H
+#define _PACKETBUFFERPOOL_H
+
+#include "Define.h"
+#include <vector>
+
+/// Recycles the storage of ByteBuffer and WorldPacket. Buffers are kept per
+/// thread in a few size classes, so building a packet on a map thread and
+/// freeing it on the network thread after it was written does not end up in
+/// the heap on either side. Threads that free more buffers than they take
+/// hand batches over to a shared cache that the others refill from.
+class AC_SHARED_API PacketBufferPool
+{
+public:
+    /// empty buffer with at least `reserve` bytes of capacity
+    static std::vector<uint8> Acquire(std::size_t reserve);
+
+    /// takes the storage back for reuse if it fits one of the size classes
+    static void Release(std::vector<uint8>&& storage);
+};
+
+#endif
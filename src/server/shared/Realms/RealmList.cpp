@@ -225,6 +225,8 @@ void RealmList::UpdateRealms(boost::system::error_code const& error)
     for (auto itr = existingRealms.begin(); itr != existingRealms.end(); ++itr)
         LOG_INFO("server.authserver", "Removed realm \"{}\".", itr->second);
 
+    ++_updateCount;
+
     if (_updateInterval)
     {
         _updateTimer->expires_from_now(boost::posix_time::seconds(_updateInterval));
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "Realm.h"
 #include <array>
+#include <atomic>
 #include <map>
 #include <unordered_set>
 #include <vector>
@@ -57,6 +58,9 @@ public:
 
     [[nodiscard]] RealmBuildInfo const* GetBuildInfo(uint32 build) const;
 
+    /// Incremented after each update of the realms, lets users of the realms detect stale copies
+    [[nodiscard]] uint32 GetUpdateCount() const { return _updateCount; }
+
 private:
     RealmList();
     ~RealmList() = default;
@@ -69,6 +73,7 @@ private:
 
     std::vector<RealmBuildInfo> _builds;
     RealmMap _realms;
+    std::atomic<uint32> _updateCount{0};
     uint32 _updateInterval{0};
     std::unique_ptr<Acore::Asio::DeadlineTimer> _updateTimer;
     std::unique_ptr<Acore::Asio::Resolver> _resolver;
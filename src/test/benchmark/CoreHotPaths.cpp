@@ -0,0 +1,296 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Times the core containers and packet building paths every world update goes
+ * through, each on synthetic data so a change to one of them can be measured in
+ * isolation: EventMap and TaskScheduler timers of creature scripts, EventProcessor
+ * events of units, ByteBuffer packing of movement packets and the values update
+ * blocks built from an UpdateMask. Inputs are generated from a fixed seed, so two
+ * runs of the same binary do the same work. Every line prints a checksum that has
+ * to stay the same when only the implementation changes.
+ *
+ * Usage: core_hot_paths [rounds] [objects] [seed]
+ */
+
+#include "ByteBuffer.h"
+#include "EventMap.h"
+#include "EventProcessor.h"
+#include "ObjectGuid.h"
+#include "TaskScheduler.h"
+#include "UpdateData.h"
+#include "UpdateFields.h"
+#include "UpdateMask.h"
+#include "WorldPacket.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 TICK_DIFF = 50; // world update interval the timers are driven with
+
+    // Six timers of a typical creature script, repeated until the end of the run
+    uint64 RunEventMaps(uint32 rounds, uint32 objects)
+    {
+        std::vector<EventMap> maps(objects);
+        for (uint32 i = 0; i < objects; ++i)
+            for (uint32 eventId = 1; eventId <= 6; ++eventId)
+                maps[i].ScheduleEvent(eventId, Milliseconds(1000 * eventId + i % 1000), eventId % 2 + 1);
+
+        uint64 checksum = 0;
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            for (EventMap& events : maps)
+            {
+                events.Update(TICK_DIFF);
+                while (uint32 eventId = events.ExecuteEvent())
+                {
+                    checksum += eventId;
+                    events.Repeat(Milliseconds(1000 * eventId));
+                }
+            }
+        }
+
+        return checksum;
+    }
+
+    uint64 RunTaskSchedulers(uint32 rounds, uint32 objects)
+    {
+        uint64 checksum = 0;
+        std::vector<TaskScheduler> schedulers(objects);
+        for (uint32 i = 0; i < objects; ++i)
+        {
+            for (uint32 task = 1; task <= 6; ++task)
+            {
+                schedulers[i].Schedule(Milliseconds(1000 * task + i % 1000), task % 2 + 1, [&checksum, task](TaskContext context)
+                {
+                    checksum += task;
+                    context.Repeat(Milliseconds(1000 * task));
+                });
+            }
+        }
+
+        for (uint32 round = 0; round < rounds; ++round)
+            for (TaskScheduler& scheduler : schedulers)
+                scheduler.Update(TICK_DIFF);
+
+        return checksum;
+    }
+
+    // Re-adds itself like the periodic events of units (regeneration, combat checks) do
+    class PeriodicEvent : public BasicEvent
+    {
+    public:
+        PeriodicEvent(EventProcessor& events, uint64& checksum, uint32 period) : _events(events), _checksum(checksum), _period(period) { }
+
+        bool Execute(uint64 /*e_time*/, uint32 /*p_time*/) override
+        {
+            _checksum += _period;
+            _events.AddEventAtOffset(this, Milliseconds(_period));
+            return false;
+        }
+
+    private:
+        EventProcessor& _events;
+        uint64& _checksum;
+        uint32 _period;
+    };
+
+    uint64 RunEventProcessors(uint32 rounds, uint32 objects)
+    {
+        uint64 checksum = 0;
+        std::vector<EventProcessor> processors(objects);
+        for (uint32 i = 0; i < objects; ++i)
+            for (uint32 period = 1; period <= 4; ++period)
+                processors[i].AddEventAtOffset(new PeriodicEvent(processors[i], checksum, 500 * period), Milliseconds(i % 500 + period));
+
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            for (uint32 i = 0; i < objects; ++i)
+            {
+                // one shot events, e.g. delayed spell effects
+                if ((round + i) % 8 == 0)
+                    processors[i].AddEventAtOffset([&checksum]() { ++checksum; }, 200ms);
+
+                processors[i].Update(TICK_DIFF);
+            }
+        }
+
+        for (EventProcessor& events : processors)
+            events.KillAllEvents(true);
+
+        return checksum;
+    }
+
+    struct MovementInput
+    {
+        ObjectGuid Guid;
+        uint32 Flags;
+        uint32 Time;
+        float X, Y, Z, O;
+    };
+
+    // Movement heartbeats as relayed to the players around the mover, then read back
+    uint64 RunByteBuffer(uint32 rounds, std::vector<MovementInput> const& movers)
+    {
+        uint64 checksum = 0;
+        ByteBuffer buffer;
+
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            buffer.clear();
+            for (MovementInput const& mover : movers)
+            {
+                buffer << mover.Guid.WriteAsPacked();
+                buffer << uint32(mover.Flags) << uint16(0) << uint32(mover.Time + round * TICK_DIFF);
+                buffer << mover.X << mover.Y << mover.Z << mover.O;
+                buffer << uint32(0);
+            }
+
+            for (size_t i = 0; i < movers.size(); ++i)
+            {
+                uint64 guid = 0;
+                buffer.readPackGUID(guid);
+                checksum += guid + buffer.read<uint32>();
+                buffer.read_skip<uint16>();
+                checksum += buffer.read<uint32>();
+                buffer.read_skip(4 * sizeof(float) + sizeof(uint32));
+            }
+        }
+
+        return checksum;
+    }
+
+    // Values update of a unit, shaped like Object::BuildValuesUpdate: a few fields change
+    // each tick, the visible changed fields are masked and their values appended.
+    template<bool UseFindNextSetBit>
+    uint64 RunValuesUpdate(uint32 rounds, uint32 objects, uint32 seed)
+    {
+        std::mt19937 generator(seed);
+        std::vector<uint32> values(UNIT_END);
+        for (uint32& value : values)
+            value = generator() % 4 ? uint32(generator()) : 0;
+
+        UpdateMask visibleMask;
+        visibleMask.SetCount(UNIT_END);
+        for (uint32 index = 0; index < UNIT_END; ++index)
+            if (generator() % 4)
+                visibleMask.SetBit(index);
+
+        uint64 checksum = 0;
+        UpdateMask changesMask;
+        changesMask.SetCount(UNIT_END);
+        UpdateData data;
+
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            data.Clear();
+
+            for (uint32 object = 0; object < objects; ++object)
+            {
+                changesMask.Clear();
+                for (uint32 i = 0; i < 6; ++i)
+                    changesMask.SetBit(generator() % UNIT_END);
+
+                UpdateMask updateMask;
+                updateMask.SetCount(UNIT_END);
+                for (uint32 block = 0; block < updateMask.GetBlockCount(); ++block)
+                    updateMask.SetBlock(block, visibleMask.GetBlock(block) & changesMask.GetBlock(block));
+
+                ByteBuffer block(500);
+                block << uint8(UPDATETYPE_VALUES);
+                block << ObjectGuid(HighGuid::Unit, 1, object + 1).WriteAsPacked();
+
+                ByteBuffer fieldBuffer;
+                if constexpr (UseFindNextSetBit)
+                {
+                    for (uint32 index = updateMask.FindNextSetBit(0); index < UNIT_END; index = updateMask.FindNextSetBit(index + 1))
+                        fieldBuffer << values[index];
+                }
+                else
+                {
+                    for (uint32 index = 0; index < UNIT_END; ++index)
+                        if (updateMask.GetBit(index))
+                            fieldBuffer << values[index];
+                }
+
+                block << uint8(updateMask.GetBlockCount());
+                updateMask.AppendToPacket(&block);
+                block.append(fieldBuffer);
+                data.AddUpdateBlock(block);
+            }
+
+            WorldPacket packet;
+            data.BuildPacket(packet);
+            checksum += packet.size();
+        }
+
+        return checksum;
+    }
+
+    template<class Func>
+    void Measure(char const* name, Func&& func)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        uint64 const checksum = func();
+        std::chrono::duration<double, std::milli> const time = std::chrono::steady_clock::now() - start;
+
+        std::printf("  %-28s %10.3f ms (checksum %llu)\n", name, time.count(), (unsigned long long)checksum);
+    }
+
+    uint32 ParseArgument(int argc, char* argv[], int index, uint32 defaultValue)
+    {
+        return argc > index ? uint32(std::strtoul(argv[index], nullptr, 10)) : defaultValue;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32 const rounds = std::max<uint32>(ParseArgument(argc, argv, 1, 2000), 1);
+    uint32 const objects = std::max<uint32>(ParseArgument(argc, argv, 2, 500), 1);
+    uint32 const seed = ParseArgument(argc, argv, 3, 0xACACACAC);
+
+    std::mt19937 generator(seed);
+    std::vector<MovementInput> movers(objects);
+    for (uint32 i = 0; i < objects; ++i)
+    {
+        movers[i].Guid = i % 3 ? ObjectGuid(HighGuid::Unit, generator() % 40000 + 1, i + 1) : ObjectGuid(HighGuid::Player, i + 1);
+        movers[i].Flags = generator() % 2 ? 0x1 : 0x0;
+        movers[i].Time = generator();
+        movers[i].X = float(generator() % 20000) / 10.0f;
+        movers[i].Y = float(generator() % 20000) / 10.0f;
+        movers[i].Z = float(generator() % 1000) / 10.0f;
+        movers[i].O = float(generator() % 628) / 100.0f;
+    }
+
+    std::printf("rounds: %u, objects: %u\n", rounds, objects);
+
+    std::printf("timers:\n");
+    Measure("EventMap", [&]() { return RunEventMaps(rounds, objects); });
+    Measure("TaskScheduler", [&]() { return RunTaskSchedulers(rounds, objects); });
+    Measure("EventProcessor", [&]() { return RunEventProcessors(rounds, objects); });
+
+    std::printf("packets:\n");
+    Measure("ByteBuffer movement", [&]() { return RunByteBuffer(rounds, movers); });
+    Measure("values update (GetBit)", [&]() { return RunValuesUpdate<false>(rounds, objects, seed); });
+    Measure("values update (FindNextSetBit)", [&]() { return RunValuesUpdate<true>(rounds, objects, seed); });
+    return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Replays a scripted boss encounter for a fixed number of ticks and reports the
+ * per-tick CPU time and heap allocations. The encounter is driven by a recorded
+ * input trace generated from a fixed seed, and the same seed is given to the core
+ * random generator the randomized timers and crit rolls use, so two runs of the
+ * same binary do the same work and can be compared against each other.
+ *
+ * Usage: encounter_replay [ticks] [players] [seed]
+ */
+
+#include "EventMap.h"
+#include "Random.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::atomic<uint64> allocations(0);
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+    constexpr uint32 TICK_DIFF = 50; // world update interval the encounter is replayed at
+
+    enum ReplayAction : uint8
+    {
+        ACTION_DAMAGE,
+        ACTION_INTERRUPT,
+        ACTION_DISPEL,
+        ACTION_MOVE,
+        ACTION_MAX
+    };
+
+    struct ReplayInput
+    {
+        uint32 Tick;
+        uint32 Player;
+        ReplayAction Action;
+    };
+
+    enum EncounterEvents
+    {
+        EVENT_CLEAVE = 1,
+        EVENT_FEAR,
+        EVENT_SUMMON_ADDS,
+        EVENT_SHADOW_BOLT_VOLLEY,
+        EVENT_BERSERK,
+        EVENT_PHASE_TWO_CHECK
+    };
+
+    enum EncounterPhases
+    {
+        PHASE_ONE = 1,
+        PHASE_TWO
+    };
+
+    enum EncounterGroups
+    {
+        GROUP_CASTS = 1,
+        GROUP_ADDS
+    };
+
+    // Recorded input: the actions every synthetic player performs during the fight
+    std::vector<ReplayInput> RecordInput(uint32 ticks, uint32 players, uint32 seed)
+    {
+        // Raw mt19937 output is specified by the standard, distributions aren't
+        std::mt19937 generator(seed);
+        std::vector<ReplayInput> input;
+
+        for (uint32 tick = 0; tick < ticks; ++tick)
+            for (uint32 player = 0; player < players; ++player)
+                if (generator() % 40 == 0)
+                    input.push_back({ tick, player, ReplayAction(generator() % ACTION_MAX) });
+
+        return input;
+    }
+
+    // Boss script in the shape of a typical instance script: phased EventMap timers
+    // for the spell rotation and a TaskScheduler for the adds and player debuffs.
+    class EncounterReplay
+    {
+    public:
+        explicit EncounterReplay(uint32 players) : _health(uint64(players) * 100000), _maxHealth(_health), _adds(0), _debuffs(players, 0), _casts(0)
+        {
+            _events.SetPhase(PHASE_ONE);
+            _events.ScheduleEvent(EVENT_CLEAVE, 6s, GROUP_CASTS, PHASE_ONE);
+            _events.ScheduleEvent(EVENT_FEAR, 20s, GROUP_CASTS, PHASE_ONE);
+            _events.ScheduleEvent(EVENT_SUMMON_ADDS, 30s, GROUP_ADDS);
+            _events.ScheduleEvent(EVENT_PHASE_TWO_CHECK, 1s);
+            _events.ScheduleEvent(EVENT_BERSERK, 10min);
+        }
+
+        void Apply(ReplayInput const& input)
+        {
+            switch (input.Action)
+            {
+                case ACTION_DAMAGE:
+                    _health -= std::min<uint64>(_health, roll_chance_f(25.0f) ? 5000 : 2500);
+                    break;
+                case ACTION_INTERRUPT:
+                    _events.DelayEvents(1500, GROUP_CASTS);
+                    break;
+                case ACTION_DISPEL:
+                    if (_debuffs[input.Player])
+                    {
+                        --_debuffs[input.Player];
+                        _scheduler.CancelGroup(input.Player + 1);
+                    }
+                    break;
+                case ACTION_MOVE:
+                    _events.RescheduleEvent(EVENT_CLEAVE, 3s, GROUP_CASTS, _events.IsInPhase(PHASE_TWO) ? PHASE_TWO : PHASE_ONE);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void Update(uint32 diff)
+        {
+            _scheduler.Update(diff);
+            _events.Update(diff);
+
+            while (uint32 eventId = _events.ExecuteEvent())
+            {
+                ++_casts;
+
+                switch (eventId)
+                {
+                    case EVENT_CLEAVE:
+                        _events.Repeat(6s);
+                        break;
+                    case EVENT_FEAR:
+                        ApplyDebuff(_casts % _debuffs.size());
+                        _events.Repeat(18s, 24s);
+                        break;
+                    case EVENT_SUMMON_ADDS:
+                        SummonAdds();
+                        _events.Repeat(45s);
+                        break;
+                    case EVENT_SHADOW_BOLT_VOLLEY:
+                        for (uint32 player = 0; player < _debuffs.size(); player += 5)
+                            ApplyDebuff(player);
+                        _events.Repeat(6s, 10s);
+                        break;
+                    case EVENT_PHASE_TWO_CHECK:
+                        if (_health * 2 <= _maxHealth)
+                        {
+                            _events.SetPhase(PHASE_TWO);
+                            _events.ScheduleEvent(EVENT_CLEAVE, 4s, GROUP_CASTS, PHASE_TWO);
+                            _events.ScheduleEvent(EVENT_SHADOW_BOLT_VOLLEY, 2s, GROUP_CASTS, PHASE_TWO);
+                        }
+                        else
+                            _events.Repeat(1s);
+                        break;
+                    case EVENT_BERSERK:
+                        _events.CancelEventGroup(GROUP_ADDS);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        [[nodiscard]] uint64 GetCasts() const { return _casts; }
+
+    private:
+        void ApplyDebuff(size_t player)
+        {
+            ++_debuffs[player];
+
+            _scheduler.Schedule(1s, uint32(player + 1), [this, player](TaskContext context)
+            {
+                // Ticks until dispelled or expired
+                if (_debuffs[player] && context.GetRepeatCounter() < 10)
+                    context.Repeat();
+                else if (_debuffs[player])
+                    --_debuffs[player];
+            });
+        }
+
+        void SummonAdds()
+        {
+            for (uint32 i = 0; i < 4; ++i)
+            {
+                ++_adds;
+
+                _scheduler.Schedule(2s, [this](TaskContext context)
+                {
+                    // The add casts until the raid kills it
+                    if (context.GetRepeatCounter() < 15)
+                        context.Repeat(1500ms);
+                    else
+                        --_adds;
+                });
+            }
+        }
+
+        EventMap _events;
+        TaskScheduler _scheduler;
+        uint64 _health;
+        uint64 const _maxHealth;
+        uint32 _adds;
+        std::vector<uint32> _debuffs;
+        uint64 _casts;
+    };
+
+    uint32 ParseArgument(int argc, char* argv[], int index, uint32 defaultValue)
+    {
+        return argc > index ? uint32(std::strtoul(argv[index], nullptr, 10)) : defaultValue;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32 const ticks = std::max<uint32>(ParseArgument(argc, argv, 1, 12000), 1);
+    uint32 const players = std::max<uint32>(ParseArgument(argc, argv, 2, 25), 1);
+    uint32 const seed = ParseArgument(argc, argv, 3, 0xACACACAC);
+
+    SetRandomSeed(seed);
+
+    std::vector<ReplayInput> const input = RecordInput(ticks, players, seed);
+    std::vector<std::chrono::nanoseconds> tickTimes;
+    tickTimes.reserve(ticks);
+
+    EncounterReplay encounter(players);
+
+    uint64 const allocationsBefore = allocations;
+    auto nextInput = input.begin();
+
+    for (uint32 tick = 0; tick < ticks; ++tick)
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        for (; nextInput != input.end() && nextInput->Tick == tick; ++nextInput)
+            encounter.Apply(*nextInput);
+
+        encounter.Update(TICK_DIFF);
+
+        tickTimes.push_back(std::chrono::steady_clock::now() - start);
+    }
+
+    uint64 const tickAllocations = allocations - allocationsBefore;
+
+    std::vector<std::chrono::nanoseconds> sorted = tickTimes;
+    std::sort(sorted.begin(), sorted.end());
+
+    std::chrono::nanoseconds total(0);
+    for (std::chrono::nanoseconds time : tickTimes)
+        total += time;
+
+    auto micros = [](std::chrono::nanoseconds time) { return std::chrono::duration<double, std::micro>(time).count(); };
+
+    std::printf("ticks: %u, players: %u, inputs: %zu, casts: %llu\n", ticks, players, input.size(), (unsigned long long)encounter.GetCasts());
+    std::printf("tick time (us): avg %.3f, p50 %.3f, p99 %.3f, max %.3f\n",
+        micros(total) / ticks, micros(sorted[sorted.size() / 2]), micros(sorted[sorted.size() * 99 / 100]), micros(sorted.back()));
+    std::printf("allocations: %llu total, %.3f per tick\n", (unsigned long long)tickAllocations, double(tickAllocations) / ticks);
+    return 0;
+}
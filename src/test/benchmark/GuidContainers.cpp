@@ -0,0 +1,171 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares the guid containers used for the client visibility sets and the auction
+ * item map. Every round replays the access pattern of a visibility pass: the set of
+ * a player is copied, the objects in range are looked up and erased, objects that
+ * came into range are inserted. Guids are generated from a fixed seed, so two runs
+ * of the same binary do the same work.
+ *
+ * Usage: guid_containers [rounds] [guids] [seed]
+ */
+
+#include "FlatHashContainers.h"
+#include "ObjectGuid.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+    // Creatures, game objects and players in the mix a busy city shows a client
+    std::vector<ObjectGuid> GenerateGuids(uint32 count, uint32 seed)
+    {
+        std::mt19937 generator(seed);
+        std::vector<ObjectGuid> guids;
+        guids.reserve(count);
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            switch (generator() % 4)
+            {
+                case 0:
+                    guids.emplace_back(HighGuid::Player, uint32(generator() % 100000 + 1));
+                    break;
+                case 1:
+                    guids.emplace_back(HighGuid::GameObject, uint32(generator() % 200000 + 1), uint32(generator() % 1000000 + 1));
+                    break;
+                default:
+                    guids.emplace_back(HighGuid::Unit, uint32(generator() % 40000 + 1), uint32(generator() % 1000000 + 1));
+                    break;
+            }
+        }
+
+        return guids;
+    }
+
+    template<class Set>
+    uint64 ReplayVisibility(std::vector<ObjectGuid> const& guids, uint32 rounds)
+    {
+        size_t const half = guids.size() / 2;
+        uint64 checksum = 0;
+
+        Set clientGuids;
+        clientGuids.insert(guids.begin(), guids.begin() + half);
+
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            // a quarter of the objects moves out of range and the next quarter comes in
+            size_t const shift = (round * half / 2) % half;
+
+            Set visible = clientGuids;
+            for (size_t i = shift; i < shift + half; ++i)
+            {
+                ObjectGuid const guid = guids[i];
+                if (visible.erase(guid))
+                    ++checksum;
+                else
+                    clientGuids.insert(guid);
+            }
+
+            for (ObjectGuid const& guid : visible)
+            {
+                clientGuids.erase(guid);
+                checksum += guid.GetCounter();
+            }
+        }
+
+        return checksum + clientGuids.size();
+    }
+
+    template<class Map>
+    uint64 ReplayItemMap(std::vector<ObjectGuid> const& guids, uint32 rounds)
+    {
+        uint64 checksum = 0;
+        Map items;
+
+        for (uint32 round = 0; round < rounds; ++round)
+        {
+            for (size_t i = 0; i < guids.size(); ++i)
+                items[guids[i]] = i + 1;
+
+            for (size_t i = 0; i < guids.size(); i += 3)
+            {
+                auto itr = items.find(guids[i]);
+                if (itr != items.end())
+                {
+                    checksum += itr->second;
+                    items.erase(itr);
+                }
+            }
+
+            for (ObjectGuid const& guid : guids)
+                checksum += items.count(guid);
+
+            items.clear();
+        }
+
+        return checksum;
+    }
+
+    template<class Func>
+    void Measure(char const* name, Func&& func)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        uint64 const checksum = func();
+        std::chrono::duration<double, std::milli> const time = std::chrono::steady_clock::now() - start;
+
+        std::printf("  %-28s %10.3f ms (checksum %llu)\n", name, time.count(), (unsigned long long)checksum);
+    }
+
+    uint32 ParseArgument(int argc, char* argv[], int index, uint32 defaultValue)
+    {
+        return argc > index ? uint32(std::strtoul(argv[index], nullptr, 10)) : defaultValue;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32 const rounds = std::max<uint32>(ParseArgument(argc, argv, 1, 2000), 1);
+    uint32 const count = std::max<uint32>(ParseArgument(argc, argv, 2, 1000), 4);
+    uint32 const seed = ParseArgument(argc, argv, 3, 0xACACACAC);
+
+    // duplicates would make the containers disagree on sizes
+    std::vector<ObjectGuid> guids = GenerateGuids(count, seed);
+    std::sort(guids.begin(), guids.end());
+    guids.erase(std::unique(guids.begin(), guids.end()), guids.end());
+    std::shuffle(guids.begin(), guids.end(), std::mt19937(seed));
+
+    std::printf("rounds: %u, guids: %zu\n", rounds, guids.size());
+
+    std::printf("visibility set:\n");
+    Measure("GuidSet", [&]() { return ReplayVisibility<GuidSet>(guids, rounds); });
+    Measure("GuidUnorderedSet", [&]() { return ReplayVisibility<GuidUnorderedSet>(guids, rounds); });
+    Measure("GuidFlatSet", [&]() { return ReplayVisibility<GuidFlatSet>(guids, rounds); });
+
+    std::printf("item map:\n");
+    Measure("std::unordered_map", [&]() { return ReplayItemMap<std::unordered_map<ObjectGuid, uint64>>(guids, rounds); });
+    Measure("Acore::FlatHashMap", [&]() { return ReplayItemMap<Acore::FlatHashMap<ObjectGuid, uint64>>(guids, rounds); });
+    return 0;
+}
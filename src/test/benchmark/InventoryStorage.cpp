@@ -0,0 +1,200 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Replays the storage checks a looting character with full bags does. Every round an
+ * item is looted: the bags are searched for a partial stack of it first and for a free
+ * slot after that, the same two passes Player::CanStoreItem makes. The slot scan that
+ * walks every bag slot is compared with the used slot masks Bag keeps and the per entry
+ * stack index Player keeps. Items are generated from a fixed seed, so two runs of the
+ * same binary do the same work.
+ *
+ * Usage: inventory_storage [rounds] [free slots] [seed]
+ */
+
+#include "FlatHashContainers.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 BAG_COUNT = 5;       // backpack and four equipped bags
+    constexpr uint32 BAG_SIZE = 36;
+    constexpr uint32 MAX_STACK = 20;
+
+    struct Slot
+    {
+        uint32 Entry = 0;
+        uint32 Count = 0;
+    };
+
+    struct Inventory
+    {
+        std::array<std::array<Slot, BAG_SIZE>, BAG_COUNT> Bags;
+        std::array<uint64, BAG_COUNT> UsedSlots{};
+        Acore::FlatHashMap<uint32, uint32> Stacks;
+
+        void Store(uint32 bag, uint32 slot, uint32 entry, uint32 count)
+        {
+            Bags[bag][slot] = { entry, count };
+            UsedSlots[bag] |= uint64(1) << slot;
+            ++Stacks[entry];
+        }
+
+        void Remove(uint32 bag, uint32 slot)
+        {
+            --Stacks[Bags[bag][slot].Entry];
+            Bags[bag][slot] = {};
+            UsedSlots[bag] &= ~(uint64(1) << slot);
+        }
+    };
+
+    // every slot taken by full stacks of distinct items but the requested number of free ones
+    Inventory GenerateInventory(uint32 freeSlots, std::mt19937& generator)
+    {
+        Inventory inventory;
+        uint32 entry = 100000;
+
+        for (uint32 bag = 0; bag < BAG_COUNT; ++bag)
+            for (uint32 slot = 0; slot < BAG_SIZE; ++slot)
+                inventory.Store(bag, slot, ++entry, MAX_STACK);
+
+        for (uint32 i = 0; i < freeSlots && i < BAG_COUNT * BAG_SIZE; ++i)
+        {
+            uint32 bag = generator() % BAG_COUNT;
+            uint32 slot = generator() % BAG_SIZE;
+            if (inventory.Bags[bag][slot].Entry)
+                inventory.Remove(bag, slot);
+        }
+
+        return inventory;
+    }
+
+    // loot is mostly items the character has no stack of
+    std::vector<uint32> GenerateLoot(uint32 count, std::mt19937& generator)
+    {
+        std::vector<uint32> loot;
+        loot.reserve(count);
+
+        for (uint32 i = 0; i < count; ++i)
+            loot.push_back(generator() % 8 ? 200000 + generator() % 5000 : 100001 + generator() % (BAG_COUNT * BAG_SIZE));
+
+        return loot;
+    }
+
+    uint64 ReplayScan(Inventory const& inventory, std::vector<uint32> const& loot)
+    {
+        uint64 checksum = 0;
+
+        for (uint32 entry : loot)
+        {
+            bool stored = false;
+            for (uint32 bag = 0; bag < BAG_COUNT && !stored; ++bag)
+                for (uint32 slot = 0; slot < BAG_SIZE && !stored; ++slot)
+                    if (inventory.Bags[bag][slot].Entry == entry && inventory.Bags[bag][slot].Count < MAX_STACK)
+                    {
+                        checksum += bag * BAG_SIZE + slot + 1;
+                        stored = true;
+                    }
+
+            for (uint32 bag = 0; bag < BAG_COUNT && !stored; ++bag)
+                for (uint32 slot = 0; slot < BAG_SIZE && !stored; ++slot)
+                    if (!inventory.Bags[bag][slot].Entry)
+                    {
+                        checksum += bag * BAG_SIZE + slot + 1;
+                        stored = true;
+                    }
+        }
+
+        return checksum;
+    }
+
+    uint64 ReplayMasks(Inventory const& inventory, std::vector<uint32> const& loot)
+    {
+        uint64 const fullBag = (uint64(1) << BAG_SIZE) - 1;
+        uint64 checksum = 0;
+
+        for (uint32 entry : loot)
+        {
+            bool stored = false;
+
+            auto itr = inventory.Stacks.find(entry);
+            if (itr != inventory.Stacks.end() && itr->second)
+                for (uint32 bag = 0; bag < BAG_COUNT && !stored; ++bag)
+                    for (uint64 slots = inventory.UsedSlots[bag]; slots && !stored; slots &= slots - 1)
+                    {
+                        uint32 slot = std::countr_zero(slots);
+                        if (inventory.Bags[bag][slot].Entry == entry && inventory.Bags[bag][slot].Count < MAX_STACK)
+                        {
+                            checksum += bag * BAG_SIZE + slot + 1;
+                            stored = true;
+                        }
+                    }
+
+            for (uint32 bag = 0; bag < BAG_COUNT && !stored; ++bag)
+                if (uint64 freeSlots = ~inventory.UsedSlots[bag] & fullBag)
+                {
+                    checksum += bag * BAG_SIZE + std::countr_zero(freeSlots) + 1;
+                    stored = true;
+                }
+        }
+
+        return checksum;
+    }
+
+    template<class Func>
+    void Measure(char const* name, Func&& func)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        uint64 const checksum = func();
+        std::chrono::duration<double, std::milli> const time = std::chrono::steady_clock::now() - start;
+
+        std::printf("  %-28s %10.3f ms (checksum %llu)\n", name, time.count(), (unsigned long long)checksum);
+    }
+
+    uint32 ParseArgument(int argc, char* argv[], int index, uint32 defaultValue)
+    {
+        return argc > index ? uint32(std::strtoul(argv[index], nullptr, 10)) : defaultValue;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32 const rounds = std::max<uint32>(ParseArgument(argc, argv, 1, 1000000), 1);
+    uint32 const freeSlots = ParseArgument(argc, argv, 2, 1);
+    uint32 const seed = ParseArgument(argc, argv, 3, 0xACACACAC);
+
+    std::mt19937 generator(seed);
+    Inventory const inventory = GenerateInventory(freeSlots, generator);
+    std::vector<uint32> const loot = GenerateLoot(rounds, generator);
+
+    std::printf("rounds: %u, bags: %u x %u slots, free slots: %u\n", rounds, BAG_COUNT, BAG_SIZE,
+        uint32(BAG_COUNT * BAG_SIZE) - uint32(std::accumulate(inventory.UsedSlots.begin(), inventory.UsedSlots.end(), 0u,
+            [](uint32 used, uint64 mask) { return used + std::popcount(mask); })));
+
+    std::printf("store checks:\n");
+    Measure("slot scan", [&]() { return ReplayScan(inventory, loot); });
+    Measure("slot masks + stack index", [&]() { return ReplayMasks(inventory, loot); });
+    return 0;
+}
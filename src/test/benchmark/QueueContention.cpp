@@ -0,0 +1,117 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compares ProducerConsumerQueue with LockFreeProducerConsumerQueue under contention.
+ * Producers push their share of the items, consumers block in WaitAndPop until they
+ * get the end marker. The checksum is the sum of all consumed items, equal for both
+ * queues when nothing was lost.
+ *
+ * Usage: queue_contention [producers] [consumers] [items]
+ */
+
+#include "LockFreePCQueue.h"
+#include "PCQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // 0 tells a consumer to stop, items start at 1
+    constexpr uint64 END_MARKER = 0;
+
+    template<class Queue>
+    uint64 Run(Queue& queue, uint32 producers, uint32 consumers, uint32 items)
+    {
+        std::atomic<uint64> checksum = 0;
+        std::vector<std::thread> threads;
+
+        for (uint32 i = 0; i < consumers; ++i)
+        {
+            threads.emplace_back([&queue, &checksum]()
+            {
+                uint64 sum = 0;
+                while (true)
+                {
+                    uint64 item = END_MARKER;
+                    queue.WaitAndPop(item);
+                    if (item == END_MARKER)
+                        break;
+
+                    sum += item;
+                }
+
+                checksum += sum;
+            });
+        }
+
+        std::vector<std::thread> producerThreads;
+        for (uint32 i = 0; i < producers; ++i)
+        {
+            producerThreads.emplace_back([&queue, i, producers, items]()
+            {
+                for (uint64 item = i + 1; item <= items; item += producers)
+                    queue.Push(item);
+            });
+        }
+
+        for (std::thread& thread : producerThreads)
+            thread.join();
+
+        for (uint32 i = 0; i < consumers; ++i)
+            queue.Push(END_MARKER);
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        return checksum;
+    }
+
+    template<class Queue>
+    void Measure(char const* name, uint32 producers, uint32 consumers, uint32 items)
+    {
+        Queue queue;
+
+        auto const start = std::chrono::steady_clock::now();
+        uint64 const checksum = Run(queue, producers, consumers, items);
+        std::chrono::duration<double, std::milli> const time = std::chrono::steady_clock::now() - start;
+
+        std::printf("  %-32s %10.3f ms %8.1f Mops/s (checksum %llu)\n", name, time.count(), items / time.count() / 1000.0, (unsigned long long)checksum);
+    }
+
+    uint32 ParseArgument(int argc, char* argv[], int index, uint32 defaultValue)
+    {
+        return argc > index ? uint32(std::strtoul(argv[index], nullptr, 10)) : defaultValue;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32 const producers = std::max<uint32>(ParseArgument(argc, argv, 1, 4), 1);
+    uint32 const consumers = std::max<uint32>(ParseArgument(argc, argv, 2, 4), 1);
+    uint32 const items = std::max<uint32>(ParseArgument(argc, argv, 3, 2000000), 1);
+
+    std::printf("producers: %u, consumers: %u, items: %u\n", producers, consumers, items);
+    Measure<ProducerConsumerQueue<uint64>>("ProducerConsumerQueue", producers, consumers, items);
+    Measure<LockFreeProducerConsumerQueue<uint64>>("LockFreeProducerConsumerQueue", producers, consumers, items);
+    return 0;
+}
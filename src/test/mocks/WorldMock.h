@@ -60,6 +60,9 @@ public:
     MOCK_METHOD(bool, RemoveQueuedPlayer, (WorldSession* session), ());
     MOCK_METHOD(int32, GetQueuePos, (WorldSession*), ());
     MOCK_METHOD(bool, HasRecentlyDisconnected, (WorldSession*), ());
+    MOCK_METHOD(bool, TryStartPlayerLogin, (), ());
+    MOCK_METHOD(bool, CanFinishPlayerLogin, (), (const));
+    MOCK_METHOD(void, AddPlayerLoginTime, (Microseconds time), ());
     MOCK_METHOD(bool, getAllowMovement, (), (const));
     MOCK_METHOD(void, SetAllowMovement, (bool allow), ());
     MOCK_METHOD(void, SetNewCharString, (std::string const& str), ());
@@ -106,6 +109,8 @@ public:
     MOCK_METHOD(uint32, GetNextWhoListUpdateDelaySecs, ());
     MOCK_METHOD(void, ProcessCliCommands, ());
     MOCK_METHOD(void, QueueCliCommand, (CliCommandHolder* commandHolder), ());
+    MOCK_METHOD(void, QueueCliCommands, (std::vector<CliCommandHolder*> const& commandHolders), ());
+    MOCK_METHOD(bool, QueueBackgroundReload, (std::string const& name, BackgroundReloadBuilder builder), ());
     MOCK_METHOD(void, ForceGameEventUpdate, ());
     MOCK_METHOD(void, UpdateRealmCharCount, (uint32 accid), ());
     MOCK_METHOD(LocaleConstant, GetAvailableDbcLocale, (LocaleConstant locale), (const));
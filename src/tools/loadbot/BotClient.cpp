@@ -0,0 +1,911 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BotClient.h"
+#include "BigNumber.h"
+#include "CryptoHash.h"
+#include "CryptoRandom.h"
+#include "IoContext.h"
+#include "Log.h"
+#include "SRP6.h"
+#include "SharedDefines.h"
+#include "Util.h"
+#include <boost/asio/connect.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <cmath>
+#include <functional>
+
+using SHA1 = Acore::Crypto::SHA1;
+using SRP6 = Acore::Crypto::SRP6;
+
+namespace
+{
+    enum class AuthCommand : uint8
+    {
+        LogonChallenge  = 0x00,
+        LogonProof      = 0x01,
+        RealmList       = 0x10
+    };
+
+    constexpr uint32 CLIENT_BUILD = 12340;
+    constexpr uint32 MOVEMENT_FLAG_FORWARD = 0x00000001;
+    constexpr float MOVEMENT_RUN_SPEED = 7.0f;
+    constexpr Seconds PROBE_TIMEOUT = 30s;
+
+    // the server answers the logon challenge with B, g, N, s, the version challenge and the security flags
+    constexpr std::size_t LOGON_CHALLENGE_SIZE = 32 + 1 + 1 + 1 + 32 + 32 + 16 + 1;
+    // M2, account flags, survey id, login flags
+    constexpr std::size_t LOGON_PROOF_SIZE = 20 + 4 + 4 + 2;
+}
+
+char const* GetBotStateName(BotState state)
+{
+    switch (state)
+    {
+        case BOT_STATE_IDLE:                return "idle";
+        case BOT_STATE_AUTHENTICATING:      return "authenticating";
+        case BOT_STATE_CONNECTING:          return "connecting";
+        case BOT_STATE_QUEUED:              return "queued";
+        case BOT_STATE_SELECTING_CHARACTER: return "selecting_character";
+        case BOT_STATE_LOADING:             return "loading";
+        case BOT_STATE_IN_WORLD:            return "in_world";
+        case BOT_STATE_FAILED:              return "failed";
+        case BOT_STATE_STOPPED:             return "stopped";
+        default:                            return "unknown";
+    }
+}
+
+char const* GetBotProbeName(BotProbe probe)
+{
+    switch (probe)
+    {
+        case BOT_PROBE_QUERY_TIME:      return "query_time";
+        case BOT_PROBE_CHAT:            return "chat";
+        case BOT_PROBE_CAST:            return "cast";
+        case BOT_PROBE_AUCTION_SEARCH:  return "auction_search";
+        case BOT_PROBE_WHO:             return "who";
+        default:                        return "unknown";
+    }
+}
+
+void BotLatency::Add(Microseconds time)
+{
+    uint64 const value = time.count();
+    _total += value;
+    ++_count;
+
+    uint64 max = _max.load(std::memory_order_relaxed);
+    while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        ;
+}
+
+BotLatency::Snapshot BotLatency::Take()
+{
+    uint64 const total = _total.exchange(0);
+    uint64 const count = _count.exchange(0);
+    uint64 const max = _max.exchange(0);
+    return { count, Microseconds(count ? total / count : 0), Microseconds(max) };
+}
+
+BotClient::BotClient(Acore::Asio::IoContext& ioContext, BotConfig const& config, BotStats& stats, uint32 index) :
+    _config(config), _stats(stats), _index(index),
+    _account(config.AccountPrefix + std::to_string(config.FirstAccount + index)), _password(config.AccountPassword),
+    _strand(boost::asio::make_strand(static_cast<boost::asio::io_context&>(ioContext))), _socket(_strand), _updateTimer(_strand),
+    _random(config.FirstAccount + index), _state(BOT_STATE_IDLE), _sessionKey(), _clientPublicKey(), _clientProof(), _header(),
+    _readOpcode(0), _guid(0), _race(0), _createdCharacter(false), _language(LANG_UNIVERSAL), _homeX(0.0f), _homeY(0.0f),
+    _x(0.0f), _y(0.0f), _z(0.0f), _orientation(0.0f), _moveHeartbeats(0), _castCount(0), _probeSent()
+{
+    // SRP6 works on the upper case names, like the client does
+    Utf8ToUpperOnlyLatin(_account);
+    Utf8ToUpperOnlyLatin(_password);
+
+    ++_stats.States[_state];
+}
+
+BotClient::~BotClient()
+{
+    --_stats.States[_state];
+}
+
+void BotClient::Start()
+{
+    boost::asio::post(_strand, [self = shared_from_this()]()
+    {
+        self->_startTime = std::chrono::steady_clock::now();
+        self->SetState(BOT_STATE_AUTHENTICATING);
+
+        tcp::endpoint endpoint;
+        if (!self->Resolve(self->_config.AuthServerHost, std::to_string(self->_config.AuthServerPort), endpoint))
+            return;
+
+        self->_socket.async_connect(endpoint, [self](boost::system::error_code const& error)
+        {
+            if (error)
+            {
+                self->Fail("can't connect to the authserver");
+                return;
+            }
+
+            self->SendLogonChallenge();
+        });
+    });
+}
+
+void BotClient::Stop()
+{
+    boost::asio::post(_strand, [self = shared_from_this()]()
+    {
+        self->SetState(BOT_STATE_STOPPED);
+        self->Close();
+    });
+}
+
+void BotClient::SetState(BotState state)
+{
+    if (_state == state)
+        return;
+
+    --_stats.States[_state];
+    ++_stats.States[state];
+    _state = state;
+}
+
+void BotClient::Fail(char const* reason)
+{
+    if (_state == BOT_STATE_STOPPED || _state == BOT_STATE_FAILED)
+        return;
+
+    LOG_WARN("loadbot", "Bot {} ({}) failed while {}: {}", _index, _account, GetBotStateName(_state), reason);
+
+    SetState(BOT_STATE_FAILED);
+    Close();
+}
+
+void BotClient::Close()
+{
+    _updateTimer.cancel();
+    _writeQueue.clear();
+
+    boost::system::error_code error;
+    _socket.shutdown(tcp::socket::shutdown_both, error);
+    _socket.close(error);
+}
+
+bool BotClient::Resolve(std::string const& host, std::string const& port, tcp::endpoint& endpoint)
+{
+    boost::system::error_code error;
+    tcp::resolver resolver(_strand);
+    tcp::resolver::results_type results = resolver.resolve(tcp::v4(), host, port, error);
+    if (error || results.empty())
+    {
+        Fail("can't resolve the server address");
+        return false;
+    }
+
+    endpoint = results.begin()->endpoint();
+    return true;
+}
+
+void BotClient::SendLogonChallenge()
+{
+    ByteBuffer packet;
+    packet << uint8(AuthCommand::LogonChallenge);
+    packet << uint8(8);
+    packet << uint16(30 + _account.size());             // size of the rest of the packet
+    packet.append("WoW", 4);
+    packet << uint8(3) << uint8(3) << uint8(5);
+    packet << uint16(CLIENT_BUILD);
+    packet.append("68x", 4);                            // platform, os and locale are sent reversed
+    packet.append("niW", 4);
+    packet.append("SUne", 4);
+    packet << uint32(0);                                // timezone bias
+    packet << uint32(0);                                // ip
+    packet << uint8(_account.size());
+    packet.append(_account.data(), _account.size());
+
+    WriteAuth(packet);
+    ReadAuth(3, &BotClient::HandleLogonChallengeResult);
+}
+
+void BotClient::HandleLogonChallengeResult()
+{
+    if (_readBuffer[2] != 0)                            // WOW_SUCCESS
+    {
+        Fail("logon challenge rejected, unknown account or client build");
+        return;
+    }
+
+    ReadAuth(LOGON_CHALLENGE_SIZE, &BotClient::HandleLogonChallenge);
+}
+
+void BotClient::HandleLogonChallenge()
+{
+    ByteBuffer data;
+    data.append(_readBuffer.data(), _readBuffer.size());
+
+    SRP6::EphemeralKey serverPublicKey;
+    std::array<uint8, 1> generator;
+    std::array<uint8, 32> modulus;
+    SRP6::Salt salt;
+    data.read(serverPublicKey);
+    data.read_skip<uint8>();
+    data.read(generator);
+    data.read_skip<uint8>();
+    data.read(modulus);
+    data.read(salt);
+    data.read_skip(16);                                 // version challenge
+
+    if (data.read<uint8>())
+    {
+        Fail("account requires a PIN, matrix card or token");
+        return;
+    }
+
+    // the client half of SRP6:
+    // A = g^a, u = H(A | B), x = H(s | H(I | ":" | P)), S = (B - 3 * g^x)^(a + u * x), K = interleaved H(S)
+    BigNumber const g(generator);
+    BigNumber const N(modulus);
+    BigNumber const B(serverPublicKey);
+
+    BigNumber a;
+    a.SetRand(19 * 8);
+
+    _clientPublicKey = g.ModExp(a, N).ToByteArray<32>();
+    BigNumber const u(SHA1::GetDigestOf(_clientPublicKey, serverPublicKey));
+    BigNumber const x(SHA1::GetDigestOf(salt, SHA1::GetDigestOf(_account, ":", _password)));
+
+    SRP6::EphemeralKey const S = ((B + N * 3 - g.ModExp(x, N) * 3) % N).ModExp(a + u * x, N).ToByteArray<32>();
+    _sessionKey = SRP6::SHA1Interleave(S);
+
+    // M = H(H(N) xor H(g) | H(I) | s | A | B | K)
+    SHA1::Digest const NHash = SHA1::GetDigestOf(modulus);
+    SHA1::Digest const gHash = SHA1::GetDigestOf(generator);
+    SHA1::Digest NgHash;
+    std::transform(NHash.begin(), NHash.end(), gHash.begin(), NgHash.begin(), std::bit_xor<>());
+
+    _clientProof = SHA1::GetDigestOf(NgHash, SHA1::GetDigestOf(_account), salt, _clientPublicKey, serverPublicKey, _sessionKey);
+
+    ByteBuffer packet;
+    packet << uint8(AuthCommand::LogonProof);
+    packet.append(_clientPublicKey);
+    packet.append(_clientProof);
+    packet.append(SHA1::Digest{});                      // version proof, only checked with StrictVersionCheck
+    packet << uint8(0);                                 // number of keys
+    packet << uint8(0);                                 // security flags
+
+    WriteAuth(packet);
+    ReadAuth(2, &BotClient::HandleLogonProofResult);
+}
+
+void BotClient::HandleLogonProofResult()
+{
+    if (_readBuffer[1] != 0)
+    {
+        Fail("logon proof rejected, wrong password");
+        return;
+    }
+
+    ReadAuth(LOGON_PROOF_SIZE, &BotClient::HandleLogonProof);
+}
+
+void BotClient::HandleLogonProof()
+{
+    SHA1::Digest serverProof;
+    std::copy_n(_readBuffer.begin(), serverProof.size(), serverProof.begin());
+    if (serverProof != SRP6::GetSessionVerifier(_clientPublicKey, _clientProof, _sessionKey))
+    {
+        Fail("server proof doesn't match");
+        return;
+    }
+
+    ByteBuffer packet;
+    packet << uint8(AuthCommand::RealmList);
+    packet << uint32(0);
+
+    WriteAuth(packet);
+    ReadAuth(3, &BotClient::HandleRealmListHeader);
+}
+
+void BotClient::HandleRealmListHeader()
+{
+    std::size_t const size = _readBuffer[1] | (_readBuffer[2] << 8);
+    ReadAuth(size, &BotClient::HandleRealmList);
+}
+
+void BotClient::HandleRealmList()
+{
+    ByteBuffer data;
+    data.append(_readBuffer.data(), _readBuffer.size());
+
+    std::string address = _config.WorldServerAddress;
+
+    data.read_skip<uint32>();
+    uint16 realmCount = data.read<uint16>();
+    for (uint16 i = 0; i < realmCount && address.empty(); ++i)
+    {
+        data.read_skip<uint8>();                        // type
+        data.read_skip<uint8>();                        // locked
+        uint8 flags = data.read<uint8>();
+        data.ReadCString(false);                        // name
+        std::string realmAddress = data.ReadCString(false);
+        data.read_skip<float>();                        // population
+        data.read_skip<uint8>();                        // characters
+        data.read_skip<uint8>();                        // timezone
+        uint8 realmId = data.read<uint8>();
+
+        if (flags & 0x04)                               // REALM_FLAG_SPECIFYBUILD
+            data.read_skip(5);
+
+        if (realmId == _config.RealmId)
+            address = std::move(realmAddress);
+    }
+
+    std::size_t const separator = address.rfind(':');
+    if (separator == std::string::npos)
+    {
+        Fail("realm not found in the realm list");
+        return;
+    }
+
+    // the authserver connection isn't needed anymore, the session key is stored in the account
+    Close();
+
+    tcp::endpoint endpoint;
+    if (Resolve(address.substr(0, separator), address.substr(separator + 1), endpoint))
+        ConnectWorld(endpoint);
+}
+
+void BotClient::ReadAuth(std::size_t size, Handler handler)
+{
+    _readBuffer.resize(size);
+    boost::asio::async_read(_socket, boost::asio::buffer(_readBuffer), [self = shared_from_this(), handler](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        if (error)
+        {
+            self->Fail("authserver closed the connection");
+            return;
+        }
+
+        try
+        {
+            ((*self).*handler)();
+        }
+        catch (ByteBufferException const&)
+        {
+            self->Fail("malformed authserver packet");
+        }
+    });
+}
+
+void BotClient::WriteAuth(ByteBuffer const& packet)
+{
+    Write(std::vector<uint8>(packet.contents(), packet.contents() + packet.size()));
+}
+
+void BotClient::ConnectWorld(tcp::endpoint const& endpoint)
+{
+    SetState(BOT_STATE_CONNECTING);
+
+    _socket.async_connect(endpoint, [self = shared_from_this()](boost::system::error_code const& error)
+    {
+        if (error)
+        {
+            self->Fail("can't connect to the worldserver");
+            return;
+        }
+
+        self->ReadWorldHeader();
+    });
+}
+
+void BotClient::ReadWorldHeader()
+{
+    boost::asio::async_read(_socket, boost::asio::buffer(_header.data(), 4), [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        if (error)
+        {
+            if (self->_state != BOT_STATE_STOPPED && self->_state != BOT_STATE_FAILED)
+                ++self->_stats.Disconnects;
+
+            self->Fail("worldserver closed the connection");
+            return;
+        }
+
+        if (self->_authCrypt.IsInitialized())
+            self->_authCrypt.DecryptRecv(self->_header.data(), 4);
+
+        // packets bigger than 0x7FFF bytes have a three byte size
+        if (self->_header[0] & 0x80)
+        {
+            self->ReadWorldLargeHeader();
+            return;
+        }
+
+        self->_readOpcode = self->_header[2] | (self->_header[3] << 8);
+        self->ReadWorldBody(((self->_header[0] << 8) | self->_header[1]) - 2);
+    });
+}
+
+void BotClient::ReadWorldLargeHeader()
+{
+    boost::asio::async_read(_socket, boost::asio::buffer(_header.data() + 4, 1), [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        if (error)
+        {
+            self->Fail("worldserver closed the connection");
+            return;
+        }
+
+        if (self->_authCrypt.IsInitialized())
+            self->_authCrypt.DecryptRecv(self->_header.data() + 4, 1);
+
+        self->_readOpcode = self->_header[3] | (self->_header[4] << 8);
+        self->ReadWorldBody((((self->_header[0] & 0x7F) << 16) | (self->_header[1] << 8) | self->_header[2]) - 2);
+    });
+}
+
+void BotClient::ReadWorldBody(std::size_t size)
+{
+    _readBuffer.resize(size);
+    boost::asio::async_read(_socket, boost::asio::buffer(_readBuffer), [self = shared_from_this()](boost::system::error_code const& error, std::size_t transferred)
+    {
+        if (error)
+        {
+            self->Fail("worldserver closed the connection");
+            return;
+        }
+
+        ++self->_stats.PacketsReceived;
+
+        WorldPacket packet(self->_readOpcode, transferred);
+        if (transferred)
+            packet.append(self->_readBuffer.data(), transferred);
+
+        try
+        {
+            self->HandleWorldPacket(packet);
+        }
+        catch (ByteBufferException const&)
+        {
+            LOG_DEBUG("loadbot", "Bot {} received malformed packet {}", self->_index, self->_readOpcode);
+        }
+
+        if (self->_state != BOT_STATE_STOPPED && self->_state != BOT_STATE_FAILED)
+            self->ReadWorldHeader();
+    });
+}
+
+void BotClient::HandleWorldPacket(WorldPacket& packet)
+{
+    switch (packet.GetOpcode())
+    {
+        case SMSG_AUTH_CHALLENGE:
+            HandleAuthChallenge(packet);
+            break;
+        case SMSG_AUTH_RESPONSE:
+            HandleAuthResponse(packet);
+            break;
+        case SMSG_CHAR_ENUM:
+            HandleCharEnum(packet);
+            break;
+        case SMSG_CHAR_CREATE:
+            HandleCharCreate(packet);
+            break;
+        case SMSG_CHARACTER_LOGIN_FAILED:
+            Fail("character login failed");
+            break;
+        case SMSG_LOGIN_VERIFY_WORLD:
+            HandleLoginVerifyWorld(packet);
+            break;
+        case SMSG_TIME_SYNC_REQ:
+            HandleTimeSyncRequest(packet);
+            break;
+        case SMSG_QUERY_TIME_RESPONSE:
+            HandleProbeResponse(BOT_PROBE_QUERY_TIME);
+            break;
+        case SMSG_MESSAGECHAT:
+        {
+            // says of the bots around are received too
+            packet.read_skip<uint8>();
+            packet.read_skip<uint32>();
+            if (packet.read<uint64>() == _guid)
+                HandleProbeResponse(BOT_PROBE_CHAT);
+            break;
+        }
+        case SMSG_SPELL_START:
+        {
+            uint64 casterItem, caster;
+            packet.readPackGUID(casterItem);
+            packet.readPackGUID(caster);
+            if (caster == _guid)
+                HandleProbeResponse(BOT_PROBE_CAST);
+            break;
+        }
+        case SMSG_CAST_FAILED:
+            HandleProbeResponse(BOT_PROBE_CAST);
+            break;
+        case SMSG_AUCTION_LIST_RESULT:
+            HandleProbeResponse(BOT_PROBE_AUCTION_SEARCH);
+            break;
+        case SMSG_WHO:
+            HandleProbeResponse(BOT_PROBE_WHO);
+            break;
+        default:
+            break;
+    }
+}
+
+void BotClient::SendWorldPacket(WorldPacket const& packet)
+{
+    // client header: size (big endian, including the opcode) and a four byte opcode
+    std::vector<uint8> data(6 + packet.size());
+    uint16 const size = uint16(packet.size() + 4);
+    uint32 const opcode = packet.GetOpcode();
+    data[0] = uint8(size >> 8);
+    data[1] = uint8(size);
+    data[2] = uint8(opcode);
+    data[3] = uint8(opcode >> 8);
+    data[4] = uint8(opcode >> 16);
+    data[5] = uint8(opcode >> 24);
+
+    if (_authCrypt.IsInitialized())
+        _authCrypt.EncryptSend(data.data(), 6);
+
+    if (!packet.empty())
+        std::copy_n(packet.contents(), packet.size(), data.begin() + 6);
+
+    ++_stats.PacketsSent;
+    Write(std::move(data));
+}
+
+void BotClient::Write(std::vector<uint8>&& data)
+{
+    _writeQueue.push_back(std::move(data));
+    if (_writeQueue.size() == 1)
+        WriteNext();
+}
+
+void BotClient::WriteNext()
+{
+    boost::asio::async_write(_socket, boost::asio::buffer(_writeQueue.front()), [self = shared_from_this()](boost::system::error_code const& error, std::size_t /*transferred*/)
+    {
+        // a closed connection is noticed by the read side
+        if (error || self->_writeQueue.empty())
+            return;
+
+        self->_writeQueue.pop_front();
+        if (!self->_writeQueue.empty())
+            self->WriteNext();
+    });
+}
+
+void BotClient::HandleAuthChallenge(WorldPacket& packet)
+{
+    std::array<uint8, 4> authSeed;
+    packet.read_skip<uint32>();
+    packet.read(authSeed);
+
+    std::array<uint8, 4> const localChallenge = Acore::Crypto::GetRandomBytes<4>();
+
+    WorldPacket response(CMSG_AUTH_SESSION, 64);
+    response << uint32(CLIENT_BUILD);
+    response << uint32(0);                              // login server id
+    response << _account;
+    response << uint32(0);                              // login server type
+    response.append(localChallenge);
+    response << uint32(0);                              // region id
+    response << uint32(0);                              // battlegroup id
+    response << uint32(_config.RealmId);
+    response << uint64(0);                              // dos response
+    response.append(SHA1::GetDigestOf(_account, std::array<uint8, 4>{}, localChallenge, authSeed, _sessionKey));
+    response << uint32(0);                              // no addons
+    SendWorldPacket(response);
+
+    // everything after the auth session is encrypted
+    _authCrypt.InitClient(_sessionKey);
+}
+
+void BotClient::HandleAuthResponse(WorldPacket& packet)
+{
+    switch (packet.read<uint8>())
+    {
+        case AUTH_OK:
+            SetState(BOT_STATE_SELECTING_CHARACTER);
+            SendWorldPacket(WorldPacket(CMSG_CHAR_ENUM, 0));
+            break;
+        case AUTH_WAIT_QUEUE:
+            SetState(BOT_STATE_QUEUED);
+            break;
+        default:
+            Fail("worldserver rejected the session, is Warden disabled?");
+            break;
+    }
+}
+
+void BotClient::HandleCharEnum(WorldPacket& packet)
+{
+    if (packet.read<uint8>())
+    {
+        std::string name;
+        packet >> _guid;
+        packet >> name;
+        packet >> _race;
+
+        _language = ((1 << (_race - 1)) & RACEMASK_ALLIANCE) ? LANG_COMMON : LANG_ORCISH;
+
+        WorldPacket login(CMSG_PLAYER_LOGIN, 8);
+        login << _guid;
+        SendWorldPacket(login);
+
+        SetState(BOT_STATE_LOADING);
+        return;
+    }
+
+    if (_createdCharacter)
+    {
+        Fail("created character is missing");
+        return;
+    }
+
+    _createdCharacter = true;
+
+    WorldPacket create(CMSG_CHAR_CREATE, 20);
+    create << GetCharacterName();
+    create << uint8(_config.CharacterRace);
+    create << uint8(_config.CharacterClass);
+    create << uint8(GENDER_MALE);
+    create << uint8(0);                                 // skin
+    create << uint8(0);                                 // face
+    create << uint8(0);                                 // hair style
+    create << uint8(0);                                 // hair color
+    create << uint8(0);                                 // facial hair
+    create << uint8(0);                                 // outfit
+    SendWorldPacket(create);
+}
+
+void BotClient::HandleCharCreate(WorldPacket& packet)
+{
+    if (packet.read<uint8>() != CHAR_CREATE_SUCCESS)
+    {
+        Fail("character creation failed");
+        return;
+    }
+
+    SendWorldPacket(WorldPacket(CMSG_CHAR_ENUM, 0));
+}
+
+void BotClient::HandleLoginVerifyWorld(WorldPacket& packet)
+{
+    packet.read_skip<uint32>();                         // map
+    packet >> _x >> _y >> _z >> _orientation;
+    _homeX = _x;
+    _homeY = _y;
+
+    _stats.LoginTime.Add(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - _startTime));
+    SetState(BOT_STATE_IN_WORLD);
+
+    // spread the actions of bots that entered the world together
+    TimePoint const now = std::chrono::steady_clock::now();
+    _nextAction = now + Milliseconds(_random() % (_config.ActionInterval.count() + 1));
+    _nextProbe = now + Milliseconds(_random() % (_config.ProbeInterval.count() + 1));
+
+    ScheduleUpdate();
+}
+
+void BotClient::HandleTimeSyncRequest(WorldPacket& packet)
+{
+    WorldPacket response(CMSG_TIME_SYNC_RESP, 8);
+    response << packet.read<uint32>();                  // counter
+    response << GetClientTime();
+    SendWorldPacket(response);
+}
+
+void BotClient::HandleProbeResponse(BotProbe probe)
+{
+    TimePoint& sent = _probeSent[probe];
+    if (sent == TimePoint())
+        return;
+
+    _stats.Responses[probe].Add(std::chrono::duration_cast<Microseconds>(std::chrono::steady_clock::now() - sent));
+    sent = TimePoint();
+}
+
+void BotClient::ScheduleUpdate()
+{
+    _updateTimer.expires_after(_config.UpdateInterval);
+    _updateTimer.async_wait([self = shared_from_this()](boost::system::error_code const& error)
+    {
+        if (!error && self->_state == BOT_STATE_IN_WORLD)
+            self->Update();
+    });
+}
+
+void BotClient::Update()
+{
+    if (_moveHeartbeats)
+    {
+        float const distance = MOVEMENT_RUN_SPEED * _config.UpdateInterval.count() / 1000.0f;
+        _x += distance * std::cos(_orientation);
+        _y += distance * std::sin(_orientation);
+
+        if (--_moveHeartbeats)
+            SendMovement(MSG_MOVE_HEARTBEAT, MOVEMENT_FLAG_FORWARD);
+        else
+            SendMovement(MSG_MOVE_STOP, 0);
+    }
+
+    TimePoint const now = std::chrono::steady_clock::now();
+    if (_config.ActionInterval > 0ms && now >= _nextAction)
+    {
+        _nextAction = now + _config.ActionInterval;
+
+        uint32 totalWeight = 0;
+        for (uint32 weight : _config.ActionWeights)
+            totalWeight += weight;
+
+        if (totalWeight)
+        {
+            uint32 roll = _random() % totalWeight;
+            for (uint8 action = 0; action < MAX_BOT_ACTIONS; ++action)
+            {
+                if (roll < _config.ActionWeights[action])
+                {
+                    DoAction(BotAction(action));
+                    break;
+                }
+
+                roll -= _config.ActionWeights[action];
+            }
+        }
+    }
+
+    if (_config.ProbeInterval > 0ms && now >= _nextProbe)
+    {
+        _nextProbe = now + _config.ProbeInterval;
+        SendProbe(BOT_PROBE_QUERY_TIME, WorldPacket(CMSG_QUERY_TIME, 0));
+    }
+
+    ScheduleUpdate();
+}
+
+void BotClient::DoAction(BotAction action)
+{
+    ++_stats.Actions[action];
+
+    switch (action)
+    {
+        case BOT_ACTION_MOVEMENT:
+            StartMoving();
+            break;
+        case BOT_ACTION_CHAT:
+        {
+            WorldPacket packet(CMSG_MESSAGECHAT, 32);
+            packet << uint32(CHAT_MSG_SAY);
+            packet << _language;
+            packet << "Load test message " + std::to_string(_random() % 1000);
+            SendProbe(BOT_PROBE_CHAT, packet);
+            break;
+        }
+        case BOT_ACTION_CAST:
+        {
+            WorldPacket packet(CMSG_CAST_SPELL, 10);
+            packet << uint8(++_castCount);
+            packet << uint32(_config.CastSpellId);
+            packet << uint8(0);                         // cast flags
+            packet << uint32(0);                        // target mask, the caster
+            SendProbe(BOT_PROBE_CAST, packet);
+            break;
+        }
+        case BOT_ACTION_AUCTION_SEARCH:
+        {
+            WorldPacket packet(CMSG_AUCTION_LIST_ITEMS, 40);
+            packet << _config.AuctioneerGuid;
+            packet << uint32(0);                        // list from
+            packet << std::string(1, char('a' + _random() % 26));
+            packet << uint8(0) << uint8(0);             // level range
+            packet << uint32(-1) << uint32(-1) << uint32(-1); // slot, class, subclass
+            packet << uint32(-1);                       // quality
+            packet << uint8(0);                         // usable
+            packet << uint8(0);                         // get all
+            packet << uint8(0);                         // sort columns
+            SendProbe(BOT_PROBE_AUCTION_SEARCH, packet);
+            break;
+        }
+        case BOT_ACTION_WHO:
+        {
+            WorldPacket packet(CMSG_WHO, 26);
+            packet << uint32(0) << uint32(100);         // level range
+            packet << "";                               // player name
+            packet << "";                               // guild name
+            packet << uint32(-1) << uint32(-1);         // race and class mask
+            packet << uint32(0);                        // zones
+            packet << uint32(0);                        // strings
+            SendProbe(BOT_PROBE_WHO, packet);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void BotClient::StartMoving()
+{
+    if (_moveHeartbeats)
+        return;
+
+    // wander around the login position, runs back once too far away
+    float const dx = _homeX - _x;
+    float const dy = _homeY - _y;
+    if (dx * dx + dy * dy > _config.WanderRadius * _config.WanderRadius)
+        _orientation = std::atan2(dy, dx);
+    else
+        _orientation = std::uniform_real_distribution<float>(0.0f, 2.0f * float(M_PI))(_random);
+
+    if (_orientation < 0.0f)
+        _orientation += 2.0f * float(M_PI);
+
+    _moveHeartbeats = 4 + _random() % 5;
+    SendMovement(MSG_MOVE_START_FORWARD, MOVEMENT_FLAG_FORWARD);
+}
+
+void BotClient::SendMovement(uint16 opcode, uint32 flags)
+{
+    WorldPacket packet(opcode, 36);
+    packet.appendPackGUID(_guid);
+    packet << uint32(flags);
+    packet << uint16(0);                                // extra flags
+    packet << GetClientTime();
+    packet << _x << _y << _z << _orientation;
+    packet << uint32(0);                                // fall time
+    SendWorldPacket(packet);
+}
+
+void BotClient::SendProbe(BotProbe probe, WorldPacket const& packet)
+{
+    // a request without answer (e.g. an auctioneer out of reach) doesn't block the probe forever
+    TimePoint const now = std::chrono::steady_clock::now();
+    TimePoint& sent = _probeSent[probe];
+    if (sent == TimePoint() || now - sent > PROBE_TIMEOUT)
+        sent = now;
+
+    SendWorldPacket(packet);
+}
+
+uint32 BotClient::GetClientTime() const
+{
+    return uint32(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - _startTime).count());
+}
+
+std::string BotClient::GetCharacterName() const
+{
+    // names may only contain letters, the bot number is spelled with syllables
+    static constexpr char Consonants[] = "bcdfghklmnprstvz";
+    static constexpr char Vowels[] = "aeiou";
+
+    std::string name = _config.CharacterPrefix;
+    uint32 number = _config.FirstAccount + _index;
+    do
+    {
+        name += Consonants[number % 16];
+        name += Vowels[number / 16 % 5];
+        number /= 16 * 5;
+    } while (number);
+
+    return name;
+}
@@ -0,0 +1,203 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BotClient_h__
+#define BotClient_h__
+
+#include "AuthCrypt.h"
+#include "AuthDefines.h"
+#include "BotConfig.h"
+#include "WorldPacket.h"
+#include <array>
+#include <atomic>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace Acore::Asio
+{
+    class IoContext;
+}
+
+enum BotState : uint8
+{
+    BOT_STATE_IDLE,
+    BOT_STATE_AUTHENTICATING,
+    BOT_STATE_CONNECTING,                   // world server, up to the auth response
+    BOT_STATE_QUEUED,
+    BOT_STATE_SELECTING_CHARACTER,
+    BOT_STATE_LOADING,
+    BOT_STATE_IN_WORLD,
+    BOT_STATE_FAILED,
+    BOT_STATE_STOPPED,
+
+    MAX_BOT_STATES
+};
+
+/// Requests whose response time is measured, each has at most one outstanding request per bot
+enum BotProbe : uint8
+{
+    BOT_PROBE_QUERY_TIME,                   // answered in the session update, follows the server tick
+    BOT_PROBE_CHAT,
+    BOT_PROBE_CAST,
+    BOT_PROBE_AUCTION_SEARCH,
+    BOT_PROBE_WHO,
+
+    MAX_BOT_PROBES
+};
+
+char const* GetBotStateName(BotState state);
+char const* GetBotProbeName(BotProbe probe);
+
+struct BotLatency
+{
+    void Add(Microseconds time);
+
+    struct Snapshot
+    {
+        uint64 Count;
+        Microseconds Average;
+        Microseconds Max;
+    };
+
+    /// Returns the values since the previous call
+    Snapshot Take();
+
+private:
+    std::atomic<uint64> _total{ 0 };
+    std::atomic<uint64> _count{ 0 };
+    std::atomic<uint64> _max{ 0 };
+};
+
+/// Shared by all bots, written from the network threads
+struct BotStats
+{
+    std::array<std::atomic<uint32>, MAX_BOT_STATES> States{};
+    std::array<std::atomic<uint64>, MAX_BOT_ACTIONS> Actions{};
+    std::atomic<uint64> PacketsSent{ 0 };
+    std::atomic<uint64> PacketsReceived{ 0 };
+    std::atomic<uint64> Disconnects{ 0 };
+    BotLatency LoginTime;                   // from the logon challenge to the world verification
+    std::array<BotLatency, MAX_BOT_PROBES> Responses;
+};
+
+/**
+ * One scripted client. It logs in through the authserver (SRP6), selects the realm from the
+ * realm list, connects to the worldserver, creates a character when the account has none and
+ * enters the world. In the world it does a weighted random action every ActionInterval and
+ * measures how long the server takes to answer.
+ *
+ * All handlers of a bot run on its strand.
+ */
+class BotClient : public std::enable_shared_from_this<BotClient>
+{
+public:
+    BotClient(Acore::Asio::IoContext& ioContext, BotConfig const& config, BotStats& stats, uint32 index);
+    ~BotClient();
+
+    void Start();
+    void Stop();
+
+private:
+    using tcp = boost::asio::ip::tcp;
+    using Handler = void (BotClient::*)();
+
+    void SetState(BotState state);
+    void Fail(char const* reason);
+    void Close();
+    bool Resolve(std::string const& host, std::string const& port, tcp::endpoint& endpoint);
+
+    // authserver
+    void SendLogonChallenge();
+    void HandleLogonChallengeResult();
+    void HandleLogonChallenge();
+    void HandleLogonProofResult();
+    void HandleLogonProof();
+    void HandleRealmListHeader();
+    void HandleRealmList();
+    void ReadAuth(std::size_t size, Handler handler);
+    void WriteAuth(ByteBuffer const& packet);
+
+    // worldserver
+    void ConnectWorld(tcp::endpoint const& endpoint);
+    void ReadWorldHeader();
+    void ReadWorldLargeHeader();
+    void ReadWorldBody(std::size_t size);
+    void HandleWorldPacket(WorldPacket& packet);
+    void SendWorldPacket(WorldPacket const& packet);
+    void Write(std::vector<uint8>&& data);
+    void WriteNext();
+
+    void HandleAuthChallenge(WorldPacket& packet);
+    void HandleAuthResponse(WorldPacket& packet);
+    void HandleCharEnum(WorldPacket& packet);
+    void HandleCharCreate(WorldPacket& packet);
+    void HandleLoginVerifyWorld(WorldPacket& packet);
+    void HandleTimeSyncRequest(WorldPacket& packet);
+    void HandleProbeResponse(BotProbe probe);
+
+    // in the world
+    void ScheduleUpdate();
+    void Update();
+    void DoAction(BotAction action);
+    void StartMoving();
+    void SendMovement(uint16 opcode, uint32 flags);
+    void SendProbe(BotProbe probe, WorldPacket const& packet);
+
+    uint32 GetClientTime() const;
+    std::string GetCharacterName() const;
+
+    BotConfig const& _config;
+    BotStats& _stats;
+    uint32 _index;
+    std::string _account;
+    std::string _password;
+
+    boost::asio::strand<boost::asio::io_context::executor_type> _strand;
+    tcp::socket _socket;
+    boost::asio::steady_timer _updateTimer;
+    std::vector<uint8> _readBuffer;
+    std::deque<std::vector<uint8>> _writeQueue;
+    std::mt19937 _random;
+
+    BotState _state;
+    TimePoint _startTime;
+    SessionKey _sessionKey;
+    std::array<uint8, 32> _clientPublicKey;
+    std::array<uint8, 20> _clientProof;
+    AuthCrypt _authCrypt;
+    std::array<uint8, 5> _header;
+    uint16 _readOpcode;
+
+    uint64 _guid;
+    uint8 _race;
+    bool _createdCharacter;
+    uint32 _language;
+    float _homeX, _homeY;
+    float _x, _y, _z, _orientation;
+    uint32 _moveHeartbeats;
+    uint8 _castCount;
+    TimePoint _nextAction;
+    TimePoint _nextProbe;
+    std::array<TimePoint, MAX_BOT_PROBES> _probeSent;
+};
+
+#endif // BotClient_h__
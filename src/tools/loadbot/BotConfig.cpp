@@ -0,0 +1,77 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BotConfig.h"
+#include "Config.h"
+#include <algorithm>
+
+char const* GetBotActionName(BotAction action)
+{
+    switch (action)
+    {
+        case BOT_ACTION_MOVEMENT:       return "movement";
+        case BOT_ACTION_CHAT:           return "chat";
+        case BOT_ACTION_CAST:           return "cast";
+        case BOT_ACTION_AUCTION_SEARCH: return "auction_search";
+        case BOT_ACTION_WHO:            return "who";
+        default:                        return "unknown";
+    }
+}
+
+/*static*/ BotConfig BotConfig::Load()
+{
+    BotConfig config;
+
+    config.AuthServerHost = sConfigMgr->GetOption<std::string>("AuthServer.Host", "127.0.0.1");
+    config.AuthServerPort = sConfigMgr->GetOption<uint16>("AuthServer.Port", 3724);
+    config.WorldServerAddress = sConfigMgr->GetOption<std::string>("WorldServer.Address", "");
+    config.RealmId = sConfigMgr->GetOption<uint32>("RealmID", 1);
+
+    config.AccountPrefix = sConfigMgr->GetOption<std::string>("Bots.AccountPrefix", "LOADBOT");
+    config.AccountPassword = sConfigMgr->GetOption<std::string>("Bots.AccountPassword", "loadbot");
+    config.FirstAccount = sConfigMgr->GetOption<uint32>("Bots.FirstAccount", 1);
+    config.BotCount = sConfigMgr->GetOption<uint32>("Bots.Count", 100);
+    config.LoginsPerSecond = std::max<uint32>(sConfigMgr->GetOption<uint32>("Bots.LoginsPerSecond", 20), 1);
+
+    config.CharacterPrefix = sConfigMgr->GetOption<std::string>("Bots.CharacterPrefix", "Bot");
+    config.CharacterRace = sConfigMgr->GetOption<uint8>("Bots.CharacterRace", 1);
+    config.CharacterClass = sConfigMgr->GetOption<uint8>("Bots.CharacterClass", 5);
+
+    config.UpdateInterval = Milliseconds(std::max<uint32>(sConfigMgr->GetOption<uint32>("Bots.UpdateInterval", 500), 50));
+    config.ActionInterval = Milliseconds(sConfigMgr->GetOption<uint32>("Bots.ActionInterval", 3000));
+    config.ProbeInterval = Milliseconds(sConfigMgr->GetOption<uint32>("Bots.ProbeInterval", 5000));
+    config.Duration = Seconds(sConfigMgr->GetOption<uint32>("Duration", 0));
+    config.ReportInterval = Seconds(std::max<uint32>(sConfigMgr->GetOption<uint32>("ReportInterval", 10), 1));
+
+    config.ActionWeights[BOT_ACTION_MOVEMENT] = sConfigMgr->GetOption<uint32>("Bots.Mix.Movement", 50);
+    config.ActionWeights[BOT_ACTION_CHAT] = sConfigMgr->GetOption<uint32>("Bots.Mix.Chat", 15);
+    config.ActionWeights[BOT_ACTION_CAST] = sConfigMgr->GetOption<uint32>("Bots.Mix.Cast", 20);
+    config.ActionWeights[BOT_ACTION_AUCTION_SEARCH] = sConfigMgr->GetOption<uint32>("Bots.Mix.AuctionSearch", 5);
+    config.ActionWeights[BOT_ACTION_WHO] = sConfigMgr->GetOption<uint32>("Bots.Mix.Who", 10);
+    config.CastSpellId = sConfigMgr->GetOption<uint32>("Bots.CastSpellId", 2050);
+    config.AuctioneerGuid = sConfigMgr->GetOption<uint64>("Bots.AuctioneerGuid", 0);
+    config.WanderRadius = sConfigMgr->GetOption<float>("Bots.WanderRadius", 20.0f);
+
+    // actions that can't be done don't take a share of the mix
+    if (!config.CastSpellId)
+        config.ActionWeights[BOT_ACTION_CAST] = 0;
+
+    if (!config.AuctioneerGuid)
+        config.ActionWeights[BOT_ACTION_AUCTION_SEARCH] = 0;
+
+    return config;
+}
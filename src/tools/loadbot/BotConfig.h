@@ -0,0 +1,70 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BotConfig_h__
+#define BotConfig_h__
+
+#include "Define.h"
+#include "Duration.h"
+#include <array>
+#include <string>
+
+enum BotAction : uint8
+{
+    BOT_ACTION_MOVEMENT,
+    BOT_ACTION_CHAT,
+    BOT_ACTION_CAST,
+    BOT_ACTION_AUCTION_SEARCH,
+    BOT_ACTION_WHO,
+
+    MAX_BOT_ACTIONS
+};
+
+char const* GetBotActionName(BotAction action);
+
+struct BotConfig
+{
+    std::string AuthServerHost;
+    uint16 AuthServerPort;
+    std::string WorldServerAddress;         // "host:port", empty takes the address of the realm list
+    uint32 RealmId;
+
+    std::string AccountPrefix;
+    std::string AccountPassword;
+    uint32 FirstAccount;
+    uint32 BotCount;
+    uint32 LoginsPerSecond;
+
+    std::string CharacterPrefix;
+    uint8 CharacterRace;
+    uint8 CharacterClass;
+
+    Milliseconds UpdateInterval;
+    Milliseconds ActionInterval;
+    Milliseconds ProbeInterval;
+    Seconds Duration;                       // 0 runs until stopped
+    Seconds ReportInterval;
+
+    std::array<uint32, MAX_BOT_ACTIONS> ActionWeights;
+    uint32 CastSpellId;
+    uint64 AuctioneerGuid;
+    float WanderRadius;
+
+    static BotConfig Load();
+};
+
+#endif // BotConfig_h__
@@ -0,0 +1,328 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Banner.h"
+#include "BotClient.h"
+#include "BotConfig.h"
+#include "Config.h"
+#include "IoContext.h"
+#include "Log.h"
+#include "Metric.h"
+#include "OpenSSLCrypto.h"
+#include "Util.h"
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/program_options.hpp>
+#include <boost/version.hpp>
+#include <csignal>
+#include <filesystem>
+#include <iostream>
+#include <openssl/crypto.h>
+#include <openssl/opensslv.h>
+#include <thread>
+
+#ifndef _ACORE_LOAD_BOT_CONFIG
+#define _ACORE_LOAD_BOT_CONFIG "loadbot.conf"
+#endif
+
+using namespace boost::program_options;
+namespace fs = std::filesystem;
+
+/// Starts the bots at the configured login rate and reports what they measure
+class LoadBotRunner
+{
+public:
+    LoadBotRunner(Acore::Asio::IoContext& ioContext, BotConfig const& config) :
+        _ioContext(ioContext), _config(config), _strand(ioContext.get_executor()), _loginTimer(ioContext), _reportTimer(ioContext),
+        _metricTimer(ioContext), _durationTimer(ioContext), _stopped(false) { }
+
+    boost::asio::strand<boost::asio::io_context::executor_type>& GetStrand() { return _strand; }
+
+    void Start()
+    {
+        _bots.reserve(_config.BotCount);
+        _stats.States[BOT_STATE_IDLE] = _config.BotCount;
+
+        ScheduleLogin();
+        ScheduleReport();
+        ScheduleMetricUpdate();
+
+        if (_config.Duration > 0s)
+        {
+            _durationTimer.expires_after(_config.Duration);
+            _durationTimer.async_wait(boost::asio::bind_executor(_strand, [this](boost::system::error_code const& error)
+            {
+                if (!error)
+                    Stop();
+            }));
+        }
+    }
+
+    void Stop()
+    {
+        if (_stopped)
+            return;
+
+        _stopped = true;
+        LOG_INFO("loadbot", "Stopping {} bots...", _bots.size());
+
+        _loginTimer.cancel();
+        _durationTimer.cancel();
+
+        for (std::shared_ptr<BotClient> const& bot : _bots)
+            bot->Stop();
+
+        // let the bots close their sockets and send the last report before the network stops
+        _reportTimer.cancel();
+        _reportTimer.expires_after(1s);
+        _reportTimer.async_wait(boost::asio::bind_executor(_strand, [this](boost::system::error_code const& /*error*/)
+        {
+            Report();
+            _metricTimer.cancel();
+            _ioContext.stop();
+        }));
+    }
+
+    void LogOverallStatus()
+    {
+        for (uint8 state = 0; state < MAX_BOT_STATES; ++state)
+            METRIC_VALUE("loadbot_bots", _stats.States[state].load(), METRIC_TAG("state", GetBotStateName(BotState(state))));
+
+        METRIC_VALUE("loadbot_packets_sent", _stats.PacketsSent.load());
+        METRIC_VALUE("loadbot_packets_received", _stats.PacketsReceived.load());
+        METRIC_VALUE("loadbot_disconnects", _stats.Disconnects.load());
+    }
+
+private:
+    void ScheduleLogin()
+    {
+        _loginTimer.expires_after(std::max<Milliseconds>(Milliseconds(1000 / _config.LoginsPerSecond), 1ms));
+        _loginTimer.async_wait(boost::asio::bind_executor(_strand, [this](boost::system::error_code const& error)
+        {
+            if (error || _stopped)
+                return;
+
+            std::shared_ptr<BotClient> bot = std::make_shared<BotClient>(_ioContext, _config, _stats, uint32(_bots.size()));
+            bot->Start();
+            _bots.push_back(std::move(bot));
+
+            if (_bots.size() < _config.BotCount)
+                ScheduleLogin();
+            else
+                LOG_INFO("loadbot", "All {} bots started.", _bots.size());
+        }));
+    }
+
+    void ScheduleReport()
+    {
+        _reportTimer.expires_after(_config.ReportInterval);
+        _reportTimer.async_wait(boost::asio::bind_executor(_strand, [this](boost::system::error_code const& error)
+        {
+            if (error || _stopped)
+                return;
+
+            Report();
+            ScheduleReport();
+        }));
+    }
+
+    void ScheduleMetricUpdate()
+    {
+        _metricTimer.expires_after(1s);
+        _metricTimer.async_wait(boost::asio::bind_executor(_strand, [this](boost::system::error_code const& error)
+        {
+            if (error)
+                return;
+
+            sMetric->Update();
+            ScheduleMetricUpdate();
+        }));
+    }
+
+    void Report()
+    {
+        LOG_INFO("loadbot", "Bots in world: {}, loading: {}, authenticating: {}, queued: {}, failed: {}, disconnects: {}",
+            _stats.States[BOT_STATE_IN_WORLD].load(), _stats.States[BOT_STATE_LOADING].load() + _stats.States[BOT_STATE_SELECTING_CHARACTER].load(),
+            _stats.States[BOT_STATE_AUTHENTICATING].load() + _stats.States[BOT_STATE_CONNECTING].load(), _stats.States[BOT_STATE_QUEUED].load(),
+            _stats.States[BOT_STATE_FAILED].load(), _stats.Disconnects.load());
+
+        BotLatency::Snapshot login = _stats.LoginTime.Take();
+        if (login.Count)
+        {
+            LOG_INFO("loadbot", "  {:<16} {:>6} logins, avg {:>6} ms, max {:>6} ms", "login", login.Count,
+                std::chrono::duration_cast<Milliseconds>(login.Average).count(), std::chrono::duration_cast<Milliseconds>(login.Max).count());
+            METRIC_VALUE("loadbot_login_time", login.Average);
+        }
+
+        for (uint8 probe = 0; probe < MAX_BOT_PROBES; ++probe)
+        {
+            BotLatency::Snapshot response = _stats.Responses[probe].Take();
+            if (!response.Count)
+                continue;
+
+            LOG_INFO("loadbot", "  {:<16} {:>6} responses, avg {:>6} ms, max {:>6} ms", GetBotProbeName(BotProbe(probe)), response.Count,
+                std::chrono::duration_cast<Milliseconds>(response.Average).count(), std::chrono::duration_cast<Milliseconds>(response.Max).count());
+            METRIC_VALUE("loadbot_response_time_avg", response.Average, METRIC_TAG("probe", GetBotProbeName(BotProbe(probe))));
+            METRIC_VALUE("loadbot_response_time_max", response.Max, METRIC_TAG("probe", GetBotProbeName(BotProbe(probe))));
+        }
+
+        for (uint8 action = 0; action < MAX_BOT_ACTIONS; ++action)
+            METRIC_VALUE("loadbot_actions", _stats.Actions[action].load(), METRIC_TAG("action", GetBotActionName(BotAction(action))));
+    }
+
+    Acore::Asio::IoContext& _ioContext;
+    BotConfig const& _config;
+    BotStats _stats;
+    std::vector<std::shared_ptr<BotClient>> _bots;
+    boost::asio::strand<boost::asio::io_context::executor_type> _strand;
+    boost::asio::steady_timer _loginTimer;
+    boost::asio::steady_timer _reportTimer;
+    boost::asio::steady_timer _metricTimer;
+    boost::asio::steady_timer _durationTimer;
+    bool _stopped;
+};
+
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile);
+
+/// Launch the load test bots
+int main(int argc, char** argv)
+{
+    signal(SIGABRT, &Acore::AbortHandler);
+
+    // Command line parsing
+    auto configFile = fs::path(sConfigMgr->GetConfigPath() + std::string(_ACORE_LOAD_BOT_CONFIG));
+    auto vm = GetConsoleArguments(argc, argv, configFile);
+
+    // exit if help is enabled
+    if (vm.count("help"))
+        return 0;
+
+    // Add file and args in config
+    sConfigMgr->Configure(configFile.generic_string(), std::vector<std::string>(argv, argv + argc));
+
+    if (!sConfigMgr->LoadAppConfigs())
+        return 1;
+
+    std::vector<std::string> overriddenKeys = sConfigMgr->OverrideWithEnvVariablesIfAny();
+
+    // Init logging
+    sLog->Initialize();
+
+    Acore::Banner::Show("loadbot",
+        [](std::string_view text)
+        {
+            LOG_INFO("loadbot", text);
+        },
+        []()
+        {
+            LOG_INFO("loadbot", "> Using configuration file:       {}", sConfigMgr->GetFilename());
+            LOG_INFO("loadbot", "> Using SSL version:              {} (library: {})", OPENSSL_VERSION_TEXT, OpenSSL_version(OPENSSL_VERSION));
+            LOG_INFO("loadbot", "> Using Boost version:            {}.{}.{}", BOOST_VERSION / 100000, BOOST_VERSION / 100 % 1000, BOOST_VERSION % 100);
+        }
+    );
+
+    for (std::string const& key : overriddenKeys)
+        LOG_INFO("loadbot", "Configuration field {} was overridden with environment variable.", key);
+
+    OpenSSLCrypto::threadsSetup();
+
+    std::shared_ptr<void> opensslHandle(nullptr, [](void*) { OpenSSLCrypto::threadsCleanup(); });
+
+    BotConfig const config = BotConfig::Load();
+    if (!config.BotCount)
+    {
+        LOG_ERROR("loadbot", "Bots.Count is 0, nothing to do.");
+        return 1;
+    }
+
+    if (sConfigMgr->isDryRun())
+    {
+        LOG_INFO("loadbot", "Dry run completed, terminating.");
+        return 0;
+    }
+
+    Acore::Asio::IoContext ioContext;
+    LoadBotRunner runner(ioContext, config);
+
+    sMetric->Initialize("loadbot", ioContext, [&runner]()
+    {
+        runner.LogOverallStatus();
+    });
+
+    // the runner and the signals share one strand, the bots each have their own
+    boost::asio::signal_set signals(ioContext, SIGINT, SIGTERM);
+    signals.async_wait(boost::asio::bind_executor(runner.GetStrand(), [&runner](boost::system::error_code const& error, int /*signalNumber*/)
+    {
+        if (!error)
+            runner.Stop();
+    }));
+
+    LOG_INFO("loadbot", "Starting {} bots against {}:{} at {} logins per second.", config.BotCount, config.AuthServerHost,
+        config.AuthServerPort, config.LoginsPerSecond);
+
+    boost::asio::post(runner.GetStrand(), [&runner]() { runner.Start(); });
+
+    std::vector<std::thread> threads;
+    for (int32 i = 1; i < std::max<int32>(sConfigMgr->GetOption<int32>("NetworkThreads", 4), 1); ++i)
+        threads.emplace_back([&ioContext]() { ioContext.run(); });
+
+    ioContext.run();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    sMetric->Unload();
+
+    LOG_INFO("loadbot", "Halting process...");
+
+    return 0;
+}
+
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile)
+{
+    options_description all("Allowed options");
+    all.add_options()
+        ("help,h", "print usage message")
+        ("version,v", "print version build info")
+        ("dry-run,d", "Dry run")
+        ("config,c", value<fs::path>(&configFile)->default_value(fs::path(sConfigMgr->GetConfigPath() + std::string(_ACORE_LOAD_BOT_CONFIG))), "use <arg> as configuration file");
+
+    variables_map variablesMap;
+
+    try
+    {
+        store(command_line_parser(argc, argv).options(all).allow_unregistered().run(), variablesMap);
+        notify(variablesMap);
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << e.what() << "\n";
+    }
+
+    if (variablesMap.count("help"))
+    {
+        std::cout << all << "\n";
+    }
+    else if (variablesMap.count("dry-run"))
+    {
+        sConfigMgr->setDryRun(true);
+    }
+
+    return variablesMap;
+}
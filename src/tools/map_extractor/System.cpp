@@ -17,11 +17,13 @@
 
 #define _CRT_SECURE_NO_DEPRECATE
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <deque>
 #include <filesystem>
 #include <set>
+#include <thread>
 #include <unordered_map>
 
 #ifdef _WIN32
@@ -55,7 +57,7 @@
 #else
 #define OPEN_FLAGS (O_RDONLY | O_BINARY)
 #endif
-extern ArchiveSet gOpenArchives;
+extern thread_local ArchiveSet gOpenArchives;
 
 // cppcheck-suppress ctuOneDefinitionRuleViolation
 typedef struct
@@ -93,6 +95,8 @@ float CONF_use_minHeight = -500.0f;
 
 // This option allow use float to int conversion
 bool  CONF_allow_float_to_int   = true;
+// Threads converting map tiles, each one opens its own MPQ handles
+uint32 CONF_threads = std::max<uint32>(std::thread::hardware_concurrency(), 1);
 float CONF_float_to_int8_limit  = 2.0f;      // Max accuracy = val/256
 float CONF_float_to_int16_limit = 2048.0f;   // Max accuracy = val/65536
 float CONF_flat_height_delta_limit = 0.005f; // If max - min less this value - surface is flat
@@ -161,6 +165,7 @@ void Usage(char* prg)
         "-o set output path\n"\
         "-e extract only MAP(1)/DBC(2)/Camera(4) - standard: all(7)\n"\
         "-f height stored as int (less map size but lost some accuracy) 1 by default\n"\
+        "-j number of threads converting map tiles, all cores by default\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"", prg, prg);
     exit(1);
 }
@@ -211,6 +216,16 @@ void HandleArgs(int argc, char* arg[])
                     Usage(arg[0]);
                 }
                 break;
+            case 'j':
+                if (c + 1 < argc)                           // all ok
+                {
+                    CONF_threads = std::max<int>(atoi(arg[(c++) + 1]), 1);
+                }
+                else
+                {
+                    Usage(arg[0]);
+                }
+                break;
             case 'e':
                 if (c + 1 < argc)                           // all ok
                 {
@@ -388,24 +403,24 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per thread converting tiles
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
-uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local uint8 liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE + 1][ADT_GRID_SIZE + 1];
+thread_local uint16 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int /*cell_y*/, int /*cell_x*/, uint32 build)
 {
@@ -969,10 +984,20 @@ bool ConvertADT(std::string const& inputPath, std::string const& outputPath, int
     return true;
 }
 
-void ExtractMapsFromMpq(uint32 build)
+void LoadLocaleMPQFiles(int const locale);
+void LoadCommonMPQFiles();
+void CloseMPQFiles();
+
+struct MapTile
+{
+    std::string InputPath;
+    std::string OutputPath;
+    uint32 X;
+    uint32 Y;
+};
+
+void ExtractMapsFromMpq(uint32 build, int locale)
 {
-    std::string mpqFileName;
-    std::string outputFileName;
     std::string mpqMapName;
 
     printf("Extracting maps...\n");
@@ -985,10 +1010,10 @@ void ExtractMapsFromMpq(uint32 build)
     path += "/maps/";
     CreateDir(path);
 
-    printf("Convert map files\n");
+    printf("Read map tile lists\n");
+    std::vector<MapTile> tiles;
     for (uint32 z = 0; z < map_count; ++z)
     {
-        printf("Extract %s (%d/%u)                  \n", map_ids[z].name, z + 1, map_count);
         // Loadup map grid data
         mpqMapName = Acore::StringFormat(R"(World\Maps\%s\%s.wdt)", map_ids[z].name, map_ids[z].name);
         WDT_file wdt;
@@ -1004,14 +1029,51 @@ void ExtractMapsFromMpq(uint32 build)
             {
                 if (!wdt.main->adt_list[y][x].exist)
                     continue;
-                mpqFileName = Acore::StringFormat(R"(World\Maps\%s\%s_%u_%u.adt)", map_ids[z].name, map_ids[z].name, x, y);
-                outputFileName = Acore::StringFormat("%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x);
-                ConvertADT(mpqFileName, outputFileName, y, x, build);
+
+                tiles.push_back({ Acore::StringFormat(R"(World\Maps\%s\%s_%u_%u.adt)", map_ids[z].name, map_ids[z].name, x, y),
+                    Acore::StringFormat("%s/maps/%03u%02u%02u.map", output_path, map_ids[z].id, y, x), x, y });
             }
-            // draw progress bar
-            printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
         }
     }
+
+    uint32 const threads = std::min<uint32>(CONF_threads, std::max<size_t>(tiles.size(), 1));
+    printf("Convert %u map tiles with %u threads\n", uint32(tiles.size()), threads);
+
+    // the tiles are independent, libmpq handles are not thread safe so every thread opens the MPQs itself
+    std::atomic<size_t> nextTile(0);
+    std::atomic<size_t> doneTiles(0);
+    auto worker = [&](bool ownArchives)
+    {
+        if (ownArchives)
+        {
+            LoadLocaleMPQFiles(locale);
+            LoadCommonMPQFiles();
+        }
+
+        for (size_t i = nextTile++; i < tiles.size(); i = nextTile++)
+        {
+            ConvertADT(tiles[i].InputPath, tiles[i].OutputPath, tiles[i].Y, tiles[i].X, build);
+
+            // draw progress bar
+            size_t const done = ++doneTiles;
+            if (done * 100 / tiles.size() != (done - 1) * 100 / tiles.size())
+                printf("Processing........................%u%%\r", uint32(done * 100 / tiles.size()));
+        }
+
+        if (ownArchives)
+            CloseMPQFiles();
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < threads; ++i)
+        workers.emplace_back(worker, true);
+
+    // the calling thread works with the MPQs it already opened
+    worker(false);
+
+    for (std::thread& thread : workers)
+        thread.join();
+
     printf("\n");
 }
 
@@ -1168,7 +1230,7 @@ void LoadCommonMPQFiles()
     }
 }
 
-inline void CloseMPQFiles()
+void CloseMPQFiles()
 {
     for (auto & gOpenArchive : gOpenArchives) gOpenArchive->close();
     gOpenArchives.clear();
@@ -1247,7 +1309,7 @@ int main(int argc, char* arg[])
         LoadCommonMPQFiles();
 
         // Extract maps
-        ExtractMapsFromMpq(build);
+        ExtractMapsFromMpq(build, FirstLocale);
 
         // Close MPQs
         CloseMPQFiles();
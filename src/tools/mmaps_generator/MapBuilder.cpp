@@ -22,14 +22,52 @@
 #include "ModelInstance.h"
 #include "PathCommon.h"
 #include "StringFormat.h"
+#include "Util.h"
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
 #include <DetourCommon.h>
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
+#include <algorithm>
+#include <cinttypes>
+#include <filesystem>
 
 namespace MMAP
 {
+    // FNV-1a, only used to notice changed input files
+    static void hashBytes(uint64& hash, void const* data, size_t size)
+    {
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        for (size_t i = 0; i < size; ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+    }
+
+    static void hashFile(uint64& hash, char const* fileName)
+    {
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+        {
+            // a missing input differs from an empty one
+            uint32 const missing = 0xFFFFFFFF;
+            hashBytes(hash, &missing, sizeof(missing));
+            return;
+        }
+
+        unsigned char buffer[64 * 1024];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            hashBytes(hash, buffer, count);
+
+        fclose(file);
+    }
+
+    static uint64 fileSize(char const* fileName)
+    {
+        std::error_code error;
+        uintmax_t size = std::filesystem::file_size(fileName, error);
+        return error ? 0 : uint64(size);
+    }
+
     TileBuilder::TileBuilder(MapBuilder* mapBuilder, bool skipLiquid, bool bigBaseUnit, bool debugOutput) :
             m_bigBaseUnit(bigBaseUnit),
             m_debugOutput(debugOutput),
@@ -72,11 +110,23 @@ namespace MMAP
         m_mapid              (mapid),
         m_totalTiles         (0u),
         m_totalTilesProcessed(0u),
+        m_totalTilesUpToDate (0u),
+        m_startTime          (std::chrono::steady_clock::now()),
+        m_settingsHash       (0xCBF29CE484222325ULL),
 
         _cancelationToken    (false)
     {
         m_terrainBuilder = new TerrainBuilder(skipLiquid);
 
+        // tiles built with other settings or by another generator version are rebuilt
+        uint32 const versions[] = { MMAP_VERSION, uint32(DT_NAVMESH_VERSION) };
+        hashBytes(m_settingsHash, versions, sizeof(versions));
+        hashBytes(m_settingsHash, &m_maxWalkableAngle, sizeof(m_maxWalkableAngle));
+        hashBytes(m_settingsHash, &m_bigBaseUnit, sizeof(m_bigBaseUnit));
+        hashBytes(m_settingsHash, &m_skipLiquid, sizeof(m_skipLiquid));
+        if (m_offMeshFilePath)
+            hashFile(m_settingsHash, m_offMeshFilePath);
+
         m_rcContext = new rcContext(false);
 
         // At least 1 thread is needed
@@ -208,14 +258,16 @@ namespace MMAP
     {
         printf("Using %u threads to generate mmaps\n", m_threads);
 
+        m_startTime = std::chrono::steady_clock::now();
         for (unsigned int i = 0; i < m_threads; ++i)
         {
             m_tileBuilders.push_back(new TileBuilder(this, m_skipLiquid, m_bigBaseUnit, m_debugOutput));
         }
 
+        std::vector<TileInfo> queuedTiles;
         if (mapID)
         {
-            buildMap(*mapID);
+            buildMap(*mapID, queuedTiles);
         }
         else
         {
@@ -223,10 +275,20 @@ namespace MMAP
             for (TileList::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
             {
                 if (!shouldSkipMap(it->m_mapId))
-                    buildMap(it->m_mapId);
+                    buildMap(it->m_mapId, queuedTiles);
             }
         }
 
+        // the workers share one queue over the tiles of all maps, queue the biggest tiles first
+        // so a large map does not leave a few threads working through its tiles alone at the end
+        std::stable_sort(queuedTiles.begin(), queuedTiles.end(), [](TileInfo const& left, TileInfo const& right)
+        {
+            return left.m_inputSize > right.m_inputSize;
+        });
+
+        for (TileInfo const& tileInfo : queuedTiles)
+            _queue.Push(tileInfo);
+
         while (!_queue.Empty())
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -240,6 +302,8 @@ namespace MMAP
             delete builder;
 
         m_tileBuilders.clear();
+
+        printf("%u tiles processed, %u were up to date\n", m_totalTilesProcessed.load(), m_totalTilesUpToDate.load());
     }
 
     /**************************************************************************/
@@ -421,7 +485,7 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    void MapBuilder::buildMap(uint32 mapID)
+    void MapBuilder::buildMap(uint32 mapID, std::vector<TileInfo>& queuedTiles)
     {
         std::set<uint32>* tiles = getTileList(mapID);
 
@@ -450,8 +514,9 @@ namespace MMAP
                 tileInfo.m_mapId = mapID;
                 tileInfo.m_tileX = tileX;
                 tileInfo.m_tileY = tileY;
+                tileInfo.m_inputSize = getTileInputSize(mapID, tileX, tileY);
                 memcpy(&tileInfo.m_navMeshParams, navMesh->getParams(), sizeof(dtNavMeshParams));
-                _queue.Push(tileInfo);
+                queuedTiles.push_back(tileInfo);
             }
 
             dtFreeNavMesh(navMesh);
@@ -461,13 +526,15 @@ namespace MMAP
     /**************************************************************************/
     void TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
-        if(shouldSkipTile(mapID, tileX, tileY))
+        uint64 inputHash = m_mapBuilder->getTileInputHash(mapID, tileX, tileY);
+        if (shouldSkipTile(mapID, tileX, tileY, inputHash))
         {
+            ++m_mapBuilder->m_totalTilesUpToDate;
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
         }
 
-        printf("%u%% [Map %04i] Building tile [%02u,%02u]\n", m_mapBuilder->currentPercentageDone(), mapID, tileX, tileY);
+        printf("%u%% (ETA %s) [Map %04i] Building tile [%02u,%02u]\n", m_mapBuilder->currentPercentageDone(), m_mapBuilder->currentETA().c_str(), mapID, tileX, tileY);
 
         MeshData meshData;
 
@@ -480,6 +547,7 @@ namespace MMAP
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
         {
+            writeInputHash(mapID, tileX, tileY, inputHash);
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
         }
@@ -495,6 +563,7 @@ namespace MMAP
 
         if (!allVerts.size())
         {
+            writeInputHash(mapID, tileX, tileY, inputHash);
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
         }
@@ -508,6 +577,10 @@ namespace MMAP
         // build navmesh tile
         buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
 
+        // failed tiles get no hash and are retried by the next run
+        if (hasValidTile(mapID, tileX, tileY))
+            writeInputHash(mapID, tileX, tileY, inputHash);
+
         ++m_mapBuilder->m_totalTilesProcessed;
     }
 
@@ -1027,7 +1100,26 @@ namespace MMAP
     }
 
     /**************************************************************************/
-    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const
+    bool TileBuilder::shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash) const
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/%03u%02i%02i.mmhash", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "rb");
+        if (!file)
+            return false;
+
+        uint64 builtHash = 0;
+        uint32 hasTile = 0;
+        int count = fscanf(file, "%" SCNx64 " %u", &builtHash, &hasTile);
+        fclose(file);
+        if (count != 2 || builtHash != inputHash)
+            return false;
+
+        // tiles without any geometry never get a .mmtile
+        return !hasTile || hasValidTile(mapID, tileX, tileY);
+    }
+
+    bool TileBuilder::hasValidTile(uint32 mapID, uint32 tileX, uint32 tileY) const
     {
         char fileName[255];
         sprintf(fileName, "mmaps/%03u%02i%02i.mmtile", mapID, tileY, tileX);
@@ -1050,6 +1142,49 @@ namespace MMAP
         return true;
     }
 
+    void TileBuilder::writeInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash) const
+    {
+        char fileName[255];
+        sprintf(fileName, "mmaps/%03u%02i%02i.mmhash", mapID, tileY, tileX);
+        FILE* file = fopen(fileName, "wb");
+        if (!file)
+        {
+            char message[1024];
+            sprintf(message, "[Map %03i] Failed to open %s for writing!\n", mapID, fileName);
+            perror(message);
+            return;
+        }
+
+        fprintf(file, "%016" PRIx64 " %u\n", inputHash, hasValidTile(mapID, tileX, tileY) ? 1u : 0u);
+        fclose(file);
+    }
+
+    uint64 MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        uint64 hash = m_settingsHash;
+        char fileName[255];
+
+        // TerrainBuilder::loadMap uses the borders of the neighbouring grids too
+        int32 const neighbours[5][2] = { { 0, 0 }, { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+        for (int32 const* offset : neighbours)
+        {
+            sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY + offset[1], tileX + offset[0]);
+            hashFile(hash, fileName);
+        }
+
+        hashFile(hash, ("vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX)).c_str());
+        sprintf(fileName, "vmaps/%03u.vmtree", mapID);
+        hashFile(hash, fileName);
+        return hash;
+    }
+
+    uint64 MapBuilder::getTileInputSize(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        char fileName[255];
+        sprintf(fileName, "maps/%03u%02u%02u.map", mapID, tileY, tileX);
+        return fileSize(fileName) + fileSize(("vmaps/" + StaticMapTree::getTileFileName(mapID, tileY, tileX)).c_str());
+    }
+
     rcConfig MapBuilder::GetMapSpecificConfig(uint32 mapID, float bmin[3], float bmax[3], const TileConfig &tileConfig) const
     {
         rcConfig config;
@@ -1108,4 +1243,14 @@ namespace MMAP
     {
         return percentageDone(m_totalTiles, m_totalTilesProcessed);
     }
+
+    std::string MapBuilder::currentETA() const
+    {
+        uint32 done = m_totalTilesProcessed;
+        if (!done || done >= m_totalTiles)
+            return "-";
+
+        uint64 elapsed = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_startTime).count();
+        return secsToTimeString(elapsed * (m_totalTiles - done) / done, true);
+    }
 }
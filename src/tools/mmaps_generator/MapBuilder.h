@@ -19,6 +19,7 @@
 #define _MAP_BUILDER_H
 
 #include <atomic>
+#include <chrono>
 #include <list>
 #include <map>
 #include <set>
@@ -96,11 +97,12 @@ namespace MMAP
 
     struct TileInfo
     {
-        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_navMeshParams() {}
+        TileInfo() : m_mapId(uint32(-1)), m_tileX(), m_tileY(), m_inputSize(0), m_navMeshParams() {}
 
         uint32 m_mapId;
         uint32 m_tileX;
         uint32 m_tileY;
+        uint64 m_inputSize; // bytes of terrain and model input, used to queue the most expensive tiles first
         dtNavMeshParams m_navMeshParams;
     };
 
@@ -130,7 +132,10 @@ namespace MMAP
                               float bmax[3],
                               dtNavMesh* navMesh);
 
-        bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const;
+        // a tile is skipped if its input hash matches the one recorded by the build that wrote it
+        bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash) const;
+        bool hasValidTile(uint32 mapID, uint32 tileX, uint32 tileY) const;
+        void writeInputHash(uint32 mapID, uint32 tileX, uint32 tileY, uint64 inputHash) const;
 
     private:
         bool m_bigBaseUnit;
@@ -169,8 +174,8 @@ namespace MMAP
         void buildMaps(Optional<uint32> mapID);
 
     private:
-        // builds all mmap tiles for the specified map id (ignores skip settings)
-        void buildMap(uint32 mapID);
+        // queues all mmap tiles for the specified map id (ignores skip settings)
+        void buildMap(uint32 mapID, std::vector<TileInfo>& queuedTiles);
         // detect maps and tiles
         void discoverTiles();
         std::set<uint32>* getTileList(uint32 mapID);
@@ -190,6 +195,12 @@ namespace MMAP
 
         uint32 percentageDone(uint32 totalTiles, uint32 totalTilesDone) const;
         uint32 currentPercentageDone() const;
+        std::string currentETA() const;
+
+        // hash of everything a tile is built from: its and its neighbours' terrain, its models,
+        // the map's global models, the off mesh connections and the build settings
+        uint64 getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY) const;
+        uint64 getTileInputSize(uint32 mapID, uint32 tileX, uint32 tileY) const;
 
         TerrainBuilder* m_terrainBuilder{nullptr};
         TileList m_tiles;
@@ -209,6 +220,9 @@ namespace MMAP
 
         std::atomic<uint32> m_totalTiles;
         std::atomic<uint32> m_totalTilesProcessed;
+        std::atomic<uint32> m_totalTilesUpToDate;
+        std::chrono::steady_clock::time_point m_startTime;
+        uint64 m_settingsHash;
 
         // build performance - not really used for now
         rcContext* m_rcContext{nullptr};
@@ -15,8 +15,10 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "TileAssembler.h"
 
@@ -24,10 +26,11 @@ int main(int argc, char* argv[])
 {
     std::string src = "Buildings";
     std::string dest = "vmaps";
+    uint32 threads = std::max<uint32>(std::thread::hardware_concurrency(), 1);
 
-    if (argc > 3)
+    if (argc > 4)
     {
-        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir>" << std::endl;
+        std::cout << "usage: " << argv[0] << " <raw data dir> <vmap dest dir> <threads>" << std::endl;
         return 1;
     }
     else
@@ -36,13 +39,15 @@ int main(int argc, char* argv[])
             src = argv[1];
         if (argc > 2)
             dest = argv[2];
+        if (argc > 3)
+            threads = std::max<uint32>(std::stoul(argv[3]), 1);
     }
 
-    std::cout << "using " << src << " as source directory and writing output to " << dest << std::endl;
+    std::cout << "using " << src << " as source directory and writing output to " << dest << " with " << threads << " threads" << std::endl;
 
     VMAP::TileAssembler* ta = new VMAP::TileAssembler(src, dest);
 
-    if (!ta->convertWorld2())
+    if (!ta->convertWorld2(threads))
     {
         std::cout << "exit with errors" << std::endl;
         delete ta;
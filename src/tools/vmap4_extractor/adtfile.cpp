@@ -82,21 +82,12 @@ ADTFile::ADTFile(char* filename): _file(filename)
     Adtfilename.append(filename);
 }
 
-bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
+bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY, FILE* dirfile)
 {
     if (_file.isEof())
         return false;
 
     uint32 size;
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE* dirfile;
-    dirfile = fopen(dirname.c_str(), "ab");
-    if (!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     while (!_file.isEof())
     {
         char fourcc[5];
@@ -183,7 +174,7 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
                     ADT::MODF mapObjDef;
                     _file.read(&mapObjDef, sizeof(ADT::MODF));
                     MapObject::Extract(mapObjDef, WmoInstanceNames[mapObjDef.Id].c_str(), map_num, tileX, tileY, dirfile);
-                    Doodad::ExtractSet(WmoDoodads[WmoInstanceNames[mapObjDef.Id]], mapObjDef, map_num, tileX, tileY, dirfile);
+                    Doodad::ExtractSet(GetWmoDoodads(WmoInstanceNames[mapObjDef.Id]), mapObjDef, map_num, tileX, tileY, dirfile);
                 }
             }
         }
@@ -191,7 +182,6 @@ bool ADTFile::init(uint32 map_num, uint32 tileX, uint32 tileY)
         _file.seek(nextpos);
     }
     _file.close();
-    fclose(dirfile);
     return true;
 }
 
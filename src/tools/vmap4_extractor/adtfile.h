@@ -60,7 +60,7 @@ public:
     ~ADTFile();
     std::vector<std::string> WmoInstanceNames;
     std::vector<std::string> ModelInstanceNames;
-    bool init(uint32 map_num, uint32 tileX, uint32 tileY);
+    bool init(uint32 map_num, uint32 tileX, uint32 tileY, FILE* dirfile);
     //void LoadMapChunks();
 
     //uint32 wmo_count;
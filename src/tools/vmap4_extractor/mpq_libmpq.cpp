@@ -20,7 +20,8 @@
 #include <cstdio>
 #include <deque>
 
-ArchiveSet gOpenArchives;
+// every thread reading from the MPQs opens its own handles, libmpq archives are not thread safe
+thread_local ArchiveSet gOpenArchives;
 
 MPQArchive::MPQArchive(const char* filename)
 {
@@ -16,11 +16,16 @@
  */
 
 #define _CRT_SECURE_NO_DEPRECATE
+#include <atomic>
 #include <cerrno>
 #include <cstdio>
+#include <future>
 #include <list>
 #include <map>
+#include <mutex>
 #include <sys/stat.h>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #ifdef WIN32
@@ -47,7 +52,7 @@
 
 //-----------------------------------------------------------------------------
 
-extern ArchiveSet gOpenArchives;
+extern thread_local ArchiveSet gOpenArchives;
 
 typedef struct
 {
@@ -61,19 +66,56 @@ char output_path[128] = ".";
 char input_path[1024] = ".";
 bool hasInputPathParam = false;
 bool preciseVectorData = false;
+uint32 threadCount = std::max<uint32>(std::thread::hardware_concurrency(), 1);
+std::mutex WmoDoodadsLock;
 std::unordered_map<std::string, WMODoodadData> WmoDoodads;
 
 // Constants
 
 char const* szWorkDirWmo = "./Buildings";
 
+std::mutex uniqueObjectIdsLock;
 std::map<std::pair<uint32, uint16>, uint32> uniqueObjectIds;
 
+// The maps are extracted in parallel and share their models: a model is extracted by the
+// first thread asking for it, the others wait for its result
+std::mutex extractedModelsLock;
+std::unordered_map<std::string, std::shared_future<bool>> extractedModels;
+
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId)
 {
+    std::lock_guard<std::mutex> lock(uniqueObjectIdsLock);
     return uniqueObjectIds.emplace(std::make_pair(clientId, clientDoodadId), uint32(uniqueObjectIds.size() + 1)).first->second;
 }
 
+WMODoodadData& GetWmoDoodads(std::string const& name)
+{
+    // elements of an unordered_map keep their address when others are inserted
+    std::lock_guard<std::mutex> lock(WmoDoodadsLock);
+    return WmoDoodads[name];
+}
+
+bool ExtractOnce(std::string const& outputFile, std::function<bool()> const& extract)
+{
+    std::promise<bool> promise;
+    std::shared_future<bool> result;
+    bool owner;
+    {
+        std::lock_guard<std::mutex> lock(extractedModelsLock);
+        auto [itr, inserted] = extractedModels.try_emplace(outputFile);
+        if (inserted)
+            itr->second = promise.get_future().share();
+
+        owner = inserted;
+        result = itr->second;
+    }
+
+    if (owner)
+        promise.set_value(extract());
+
+    return result.get();
+}
+
 // Local testing functions
 
 bool FileExists(const char* file)
@@ -95,17 +137,8 @@ void strToLower(char* str)
     }
 }
 
-bool ExtractSingleWmo(std::string& fname)
+bool ExtractWmoFile(std::string const& originalName, std::string const& fname, char const* plain_name, char const* szLocalFile)
 {
-    // Copy files from archive
-    std::string originalName = fname;
-
-    char szLocalFile[1024];
-    char* plain_name = GetPlainName(&fname[0]);
-    fixnamen(plain_name, strlen(plain_name));
-    fixname2(plain_name, strlen(plain_name));
-    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
-
     if (FileExists(szLocalFile))
         return true;
 
@@ -141,7 +174,7 @@ bool ExtractSingleWmo(std::string& fname)
         return false;
     }
     froot.ConvertToVMAPRootWmo(output);
-    WMODoodadData& doodads = WmoDoodads[plain_name];
+    WMODoodadData& doodads = GetWmoDoodads(plain_name);
     std::swap(doodads, froot.DoodadData);
     int Wmo_nVertices = 0;
     //printf("root has %d groups\n", froot->nGroups);
@@ -195,34 +228,124 @@ bool ExtractSingleWmo(std::string& fname)
     return true;
 }
 
-void ParsMapFiles()
+bool ExtractSingleWmo(std::string& fname)
+{
+    // Copy files from archive
+    std::string originalName = fname;
+
+    char szLocalFile[1024];
+    char* plain_name = GetPlainName(&fname[0]);
+    fixnamen(plain_name, strlen(plain_name));
+    fixname2(plain_name, strlen(plain_name));
+    sprintf(szLocalFile, "%s/%s", szWorkDirWmo, plain_name);
+
+    return ExtractOnce(szLocalFile, [&]() { return ExtractWmoFile(originalName, fname, plain_name, szLocalFile); });
+}
+
+void OpenArchives(std::vector<std::string> const& archiveNames)
+{
+    for (auto& archiveName : archiveNames)
+    {
+        MPQArchive* archive = new MPQArchive(archiveName.c_str());
+        if (gOpenArchives.empty() || gOpenArchives.front() != archive)
+            delete archive;
+    }
+}
+
+void CloseArchives()
+{
+    // an archive closes its handle on deletion while it is still in the list
+    while (!gOpenArchives.empty())
+    {
+        delete gOpenArchives.front();
+        gOpenArchives.pop_front();
+    }
+}
+
+void ParsMapFile(map_id& map)
 {
     char fn[512];
-    //char id_filename[64];
-    for (unsigned int i = 0; i < map_count; ++i)
+    sprintf(fn, "%s/dir_bin_%03u", szWorkDirWmo, map.id);
+    FILE* dirfile = fopen(fn, "wb");
+    if (!dirfile)
     {
-        sprintf(fn,"World\\Maps\\%s\\%s.wdt", map_ids[i].name, map_ids[i].name);
-        WDTFile WDT(fn,map_ids[i].name);
-        if (WDT.init(map_ids[i].id))
+        printf("Can't open dirfile!'%s'\n", fn);
+        return;
+    }
+
+    sprintf(fn, "World\\Maps\\%s\\%s.wdt", map.name, map.name);
+    WDTFile WDT(fn, map.name);
+    if (WDT.init(map.id, dirfile))
+    {
+        printf("Processing Map %u\n", map.id);
+        for (int x = 0; x < 64; ++x)
         {
-            printf("Processing Map %u\n[", map_ids[i].id);
-            for (int x = 0; x < 64; ++x)
+            for (int y = 0; y < 64; ++y)
             {
-                for (int y = 0; y < 64; ++y)
+                if (ADTFile* ADT = WDT.GetMap(x, y))
                 {
-                    if (ADTFile* ADT = WDT.GetMap(x, y))
-                    {
-                        //sprintf(id_filename,"%02u %02u %03u",x,y,map_ids[i].id);//!!!!!!!!!
-                        ADT->init(map_ids[i].id, x, y);
-                        delete ADT;
-                    }
+                    ADT->init(map.id, x, y, dirfile);
+                    delete ADT;
                 }
-                printf("#");
-                fflush(stdout);
             }
-            printf("]\n");
+        }
+        printf("Map %u done\n", map.id);
+    }
+
+    fclose(dirfile);
+}
+
+void ParsMapFiles(std::vector<std::string> const& archiveNames)
+{
+    // every thread extracts whole maps into its own part of dir_bin, libmpq handles are not thread safe
+    // so every thread but this one opens the MPQs itself
+    std::atomic<uint32> nextMap(0);
+    auto worker = [&](bool ownArchives)
+    {
+        if (ownArchives)
+            OpenArchives(archiveNames);
+
+        for (uint32 i = nextMap++; i < map_count; i = nextMap++)
+            ParsMapFile(map_ids[i]);
+
+        if (ownArchives)
+            CloseArchives();
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32 i = 1; i < std::min(threadCount, map_count); ++i)
+        workers.emplace_back(worker, true);
+
+    worker(false);
+
+    for (std::thread& thread : workers)
+        thread.join();
+
+    // join the parts in map order, the same order a single thread writes them in
+    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
+    FILE* dirfile = fopen(dirname.c_str(), "ab");
+    if (!dirfile)
+    {
+        printf("Can't open dirfile!'%s'\n", dirname.c_str());
+        return;
+    }
+
+    char fn[512];
+    char buffer[MPQ_BLOCK_SIZE];
+    for (unsigned int i = 0; i < map_count; ++i)
+    {
+        sprintf(fn, "%s/dir_bin_%03u", szWorkDirWmo, map_ids[i].id);
+        if (FILE* part = fopen(fn, "rb"))
+        {
+            while (size_t read = fread(buffer, 1, sizeof(buffer), part))
+                fwrite(buffer, 1, read, dirfile);
+
+            fclose(part);
+            remove(fn);
         }
     }
+
+    fclose(dirfile);
 }
 
 void getGamePath()
@@ -390,6 +513,18 @@ bool processArgv(int argc, char** argv, const char* versionString)
         {
             preciseVectorData = true;
         }
+        else if (strcmp("-j", argv[i]) == 0)
+        {
+            if ((i + 1) < argc)
+            {
+                threadCount = std::max<int>(atoi(argv[i + 1]), 1);
+                ++i;
+            }
+            else
+            {
+                result = false;
+            }
+        }
         else
         {
             result = false;
@@ -399,10 +534,11 @@ bool processArgv(int argc, char** argv, const char* versionString)
     if (!result)
     {
         printf("Extract %s.\n", versionString);
-        printf("%s [-?][-s][-l][-d <path>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-j <threads>]\n", argv[0]);
         printf("   -s : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d <path>: Path to the vector data source folder.\n");
+        printf("   -j <threads>: Number of maps extracted in parallel, all cores by default.\n");
         printf("   -? : This message.\n");
     }
     return result;
@@ -454,12 +590,7 @@ int main(int argc, char** argv)
     // prepare archive name list
     std::vector<std::string> archiveNames;
     fillArchiveNameVector(archiveNames);
-    for (auto & archiveName : archiveNames)
-    {
-        MPQArchive* archive = new MPQArchive(archiveName.c_str());
-        if (gOpenArchives.empty() || gOpenArchives.front() != archive)
-            delete archive;
-    }
+    OpenArchives(archiveNames);
 
     if (gOpenArchives.empty())
     {
@@ -499,7 +630,7 @@ int main(int argc, char** argv)
         }
 
         delete dbc;
-        ParsMapFiles();
+        ParsMapFiles(archiveNames);
         //nError = ERROR_SUCCESS;
         // Extract models, listed in DameObjectDisplayInfo.dbc
         ExtractGameobjectModels();
@@ -19,8 +19,8 @@
 #define VMAPEXPORT_H
 
 #include "loadlib/loadlib.h"
+#include <functional>
 #include <string>
-#include <unordered_map>
 
 namespace VMAP
 {
@@ -38,9 +38,12 @@ enum ModelFlags
 struct WMODoodadData;
 
 extern const char * szWorkDirWmo;
-extern std::unordered_map<std::string, WMODoodadData> WmoDoodads;
 
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId);
+WMODoodadData& GetWmoDoodads(std::string const& name);
+
+/// Calls extract for the first caller asking for outputFile, concurrent callers wait for and share its result
+bool ExtractOnce(std::string const& outputFile, std::function<bool()> const& extract);
 
 bool FileExists(const char* file);
 void strToLower(char* str);
@@ -35,7 +35,7 @@ WDTFile::WDTFile(char* file_name, char* file_name1) : _file(file_name)
     filename.append(file_name1, strlen(file_name1));
 }
 
-bool WDTFile::init(uint32 mapId)
+bool WDTFile::init(uint32 mapId, FILE* dirfile)
 {
     if (_file.isEof())
     {
@@ -46,15 +46,6 @@ bool WDTFile::init(uint32 mapId)
     char fourcc[5];
     uint32 size;
 
-    std::string dirname = std::string(szWorkDirWmo) + "/dir_bin";
-    FILE* dirfile;
-    dirfile = fopen(dirname.c_str(), "ab");
-    if (!dirfile)
-    {
-        printf("Can't open dirfile!'%s'\n", dirname.c_str());
-        return false;
-    }
-
     while (!_file.isEof())
     {
         _file.read(fourcc, 4);
@@ -102,7 +93,7 @@ bool WDTFile::init(uint32 mapId)
                     ADT::MODF mapObjDef;
                     _file.read(&mapObjDef, sizeof(ADT::MODF));
                     MapObject::Extract(mapObjDef, _wmoNames[mapObjDef.Id].c_str(), mapId, 65, 65, dirfile);
-                    Doodad::ExtractSet(WmoDoodads[_wmoNames[mapObjDef.Id]], mapObjDef, mapId, 65, 65, dirfile);
+                    Doodad::ExtractSet(GetWmoDoodads(_wmoNames[mapObjDef.Id]), mapObjDef, mapId, 65, 65, dirfile);
                 }
             }
         }
@@ -110,7 +101,6 @@ bool WDTFile::init(uint32 mapId)
     }
 
     _file.close();
-    fclose(dirfile);
     return true;
 }
 